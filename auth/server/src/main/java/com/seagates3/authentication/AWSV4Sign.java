@@ -75,6 +75,22 @@ public class AWSV4Sign implements AWSSign {
         }
     }
 
+    /**
+     * Return the signing key derived for the credential scope of the request.
+     *
+     * The key is only valid for the date, region and service of that scope,
+     * which lets s3server verify further requests of the same scope itself.
+     *
+     * @param clientRequestToken
+     * @param requestor
+     * @return Signing key or null.
+     */
+    public byte[] getSigningKey(ClientRequestToken clientRequestToken,
+                                Requestor requestor) {
+        return deriveSigningKey(clientRequestToken,
+                                requestor.getAccesskey().getSecretKey());
+    }
+
     /**
      * Verify the signature of a regular S3/IAM API.
      *
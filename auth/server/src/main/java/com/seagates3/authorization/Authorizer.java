@@ -65,6 +65,10 @@ class Authorizer {
  public
   Authorizer() {}
 
+  // Signing key returned with a successful authorization, if any
+ private
+  String signingKey;
+
   /**
    * Request authorization
    *
@@ -75,6 +79,22 @@ class Authorizer {
  public
   ServerResponse authorize(Requestor requestor,
                            Map<String, String> requestBody) {
+    return authorize(requestor, requestBody, null);
+  }
+
+  /**
+   * Request authorization of an authenticated request
+   *
+   * @param requestor
+   * @param requestBody
+   * @param signingKey Hex encoded signing key of the request to return on
+   *                   success, or null.
+   * @return
+   */
+ public
+  ServerResponse authorize(Requestor requestor, Map<String, String> requestBody,
+                           String signingKey) {
+    this.signingKey = signingKey;
 
     ServerResponse serverResponse = null;
     AuthorizationResponseGenerator responseGenerator =
@@ -181,7 +201,8 @@ class Authorizer {
           acl = aclCreator.createDefaultAcl(requestor);
         }
         LOGGER.debug("Updated xml is - " + acl);
-        return responseGenerator.generateAuthorizationResponse(requestor, acl);
+        return responseGenerator.generateAuthorizationResponse(requestor, acl,
+                                                             signingKey);
       }
       catch (ParserConfigurationException | SAXException | IOException e) {
         LOGGER.error("Error while initializing default ACL");
@@ -202,7 +223,8 @@ class Authorizer {
         return e.getServerResponse();
       }
     }
-    return responseGenerator.generateAuthorizationResponse(requestor, null);
+    return responseGenerator.generateAuthorizationResponse(requestor, null,
+                                                           signingKey);
   }
 
   /**
@@ -118,7 +118,8 @@ public class AuthServerConfig {
        while (authProps.hasMoreElements()) {
                 String key = (String) authProps.nextElement();
                 Set<String> secureProps = new HashSet<>(Arrays.asList(
-                    "s3KeyPassword", "ldapLoginPW", "s3KeyStorePassword"));
+                    "s3KeyPassword", "ldapLoginPW", "s3KeyStorePassword",
+                    "s3SigningKeySecret"));
                 if( !secureProps.contains(key) ) {
                      String value = authServerConfig.getProperty(key);
                      logger.info("Config [" + key + "] = " + value);
@@ -433,5 +434,15 @@ public class AuthServerConfig {
     static int getCacheTimeout() {
       return Integer.parseInt(authServerConfig.getProperty("cacheTimeout"));
     }
+
+    /**
+     * Secret s3server sends along to get signing keys of authenticated
+     * requests, empty if signing keys are never returned.
+     */
+   public
+    static String getS3SigningKeySecret() {
+      String secret = authServerConfig.getProperty("s3SigningKeySecret");
+      return (secret != null) ? secret : "";
+    }
 }
 
@@ -23,11 +23,14 @@ package com.seagates3.controller;
 import java.lang.reflect.Constructor;
 import java.lang.reflect.InvocationTargetException;
 import java.lang.reflect.Method;
+import java.nio.charset.StandardCharsets;
+import java.security.MessageDigest;
 import java.util.Map;
 
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
+import com.seagates3.authentication.AWSV4Sign;
 import com.seagates3.authentication.ClientRequestParser;
 import com.seagates3.authentication.ClientRequestToken;
 import com.seagates3.authentication.SignatureValidator;
@@ -50,6 +53,7 @@ import com.seagates3.perf.S3Perf;
 import com.seagates3.response.ServerResponse;
 import com.seagates3.response.generator.AuthenticationResponseGenerator;
 import com.seagates3.service.RequestorService;
+import com.seagates3.util.BinaryUtil;
 
 import io.netty.handler.codec.http.FullHttpRequest;
 import io.netty.handler.codec.http.HttpResponseStatus;
@@ -317,7 +321,8 @@ class IAMController {
 
       if (requestAction.equals("AuthenticateUser")) {
         serverResponse = responseGenerator.generateAuthenticatedResponse(
-            requestor, clientRequestToken);
+            requestor, clientRequestToken,
+            getSigningKey(requestBody, clientRequestToken, requestor));
         LOGGER.info("Request is authenticated for user: " +
                     requestor.getName() + " account: " +
                     requestor.getAccount().getName());
@@ -327,7 +332,9 @@ class IAMController {
         LOGGER.info("User is Authenticated hence Authorizing user: " +
                     requestor.getName() + " account: " +
                     requestor.getAccount().getName());
-        serverResponse = new Authorizer().authorize(requestor, requestBody);
+        serverResponse = new Authorizer().authorize(
+            requestor, requestBody,
+            getSigningKey(requestBody, clientRequestToken, requestor));
         return serverResponse;
       }
     } else {
@@ -385,6 +392,37 @@ class IAMController {
     return performAction(resourceMap, requestBody, requestor);
   }
 
+  /**
+   * Return the hex encoded signing key of a V4 signed request if s3server
+   * asked for it with the configured shared secret, to cache and verify later
+   * requests itself. Without the secret any client replaying its own signed
+   * request could get the key. Not returned for temporary credentials, whose
+   * session token and expiry need checking on every request.
+   *
+   * @param requestBody
+   * @param clientRequestToken
+   * @param requestor
+   * @return Signing key or null.
+   */
+ private
+  String getSigningKey(Map<String, String> requestBody,
+                       ClientRequestToken clientRequestToken,
+                       Requestor requestor) {
+    String secret = AuthServerConfig.getS3SigningKeySecret();
+    String requested = requestBody.get("Request-Signing-Key");
+    if (secret == null || secret.isEmpty() || requested == null ||
+        !MessageDigest.isEqual(secret.getBytes(StandardCharsets.UTF_8),
+                               requested.getBytes(StandardCharsets.UTF_8)) ||
+        clientRequestToken.getSignVersion() !=
+            ClientRequestToken.AWSSigningVersion.V4 ||
+        requestor.isFederatedUser()) {
+      return null;
+    }
+    byte[] signingKey =
+        new AWSV4Sign().getSigningKey(clientRequestToken, requestor);
+    return (signingKey != null) ? BinaryUtil.toHex(signingKey) : null;
+  }
+
   /**
    * Validate the request parameters.
    *
@@ -32,6 +32,15 @@ public class AuthenticationResponseGenerator extends AbstractResponseGenerator {
 
     public ServerResponse generateAuthenticatedResponse(Requestor requestor,
             ClientRequestToken requestToken) {
+        return generateAuthenticatedResponse(requestor, requestToken, null);
+    }
+
+    /*
+     * signingKey, when not null, is the hex encoded SigV4 signing key of the
+     * request's credential scope.
+     */
+    public ServerResponse generateAuthenticatedResponse(Requestor requestor,
+            ClientRequestToken requestToken, String signingKey) {
         LinkedHashMap responseElements = new LinkedHashMap();
         responseElements.put("UserId", requestor.getId());
         responseElements.put("UserName", requestor.getName());
@@ -41,6 +50,9 @@ public class AuthenticationResponseGenerator extends AbstractResponseGenerator {
         responseElements.put("CanonicalId",
                              requestor.getAccount().getCanonicalId());
         responseElements.put("Email", requestor.getAccount().getEmail());
+        if (signingKey != null) {
+            responseElements.put("SigningKey", signingKey);
+        }
 
         return (ServerResponse) new AuthenticationResponseFormatter()
             .formatAuthenticatedResponse(responseElements,
@@ -31,6 +31,18 @@ public class AuthorizationResponseGenerator extends AbstractResponseGenerator {
   public
    ServerResponse generateAuthorizationResponse(Requestor requestor,
                                                 String acpXml) {
+     return generateAuthorizationResponse(requestor, acpXml, null);
+   }
+
+   /*
+    * signingKey, when not null, is the hex encoded SigV4 signing key of the
+    * authenticated request's credential scope. It is returned along with the
+    * email, so that s3server can cache the identity of the requestor.
+    */
+  public
+   ServerResponse generateAuthorizationResponse(Requestor requestor,
+                                                String acpXml,
+                                                String signingKey) {
         LinkedHashMap responseElements = new LinkedHashMap();
         if (requestor != null) {
           responseElements.put("UserId", requestor.getId());
@@ -39,6 +51,10 @@ public class AuthorizationResponseGenerator extends AbstractResponseGenerator {
           responseElements.put("AccountName", requestor.getAccount().getName());
           responseElements.put("CanonicalId",
                                requestor.getAccount().getCanonicalId());
+          if (signingKey != null) {
+            responseElements.put("Email", requestor.getAccount().getEmail());
+            responseElements.put("SigningKey", signingKey);
+          }
         } else {
           responseElements.put("AllUserRequest", "true");
         }
@@ -54,6 +54,7 @@ import org.powermock.modules.junit4.PowerMockRunner;
 import org.powermock.reflect.internal.WhiteboxImpl;
 
 import com.seagates3.acl.ACLValidation;
+import com.seagates3.authentication.AWSV4Sign;
 import com.seagates3.authentication.ClientRequestParser;
 import com.seagates3.authentication.ClientRequestToken;
 import com.seagates3.authentication.SignatureValidator;
@@ -969,5 +970,30 @@ import io.netty.handler.codec.http.HttpResponseStatus;
     verifyPrivate(controllerSpy)
         .invoke("performAction", resourceMap, requestBody, requestor);
   }
+
+  @Test public void getSigningKeyNeedsSharedSecret() throws Exception {
+    AWSV4Sign awsV4Sign = mock(AWSV4Sign.class);
+    whenNew(AWSV4Sign.class).withNoArguments().thenReturn(awsV4Sign);
+    when(awsV4Sign.getSigningKey(clientRequestToken, requestor))
+        .thenReturn(new byte[] {0x0a, 0x1b});
+    when(clientRequestToken.getSignVersion())
+        .thenReturn(ClientRequestToken.AWSSigningVersion.V4);
+    requestBody.put("Request-Signing-Key", "true");
+
+    when(AuthServerConfig.getS3SigningKeySecret()).thenReturn("");
+    assertNull(WhiteboxImpl.invokeMethod(controller, "getSigningKey",
+                                         requestBody, clientRequestToken,
+                                         requestor));
+
+    when(AuthServerConfig.getS3SigningKeySecret()).thenReturn("key-secret");
+    assertNull(WhiteboxImpl.invokeMethod(controller, "getSigningKey",
+                                         requestBody, clientRequestToken,
+                                         requestor));
+
+    requestBody.put("Request-Signing-Key", "key-secret");
+    assertEquals("0a1b", WhiteboxImpl.invokeMethod(
+                             controller, "getSigningKey", requestBody,
+                             clientRequestToken, requestor));
+  }
 }
 
@@ -75,6 +75,7 @@ class AuthorizationResponseGeneratorTest {
     account.setCanonicalId("qWwZGnGYTga8gbpcuY79SA");
     account.setId("12345");
     account.setName("testAccount");
+    account.setEmail("test@seagate.com");
 
     requestor = new Requestor();
     requestor.setId("456");
@@ -105,4 +106,16 @@ class AuthorizationResponseGeneratorTest {
     assertFalse(actualServerResponse.getResponseBody().matches(
         "[\\s\\S]*\\<ACL\\>[\\s\\S]*\\<\\/ACL\\>[\\s\\S]*"));
   }
+
+  @Test public void testGenerateAuthorizationResponse_WithSigningKey() {
+
+    ServerResponse actualServerResponse =
+        responseGenerator.generateAuthorizationResponse(requestor, null,
+                                                        "0a1b2c");
+    assertEquals(HttpResponseStatus.OK,
+                 actualServerResponse.getResponseStatus());
+    assertTrue(actualServerResponse.getResponseBody().contains(
+        "<CanonicalId>qWwZGnGYTga8gbpcuY79SA</CanonicalId>" +
+        "<Email>test@seagate.com</Email>" + "<SigningKey>0a1b2c</SigningKey>"));
+  }
 }
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+/*
+   Prints metadata record of a bucket or an object as JSON, whether it was
+   saved as JSON or in binary form (S3_SERVER_METADATA_BINARY_ENCODING).
+
+   Usage:
+   ./metadata_decoder -x <value as hex>
+   ./metadata_decoder < <raw value>
+ */
+
+#include <cctype>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include "s3_metadata_codec.h"
+
+static bool from_hex(const std::string &hex, std::string &value) {
+  std::string digits;
+  for (char c : hex) {
+    if (isxdigit((unsigned char)c)) {
+      digits += c;
+    } else if (!isspace((unsigned char)c)) {
+      return false;
+    }
+  }
+  if (digits.length() % 2) {
+    return false;
+  }
+  value.clear();
+  for (size_t i = 0; i < digits.length(); i += 2) {
+    value += (char)std::stoi(digits.substr(i, 2), nullptr, 16);
+  }
+  return true;
+}
+
+static void usage(const char *name) {
+  std::cout << "-----------------------Usage------------------------\n";
+  std::cout << name << " -x <value as hex>\n";
+  std::cout << name << " < <file with raw value>\n";
+}
+
+int main(int argc, char *argv[]) {
+  std::string value;
+  if (argc == 3 && std::string(argv[1]) == "-x") {
+    if (!from_hex(argv[2], value)) {
+      std::cerr << "Invalid hex value\n";
+      return 1;
+    }
+  } else if (argc == 1) {
+    value.assign(std::istreambuf_iterator<char>(std::cin),
+                 std::istreambuf_iterator<char>());
+  } else {
+    usage(argv[0]);
+    return 1;
+  }
+
+  if (!s3_is_binary_metadata(value)) {
+    // Saved as JSON, already readable.
+    std::cout << value;
+    if (value.empty() || value.back() != '\n') {
+      std::cout << "\n";
+    }
+    return 0;
+  }
+  std::string json;
+  if (!s3_binary_metadata_to_json(value, json)) {
+    std::cerr << "Invalid binary metadata record\n";
+    return 1;
+  }
+  std::cout << json;
+  if (json.empty() || json.back() != '\n') {
+    std::cout << "\n";
+  }
+  return 0;
+}
@@ -58,8 +58,34 @@ struct mempool {
   pthread_mutex_t lock;     /* lock, in case of synchronous operation */
   struct memory_pool_element *free_list; /* list of free items available for
                                             reuse */
+  int thread_cache_batch; /* Buffers moved per magazine refill/drain */
+  int starved; /* Set when a magazine refill found the pool at its max
+                  threshold, releasing threads then return their whole
+                  magazine instead of caching */
+  unsigned long pool_id;  /* Tells pool from a destroyed one at same address */
+  struct mempool *next_cached_pool; /* Next pool with ENABLE_THREAD_CACHE */
 };
 
+/* Free buffers of one pool cached by a thread, used as a stack */
+struct mempool_magazine {
+  struct mempool *pool;
+  unsigned long pool_id;
+  int count;
+  struct memory_pool_element *head;
+};
+
+static __thread struct mempool_magazine
+    thread_magazines[MEMPOOL_THREAD_CACHE_SLOTS];
+
+/* Pools with ENABLE_THREAD_CACHE not destroyed yet, looked up by exiting
+   threads to return the buffers of their magazines. */
+static pthread_mutex_t cached_pools_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct mempool *cached_pools = NULL;
+static unsigned long cached_pools_next_id = 1;
+
+static pthread_once_t thread_cache_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t thread_cache_key;
+
 /**
  * Return the number of buffers we can allocate w.r.t max threshold and
  * available memory space.
@@ -157,6 +183,238 @@ int freelist_allocate(struct mempool *pool, int items_count_to_allocate) {
   return 0;
 }
 
+/**
+ * Take a buffer from pool's free list, expanding the pool if the list is
+ * empty. Pool's lock must be held when ENABLE_LOCKING.
+ */
+static struct memory_pool_element *freelist_get(struct mempool *pool) {
+  int rc;
+  int bufs_to_allocate;
+  int bufs_that_can_be_allocated = 0;
+  struct memory_pool_element *pool_item = NULL;
+
+  /* If the free list is empty then expand the pool's free list */
+  if (pool->free_bufs_in_pool == 0) {
+    bufs_to_allocate = pool->expandable_size / pool->mempool_item_size;
+    bufs_that_can_be_allocated = pool_can_expand_by(pool);
+    if (bufs_that_can_be_allocated > 0) {
+      /* We can at least allocate
+         min(bufs_that_can_be_allocated, bufs_to_allocate) */
+      bufs_to_allocate = ((bufs_to_allocate > bufs_that_can_be_allocated)
+                              ? bufs_that_can_be_allocated
+                              : bufs_to_allocate);
+
+      rc = freelist_allocate(pool, bufs_to_allocate);
+      if (rc != 0) {
+        return NULL;
+      }
+    } else {
+      /* We cannot allocate any more buffers, reached max threshold */
+      return NULL;
+    }
+  }
+
+  /* Done with expansion of pool in case of pre allocated pools */
+
+  /* Logic of allocation from free list */
+  /* If there is an item on the pool's free list, then take that... */
+  if (pool->free_list != NULL) {
+    pool_item = pool->free_list;
+    pool->free_list = pool_item->next;
+    pool_item->next = (struct memory_pool_element *)NULL;
+    pool->free_bufs_in_pool--;
+  }
+
+  if (pool_item) {
+    pool->number_of_bufs_shared++;
+  }
+  return pool_item;
+}
+
+static void magazine_reset(struct mempool_magazine *magazine) {
+  magazine->pool = NULL;
+  magazine->pool_id = 0;
+  magazine->count = 0;
+  magazine->head = NULL;
+}
+
+/**
+ * Free the buffers of a magazine whose pool was destroyed.
+ */
+static void magazine_discard(struct mempool_magazine *magazine) {
+  struct memory_pool_element *pool_item;
+
+  while (magazine->head != NULL) {
+    pool_item = magazine->head;
+    magazine->head = pool_item->next;
+    free(pool_item);
+  }
+  magazine_reset(magazine);
+}
+
+/**
+ * Move up to 'count' buffers from the top of magazine to the pool's free
+ * list, taking the pool's lock once.
+ */
+static void magazine_drain(struct mempool_magazine *magazine, int count) {
+  int i;
+  struct mempool *pool = magazine->pool;
+  struct memory_pool_element *first = magazine->head;
+  struct memory_pool_element *last = first;
+
+  if (count > magazine->count) {
+    count = magazine->count;
+  }
+  if (count == 0) {
+    return;
+  }
+
+  for (i = 1; i < count; i++) {
+    last = last->next;
+  }
+  magazine->head = last->next;
+  magazine->count -= count;
+
+  pthread_mutex_lock(&pool->lock);
+  last->next = pool->free_list;
+  pool->free_list = first;
+  pool->free_bufs_in_pool += count;
+  pool->number_of_bufs_shared -= count;
+  pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * Move up to a batch of buffers from the pool's free list to the magazine,
+ * taking the pool's lock once. Pool is expanded only for the first buffer.
+ */
+static void magazine_refill(struct mempool_magazine *magazine) {
+  struct mempool *pool = magazine->pool;
+  struct memory_pool_element *pool_item = NULL;
+
+  pthread_mutex_lock(&pool->lock);
+  while (magazine->count < pool->thread_cache_batch) {
+    if (pool->free_bufs_in_pool == 0 && magazine->count > 0) {
+      break;
+    }
+    pool_item = freelist_get(pool);
+    if (pool_item == NULL) {
+      break;
+    }
+    pool_item->next = magazine->head;
+    magazine->head = pool_item;
+    magazine->count++;
+  }
+  if (magazine->count == 0) {
+    /* Free buffers may be parked in magazines of threads which only release
+       buffers, e.g. Motr callback threads, ask them to give them back. */
+    __atomic_store_n(&pool->starved, 1, __ATOMIC_RELAXED);
+  } else if (pool->free_bufs_in_pool >= pool->thread_cache_batch) {
+    __atomic_store_n(&pool->starved, 0, __ATOMIC_RELAXED);
+  }
+  pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * Thread exit destructor, returns buffers of thread's magazines to their
+ * pools or frees them if the pools were destroyed meanwhile.
+ */
+static void thread_cache_flush(void *magazines) {
+  int i;
+  struct mempool *pool;
+  struct mempool_magazine *magazine = (struct mempool_magazine *)magazines;
+
+  pthread_mutex_lock(&cached_pools_lock);
+  for (i = 0; i < MEMPOOL_THREAD_CACHE_SLOTS; i++, magazine++) {
+    if (magazine->pool == NULL) {
+      continue;
+    }
+    for (pool = cached_pools; pool != NULL; pool = pool->next_cached_pool) {
+      if (pool == magazine->pool && pool->pool_id == magazine->pool_id) {
+        break;
+      }
+    }
+    if (pool != NULL) {
+      magazine_drain(magazine, magazine->count);
+      magazine_reset(magazine);
+    } else {
+      magazine_discard(magazine);
+    }
+  }
+  pthread_mutex_unlock(&cached_pools_lock);
+}
+
+static void thread_cache_key_create(void) {
+  pthread_key_create(&thread_cache_key, thread_cache_flush);
+}
+
+/**
+ * Return calling thread's magazine for the pool, NULL if all the thread's
+ * magazines are in use by other pools.
+ */
+static struct mempool_magazine *thread_cache_magazine(struct mempool *pool) {
+  int i;
+  struct mempool_magazine *magazine = NULL;
+
+  for (i = 0; i < MEMPOOL_THREAD_CACHE_SLOTS; i++) {
+    if (thread_magazines[i].pool == pool) {
+      if (thread_magazines[i].pool_id == pool->pool_id) {
+        return &thread_magazines[i];
+      }
+      /* Left over by a destroyed pool at the same address */
+      magazine_discard(&thread_magazines[i]);
+    }
+    if (magazine == NULL && thread_magazines[i].pool == NULL) {
+      magazine = &thread_magazines[i];
+    }
+  }
+  if (magazine == NULL) {
+    return NULL;
+  }
+
+  pthread_once(&thread_cache_key_once, thread_cache_key_create);
+  /* Any non NULL value makes thread_cache_flush() run on thread exit */
+  pthread_setspecific(thread_cache_key, thread_magazines);
+
+  magazine->pool = pool;
+  magazine->pool_id = pool->pool_id;
+  return magazine;
+}
+
+static void thread_cache_register(struct mempool *pool) {
+  pthread_mutex_lock(&cached_pools_lock);
+  pool->pool_id = cached_pools_next_id++;
+  pool->next_cached_pool = cached_pools;
+  cached_pools = pool;
+  pthread_mutex_unlock(&cached_pools_lock);
+}
+
+/**
+ * Forget the pool being destroyed, buffers cached by the calling thread go
+ * back to its free list. Buffers cached by other threads are freed by them
+ * on exit or when their magazine is needed by another pool.
+ */
+static void thread_cache_unregister(struct mempool *pool) {
+  int i;
+  struct mempool **link;
+
+  pthread_mutex_lock(&cached_pools_lock);
+  for (link = &cached_pools; *link != NULL; link = &(*link)->next_cached_pool) {
+    if (*link == pool) {
+      *link = pool->next_cached_pool;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&cached_pools_lock);
+
+  for (i = 0; i < MEMPOOL_THREAD_CACHE_SLOTS; i++) {
+    if (thread_magazines[i].pool == pool &&
+        thread_magazines[i].pool_id == pool->pool_id) {
+      magazine_drain(&thread_magazines[i], thread_magazines[i].count);
+      magazine_reset(&thread_magazines[i]);
+    }
+  }
+}
+
 int mempool_create(size_t pool_item_size, size_t pool_initial_size,
                    size_t pool_expansion_size, size_t pool_max_threshold_size,
                    func_log_callback_type log_callback_func, int flags,
@@ -195,6 +453,20 @@ int mempool_create(size_t pool_item_size, size_t pool_initial_size,
       free(pool);
       return S3_MEMPOOL_ERROR;
     }
+  } else {
+    /* Thread cache only helps pools shared by threads */
+    pool->flags &= ~ENABLE_THREAD_CACHE;
+  }
+
+  if ((pool->flags & ENABLE_THREAD_CACHE) != 0) {
+    pool->thread_cache_batch =
+        MEMPOOL_THREAD_CACHE_BATCH_BYTES / pool->mempool_item_size;
+    if (pool->thread_cache_batch > MEMPOOL_THREAD_CACHE_BATCH) {
+      pool->thread_cache_batch = MEMPOOL_THREAD_CACHE_BATCH;
+    } else if (pool->thread_cache_batch < 1) {
+      pool->thread_cache_batch = 1;
+    }
+    thread_cache_register(pool);
   }
 
   *handle = (MemoryPoolHandle)pool;
@@ -260,10 +532,8 @@ int mempool_create_with_shared_mem(
 }
 
 void *mempool_getbuffer(MemoryPoolHandle handle, size_t expected_buffer_size) {
-  int rc;
-  int bufs_to_allocate;
-  int bufs_that_can_be_allocated = 0;
   struct memory_pool_element *pool_item = NULL;
+  struct mempool_magazine *magazine = NULL;
   struct mempool *pool = (struct mempool *)handle;
   char *log_msg_fmt =
       "mempool(%p): mempool_getbuffer called for invalid "
@@ -285,51 +555,27 @@ void *mempool_getbuffer(MemoryPoolHandle handle, size_t expected_buffer_size) {
     }
   }
 
-  if ((pool->flags & ENABLE_LOCKING) != 0) {
-    pthread_mutex_lock(&pool->lock);
+  if ((pool->flags & ENABLE_THREAD_CACHE) != 0) {
+    magazine = thread_cache_magazine(pool);
   }
-
-  /* If the free list is empty then expand the pool's free list */
-  if (pool->free_bufs_in_pool == 0) {
-    bufs_to_allocate = pool->expandable_size / pool->mempool_item_size;
-    bufs_that_can_be_allocated = pool_can_expand_by(pool);
-    if (bufs_that_can_be_allocated > 0) {
-      /* We can at least allocate
-         min(bufs_that_can_be_allocated, bufs_to_allocate) */
-      bufs_to_allocate = ((bufs_to_allocate > bufs_that_can_be_allocated)
-                              ? bufs_that_can_be_allocated
-                              : bufs_to_allocate);
-
-      rc = freelist_allocate(pool, bufs_to_allocate);
-      if (rc != 0) {
-        if ((pool->flags & ENABLE_LOCKING) != 0) {
-          pthread_mutex_unlock(&pool->lock);
-        }
-        return NULL;
-      }
-    } else {
-      /* We cannot allocate any more buffers, reached max threshold */
-      if ((pool->flags & ENABLE_LOCKING) != 0) {
-        pthread_mutex_unlock(&pool->lock);
-      }
-      return NULL;
+  if (magazine != NULL) {
+    if (magazine->count == 0) {
+      magazine_refill(magazine);
     }
+    pool_item = magazine->head;
+    if (pool_item != NULL) {
+      magazine->head = pool_item->next;
+      pool_item->next = (struct memory_pool_element *)NULL;
+      magazine->count--;
+    }
+    return (void *)pool_item;
   }
 
-  /* Done with expansion of pool in case of pre allocated pools */
-
-  /* Logic of allocation from free list */
-  /* If there is an item on the pool's free list, then take that... */
-  if (pool->free_list != NULL) {
-    pool_item = pool->free_list;
-    pool->free_list = pool_item->next;
-    pool_item->next = (struct memory_pool_element *)NULL;
-    pool->free_bufs_in_pool--;
+  if ((pool->flags & ENABLE_LOCKING) != 0) {
+    pthread_mutex_lock(&pool->lock);
   }
 
-  if (pool_item) {
-    pool->number_of_bufs_shared++;
-  }
+  pool_item = freelist_get(pool);
 
   if ((pool->flags & ENABLE_LOCKING) != 0) {
     pthread_mutex_unlock(&pool->lock);
@@ -342,6 +588,7 @@ int mempool_releasebuffer(MemoryPoolHandle handle, void *buf,
                           size_t released_buffer_size) {
   struct mempool *pool = (struct mempool *)handle;
   struct memory_pool_element *pool_item = (struct memory_pool_element *)buf;
+  struct mempool_magazine *magazine = NULL;
   char *log_msg_fmt =
       "mempool(%p): mempool_releasebuffer called for invalid "
       "released_buffer_size(%zu), current pool manages only "
@@ -362,16 +609,31 @@ int mempool_releasebuffer(MemoryPoolHandle handle, void *buf,
     }
   }
 
-  if ((pool->flags & ENABLE_LOCKING) != 0) {
-    pthread_mutex_lock(&pool->lock);
-  }
-
   /* Clean up the buffer so that we get it 'clean' when we allocate it next
    * time*/
   if ((pool->flags & ZEROED_BUFFER) != 0) {
     memset(pool_item, 0, pool->mempool_item_size);
   }
 
+  if ((pool->flags & ENABLE_THREAD_CACHE) != 0) {
+    magazine = thread_cache_magazine(pool);
+  }
+  if (magazine != NULL) {
+    pool_item->next = magazine->head;
+    magazine->head = pool_item;
+    magazine->count++;
+    if (__atomic_load_n(&pool->starved, __ATOMIC_RELAXED)) {
+      magazine_drain(magazine, magazine->count);
+    } else if (magazine->count > 2 * pool->thread_cache_batch) {
+      magazine_drain(magazine, pool->thread_cache_batch);
+    }
+    return 0;
+  }
+
+  if ((pool->flags & ENABLE_LOCKING) != 0) {
+    pthread_mutex_lock(&pool->lock);
+  }
+
   // Add the buffer back to pool
   pool_item->next = pool->free_list;
   pool->free_list = pool_item;
@@ -535,6 +797,10 @@ int mempool_destroy(MemoryPoolHandle *handle) {
     return S3_MEMPOOL_INVALID_ARG;
   }
 
+  if ((pool->flags & ENABLE_THREAD_CACHE) != 0) {
+    thread_cache_unregister(pool);
+  }
+
   if ((pool->flags & ENABLE_LOCKING) != 0) {
     pthread_mutex_lock(&pool->lock);
   }
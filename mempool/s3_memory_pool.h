@@ -34,6 +34,21 @@ extern "C" {
 #define CREATE_ALIGNED_MEMORY 0x0001
 #define ENABLE_LOCKING 0x0002
 #define ZEROED_BUFFER 0x0004
+/* Only with ENABLE_LOCKING: each thread keeps a small stack of free buffers
+   (magazine) per pool, refilled from and drained to the pool's free list in
+   batches, so that most get/release calls take no lock. */
+#define ENABLE_THREAD_CACHE 0x0008
+
+/* Maximum number of pools a thread keeps a magazine for, calls for further
+   pools go to the pool's free list under the lock. */
+#define MEMPOOL_THREAD_CACHE_SLOTS 8
+/* Number of buffers moved between a magazine and the pool's free list at a
+   time, lower for large buffers to bound memory parked in magazines. A
+   magazine holds at most twice this. Once the pool can't grow past its max
+   threshold threads return their whole magazine on their next release, a
+   thread which never calls the pool again keeps its buffers until it exits. */
+#define MEMPOOL_THREAD_CACHE_BATCH 16
+#define MEMPOOL_THREAD_CACHE_BATCH_BYTES (1024 * 1024)
 
 #define MEMORY_ALIGNMENT 4096
 #define S3_MEMPOOL_ERROR -1
@@ -122,7 +137,11 @@ struct pool_info {
  * pool_max_threshold_size (in) maximum allowed memory utilization(Consumed by
  * app. + free list in pool)
  * when done via the pool
- * flags (in) if ENABLE_LOCKING then pool synchronization with lock
+ * flags (in) if ENABLE_LOCKING then pool synchronization with lock,
+ * ENABLE_THREAD_CACHE additionally caches free buffers per thread. Buffers
+ * cached by threads count as shared in pool_info and up to twice
+ * MEMPOOL_THREAD_CACHE_BATCH of them per thread are out of reach of other
+ * threads until the pool hits its max threshold.
  * p_handle (out) On success pool handle is returned here
  * returns:
  * 0 on success, otherwise an error
@@ -18,6 +18,8 @@
  *
  */
 
+#include <thread>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -293,6 +295,122 @@ TEST_F(MempoolTestSuite, AllocateMemMemoryPoolTest) {
   EXPECT_TRUE(((uint64_t)buf & 4095) == 0);
 }
 
+TEST_F(MempoolSelfCreateTestSuite, ThreadCacheNeedsLockingTest) {
+  EXPECT_EQ(0, mempool_create(FOUR_KB, 0, FOUR_KB, TWELVE_KB,
+                              (func_log_callback_type)NULL, ENABLE_THREAD_CACHE,
+                              &first_handle));
+  EXPECT_EQ(0, mempool_getinfo(first_handle, &firstpass_pool_details));
+  EXPECT_FALSE(ENABLE_THREAD_CACHE & firstpass_pool_details.flags);
+  mempool_destroy(&first_handle);
+}
+
+// Buffers released by a thread are reused by it without going back to
+// the pool's free list
+TEST_F(MempoolSelfCreateTestSuite, ThreadCacheReuseTest) {
+  EXPECT_EQ(0, mempool_create(FOUR_KB, TWELVE_KB, EIGHT_KB, TWENTYFOUR_KB,
+                              (func_log_callback_type)NULL,
+                              ENABLE_LOCKING | ENABLE_THREAD_CACHE,
+                              &first_handle));
+
+  void *buf = mempool_getbuffer(first_handle, FOUR_KB);
+  EXPECT_TRUE(buf != NULL);
+
+  // Whole free list was moved to thread's cache
+  EXPECT_EQ(0, mempool_getinfo(first_handle, &firstpass_pool_details));
+  EXPECT_EQ(0, firstpass_pool_details.free_bufs_in_pool);
+  EXPECT_EQ(3, firstpass_pool_details.number_of_bufs_shared);
+  EXPECT_EQ(3, firstpass_pool_details.total_bufs_allocated_by_pool);
+
+  EXPECT_EQ(0, mempool_releasebuffer(first_handle, buf, FOUR_KB));
+  EXPECT_EQ(buf, mempool_getbuffer(first_handle, FOUR_KB));
+  EXPECT_EQ(0, mempool_releasebuffer(first_handle, buf, FOUR_KB));
+
+  EXPECT_EQ(0, mempool_getinfo(first_handle, &secondpass_pool_details));
+  EXPECT_EQ(0, secondpass_pool_details.free_bufs_in_pool);
+  EXPECT_EQ(3, secondpass_pool_details.total_bufs_allocated_by_pool);
+
+  EXPECT_EQ(0, mempool_destroy(&first_handle));
+}
+
+// Thread cache does not let the pool cross its max threshold
+TEST_F(MempoolSelfCreateTestSuite, ThreadCacheMaxThresholdTest) {
+  EXPECT_EQ(0, mempool_create(FOUR_KB, 0, FOUR_KB, EIGHT_KB,
+                              (func_log_callback_type)NULL,
+                              ENABLE_LOCKING | ENABLE_THREAD_CACHE,
+                              &first_handle));
+
+  void *first_buf = mempool_getbuffer(first_handle, FOUR_KB);
+  EXPECT_TRUE(first_buf != NULL);
+  void *second_buf = mempool_getbuffer(first_handle, FOUR_KB);
+  EXPECT_TRUE(second_buf != NULL);
+  EXPECT_TRUE(mempool_getbuffer(first_handle, FOUR_KB) == NULL);
+
+  mempool_releasebuffer(first_handle, first_buf, FOUR_KB);
+  mempool_releasebuffer(first_handle, second_buf, FOUR_KB);
+  mempool_destroy(&first_handle);
+}
+
+// Buffers cached by a thread go back to pool's free list when it exits,
+// including ones allocated by another thread
+TEST_F(MempoolSelfCreateTestSuite, ThreadCacheDrainedOnThreadExitTest) {
+  EXPECT_EQ(0, mempool_create(FOUR_KB, TWELVE_KB, EIGHT_KB, TWENTYFOUR_KB,
+                              (func_log_callback_type)NULL,
+                              ENABLE_LOCKING | ENABLE_THREAD_CACHE,
+                              &first_handle));
+
+  void *buf = NULL;
+  std::thread allocator([&]() {
+    buf = mempool_getbuffer(first_handle, FOUR_KB);
+    void *other_buf = mempool_getbuffer(first_handle, FOUR_KB);
+    mempool_releasebuffer(first_handle, other_buf, FOUR_KB);
+  });
+  allocator.join();
+  EXPECT_TRUE(buf != NULL);
+
+  std::thread releaser(
+      [&]() { mempool_releasebuffer(first_handle, buf, FOUR_KB); });
+  releaser.join();
+
+  EXPECT_EQ(0, mempool_getinfo(first_handle, &firstpass_pool_details));
+  EXPECT_EQ(0, firstpass_pool_details.number_of_bufs_shared);
+  EXPECT_EQ(firstpass_pool_details.total_bufs_allocated_by_pool,
+            firstpass_pool_details.free_bufs_in_pool);
+
+  mempool_destroy(&first_handle);
+}
+
+// Buffers cached by a thread which only releases go back to the pool's free
+// list once another thread finds the pool at its max threshold
+TEST_F(MempoolSelfCreateTestSuite, ThreadCacheStarvedPoolTest) {
+  EXPECT_EQ(0, mempool_create(FOUR_KB, 0, FOUR_KB, TWELVE_KB,
+                              (func_log_callback_type)NULL,
+                              ENABLE_LOCKING | ENABLE_THREAD_CACHE,
+                              &first_handle));
+
+  void *bufs[3];
+  for (int i = 0; i < 3; i++) {
+    bufs[i] = mempool_getbuffer(first_handle, FOUR_KB);
+    EXPECT_TRUE(bufs[i] != NULL);
+  }
+  EXPECT_TRUE(mempool_getbuffer(first_handle, FOUR_KB) == NULL);
+
+  std::thread releaser([&]() {
+    for (int i = 0; i < 3; i++) {
+      mempool_releasebuffer(first_handle, bufs[i], FOUR_KB);
+    }
+    // Still running, so nothing was drained on thread exit
+    EXPECT_EQ(0, mempool_getinfo(first_handle, &firstpass_pool_details));
+    EXPECT_EQ(3, firstpass_pool_details.free_bufs_in_pool);
+    EXPECT_EQ(0, firstpass_pool_details.number_of_bufs_shared);
+  });
+  releaser.join();
+
+  void *buf = mempool_getbuffer(first_handle, FOUR_KB);
+  EXPECT_TRUE(buf != NULL);
+  mempool_releasebuffer(first_handle, buf, FOUR_KB);
+  mempool_destroy(&first_handle);
+}
+
 int main(int argc, char **argv) {
   int rc;
 
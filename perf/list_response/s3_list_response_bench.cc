@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+/*
+   Microbenchmark of the two ListObjects response paths on full pages:
+   get_xml(), which keeps the metadata of every listed key until the page
+   is done and sends the response as one string, against streaming mode,
+   where each entry is serialized as it is listed and the response goes out
+   through RequestObject::send_reply_chunk*() the way
+   S3GetBucketAction::send_object_list_in_chunks() sends it.
+
+   Metadata of each key is created while it is listed and only the response
+   keeps it, so the count of live metadata objects shows what a page holds.
+   Replies are moved to a sink buffer by an EvhtpWrapper which does not
+   write to any connection.
+
+   Usage, from the directory holding s3config-test.yaml:
+   ./s3listresponsebench [keys_per_page] [pages]
+   e.g. ./s3listresponsebench 1000 100
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <event2/buffer.h>
+
+extern "C" {
+#include "motr/client.h"
+}
+
+#include "evhtp_wrapper.h"
+#include "s3_log.h"
+#include "s3_mem_pool_manager.h"
+#include "s3_object_list_response.h"
+#include "s3_object_metadata.h"
+#include "s3_option.h"
+#include "s3_request_object.h"
+#include "s3_stats.h"
+
+// Some declarations from s3server that are required to get compiled.
+const char *auth_ip_addr = "127.0.0.1";
+uint16_t auth_port = 8095;
+extern int s3log_level;
+struct m0_uint128 global_bucket_list_index_oid;
+struct m0_uint128 bucket_metadata_list_index_oid;
+struct m0_uint128 global_probable_dead_object_list_index_oid;
+struct m0_uint128 global_object_data_refs_index_oid;
+struct m0_uint128 global_instance_id;
+S3Option *g_option_instance = NULL;
+evhtp_ssl_ctx_t *g_ssl_auth_ctx;
+extern S3Stats *g_stats_instance;
+pthread_t global_tid_indexop;
+pthread_t global_tid_objop;
+int global_shutdown_in_progress;
+int shutdown_motr_teardown_called;
+std::set<struct s3_motr_op_context *> global_motr_object_ops_list;
+std::set<struct s3_motr_idx_op_context *> global_motr_idx_ops_list;
+std::set<struct s3_motr_idx_context *> global_motr_idx;
+std::set<struct s3_motr_obj_context *> global_motr_obj;
+
+struct m0 instance;
+
+static void dummy_request_cb(evhtp_request_t *req, void *arg) {}
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Moves replies into a sink buffer instead of a connection.
+class BenchEvhtpWrapper : public EvhtpWrapper {
+  struct evbuffer *sink;
+
+ public:
+  size_t bytes_sent = 0;
+
+  BenchEvhtpWrapper() : sink(evbuffer_new()) {}
+  ~BenchEvhtpWrapper() { evbuffer_free(sink); }
+
+  void http_send_reply(evhtp_request_t *request, evhtp_res code) {
+    consume(request->buffer_out);
+  }
+  void http_send_reply_chunk_start(evhtp_request_t *request,
+                                   evhtp_res code) {}
+  void http_send_reply_chunk(evhtp_request_t *request, evbuf_t *buf) {
+    consume(buf);
+  }
+  void http_send_reply_chunk_end(evhtp_request_t *request) {}
+
+  void consume(struct evbuffer *buf) {
+    bytes_sent += ::evbuffer_get_length(buf);
+    evbuffer_add_buffer(sink, buf);
+    evbuffer_drain(sink, ::evbuffer_get_length(sink));
+  }
+};
+
+struct PageResult {
+  size_t bytes_sent = 0;
+  // Metadata objects alive when the last key of the page was listed
+  size_t metadata_held = 0;
+};
+
+static PageResult send_page(evbase_t *evbase, bool streaming,
+                            size_t keys_per_page) {
+  const std::string canonical_id = "qWwZGnGYTga8gbpcuY79SA";
+  evhtp_request_t *ev_req = evhtp_request_new(dummy_request_cb, evbase);
+  BenchEvhtpWrapper *evhtp_obj = new BenchEvhtpWrapper();
+  PageResult result;
+  {
+    auto request = std::make_shared<S3RequestObject>(ev_req, evhtp_obj);
+    S3ObjectListResponse response;
+    response.set_bucket_name("seagatebucket");
+    response.set_max_keys(std::to_string(keys_per_page));
+    if (streaming) {
+      response.enable_streaming(canonical_id, "1", "1");
+    }
+    std::vector<std::weak_ptr<S3ObjectMetadata>> listed;
+    for (size_t i = 0; i < keys_per_page; ++i) {
+      auto object = std::make_shared<S3ObjectMetadata>(
+          request, "seagatebucket", "dir/object-" + std::to_string(i));
+      object->set_md5("d41d8cd98f00b204e9800998ecf8427e");
+      object->set_content_length(std::to_string(i * 4096));
+      response.add_object(object);
+      listed.push_back(object);
+    }
+    for (auto &&object : listed) {
+      if (!object.expired()) {
+        ++result.metadata_held;
+      }
+    }
+
+    if (streaming) {
+      std::string xml_head = response.get_xml_head();
+      std::string xml_tail = response.get_xml_tail();
+      std::string &contents_xml = response.get_contents_xml();
+      request->set_out_header_value("Content-Type", "application/xml");
+      request->send_reply_chunk_start(S3HttpSuccess200);
+      request->send_reply_chunk(xml_head.c_str(), xml_head.length());
+      request->send_reply_chunk(contents_xml.c_str(), contents_xml.length());
+      request->send_reply_chunk(xml_tail.c_str(), xml_tail.length());
+      request->send_reply_chunk_end();
+    } else {
+      std::string &response_xml =
+          response.get_xml(canonical_id, "1", "1");
+      request->set_out_header_value("Content-Length",
+                                    std::to_string(response_xml.length()));
+      request->set_out_header_value("Content-Type", "application/xml");
+      request->send_response(S3HttpSuccess200, response_xml);
+    }
+    result.bytes_sent = evhtp_obj->bytes_sent;
+  }
+  evhtp_request_free(ev_req);
+  return result;
+}
+
+static void run(evbase_t *evbase, bool streaming, size_t keys_per_page,
+                size_t pages) {
+  PageResult result;
+  double start = now_sec();
+  for (size_t i = 0; i < pages; ++i) {
+    result = send_page(evbase, streaming, keys_per_page);
+  }
+  double elapsed = now_sec() - start;
+  printf("%-10s %10.1f us per page, %zu bytes sent, %zu metadata held\n",
+         streaming ? "streaming" : "get_xml", elapsed * 1e6 / pages,
+         result.bytes_sent, result.metadata_held);
+}
+
+int main(int argc, char **argv) {
+  size_t keys_per_page = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000;
+  size_t pages = argc > 2 ? strtoul(argv[2], NULL, 10) : 100;
+  if (keys_per_page == 0 || pages == 0) {
+    fprintf(stderr, "Usage: %s [keys_per_page] [pages]\n", argv[0]);
+    return 1;
+  }
+
+  s3log_level = S3_LOG_FATAL;
+  g_option_instance = S3Option::get_instance();
+  g_option_instance->set_option_file("s3config-test.yaml");
+  if (!g_option_instance->load_all_sections(true)) {
+    fprintf(stderr, "Failed to load s3config-test.yaml\n");
+    return 1;
+  }
+  g_option_instance->set_stats_allowlist_filename(
+      "s3stats-allowlist-test.yaml");
+  g_stats_instance = S3Stats::get_instance();
+
+  size_t pool_buffer_size = g_option_instance->get_libevent_pool_buffer_size();
+  if (event_use_mempool(pool_buffer_size, pool_buffer_size * 100,
+                        pool_buffer_size * 100, pool_buffer_size * 1000,
+                        CREATE_ALIGNED_MEMORY) != 0) {
+    fprintf(stderr, "Failed to create libevent memory pool\n");
+    return 1;
+  }
+
+  evbase_t *evbase = event_base_new();
+  printf("%zu pages of %zu keys\n", pages, keys_per_page);
+  run(evbase, false, keys_per_page, pages);
+  run(evbase, true, keys_per_page, pages);
+  event_base_free(evbase);
+
+  event_destroy_mempool();
+  S3Stats::delete_instance();
+  S3Option::destroy_instance();
+  return 0;
+}
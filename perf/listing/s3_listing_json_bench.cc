@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+/*
+   Microbenchmark of per key CPU cost of object listing metadata parsing:
+   the full jsoncpp parse done by S3ObjectMetadata::from_json() against the
+   S3JsonScanner pass of S3ObjectMetadata::from_listing_json(), which only
+   picks the fields a ListObjects entry needs.
+
+   Usage:
+   ./s3listingjsonbench [key_count] [user_attribute_count]
+   e.g. ./s3listingjsonbench 100000 4
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <json/json.h>
+
+#include "s3_json_scanner.h"
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+struct ListingEntry {
+  std::string object_name;
+  std::map<std::string, std::string> system_defined_attribute;
+};
+
+// Object metadata as written by S3ObjectMetadata::to_json().
+static std::string make_metadata(size_t i, size_t user_attribute_count) {
+  Json::Value root;
+  root["Bucket-Name"] = "seagatebucket";
+  root["Object-Name"] = "dir" + std::to_string(i % 100) + "/object-" +
+                        std::to_string(i);
+  root["Object-URI"] = "seagatebucket\\dir/object-" + std::to_string(i);
+  root["layout_id"] = 9;
+  root["motr_oid"] = "Tlpb/gEAAAA=-AwAAAAAAqYk=";
+  Json::Value &sys = root["System-Defined"];
+  sys["Content-Length"] = std::to_string(i * 4096);
+  sys["Content-MD5"] = "d41d8cd98f00b204e9800998ecf8427e";
+  sys["Content-Type"] = "application/octet-stream";
+  sys["Date"] = "2020-11-11T11:11:11.000Z";
+  sys["Last-Modified"] = "2020-11-11T11:11:11.000Z";
+  sys["Owner-Account"] = "s3user";
+  sys["Owner-Account-id"] = "123456789012";
+  sys["Owner-Canonical-id"] = "qWwZGnGYTga8gbpcuY79SA";
+  sys["Owner-User"] = "root";
+  sys["Owner-User-id"] = "AIDAJ2J6OYS5PSG6JSGCO";
+  sys["x-amz-server-side-encryption"] = "None";
+  sys["x-amz-storage-class"] = "STANDARD";
+  sys["x-amz-version-id"] = "Njc3MzYyNDQ0MTAzMjk4MzcxMDE";
+  for (size_t a = 0; a < user_attribute_count; ++a) {
+    root["User-Defined"]["x-amz-meta-attr" + std::to_string(a)] =
+        "value-" + std::to_string(a);
+  }
+  root["ACL"] = std::string(600, 'A');
+  root["create_timestamp"] = "2020-11-11T11:11:11.000Z";
+  Json::FastWriter writer;
+  return writer.write(root);
+}
+
+// What S3ObjectMetadata::from_json() does.
+static bool parse_full(const std::string &content, ListingEntry &entry) {
+  Json::Value root;
+  Json::Reader reader;
+  if (!reader.parse(content.c_str(), root)) {
+    return false;
+  }
+  std::map<std::string, std::string> user_defined_attribute;
+  std::string bucket_name = root["Bucket-Name"].asString();
+  entry.object_name = root["Object-Name"].asString();
+  std::string object_key_uri = root["Object-URI"].asString();
+  std::string motr_oid_str = root["motr_oid"].asString();
+  int layout_id = root["layout_id"].asInt();
+  (void)layout_id;
+  Json::Value::Members members = root["System-Defined"].getMemberNames();
+  for (auto it : members) {
+    entry.system_defined_attribute[it.c_str()] =
+        root["System-Defined"][it].asString().c_str();
+  }
+  members = root["User-Defined"].getMemberNames();
+  for (auto it : members) {
+    user_defined_attribute[it.c_str()] =
+        root["User-Defined"][it].asString().c_str();
+  }
+  std::string encoded_acl = root["ACL"].asString();
+  return true;
+}
+
+static bool is_listing_attribute(const std::string &name) {
+  return name == "Content-Length" || name == "Content-MD5" ||
+         name == "Last-Modified" || name == "x-amz-storage-class" ||
+         name == "Owner-Canonical-id" || name == "Owner-Account" ||
+         name == "Owner-User" || name == "Owner-User-id" ||
+         name == "Owner-Account-id";
+}
+
+// What S3ObjectMetadata::from_listing_json() does.
+static bool parse_listing(const std::string &content, ListingEntry &entry) {
+  S3JsonScanner scanner(content);
+  std::string key, value, bucket_name;
+  if (scanner.enter_object()) {
+    while (scanner.next_member(key)) {
+      if (key == "Bucket-Name") {
+        scanner.read_string(bucket_name);
+      } else if (key == "Object-Name") {
+        scanner.read_string(entry.object_name);
+      } else if (key == "System-Defined" && scanner.enter_object()) {
+        while (scanner.next_member(key)) {
+          if (is_listing_attribute(key) && scanner.read_string(value)) {
+            entry.system_defined_attribute[key] = value;
+          } else {
+            scanner.skip_value();
+          }
+        }
+      } else {
+        scanner.skip_value();
+      }
+    }
+  }
+  return !scanner.failed();
+}
+
+static double run(bool (*parse)(const std::string &, ListingEntry &),
+                  const std::vector<std::string> &metadata,
+                  std::vector<ListingEntry> &entries) {
+  entries.clear();
+  double start = now_sec();
+  for (const auto &content : metadata) {
+    // Listing creates a fresh metadata object per key.
+    ListingEntry entry;
+    if (!parse(content, entry)) {
+      fprintf(stderr, "Parsing failed\n");
+      exit(1);
+    }
+    entries.push_back(std::move(entry));
+  }
+  return now_sec() - start;
+}
+
+int main(int argc, char **argv) {
+  size_t key_count = argc > 1 ? strtoul(argv[1], NULL, 10) : 100000;
+  size_t user_attribute_count = argc > 2 ? strtoul(argv[2], NULL, 10) : 4;
+  const int iterations = 3;
+
+  if (key_count == 0) {
+    fprintf(stderr, "Usage: %s [key_count] [user_attribute_count]\n",
+            argv[0]);
+    return 1;
+  }
+
+  std::vector<std::string> metadata;
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < key_count; ++i) {
+    metadata.push_back(make_metadata(i, user_attribute_count));
+    total_bytes += metadata.back().length();
+  }
+
+  std::vector<ListingEntry> full_entries, listing_entries;
+  double full_best = 0, listing_best = 0;
+  for (int i = 0; i < iterations; ++i) {
+    double t = run(parse_full, metadata, full_entries);
+    if (full_best == 0 || t < full_best) {
+      full_best = t;
+    }
+    t = run(parse_listing, metadata, listing_entries);
+    if (listing_best == 0 || t < listing_best) {
+      listing_best = t;
+    }
+  }
+
+  for (size_t i = 0; i < key_count; ++i) {
+    auto &listed = listing_entries[i].system_defined_attribute;
+    auto &full = full_entries[i].system_defined_attribute;
+    bool same = listing_entries[i].object_name == full_entries[i].object_name;
+    for (auto &attr : listed) {
+      same = same && full[attr.first] == attr.second;
+    }
+    if (!same || listed.size() != 9) {
+      fprintf(stderr, "Listing fields differ for key %zu\n", i);
+      return 1;
+    }
+  }
+
+  printf("%zu keys, %zu bytes of metadata per key\n", key_count,
+         total_bytes / key_count);
+  printf("%-22s %8.0f ns/key\n", "jsoncpp from_json",
+         full_best * 1e9 / key_count);
+  printf("%-22s %8.0f ns/key (%.2fx)\n", "scanner listing json",
+         listing_best * 1e9 / key_count, full_best / listing_best);
+  return 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+/*
+   Microbenchmark of aggregate MD5 throughput over many concurrent streams,
+   as seen by the hash workers of concurrent PUTs: the OpenSSL MD5_Update
+   path, one stream after another, against MD5hash::UpdateMulti() which
+   interleaves the streams on SIMD lanes.
+
+   Usage:
+   ./s3md5bench [stream_count] [mb_per_stream] [buffer_kb]
+   e.g. ./s3md5bench 64 16 16
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "s3_md5_hash.h"
+#include "s3_md5_mb.h"
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Returns seconds taken, digests of all streams go to 'digests'.
+static double run(bool multi, const std::vector<S3BufferSequence> &streams,
+                  std::vector<std::string> &digests) {
+  std::vector<MD5hash> hashes(streams.size());
+  double start = now_sec();
+  if (multi) {
+    std::vector<std::pair<MD5hash *, S3BufferSequence>> inputs;
+    for (size_t i = 0; i < streams.size(); ++i) {
+      inputs.emplace_back(&hashes[i], streams[i]);
+    }
+    MD5hash::UpdateMulti(inputs);
+  } else {
+    for (size_t i = 0; i < streams.size(); ++i) {
+      for (const auto &buf : streams[i]) {
+        hashes[i].Update((const char *)buf.first, buf.second);
+      }
+    }
+  }
+  for (auto &hash : hashes) {
+    hash.Finalize();
+  }
+  double elapsed = now_sec() - start;
+
+  digests.clear();
+  for (auto &hash : hashes) {
+    digests.push_back(hash.get_md5_string());
+  }
+  return elapsed;
+}
+
+int main(int argc, char **argv) {
+  size_t stream_count = argc > 1 ? strtoul(argv[1], NULL, 10) : 64;
+  size_t mb_per_stream = argc > 2 ? strtoul(argv[2], NULL, 10) : 16;
+  size_t buffer_size = (argc > 3 ? strtoul(argv[3], NULL, 10) : 16) * 1024;
+  const int iterations = 3;
+
+  if (stream_count == 0 || mb_per_stream == 0 || buffer_size == 0) {
+    fprintf(stderr, "Usage: %s [stream_count] [mb_per_stream] [buffer_kb]\n",
+            argv[0]);
+    return 1;
+  }
+
+  // Each stream is a sequence of buffers, like data read from a PUT.
+  const size_t stream_size = mb_per_stream * 1024 * 1024;
+  std::vector<std::vector<char>> data(stream_count);
+  std::vector<S3BufferSequence> streams(stream_count);
+  for (size_t i = 0; i < stream_count; ++i) {
+    data[i].resize(stream_size);
+    for (size_t j = 0; j < stream_size; ++j) {
+      data[i][j] = (char)(rand() & 0xff);
+    }
+    for (size_t off = 0; off < stream_size; off += buffer_size) {
+      size_t len = std::min(buffer_size, stream_size - off);
+      streams[i].emplace_back(&data[i][off], len);
+    }
+  }
+
+  const double total_gb = (double)stream_count * stream_size / 1e9;
+  std::vector<std::string> scalar_digests, multi_digests;
+  double scalar_best = 0, multi_best = 0;
+
+  S3MD5MultiBuffer::init();
+  const std::string engine = S3MD5MultiBuffer::engine_name();
+  const size_t lanes = S3MD5MultiBuffer::lanes();
+
+  for (int i = 0; i < iterations; ++i) {
+    S3MD5MultiBuffer::use_scalar();
+    double t = run(false, streams, scalar_digests);
+    if (scalar_best == 0 || t < scalar_best) {
+      scalar_best = t;
+    }
+    S3MD5MultiBuffer::init();
+    t = run(true, streams, multi_digests);
+    if (multi_best == 0 || t < multi_best) {
+      multi_best = t;
+    }
+  }
+
+  if (scalar_digests != multi_digests) {
+    fprintf(stderr, "Digest mismatch between scalar and multi-buffer MD5\n");
+    return 1;
+  }
+
+  printf("streams %zu x %zu MB, buffers of %zu KB\n", stream_count,
+         mb_per_stream, buffer_size / 1024);
+  printf("%-24s %8.3f GB/s\n", "openssl MD5_Update", total_gb / scalar_best);
+  printf("multi-buffer %-6s x%-4zu %8.3f GB/s (%.2fx)\n", engine.c_str(),
+         lanes, total_gb / multi_best, scalar_best / multi_best);
+  return 0;
+}
@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+/*
+   Microbenchmark of per record CPU cost and heap allocations of object
+   metadata serialization: jsoncpp, as done by S3ObjectMetadata::to_json()
+   and from_json(), against the binary form of s3_metadata_codec.h used when
+   S3_SERVER_METADATA_BINARY_ENCODING is enabled.
+
+   Usage:
+   ./s3metadatabench [record_count] [user_attribute_count]
+   e.g. ./s3metadatabench 100000 4
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <json/json.h>
+
+#include "base64.h"
+#include "s3_metadata_codec.h"
+
+static size_t allocation_count = 0;
+
+void *operator new(size_t size) {
+  ++allocation_count;
+  void *p = malloc(size ? size : 1);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void *p) noexcept { free(p); }
+
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Fields of S3ObjectMetadata saved in a record.
+struct ObjectRecord {
+  std::string bucket_name;
+  std::string object_name;
+  std::string object_key_uri;
+  int layout_id = 0;
+  std::string motr_oid_str;
+  std::map<std::string, std::string> system_defined_attribute;
+  std::map<std::string, std::string> user_defined_attribute;
+  std::string encoded_acl;
+  std::string create_timestamp;
+};
+
+static ObjectRecord make_record(size_t i, size_t user_attribute_count) {
+  ObjectRecord rec;
+  rec.bucket_name = "seagatebucket";
+  rec.object_name =
+      "dir" + std::to_string(i % 100) + "/object-" + std::to_string(i);
+  rec.object_key_uri = rec.bucket_name + "\\" + rec.object_name;
+  rec.layout_id = 9;
+  rec.motr_oid_str = "Tlpb/gEAAAA=-AwAAAAAAqYk=";
+  auto &sys = rec.system_defined_attribute;
+  sys["Content-Length"] = std::to_string(i * 4096);
+  sys["Content-MD5"] = "d41d8cd98f00b204e9800998ecf8427e";
+  sys["Content-Type"] = "application/octet-stream";
+  sys["Date"] = "2020-11-11T11:11:11.000Z";
+  sys["Last-Modified"] = "2020-11-11T11:11:11.000Z";
+  sys["Owner-Account"] = "s3user";
+  sys["Owner-Account-id"] = "123456789012";
+  sys["Owner-Canonical-id"] = "qWwZGnGYTga8gbpcuY79SA";
+  sys["Owner-User"] = "root";
+  sys["Owner-User-id"] = "AIDAJ2J6OYS5PSG6JSGCO";
+  sys["x-amz-server-side-encryption"] = "None";
+  sys["x-amz-storage-class"] = "STANDARD";
+  sys["x-amz-version-id"] = "Njc3MzYyNDQ0MTAzMjk4MzcxMDE";
+  for (size_t a = 0; a < user_attribute_count; ++a) {
+    rec.user_defined_attribute["x-amz-meta-attr" + std::to_string(a)] =
+        "value-" + std::to_string(a);
+  }
+  // Default ACL of an object owned by its creator.
+  std::string acl =
+      "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>"
+      "<AccessControlPolicy "
+      "xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">\n <Owner>\n  "
+      "<ID>6864c7e6e64b48e8bb2434e7c3d3ac8d44aadb66f1c34ef8a32cffd9eeea0156"
+      "</ID>\n  <DisplayName>s3user</DisplayName>\n </Owner>\n "
+      "<AccessControlList>\n  <Grant>\n   <Grantee "
+      "xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" "
+      "xsi:type=\"CanonicalUser\">\n    "
+      "<ID>6864c7e6e64b48e8bb2434e7c3d3ac8d44aadb66f1c34ef8a32cffd9eeea0156"
+      "</ID>\n    <DisplayName>s3user</DisplayName>\n   </Grantee>\n   "
+      "<Permission>FULL_CONTROL</Permission>\n  </Grant>\n "
+      "</AccessControlList>\n</AccessControlPolicy>\n";
+  rec.encoded_acl =
+      base64_encode((const unsigned char *)acl.c_str(), acl.length());
+  rec.create_timestamp = "2020-11-11T11:11:11.000Z";
+  return rec;
+}
+
+static std::string to_json(const ObjectRecord &rec) {
+  Json::Value root;
+  root["Bucket-Name"] = rec.bucket_name;
+  root["Object-Name"] = rec.object_name;
+  root["Object-URI"] = rec.object_key_uri;
+  root["layout_id"] = rec.layout_id;
+  root["motr_oid"] = rec.motr_oid_str;
+  for (auto sit : rec.system_defined_attribute) {
+    root["System-Defined"][sit.first] = sit.second;
+  }
+  for (auto uit : rec.user_defined_attribute) {
+    root["User-Defined"][uit.first] = uit.second;
+  }
+  root["ACL"] = rec.encoded_acl;
+  root["create_timestamp"] = rec.create_timestamp;
+  Json::FastWriter fastWriter;
+  return fastWriter.write(root);
+}
+
+static bool from_json(const std::string &content, ObjectRecord &rec) {
+  Json::Value newroot;
+  Json::Reader reader;
+  if (!reader.parse(content.c_str(), newroot)) {
+    return false;
+  }
+  rec.bucket_name = newroot["Bucket-Name"].asString();
+  rec.object_name = newroot["Object-Name"].asString();
+  rec.object_key_uri = newroot["Object-URI"].asString();
+  rec.motr_oid_str = newroot["motr_oid"].asString();
+  rec.layout_id = newroot["layout_id"].asInt();
+  Json::Value::Members members = newroot["System-Defined"].getMemberNames();
+  for (auto it : members) {
+    rec.system_defined_attribute[it.c_str()] =
+        newroot["System-Defined"][it].asString().c_str();
+  }
+  members = newroot["User-Defined"].getMemberNames();
+  for (auto it : members) {
+    rec.user_defined_attribute[it.c_str()] =
+        newroot["User-Defined"][it].asString().c_str();
+  }
+  rec.encoded_acl = newroot["ACL"].asString();
+  return true;
+}
+
+static std::string to_binary(const ObjectRecord &rec) {
+  std::string record;
+  S3MetadataEncoder encoder(record, S3MetadataRecord::object);
+  encoder.add_string(S3MetadataField::bucket_name, rec.bucket_name);
+  encoder.add_string(S3MetadataField::object_name, rec.object_name);
+  encoder.add_string(S3MetadataField::object_uri, rec.object_key_uri);
+  encoder.add_integer(S3MetadataField::layout_id, rec.layout_id);
+  encoder.add_string(S3MetadataField::motr_oid, rec.motr_oid_str);
+  encoder.add_map(S3MetadataField::system_defined,
+                  rec.system_defined_attribute);
+  encoder.add_map(S3MetadataField::user_defined, rec.user_defined_attribute);
+  encoder.add_base64(S3MetadataField::acl, S3MetadataField::acl_as_stored,
+                     rec.encoded_acl);
+  encoder.add_string(S3MetadataField::create_timestamp,
+                     rec.create_timestamp);
+  return record;
+}
+
+static bool from_binary(const std::string &content, ObjectRecord &rec) {
+  S3MetadataDecoder decoder(content);
+  S3MetadataField field;
+  int64_t number;
+  while (decoder.next_field(field)) {
+    switch (field) {
+      case S3MetadataField::bucket_name:
+        decoder.read_string(rec.bucket_name);
+        break;
+      case S3MetadataField::object_name:
+        decoder.read_string(rec.object_name);
+        break;
+      case S3MetadataField::object_uri:
+        decoder.read_string(rec.object_key_uri);
+        break;
+      case S3MetadataField::layout_id:
+        if (decoder.read_integer(number)) {
+          rec.layout_id = (int)number;
+        }
+        break;
+      case S3MetadataField::motr_oid:
+        decoder.read_string(rec.motr_oid_str);
+        break;
+      case S3MetadataField::system_defined:
+        decoder.read_map(rec.system_defined_attribute);
+        break;
+      case S3MetadataField::user_defined:
+        decoder.read_map(rec.user_defined_attribute);
+        break;
+      case S3MetadataField::acl:
+        decoder.read_base64(rec.encoded_acl);
+        break;
+      default:
+        decoder.skip_field();
+        break;
+    }
+  }
+  return !decoder.failed();
+}
+
+struct Result {
+  double seconds = 0;
+  size_t allocations = 0;
+};
+
+static Result run_serialize(std::string (*serialize)(const ObjectRecord &),
+                            const std::vector<ObjectRecord> &records,
+                            std::vector<std::string> &out) {
+  out.clear();
+  out.reserve(records.size());
+  Result result;
+  size_t start_allocations = allocation_count;
+  double start = now_sec();
+  for (const auto &rec : records) {
+    out.push_back(serialize(rec));
+  }
+  result.seconds = now_sec() - start;
+  result.allocations = allocation_count - start_allocations;
+  return result;
+}
+
+static Result run_parse(bool (*parse)(const std::string &, ObjectRecord &),
+                        const std::vector<std::string> &contents,
+                        std::vector<ObjectRecord> &out) {
+  out.clear();
+  out.reserve(contents.size());
+  Result result;
+  size_t start_allocations = allocation_count;
+  double start = now_sec();
+  for (const auto &content : contents) {
+    // Every load fills a fresh metadata object.
+    out.emplace_back();
+    if (!parse(content, out.back())) {
+      fprintf(stderr, "Parsing failed\n");
+      exit(1);
+    }
+  }
+  result.seconds = now_sec() - start;
+  result.allocations = allocation_count - start_allocations;
+  return result;
+}
+
+static void keep_best(Result &best, const Result &result) {
+  if (best.seconds == 0 || result.seconds < best.seconds) {
+    best = result;
+  }
+}
+
+static bool same(const ObjectRecord &a, const ObjectRecord &b) {
+  return a.bucket_name == b.bucket_name && a.object_name == b.object_name &&
+         a.object_key_uri == b.object_key_uri && a.layout_id == b.layout_id &&
+         a.motr_oid_str == b.motr_oid_str &&
+         a.system_defined_attribute == b.system_defined_attribute &&
+         a.user_defined_attribute == b.user_defined_attribute &&
+         a.encoded_acl == b.encoded_acl;
+}
+
+int main(int argc, char **argv) {
+  size_t record_count = argc > 1 ? strtoul(argv[1], NULL, 10) : 100000;
+  size_t user_attribute_count = argc > 2 ? strtoul(argv[2], NULL, 10) : 4;
+  const int iterations = 3;
+
+  if (record_count == 0) {
+    fprintf(stderr, "Usage: %s [record_count] [user_attribute_count]\n",
+            argv[0]);
+    return 1;
+  }
+
+  std::vector<ObjectRecord> records;
+  for (size_t i = 0; i < record_count; ++i) {
+    records.push_back(make_record(i, user_attribute_count));
+  }
+
+  std::vector<std::string> json, binary;
+  std::vector<ObjectRecord> json_parsed, binary_parsed;
+  Result json_write, binary_write, json_read, binary_read;
+  for (int i = 0; i < iterations; ++i) {
+    keep_best(json_write, run_serialize(to_json, records, json));
+    keep_best(binary_write, run_serialize(to_binary, records, binary));
+    keep_best(json_read, run_parse(from_json, json, json_parsed));
+    keep_best(binary_read, run_parse(from_binary, binary, binary_parsed));
+  }
+
+  size_t json_bytes = 0, binary_bytes = 0;
+  for (size_t i = 0; i < record_count; ++i) {
+    if (!same(records[i], json_parsed[i]) ||
+        !same(records[i], binary_parsed[i])) {
+      fprintf(stderr, "Record %zu differs after parsing\n", i);
+      return 1;
+    }
+    json_bytes += json[i].length();
+    binary_bytes += binary[i].length();
+  }
+
+  printf("%zu records, %zu bytes json, %zu bytes binary per record\n",
+         record_count, json_bytes / record_count,
+         binary_bytes / record_count);
+  printf("%-16s %8.0f ns/record %6.1f allocations/record\n", "json write",
+         json_write.seconds * 1e9 / record_count,
+         (double)json_write.allocations / record_count);
+  printf("%-16s %8.0f ns/record %6.1f allocations/record (%.2fx)\n",
+         "binary write", binary_write.seconds * 1e9 / record_count,
+         (double)binary_write.allocations / record_count,
+         json_write.seconds / binary_write.seconds);
+  printf("%-16s %8.0f ns/record %6.1f allocations/record\n", "json read",
+         json_read.seconds * 1e9 / record_count,
+         (double)json_read.allocations / record_count);
+  printf("%-16s %8.0f ns/record %6.1f allocations/record (%.2fx)\n",
+         "binary read", binary_read.seconds * 1e9 / record_count,
+         (double)binary_read.allocations / record_count,
+         json_read.seconds / binary_read.seconds);
+  return 0;
+}
@@ -345,6 +345,16 @@ class CORTXS3Config(object):
                 "Could not parse probable delete index-id from config file " +
                 self._conf_file)
 
+    def get_object_data_refs_index_id(self):
+        """Return object data refs index-id from config file or KeyError."""
+        try:
+          object_data_refs_index_id = self.s3confstore.get_config('indexid>object_data_refs_index_id')
+          return object_data_refs_index_id
+        except:
+            raise KeyError(
+                "Could not parse object data refs index-id from config file " +
+                self._conf_file)
+
     def get_max_keys(self):
         """Return maximum number of keys from config file or KeyError."""
         max_keys = self.s3confstore.get_config('indexid>max_keys')
@@ -69,8 +69,56 @@ class ObjectRecoveryValidator:
         timedelta_mns = math.floor(timedelta.total_seconds()/60)
         return (timedelta_mns >= older_in_mins)
 
+    def is_object_data_referred(self, obj_oid):
+        """
+        Checks if data of obj_oid is still referred by any object (CopyObject lets
+        objects share data). Drops references of objects which do not refer the
+        data any more. Returns (status, referred).
+        """
+        refs_index_id = self.config.get_object_data_refs_index_id()
+        refs_prefix = obj_oid + "/"
+        extra_qparam = {'Prefix':refs_prefix}
+        ret, response_data = self._indexapi.list(refs_index_id,
+            self.config.get_max_keys(), None, extra_qparam)
+        if (not ret):
+            if (response_data.get_error_status() == 404):
+                # No object ever shared data, so data is not referred.
+                return True, False
+            self.logAPIResponse("LIST DATA REFS", refs_index_id, refs_prefix, response_data)
+            return False, False
+
+        data_refs = response_data.get_index_content()
+        referred = False
+        if (data_refs["Keys"] is not None):
+            for data_ref in data_refs["Keys"]:
+                ref_info = json.loads(data_ref["Value"])
+                status, object_md = self.get_object_metadata(
+                    ref_info["object_list_index_oid"], ref_info["object_key_in_index"])
+                if (not status):
+                    return False, False
+                if (object_md is not None and object_md["motr_oid"] == obj_oid):
+                    self._logger.info("Obj " + obj_oid + " is referred by object " +
+                                      ref_info["object_key_in_index"])
+                    referred = True
+                else:
+                    # Referring object is deleted or overwritten.
+                    self.delete_key_from_index(refs_index_id, data_ref["Key"], "DATA REFS DEL")
+
+        if (not referred and data_refs["IsTruncated"] == "true"):
+            # Rest of references are checked in next run.
+            referred = True
+        return True, referred
+
     def delete_object_from_storage(self, obj_oid, layout_id):
         status = False
+        ret, referred = self.is_object_data_referred(obj_oid)
+        if (not ret):
+            self._logger.info("Failed to check references of obj " + obj_oid)
+            return status
+        if (referred):
+            # Data is kept until the last object referring it goes away.
+            self._logger.info("Obj " + obj_oid + " is shared, skip deleting it from motr store")
+            return True
         ret, response = self._objectapi.delete(obj_oid, layout_id)
         if (ret):
             status = ret
@@ -267,12 +315,20 @@ class ObjectRecoveryValidator:
             #   Each object oid has 1 '-', seperating high and low values
             # e.g., variable 'probable_delete_oid' contains: "Tgj8AgAAAAA=-kwAAAAAABCY=-Tgj8AgAAAAA=-lgAAAAAABCY="
             # where old obj id is "Tgj8AgAAAAA=-kwAAAAAABCY=" and new obj id is "Tgj8AgAAAAA=-lgAAAAAABCY="
+            # Object sharing data of another object (CopyObject) has key
+            # "<oid>-<object version key>", its old object has key
+            # "<old oid>-<oid>-<object version key>".
             oil_list = self.object_leak_id.split("-")
-            if (oil_list is None or (len(oil_list) not in [2, 4])):
+            if (oil_list is None or len(oil_list) < 2):
                 self._logger.error("The key for old object " + str(self.object_leak_id) +
                                    " is not in the required format 'oldoid-newoid'")
                 return
             self.object_leak_id = oil_list[0] + "-" + oil_list[1]
+        elif (len(self.object_leak_id.split("-")) > 2):
+            # Key "<oid>-<object version key>" of object sharing data of
+            # another object (CopyObject)
+            oil_list = self.object_leak_id.split("-")
+            self.object_leak_id = oil_list[0] + "-" + oil_list[1]
 
         # Determine object leak using information in metadata
         # Below is the implementaion of leak algorithm
@@ -376,4 +376,12 @@ def test_get_probable_delete_index_id_failure():
     with pytest.raises(AssertionError):
         config = CORTXS3Config()
         del config._config['indexid']['probable_delete_index_id']
-        assert config.s3confstore.get_config('indexid>probable_delete_index_id') == ''
\ No newline at end of file
+        assert config.s3confstore.get_config('indexid>probable_delete_index_id') == ''
+
+
+def test_get_object_data_refs_index_id_success():
+    """Test if object data refs index id is returned."""
+    config = CORTXS3Config()
+    config.s3confstore.set_config('indexid>object_data_refs_index_id', 'test_index', False)
+    index_id = config.s3confstore.get_config('indexid>object_data_refs_index_id')
+    assert index_id == "test_index"
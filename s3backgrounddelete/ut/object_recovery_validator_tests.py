@@ -191,4 +191,100 @@ def test_object_metadata_exists_mismatches():
 
     # Assert that object oid delete and leak index entry delete
     # is triggered if metadata doesn't exists.
-    validator.process_probable_delete_record.assert_called == True
\ No newline at end of file
+    validator.process_probable_delete_record.assert_called == True
+
+def test_shared_object_data_not_deleted():
+    """Test if ObjectRecoveryValidator keeps data still referred by another object"""
+    index_api_mock = Mock(spec=CORTXS3IndexApi)
+    kv_api_mock = Mock(spec=CORTXS3KVApi)
+    object_api_mock = Mock(spec=CORTXS3ObjectApi)
+
+    obj_oid = 'Tgj8AgAAAAA=-dQAAAAAABCY='
+    ref_val = {'motr_oid':obj_oid,'object_layout_id':9,'object_key_in_index':'copy_of_object',
+        'object_list_index_oid':'TAifBwAAAHg=-AQAAAAAA2lk=','create_timestamp':'2020-03-17T11:02:13.000Z'}
+    index_content = {'Delimiter': '', 'Index-Id': 'AAAAAAAAAHg=-BQAQAAAAAAA=',
+                    'IsTruncated': 'false',
+                    'Keys': [{'Key': obj_oid + '/TAifBwAAAHg=-AQAAAAAA2lk=/copy_of_object',
+                              'Value': json.dumps(ref_val)}],
+                    'Marker': '', 'MaxKeys': '1000', 'NextMarker': '', 'Prefix': obj_oid + '/'}
+    index_response = CORTXS3ListIndexResponse(json.dumps(index_content).encode())
+
+    # Referring object still has the data oid in its metadata.
+    object_metadata = {'Object-Name':'copy_of_object','layout_id':9,'motr_oid':obj_oid}
+    kv_response = CORTXS3GetKVResponse('copy_of_object', json.dumps(object_metadata).encode())
+
+    index_api_mock.list.return_value = True, index_response
+    kv_api_mock.get.return_value = True, kv_response
+    object_api_mock.delete.return_value = True, {}
+
+    config = CORTXS3Config()
+    probable_delete_records = {'Key': 'J' + obj_oid, 'Value': '{}'}
+    validator = ObjectRecoveryValidator(
+                          config, probable_delete_records, objectapi = object_api_mock, kvapi = kv_api_mock, indexapi = index_api_mock)
+
+    status = validator.delete_object_from_storage(obj_oid, 9)
+
+    # Data is kept and reference of live object is not removed.
+    assert status == True
+    object_api_mock.delete.assert_not_called()
+    kv_api_mock.delete.assert_not_called()
+
+
+def test_unreferred_object_data_deleted():
+    """Test if ObjectRecoveryValidator deletes data once referring objects are gone"""
+    index_api_mock = Mock(spec=CORTXS3IndexApi)
+    kv_api_mock = Mock(spec=CORTXS3KVApi)
+    object_api_mock = Mock(spec=CORTXS3ObjectApi)
+
+    obj_oid = 'Tgj8AgAAAAA=-dQAAAAAABCY='
+    ref_key = obj_oid + '/TAifBwAAAHg=-AQAAAAAA2lk=/copy_of_object'
+    ref_val = {'motr_oid':obj_oid,'object_layout_id':9,'object_key_in_index':'copy_of_object',
+        'object_list_index_oid':'TAifBwAAAHg=-AQAAAAAA2lk=','create_timestamp':'2020-03-17T11:02:13.000Z'}
+    index_content = {'Delimiter': '', 'Index-Id': 'AAAAAAAAAHg=-BQAQAAAAAAA=',
+                    'IsTruncated': 'false', 'Keys': [{'Key': ref_key, 'Value': json.dumps(ref_val)}],
+                    'Marker': '', 'MaxKeys': '1000', 'NextMarker': '', 'Prefix': obj_oid + '/'}
+    index_response = CORTXS3ListIndexResponse(json.dumps(index_content).encode())
+    error_response = CORTXS3ErrorResponse(404, "Not found", "Not found")
+
+    # Referring object was deleted.
+    index_api_mock.list.return_value = True, index_response
+    kv_api_mock.get.return_value = False, error_response
+    kv_api_mock.delete.return_value = True, {}
+    object_api_mock.delete.return_value = True, {}
+
+    config = CORTXS3Config()
+    probable_delete_records = {'Key': 'J' + obj_oid, 'Value': '{}'}
+    validator = ObjectRecoveryValidator(
+                          config, probable_delete_records, objectapi = object_api_mock, kvapi = kv_api_mock, indexapi = index_api_mock)
+
+    status = validator.delete_object_from_storage(obj_oid, 9)
+
+    # Stale reference is dropped and data is deleted.
+    assert status == True
+    kv_api_mock.delete.assert_called_with(config.get_object_data_refs_index_id(), ref_key)
+    object_api_mock.delete.assert_called_with(obj_oid, 9)
+
+def test_shared_object_data_record_key():
+    """Test if ObjectRecoveryValidator takes oid from key of record of object sharing data"""
+    obj_oid = 'Tgj8AgAAAAA=-dQAAAAAABCY='
+    version_key = 'copy-of-object/18446742489333709430'
+    config = CORTXS3Config()
+
+    # Copy is a new object, or it overwrites an old object.
+    for old_oid in ['AAAAAAAAAAA=-AAAAAAAAAAA=', 'Tgj8AgAAAAA=-kwAAAAAABCY=']:
+        leak_info = {'motr_process_fid':'<0x7200000000000000:0>','create_timestamp':'2020-03-16T16:24:04.000Z',
+            'force_delete':'false','global_instance_id':'TAifBwAAAAA=-AAAAAAAA2lk=','is_multipart':'false',
+            'object_key_in_index':'copy-of-object','object_layout_id':9,
+            'object_list_index_oid':'TAifBwAAAHg=-AQAAAAAA2lk=',
+            'objects_version_list_index_oid':'TAifBwAAAHg=-AwAAAAAA2lk=','old_oid':old_oid,
+            'version_key_in_index':version_key}
+        probable_delete_records = {'Key': 'J' + obj_oid + '-' + version_key, 'Value': json.dumps(leak_info)}
+        validator = ObjectRecoveryValidator(
+                          config, probable_delete_records, objectapi = Mock(spec=CORTXS3ObjectApi),
+                          kvapi = Mock(spec=CORTXS3KVApi), indexapi = Mock(spec=CORTXS3IndexApi))
+        validator.process_object_leak = MagicMock()
+
+        validator.process_results()
+
+        assert validator.object_leak_id == obj_oid
+        validator.process_object_leak.assert_called_once_with()
@@ -28,6 +28,10 @@ extern "C" {
 
 #include <evhtp.h>
 
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
 #include "s3_mem_pool_manager.h"
 #include "s3_option.h"
 #include "s3_stats.h"
@@ -43,6 +47,7 @@ extern "C" {
 struct m0_uint128 global_bucket_list_index_oid;
 struct m0_uint128 bucket_metadata_list_index_oid;
 struct m0_uint128 global_probable_dead_object_list_index_oid;
+struct m0_uint128 global_object_data_refs_index_oid;
 struct m0_uint128 global_instance_id;
 pthread_t global_tid_indexop;
 pthread_t global_tid_objop;
@@ -247,6 +252,123 @@ TEST_F(S3MempoolManagerTestSuite, PoolShouldGrowByDownsizingUnusedPool) {
   EXPECT_TRUE(S3MempoolManager::instance == NULL);
 }
 
+TEST_F(S3MempoolManagerTestSuite, ReleaseBufferByRefTest) {
+  std::vector<int> unit_sizes{FOUR_KB, EIGHT_KB};
+
+  EXPECT_EQ(0, S3MempoolManager::free_space);
+  EXPECT_TRUE(S3MempoolManager::instance == NULL);
+
+  int rc = S3MempoolManager::create_pool(SIXTEEN_KB,  // max threshold
+                                         unit_sizes,  // supported unit_sizes
+                                         1,   // initial_buffer_count_per_pool
+                                         1,   // expandable_count
+                                         0);  // Flags
+  EXPECT_EQ(0, rc);
+
+  void *buffer_1 =
+      S3MempoolManager::get_instance()->get_buffer_for_unit_size(EIGHT_KB);
+  EXPECT_TRUE(buffer_1 != NULL);
+  EXPECT_EQ(FOUR_KB,
+            S3MempoolManager::get_instance()->get_free_space_for(EIGHT_KB));
+
+  // Released as libevent does for data added with evbuffer_add_reference()
+  S3MempoolManager::release_buffer_by_ref(buffer_1, FOUR_KB,
+                                          (void *)(uintptr_t)EIGHT_KB);
+  EXPECT_EQ(TWELVE_KB,
+            S3MempoolManager::get_instance()->get_free_space_for(EIGHT_KB));
+
+  S3MempoolManager::destroy_instance();
+  EXPECT_EQ(0, S3MempoolManager::free_space);
+  EXPECT_TRUE(S3MempoolManager::instance == NULL);
+
+  // Late release after pools are gone is ignored
+  S3MempoolManager::release_buffer_by_ref(NULL, FOUR_KB,
+                                          (void *)(uintptr_t)EIGHT_KB);
+}
+
+#define BENCHMARK_POOL_SIZE (4096 * FOUR_KB)
+
+// Contention benchmark: reactor like threads getting and releasing bursts of
+// buffers of one shared pool, some of them released by another thread as
+// Motr callbacks do, with the pool's lock alone and with per thread caches.
+static long run_contention_benchmark(int flags, int thread_count,
+                                     int iterations) {
+  const int burst = 8;
+  const int handover_interval = 16;
+  std::vector<int> unit_sizes{FOUR_KB};
+  int rc = S3MempoolManager::create_pool(BENCHMARK_POOL_SIZE, unit_sizes, 64,
+                                         16, flags);
+  EXPECT_EQ(0, rc);
+  if (rc != 0) {
+    return -1;
+  }
+  S3MempoolManager *pool_mgr = S3MempoolManager::get_instance();
+  // Buffers each thread hands over to next thread for release
+  std::vector<std::vector<void *>> handed_over(thread_count);
+  std::vector<std::thread> threads;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int t = 0; t < thread_count; t++) {
+    threads.emplace_back([&, t]() {
+      void *bufs[burst];
+      for (int i = 0; i < iterations; i++) {
+        for (int b = 0; b < burst; b++) {
+          bufs[b] = pool_mgr->get_buffer_for_unit_size(FOUR_KB);
+          EXPECT_TRUE(bufs[b] != NULL);
+        }
+        int b = 0;
+        if (i % handover_interval == 0) {
+          handed_over[t].push_back(bufs[b++]);
+        }
+        for (; b < burst; b++) {
+          pool_mgr->release_buffer_for_unit_size(bufs[b], FOUR_KB);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+  for (int t = 0; t < thread_count; t++) {
+    threads.emplace_back([&, t]() {
+      for (void *buf : handed_over[(t + 1) % thread_count]) {
+        pool_mgr->release_buffer_for_unit_size(buf, FOUR_KB);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                     std::chrono::steady_clock::now() - start).count();
+
+  // Threads have exited, so all the buffers are back to the pool
+  EXPECT_EQ(BENCHMARK_POOL_SIZE, pool_mgr->get_free_space_for(FOUR_KB));
+  S3MempoolManager::destroy_instance();
+  return elapsed;
+}
+
+TEST_F(S3MempoolManagerTestSuite, ThreadCacheContentionBenchmark) {
+  const int thread_count = 8;
+  const int iterations = 4096;
+  // Per call debug logs would dominate the timings
+  int saved_log_level = s3log_level;
+  s3log_level = S3_LOG_WARN;
+
+  long locked_usec =
+      run_contention_benchmark(ENABLE_LOCKING, thread_count, iterations);
+  long cached_usec = run_contention_benchmark(
+      ENABLE_LOCKING | ENABLE_THREAD_CACHE, thread_count, iterations);
+
+  s3log_level = saved_log_level;
+  printf("%d threads x %d bursts: locked pool %ld usec, "
+         "thread cache %ld usec\n",
+         thread_count, iterations, locked_usec, cached_usec);
+  EXPECT_LE(0, locked_usec);
+  EXPECT_LE(0, cached_usec);
+}
+
 int main(int argc, char **argv) {
   int rc = 0;
 
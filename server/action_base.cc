@@ -18,6 +18,8 @@
  *
  */
 
+#include <mutex>
+
 #include "action_base.h"
 #include "s3_motr_layout.h"
 #include "s3_error_codes.h"
@@ -27,16 +29,16 @@
 std::map<std::string, uint64_t> Action::s3_task_name_to_addb_task_id_map;
 
 void Action::s3_task_name_to_addb_task_id_map_init() {
-  if (s3_task_name_to_addb_task_id_map.size() ==
-      g_s3_to_addb_idx_func_name_map_size) {
-    return;
-  }
-
-  uint64_t idx = 0;
-  for (; idx < g_s3_to_addb_idx_func_name_map_size; ++idx) {
-    s3_task_name_to_addb_task_id_map[g_s3_to_addb_idx_func_name_map[idx]] =
-        idx + ADDB_TASK_LIST_OFFSET;
-  }
+  // Actions get created on every reactor thread, the map is filled exactly
+  // once and only read afterwards.
+  static std::once_flag map_filled;
+  std::call_once(map_filled, []() {
+    uint64_t idx = 0;
+    for (; idx < g_s3_to_addb_idx_func_name_map_size; ++idx) {
+      s3_task_name_to_addb_task_id_map[g_s3_to_addb_idx_func_name_map[idx]] =
+          idx + ADDB_TASK_LIST_OFFSET;
+    }
+  });
 }
 
 Action::Action(std::shared_ptr<RequestObject> req, bool check_shutdown,
@@ -148,16 +150,52 @@ void Action::start() {
   }
 
   task_iteration_index = 0;
+  tasks_in_flight = 0;
   if (task_list.size() > 0) {
+    run_next_task();
+  }
+}
+
+void Action::run_next_task() {
+  const size_t group = task_group_id_list[task_iteration_index];
+  size_t group_end = task_iteration_index + 1;
+  if (group) {
+    while (group_end < task_list.size() &&
+           task_group_id_list[group_end] == group) {
+      ++group_end;
+    }
+  }
+  if (group_end - task_iteration_index == 1) {
     ADDB(get_addb_action_type_id(), addb_request_id,
          task_addb_id_list[task_iteration_index]);
 
     task_list[task_iteration_index++]();
+    return;
+  }
+  // Tasks may call next() right away and the last one may even end the
+  // action, so nothing of this object is used once they are launched.
+  std::vector<std::function<void()>> group_tasks(
+      task_list.begin() + task_iteration_index, task_list.begin() + group_end);
+  for (size_t idx = task_iteration_index; idx < group_end; ++idx) {
+    ADDB(get_addb_action_type_id(), addb_request_id, task_addb_id_list[idx]);
+  }
+  s3_log(S3_LOG_DEBUG, request_id, "Launching group of %zu tasks\n",
+         group_tasks.size());
+  tasks_in_flight = group_tasks.size();
+  task_iteration_index = group_end;
+  for (auto& task : group_tasks) {
+    task();
   }
 }
 
 // Step to next async step.
 void Action::next() {
+  if (tasks_in_flight > 1) {
+    // Join: wait for the rest of the group.
+    --tasks_in_flight;
+    return;
+  }
+  tasks_in_flight = 0;
   if (check_shutdown_signal && check_shutdown_and_rollback()) {
     s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
     return;
@@ -172,10 +210,7 @@ void Action::next() {
     if (cleanup_started || base_request->client_connected()) {
       // cleanup is primarily background async activity and should work
       // independent of S3 client connection.
-      ADDB(get_addb_action_type_id(), addb_request_id,
-           task_addb_id_list[task_iteration_index]);
-
-      task_list[task_iteration_index++]();
+      run_next_task();
     } else {
       if (action_uses_cleanup) {
         startcleanup();
@@ -190,6 +225,7 @@ void Action::next() {
 
 void Action::done() {
   task_iteration_index = 0;
+  tasks_in_flight = 0;
   state = ACTS_COMPLETE;
   ADDB(get_addb_action_type_id(), addb_request_id, (uint64_t)state);
   i_am_done();
@@ -101,7 +101,14 @@ class Action {
   std::vector<std::function<void()>> task_list;
   // Holds task's addb index
   std::vector<uint64_t> task_addb_id_list;
+  // Holds task's group, 0 for tasks run one after another
+  std::vector<size_t> task_group_id_list;
   size_t task_iteration_index;
+  // Group given to tasks being added, and last group given out
+  size_t current_task_group = 0;
+  size_t last_task_group = 0;
+  // Tasks of running group yet to call next()
+  size_t tasks_in_flight = 0;
 
   // Hold member functions that will rollback
   // changes in event of error
@@ -128,6 +135,8 @@ class Action {
   S3Timer auth_timer;
 
   bool is_date_header_present_in_request() const;
+  // Runs task at task_iteration_index, or all tasks of its group.
+  void run_next_task();
 
  protected:
   std::string request_id;
@@ -171,9 +180,9 @@ class Action {
 
  protected:
   void add_task(std::function<void()> task, const char* func_name) {
-    s3_task_name_to_addb_task_id_map_init();
-
-    if (s3_task_name_to_addb_task_id_map.count(func_name) == 0) {
+    const auto &task_ids = s3_task_name_to_addb_task_id_map;
+    auto task_id = task_ids.find(func_name);
+    if (task_id == task_ids.end()) {
       s3_log(S3_LOG_FATAL, "",
              "Function %s was not found in addb index map. "
              "Make sure you use ACTION_TASK_ADD macro to call add_task. "
@@ -181,13 +190,24 @@ class Action {
              func_name);
     }
     task_list.push_back(std::move(task));
-    task_addb_id_list.push_back(s3_task_name_to_addb_task_id_map[func_name]);
+    task_addb_id_list.push_back(task_id == task_ids.end() ? 0
+                                                          : task_id->second);
+    task_group_id_list.push_back(current_task_group);
   }
 
+  // Tasks added between begin_task_group() and end_task_group() are
+  // independent of each other and get launched together, the action goes on
+  // once every one of them has called next(). Tasks of a group must call
+  // next() whether they succeed or not.
+  void begin_task_group() { current_task_group = ++last_task_group; }
+  void end_task_group() { current_task_group = 0; }
+
   void clear_tasks() {
     task_list.clear();
     task_addb_id_list.clear();
+    task_group_id_list.clear();
     task_iteration_index = 0;
+    tasks_in_flight = 0;
   }
 
   std::shared_ptr<S3AuthClient>& get_auth_client() { return auth_client; }
@@ -296,6 +316,8 @@ class Action {
   FRIEND_TEST(ActionTest, AddTask);
   FRIEND_TEST(ActionTest, AddTaskRollback);
   FRIEND_TEST(ActionTest, TasklistRun);
+  FRIEND_TEST(ActionTest, TaskGroupRun);
+  FRIEND_TEST(ActionTest, TaskGroupCompletedRightAway);
   FRIEND_TEST(ActionTest, RollbacklistRun);
   FRIEND_TEST(ActionTest, SkipAuthTest);
   FRIEND_TEST(ActionTest, EnableAuthTest);
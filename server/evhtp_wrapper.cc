@@ -83,6 +83,20 @@ void EvhtpWrapper::http_send_reply_end(evhtp_request_t *request) {
   evhtp_send_reply_end(request);
 }
 
+void EvhtpWrapper::http_send_reply_chunk_start(evhtp_request_t *request,
+                                               evhtp_res code) {
+  evhtp_send_reply_chunk_start(request, code);
+}
+
+void EvhtpWrapper::http_send_reply_chunk(evhtp_request_t *request,
+                                         evbuf_t *buf) {
+  evhtp_send_reply_chunk(request, buf);
+}
+
+void EvhtpWrapper::http_send_reply_chunk_end(evhtp_request_t *request) {
+  evhtp_send_reply_chunk_end(request);
+}
+
 static bool conn_has_data_for_writing(evhtp_connection_t *p_conn) noexcept {
   struct evbuffer *p_evbuf = bufferevent_get_output(p_conn->bev);
 
@@ -58,6 +58,11 @@ class EvhtpInterface {
                                      evhtp_res code) = 0;
   virtual void http_send_reply_body(evhtp_request_t *request, evbuf_t *buf) = 0;
   virtual void http_send_reply_end(evhtp_request_t *request) = 0;
+  virtual void http_send_reply_chunk_start(evhtp_request_t *request,
+                                           evhtp_res code) = 0;
+  virtual void http_send_reply_chunk(evhtp_request_t *request,
+                                     evbuf_t *buf) = 0;
+  virtual void http_send_reply_chunk_end(evhtp_request_t *request) = 0;
   virtual void close_connection_after_writing(evhtp_connection_t *) = 0;
 
   // Libevent wrappers
@@ -84,6 +89,9 @@ class EvhtpWrapper : public EvhtpInterface {
   void http_send_reply_start(evhtp_request_t *request, evhtp_res code);
   void http_send_reply_body(evhtp_request_t *request, evbuf_t *buf);
   void http_send_reply_end(evhtp_request_t *request);
+  void http_send_reply_chunk_start(evhtp_request_t *request, evhtp_res code);
+  void http_send_reply_chunk(evhtp_request_t *request, evbuf_t *buf);
+  void http_send_reply_chunk_end(evhtp_request_t *request);
   void close_connection_after_writing(evhtp_connection_t *) override;
 
   // Libevent wrappers
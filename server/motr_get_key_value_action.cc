@@ -21,6 +21,7 @@
 #include "motr_get_key_value_action.h"
 #include "s3_error_codes.h"
 #include "s3_m0_uint128_helper.h"
+#include "s3_metadata_codec.h"
 
 MotrGetKeyValueAction::MotrGetKeyValueAction(
     std::shared_ptr<MotrRequestObject> req, std::shared_ptr<MotrAPI> motr_api,
@@ -110,7 +111,16 @@ void MotrGetKeyValueAction::send_response_to_s3_client() {
     }
     request->send_response(error.get_http_status_code(), response_xml);
   } else {
-    request->send_response(S3HttpSuccess200, motr_kv_reader->get_value());
+    // Binary metadata is handed out in the json form readers such as
+    // background delete understand.
+    const std::string& value = motr_kv_reader->get_value();
+    std::string json_value;
+    if (s3_is_binary_metadata(value) &&
+        s3_binary_metadata_to_json(value, json_value)) {
+      request->send_response(S3HttpSuccess200, json_value);
+    } else {
+      request->send_response(S3HttpSuccess200, value);
+    }
   }
   done();
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
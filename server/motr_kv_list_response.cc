@@ -23,6 +23,7 @@
 #include "motr_kv_list_response.h"
 #include "s3_common_utilities.h"
 #include "s3_log.h"
+#include "s3_metadata_codec.h"
 
 MotrKVListResponse::MotrKVListResponse(std::string encoding_type)
     : encoding_type(encoding_type),
@@ -107,10 +108,18 @@ std::string MotrKVListResponse::as_json() {
   root["IsTruncated"] = response_is_truncated ? "true" : "false";
 
   Json::Value keys_array;
+  std::string json_value;
   for (auto&& kv : kv_list) {
     Json::Value key_object;
     key_object["Key"] = kv.first;
-    key_object["Value"] = kv.second;
+    // Binary metadata is listed in its json form, see
+    // MotrGetKeyValueAction.
+    if (s3_is_binary_metadata(kv.second) &&
+        s3_binary_metadata_to_json(kv.second, json_value)) {
+      key_object["Value"] = json_value;
+    } else {
+      key_object["Value"] = kv.second;
+    }
     keys_array.append(key_object);
   }
 
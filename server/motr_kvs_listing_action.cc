@@ -110,7 +110,7 @@ void MotrKVSListingAction::get_next_key_value() {
 
   if (motr_kv_reader == nullptr) {
     motr_kv_reader =
-        motr_kvs_reader_factory_ptr->create_motr_kvs_reader(request, motr_api);
+        motr_kvs_reader_factory_ptr->create_motr_kvs_cursor(request, motr_api);
   }
 
   if (motr_kv_reader->get_state() == S3MotrKVSReaderOpState::failed_e2big) {
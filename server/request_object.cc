@@ -812,10 +812,52 @@ void RequestObject::send_reply_body(const char* data, int length) {
   }
 }
 
+void RequestObject::send_reply_body_by_ref(const char* data, int length,
+                                           evbuffer_ref_cleanup_cb cleanup_fn,
+                                           void* cleanup_arg) {
+  if (client_connected() &&
+      evbuffer_add_reference(reply_buffer, data, length, cleanup_fn,
+                             cleanup_arg) == 0) {
+    evhtp_obj->http_send_reply_body(ev_req, reply_buffer);
+  } else {
+    // Data is not referenced by the connection, release it right away.
+    send_reply_body(data, length);
+    cleanup_fn(data, length, cleanup_arg);
+  }
+}
+
 void RequestObject::send_reply_end() {
   if (client_connected()) {
     evhtp_obj->http_send_reply_end(ev_req);
   }
+  finish_reply();
+}
+
+void RequestObject::send_reply_chunk_start(int code) {
+  http_status = code;
+  turn_around_time.stop();
+  set_out_header_value("x-amz-request-id", request_id);
+  if (client_connected()) {
+    evhtp_obj->http_send_reply_chunk_start(ev_req, code);
+    reply_buffer = evbuffer_new();
+  }
+}
+
+void RequestObject::send_reply_chunk(const char* data, int length) {
+  if (client_connected() && reply_buffer != NULL && length > 0) {
+    evbuffer_add(reply_buffer, data, length);
+    evhtp_obj->http_send_reply_chunk(ev_req, reply_buffer);
+  }
+}
+
+void RequestObject::send_reply_chunk_end() {
+  if (client_connected() && reply_buffer != NULL) {
+    evhtp_obj->http_send_reply_chunk_end(ev_req);
+  }
+  finish_reply();
+}
+
+void RequestObject::finish_reply() {
   stop_processing_incoming_data();
 
   auto mss = paused_timer.elapsed_time_in_millisec();
@@ -838,6 +880,19 @@ void RequestObject::send_reply_end() {
   s3_stats_timing("total_request_time", mss);
 }
 
+size_t RequestObject::get_pending_reply_body_length() {
+  if (!client_connected() || ev_req == NULL || ev_req->conn == NULL ||
+      ev_req->conn->bev == NULL) {
+    return 0;
+  }
+  size_t pending_length =
+      evhtp_obj->evbuffer_get_length(bufferevent_get_output(ev_req->conn->bev));
+  if (reply_buffer != NULL) {
+    pending_length += evhtp_obj->evbuffer_get_length(reply_buffer);
+  }
+  return pending_length;
+}
+
 void RequestObject::close_connection() {
   if (!is_client_connected) {
     s3_log(S3_LOG_INFO, stripped_request_id,
@@ -262,6 +262,8 @@ class RequestObject {
     }
   }
 
+  bool is_request_paused() const { return is_paused; }
+
   virtual void resume(bool set_read_timer = true) {
     if (!client_connected()) {
       s3_log(S3_LOG_INFO, stripped_request_id, "s3 client is disconnected.\n");
@@ -349,12 +351,28 @@ class RequestObject {
  private:
   struct evbuffer* reply_buffer;
 
+  void finish_reply();
+
  public:
   virtual void send_response(int code, std::string body = "");
   virtual void send_reply_start(int code);
   virtual void send_reply_body(const char* data, int length);
+  // Adds data to the reply without copying it. 'cleanup_fn' is called with
+  // 'cleanup_arg' once the data is written or dropped, and may be called
+  // before this returns.
+  virtual void send_reply_body_by_ref(const char* data, int length,
+                                      evbuffer_ref_cleanup_cb cleanup_fn,
+                                      void* cleanup_arg);
   virtual void send_reply_end();
+  // Same as send_reply_start/body/end but the reply body is sent with chunked
+  // transfer encoding, so Content-Length need not be known up front.
+  virtual void send_reply_chunk_start(int code);
+  virtual void send_reply_chunk(const char* data, int length);
+  virtual void send_reply_chunk_end();
   virtual void close_connection();
+  // Bytes handed to the connection with send_reply_body() which are not yet
+  // written to the client socket.
+  virtual size_t get_pending_reply_body_length();
 
   void respond_error(std::string error_code,
                      const std::map<std::string, std::string>& headers =
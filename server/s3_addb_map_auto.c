@@ -25,10 +25,11 @@
 
 #include "s3_addb_map.h"
 
-const uint64_t g_s3_to_addb_idx_func_name_map_size = 209;
+const uint64_t g_s3_to_addb_idx_func_name_map_size = 224;
 
 const char* g_s3_to_addb_idx_func_name_map[] = {
     "Action::check_authentication",
+    "ActionTest::func_callback_done",
     "ActionTest::func_callback_one",
     "ActionTest::func_callback_two",
     "MotrAPIHandlerTest::func_callback_one",
@@ -78,7 +79,7 @@ const char* g_s3_to_addb_idx_func_name_map[] = {
     "S3BucketActionTest::func_callback_one",
     "S3CopyObjectAction::check_source_bucket_authorization",
     "S3CopyObjectAction::copy_object",
-    "S3CopyObjectAction::create_object",
+    "S3CopyObjectAction::create_destination_object",
     "S3CopyObjectAction::save_metadata",
     "S3CopyObjectAction::send_response_to_s3_client",
     "S3CopyObjectAction::set_source_bucket_authorization_metadata",
@@ -190,6 +191,7 @@ const char* g_s3_to_addb_idx_func_name_map[] = {
     "S3PutChunkUploadObjectAction::initiate_data_streaming",
     "S3PutChunkUploadObjectAction::mark_new_oid_for_deletion",
     "S3PutChunkUploadObjectAction::mark_old_oid_for_deletion",
+    "S3PutChunkUploadObjectAction::remove_inline_object_version_metadata",
     "S3PutChunkUploadObjectAction::remove_new_oid_probable_record",
     "S3PutChunkUploadObjectAction::remove_old_oid_probable_record",
     "S3PutChunkUploadObjectAction::save_metadata",
@@ -219,6 +221,8 @@ const char* g_s3_to_addb_idx_func_name_map[] = {
     "S3PutObjectAction::initiate_data_streaming",
     "S3PutObjectAction::mark_new_oid_for_deletion",
     "S3PutObjectAction::mark_old_oid_for_deletion",
+    "S3PutObjectAction::read_inline_data",
+    "S3PutObjectAction::remove_inline_object_version_metadata",
     "S3PutObjectAction::remove_new_oid_probable_record",
     "S3PutObjectAction::remove_old_oid_probable_record",
     "S3PutObjectAction::save_metadata",
@@ -229,6 +233,7 @@ const char* g_s3_to_addb_idx_func_name_map[] = {
     "S3PutObjectActionBase::delete_old_object",
     "S3PutObjectActionBase::mark_new_oid_for_deletion",
     "S3PutObjectActionBase::mark_old_oid_for_deletion",
+    "S3PutObjectActionBase::remove_inline_object_version_metadata",
     "S3PutObjectActionBase::remove_new_oid_probable_record",
     "S3PutObjectActionBase::remove_old_oid_probable_record",
     "S3PutObjectActionTest::func_callback_one",
@@ -236,4 +241,14 @@ const char* g_s3_to_addb_idx_func_name_map[] = {
     "S3PutObjectTaggingAction::send_response_to_s3_client",
     "S3PutObjectTaggingAction::validate_request",
     "S3PutObjectTaggingAction::validate_request_xml_tags",
-    "S3PutObjectTaggingActionTest::func_callback_one"};
+    "S3PutObjectTaggingActionTest::func_callback_one",
+    "S3UploadPartCopyAction::check_source_bucket_authorization",
+    "S3UploadPartCopyAction::compute_part_offset",
+    "S3UploadPartCopyAction::copy_part",
+    "S3UploadPartCopyAction::fetch_multipart_metadata",
+    "S3UploadPartCopyAction::save_metadata",
+    "S3UploadPartCopyAction::save_multipart_metadata",
+    "S3UploadPartCopyAction::send_response_to_s3_client",
+    "S3UploadPartCopyAction::set_source_bucket_authorization_metadata",
+    "S3UploadPartCopyAction::validate_upload_part_copy_request",
+    "S3UploadPartCopyActionTest::func_callback_one"};
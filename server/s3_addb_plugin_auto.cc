@@ -78,6 +78,7 @@
 #include "s3_put_object_acl_action.h"
 #include "s3_put_object_action.h"
 #include "s3_put_object_tagging_action.h"
+#include "s3_upload_part_copy_action.h"
 
 static std::unordered_map<std::type_index, enum S3AddbActionTypeId> gs_addb_map;
 
@@ -171,6 +172,8 @@ int s3_addb_init() {
       S3_ADDB_S3_PUT_OBJECT_ACTION_ID;
   gs_addb_map[std::type_index(typeid(S3PutObjectTaggingAction))] =
       S3_ADDB_S3_PUT_OBJECT_TAGGING_ACTION_ID;
+  gs_addb_map[std::type_index(typeid(S3UploadPartCopyAction))] =
+      S3_ADDB_S3_UPLOAD_PART_COPY_ACTION_ID;
 
   s3_log(S3_LOG_DEBUG, "",
          "  * id 0x%" PRIx64 "/%" PRId64  // suppress clang warning
@@ -429,6 +432,12 @@ int s3_addb_init() {
          ": class S3PutObjectTaggingAction\n",
          (uint64_t)S3_ADDB_S3_PUT_OBJECT_TAGGING_ACTION_ID,
          (int64_t)S3_ADDB_S3_PUT_OBJECT_TAGGING_ACTION_ID);
+
+  s3_log(S3_LOG_DEBUG, "",
+         "  * id 0x%" PRIx64 "/%" PRId64  // suppress clang warning
+         ": class S3UploadPartCopyAction\n",
+         (uint64_t)S3_ADDB_S3_UPLOAD_PART_COPY_ACTION_ID,
+         (int64_t)S3_ADDB_S3_UPLOAD_PART_COPY_ACTION_ID);
   return 0;
 }
 
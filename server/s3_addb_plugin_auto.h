@@ -151,9 +151,11 @@ enum S3AddbActionTypeId {
   S3_ADDB_S3_PUT_OBJECT_ACTION_ID,
   /* S3PutObjectTaggingAction: */
   S3_ADDB_S3_PUT_OBJECT_TAGGING_ACTION_ID,
+  /* S3UploadPartCopyAction: */
+  S3_ADDB_S3_UPLOAD_PART_COPY_ACTION_ID,
 
   /* End of auto-generated IDs. */
-  S3_ADDB_LAST_REQUEST_ID = S3_ADDB_S3_PUT_OBJECT_TAGGING_ACTION_ID,
+  S3_ADDB_LAST_REQUEST_ID = S3_ADDB_S3_UPLOAD_PART_COPY_ACTION_ID,
 
   /* End of S3 server range. */
   S3_ADDB_RANGE_END = S3_ADDB_LAST_REQUEST_ID
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+#include <time.h>
+
+#include "s3_async_log.h"
+#include "s3_log.h"
+
+// Longest message kept, as glog truncates longer ones anyway.
+#define S3_LOG_MAX_MESSAGE_LEN 30000
+// Writer thread looks for new messages at least this often. Callers wake
+// it up sooner for errors and when their ring is half full.
+#define S3_LOG_WRITER_POLL_MSEC 10
+
+static size_t align_record_size(size_t size) {
+  return (size + S3_LOG_RECORD_ALIGN - 1) / S3_LOG_RECORD_ALIGN *
+         S3_LOG_RECORD_ALIGN;
+}
+
+static_assert(sizeof(S3LogRecord) <= S3_LOG_RECORD_ALIGN,
+              "S3LogRecord must fit S3_LOG_RECORD_ALIGN");
+
+S3LogRing::S3LogRing(size_t size)
+    : capacity(std::max(size / S3_LOG_RECORD_ALIGN * S3_LOG_RECORD_ALIGN,
+                        (size_t)(4 * S3_LOG_RECORD_ALIGN))),
+      head(0),
+      tail(0),
+      dropped(0),
+      orphaned(false) {
+  buffer = new char[capacity];
+}
+
+S3LogRing::~S3LogRing() { delete[] buffer; }
+
+size_t S3LogRing::get_max_text_len() const {
+  // A record may need as much padding before it as its own size.
+  return capacity / 2 - sizeof(S3LogRecord);
+}
+
+bool S3LogRing::push(int level, const char *file, int line,
+                     int64_t timestamp_nsec, const char *text,
+                     size_t text_len) {
+  text_len = std::min(text_len, get_max_text_len());
+  const size_t record_size = align_record_size(sizeof(S3LogRecord) + text_len);
+  uint64_t position = head.load(std::memory_order_relaxed);
+  const uint64_t used = position - tail.load(std::memory_order_acquire);
+  size_t offset = position % capacity;
+  // Records are contiguous, what does not fit the end of ring is padding.
+  const size_t padding =
+      capacity - offset < record_size ? capacity - offset : 0;
+  if (capacity - used < padding + record_size) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  if (padding > 0) {
+    S3LogRecord *pad = reinterpret_cast<S3LogRecord *>(buffer + offset);
+    pad->size = padding;
+    pad->level = -1;
+    position += padding;
+    offset = 0;
+  }
+  S3LogRecord *record = reinterpret_cast<S3LogRecord *>(buffer + offset);
+  record->size = record_size;
+  record->text_len = text_len;
+  record->level = level;
+  record->line = line;
+  record->file = file;
+  record->timestamp_nsec = timestamp_nsec;
+  memcpy(record + 1, text, text_len);
+  head.store(position + record_size, std::memory_order_release);
+  return true;
+}
+
+bool S3LogRing::is_half_full() const {
+  return head.load(std::memory_order_relaxed) -
+             tail.load(std::memory_order_relaxed) >=
+         capacity / 2;
+}
+
+uint64_t S3LogRing::get_end() const {
+  return head.load(std::memory_order_acquire);
+}
+
+const S3LogRecord *S3LogRing::front(uint64_t end) {
+  uint64_t position = tail.load(std::memory_order_relaxed);
+  while (position < end) {
+    const S3LogRecord *record =
+        reinterpret_cast<const S3LogRecord *>(buffer + position % capacity);
+    if (record->level >= 0) {
+      return record;
+    }
+    position += record->size;
+    tail.store(position, std::memory_order_release);
+  }
+  return NULL;
+}
+
+void S3LogRing::pop() {
+  const uint64_t position = tail.load(std::memory_order_relaxed);
+  const S3LogRecord *record =
+      reinterpret_cast<const S3LogRecord *>(buffer + position % capacity);
+  tail.store(position + record->size, std::memory_order_release);
+}
+
+uint64_t S3LogRing::take_dropped() {
+  return dropped.exchange(0, std::memory_order_relaxed);
+}
+
+void S3LogRing::set_orphaned() {
+  orphaned.store(true, std::memory_order_release);
+}
+
+bool S3LogRing::is_orphaned() const {
+  return orphaned.load(std::memory_order_acquire);
+}
+
+// Ring of the calling thread, it is orphaned when the thread exits and
+// forgotten by the writer once it is written.
+struct S3LogThreadRing {
+  std::shared_ptr<S3LogRing> ring;
+  uint64_t logger_id = 0;
+
+  ~S3LogThreadRing() {
+    if (ring) {
+      ring->set_orphaned();
+    }
+  }
+};
+
+static thread_local S3LogThreadRing thread_ring;
+static std::atomic<uint64_t> last_logger_id(0);
+
+S3AsyncLogger::S3AsyncLogger(size_t ring_size_bytes, Writer log_writer)
+    : id(++last_logger_id),
+      ring_size(ring_size_bytes),
+      writer(std::move(log_writer)) {}
+
+S3AsyncLogger::~S3AsyncLogger() { stop(); }
+
+S3LogRing *S3AsyncLogger::get_thread_ring() {
+  if (thread_ring.logger_id != id) {
+    if (thread_ring.ring) {
+      thread_ring.ring->set_orphaned();
+    }
+    thread_ring.ring = std::make_shared<S3LogRing>(ring_size);
+    thread_ring.logger_id = id;
+    std::lock_guard<std::mutex> guard(lock);
+    rings.push_back(thread_ring.ring);
+  }
+  return thread_ring.ring.get();
+}
+
+void S3AsyncLogger::log(int level, const char *file, int line,
+                        const char *fmt, va_list args) {
+  static thread_local char text[S3_LOG_MAX_MESSAGE_LEN];
+  struct timespec ts;
+
+  clock_gettime(CLOCK_REALTIME, &ts);
+  const int len = vsnprintf(text, sizeof(text), fmt, args);
+  if (len < 0) {
+    return;
+  }
+  size_t text_len = std::min((size_t)len, sizeof(text) - 1);
+  // As with synchronous s3_log(), new line is added by the log file.
+  if (text_len > 0 && text[text_len - 1] == '\n') {
+    --text_len;
+  }
+  const int64_t timestamp_nsec = ts.tv_sec * 1000000000LL + ts.tv_nsec;
+
+  S3LogRing *ring = get_thread_ring();
+  if (ring->push(level, file, line, timestamp_nsec, text, text_len)) {
+    if (level >= S3_LOG_ERROR || ring->is_half_full()) {
+      wakeup_cond.notify_one();
+    }
+  } else if (level >= S3_LOG_ERROR) {
+    S3LogRecord record = {0, (uint32_t)text_len, level, line, file,
+                          timestamp_nsec};
+    writer(record, text);
+  }
+  if (level >= S3_LOG_FATAL) {
+    flush();
+  }
+}
+
+size_t S3AsyncLogger::write_rings(
+    const std::vector<std::shared_ptr<S3LogRing>> &to_write) {
+  std::vector<uint64_t> ends;
+  uint64_t dropped = 0;
+  for (const auto &ring : to_write) {
+    ends.push_back(ring->get_end());
+    dropped += ring->take_dropped();
+  }
+
+  // Rings are each in time order, they are merged so that messages of
+  // different threads are written in time order too.
+  size_t written = 0;
+  while (true) {
+    S3LogRing *oldest_ring = NULL;
+    const S3LogRecord *oldest = NULL;
+    for (size_t i = 0; i < to_write.size(); ++i) {
+      const S3LogRecord *record = to_write[i]->front(ends[i]);
+      if (record &&
+          (!oldest || record->timestamp_nsec < oldest->timestamp_nsec)) {
+        oldest = record;
+        oldest_ring = to_write[i].get();
+      }
+    }
+    if (!oldest) {
+      break;
+    }
+    writer(*oldest, reinterpret_cast<const char *>(oldest + 1));
+    oldest_ring->pop();
+    ++written;
+  }
+
+  if (dropped > 0) {
+    char text[128];
+    const int len = snprintf(text, sizeof(text),
+                             "[Req:%s] %" PRIu64
+                             " log messages were dropped as log buffers "
+                             "were full",
+                             S3_DEFAULT_REQID, dropped);
+    S3LogRecord record = {0, (uint32_t)len, S3_LOG_WARN, __LINE__, __FILE__,
+                          0};
+    writer(record, text);
+  }
+  return written;
+}
+
+void S3AsyncLogger::run() {
+  std::vector<std::shared_ptr<S3LogRing>> to_write;
+  std::unique_lock<std::mutex> guard(lock);
+  while (true) {
+    const uint64_t flush_target = flush_requested;
+    const bool stop_after_write = stopping;
+    to_write = rings;
+    guard.unlock();
+
+    const size_t written = write_rings(to_write);
+    to_write.clear();
+
+    guard.lock();
+    rings.erase(std::remove_if(rings.begin(), rings.end(),
+                               [](const std::shared_ptr<S3LogRing> &ring) {
+                                 return ring->is_orphaned() &&
+                                        !ring->front(ring->get_end());
+                               }),
+                rings.end());
+    if (stop_after_write) {
+      // Flushes asked meanwhile return too, nothing more will be written.
+      flush_done = flush_requested;
+      flushed_cond.notify_all();
+      break;
+    }
+    if (flush_done < flush_target) {
+      flush_done = flush_target;
+      flushed_cond.notify_all();
+    }
+    if (written == 0 && flush_requested == flush_done && !stopping) {
+      wakeup_cond.wait_for(guard,
+                           std::chrono::milliseconds(S3_LOG_WRITER_POLL_MSEC));
+    }
+  }
+}
+
+int S3AsyncLogger::start() {
+  try {
+    writer_thread = std::thread(&S3AsyncLogger::run, this);
+  }
+  catch (const std::system_error &e) {
+    return -e.code().value();
+  }
+  return 0;
+}
+
+void S3AsyncLogger::stop() {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    stopping = true;
+  }
+  wakeup_cond.notify_one();
+  if (writer_thread.joinable()) {
+    writer_thread.join();
+  }
+}
+
+void S3AsyncLogger::flush() {
+  std::unique_lock<std::mutex> guard(lock);
+  if (stopping || !writer_thread.joinable() ||
+      writer_thread.get_id() == std::this_thread::get_id()) {
+    return;
+  }
+  const uint64_t target = ++flush_requested;
+  wakeup_cond.notify_one();
+  flushed_cond.wait(guard, [this, target]() { return flush_done >= target; });
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_ASYNC_LOG_H__
+#define __S3_SERVER_S3_ASYNC_LOG_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest_prod.h>
+
+// Records in S3LogRing start at multiples of this, so padding at the end of
+// the ring always has room for a record header.
+#define S3_LOG_RECORD_ALIGN 32
+
+// Message in S3LogRing, its text follows the record.
+struct S3LogRecord {
+  // Size of the record with its text and alignment
+  uint32_t size;
+  uint32_t text_len;
+  // S3_LOG_* level, -1 for padding up to the end of the ring
+  int32_t level;
+  int32_t line;
+  // __FILE__ of the caller, string literals outlive the record.
+  const char *file;
+  int64_t timestamp_nsec;
+};
+
+// Messages logged by one thread. Only that thread pushes to the ring and
+// only the writer thread of S3AsyncLogger reads it, so neither side takes
+// a lock or waits for the other.
+class S3LogRing {
+  char *buffer;
+  size_t capacity;
+  // Positions only grow, offset in buffer is position % capacity.
+  alignas(64) std::atomic<uint64_t> head;
+  alignas(64) std::atomic<uint64_t> tail;
+  std::atomic<uint64_t> dropped;
+  std::atomic<bool> orphaned;
+
+ public:
+  explicit S3LogRing(size_t size);
+  ~S3LogRing();
+
+  // Longer texts are truncated by the caller.
+  size_t get_max_text_len() const;
+  // Returns false, and counts the message as dropped, if the ring is full.
+  bool push(int level, const char *file, int line, int64_t timestamp_nsec,
+            const char *text, size_t text_len);
+  bool is_half_full() const;
+
+  // Reader side. Position up to which messages are pushed, and the oldest
+  // message before 'end', NULL if there is none.
+  uint64_t get_end() const;
+  const S3LogRecord *front(uint64_t end);
+  void pop();
+  // Returns count of dropped messages since last call.
+  uint64_t take_dropped();
+
+  // Set when the thread owning the ring exits.
+  void set_orphaned();
+  bool is_orphaned() const;
+};
+
+// Asynchronous backend of s3_log(). Caller threads only format messages
+// into their own S3LogRing, a writer thread passes them in time order to
+// the Writer (glog in s3server). A producer never waits: messages are
+// dropped while its ring is full, except errors which are then written by
+// the caller itself. FATAL messages are flushed before log() returns.
+class S3AsyncLogger {
+ public:
+  // Writes a message, the text is not NUL terminated. Called from the
+  // writer thread, and from callers for errors which did not fit a ring.
+  typedef std::function<void(const S3LogRecord &, const char *)> Writer;
+
+ private:
+  const uint64_t id;
+  size_t ring_size;
+  Writer writer;
+
+  // Guards all below
+  std::mutex lock;
+  std::condition_variable wakeup_cond;
+  std::condition_variable flushed_cond;
+  std::vector<std::shared_ptr<S3LogRing>> rings;
+  uint64_t flush_requested = 0;
+  uint64_t flush_done = 0;
+  bool stopping = false;
+  std::thread writer_thread;
+
+  S3LogRing *get_thread_ring();
+  // Writes messages pushed so far in all rings, returns their count.
+  size_t write_rings(const std::vector<std::shared_ptr<S3LogRing>> &to_write);
+  void run();
+
+ public:
+  S3AsyncLogger(size_t ring_size_bytes, Writer log_writer);
+  virtual ~S3AsyncLogger();
+
+  int start();
+  // Writes all messages logged so far and stops the writer thread.
+  void stop();
+  // Returns once messages logged so far are written.
+  void flush();
+  void log(int level, const char *file, int line, const char *fmt,
+           va_list args);
+
+  FRIEND_TEST(S3AsyncLoggerTest, RingsOfExitedThreadsAreForgotten);
+};
+
+#endif  // __S3_SERVER_S3_ASYNC_LOG_H__
@@ -23,6 +23,7 @@
 #include "s3_perf_logger.h"
 #include "s3_stats.h"
 #include "s3_log.h"
+#include "s3_option.h"
 
 S3AsyncOpContextBase::S3AsyncOpContextBase(std::shared_ptr<RequestObject> req,
                                            std::function<void(void)> success,
@@ -36,7 +37,8 @@ S3AsyncOpContextBase::S3AsyncOpContextBase(std::shared_ptr<RequestObject> req,
       response_received_count(0),
       at_least_one_success(false),
       s3_motr_api(motr_api ? std::move(motr_api)
-                           : std::make_shared<ConcreteMotrAPI>()) {
+                           : std::make_shared<ConcreteMotrAPI>()),
+      event_base(S3Option::get_instance()->get_eventbase()) {
   request_id = request->get_request_id();
   stripped_request_id = request->get_stripped_request_id();
   ops_response.resize(ops_count);
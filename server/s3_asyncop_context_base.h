@@ -71,6 +71,10 @@ class S3AsyncOpContextBase {
   std::string request_id;
   std::string stripped_request_id;
 
+  // Event base of the reactor which launched the operation, completion is
+  // posted back to it.
+  evbase_t* event_base;
+
  public:
   S3AsyncOpContextBase(std::shared_ptr<RequestObject> req,
                        std::function<void(void)> success,
@@ -107,6 +111,7 @@ class S3AsyncOpContextBase {
   // log file.
   void log_timer();
   std::shared_ptr<MotrAPI> get_motr_api();
+  evbase_t* get_event_base() { return event_base; }
   // Google tests
   FRIEND_TEST(S3MotrReadWriteCommonTest, MotrOpDoneOnMainThreadOnSuccess);
   FRIEND_TEST(S3MotrReadWriteCommonTest, S3MotrOpStable);
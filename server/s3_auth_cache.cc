@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include "s3_auth_cache.h"
+#include "s3_log.h"
+#include "s3_option.h"
+
+S3AuthCache* S3AuthCache::instance = NULL;
+
+S3AuthCache::S3AuthCache(size_t max_entries, unsigned int ttl_millisec)
+    : entries(max_entries, ttl_millisec), disabled(false) {}
+
+S3AuthCache* S3AuthCache::get_instance() {
+  if (!instance) {
+    S3Option* option_instance = S3Option::get_instance();
+    instance = new S3AuthCache(option_instance->get_auth_cache_max_entries(),
+                               option_instance->get_auth_cache_ttl_millisec());
+  }
+  return instance;
+}
+
+void S3AuthCache::destroy_instance() {
+  if (instance) {
+    delete instance;
+    instance = NULL;
+  }
+}
+
+std::string S3AuthCache::get_key(const std::string& access_key,
+                                 const std::string& credential_scope) {
+  return access_key + "/" + credential_scope;
+}
+
+void S3AuthCache::disable() {
+  if (disabled.exchange(true)) {
+    return;
+  }
+  s3_log(S3_LOG_WARN, "",
+         "Auth server did not return a signing key, auth cache disabled\n");
+  std::lock_guard<std::mutex> guard(cache_lock);
+  entries.clear();
+}
+
+std::shared_ptr<const S3AuthCacheEntry> S3AuthCache::get(
+    const std::string& access_key, const std::string& credential_scope) {
+  if (!is_enabled()) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> guard(cache_lock);
+  return entries.get(get_key(access_key, credential_scope));
+}
+
+void S3AuthCache::put(const std::string& access_key,
+                      const std::string& credential_scope,
+                      std::shared_ptr<const S3AuthCacheEntry> entry) {
+  if (!is_enabled()) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(cache_lock);
+  entries.put(get_key(access_key, credential_scope), std::move(entry));
+}
+
+size_t S3AuthCache::size() {
+  std::lock_guard<std::mutex> guard(cache_lock);
+  return entries.size();
+}
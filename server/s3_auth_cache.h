@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_AUTH_CACHE_H__
+#define __S3_SERVER_S3_AUTH_CACHE_H__
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "s3_lru_cache.h"
+
+// What a successful AWS V4 authentication with the Auth server tells about
+// an access key within one credential scope.
+struct S3AuthCacheEntry {
+  // Raw (not hex encoded) signing key of the scope
+  std::string signing_key;
+  std::string user_name;
+  std::string user_id;
+  std::string account_name;
+  std::string account_id;
+  std::string canonical_id;
+  std::string email;
+};
+
+// LRU cache of signing keys and identities, shared by all requests, so that
+// S3AuthClient can verify AWS V4 signatures without asking the Auth server.
+// Entries are keyed by access key and credential scope
+// (date/region/service/aws4_request). Revoked or changed credentials are
+// noticed once the TTL expires.
+class S3AuthCache {
+  std::mutex cache_lock;
+  S3LruCache<S3AuthCacheEntry> entries;
+  // Set when the Auth server does not hand out signing keys
+  std::atomic<bool> disabled;
+
+  static S3AuthCache* instance;
+
+  static std::string get_key(const std::string& access_key,
+                             const std::string& credential_scope);
+
+ public:
+  S3AuthCache(size_t max_entries, unsigned int ttl_millisec);
+
+  static S3AuthCache* get_instance();
+  static void destroy_instance();
+
+  bool is_enabled() const { return !disabled && entries.is_enabled(); }
+
+  // Stops caching, e.g. when talking to an older Auth server.
+  void disable();
+
+  // Returns nullptr when the key is not cached or its entry expired.
+  std::shared_ptr<const S3AuthCacheEntry> get(
+      const std::string& access_key, const std::string& credential_scope);
+
+  void put(const std::string& access_key, const std::string& credential_scope,
+           std::shared_ptr<const S3AuthCacheEntry> entry);
+
+  size_t size();
+
+  friend class S3AuthClientTest;
+};
+
+#endif
@@ -23,16 +23,22 @@
 #include <unistd.h>
 #include <string>
 
+#include "s3_auth_cache.h"
 #include "s3_auth_client.h"
 #include "s3_auth_fake.h"
+#include "s3_aws_v4_signer.h"
 #include "s3_common.h"
 #include "s3_error_codes.h"
 #include "s3_fi_common.h"
 #include "s3_iem.h"
 #include "s3_option.h"
 #include "s3_common_utilities.h"
+#include "s3_stats.h"
 #include "atexit.h"
 
+// Same limit as the Auth server applies to the request timestamp
+#define S3_AUTH_MAX_REQUEST_TIME_SKEW_SEC (15 * 60)
+
 // S3 Auth client callbacks
 
 static int log_http_header(evhtp_header_t *header, void *arg) {
@@ -87,6 +93,8 @@ static evhtp_res on_conn_err_callback(evhtp_connection_t *p_evhtp_conn,
   if (p_evhtp_conn->request) {
     evhtp_unset_all_hooks(&p_evhtp_conn->request->hooks);
   }
+  p_auth_ctx->forget_connection();
+
   if (request_inst->client_connected()) {
     p_auth_ctx->set_op_status_for(0, S3AsyncOpStatus::connection_failed,
                                   "Cannot connect to Auth server.");
@@ -154,6 +162,9 @@ evhtp_res on_read_response(evhtp_request_t *p_req, evbuf_t *p_buf,
   }
   assert(p_buf != nullptr);
   const auto buffer_len = evbuffer_get_length(p_buf);
+  if (p_auth_ctx->get_content_length() == (long)buffer_len) {
+    p_auth_ctx->on_response_complete();
+  }
 
   char *auth_response_body = (char *)::malloc(buffer_len + 1);
   if (auth_response_body == NULL) {
@@ -213,6 +224,10 @@ static void timeout_cb_auth_retry(evutil_socket_t fd, short event, void *arg) {
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
+static void on_chunk_auth_event(evutil_socket_t fd, short event, void *arg) {
+  static_cast<S3AuthClient *>(arg)->verify_chunk_signature();
+}
+
 static void on_event_hook(evhtp_connection_t *conn, short events, void *p_arg) {
 
   auto *p_auth_ctx = static_cast<S3AuthClientOpContext *>(p_arg);
@@ -280,6 +295,9 @@ static evhtp_res on_response_header(evhtp_request_t *,
 
   if (!strcasecmp(p_evhtp_hdr->key, "Content-Length")) {
     p_auth_ctx->save_content_length(atol(p_evhtp_hdr->val));
+  } else if (!strcasecmp(p_evhtp_hdr->key, "Connection") &&
+             !strcasecmp(p_evhtp_hdr->val, "close")) {
+    p_auth_ctx->save_connection_close();
   }
   return EVHTP_RES_OK;
 }
@@ -304,6 +322,7 @@ static evhtp_res on_response_headers_end(evhtp_request_t *p_evhtp_req,
     s3_log(S3_LOG_WARN, p_auth_ctx->get_request_id(),
            "S3AuthClient doesn't return \"Content-Length\" header");
   } else if (content_lentgh == 0) {
+    p_auth_ctx->on_response_complete();
 
     switch (p_auth_ctx->op_type) {
       case S3AuthClientOpType::aclvalidation:
@@ -550,8 +569,10 @@ void S3AuthClientOpContext::unset_hooks() {
 }
 
 void S3AuthClientOpContext::clear_op_context() {
-  free_basic_auth_client_op_ctx(auth_op_context);
+  free_basic_auth_client_op_ctx(auth_op_context, f_conn_reusable);
   auth_op_context = NULL;
+  f_conn_close = false;
+  f_conn_reusable = false;
 }
 
 // S3AuthClient
@@ -570,6 +591,9 @@ S3AuthClient::S3AuthClient(std::shared_ptr<RequestObject> req,
 
 S3AuthClient::~S3AuthClient() {
   s3_log(S3_LOG_DEBUG, request_id, "%s\n", __func__);
+  if (chunk_auth_event) {
+    event_free(chunk_auth_event);
+  }
   ADDB_AUTH(ACTS_AUTH_CLNT_DESTRUCT);
 }
 
@@ -639,96 +663,60 @@ std::string S3AuthClient::get_error_code() const {
   return "ServiceUnavailable";  // auth server may be down
 }
 
-bool S3AuthClient::setup_auth_request_body() {
-  s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
-
-  // Setup the headers to forward to auth service
-  s3_log(S3_LOG_DEBUG, request_id, "Headers from S3 client:\n");
-
-  data_key_val.clear();
-
-  if (op_type != S3AuthClientOpType::policyvalidation) {
-
-    for (const auto &hdr_val : request->get_in_headers_copy()) {
-      const auto &s_hdr = hdr_val.first;
-      const auto &s_val = hdr_val.second;
-
-      s3_log(S3_LOG_DEBUG, request_id, "%s: %s\n", s_hdr.c_str(),
-             s_val.c_str());
-      add_key_val_to_body(s_hdr, s_val);
-    }
+std::string S3AuthClient::get_auth_method() const {
+  if (set_get_method) {
+    return "GET";
   }
-  std::string auth_request_body;
-  std::string method;
-
   switch (request->http_verb()) {
     case S3HttpVerb::GET:
-      method = "GET";
-      break;
+      return "GET";
     case S3HttpVerb::HEAD:
-      method = "HEAD";
-      break;
+      return "HEAD";
     case S3HttpVerb::PUT:
-      method = "PUT";
-      break;
+      return "PUT";
     case S3HttpVerb::DELETE:
-      method = "DELETE";
-      break;
+      return "DELETE";
     case S3HttpVerb::POST:
-      method = "POST";
-      break;
+      return "POST";
     default:
       ;  // -Wall
   }
-  if (set_get_method) {
-    method = "GET";
-  }
-  add_key_val_to_body("Method", method);
-  add_key_val_to_body("RequestorAccountId", request->get_account_id());
-  add_key_val_to_body("RequestorAccountName", request->get_account_name());
-  add_key_val_to_body("RequestorUserId", request->get_user_id());
-  add_key_val_to_body("RequestorUserName", request->get_user_name());
-  add_key_val_to_body("RequestorEmail", request->get_email());
-  add_key_val_to_body("RequestorCanonicalId", request->get_canonical_id());
-
-  std::shared_ptr<S3RequestObject> s3_request =
-      std::dynamic_pointer_cast<S3RequestObject>(request);
-
-  if (entity_path.empty()) {
+  return "";
+}
 
-    const char *sz_full_path = request->c_get_full_encoded_path();
+void S3AuthClient::init_entity_path() {
+  if (!entity_path.empty()) {
+    return;
+  }
+  const char *sz_full_path = request->c_get_full_encoded_path();
 
-    if (sz_full_path) {
-      entity_path.assign(sz_full_path);
+  if (sz_full_path) {
+    entity_path.assign(sz_full_path);
 
-      // in encoded uri path space is encoding as '+'
-      // but cannonical request should have '%20' for verification.
-      // decode plus into space, this special handling
-      // is not required for other charcters.
-      S3CommonUtilities::find_and_replaceall(entity_path, "+", "%20");
+    // in encoded uri path space is encoding as '+'
+    // but cannonical request should have '%20' for verification.
+    // decode plus into space, this special handling
+    // is not required for other charcters.
+    S3CommonUtilities::find_and_replaceall(entity_path, "+", "%20");
 
-      std::string authorization_header =
-          request->get_header_value("Authorization");
+    std::string authorization_header =
+        request->get_header_value("Authorization");
 
-      if (authorization_header.rfind("AWS4-HMAC-SHA256", 0) == 0) {
-        S3CommonUtilities::find_and_replaceall(entity_path, "!", "%21");
-      }
+    if (authorization_header.rfind("AWS4-HMAC-SHA256", 0) == 0) {
+      S3CommonUtilities::find_and_replaceall(entity_path, "!", "%21");
     }
   }
-  if (entity_path == "/" && S3AuthClientOpType::policyvalidation == op_type) {
-    entity_path.append(s3_request->get_bucket_name());
-  }
-  add_key_val_to_body("ClientAbsoluteUri", entity_path);
+}
 
+bool S3AuthClient::get_client_query_params(std::string &query) {
   // get the query paramters in a map
   // eg: query_map = { {prefix, abc&def}, {delimiter, /}};
   const std::map<std::string, std::string, compare> query_map =
       request->get_query_parameters();
-  std::string query;
   // iterate through the each query parameter
   // and url-encode the values (abc%26def)
   // then form the query (prefix=abc%26def&delimiter=%2F)
-  bool f_evhttp_encode_uri_succ = true;
+  query.clear();
 
   for (auto it : query_map) {
     if (it.second == "") {
@@ -739,8 +727,9 @@ bool S3AuthClient::setup_auth_request_body() {
       if (!encoded_value) {
         s3_log(S3_LOG_ERROR, request_id, "Failed to URI encode value = %s",
                it.second.c_str());
-        f_evhttp_encode_uri_succ = false;
-        break;
+        s3_log(S3_LOG_ERROR, request_id,
+               "evhttp_encode_uri() returned NULL for client query params");
+        return false;
       }
 
       std::string encoded_value_str = encoded_value;
@@ -749,14 +738,55 @@ bool S3AuthClient::setup_auth_request_body() {
       free(encoded_value);
     }
   }
+  return true;
+}
 
-  if (!f_evhttp_encode_uri_succ) {
-    s3_log(S3_LOG_ERROR, request_id,
-           "evhttp_encode_uri() returned NULL for client query params");
-    auth_request_body.clear();
-    return false;
+bool S3AuthClient::setup_auth_request_body() {
+  s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+
+  // Setup the headers to forward to auth service
+  s3_log(S3_LOG_DEBUG, request_id, "Headers from S3 client:\n");
+
+  data_key_val.clear();
+  signing_key_requested = false;
+  signing_key_cacheable = false;
+
+  if (op_type != S3AuthClientOpType::policyvalidation) {
+
+    for (const auto &hdr_val : request->get_in_headers_copy()) {
+      const auto &s_hdr = hdr_val.first;
+      const auto &s_val = hdr_val.second;
+
+      s3_log(S3_LOG_DEBUG, request_id, "%s: %s\n", s_hdr.c_str(),
+             s_val.c_str());
+      add_key_val_to_body(s_hdr, s_val);
+    }
   }
+  std::string auth_request_body;
 
+  add_key_val_to_body("Method", get_auth_method());
+  add_key_val_to_body("RequestorAccountId", request->get_account_id());
+  add_key_val_to_body("RequestorAccountName", request->get_account_name());
+  add_key_val_to_body("RequestorUserId", request->get_user_id());
+  add_key_val_to_body("RequestorUserName", request->get_user_name());
+  add_key_val_to_body("RequestorEmail", request->get_email());
+  add_key_val_to_body("RequestorCanonicalId", request->get_canonical_id());
+
+  std::shared_ptr<S3RequestObject> s3_request =
+      std::dynamic_pointer_cast<S3RequestObject>(request);
+
+  init_entity_path();
+
+  if (entity_path == "/" && S3AuthClientOpType::policyvalidation == op_type) {
+    entity_path.append(s3_request->get_bucket_name());
+  }
+  add_key_val_to_body("ClientAbsoluteUri", entity_path);
+
+  std::string query;
+
+  if (!get_client_query_params(query)) {
+    return false;
+  }
   add_key_val_to_body("ClientQueryParams", query);
 
   // May need to take it from config
@@ -807,6 +837,9 @@ bool S3AuthClient::setup_auth_request_body() {
     add_non_empty_key_val_to_body("Bucket-ACL", bucket_acl);
 
     if (op_type == S3AuthClientOpType::combo_auth) {
+      // Signing key is returned along with authorization, so further
+      // requests of the same credential scope only need authorization.
+      request_signing_key();
       auth_request_body = "Action=AuthenticateAndAuthorize";
     } else {
       auth_request_body = "Action=AuthorizeUser";
@@ -820,6 +853,9 @@ bool S3AuthClient::setup_auth_request_body() {
       add_key_val_to_body("current-signature-sha256",
                           current_chunk_signature_from_auth);
       add_key_val_to_body("x-amz-content-sha256", hash_sha256_current_chunk);
+
+    } else if (!is_chunked_auth) {
+      request_signing_key();
     }
 
     auth_request_body = "Action=AuthenticateUser";
@@ -833,6 +869,8 @@ bool S3AuthClient::setup_auth_request_body() {
     auth_request_body = "Action=ValidatePolicy";
   }
 
+  bool f_evhttp_encode_uri_succ = true;
+
   for (auto &it : data_key_val) {
 
     char *encoded_key = evhttp_encode_uri(it.first.c_str());
@@ -907,15 +945,14 @@ void S3AuthClient::setup_auth_request_headers() {
 
   evhtp_headers_add_header(p_evhtp_req->headers_out,
                            evhtp_header_new("User-Agent", "s3server", 1, 1));
-  /* Using a new connection per request, all types of requests like
-  *   authenticarion, authorization, validateacl, validatepolicy open
-  *   a connection and it will be closed by Authserver.
-  *   TODO : Evaluate performance and change this approach to reuse
-  *   connections
-  */
-
-  evhtp_headers_add_header(p_evhtp_req->headers_out,
-                           evhtp_header_new("Connection", "close", 1, 1));
+  // Without a connection pool every request uses a new connection which
+  // is closed by Authserver once it has responded.
+  const bool keep_alive = auth_context->get_auth_op_ctx() &&
+                          auth_context->get_auth_op_ctx()->pooled;
+  evhtp_headers_add_header(
+      p_evhtp_req->headers_out,
+      evhtp_header_new("Connection", keep_alive ? "keep-alive" : "close", 0,
+                       0));
 
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
@@ -1085,6 +1122,14 @@ void S3AuthClient::on_common_success() {
   if (is_chunked_auth) {
     assert(S3AuthClientOpType::authentication == op_type);
     prev_chunk_signature_from_auth = get_signature_from_response();
+  } else {
+    if (signing_key_requested) {
+      save_signing_key();
+    }
+    if (op_type == S3AuthClientOpType::authentication ||
+        op_type == S3AuthClientOpType::combo_auth) {
+      charge_qos_ticket();
+    }
   }
   this->handler_on_success();
 
@@ -1188,7 +1233,13 @@ void S3AuthClient::check_combo_auth(std::function<void(void)> on_success,
       break;
     }
   }
-  trigger_request(std::move(on_success), std::move(on_failed));
+  if (authenticate_from_cache()) {
+    // Signature is verified with cached signing key, only authorization
+    // is left to Auth server.
+    check_authorization(std::move(on_success), std::move(on_failed));
+  } else {
+    trigger_request(std::move(on_success), std::move(on_failed));
+  }
 
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
@@ -1222,6 +1273,19 @@ void S3AuthClient::check_authentication(std::function<void(void)> on_success,
   s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
 
   ADDB_AUTH(ACTS_AUTH_CLNT_CHK_AUTH);
+  is_chunked_auth = false;
+
+  if (authenticate_from_cache()) {
+    state = S3AuthClientOpState::succeded;
+    on_success();
+  } else {
+    authenticate_with_server(std::move(on_success), std::move(on_failed));
+  }
+  s3_log(S3_LOG_DEBUG, nullptr, "%s Exit", __func__);
+}
+
+void S3AuthClient::authenticate_with_server(
+    std::function<void(void)> on_success, std::function<void(void)> on_failed) {
   auth_context.reset(new S3AuthClientOpContext(
       request, std::bind(&S3AuthClient::on_common_success, this),
       std::bind(&S3AuthClient::on_common_failed, this),
@@ -1230,8 +1294,127 @@ void S3AuthClient::check_authentication(std::function<void(void)> on_success,
   is_chunked_auth = false;
 
   trigger_request(std::move(on_success), std::move(on_failed));
+}
 
-  s3_log(S3_LOG_DEBUG, nullptr, "%s Exit", __func__);
+bool S3AuthClient::can_use_auth_cache(const S3AwsV4Signer &signer) {
+  if (!S3AuthCache::get_instance()->is_enabled() || !signer.is_ok() ||
+      !request->get_header_value("x-amz-security-token").empty()) {
+    return false;
+  }
+  // x-amz-date must be in the credential scope and not too far from now,
+  // this is what the Auth server checks before the signature.
+  const std::string amz_date = request->get_header_value("x-amz-date");
+  struct tm tm_amz_date = {};
+  const char *end = strptime(amz_date.c_str(), "%Y%m%dT%H%M%SZ", &tm_amz_date);
+
+  if (!end || *end ||
+      amz_date.compare(0, signer.get_scope_date().length(),
+                       signer.get_scope_date()) != 0) {
+    return false;
+  }
+  const double skew = difftime(time(NULL), timegm(&tm_amz_date));
+  return skew <= S3_AUTH_MAX_REQUEST_TIME_SKEW_SEC &&
+         skew >= -S3_AUTH_MAX_REQUEST_TIME_SKEW_SEC;
+}
+
+void S3AuthClient::request_signing_key() {
+  // Auth server only returns signing keys to callers knowing the secret.
+  const std::string &secret =
+      S3Option::get_instance()->get_auth_signing_key_secret();
+  S3AwsV4Signer signer(request->get_header_value("Authorization"));
+
+  if (secret.empty() || !signer.is_ok()) {
+    return;
+  }
+  signing_key_cacheable = can_use_auth_cache(signer);
+  // Chunk signatures of an aws-chunked upload are verified with the signing
+  // key of its seed, whether S3AuthCache may keep that key or not.
+  if (signing_key_cacheable || request->is_chunked()) {
+    add_key_val_to_body("Request-Signing-Key", secret);
+    signing_key_requested = true;
+  }
+}
+
+bool S3AuthClient::authenticate_from_cache() {
+  S3AwsV4Signer signer(request->get_header_value("Authorization"));
+
+  if (!can_use_auth_cache(signer)) {
+    return false;
+  }
+  auto entry = S3AuthCache::get_instance()->get(
+      signer.get_access_key(), signer.get_credential_scope());
+  if (!entry) {
+    s3_stats_inc("auth_cache_miss_count");
+    return false;
+  }
+  std::string query;
+  if (!get_client_query_params(query)) {
+    return false;
+  }
+  init_entity_path();
+
+  const std::string signature = signer.calculate_signature(
+      entry->signing_key, get_auth_method(), entity_path, query,
+      request->get_in_headers_copy());
+  if (!S3AwsV4Signer::signatures_match(signer.get_signature(), signature)) {
+    // Let the Auth server give the exact error
+    s3_log(S3_LOG_DEBUG, request_id,
+           "Signature does not match with cached signing key\n");
+    s3_stats_inc("auth_cache_miss_count");
+    return false;
+  }
+  signing_key = entry->signing_key;
+  request->set_user_name(entry->user_name);
+  request->set_canonical_id(entry->canonical_id);
+  request->set_user_id(entry->user_id);
+  request->set_account_name(entry->account_name);
+  request->set_account_id(entry->account_id);
+  request->set_email(entry->email);
+
+  s3_log(S3_LOG_DEBUG, request_id, "Authenticated with cached signing key\n");
+  s3_stats_inc("auth_cache_hit_count");
+  charge_qos_ticket();
+  return true;
+}
+
+void S3AuthClient::charge_qos_ticket() {
+  std::shared_ptr<S3RequestObject> s3_request =
+      std::dynamic_pointer_cast<S3RequestObject>(request);
+  if (s3_request) {
+    s3_request->charge_qos_ticket();
+  }
+}
+
+void S3AuthClient::save_signing_key() {
+  const std::string hex_signing_key = auth_context->get_signing_key();
+
+  if (hex_signing_key.empty()) {
+    if (signing_key_cacheable) {
+      S3AuthCache::get_instance()->disable();
+    }
+    return;
+  }
+  auto entry = std::make_shared<S3AuthCacheEntry>();
+
+  if (!S3AwsV4Signer::from_hex(hex_signing_key, entry->signing_key)) {
+    s3_log(S3_LOG_WARN, request_id, "Invalid signing key from Auth server\n");
+    return;
+  }
+  signing_key = entry->signing_key;
+  if (!signing_key_cacheable) {
+    return;
+  }
+  entry->user_name = request->get_user_name();
+  entry->user_id = request->get_user_id();
+  entry->account_name = request->get_account_name();
+  entry->account_id = request->get_account_id();
+  entry->canonical_id = request->get_canonical_id();
+  entry->email = request->get_email();
+
+  S3AwsV4Signer signer(request->get_header_value("Authorization"));
+  S3AuthCache::get_instance()->put(signer.get_access_key(),
+                                   signer.get_credential_scope(),
+                                   std::move(entry));
 }
 
 // This is same as above but will cycle through with the
@@ -1254,6 +1437,22 @@ void S3AuthClient::init_chunk_auth_cycle(std::function<void(void)> on_success,
   is_chunked_auth = true;
   state = S3AuthClientOpState::init;
 
+  if (!signing_key.empty()) {
+    // The seed signature is already verified, so the chunk signatures can
+    // be checked here with the same signing key.
+    chunk_signer.reset(
+        new S3AwsV4Signer(request->get_header_value("Authorization")));
+    if (!chunk_auth_event) {
+      chunk_auth_event =
+          event_new(S3Option::get_instance()->get_eventbase(), -1, 0,
+                    on_chunk_auth_event, (void *)this);
+    }
+    if (!chunk_auth_event) {
+      // Fall back to the Auth server
+      chunk_signer.reset();
+    }
+  }
+
   s3_log(S3_LOG_DEBUG, request_id, "%s Exit", __func__);
   // trigger is done when sign and hash are available for any chunk
 }
@@ -1276,7 +1475,7 @@ void S3AuthClient::add_checksum_for_chunk(std::string current_sign,
 
     chunk_validation_data.pop();
 
-    trigger_request();
+    trigger_chunk_auth();
   }
   s3_log(S3_LOG_DEBUG, nullptr, "%s Exit", __func__);
 }
@@ -1297,7 +1496,11 @@ void S3AuthClient::chunk_auth_successful() {
 
   ADDB_AUTH(ACTS_AUTH_CLNT_CHUNK_AUTH_SUCC);
   // remember_auth_details_in_request();
-  prev_chunk_signature_from_auth = get_signature_from_response();
+  if (chunk_signer) {
+    prev_chunk_signature_from_auth = current_chunk_signature_from_auth;
+  } else {
+    prev_chunk_signature_from_auth = get_signature_from_response();
+  }
 
   if (chunk_auth_aborted ||
       (last_chunk_added && chunk_validation_data.empty())) {
@@ -1315,7 +1518,7 @@ void S3AuthClient::chunk_auth_successful() {
 
     chunk_validation_data.pop();
 
-    trigger_request();
+    trigger_chunk_auth();
   }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
@@ -1329,3 +1532,30 @@ void S3AuthClient::chunk_auth_failed() {
 
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
+
+void S3AuthClient::trigger_chunk_auth() {
+  if (!chunk_signer) {
+    trigger_request();
+    return;
+  }
+  state = S3AuthClientOpState::started;
+  event_active(chunk_auth_event, EV_TIMEOUT, 0);
+}
+
+void S3AuthClient::verify_chunk_signature() {
+  s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+
+  const std::string signature = chunk_signer->calculate_chunk_signature(
+      signing_key, request->get_header_value("x-amz-date"),
+      prev_chunk_signature_from_auth, hash_sha256_current_chunk);
+
+  if (!signature.empty() &&
+      S3AwsV4Signer::signatures_match(current_chunk_signature_from_auth,
+                                      signature)) {
+    chunk_auth_successful();
+  } else {
+    s3_log(S3_LOG_ERROR, request_id, "Chunk signature does not match\n");
+    chunk_auth_failed();
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
@@ -46,6 +46,8 @@
 
 evhtp_res on_read_response(evhtp_request_t* p_req, evbuf_t* p_buf, void* p_arg);
 
+class S3AwsV4Signer;
+
 class S3AuthClientOpContext : public S3AsyncOpContextBase {
 
   std::string s_resp;
@@ -56,6 +58,10 @@ class S3AuthClientOpContext : public S3AsyncOpContextBase {
   struct s3_auth_op_context* auth_op_context = NULL;
   long content_length = -1;
   bool f_success = false;
+  // Auth server answered "Connection: close"
+  bool f_conn_close = false;
+  // Response has been read completely, so the connection can be pooled
+  bool f_conn_reusable = false;
 
  public:
   const S3AuthClientOpType op_type;
@@ -74,6 +80,14 @@ class S3AuthClientOpContext : public S3AsyncOpContextBase {
 
   long get_content_length() const { return content_length; }
   void save_content_length(long val) { content_length = val; }
+  void save_connection_close() { f_conn_close = true; }
+  void on_response_complete() { f_conn_reusable = !f_conn_close; }
+  // The connection is freed by evhtp after a connection error.
+  void forget_connection() {
+    if (auth_op_context) {
+      auth_op_context->conn = NULL;
+    }
+  }
 
   void set_auth_response_error(std::string error_code,
                                std::string error_message,
@@ -88,6 +102,9 @@ class S3AuthClientOpContext : public S3AsyncOpContextBase {
   std::string get_signature_sha256() const {
     return f_success ? success_obj->get_signature_sha256() : "";
   }
+  std::string get_signing_key() const {
+    return f_success ? success_obj->get_signing_key() : "";
+  }
   const std::string& get_error_message() const {
     return error_obj->get_message();
   }
@@ -171,9 +188,45 @@ class S3AuthClient {
   bool is_authheader_present;
 
   bool skip_authorization;
+  // Set when the authentication or combined authentication and
+  // authorization request asks the Auth server for the signing key, to be
+  // kept in S3AuthCache or to verify aws-chunked chunk signatures
+  bool signing_key_requested = false;
+  // Set when the requested signing key may be kept in S3AuthCache
+  bool signing_key_cacheable = false;
+  // Signing key of the request's credential scope, known once the request
+  // is authenticated through S3AuthCache or with the key requested
+  std::string signing_key;
+  // Set for aws-chunked uploads when chunk signatures are verified here
+  // instead of by the Auth server
+  std::unique_ptr<S3AwsV4Signer> chunk_signer;
+  struct event* chunk_auth_event = nullptr;
 
   void trigger_request(std::function<void(void)> on_success,
                        std::function<void(void)> on_failed);
+
+  std::string get_auth_method() const;
+  void init_entity_path();
+  bool get_client_query_params(std::string& query);
+
+  // Whether the request is signed in a way S3AuthCache can verify
+  bool can_use_auth_cache(const S3AwsV4Signer& signer);
+  // Adds Request-Signing-Key with the shared secret to the request body if
+  // the signing key of the request could be cached or the request is an
+  // aws-chunked upload.
+  void request_signing_key();
+  // Verifies the AWS V4 signature with a cached signing key and sets the
+  // requestor identity. Returns false when the Auth server must be asked.
+  bool authenticate_from_cache();
+  // Keeps the signing key returned by the Auth server, in S3AuthCache too
+  // when it may be cached.
+  void save_signing_key();
+  // QoS limits of the request's access key are charged only once it is
+  // authenticated.
+  void charge_qos_ticket();
+  void authenticate_with_server(std::function<void(void)> on_success,
+                                std::function<void(void)> on_failed);
+  void trigger_chunk_auth();
   // void remember_auth_details_in_request();
 
   void on_common_success();
@@ -239,6 +292,9 @@ class S3AuthClient {
                                            std::string sha256_of_payload);
   void chunk_auth_successful();
   void chunk_auth_failed();
+  // Checks the current chunk signature with the signing key, called from
+  // the event loop like a response from the Auth server would be.
+  void verify_chunk_signature();
 
   void abort_chunk_auth_op() { chunk_auth_aborted = true; }
   bool is_chunk_auth_op_aborted() { return chunk_auth_aborted; }
@@ -262,6 +318,15 @@ class S3AuthClient {
   FRIEND_TEST(S3AuthClientTest, SetUpAuthRequestBodyForChunkedAuth);
   FRIEND_TEST(S3AuthClientTest, SetUpAuthRequestBodyForChunkedAuth1);
   FRIEND_TEST(S3AuthClientTest, SetUpAuthRequestBodyForChunkedAuth2);
+  FRIEND_TEST(S3AuthClientTest, SetUpAuthRequestBodyRequestsSigningKey);
+  FRIEND_TEST(S3AuthClientTest, SetUpAuthRequestBodyNoSigningKeyWithoutSecret);
+  FRIEND_TEST(S3AuthClientTest,
+              SetUpAuthRequestBodyChunkedSeedRequestsSigningKey);
+  FRIEND_TEST(S3AuthClientTest, SetUpComboAuthRequestBodyRequestsSigningKey);
+  FRIEND_TEST(S3AuthClientTest, CheckAuthenticationCacheMismatch);
+  friend class S3AuthClientChunkTest;
+  FRIEND_TEST(S3AuthClientChunkTest, VerifyChunkSignatureLocally);
+  FRIEND_TEST(S3AuthClientChunkTest, VerifyChunkSignatureLocallyFails);
   FRIEND_TEST(S3BucketActionTest, SetAuthorizationMeta);
 };
 
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include "s3_auth_connection_pool.h"
+#include "s3_auth_context.h"
+#include "s3_log.h"
+#include "s3_option.h"
+#include "s3_stats.h"
+
+std::mutex S3AuthConnectionPool::instances_lock;
+std::map<evbase_t*, S3AuthConnectionPool*> S3AuthConnectionPool::instances;
+
+S3AuthConnectionPool::S3AuthConnectionPool(evbase_t* evbase, size_t max_idle,
+                                           unsigned int idle_timeout_millisec)
+    : evbase(evbase),
+      max_idle(max_idle),
+      idle_timeout(idle_timeout_millisec),
+      release_event(NULL) {}
+
+S3AuthConnectionPool::~S3AuthConnectionPool() {
+  if (release_event) {
+    event_free(release_event);
+    release_event = NULL;
+  }
+  for (auto& entry : idle) {
+    close(entry.conn);
+  }
+  for (auto conn : released) {
+    close(conn);
+  }
+  for (auto conn : to_close) {
+    close(conn);
+  }
+}
+
+S3AuthConnectionPool* S3AuthConnectionPool::get_instance(evbase_t* evbase) {
+  S3Option* option_instance = S3Option::get_instance();
+  if (!evbase || option_instance->get_auth_connection_pool_size() == 0) {
+    return NULL;
+  }
+  std::lock_guard<std::mutex> guard(instances_lock);
+  S3AuthConnectionPool*& pool = instances[evbase];
+  if (!pool) {
+    pool = new S3AuthConnectionPool(
+        evbase, option_instance->get_auth_connection_pool_size(),
+        option_instance->get_auth_connection_idle_timeout_millisec());
+  }
+  return pool;
+}
+
+void S3AuthConnectionPool::destroy_instances() {
+  std::lock_guard<std::mutex> guard(instances_lock);
+  for (auto& instance : instances) {
+    delete instance.second;
+  }
+  instances.clear();
+}
+
+evhtp_connection_t* S3AuthConnectionPool::acquire() {
+  const auto now = std::chrono::steady_clock::now();
+
+  while (!idle.empty()) {
+    idle_connection entry = idle.front();
+    idle.pop_front();
+
+    if (now - entry.idle_since >= idle_timeout) {
+      close(entry.conn);
+      continue;
+    }
+    evhtp_unset_all_hooks(&entry.conn->hooks);
+    // evhtp does not free the request of a client connection until the
+    // connection itself is freed.
+    if (entry.conn->request) {
+      evhtp_request_t* prev_request = entry.conn->request;
+      entry.conn->request = NULL;
+      evhtp_request_free(prev_request);
+    }
+    s3_stats_inc("auth_connection_reused_count");
+    return entry.conn;
+  }
+  evhtp_connection_t* conn = create_auth_connection(evbase);
+  if (conn) {
+    s3_stats_inc("auth_connection_created_count");
+  }
+  return conn;
+}
+
+void S3AuthConnectionPool::release(evhtp_connection_t* conn, bool reusable) {
+  if (!conn) {
+    return;
+  }
+  evhtp_unset_all_hooks(&conn->hooks);
+  if (conn->request) {
+    evhtp_unset_all_hooks(&conn->request->hooks);
+  }
+  // Auth server may close an idle connection at any time, evhtp then
+  // frees it and the pool must forget it.
+  evhtp_set_hook(&conn->hooks, evhtp_hook_on_conn_error,
+                 (evhtp_hook)on_idle_conn_error, this);
+  evhtp_set_hook(&conn->hooks, evhtp_hook_on_connection_fini,
+                 (evhtp_hook)on_idle_conn_fini, this);
+
+  if (reusable) {
+    released.push_back(conn);
+  } else {
+    to_close.push_back(conn);
+  }
+  schedule_release();
+}
+
+void S3AuthConnectionPool::schedule_release() {
+  if (!release_event) {
+    release_event = event_new(evbase, -1, 0, on_release_event, this);
+    if (!release_event) {
+      s3_log(S3_LOG_ERROR, "", "event_new() failed\n");
+      return;
+    }
+  }
+  event_active(release_event, 0, 1);
+}
+
+void S3AuthConnectionPool::on_release_event(evutil_socket_t, short,
+                                            void* arg) {
+  auto* pool = static_cast<S3AuthConnectionPool*>(arg);
+  const auto now = std::chrono::steady_clock::now();
+
+  while (!pool->to_close.empty()) {
+    evhtp_connection_t* conn = pool->to_close.front();
+    pool->to_close.pop_front();
+    pool->close(conn);
+  }
+  while (!pool->released.empty()) {
+    pool->idle.push_front({pool->released.front(), now});
+    pool->released.pop_front();
+  }
+  while (!pool->idle.empty() &&
+         (pool->idle.size() > pool->max_idle ||
+          now - pool->idle.back().idle_since >= pool->idle_timeout)) {
+    evhtp_connection_t* conn = pool->idle.back().conn;
+    pool->idle.pop_back();
+    pool->close(conn);
+  }
+  s3_log(S3_LOG_DEBUG, "", "%zu idle Auth server connection(s)\n",
+         pool->idle.size());
+}
+
+void S3AuthConnectionPool::forget(evhtp_connection_t* conn) {
+  idle.remove_if(
+      [conn](const idle_connection& entry) { return entry.conn == conn; });
+  released.remove(conn);
+  to_close.remove(conn);
+}
+
+void S3AuthConnectionPool::close(evhtp_connection_t* conn) {
+  evhtp_unset_all_hooks(&conn->hooks);
+  evhtp_connection_free(conn);
+  s3_stats_inc("auth_connection_closed_count");
+}
+
+evhtp_res S3AuthConnectionPool::on_idle_conn_error(evhtp_connection_t* conn,
+                                                   evhtp_error_flags,
+                                                   void* arg) {
+  s3_log(S3_LOG_DEBUG, "", "Idle Auth server connection %p closed\n",
+         (void*)conn);
+  static_cast<S3AuthConnectionPool*>(arg)->forget(conn);
+  return EVHTP_RES_OK;
+}
+
+evhtp_res S3AuthConnectionPool::on_idle_conn_fini(evhtp_connection_t* conn,
+                                                  void* arg) {
+  static_cast<S3AuthConnectionPool*>(arg)->forget(conn);
+  return EVHTP_RES_OK;
+}
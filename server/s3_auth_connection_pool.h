@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_AUTH_CONNECTION_POOL_H__
+#define __S3_SERVER_S3_AUTH_CONNECTION_POOL_H__
+
+#include <chrono>
+#include <list>
+#include <map>
+#include <mutex>
+
+#include <gtest/gtest_prod.h>
+
+#include "s3_common.h"
+
+EXTERN_C_BLOCK_BEGIN
+
+#include <evhtp.h>
+
+EXTERN_C_BLOCK_END
+
+// Keep-alive connections to the Auth server owned by one event base.
+// Every request to the Auth server used to open a new (possibly TLS)
+// connection which the Auth server closed after the response. The pool
+// keeps finished connections open and hands them to the next request
+// of the same event loop.
+//
+// evhtp client connections carry a single request at a time, so the pool
+// is not thread safe and must only be used from the thread running its
+// event base.
+class S3AuthConnectionPool {
+  struct idle_connection {
+    evhtp_connection_t* conn;
+    std::chrono::steady_clock::time_point idle_since;
+  };
+
+  evbase_t* evbase;
+  size_t max_idle;
+  std::chrono::milliseconds idle_timeout;
+
+  // Connections ready for the next request, most recently used first
+  std::list<idle_connection> idle;
+  // Connections released from within evhtp callbacks, they are moved to
+  // the idle list (or closed) once the callback has returned.
+  std::list<evhtp_connection_t*> released;
+  std::list<evhtp_connection_t*> to_close;
+  struct event* release_event;
+
+  static std::mutex instances_lock;
+  static std::map<evbase_t*, S3AuthConnectionPool*> instances;
+
+  void schedule_release();
+  void forget(evhtp_connection_t* conn);
+  void close(evhtp_connection_t* conn);
+
+  static void on_release_event(evutil_socket_t, short, void* arg);
+  static evhtp_res on_idle_conn_error(evhtp_connection_t* conn,
+                                      evhtp_error_flags errtype, void* arg);
+  static evhtp_res on_idle_conn_fini(evhtp_connection_t* conn, void* arg);
+
+ public:
+  S3AuthConnectionPool(evbase_t* evbase, size_t max_idle,
+                       unsigned int idle_timeout_millisec);
+  ~S3AuthConnectionPool();
+
+  // Returns NULL when connection reuse is disabled.
+  static S3AuthConnectionPool* get_instance(evbase_t* evbase);
+  // Must be called once the event loops have stopped and before their
+  // event bases are freed.
+  static void destroy_instances();
+
+  // Returns an idle connection or opens a new one.
+  evhtp_connection_t* acquire();
+  // Returns a connection after its request has finished. Connections with
+  // a complete response are kept for reuse, others are closed.
+  // Safe to call from within evhtp callbacks of the connection.
+  void release(evhtp_connection_t* conn, bool reusable);
+
+  size_t get_idle_count() const { return idle.size(); }
+
+  FRIEND_TEST(S3AuthConnectionPoolTest, IdleListIsBounded);
+};
+
+#endif
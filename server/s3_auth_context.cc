@@ -20,27 +20,37 @@
 
 #include <event2/thread.h>
 
+#include "s3_auth_connection_pool.h"
 #include "s3_auth_context.h"
 #include "s3_log.h"
 #include "s3_option.h"
 
 extern evhtp_ssl_ctx_t *g_ssl_auth_ctx;
 
+evhtp_connection_t *create_auth_connection(struct event_base *eventbase) {
+  S3Option *option_instance = S3Option::get_instance();
+  if (option_instance->is_s3_ssl_auth_enabled()) {
+    return evhtp_connection_ssl_new(
+        eventbase, option_instance->get_auth_ip_addr().c_str(),
+        option_instance->get_auth_port(), g_ssl_auth_ctx);
+  }
+  return evhtp_connection_new(eventbase,
+                              option_instance->get_auth_ip_addr().c_str(),
+                              option_instance->get_auth_port());
+}
+
 struct s3_auth_op_context *create_basic_auth_op_ctx(
     struct event_base *eventbase) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
-  S3Option *option_instance = S3Option::get_instance();
   struct s3_auth_op_context *ctx =
       (struct s3_auth_op_context *)calloc(1, sizeof(struct s3_auth_op_context));
   ctx->evbase = eventbase;
-  if (option_instance->is_s3_ssl_auth_enabled()) {
-    ctx->conn = evhtp_connection_ssl_new(
-        ctx->evbase, option_instance->get_auth_ip_addr().c_str(),
-        option_instance->get_auth_port(), g_ssl_auth_ctx);
+  S3AuthConnectionPool *pool = S3AuthConnectionPool::get_instance(eventbase);
+  if (pool) {
+    ctx->conn = pool->acquire();
+    ctx->pooled = true;
   } else {
-    ctx->conn = evhtp_connection_new(
-        ctx->evbase, option_instance->get_auth_ip_addr().c_str(),
-        option_instance->get_auth_port());
+    ctx->conn = create_auth_connection(ctx->evbase);
   }
 
   ctx->auth_request = evhtp_request_new(NULL, ctx->evbase);
@@ -49,8 +59,13 @@ struct s3_auth_op_context *create_basic_auth_op_ctx(
   return ctx;
 }
 
-int free_basic_auth_client_op_ctx(struct s3_auth_op_context *ctx) {
+int free_basic_auth_client_op_ctx(struct s3_auth_op_context *ctx,
+                                  bool reusable) {
   s3_log(S3_LOG_DEBUG, "", "Called\n");
+  if (ctx && ctx->pooled && ctx->conn) {
+    S3AuthConnectionPool::get_instance(ctx->evbase)
+        ->release(ctx->conn, reusable);
+  }
   free(ctx);
   ctx = NULL;
   return 0;
@@ -33,12 +33,19 @@ struct s3_auth_op_context {
   evbase_t* evbase;
   evhtp_connection_t* conn;
   evhtp_request_t* auth_request;
+  // Connection belongs to the event base's S3AuthConnectionPool
+  bool pooled;
 };
 
+evhtp_connection_t* create_auth_connection(struct event_base* eventbase);
+
 struct s3_auth_op_context* create_basic_auth_op_ctx(
     struct event_base* eventbase);
 
-int free_basic_auth_client_op_ctx(struct s3_auth_op_context* ctx);
+// reusable tells whether the connection has completely read the response
+// of its last request and may be used by the next one.
+int free_basic_auth_client_op_ctx(struct s3_auth_op_context* ctx,
+                                  bool reusable);
 
 EXTERN_C_BLOCK_END
 
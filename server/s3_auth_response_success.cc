@@ -58,6 +58,10 @@ const std::string &S3AuthResponseSuccess::get_request_id() {
 
 const std::string &S3AuthResponseSuccess::get_acl() { return acl; }
 
+const std::string &S3AuthResponseSuccess::get_signing_key() {
+  return signing_key;
+}
+
 void S3AuthResponseSuccess::set_auth_parameters(xmlNode *child_node) {
   xmlChar *key;
   if (child_node == NULL) {
@@ -88,6 +92,10 @@ void S3AuthResponseSuccess::set_auth_parameters(xmlNode *child_node) {
                            (const xmlChar *)"SignatureSHA256"))) {
       s3_log(S3_LOG_DEBUG, "", "SignatureSHA256 =%s\n", (const char *)key);
       signature_SHA256 = (const char *)key;
+    } else if ((!xmlStrcmp(child_node->name,
+                           (const xmlChar *)"SigningKey"))) {
+      // Secret, not logged
+      signing_key = (const char *)key;
     } else if ((!xmlStrcmp(child_node->name, (const xmlChar *)"ACL"))) {
       s3_log(S3_LOG_DEBUG, "", "ACL =%s\n", (const char *)key);
       acl = (const char *)key;
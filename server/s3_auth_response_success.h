@@ -41,6 +41,8 @@ class S3AuthResponseSuccess {
   std::string request_id;
   std::string acl;
   std::string email;
+  // Hex encoded SigV4 signing key, only if s3server asked for it
+  std::string signing_key;
   bool alluserrequest;
 
   bool parse_and_validate();
@@ -59,6 +61,7 @@ class S3AuthResponseSuccess {
   const std::string& get_signature_sha256();
   const std::string& get_request_id();
   const std::string& get_acl();
+  const std::string& get_signing_key();
 
   FRIEND_TEST(S3AuthResponseSuccessTest, ConstructorTest);
   FRIEND_TEST(S3AuthResponseSuccessTest, GetUserName);
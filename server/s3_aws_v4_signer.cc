@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <openssl/crypto.h>
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+#include <strings.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "s3_aws_v4_signer.h"
+#include "s3_log.h"
+
+#define AWS_V4_SHA256_OF_EMPTY \
+  "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"
+
+// Same as Java's String.trim()
+static std::string trim(const std::string& str) {
+  size_t begin = 0;
+  size_t end = str.length();
+  while (begin < end && (unsigned char)str[begin] <= ' ') {
+    ++begin;
+  }
+  while (end > begin && (unsigned char)str[end - 1] <= ' ') {
+    --end;
+  }
+  return str.substr(begin, end - begin);
+}
+
+static std::vector<std::string> split(const std::string& str, char delim) {
+  std::vector<std::string> tokens;
+  size_t begin = 0;
+  size_t pos;
+  while ((pos = str.find(delim, begin)) != std::string::npos) {
+    tokens.push_back(str.substr(begin, pos - begin));
+    begin = pos + 1;
+  }
+  tokens.push_back(str.substr(begin));
+  return tokens;
+}
+
+S3AwsV4Signer::S3AwsV4Signer(const std::string& authorization_header) {
+  is_valid = parse_authorization_header(authorization_header);
+}
+
+// AWS4-HMAC-SHA256 Credential=<access key>/<date>/<region>/<service>/
+// aws4_request, SignedHeaders=<h1;h2>, Signature=<hex>
+bool S3AwsV4Signer::parse_authorization_header(
+    const std::string& header_value) {
+  const std::string algorithm = AWS_V4_ALGORITHM " ";
+  if (header_value.compare(0, algorithm.length(), algorithm) != 0) {
+    return false;
+  }
+  for (const auto& token :
+       split(header_value.substr(algorithm.length()), ',')) {
+    const std::string item = trim(token);
+    const size_t pos = item.find('=');
+    if (pos == std::string::npos) {
+      return false;
+    }
+    const std::string name = item.substr(0, pos);
+    const std::string value = item.substr(pos + 1);
+    if (name == "Credential") {
+      const size_t slash = value.find('/');
+      if (slash == std::string::npos) {
+        return false;
+      }
+      access_key = value.substr(0, slash);
+      credential_scope = value.substr(slash + 1);
+    } else if (name == "SignedHeaders") {
+      signed_headers = value;
+    } else if (name == "Signature") {
+      signature = value;
+    }
+  }
+  const auto scope = split(credential_scope, '/');
+  if (scope.size() != 4 || scope[3] != "aws4_request") {
+    return false;
+  }
+  scope_date = scope[0];
+  region = scope[1];
+  service = scope[2];
+  return !access_key.empty() && !scope_date.empty() && !region.empty() &&
+         !service.empty() && !signed_headers.empty() && !signature.empty();
+}
+
+// Sorted by parameter name, names and values are used as they are.
+std::string S3AwsV4Signer::get_canonical_query(const std::string& query) {
+  if (query.empty()) {
+    return "";
+  }
+  std::map<std::string, std::string> params;
+  for (const auto& token : split(query, '&')) {
+    const auto name_value = split(token, '=');
+    params[name_value[0]] = name_value.size() == 2 ? name_value[1] : "";
+  }
+  std::string canonical_query;
+  for (const auto& param : params) {
+    if (!canonical_query.empty()) {
+      canonical_query += '&';
+    }
+    canonical_query += param.first + "=" + param.second;
+  }
+  return canonical_query;
+}
+
+bool S3AwsV4Signer::create_canonical_request(
+    const std::string& method, const std::string& uri,
+    const std::string& query,
+    const std::map<std::string, std::string>& headers,
+    std::string& canonical_request) const {
+  std::map<std::string, std::string> lower_case_headers;
+  for (const auto& header : headers) {
+    std::string name = header.first;
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    lower_case_headers[name] = header.second;
+  }
+
+  std::string canonical_headers;
+  for (const auto& name : split(signed_headers, ';')) {
+    const auto it = lower_case_headers.find(name);
+    if (it != lower_case_headers.end()) {
+      canonical_headers += name + ":" + trim(it->second) + "\n";
+    } else if (name == "connection") {
+      canonical_headers += "connection:Keep-Alive\n";
+    } else {
+      s3_log(S3_LOG_DEBUG, "", "Signed header %s is missing\n", name.c_str());
+      return false;
+    }
+  }
+
+  std::string hashed_payload = AWS_V4_SHA256_OF_EMPTY;
+  const auto it = lower_case_headers.find("x-amz-content-sha256");
+  if (it != lower_case_headers.end()) {
+    hashed_payload = it->second;
+  }
+
+  canonical_request = method + "\n" + uri + "\n" + get_canonical_query(query) +
+                      "\n" + canonical_headers + "\n" + signed_headers + "\n" +
+                      hashed_payload;
+  return true;
+}
+
+std::string S3AwsV4Signer::create_string_to_sign(
+    const std::string& amz_date, const std::string& canonical_request) const {
+  return AWS_V4_ALGORITHM "\n" + amz_date + "\n" + credential_scope + "\n" +
+         sha256_hex(canonical_request);
+}
+
+std::string S3AwsV4Signer::calculate_signature(
+    const std::string& signing_key, const std::string& method,
+    const std::string& uri, const std::string& query,
+    const std::map<std::string, std::string>& headers) const {
+  std::string canonical_request;
+  if (!is_valid || !create_canonical_request(method, uri, query, headers,
+                                             canonical_request)) {
+    return "";
+  }
+  std::string amz_date;
+  for (const auto& header : headers) {
+    if (!strcasecmp(header.first.c_str(), "x-amz-date")) {
+      amz_date = header.second;
+      break;
+    }
+  }
+  const std::string string_to_sign =
+      create_string_to_sign(amz_date, canonical_request);
+  return to_hex(hmac_sha256(signing_key, string_to_sign));
+}
+
+std::string S3AwsV4Signer::calculate_chunk_signature(
+    const std::string& signing_key, const std::string& amz_date,
+    const std::string& previous_signature,
+    const std::string& chunk_sha256) const {
+  if (!is_valid) {
+    return "";
+  }
+  const std::string string_to_sign =
+      AWS_V4_CHUNK_ALGORITHM "\n" + amz_date + "\n" + credential_scope + "\n" +
+      previous_signature + "\n" AWS_V4_SHA256_OF_EMPTY "\n" + chunk_sha256;
+  return to_hex(hmac_sha256(signing_key, string_to_sign));
+}
+
+std::string S3AwsV4Signer::derive_signing_key(const std::string& secret_key,
+                                              const std::string& date,
+                                              const std::string& region,
+                                              const std::string& service) {
+  const std::string date_key = hmac_sha256("AWS4" + secret_key, date);
+  const std::string region_key = hmac_sha256(date_key, region);
+  const std::string service_key = hmac_sha256(region_key, service);
+  return hmac_sha256(service_key, "aws4_request");
+}
+
+std::string S3AwsV4Signer::hmac_sha256(const std::string& key,
+                                       const std::string& data) {
+  unsigned char digest[SHA256_DIGEST_LENGTH];
+  unsigned int digest_len = sizeof(digest);
+  HMAC(EVP_sha256(), key.data(), (int)key.length(),
+       (const unsigned char*)data.data(), data.length(), digest, &digest_len);
+  return std::string((const char*)digest, digest_len);
+}
+
+std::string S3AwsV4Signer::sha256_hex(const std::string& data) {
+  unsigned char digest[SHA256_DIGEST_LENGTH];
+  SHA256((const unsigned char*)data.data(), data.length(), digest);
+  return to_hex(std::string((const char*)digest, sizeof(digest)));
+}
+
+std::string S3AwsV4Signer::to_hex(const std::string& data) {
+  static const char digits[] = "0123456789abcdef";
+  std::string hex;
+  hex.reserve(data.length() * 2);
+  for (unsigned char c : data) {
+    hex += digits[c >> 4];
+    hex += digits[c & 0xf];
+  }
+  return hex;
+}
+
+bool S3AwsV4Signer::from_hex(const std::string& hex, std::string& data) {
+  if (hex.length() % 2) {
+    return false;
+  }
+  data.clear();
+  data.reserve(hex.length() / 2);
+  for (size_t i = 0; i < hex.length(); i += 2) {
+    int value = 0;
+    for (size_t j = i; j < i + 2; ++j) {
+      const char c = hex[j];
+      value <<= 4;
+      if (c >= '0' && c <= '9') {
+        value |= c - '0';
+      } else if (c >= 'a' && c <= 'f') {
+        value |= c - 'a' + 10;
+      } else if (c >= 'A' && c <= 'F') {
+        value |= c - 'A' + 10;
+      } else {
+        return false;
+      }
+    }
+    data += (char)value;
+  }
+  return true;
+}
+
+bool S3AwsV4Signer::signatures_match(const std::string& signature,
+                                     const std::string& expected) {
+  // Length of a signature is no secret.
+  return signature.length() == expected.length() &&
+         CRYPTO_memcmp(signature.data(), expected.data(),
+                       expected.length()) == 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_AWS_V4_SIGNER_H__
+#define __S3_SERVER_S3_AWS_V4_SIGNER_H__
+
+#include <map>
+#include <string>
+
+#include <gtest/gtest_prod.h>
+
+#define AWS_V4_ALGORITHM "AWS4-HMAC-SHA256"
+#define AWS_V4_CHUNK_ALGORITHM "AWS4-HMAC-SHA256-PAYLOAD"
+
+// Recomputes AWS signature V4 of a request the same way the Auth server does
+// (see AWSV4Sign.java), given the signing key of the request's credential
+// scope. Headers, uri and query are expected in the form S3AuthClient sends
+// them to the Auth server.
+class S3AwsV4Signer {
+  bool is_valid;
+
+  std::string access_key;
+  // date/region/service/aws4_request
+  std::string credential_scope;
+  std::string scope_date;
+  std::string region;
+  std::string service;
+  std::string signed_headers;
+  std::string signature;
+
+  bool parse_authorization_header(const std::string& header_value);
+
+ public:
+  // Parses value of the "Authorization" header
+  explicit S3AwsV4Signer(const std::string& authorization_header);
+
+  bool is_ok() const { return is_valid; }
+
+  const std::string& get_access_key() const { return access_key; }
+  const std::string& get_credential_scope() const { return credential_scope; }
+  const std::string& get_scope_date() const { return scope_date; }
+  const std::string& get_signature() const { return signature; }
+
+  // Canonical request of a request, or of the seed request of an aws-chunked
+  // upload. Returns false if one of the signed headers is missing.
+  bool create_canonical_request(
+      const std::string& method, const std::string& uri,
+      const std::string& query,
+      const std::map<std::string, std::string>& headers,
+      std::string& canonical_request) const;
+
+  std::string create_string_to_sign(const std::string& amz_date,
+                                    const std::string& canonical_request) const;
+
+  // Lower case hex signature of the request described by the arguments,
+  // empty if it cannot be computed.
+  std::string calculate_signature(
+      const std::string& signing_key, const std::string& method,
+      const std::string& uri, const std::string& query,
+      const std::map<std::string, std::string>& headers) const;
+
+  // Signature of a chunk of an aws-chunked upload, chained to the signature
+  // of the previous chunk (the seed signature for the first one).
+  std::string calculate_chunk_signature(const std::string& signing_key,
+                                        const std::string& amz_date,
+                                        const std::string& previous_signature,
+                                        const std::string& chunk_sha256) const;
+
+  // 'query' is already URI encoded, only needs sorting.
+  static std::string get_canonical_query(const std::string& query);
+
+  static std::string derive_signing_key(const std::string& secret_key,
+                                        const std::string& date,
+                                        const std::string& region,
+                                        const std::string& service);
+  static std::string hmac_sha256(const std::string& key,
+                                 const std::string& data);
+  static std::string sha256_hex(const std::string& data);
+  static std::string to_hex(const std::string& data);
+  // Returns false if 'hex' is not a valid hex string.
+  static bool from_hex(const std::string& hex, std::string& data);
+  // Compares signatures in time that does not depend on their content.
+  static bool signatures_match(const std::string& signature,
+                               const std::string& expected);
+
+  FRIEND_TEST(S3AwsV4SignerTest, ParsesAuthorizationHeader);
+};
+
+#endif
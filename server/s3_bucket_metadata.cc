@@ -25,6 +25,7 @@
 #include "s3_datetime.h"
 #include "s3_factory.h"
 #include "s3_iem.h"
+#include "s3_metadata_codec.h"
 #include "s3_uri_to_motr_oid.h"
 #include "s3_common_utilities.h"
 #include "s3_m0_uint128_helper.h"
@@ -291,6 +292,9 @@ std::string S3BucketMetadata::to_json() {
 
 int S3BucketMetadata::from_json(std::string content) {
   s3_log(S3_LOG_DEBUG, request_id, "Called\n");
+  if (s3_is_binary_metadata(content)) {
+    return from_binary(content);
+  }
   Json::Value newroot;
   Json::Reader reader;
   bool parsingSuccessful = reader.parse(content.c_str(), newroot);
@@ -336,6 +340,101 @@ int S3BucketMetadata::from_json(std::string content) {
   return 0;
 }
 
+std::string S3BucketMetadata::to_binary() {
+  s3_log(S3_LOG_DEBUG, request_id, "Called\n");
+  std::string record;
+  S3MetadataEncoder encoder(record, S3MetadataRecord::bucket);
+  encoder.add_string(S3MetadataField::bucket_name, bucket_name);
+  encoder.add_map(S3MetadataField::system_defined, system_defined_attribute);
+  if (!user_defined_attribute.empty()) {
+    encoder.add_map(S3MetadataField::user_defined, user_defined_attribute);
+  }
+  encoder.add_base64(
+      S3MetadataField::acl, S3MetadataField::acl_as_stored,
+      encoded_acl == "" ? request->get_default_acl() : encoded_acl);
+  encoder.add_bytes(S3MetadataField::policy, bucket_policy);
+  if (!bucket_tags.empty()) {
+    encoder.add_map(S3MetadataField::user_defined_tags, bucket_tags);
+  }
+  encoder.add_string(S3MetadataField::object_list_index_oid,
+                     S3M0Uint128Helper::to_string(object_list_index_oid));
+  encoder.add_string(S3MetadataField::multipart_index_oid,
+                     S3M0Uint128Helper::to_string(multipart_index_oid));
+  encoder.add_string(
+      S3MetadataField::objects_version_list_index_oid,
+      S3M0Uint128Helper::to_string(objects_version_list_index_oid));
+
+  S3DateTime current_time;
+  current_time.init_current_time();
+  encoder.add_string(S3MetadataField::create_timestamp,
+                     current_time.get_isoformat_string());
+  return record;
+}
+
+int S3BucketMetadata::from_binary(const std::string& content) {
+  S3MetadataDecoder decoder(content);
+  S3MetadataField field;
+  std::string oid_str;
+
+  while (decoder.next_field(field)) {
+    switch (field) {
+      case S3MetadataField::bucket_name:
+        decoder.read_string(bucket_name);
+        break;
+      case S3MetadataField::system_defined:
+        decoder.read_map(system_defined_attribute);
+        break;
+      case S3MetadataField::user_defined:
+        decoder.read_map(user_defined_attribute);
+        break;
+      case S3MetadataField::acl:
+        decoder.read_base64(encoded_acl);
+        break;
+      case S3MetadataField::acl_as_stored:
+        decoder.read_string(encoded_acl);
+        break;
+      case S3MetadataField::policy:
+        decoder.read_string(bucket_policy);
+        break;
+      case S3MetadataField::user_defined_tags:
+        decoder.read_map(bucket_tags);
+        break;
+      case S3MetadataField::object_list_index_oid:
+        if (decoder.read_string(oid_str)) {
+          object_list_index_oid = S3M0Uint128Helper::to_m0_uint128(oid_str);
+        }
+        break;
+      case S3MetadataField::multipart_index_oid:
+        if (decoder.read_string(oid_str)) {
+          multipart_index_oid = S3M0Uint128Helper::to_m0_uint128(oid_str);
+        }
+        break;
+      case S3MetadataField::objects_version_list_index_oid:
+        if (decoder.read_string(oid_str)) {
+          objects_version_list_index_oid =
+              S3M0Uint128Helper::to_m0_uint128(oid_str);
+        }
+        break;
+      default:
+        decoder.skip_field();
+        break;
+    }
+  }
+  if (decoder.failed() ||
+      decoder.record_type() != S3MetadataRecord::bucket ||
+      s3_fi_is_enabled("bucket_metadata_corrupted")) {
+    s3_log(S3_LOG_ERROR, request_id, "Binary metadata parsing failed.\n");
+    return -1;
+  }
+
+  user_name = system_defined_attribute["Owner-User"];
+  user_id = system_defined_attribute["Owner-User-id"];
+  account_name = system_defined_attribute["Owner-Account"];
+  account_id = system_defined_attribute["Owner-Account-id"];
+  owner_canonical_id = system_defined_attribute["Owner-Canonical-id"];
+  return 0;
+}
+
 void S3BucketMetadata::acl_from_json(std::string acl_json_str) {
   s3_log(S3_LOG_DEBUG, "", "Called\n");
   encoded_acl = acl_json_str;
@@ -197,9 +197,13 @@ class S3BucketMetadata {
 
   // Streaming to json
   virtual std::string to_json();
+  // Compact form of to_json(), see s3_metadata_codec.h
+  virtual std::string to_binary();
 
+  // Reads both json and binary records.
   // returns 0 on success, -1 on parsing error
   virtual int from_json(std::string content);
+  int from_binary(const std::string& content);
 
   // Google tests
   FRIEND_TEST(S3BucketMetadataTest, ConstructorTest);
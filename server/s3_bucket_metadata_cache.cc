@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include "s3_bucket_metadata_cache.h"
+#include "s3_log.h"
+#include "s3_option.h"
+
+S3BucketMetadataCache* S3BucketMetadataCache::instance = NULL;
+
+S3BucketMetadataCache::S3BucketMetadataCache(size_t max_entries,
+                                             unsigned int ttl_millisec)
+    : entries(max_entries, ttl_millisec), generation(0) {}
+
+S3BucketMetadataCache* S3BucketMetadataCache::get_instance() {
+  if (!instance) {
+    S3Option* option_instance = S3Option::get_instance();
+    instance = new S3BucketMetadataCache(
+        option_instance->get_bucket_metadata_cache_max_entries(),
+        option_instance->get_bucket_metadata_cache_ttl_millisec());
+  }
+  return instance;
+}
+
+void S3BucketMetadataCache::destroy_instance() {
+  if (instance) {
+    delete instance;
+    instance = NULL;
+  }
+}
+
+std::shared_ptr<const S3BucketMetadataRecord> S3BucketMetadataCache::get(
+    const std::string& bucket_name) {
+  std::lock_guard<std::mutex> guard(cache_lock);
+  return entries.get(bucket_name);
+}
+
+uint64_t S3BucketMetadataCache::get_generation() {
+  std::lock_guard<std::mutex> guard(cache_lock);
+  return generation;
+}
+
+void S3BucketMetadataCache::put(
+    const std::string& bucket_name,
+    std::shared_ptr<const S3BucketMetadataRecord> record,
+    uint64_t generation) {
+  if (!is_enabled()) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(cache_lock);
+  if (generation != this->generation) {
+    s3_log(S3_LOG_DEBUG, "",
+           "Bucket metadata of %s changed while loading, not cached\n",
+           bucket_name.c_str());
+    return;
+  }
+  entries.put(bucket_name, std::move(record));
+}
+
+void S3BucketMetadataCache::invalidate(const std::string& bucket_name) {
+  std::lock_guard<std::mutex> guard(cache_lock);
+  ++generation;
+  entries.erase(bucket_name);
+}
+
+size_t S3BucketMetadataCache::size() {
+  std::lock_guard<std::mutex> guard(cache_lock);
+  return entries.size();
+}
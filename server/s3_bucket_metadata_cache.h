@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_BUCKET_METADATA_CACHE_H__
+#define __S3_SERVER_S3_BUCKET_METADATA_CACHE_H__
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <gtest/gtest_prod.h>
+
+#include "motr_helpers.h"
+#include "s3_lru_cache.h"
+
+// Bucket metadata as read from the global bucket list index and the bucket
+// metadata list index, i.e. everything S3BucketMetadataV1::load() fills in.
+struct S3BucketMetadataRecord {
+  std::string bucket_owner_account_id;
+  std::string bucket_name;
+  std::string account_name;
+  std::string account_id;
+  std::string user_name;
+  std::string user_id;
+  std::string owner_canonical_id;
+  std::string encoded_acl;
+  std::string bucket_policy;
+  std::map<std::string, std::string> bucket_tags;
+  std::map<std::string, std::string> system_defined_attribute;
+  std::map<std::string, std::string> user_defined_attribute;
+  struct m0_uint128 object_list_index_oid;
+  struct m0_uint128 multipart_index_oid;
+  struct m0_uint128 objects_version_list_index_oid;
+};
+
+// LRU cache of loaded bucket metadata, shared by all requests.
+// Bucket names are global, so entries are keyed by bucket name; the record
+// carries the owner account. Changes made by this instance invalidate the
+// entry, changes made by other instances are picked up after the TTL.
+class S3BucketMetadataCache {
+  std::mutex cache_lock;
+  S3LruCache<S3BucketMetadataRecord> entries;
+  // Bumped by every invalidation, see put().
+  uint64_t generation;
+
+  static S3BucketMetadataCache* instance;
+
+ public:
+  S3BucketMetadataCache(size_t max_entries, unsigned int ttl_millisec);
+
+  static S3BucketMetadataCache* get_instance();
+  static void destroy_instance();
+
+  bool is_enabled() const { return entries.is_enabled(); }
+
+  // Returns nullptr when the bucket is not cached or its entry expired.
+  std::shared_ptr<const S3BucketMetadataRecord> get(
+      const std::string& bucket_name);
+
+  // Take this before reading the metadata store and pass it to put().
+  uint64_t get_generation();
+
+  // The record is dropped if anything was invalidated since 'generation'
+  // was taken, as it may have been read before that change.
+  void put(const std::string& bucket_name,
+           std::shared_ptr<const S3BucketMetadataRecord> record,
+           uint64_t generation);
+
+  void invalidate(const std::string& bucket_name);
+
+  size_t size();
+
+  FRIEND_TEST(S3BucketMetadataV1Test, LoadFromCache);
+  FRIEND_TEST(S3BucketMetadataV1Test, UpdateInvalidatesCache);
+};
+
+#endif
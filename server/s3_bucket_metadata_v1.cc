@@ -22,9 +22,11 @@
 #include <json/json.h>
 #include <string>
 #include "base64.h"
+#include "s3_bucket_metadata_cache.h"
 #include "s3_datetime.h"
 #include "s3_factory.h"
 #include "s3_iem.h"
+#include "s3_option.h"
 #include "s3_uri_to_motr_oid.h"
 #include "s3_common_utilities.h"
 #include "s3_stats.h"
@@ -54,6 +56,7 @@ S3BucketMetadataV1::S3BucketMetadataV1(
   salted_object_list_index_name = get_object_list_index_name();
 
   should_cleanup_global_idx = false;
+  cache_generation = 0;
 }
 
 S3BucketMetadataV1::S3BucketMetadataV1(
@@ -81,6 +84,7 @@ S3BucketMetadataV1::S3BucketMetadataV1(
   salted_object_list_index_name = get_object_list_index_name();
 
   should_cleanup_global_idx = false;
+  cache_generation = 0;
 }
 
 struct m0_uint128 S3BucketMetadataV1::get_bucket_metadata_list_index_oid() {
@@ -96,6 +100,64 @@ void S3BucketMetadataV1::set_state(S3BucketMetadataState state) {
   this->state = state;
 }
 
+// Cached metadata may be stale once a change to the bucket is started, and a
+// load racing with the change may re-cache the old value before it completes,
+// so drop the entry both before and after the change.
+void S3BucketMetadataV1::set_handlers_invalidating_cache(
+    std::function<void(void)> on_success, std::function<void(void)> on_failed) {
+  S3BucketMetadataCache::get_instance()->invalidate(bucket_name);
+
+  const std::string bucket = bucket_name;
+  this->handler_on_success = [bucket, on_success]() {
+    S3BucketMetadataCache::get_instance()->invalidate(bucket);
+    on_success();
+  };
+  this->handler_on_failed = [bucket, on_failed]() {
+    S3BucketMetadataCache::get_instance()->invalidate(bucket);
+    on_failed();
+  };
+}
+
+std::shared_ptr<const S3BucketMetadataRecord>
+S3BucketMetadataV1::to_cache_record() {
+  auto record = std::make_shared<S3BucketMetadataRecord>();
+  record->bucket_owner_account_id = bucket_owner_account_id;
+  record->bucket_name = bucket_name;
+  record->account_name = account_name;
+  record->account_id = account_id;
+  record->user_name = user_name;
+  record->user_id = user_id;
+  record->owner_canonical_id = owner_canonical_id;
+  record->encoded_acl = encoded_acl;
+  record->bucket_policy = bucket_policy;
+  record->bucket_tags = bucket_tags;
+  record->system_defined_attribute = system_defined_attribute;
+  record->user_defined_attribute = user_defined_attribute;
+  record->object_list_index_oid = object_list_index_oid;
+  record->multipart_index_oid = multipart_index_oid;
+  record->objects_version_list_index_oid = objects_version_list_index_oid;
+  return record;
+}
+
+void S3BucketMetadataV1::from_cache_record(
+    const S3BucketMetadataRecord& record) {
+  bucket_owner_account_id = record.bucket_owner_account_id;
+  bucket_name = record.bucket_name;
+  account_name = record.account_name;
+  account_id = record.account_id;
+  user_name = record.user_name;
+  user_id = record.user_id;
+  owner_canonical_id = record.owner_canonical_id;
+  encoded_acl = record.encoded_acl;
+  bucket_policy = record.bucket_policy;
+  bucket_tags = record.bucket_tags;
+  system_defined_attribute = record.system_defined_attribute;
+  user_defined_attribute = record.user_defined_attribute;
+  object_list_index_oid = record.object_list_index_oid;
+  multipart_index_oid = record.multipart_index_oid;
+  objects_version_list_index_oid = record.objects_version_list_index_oid;
+}
+
 // Load {B1, A1} in global_bucket_list_index_oid, followed by {A1/B1, md} in
 // bucket_metadata_list_index_oid
 void S3BucketMetadataV1::load(std::function<void(void)> on_success,
@@ -106,6 +168,22 @@ void S3BucketMetadataV1::load(std::function<void(void)> on_success,
   this->handler_on_success = on_success;
   this->handler_on_failed = on_failed;
 
+  S3BucketMetadataCache* cache = S3BucketMetadataCache::get_instance();
+  if (cache->is_enabled()) {
+    auto record = cache->get(bucket_name);
+    if (record) {
+      s3_log(S3_LOG_DEBUG, request_id,
+             "Bucket metadata of %s found in cache\n", bucket_name.c_str());
+      s3_stats_inc("bucket_metadata_cache_hit_count");
+      from_cache_record(*record);
+      state = S3BucketMetadataState::present;
+      this->handler_on_success();
+      s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+      return;
+    }
+    s3_stats_inc("bucket_metadata_cache_miss_count");
+    cache_generation = cache->get_generation();
+  }
   fetch_global_bucket_account_id_info();
 
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
@@ -196,6 +274,10 @@ void S3BucketMetadataV1::load_bucket_info_successful() {
     LOG_PERF("load_bucket_info_ms", request_id.c_str(), mss);
     s3_stats_timing("load_bucket_info", mss);
 
+    S3BucketMetadataCache* cache = S3BucketMetadataCache::get_instance();
+    if (cache->is_enabled()) {
+      cache->put(bucket_name, to_cache_record(), cache_generation);
+    }
     state = S3BucketMetadataState::present;
     this->handler_on_success();
   }
@@ -231,8 +313,8 @@ void S3BucketMetadataV1::save(std::function<void(void)> on_success,
 
   assert(state == S3BucketMetadataState::missing);
 
-  this->handler_on_success = on_success;
-  this->handler_on_failed = on_failed;
+  set_handlers_invalidating_cache(std::move(on_success),
+                                  std::move(on_failed));
 
   global_bucket_index_metadata.reset();
   save_global_bucket_account_id_info();
@@ -246,8 +328,8 @@ void S3BucketMetadataV1::update(std::function<void(void)> on_success,
 
   assert(state == S3BucketMetadataState::present);
 
-  this->handler_on_success = on_success;
-  this->handler_on_failed = on_failed;
+  set_handlers_invalidating_cache(std::move(on_success),
+                                  std::move(on_failed));
 
   save_bucket_info(false);
 
@@ -452,7 +534,9 @@ void S3BucketMetadataV1::save_bucket_info(bool clean_glob_on_err) {
   should_cleanup_global_idx = clean_glob_on_err;
   motr_kv_writer->put_keyval(
       bucket_metadata_list_index_oid, get_bucket_metadata_index_key_name(),
-      this->to_json(),
+      S3Option::get_instance()->is_s3server_metadata_binary_encoding_enabled()
+          ? this->to_binary()
+          : this->to_json(),
       std::bind(&S3BucketMetadataV1::save_bucket_info_successful, this),
       std::bind(&S3BucketMetadataV1::save_bucket_info_failed, this));
 
@@ -489,8 +573,8 @@ void S3BucketMetadataV1::remove(std::function<void(void)> on_success,
                                 std::function<void(void)> on_failed) {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
 
-  this->handler_on_success = on_success;
-  this->handler_on_failed = on_failed;
+  set_handlers_invalidating_cache(std::move(on_success),
+                                  std::move(on_failed));
 
   assert(state == S3BucketMetadataState::present);
   remove_bucket_info();
@@ -541,6 +625,12 @@ void S3BucketMetadataV1::remove_bucket_info_failed() {
 
 void S3BucketMetadataV1::remove_global_bucket_account_id_info() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  // Not loaded when the bucket metadata came from the cache
+  if (!global_bucket_index_metadata) {
+    global_bucket_index_metadata =
+        global_bucket_index_metadata_factory
+            ->create_s3_global_bucket_index_metadata(request, bucket_name);
+  }
   global_bucket_index_metadata->remove(
       std::bind(
           &S3BucketMetadataV1::remove_global_bucket_account_id_info_successful,
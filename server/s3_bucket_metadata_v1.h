@@ -30,6 +30,7 @@
 #include <string>
 #include "s3_global_bucket_index_metadata.h"
 #include "s3_bucket_metadata.h"
+#include "s3_bucket_metadata_cache.h"
 #include "s3_log.h"
 #include "s3_timer.h"
 
@@ -49,7 +50,15 @@ class S3BucketMetadataV1 : public S3BucketMetadata {
 
   S3Timer s3_timer;
 
+  // Cache generation taken when loading started, see S3BucketMetadataCache
+  uint64_t cache_generation;
+
  private:
+  void set_handlers_invalidating_cache(std::function<void(void)> on_success,
+                                       std::function<void(void)> on_failed);
+  std::shared_ptr<const S3BucketMetadataRecord> to_cache_record();
+  void from_cache_record(const S3BucketMetadataRecord& record);
+
   void fetch_global_bucket_account_id_info();
   void fetch_global_bucket_account_id_info_success();
   void fetch_global_bucket_account_id_info_failed();
@@ -181,6 +190,8 @@ class S3BucketMetadataV1 : public S3BucketMetadata {
   FRIEND_TEST(S3BucketMetadataV1Test,
               FetchBucketListIndexOIDFailedIndexFailedStateIsFetching);
   FRIEND_TEST(S3BucketMetadataV1Test, FetchBucketListIndexOIDFailedIndexFailed);
+  FRIEND_TEST(S3BucketMetadataV1Test, LoadFromCache);
+  FRIEND_TEST(S3BucketMetadataV1Test, UpdateInvalidatesCache);
   FRIEND_TEST(S3BucketMetadataV1Test, LoadBucketInfo);
   FRIEND_TEST(S3BucketMetadataV1Test, SetBucketPolicy);
   FRIEND_TEST(S3BucketMetadataV1Test, SetAcl);
@@ -230,6 +241,7 @@ class S3BucketMetadataV1 : public S3BucketMetadata {
   FRIEND_TEST(S3BucketMetadataV1Test, RemoveBucketInfoFailedToLaunch);
   FRIEND_TEST(S3BucketMetadataV1Test, ToJson);
   FRIEND_TEST(S3BucketMetadataV1Test, FromJson);
+  FRIEND_TEST(S3BucketMetadataV1Test, ToBinaryFromBinary);
   FRIEND_TEST(S3BucketMetadataV1Test, GetEncodedBucketAcl);
   FRIEND_TEST(S3BucketMetadataV1Test, CreateMultipartListIndexCollisionCount0);
   FRIEND_TEST(S3BucketMetadataV1Test, CreateObjectListIndexCollisionCount0);
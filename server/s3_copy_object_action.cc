@@ -20,6 +20,7 @@
 
 #include <cassert>
 #include <algorithm>
+#include <map>
 #include <utility>
 #include <evhttp.h>
 
@@ -30,9 +31,14 @@
 #include "s3_log.h"
 #include "s3_motr_layout.h"
 #include "s3_m0_uint128_helper.h"
+#include "s3_motr_kvs_writer.h"
+#include "s3_object_data_ref_record.h"
+#include "s3_option.h"
 #include "s3_probable_delete_record.h"
 #include "s3_uri_to_motr_oid.h"
 
+extern struct m0_uint128 global_object_data_refs_index_oid;
+
 S3CopyObjectAction::S3CopyObjectAction(
     std::shared_ptr<S3RequestObject> req, std::shared_ptr<MotrAPI> motr_api,
     std::shared_ptr<S3BucketMetadataFactory> bucket_meta_factory,
@@ -68,7 +74,7 @@ void S3CopyObjectAction::setup_steps() {
   ACTION_TASK_ADD(S3CopyObjectAction::set_source_bucket_authorization_metadata,
                   this);
   ACTION_TASK_ADD(S3CopyObjectAction::check_source_bucket_authorization, this);
-  ACTION_TASK_ADD(S3CopyObjectAction::create_object, this);
+  ACTION_TASK_ADD(S3CopyObjectAction::create_destination_object, this);
   ACTION_TASK_ADD(S3CopyObjectAction::copy_object, this);
   ACTION_TASK_ADD(S3CopyObjectAction::save_metadata, this);
   ACTION_TASK_ADD(S3CopyObjectAction::send_response_to_s3_client, this);
@@ -76,26 +82,32 @@ void S3CopyObjectAction::setup_steps() {
 
 void S3CopyObjectAction::get_source_bucket_and_object() {
   s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
-  std::string source = request->get_headers_copysource();
+  parse_copy_source(request->get_headers_copysource(), source_bucket_name,
+                    source_object_name);
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3CopyObjectAction::parse_copy_source(const std::string& source,
+                                           std::string& bucket_name,
+                                           std::string& object_name) {
   size_t separator_pos;
   if (source[0] != '/') {
     separator_pos = source.find("/");
     if (separator_pos != std::string::npos) {
-      source_bucket_name = source.substr(0, separator_pos);
-      source_object_name = source.substr(separator_pos + 1);
+      bucket_name = source.substr(0, separator_pos);
+      object_name = source.substr(separator_pos + 1);
     }
   } else {
     separator_pos = source.find("/", 1);
     if (separator_pos != std::string::npos) {
-      source_bucket_name = source.substr(1, separator_pos - 1);
-      source_object_name = source.substr(separator_pos + 1);
+      bucket_name = source.substr(1, separator_pos - 1);
+      object_name = source.substr(separator_pos + 1);
     }
   }
-  char* decode_uri = evhttp_uridecode(source_object_name.c_str(), 0, NULL);
-  source_object_name = decode_uri;
+  char* decode_uri = evhttp_uridecode(object_name.c_str(), 0, NULL);
+  object_name = decode_uri;
   free(decode_uri);
   decode_uri = NULL;
-  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
 void S3CopyObjectAction::fetch_source_bucket_info() {
@@ -277,6 +289,166 @@ void S3CopyObjectAction::validate_copyobject_request() {
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
+// Destination may refer data of source only when deletion of data is left to
+// background delete, as only BD checks that data is not referred any more.
+bool S3CopyObjectAction::can_share_source_data() {
+  auto option_instance = S3Option::get_instance();
+  return total_data_to_stream &&
+         option_instance->is_s3server_obj_delayed_del_enabled() &&
+         option_instance->is_s3server_copy_object_share_data_enabled();
+}
+
+void S3CopyObjectAction::create_destination_object() {
+  if (source_object_metadata->is_inline()) {
+    copy_inline_source();
+  } else if (can_share_source_data()) {
+    share_source_data();
+  } else {
+    create_object();
+  }
+}
+
+// Destination gets metadata referring motr object of source, no new motr
+// object is created and no data is copied.
+void S3CopyObjectAction::share_source_data() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+
+  object_data_shared = true;
+  new_object_oid = source_object_metadata->get_oid();
+  _set_layout_id(source_object_metadata->get_layout_id());
+
+  create_new_object_metadata();
+  new_object_metadata->set_oid(new_object_oid);
+  // Source and every other copy have probable delete records of the same
+  // oid, key of the record of this copy is oid + "-" + its version key.
+  new_oid_str += '-' + new_object_metadata->get_version_key_in_index();
+
+  // Probable delete record is added once data is referred, else BD could
+  // delete data of source in the meantime.
+  add_object_data_refs();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+// Source keeps its data in metadata, so does destination. Data is copied
+// along with the metadata, no motr object is created.
+void S3CopyObjectAction::copy_inline_source() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+
+  new_object_inline = true;
+  _set_layout_id(source_object_metadata->get_layout_id());
+
+  create_new_object_metadata();
+  new_object_metadata->set_inline_data(
+      source_object_metadata->get_inline_data());
+  // Data is same, so is its md5.
+  content_md5 = source_object_metadata->get_md5();
+  s3_put_action_state = S3PutObjectActionState::writeComplete;
+
+  if (old_object_oid.u_hi || old_object_oid.u_lo) {
+    // Old motr object is still to be deleted once metadata is replaced.
+    add_object_oid_to_probable_dead_oid_list();
+  } else {
+    next();
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+// Both source and destination refer the data from now on.
+void S3CopyObjectAction::add_object_data_refs() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  std::map<std::string, std::string> data_refs;
+
+  S3ObjectDataRefRecord source_ref(
+      new_object_oid, layout_id, source_object_metadata->get_object_name(),
+      source_bucket_metadata->get_object_list_index_oid());
+  data_refs[source_ref.get_key()] = source_ref.to_json();
+
+  S3ObjectDataRefRecord destination_ref(
+      new_object_oid, layout_id, new_object_metadata->get_object_name(),
+      bucket_metadata->get_object_list_index_oid());
+  data_refs[destination_ref.get_key()] = destination_ref.to_json();
+
+  if (!motr_kv_writer) {
+    motr_kv_writer =
+        mote_kv_writer_factory->create_motr_kvs_writer(request, s3_motr_api);
+  }
+  motr_kv_writer->put_keyval(
+      global_object_data_refs_index_oid, data_refs,
+      std::bind(&S3CopyObjectAction::check_source_object_data, this),
+      std::bind(&S3CopyObjectAction::add_object_data_refs_failed, this));
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+// Nothing is to be undone when data could not be shared, BD drops reference
+// of destination as destination does not refer the data.
+void S3CopyObjectAction::add_object_data_refs_failed() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+
+  s3_put_action_state = S3PutObjectActionState::newObjOidCreationFailed;
+  if (motr_kv_writer->get_state() == S3MotrKVSWriterOpState::failed_to_launch) {
+    set_s3_error("ServiceUnavailable");
+  } else {
+    set_s3_error("InternalError");
+  }
+  send_response_to_s3_client();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+// Source could be deleted or overwritten before reference of the source was
+// added, then BD may not keep the data. Reload to be sure source still refers
+// the data.
+void S3CopyObjectAction::check_source_object_data() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+
+  source_object_metadata = object_metadata_factory->create_object_metadata_obj(
+      request, source_bucket_name, source_object_name,
+      source_bucket_metadata->get_object_list_index_oid());
+  source_object_metadata->set_objects_version_list_index_oid(
+      source_bucket_metadata->get_objects_version_list_index_oid());
+
+  source_object_metadata->load(
+      std::bind(&S3CopyObjectAction::check_source_object_data_success, this),
+      std::bind(&S3CopyObjectAction::check_source_object_data_failed, this));
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3CopyObjectAction::check_source_object_data_success() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  const struct m0_uint128 source_oid = source_object_metadata->get_oid();
+
+  if (source_oid.u_hi == new_object_oid.u_hi &&
+      source_oid.u_lo == new_object_oid.u_lo) {
+    s3_put_action_state = S3PutObjectActionState::newObjOidCreated;
+    // Data is same, so is its md5.
+    content_md5 = source_object_metadata->get_md5();
+    add_object_oid_to_probable_dead_oid_list();
+  } else {
+    s3_log(S3_LOG_WARN, request_id,
+           "Source object was overwritten during copy\n");
+    s3_put_action_state = S3PutObjectActionState::newObjOidCreationFailed;
+    set_s3_error("InternalError");
+    send_response_to_s3_client();
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3CopyObjectAction::check_source_object_data_failed() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+
+  s3_put_action_state = S3PutObjectActionState::newObjOidCreationFailed;
+  if (source_object_metadata->get_state() == S3ObjectMetadataState::missing) {
+    s3_log(S3_LOG_WARN, request_id, "Source object was deleted during copy\n");
+    set_s3_error("NoSuchKey");
+  } else if (source_object_metadata->get_state() ==
+             S3ObjectMetadataState::failed_to_launch) {
+    set_s3_error("ServiceUnavailable");
+  } else {
+    set_s3_error("InternalError");
+  }
+  send_response_to_s3_client();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
 const char xml_spaces[] = "        ";
 // Shall be 8 bytes (size of cipher block)
 
@@ -294,19 +466,28 @@ bool S3CopyObjectAction::copy_object_cb() {
 void S3CopyObjectAction::copy_object() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
 
-  if (!total_data_to_stream) {
-    s3_log(S3_LOG_DEBUG, stripped_request_id, "Source object is empty");
+  if (!total_data_to_stream || new_object_inline) {
+    s3_log(S3_LOG_DEBUG, stripped_request_id,
+           "Source object is empty or its data is already copied");
+    next();
+    return;
+  }
+  if (object_data_shared) {
+    // Data is referred by destination already.
+    s3_put_action_state = S3PutObjectActionState::writeComplete;
     next();
     return;
   }
   bool f_success = false;
   try {
-    object_data_copier.reset(new S3ObjectDataCopier(
-        request, motr_writer, motr_reader_factory, s3_motr_api));
+    object_data_copier.reset(
+        new S3ObjectDataCopier(request, motr_writer, motr_writer_factory,
+                               motr_reader_factory, s3_motr_api));
 
     object_data_copier->copy(
         source_object_metadata->get_oid(), total_data_to_stream,
         source_object_metadata->get_layout_id(),
+        source_object_metadata->get_extents(),
         std::bind(&S3CopyObjectAction::copy_object_cb, this),
         std::bind(&S3CopyObjectAction::copy_object_success, this),
         std::bind(&S3CopyObjectAction::copy_object_failed, this));
@@ -335,6 +516,7 @@ void S3CopyObjectAction::copy_object_success() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
 
   s3_put_action_state = S3PutObjectActionState::writeComplete;
+  content_md5 = object_data_copier->get_content_md5();
   object_data_copier.reset();
   next();
 
@@ -363,8 +545,13 @@ void S3CopyObjectAction::save_metadata() {
   new_object_metadata->set_content_length(std::to_string(total_data_to_stream));
   new_object_metadata->set_content_type(
       source_object_metadata->get_content_type());
-  new_object_metadata->set_md5(motr_writer->get_content_md5());
+  // Empty source is not copied, motr_writer has the md5 of no data then.
+  new_object_metadata->set_md5(content_md5.empty()
+                                   ? motr_writer->get_content_md5()
+                                   : content_md5);
   new_object_metadata->setacl(auth_acl);
+  // Data is copied to the same offsets as in source object.
+  new_object_metadata->set_extents(source_object_metadata->get_extents());
 
   // put source object tags on new object
   s3_log(S3_LOG_DEBUG, stripped_request_id,
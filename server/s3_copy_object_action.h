@@ -56,6 +56,8 @@ class S3CopyObjectAction : public S3PutObjectActionBase {
   std::shared_ptr<S3ObjectMetadata> source_object_metadata;
   std::shared_ptr<S3BucketMetadata> source_bucket_metadata;
   std::unique_ptr<S3ObjectDataCopier> object_data_copier;
+  // md5 of the data copied by object_data_copier.
+  std::string content_md5;
 
   bool response_started = false;
 
@@ -86,12 +88,26 @@ class S3CopyObjectAction : public S3PutObjectActionBase {
       std::shared_ptr<S3MotrReaderFactory> motrreader_s3_factory = nullptr,
       std::shared_ptr<S3MotrKVSWriterFactory> kv_writer_factory = nullptr);
 
+  // Splits value of x-amz-copy-source into source's bucket and object names.
+  static void parse_copy_source(const std::string& source,
+                                std::string& bucket_name,
+                                std::string& object_name);
+
  private:
   void setup_steps();
 
   std::string get_response_xml();
 
   void validate_copyobject_request();
+  bool can_share_source_data();
+  void create_destination_object();
+  void share_source_data();
+  void copy_inline_source();
+  void add_object_data_refs();
+  void add_object_data_refs_failed();
+  void check_source_object_data();
+  void check_source_object_data_success();
+  void check_source_object_data_failed();
   void copy_object();
   bool copy_object_cb();
   void copy_object_success();
@@ -149,6 +165,15 @@ class S3CopyObjectAction : public S3PutObjectActionBase {
   FRIEND_TEST(S3CopyObjectActionTest, CreateObjectFailedToLaunchTest);
   FRIEND_TEST(S3CopyObjectActionTest, CreateNewOidTest);
   FRIEND_TEST(S3CopyObjectActionTest, ZeroSizeObject);
+  FRIEND_TEST(S3CopyObjectActionTest, CanShareSourceData);
+  FRIEND_TEST(S3CopyObjectActionTest, CreateDestinationObjectSharesData);
+  FRIEND_TEST(S3CopyObjectActionTest, AddObjectDataRefs);
+  FRIEND_TEST(S3CopyObjectActionTest, CopyObjectOfSharedData);
+  FRIEND_TEST(S3CopyObjectActionTest, AddObjectDataRefsFailed);
+  FRIEND_TEST(S3CopyObjectActionTest, CheckSourceObjectDataSuccess);
+  FRIEND_TEST(S3CopyObjectActionTest, CheckSourceObjectDataReplaced);
+  FRIEND_TEST(S3CopyObjectActionTest, CheckSourceObjectDataMissing);
+  FRIEND_TEST(S3CopyObjectActionTest, SharedDataNotDeletedOnRollback);
   FRIEND_TEST(S3CopyObjectActionTest, SaveMetadata);
   FRIEND_TEST(S3CopyObjectActionTest, SaveObjectMetadataFailed);
   FRIEND_TEST(S3CopyObjectActionTest, SendResponseWhenShuttingDown);
@@ -283,7 +283,9 @@ void S3DeleteMultipleObjectsAction::add_object_oid_to_probable_dead_oid_list() {
   std::map<std::string, std::string> delete_list;
 
   for (const auto& obj : objects_metadata) {
-    if (obj->get_state() != S3ObjectMetadataState::invalid) {
+    // Inline object has no motr object to be deleted in background
+    if (obj->get_state() != S3ObjectMetadataState::invalid &&
+        !obj->is_inline()) {
       std::string oid_str = S3M0Uint128Helper::to_string(obj->get_oid());
       assert(!oid_str.empty());
       // Add error when any key is empty
@@ -311,6 +313,11 @@ void S3DeleteMultipleObjectsAction::add_object_oid_to_probable_dead_oid_list() {
     }
   }
 
+  if (delete_list.empty()) {
+    delete_objects_metadata();
+    s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+    return;
+  }
   motr_kv_writer->put_keyval(
       global_probable_dead_object_list_index_oid, delete_list,
       std::bind(&S3DeleteMultipleObjectsAction::delete_objects_metadata, this),
@@ -358,6 +365,10 @@ void S3DeleteMultipleObjectsAction::delete_objects_metadata_successful() {
   at_least_one_delete_successful = true;
   for (auto& obj : objects_metadata) {
     delete_objects_response.add_success(obj->get_object_name());
+    if (obj->is_inline()) {
+      inline_version_keys_to_delete.push_back(obj->get_version_key_in_index());
+      continue;
+    }
     oids_to_delete.push_back(obj->get_oid());
     layout_id_for_objs_to_delete.push_back(obj->get_layout_id());
   }
@@ -441,7 +452,16 @@ void S3DeleteMultipleObjectsAction::send_response_to_s3_client() {
 void S3DeleteMultipleObjectsAction::cleanup() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
 
-  if (oids_to_delete.empty()) {
+  if (!inline_version_keys_to_delete.empty()) {
+    // Version entries of inline objects are not removed by background
+    // delete as they have no probable delete record, remove them here.
+    std::vector<std::string> version_keys;
+    version_keys.swap(inline_version_keys_to_delete);
+    motr_kv_writer->delete_keyval(
+        bucket_metadata->get_objects_version_list_index_oid(), version_keys,
+        std::bind(&S3DeleteMultipleObjectsAction::cleanup, this),
+        std::bind(&S3DeleteMultipleObjectsAction::cleanup, this));
+  } else if (oids_to_delete.empty()) {
     cleanup_oid_from_probable_dead_oid_list();
   } else {
     if (S3Option::get_instance()->is_s3server_obj_delayed_del_enabled()) {
@@ -56,6 +56,8 @@ class S3DeleteMultipleObjectsAction : public S3BucketAction {
   std::vector<struct m0_uint128> oids_to_delete;
   std::vector<int> layout_id_for_objs_to_delete;
   std::vector<std::string> keys_to_delete;
+  // Version entries of deleted inline objects
+  std::vector<std::string> inline_version_keys_to_delete;
   bool at_least_one_delete_successful;
 
   S3DeleteMultipleObjectsResponseBody delete_objects_response;
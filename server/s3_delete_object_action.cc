@@ -121,6 +121,13 @@ void S3DeleteObjectAction::fetch_object_info_failed() {
 
 void S3DeleteObjectAction::add_object_oid_to_probable_dead_oid_list() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  if (object_metadata->is_inline()) {
+    // Data goes away with metadata, nothing is left for backgrounddelete.
+    s3_log(S3_LOG_DEBUG, request_id, "Object data is inline\n");
+    next();
+    s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+    return;
+  }
 
   oid_str = S3M0Uint128Helper::to_string(object_metadata->get_oid());
   if (!motr_kv_writer) {
@@ -216,8 +223,9 @@ void S3DeleteObjectAction::startcleanup() {
 
   if (s3_del_obj_action_state == S3DeleteObjectActionState::validationFailed ||
       s3_del_obj_action_state ==
-          S3DeleteObjectActionState::probableEntryRecordFailed) {
-    // Nothing to clean up
+          S3DeleteObjectActionState::probableEntryRecordFailed ||
+      (object_metadata && object_metadata->is_inline())) {
+    // Nothing to clean up, inline object has no motr object
     done();
   } else {
     if (s3_del_obj_action_state == S3DeleteObjectActionState::metadataDeleted) {
@@ -27,12 +27,14 @@
 #include "s3_async_buffer_opt.h"
 #include "s3_auth_client.h"
 #include "s3_bucket_metadata_v1.h"
+#include "s3_motr_kvs_cursor.h"
 #include "s3_motr_kvs_reader.h"
 #include "s3_motr_kvs_writer.h"
 #include "s3_motr_reader.h"
 #include "s3_motr_writer.h"
 #include "s3_log.h"
 #include "s3_object_metadata.h"
+#include "s3_option.h"
 #include "s3_part_metadata.h"
 #include "s3_put_bucket_body.h"
 #include "s3_put_tag_body.h"
@@ -159,6 +161,17 @@ class S3MotrKVSReaderFactory {
            "S3MotrKVSReaderFactory::create_motr_kvs_reader\n");
     return std::make_shared<S3MotrKVSReader>(req, s3_motr_api);
   }
+  // Reader for walking an index batch after batch.
+  virtual std::shared_ptr<S3MotrKVSReader> create_motr_kvs_cursor(
+      std::shared_ptr<RequestObject> req,
+      std::shared_ptr<MotrAPI> s3_motr_api = nullptr) {
+    s3_log(S3_LOG_DEBUG, "",
+           "S3MotrKVSReaderFactory::create_motr_kvs_cursor\n");
+    if (S3Option::get_instance()->is_motr_idx_prefetch_enabled()) {
+      return std::make_shared<S3MotrKVSCursor>(req, s3_motr_api);
+    }
+    return std::make_shared<S3MotrKVSReader>(req, s3_motr_api);
+  }
 };
 
 class S3MotrKVSWriterFactory {
@@ -136,6 +136,11 @@ void S3GetBucketAction::validate_request() {
     object_list->set_max_keys(max_k);
   }
   s3_log(S3_LOG_DEBUG, request_id, "max-keys = %s\n", max_k.c_str());
+  if (S3Option::get_instance()->is_list_response_streaming_enabled()) {
+    object_list->enable_streaming(request->get_canonical_id(),
+                                  bucket_metadata->get_owner_id(),
+                                  request->get_user_id());
+  }
   after_validate_request();
 }
 
@@ -156,7 +161,7 @@ void S3GetBucketAction::get_next_objects() {
   m0_uint128 object_list_index_oid =
       bucket_metadata->get_object_list_index_oid();
   if (motr_kv_reader == nullptr) {
-    motr_kv_reader = s3_motr_kvs_reader_factory->create_motr_kvs_reader(
+    motr_kv_reader = s3_motr_kvs_reader_factory->create_motr_kvs_cursor(
         request, s3_motr_api);
   }
 
@@ -220,7 +225,6 @@ void S3GetBucketAction::get_next_objects_successful() {
   bool atleast_one_json_error = false;
   bool last_key_in_common_prefix = false;
   bool skip_no_further_prefix_match = false;
-  bool b_skip_remaining_common_prefixes = false;
   std::string last_common_prefix = "";
   auto& kvps = motr_kv_reader->get_key_values();
   size_t length = kvps.size();
@@ -298,8 +302,8 @@ void S3GetBucketAction::get_next_objects_successful() {
           }
         }
       }
-      size_t common_prefix_pos = kv.first.find(last_common_prefix);
-      if (common_prefix_pos == std::string::npos) {
+      if (kv.first.compare(0, last_common_prefix.length(),
+                           last_common_prefix) != 0) {
         // As we didn't find key with same common prefix, it means we have one
         // more key added to the list.
         // Now check if we have reached the max keys requested. If yes, break
@@ -325,7 +329,7 @@ void S3GetBucketAction::get_next_objects_successful() {
     auto object = object_metadata_factory->create_object_metadata_obj(request);
     size_t delimiter_pos = std::string::npos;
     if (request_prefix.empty() && request_delimiter.empty()) {
-      if (object->from_json(kv.second.second) != 0) {
+      if (object->from_listing_json(kv.second.second) != 0) {
         atleast_one_json_error = true;
         s3_log(S3_LOG_ERROR, request_id,
                "Json Parsing failed. Index oid = "
@@ -338,7 +342,7 @@ void S3GetBucketAction::get_next_objects_successful() {
     } else if (!request_prefix.empty() && request_delimiter.empty()) {
       // Filter out by prefix
       if (kv.first.find(request_prefix) == 0) {
-        if (object->from_json(kv.second.second) != 0) {
+        if (object->from_listing_json(kv.second.second) != 0) {
           atleast_one_json_error = true;
           s3_log(S3_LOG_ERROR, request_id,
                  "Json Parsing failed. Index oid = "
@@ -365,7 +369,7 @@ void S3GetBucketAction::get_next_objects_successful() {
     } else if (request_prefix.empty() && !request_delimiter.empty()) {
       delimiter_pos = kv.first.find(request_delimiter);
       if (delimiter_pos == std::string::npos) {
-        if (object->from_json(kv.second.second) != 0) {
+        if (object->from_listing_json(kv.second.second) != 0) {
           atleast_one_json_error = true;
           s3_log(S3_LOG_ERROR, request_id,
                  "Json Parsing failed. Index oid = "
@@ -385,13 +389,6 @@ void S3GetBucketAction::get_next_objects_successful() {
                "Delimiter %s found at pos %zu in string %s\n",
                request_delimiter.c_str(), delimiter_pos, kv.first.c_str());
         std::string common_prefix = kv.first.substr(0, delimiter_pos + 1);
-        b_skip_remaining_common_prefixes = false;
-        // Before adding common prefix, check if this is the first time we add
-        // this key
-        // to common_prefixes. If so, skip remaining keys that belong to it.
-        if (!object_list->is_prefix_in_common_prefix(common_prefix)) {
-          b_skip_remaining_common_prefixes = true;
-        }
         if (common_prefix != request_marker_key) {
           // If marker is specified, and if this key gets rolled up
           // in common prefix, we add to common prefix only if it is not the
@@ -399,18 +396,12 @@ void S3GetBucketAction::get_next_objects_successful() {
           object_list->add_common_prefix(common_prefix);
           s3_log(S3_LOG_DEBUG, request_id, "Adding common prefix [%s]\n",
                  common_prefix.c_str());
-          last_common_prefix = common_prefix;
-          last_key_in_common_prefix = true;
-        }
-        if (b_skip_remaining_common_prefixes) {
-          // Skip remaining common prefixes
-          // For this, set last key for the next key enumeration and break
-          last_key = common_prefix + "\xff";
-          s3_log(S3_LOG_DEBUG, request_id,
-                 "Skipping further common prefixes, set next key = [%s]\n",
-                 last_key.c_str());
-          break;
         }
+        // Remaining keys of this common prefix in the batch are skipped at
+        // the top of the loop. If the batch ends within the prefix, listing
+        // seeks past it instead of reading the rest of its keys.
+        last_common_prefix = common_prefix;
+        last_key_in_common_prefix = true;
       }
     } else {
       // both prefix and delimiter are not empty
@@ -419,7 +410,7 @@ void S3GetBucketAction::get_next_objects_successful() {
         delimiter_pos =
             kv.first.find(request_delimiter, request_prefix.length());
         if (delimiter_pos == std::string::npos) {
-          if (object->from_json(kv.second.second) != 0) {
+          if (object->from_listing_json(kv.second.second) != 0) {
             atleast_one_json_error = true;
             s3_log(S3_LOG_ERROR, request_id.c_str(),
                    "Json Parsing failed. Index oid = "
@@ -439,13 +430,6 @@ void S3GetBucketAction::get_next_objects_successful() {
                  "Delimiter %s found at pos %zu in string %s\n",
                  request_delimiter.c_str(), delimiter_pos, kv.first.c_str());
           std::string common_prefix = kv.first.substr(0, delimiter_pos + 1);
-          b_skip_remaining_common_prefixes = false;
-          // Before adding common prefix, check if this is the first time we
-          // add this key to common_prefixes.
-          // If so, skip remaining keys that belong to it.
-          if (!object_list->is_prefix_in_common_prefix(common_prefix)) {
-            b_skip_remaining_common_prefixes = true;
-          }
           if (common_prefix != request_marker_key) {
             // If marker is specified, and if this key gets rolled up
             // in common prefix, we add to common prefix only if it is not the
@@ -453,18 +437,10 @@ void S3GetBucketAction::get_next_objects_successful() {
             object_list->add_common_prefix(common_prefix);
             s3_log(S3_LOG_DEBUG, request_id, "Adding common prefix [%s]\n",
                    common_prefix.c_str());
-            last_common_prefix = common_prefix;
-            last_key_in_common_prefix = true;
-          }
-          if (b_skip_remaining_common_prefixes) {
-            // Skip remaining common prefixes
-            // For this, set last key for the next key enumeration and break
-            last_key = common_prefix + "\xff";
-            s3_log(S3_LOG_DEBUG, request_id,
-                   "Skipping further common prefixes, set next key = [%s]\n",
-                   last_key.c_str());
-            break;
           }
+          // Remaining keys of this common prefix are skipped, see above.
+          last_common_prefix = common_prefix;
+          last_key_in_common_prefix = true;
         }
       } else {
         // Prefix does not match.
@@ -500,43 +476,39 @@ void S3GetBucketAction::get_next_objects_successful() {
 
   // We ask for more if there is any.
   key_Count = object_list->size() + object_list->common_prefixes_size();
-  if ((key_Count == max_keys) ||
-      (!b_skip_remaining_common_prefixes && (kvps.size() < max_record_count)) ||
+  if (last_key_in_common_prefix && length == 0 &&
+      !skip_no_further_prefix_match && kvps.size() == max_record_count) {
+    // The batch ended within a common prefix which may have many more keys.
+    // Rather than reading all of them only to roll them up, continue the
+    // enumeration from the first key past the common prefix.
+    last_key = last_common_prefix + "\xff";
+    s3_log(S3_LOG_DEBUG, request_id,
+           "Skipping further keys of common prefix, set next key = [%s]\n",
+           last_key.c_str());
+    if (key_Count == max_keys) {
+      // The response is complete. We only need to know if there are any
+      // more keys left after the common prefix, to mark the truncation flag
+      // in the object list response.
+      b_state_start_check_any_more_keys = true;
+      saved_last_key = last_common_prefix;
+    }
+    get_next_objects();
+    return;
+  }
+  if ((key_Count == max_keys) || (kvps.size() < max_record_count) ||
       (skip_no_further_prefix_match)) {
     // Go ahead and respond.
     if (key_Count == max_keys && length != 0) {
-      // When we hit the max keys condition and previously we skipped common
-      // prefix keys
-      // (i.e. b_skip_remaining_common_prefixes = true), we can't rely on
-      // 'length' variable for truncation flag.
-      // In such case, we don't know if there are any more keys left after
-      // skipping the common prefix. In such situation, we have to explictly
-      // identify if there are any further keys left in a bucket to mark
-      // the truncation flag in the object list response.
-      if (b_skip_remaining_common_prefixes) {
-        // Check with Motr if there are any keys to be seen.
-        // If there are still some keys, we would set truncation flag, else no.
-        b_state_start_check_any_more_keys = true;
-        if (last_key_in_common_prefix) {
-          saved_last_key = last_common_prefix;
-        }
-        // Call get_next_objects to see remaining keys, if any, after skipping
-        // keys belonging to common prefix.
-        get_next_objects();
-        return;
-      } else {
-        object_list->set_response_is_truncated(true);
-        // Before sending response, check if the previous key was in common
-        // prefix
-        // If yes, we need to return the common prefix as next marker
-        // This is required to fix Ceph S3 test case.
-        if (last_key_in_common_prefix) {
-          last_key = last_common_prefix;
-        }
-        s3_log(S3_LOG_DEBUG, request_id, "Next marker = %s\n",
-               last_key.c_str());
-        object_list->set_next_marker_key(last_key);
+      object_list->set_response_is_truncated(true);
+      // Before sending response, check if the previous key was in common
+      // prefix
+      // If yes, we need to return the common prefix as next marker
+      // This is required to fix Ceph S3 test case.
+      if (last_key_in_common_prefix) {
+        last_key = last_common_prefix;
       }
+      s3_log(S3_LOG_DEBUG, request_id, "Next marker = %s\n", last_key.c_str());
+      object_list->set_next_marker_key(last_key);
     }
     fetch_successful = true;
     object_list->set_key_count(key_Count);
@@ -605,6 +577,11 @@ void S3GetBucketAction::send_response_to_s3_client() {
       request->set_out_header_value("Retry-After", "1");
     }
     request->send_response(error.get_http_status_code(), response_xml);
+  } else if (fetch_successful && object_list->is_streaming()) {
+    // Total visited/touched keys in the bucket
+    s3_log(S3_LOG_INFO, stripped_request_id, "Total keys visited = %zu\n",
+           total_keys_visited);
+    send_object_list_in_chunks();
   } else if (fetch_successful) {
     std::string& response_xml = object_list->get_xml(
         request->get_canonical_id(), bucket_metadata->get_owner_id(),
@@ -633,3 +610,18 @@ void S3GetBucketAction::send_response_to_s3_client() {
   done();
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
+
+void S3GetBucketAction::send_object_list_in_chunks() {
+  std::string xml_head = object_list->get_xml_head();
+  std::string xml_tail = object_list->get_xml_tail();
+  std::string& contents_xml = object_list->get_contents_xml();
+
+  request->set_out_header_value("Content-Type", "application/xml");
+  request->set_bytes_sent(xml_head.length() + contents_xml.length() +
+                          xml_tail.length());
+  request->send_reply_chunk_start(S3HttpSuccess200);
+  request->send_reply_chunk(xml_head.c_str(), xml_head.length());
+  request->send_reply_chunk(contents_xml.c_str(), contents_xml.length());
+  request->send_reply_chunk(xml_tail.c_str(), xml_tail.length());
+  request->send_reply_chunk_end();
+}
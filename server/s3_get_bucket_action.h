@@ -58,6 +58,9 @@ class S3GetBucketAction : public S3BucketAction {
     return "BUCKET/" + request->get_bucket_name() + "/Multipart";
   }
 
+  // Sends the streamed object list with chunked transfer encoding.
+  void send_object_list_in_chunks();
+
   // Request Input params
   std::string request_prefix;
   std::string request_delimiter;
@@ -113,11 +116,16 @@ class S3GetBucketAction : public S3BucketAction {
   FRIEND_TEST(S3GetBucketActionTest, SendResponseToClientServiceUnavailable);
   FRIEND_TEST(S3GetBucketActionTest, SendResponseToClientNoSuchBucket);
   FRIEND_TEST(S3GetBucketActionTest, SendResponseToClientSuccess);
+  FRIEND_TEST(S3GetBucketActionTest, SendResponseToClientSuccessStreaming);
   FRIEND_TEST(S3GetBucketActionTest, SendResponseToClientInternalError);
   FRIEND_TEST(S3GetBucketActionTest, GetNextObjectsSuccessfulMultiComponentKey);
   FRIEND_TEST(S3GetBucketActionTest,
               GetNextObjectsSuccessfulPrefixDelimMultiComponentKey);
   FRIEND_TEST(S3GetBucketActionTest, GetNextObjectsSuccessfulDelimiterLastKey);
+  FRIEND_TEST(S3GetBucketActionTest,
+              GetNextObjectsSuccessfulDelimiterSkipsInBatch);
+  FRIEND_TEST(S3GetBucketActionTest,
+              GetNextObjectsSuccessfulDelimiterSeekTruncated);
 };
 
 #endif
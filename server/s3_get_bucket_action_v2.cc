@@ -138,19 +138,23 @@ void S3GetBucketActionV2::send_response_to_s3_client() {
                         obfuscated_nextmarker.size());
       // Do not URL encode NextContinuationToken
       obj_v2_list->set_next_marker_key(enc_token, false);
-      std::string& response_xml = obj_v2_list->get_xml(
-          request->get_canonical_id(), bucket_metadata->get_owner_id(),
-          request->get_user_id());
-      request->set_out_header_value("Content-Length",
-                                    std::to_string(response_xml.length()));
-      request->set_out_header_value("Content-Type", "application/xml");
-      request->set_bytes_sent(response_xml.length());
-      s3_log(S3_LOG_DEBUG, request_id, "Object list V2 response_xml = %s\n",
-             response_xml.c_str());
       // Total visited/touched keys in the bucket
       s3_log(S3_LOG_INFO, stripped_request_id, "Total keys visited = %zu\n",
              total_keys_visited);
-      request->send_response(S3HttpSuccess200, response_xml);
+      if (obj_v2_list->is_streaming()) {
+        send_object_list_in_chunks();
+      } else {
+        std::string& response_xml = obj_v2_list->get_xml(
+            request->get_canonical_id(), bucket_metadata->get_owner_id(),
+            request->get_user_id());
+        request->set_out_header_value("Content-Length",
+                                      std::to_string(response_xml.length()));
+        request->set_out_header_value("Content-Type", "application/xml");
+        request->set_bytes_sent(response_xml.length());
+        s3_log(S3_LOG_DEBUG, request_id,
+               "Object list V2 response_xml = %s\n", response_xml.c_str());
+        request->send_response(S3HttpSuccess200, response_xml);
+      }
     }
   } else {
     S3Error error("InternalError", request->get_request_id(),
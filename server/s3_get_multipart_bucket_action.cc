@@ -143,8 +143,10 @@ void S3GetMultipartBucketAction::get_next_objects() {
     send_response_to_s3_client();
   } else {
     size_t count = S3Option::get_instance()->get_motr_idx_fetch_count();
-    motr_kv_reader = s3_motr_kvs_reader_factory->create_motr_kvs_reader(
-        request, s3_motr_api);
+    if (motr_kv_reader == nullptr) {
+      motr_kv_reader = s3_motr_kvs_reader_factory->create_motr_kvs_cursor(
+          request, s3_motr_api);
+    }
     motr_kv_reader->next_keyval(
         bucket_metadata->get_multipart_index_oid(), last_key, count,
         std::bind(&S3GetMultipartBucketAction::get_next_objects_successful,
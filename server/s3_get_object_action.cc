@@ -19,10 +19,13 @@
  */
 
 #include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include "s3_get_object_action.h"
 #include "s3_motr_layout.h"
 #include "s3_error_codes.h"
 #include "s3_log.h"
+#include "s3_mem_pool_manager.h"
 #include "s3_option.h"
 #include "s3_common_utilities.h"
 #include "s3_stats.h"
@@ -42,7 +45,14 @@ S3GetObjectAction::S3GetObjectAction(
       first_byte_offset_to_read(0),
       last_byte_offset_to_read(0),
       total_blocks_to_read(0),
-      read_object_reply_started(false) {
+      read_object_reply_started(false),
+      read_ahead_depth(1),
+      reads_in_flight(0),
+      blocks_requested(0),
+      next_read_offset(0),
+      read_failed(false),
+      read_extent_index(0),
+      read_extent_start(0) {
   s3_log(S3_LOG_DEBUG, request_id, "%s Ctor\n", __func__);
 
   s3_log(S3_LOG_INFO, stripped_request_id,
@@ -55,6 +65,11 @@ S3GetObjectAction::S3GetObjectAction(
   } else {
     motr_reader_factory = std::make_shared<S3MotrReaderFactory>();
   }
+  read_ahead_max_depth =
+      S3Option::get_instance()->get_motr_max_read_ahead_depth();
+  if (read_ahead_max_depth == 0) {
+    read_ahead_max_depth = 1;
+  }
 
   setup_steps();
 }
@@ -144,6 +159,9 @@ void S3GetObjectAction::validate_object_info() {
     }
     request->send_reply_start(S3HttpSuccess200);
     send_response_to_s3_client();
+  } else if (object_metadata->is_inline()) {
+    s3_log(S3_LOG_DEBUG, request_id, "Object data is inline\n");
+    next();
   } else {
     size_t motr_unit_size =
         S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
@@ -161,25 +179,35 @@ void S3GetObjectAction::validate_object_info() {
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
+void S3GetObjectAction::load_object_extents() {
+  extents = object_metadata->get_extents();
+  if (extents.empty()) {
+    // Object data is contiguous.
+    extents.push_back({0, content_length});
+  }
+}
+
 void S3GetObjectAction::set_total_blocks_to_read_from_object() {
-  // to read complete object, total number blocks to read is equal to total
-  // number of blocks
-  if ((first_byte_offset_to_read == 0) &&
-      (last_byte_offset_to_read == (content_length - 1))) {
-    total_blocks_to_read = total_blocks_in_object;
-  } else {
-    // object read for valid range
-    size_t motr_unit_size =
-        S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
-            object_metadata->get_layout_id());
-    // get block of first_byte_offset_to_read
-    size_t first_byte_offset_block =
-        (first_byte_offset_to_read + motr_unit_size) / motr_unit_size;
-    // get block of last_byte_offset_to_read
-    size_t last_byte_offset_block =
-        (last_byte_offset_to_read + motr_unit_size) / motr_unit_size;
-    // get total number blocks to read for a given valid range
-    total_blocks_to_read = last_byte_offset_block - first_byte_offset_block + 1;
+  load_object_extents();
+  size_t motr_unit_size =
+      S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
+          object_metadata->get_layout_id());
+  // Count blocks holding requested range in every extent it overlaps.
+  total_blocks_to_read = 0;
+  size_t extent_start = 0;
+  for (const auto& extent : extents) {
+    size_t extent_end = extent_start + extent.length;
+    if (extent.length != 0 && first_byte_offset_to_read < extent_end &&
+        last_byte_offset_to_read >= extent_start) {
+      size_t first_byte =
+          std::max(first_byte_offset_to_read, extent_start) - extent_start;
+      size_t last_byte =
+          std::min(last_byte_offset_to_read, extent_end - 1) - extent_start;
+      total_blocks_to_read += (extent.offset + last_byte) / motr_unit_size -
+                              (extent.offset + first_byte) / motr_unit_size +
+                              1;
+    }
+    extent_start = extent_end;
   }
 }
 
@@ -323,24 +351,40 @@ void S3GetObjectAction::check_full_or_range_object_read() {
 
 void S3GetObjectAction::read_object() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  if (object_metadata->is_inline()) {
+    send_inline_data_to_client();
+    s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+    return;
+  }
   // get total number of blocks to read from an object
   set_total_blocks_to_read_from_object();
   motr_reader = motr_reader_factory->create_motr_reader(
       request, object_metadata->get_oid(), object_metadata->get_layout_id());
-  // get the block,in which first_byte_offset_to_read is present
-  // and initilaize the last index with starting offset the block
-  size_t block_start_offset =
-      first_byte_offset_to_read -
-      (first_byte_offset_to_read %
-       S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
-           object_metadata->get_layout_id()));
-  motr_reader->set_last_index(block_start_offset);
+  // Reads start with the extent holding first_byte_offset_to_read, motr
+  // read offset is set per slot.
+  next_read_offset = first_byte_offset_to_read;
+  read_extent_index = 0;
+  read_extent_start = 0;
+  while (read_extent_index < extents.size() &&
+         next_read_offset >=
+             read_extent_start + extents[read_extent_index].length) {
+    read_extent_start += extents[read_extent_index].length;
+    read_extent_index++;
+  }
+  idle_motr_readers.push_back(motr_reader);
   read_object_data();
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
 void S3GetObjectAction::read_object_data() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  if (reads_in_flight > 0 &&
+      S3Option::get_instance()->get_is_s3_shutting_down()) {
+    // Response is sent once reads in flight are complete, so that motr
+    // callbacks do not outlive the action.
+    s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+    return;
+  }
   if (check_shutdown_and_rollback()) {
     s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
     return;
@@ -348,19 +392,37 @@ void S3GetObjectAction::read_object_data() {
 
   size_t max_blocks_in_one_read_op =
       S3Option::get_instance()->get_motr_units_per_request();
+  int layout_id = object_metadata->get_layout_id();
   size_t motr_unit_size =
-      S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
-          object_metadata->get_layout_id());
-  size_t blocks_to_read = 0;
+      S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(layout_id);
+  size_t requested_content_length = get_requested_content_length();
 
   s3_log(S3_LOG_DEBUG, request_id, "max_blocks_in_one_read_op: (%zu)\n",
          max_blocks_in_one_read_op);
   s3_log(S3_LOG_DEBUG, request_id, "blocks_already_read: (%zu)\n",
          blocks_already_read);
+  s3_log(S3_LOG_DEBUG, request_id, "blocks_requested: (%zu)\n",
+         blocks_requested);
   s3_log(S3_LOG_DEBUG, request_id, "total_blocks_to_read: (%zu)\n",
          total_blocks_to_read);
-  if (blocks_already_read != total_blocks_to_read) {
-    if (blocks_already_read == 0 &&
+  s3_log(S3_LOG_DEBUG, request_id, "reads_in_flight: (%zu/%zu)\n",
+         reads_in_flight, read_ahead_depth);
+  if (blocks_requested == total_blocks_to_read) {
+    if (read_ahead_slots.empty()) {
+      // We are done Reading
+      send_response_to_s3_client();
+    }
+    s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+    return;
+  }
+  // Slot callbacks may run before launch returns, hence state is re-checked
+  // on every iteration.
+  while (!read_failed && !reject_if_shutting_down() &&
+         reads_in_flight < read_ahead_depth &&
+         blocks_requested < total_blocks_to_read &&
+         data_sent_to_client < requested_content_length) {
+    size_t blocks_to_read = 0;
+    if (blocks_requested == 0 &&
         content_length > max_blocks_in_one_read_op * motr_unit_size) {
       size_t first_blocks_to_read =
           S3Option::get_instance()->get_motr_first_read_size();
@@ -369,140 +431,326 @@ void S3GetObjectAction::read_object_data() {
                            : first_blocks_to_read;
       s3_log(S3_LOG_DEBUG, request_id, "First blocks_to_read: (%zu)\n",
              blocks_to_read);
-    } else if ((total_blocks_to_read - blocks_already_read) >
+    } else if ((total_blocks_to_read - blocks_requested) >
                max_blocks_in_one_read_op) {
       blocks_to_read = max_blocks_in_one_read_op;
     } else {
-      blocks_to_read = total_blocks_to_read - blocks_already_read;
+      blocks_to_read = total_blocks_to_read - blocks_requested;
     }
     s3_log(S3_LOG_DEBUG, request_id, "blocks_to_read: (%zu)\n", blocks_to_read);
 
-    if (blocks_to_read > 0) {
-      bool op_launched = motr_reader->read_object_data(
-          blocks_to_read,
-          std::bind(&S3GetObjectAction::send_data_to_client, this),
-          std::bind(&S3GetObjectAction::read_object_data_failed, this));
-      if (!op_launched) {
-        if (motr_reader->get_state() == S3MotrReaderOpState::failed_to_launch) {
-          set_s3_error("ServiceUnavailable");
-          s3_log(S3_LOG_ERROR, request_id,
-                 "read_object_data called due to motr_entity_open failure\n");
-        } else {
-          set_s3_error("InternalError");
-        }
+    if (blocks_to_read == 0) {
+      if (reads_in_flight == 0) {
         send_response_to_s3_client();
       }
-    } else {
-      send_response_to_s3_client();
+      break;
+    }
+    // First read is always launched, read-ahead only when motr read
+    // mempool can afford it.
+    if (reads_in_flight > 0 &&
+        !mem_profile->we_have_enough_memory_for_read_ahead(layout_id,
+                                                           blocks_to_read)) {
+      s3_log(S3_LOG_DEBUG, request_id,
+             "Not enough memory in motr read mempool for read-ahead\n");
+      break;
     }
+    if (!launch_read_ahead_slot(blocks_to_read)) {
+      break;
+    }
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+bool S3GetObjectAction::launch_read_ahead_slot(size_t blocks_to_read) {
+  s3_log(S3_LOG_DEBUG, request_id, "%s Entry with blocks_to_read = %zu\n",
+         __func__, blocks_to_read);
+  std::shared_ptr<ReadAheadSlot> slot = std::make_shared<ReadAheadSlot>();
+  if (idle_motr_readers.empty()) {
+    slot->reader = motr_reader_factory->create_motr_reader(
+        request, object_metadata->get_oid(), object_metadata->get_layout_id());
   } else {
-    // We are done Reading
-    send_response_to_s3_client();
+    slot->reader = idle_motr_readers.back();
+    idle_motr_readers.pop_back();
+  }
+  assert(read_extent_index < extents.size());
+  size_t motr_unit_size =
+      S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
+          object_metadata->get_layout_id());
+  const S3ObjectExtent& extent = extents[read_extent_index];
+  size_t offset_in_extent = next_read_offset - read_extent_start;
+  size_t motr_offset = extent.offset + offset_in_extent;
+  size_t block_start_offset = motr_offset - (motr_offset % motr_unit_size);
+  size_t bytes_left_in_extent =
+      std::min(extent.length - offset_in_extent,
+               last_byte_offset_to_read + 1 - next_read_offset);
+  // Do not read past the extent, what follows belongs to another part
+  // or is a hole.
+  size_t blocks_left_in_extent =
+      (motr_offset - block_start_offset + bytes_left_in_extent +
+       motr_unit_size - 1) /
+      motr_unit_size;
+  if (blocks_to_read > blocks_left_in_extent) {
+    blocks_to_read = blocks_left_in_extent;
+  }
+  slot->blocks = blocks_to_read;
+  slot->skip_bytes = motr_offset - block_start_offset;
+  slot->data_length = std::min(blocks_to_read * motr_unit_size -
+                                   slot->skip_bytes,
+                               bytes_left_in_extent);
+  slot->completed = false;
+  slot->failed = false;
+  slot->reader->set_last_index(block_start_offset);
+
+  read_ahead_slots.push_back(slot);
+  next_read_offset += slot->data_length;
+  while (read_extent_index < extents.size() &&
+         next_read_offset >=
+             read_extent_start + extents[read_extent_index].length) {
+    read_extent_start += extents[read_extent_index].length;
+    read_extent_index++;
+  }
+  blocks_requested += blocks_to_read;
+  // Callbacks can be invoked before read_object_data() returns.
+  reads_in_flight++;
+
+  bool op_launched = slot->reader->read_object_data(
+      blocks_to_read,
+      std::bind(&S3GetObjectAction::read_ahead_slot_successful, this, slot),
+      std::bind(&S3GetObjectAction::read_ahead_slot_failed, this, slot));
+  if (!op_launched && !slot->completed) {
+    slot->completed = true;
+    slot->failed = true;
+    reads_in_flight--;
+    read_failed = true;
+    if (!read_object_reply_started) {
+      if (slot->reader->get_state() ==
+          S3MotrReaderOpState::failed_to_launch) {
+        set_s3_error("ServiceUnavailable");
+        s3_log(S3_LOG_ERROR, request_id,
+               "read_object_data called due to motr_entity_open failure\n");
+      } else {
+        set_s3_error("InternalError");
+      }
+    }
+    if (reads_in_flight == 0) {
+      read_object_data_failed();
+    }
   }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+  return op_launched;
 }
 
-void S3GetObjectAction::send_data_to_client() {
+void S3GetObjectAction::read_ahead_slot_successful(
+    std::shared_ptr<ReadAheadSlot> slot) {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  slot->completed = true;
+  reads_in_flight--;
   s3_stats_inc("read_object_data_success_count");
   log_timed_counter(get_timed_counter, "outgoing_object_data_blocks");
 
+  if (reads_in_flight > 0 &&
+      (read_failed || S3Option::get_instance()->get_is_s3_shutting_down())) {
+    // Wait for other reads in flight before responding.
+    s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+    return;
+  }
+  if (read_failed) {
+    read_object_data_failed();
+    s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+    return;
+  }
   if (check_shutdown_and_rollback()) {
     s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
     return;
   }
-  if (!read_object_reply_started) {
-    s3_timer.start();
+  // Data is sent to client in the order reads were launched.
+  while (!read_ahead_slots.empty() && read_ahead_slots.front()->completed) {
+    std::shared_ptr<ReadAheadSlot> head = read_ahead_slots.front();
+    read_ahead_slots.pop_front();
+    motr_reader = head->reader;
+    send_data_to_client(*head);
+    idle_motr_readers.push_back(head->reader);
+  }
 
-    // AWS add explicit quotes "" to etag values.
-    // https://docs.aws.amazon.com/AmazonS3/latest/API/API_GetObject.html
-    std::string e_tag = "\"" + object_metadata->get_md5() + "\"";
+  if (data_sent_to_client == get_requested_content_length()) {
+    if (reads_in_flight == 0) {
+      const auto mss = s3_timer.elapsed_time_in_millisec();
+      LOG_PERF("get_object_send_data_ms", request_id.c_str(), mss);
+      s3_stats_timing("get_object_send_data", mss);
 
-    request->set_out_header_value("Last-Modified",
-                                  object_metadata->get_last_modified_gmt());
-    request->set_out_header_value("Content-Type",
-                                  object_metadata->get_content_type());
-    request->set_out_header_value("ETag", e_tag);
-    s3_log(S3_LOG_INFO, stripped_request_id, "e_tag= %s", e_tag.c_str());
-    request->set_out_header_value("Accept-Ranges", "bytes");
-    request->set_out_header_value(
-        "Content-Length", std::to_string(get_requested_content_length()));
-    for (auto it : object_metadata->get_user_attributes()) {
-      request->set_out_header_value(it.first, it.second);
+      send_response_to_s3_client();
     }
-    if (!request->get_header_value("Range").empty()) {
-      std::ostringstream content_range_stream;
-      content_range_stream << "bytes " << first_byte_offset_to_read << "-"
-                           << last_byte_offset_to_read << "/" << content_length;
-      request->set_out_header_value("Content-Range",
-                                    content_range_stream.str());
-      // Partial Content
-      request->send_reply_start(S3HttpSuccess206);
-    } else {
-      request->send_reply_start(S3HttpSuccess200);
+  } else {
+    adjust_read_ahead_depth();
+    read_object_data();
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3GetObjectAction::read_ahead_slot_failed(
+    std::shared_ptr<ReadAheadSlot> slot) {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  slot->completed = true;
+  slot->failed = true;
+  reads_in_flight--;
+  read_failed = true;
+  if (reads_in_flight == 0) {
+    read_object_data_failed();
+  } else {
+    s3_log(S3_LOG_DEBUG, request_id,
+           "Waiting for %zu reads in flight before responding\n",
+           reads_in_flight);
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+// Keep about one read worth of data queued on the connection: a client that
+// drains the reply quickly gets more read-ahead, a slow one gets less.
+void S3GetObjectAction::adjust_read_ahead_depth() {
+  size_t read_size_in_bytes =
+      S3Option::get_instance()->get_motr_units_per_request() *
+      S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
+          object_metadata->get_layout_id());
+  size_t pending_reply_length = request->get_pending_reply_body_length();
+
+  if (pending_reply_length < read_size_in_bytes) {
+    if (read_ahead_depth < read_ahead_max_depth) {
+      read_ahead_depth++;
     }
-    read_object_reply_started = true;
+  } else if (pending_reply_length > read_ahead_depth * read_size_in_bytes) {
+    read_ahead_depth = std::max<size_t>(1, read_ahead_depth / 2);
+  }
+  s3_log(S3_LOG_DEBUG, request_id,
+         "pending_reply_length = %zu, read_ahead_depth = %zu\n",
+         pending_reply_length, read_ahead_depth);
+}
+
+// Data of inline object came with its metadata, no motr read is needed.
+void S3GetObjectAction::send_inline_data_to_client() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  const std::string data = object_metadata->get_inline_data();
+  if (data.length() != content_length) {
+    s3_log(S3_LOG_ERROR, request_id,
+           "Inline data of %zu bytes, expected %zu bytes\n", data.length(),
+           content_length);
+    set_s3_error("InternalError");
+    send_response_to_s3_client();
+    return;
+  }
+  s3_timer.start();
+  start_reply();
+  size_t length = get_requested_content_length();
+  request->send_reply_body(data.c_str() + first_byte_offset_to_read, length);
+  data_sent_to_client = length;
+  request->set_bytes_sent(data_sent_to_client);
+  s3_perf_count_outcoming_bytes(length);
+  s3_timer.stop();
+  send_response_to_s3_client();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3GetObjectAction::start_reply() {
+  // AWS add explicit quotes "" to etag values.
+  // https://docs.aws.amazon.com/AmazonS3/latest/API/API_GetObject.html
+  std::string e_tag = "\"" + object_metadata->get_md5() + "\"";
+
+  request->set_out_header_value("Last-Modified",
+                                object_metadata->get_last_modified_gmt());
+  request->set_out_header_value("Content-Type",
+                                object_metadata->get_content_type());
+  request->set_out_header_value("ETag", e_tag);
+  s3_log(S3_LOG_INFO, stripped_request_id, "e_tag= %s", e_tag.c_str());
+  request->set_out_header_value("Accept-Ranges", "bytes");
+  request->set_out_header_value(
+      "Content-Length", std::to_string(get_requested_content_length()));
+  for (auto it : object_metadata->get_user_attributes()) {
+    request->set_out_header_value(it.first, it.second);
+  }
+  if (!request->get_header_value("Range").empty()) {
+    std::ostringstream content_range_stream;
+    content_range_stream << "bytes " << first_byte_offset_to_read << "-"
+                         << last_byte_offset_to_read << "/" << content_length;
+    request->set_out_header_value("Content-Range", content_range_stream.str());
+    // Partial Content
+    request->send_reply_start(S3HttpSuccess206);
+  } else {
+    request->send_reply_start(S3HttpSuccess200);
+  }
+  read_object_reply_started = true;
+}
+
+void S3GetObjectAction::send_data_to_client(const ReadAheadSlot& slot) {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  if (!read_object_reply_started) {
+    s3_timer.start();
+    start_reply();
   } else {
     s3_timer.resume();
   }
   s3_log(S3_LOG_DEBUG, request_id, "Earlier data_sent_to_client = %zu bytes.\n",
          data_sent_to_client);
 
-  char* data = NULL;
-  size_t length = 0;
   size_t requested_content_length = get_requested_content_length();
   s3_log(S3_LOG_DEBUG, request_id,
          "object requested content length size(%zu).\n",
          requested_content_length);
-  length = motr_reader->get_first_block(&data);
-
-  while (length > 0) {
+  size_t motr_unit_size =
+      S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
+          object_metadata->get_layout_id());
+  S3MempoolManager* mempool_manager = S3MempoolManager::get_instance();
+  // Take ownership of motr buffers, so they can be handed to the
+  // connection without copying.
+  S3BufferSequence blocks_read = motr_reader->extract_blocks_read();
+  size_t skip_bytes = slot.skip_bytes;
+  size_t slot_bytes_left = slot.data_length;
+
+  for (auto& block : blocks_read) {
+    char* data = static_cast<char*>(block.first);
+    size_t length = block.second;
     size_t read_data_start_offset = 0;
     blocks_already_read++;
-    if (data_sent_to_client == 0) {
-      // get starting offset from the block,
-      // condition true for only statring block read object.
-      // this is to set get first offset byte from initial read block
+    if (skip_bytes != 0) {
+      // Slot starts within its first block,
       // eg: read_data_start_offset will be set to 1000 on initial read block
       // for a given range 1000-1500 to read from 2mb object
-      read_data_start_offset =
-          first_byte_offset_to_read %
-          S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
-              object_metadata->get_layout_id());
+      read_data_start_offset = std::min(skip_bytes, length);
+      skip_bytes -= read_data_start_offset;
       length -= read_data_start_offset;
     }
-    // to read number of bytes from final read block of read object
-    // that is requested content length is lesser than the sum of data has been
-    // sent to client and current read block size
-    if ((data_sent_to_client + length) >= requested_content_length) {
-      // length will have the size of remaining byte to sent
-      length = requested_content_length - data_sent_to_client;
+    // Last block of the slot may hold bytes beyond the requested range or
+    // the end of a part.
+    if (length > slot_bytes_left) {
+      length = slot_bytes_left;
     }
+    if (length == 0) {
+      mempool_manager->release_buffer_for_unit_size(data, motr_unit_size);
+      continue;
+    }
+    slot_bytes_left -= length;
     data_sent_to_client += length;
     request->set_bytes_sent(data_sent_to_client);
     s3_log(S3_LOG_DEBUG, request_id, "Sending %zu bytes to client.\n", length);
-    request->send_reply_body(data + read_data_start_offset, length);
+    if (read_data_start_offset == 0) {
+      // Buffer goes back to mempool once it is written to the socket.
+      request->send_reply_body_by_ref(data, length,
+                                      S3MempoolManager::release_buffer_by_ref,
+                                      (void*)(uintptr_t)motr_unit_size);
+    } else {
+      // Cleanup callback gets start of the referenced data, which is not
+      // the buffer start here, so copy this partial block.
+      request->send_reply_body(data + read_data_start_offset, length);
+      mempool_manager->release_buffer_for_unit_size(data, motr_unit_size);
+    }
     s3_perf_count_outcoming_bytes(length);
-    length = motr_reader->get_next_block(&data);
   }
   s3_timer.stop();
-
-  if (data_sent_to_client != requested_content_length) {
-    read_object_data();
-  } else {
-    const auto mss = s3_timer.elapsed_time_in_millisec();
-    LOG_PERF("get_object_send_data_ms", request_id.c_str(), mss);
-    s3_stats_timing("get_object_send_data", mss);
-
-    send_response_to_s3_client();
-  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
 void S3GetObjectAction::read_object_data_failed() {
   s3_log(S3_LOG_DEBUG, request_id, "Failed to read object data from motr\n");
   // set error only when reply is not started
-  if (!read_object_reply_started) {
+  if (!read_object_reply_started && get_s3_error_code().empty()) {
     set_s3_error("InternalError");
   }
   send_response_to_s3_client();
@@ -542,6 +790,7 @@ void S3GetObjectAction::send_response_to_s3_client() {
     request->send_response(error.get_http_status_code(), response_xml);
   } else if (object_metadata &&
              (object_metadata->get_content_length() == 0 ||
+              (object_metadata->is_inline() && read_object_reply_started) ||
               (motr_reader &&
                motr_reader->get_state() == S3MotrReaderOpState::success))) {
     request->send_reply_end();
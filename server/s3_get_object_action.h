@@ -24,7 +24,9 @@
 #define __S3_SERVER_S3_GET_OBJECT_ACTION_H__
 
 #include <gtest/gtest_prod.h>
+#include <deque>
 #include <memory>
+#include <vector>
 
 #include "s3_object_action_base.h"
 #include "s3_bucket_metadata.h"
@@ -49,6 +51,37 @@ class S3GetObjectAction : public S3ObjectAction {
   std::shared_ptr<S3MotrReaderFactory> motr_reader_factory;
   S3Timer s3_timer;
 
+  // Read-ahead state. Every motr read in flight owns a slot with its own
+  // motr reader, slots are delivered to client in the order of launch.
+  struct ReadAheadSlot {
+    std::shared_ptr<S3MotrReader> reader;
+    size_t blocks;
+    // Bytes of the first block preceding the requested data.
+    size_t skip_bytes;
+    // Requested bytes held by the slot blocks.
+    size_t data_length;
+    bool completed;
+    bool failed;
+  };
+  std::deque<std::shared_ptr<ReadAheadSlot>> read_ahead_slots;
+  // Readers whose data is already sent to client, reused for next slots.
+  std::vector<std::shared_ptr<S3MotrReader>> idle_motr_readers;
+  size_t read_ahead_max_depth;
+  // Current depth, adjusted as per how fast client drains the reply.
+  size_t read_ahead_depth;
+  size_t reads_in_flight;
+  size_t blocks_requested;
+  // Object offset of the next byte to be read.
+  size_t next_read_offset;
+  bool read_failed;
+
+  // Where object data lives in motr object, a multipart object written to
+  // part slots has one extent per part. A single read never spans extents.
+  std::vector<S3ObjectExtent> extents;
+  size_t read_extent_index;
+  // Object offset at which extents[read_extent_index] starts.
+  size_t read_extent_start;
+
   size_t get_requested_content_length() const {
     return last_byte_offset_to_read - first_byte_offset_to_read + 1;
   }
@@ -72,9 +105,16 @@ class S3GetObjectAction : public S3ObjectAction {
       const std::string& range_value);
   void read_object();
 
+  void load_object_extents();
   void read_object_data();
+  bool launch_read_ahead_slot(size_t blocks_to_read);
+  void read_ahead_slot_successful(std::shared_ptr<ReadAheadSlot> slot);
+  void read_ahead_slot_failed(std::shared_ptr<ReadAheadSlot> slot);
+  void adjust_read_ahead_depth();
   void read_object_data_failed();
-  void send_data_to_client();
+  void send_inline_data_to_client();
+  void start_reply();
+  void send_data_to_client(const ReadAheadSlot& slot);
   void send_response_to_s3_client();
 
   FRIEND_TEST(S3GetObjectActionTest, ConstructorTest);
@@ -98,6 +138,14 @@ class S3GetObjectAction : public S3ObjectAction {
   FRIEND_TEST(S3GetObjectActionTest, ReadObjectOfSizeEqualToUnitSize);
   FRIEND_TEST(S3GetObjectActionTest, ReadObjectOfSizeMoreThanUnitSize);
   FRIEND_TEST(S3GetObjectActionTest, ReadObjectOfGivenRange);
+  FRIEND_TEST(S3GetObjectActionTest, ReadObjectWithReadAheadDepthTwo);
+  FRIEND_TEST(S3GetObjectActionTest, ReadAheadDepthGrowsWhenClientDrains);
+  FRIEND_TEST(S3GetObjectActionTest, ReadAheadDepthShrinksWhenClientIsSlow);
+  FRIEND_TEST(S3GetObjectActionTest, ReadAheadFailureWaitsForReadsInFlight);
+  FRIEND_TEST(S3GetObjectActionTest, ReadObjectWrittenToPartSlots);
+  FRIEND_TEST(S3GetObjectActionTest, ReadRangeOfObjectWrittenToPartSlots);
+  FRIEND_TEST(S3GetObjectActionTest, ReadInlineObject);
+  FRIEND_TEST(S3GetObjectActionTest, ReadRangeOfInlineObject);
   FRIEND_TEST(S3GetObjectActionTest,
               SendResponseWhenShuttingDownAndResponseStarted);
   FRIEND_TEST(S3GetObjectActionTest,
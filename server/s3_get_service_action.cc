@@ -92,8 +92,10 @@ void S3GetServiceAction::get_next_buckets() {
   s3_log(S3_LOG_DEBUG, request_id, "Fetching bucket list from KV store\n");
   size_t count = BUCKET_KVS_FETCH_COUNT;
 
-  motr_kv_reader =
-      s3_motr_kvs_reader_factory->create_motr_kvs_reader(request, s3_motr_api);
+  if (motr_kv_reader == nullptr) {
+    motr_kv_reader = s3_motr_kvs_reader_factory->create_motr_kvs_cursor(
+        request, s3_motr_api);
+  }
   motr_kv_reader->next_keyval(
       bucket_metadata_list_index_oid, last_key, count,
       std::bind(&S3GetServiceAction::get_next_buckets_successful, this),
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include <algorithm>
+
+#include "s3_hash_worker_pool.h"
+#include "s3_log.h"
+#include "s3_md5_mb.h"
+#include "s3_option.h"
+#include "s3_post_to_main_loop.h"
+
+S3HashWorkerPool *S3HashWorkerPool::instance = NULL;
+
+S3HashStream::S3HashStream(S3HashWorker *hash_worker)
+    : worker(hash_worker), pending_jobs(0), evbase(NULL) {}
+
+void S3HashStream::submit(std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> guard(stream_lock);
+    ++pending_jobs;
+  }
+  worker->add_job({shared_from_this(), std::move(job), NULL, {}});
+}
+
+void S3HashStream::submit_md5(MD5hash *hash, S3BufferSequence buffers) {
+  {
+    std::lock_guard<std::mutex> guard(stream_lock);
+    ++pending_jobs;
+  }
+  worker->add_job({shared_from_this(), nullptr, hash, std::move(buffers)});
+}
+
+bool S3HashStream::is_idle() {
+  std::lock_guard<std::mutex> guard(stream_lock);
+  return pending_jobs == 0;
+}
+
+void S3HashStream::notify_when_idle(std::function<void()> callback) {
+  {
+    std::lock_guard<std::mutex> guard(stream_lock);
+    if (pending_jobs > 0) {
+      on_idle = std::move(callback);
+      evbase = S3Option::get_instance()->get_eventbase();
+      return;
+    }
+  }
+  callback();
+}
+
+void S3HashStream::wait() {
+  std::unique_lock<std::mutex> guard(stream_lock);
+  idle_cond.wait(guard, [this] { return pending_jobs == 0; });
+}
+
+void S3HashStream::cancel() {
+  std::unique_lock<std::mutex> guard(stream_lock);
+  on_idle = nullptr;
+  idle_cond.wait(guard, [this] { return pending_jobs == 0; });
+}
+
+void S3HashStream::job_done() {
+  bool post_to_loop = false;
+  {
+    std::lock_guard<std::mutex> guard(stream_lock);
+    --pending_jobs;
+    if (pending_jobs == 0) {
+      post_to_loop = static_cast<bool>(on_idle);
+      idle_cond.notify_all();
+    }
+  }
+  if (!post_to_loop) {
+    return;
+  }
+  // Keeps the stream alive until the event is handled on the loop.
+  struct user_event_context *user_ctx =
+      (struct user_event_context *)calloc(1, sizeof(struct user_event_context));
+  user_ctx->app_ctx = new std::shared_ptr<S3HashStream>(shared_from_this());
+#ifdef S3_GOOGLE_TEST
+  on_idle_in_loop(0, 0, (void *)user_ctx);
+#else
+  S3PostToMainLoop((void *)user_ctx, evbase)(on_idle_in_loop);
+#endif  // S3_GOOGLE_TEST
+}
+
+void S3HashStream::on_idle_in_loop(evutil_socket_t, short, void *user_data) {
+  struct user_event_context *user_ctx =
+      (struct user_event_context *)user_data;
+  std::shared_ptr<S3HashStream> *stream =
+      (std::shared_ptr<S3HashStream> *)user_ctx->app_ctx;
+  if (user_ctx->user_event) {
+    event_free((struct event *)user_ctx->user_event);
+  }
+  free(user_ctx);
+
+  std::function<void()> callback;
+  {
+    std::lock_guard<std::mutex> guard((*stream)->stream_lock);
+    // More jobs may have been queued meanwhile, the last of them
+    // posts again. The callback is also gone if the owner cancelled.
+    if ((*stream)->pending_jobs == 0) {
+      callback = std::move((*stream)->on_idle);
+      (*stream)->on_idle = nullptr;
+    }
+  }
+  delete stream;
+  if (callback) {
+    callback();
+  }
+}
+
+S3HashWorker::S3HashWorker() : stopping(false) {
+  worker_thread = std::thread(&S3HashWorker::run, this);
+}
+
+S3HashWorker::~S3HashWorker() {
+  {
+    std::lock_guard<std::mutex> guard(queue_lock);
+    stopping = true;
+  }
+  queue_cond.notify_one();
+  worker_thread.join();
+}
+
+void S3HashWorker::add_job(S3HashJob job) {
+  {
+    std::lock_guard<std::mutex> guard(queue_lock);
+    jobs.push_back(std::move(job));
+  }
+  queue_cond.notify_one();
+}
+
+void S3HashWorker::collect_md5_batch(std::vector<S3HashJob> &batch) {
+  // Streams with a job in the batch or still queued ahead of the scan
+  std::vector<S3HashStream *> streams_seen;
+  const size_t max_batch = 2 * S3MD5MultiBuffer::lanes();
+
+  streams_seen.push_back(batch[0].stream.get());
+  for (auto it = jobs.begin(); it != jobs.end() && batch.size() < max_batch;) {
+    S3HashStream *stream = it->stream.get();
+    bool seen = std::find(streams_seen.begin(), streams_seen.end(), stream) !=
+                streams_seen.end();
+    if (!seen) {
+      streams_seen.push_back(stream);
+    }
+    if (!seen && it->md5) {
+      batch.push_back(std::move(*it));
+      it = jobs.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void S3HashWorker::run_md5_batch(std::vector<S3HashJob> &batch) {
+  if (batch.size() == 1) {
+    for (const auto &buf : batch[0].buffers) {
+      batch[0].md5->Update((const char *)buf.first, buf.second);
+    }
+    return;
+  }
+  std::vector<std::pair<MD5hash *, S3BufferSequence>> inputs;
+  inputs.reserve(batch.size());
+  for (auto &job : batch) {
+    inputs.emplace_back(job.md5, std::move(job.buffers));
+  }
+  MD5hash::UpdateMulti(inputs);
+}
+
+void S3HashWorker::run() {
+  std::unique_lock<std::mutex> guard(queue_lock);
+  for (;;) {
+    queue_cond.wait(guard, [this] { return stopping || !jobs.empty(); });
+    if (jobs.empty()) {
+      // Only stop once everything queued has been hashed.
+      break;
+    }
+    std::vector<S3HashJob> batch;
+    batch.push_back(std::move(jobs.front()));
+    jobs.pop_front();
+    if (batch[0].md5 && S3MD5MultiBuffer::lanes() > 1) {
+      collect_md5_batch(batch);
+    }
+    guard.unlock();
+
+    if (batch[0].md5) {
+      run_md5_batch(batch);
+    } else {
+      batch[0].job();
+    }
+    for (auto &job : batch) {
+      job.stream->job_done();
+    }
+    batch.clear();
+
+    guard.lock();
+  }
+}
+
+S3HashWorkerPool::S3HashWorkerPool(unsigned short thread_count)
+    : next_worker(0) {
+  for (unsigned short i = 0; i < thread_count; ++i) {
+    workers.emplace_back(new S3HashWorker());
+  }
+}
+
+int S3HashWorkerPool::create_pool(unsigned short thread_count) {
+  if (instance) {
+    return EEXIST;
+  }
+  if (thread_count == 0) {
+    return EINVAL;
+  }
+  S3MD5MultiBuffer::init();
+  s3_log(S3_LOG_INFO, "",
+         "Starting %d hash worker threads, MD5 engine %s with %zu lanes\n",
+         thread_count, S3MD5MultiBuffer::engine_name(),
+         S3MD5MultiBuffer::lanes());
+  instance = new S3HashWorkerPool(thread_count);
+  return 0;
+}
+
+void S3HashWorkerPool::destroy_instance() {
+  if (instance) {
+    delete instance;
+    instance = NULL;
+  }
+}
+
+std::shared_ptr<S3HashStream> S3HashWorkerPool::create_stream() {
+  size_t index = next_worker++ % workers.size();
+  return std::make_shared<S3HashStream>(workers[index].get());
+}
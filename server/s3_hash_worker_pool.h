@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_HASH_WORKER_POOL_H__
+#define __S3_SERVER_S3_HASH_WORKER_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <event2/event.h>
+#include <gtest/gtest_prod.h>
+
+#include "s3_buffer_sequence.h"
+#include "s3_md5_hash.h"
+
+class S3HashWorker;
+
+// Ordered sequence of hashing jobs, e.g. all MD5 updates of one object.
+// Jobs of a stream always run on the same worker thread in the order they
+// were submitted, so a hash context updated by them stays consistent.
+class S3HashStream : public std::enable_shared_from_this<S3HashStream> {
+  S3HashWorker* worker;
+
+  std::mutex stream_lock;
+  std::condition_variable idle_cond;
+  size_t pending_jobs;
+
+  // Called on 'evbase' once all pending jobs are done.
+  std::function<void()> on_idle;
+  struct event_base* evbase;
+
+  // Called by the worker thread after each job of this stream.
+  void job_done();
+  static void on_idle_in_loop(evutil_socket_t, short, void* user_data);
+
+  friend class S3HashWorker;
+
+ public:
+  explicit S3HashStream(S3HashWorker* hash_worker);
+
+  void submit(std::function<void()> job);
+
+  // Same as submitting hash->Update() of each buffer, but lets the worker
+  // batch it with MD5 jobs of other streams on SIMD lanes.
+  void submit_md5(MD5hash* hash, S3BufferSequence buffers);
+
+  bool is_idle();
+
+  // Runs 'callback' on the calling thread's event loop when all submitted
+  // jobs are done, or right away if nothing is pending.
+  void notify_when_idle(std::function<void()> callback);
+
+  // Blocks until all submitted jobs are done.
+  void wait();
+
+  // Drops the pending idle callback and waits for the jobs in flight,
+  // so the owner can safely go away.
+  void cancel();
+
+  FRIEND_TEST(S3HashWorkerPoolTest, StreamsAreSpreadOverWorkers);
+};
+
+struct S3HashJob {
+  std::shared_ptr<S3HashStream> stream;
+  std::function<void()> job;
+  // Set for MD5 updates instead of 'job'.
+  MD5hash* md5;
+  S3BufferSequence buffers;
+};
+
+class S3HashWorker {
+  std::thread worker_thread;
+  std::mutex queue_lock;
+  std::condition_variable queue_cond;
+  std::deque<S3HashJob> jobs;
+  bool stopping;
+
+  // Moves MD5 jobs of other streams that are next in their stream's order
+  // from the queue into 'batch'.
+  void collect_md5_batch(std::vector<S3HashJob>& batch);
+  void run_md5_batch(std::vector<S3HashJob>& batch);
+  void run();
+
+ public:
+  S3HashWorker();
+  ~S3HashWorker();
+
+  void add_job(S3HashJob job);
+};
+
+// Worker threads computing content hashes (MD5 ETag) off the event loop.
+// The pool is only created when S3_HASH_WORKER_THREADS > 0, otherwise
+// get_instance() returns NULL and callers hash inline.
+class S3HashWorkerPool {
+  std::vector<std::unique_ptr<S3HashWorker>> workers;
+  std::atomic<size_t> next_worker;
+
+  static S3HashWorkerPool* instance;
+
+  explicit S3HashWorkerPool(unsigned short thread_count);
+
+ public:
+  static int create_pool(unsigned short thread_count);
+
+  static S3HashWorkerPool* get_instance() { return instance; }
+
+  // Waits for all queued jobs, then stops and joins the worker threads.
+  static void destroy_instance();
+
+  // Streams are spread over the workers round robin.
+  std::shared_ptr<S3HashStream> create_stream();
+
+  FRIEND_TEST(S3HashWorkerPoolTest, CreateAndDestroyPool);
+};
+
+#endif
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include "s3_json_scanner.h"
+
+S3JsonScanner::S3JsonScanner(const char *data, size_t length)
+    : pos(data), end(data + length), error(false) {}
+
+S3JsonScanner::S3JsonScanner(const std::string &json)
+    : S3JsonScanner(json.data(), json.length()) {}
+
+void S3JsonScanner::skip_whitespace() {
+  while (pos < end &&
+         (*pos == ' ' || *pos == '\t' || *pos == '\n' || *pos == '\r')) {
+    ++pos;
+  }
+}
+
+bool S3JsonScanner::fail() {
+  error = true;
+  return false;
+}
+
+bool S3JsonScanner::enter_object() {
+  if (error) {
+    return false;
+  }
+  skip_whitespace();
+  if (pos == end || *pos != '{') {
+    return fail();
+  }
+  ++pos;
+  return true;
+}
+
+bool S3JsonScanner::next_member(std::string &key) {
+  if (error) {
+    return false;
+  }
+  skip_whitespace();
+  if (pos < end && *pos == ',') {
+    ++pos;
+    skip_whitespace();
+  }
+  if (pos == end) {
+    return fail();
+  }
+  if (*pos == '}') {
+    ++pos;
+    return false;
+  }
+  if (!read_string(key)) {
+    return false;
+  }
+  skip_whitespace();
+  if (pos == end || *pos != ':') {
+    return fail();
+  }
+  ++pos;
+  return true;
+}
+
+bool S3JsonScanner::read_hex4(unsigned &code_point) {
+  if (end - pos < 4) {
+    return fail();
+  }
+  code_point = 0;
+  for (int i = 0; i < 4; ++i, ++pos) {
+    char c = *pos;
+    code_point <<= 4;
+    if (c >= '0' && c <= '9') {
+      code_point |= c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      code_point |= c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      code_point |= c - 'A' + 10;
+    } else {
+      return fail();
+    }
+  }
+  return true;
+}
+
+bool S3JsonScanner::read_string(std::string &value) {
+  if (error) {
+    return false;
+  }
+  skip_whitespace();
+  if (pos == end || *pos != '"') {
+    return fail();
+  }
+  ++pos;
+  value.clear();
+  while (pos < end) {
+    // Copy the run of plain characters in one go.
+    const char *run = pos;
+    while (pos < end && *pos != '"' && *pos != '\\') {
+      ++pos;
+    }
+    value.append(run, pos - run);
+    if (pos == end) {
+      break;
+    }
+    if (*pos == '"') {
+      ++pos;
+      return true;
+    }
+    // Escape sequence
+    if (++pos == end) {
+      break;
+    }
+    char c = *pos++;
+    switch (c) {
+      case '"':
+      case '\\':
+      case '/':
+        value += c;
+        break;
+      case 'b':
+        value += '\b';
+        break;
+      case 'f':
+        value += '\f';
+        break;
+      case 'n':
+        value += '\n';
+        break;
+      case 'r':
+        value += '\r';
+        break;
+      case 't':
+        value += '\t';
+        break;
+      case 'u': {
+        unsigned code_point;
+        if (!read_hex4(code_point)) {
+          return false;
+        }
+        if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+          // High surrogate, must be followed by \u and a low surrogate.
+          unsigned low;
+          if (end - pos < 2 || pos[0] != '\\' || pos[1] != 'u') {
+            return fail();
+          }
+          pos += 2;
+          if (!read_hex4(low) || low < 0xDC00 || low > 0xDFFF) {
+            return fail();
+          }
+          code_point = 0x10000 + ((code_point - 0xD800) << 10) +
+                       (low - 0xDC00);
+        }
+        // UTF-8 encode
+        if (code_point < 0x80) {
+          value += (char)code_point;
+        } else if (code_point < 0x800) {
+          value += (char)(0xC0 | (code_point >> 6));
+          value += (char)(0x80 | (code_point & 0x3F));
+        } else if (code_point < 0x10000) {
+          value += (char)(0xE0 | (code_point >> 12));
+          value += (char)(0x80 | ((code_point >> 6) & 0x3F));
+          value += (char)(0x80 | (code_point & 0x3F));
+        } else {
+          value += (char)(0xF0 | (code_point >> 18));
+          value += (char)(0x80 | ((code_point >> 12) & 0x3F));
+          value += (char)(0x80 | ((code_point >> 6) & 0x3F));
+          value += (char)(0x80 | (code_point & 0x3F));
+        }
+        break;
+      }
+      default:
+        return fail();
+    }
+  }
+  // Unterminated string
+  return fail();
+}
+
+bool S3JsonScanner::skip_string() {
+  // Opening quote is already consumed.
+  while (pos < end) {
+    char c = *pos++;
+    if (c == '"') {
+      return true;
+    }
+    if (c == '\\') {
+      if (pos == end) {
+        break;
+      }
+      ++pos;
+    }
+  }
+  return fail();
+}
+
+bool S3JsonScanner::skip_literal() {
+  const char *start = pos;
+  while (pos < end && *pos != ',' && *pos != '}' && *pos != ']' &&
+         *pos != ' ' && *pos != '\t' && *pos != '\n' && *pos != '\r') {
+    ++pos;
+  }
+  return pos != start || fail();
+}
+
+bool S3JsonScanner::skip_value() {
+  if (error) {
+    return false;
+  }
+  skip_whitespace();
+  if (pos == end) {
+    return fail();
+  }
+  if (*pos == '"') {
+    ++pos;
+    return skip_string();
+  }
+  if (*pos != '{' && *pos != '[') {
+    return skip_literal();
+  }
+  // Object or array, skip up to the matching close.
+  size_t depth = 0;
+  while (pos < end) {
+    char c = *pos++;
+    if (c == '"') {
+      if (!skip_string()) {
+        return false;
+      }
+    } else if (c == '{' || c == '[') {
+      ++depth;
+    } else if (c == '}' || c == ']') {
+      if (--depth == 0) {
+        return true;
+      }
+    }
+  }
+  return fail();
+}
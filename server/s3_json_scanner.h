@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_JSON_SCANNER_H__
+#define __S3_SERVER_S3_JSON_SCANNER_H__
+
+#include <stddef.h>
+#include <string>
+
+// Forward-only reader of a JSON document which decodes only what the caller
+// asks for. Members the caller is not interested in are skipped without
+// building any values, so picking a few fields out of a large document costs
+// a single pass over its bytes and no allocations beyond the strings read.
+//
+// Usage:
+//   S3JsonScanner scanner(json);
+//   std::string key;
+//   if (scanner.enter_object()) {
+//     while (scanner.next_member(key)) {
+//       if (key == "wanted") {
+//         scanner.read_string(value);
+//       } else {
+//         scanner.skip_value();
+//       }
+//     }
+//   }
+//   if (scanner.failed()) { ... }
+class S3JsonScanner {
+  const char *pos;
+  const char *end;
+  bool error;
+
+  void skip_whitespace();
+  bool fail();
+  bool skip_string();
+  bool skip_literal();
+  bool read_hex4(unsigned &code_point);
+
+ public:
+  // The scanned data is not copied and must outlive the scanner.
+  S3JsonScanner(const char *data, size_t length);
+  explicit S3JsonScanner(const std::string &json);
+  S3JsonScanner(std::string &&json) = delete;
+
+  // Consumes the '{' opening an object value.
+  bool enter_object();
+  // Reads the key of the next member of the current object and consumes the
+  // ':' after it. Returns false once the closing '}' is consumed or on error.
+  // The member value must be consumed with read_string(), skip_value() or
+  // enter_object() before the next call.
+  bool next_member(std::string &key);
+  // Decodes a string value, including escape sequences, into 'value'.
+  bool read_string(std::string &value);
+  // Skips any value: string, number, literal, object or array.
+  bool skip_value();
+
+  bool failed() const { return error; }
+};
+
+#endif
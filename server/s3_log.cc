@@ -18,11 +18,43 @@
  *
  */
 
+#include <cstdarg>
+
+#include "s3_async_log.h"
 #include "s3_log.h"
 #include "s3_option.h"
 
 int s3log_level = S3_LOG_INFO;
 s3_fatal_log_handler s3_fatal_handler;
+std::atomic<bool> s3log_async(false);
+
+static S3AsyncLogger *async_logger;
+
+static void write_to_glog(const S3LogRecord &record, const char *text) {
+  google::LogSeverity severity;
+  switch (record.level) {
+    case S3_LOG_WARN:
+      severity = google::GLOG_WARNING;
+      break;
+    case S3_LOG_ERROR:
+    case S3_LOG_FATAL:
+      severity = google::GLOG_ERROR;
+      break;
+    default:
+      severity = google::GLOG_INFO;
+  }
+  google::LogMessage(record.file, record.line, severity)
+      .stream()
+      .write(text, record.text_len);
+}
+
+void s3_log_async(int loglevel, const char *file, int line, const char *fmt,
+                  ...) {
+  va_list args;
+  va_start(args, fmt);
+  async_logger->log(loglevel, file, line, fmt, args);
+  va_end(args);
+}
 
 int init_log(char *process_name) {
   S3Option *option_instance = S3Option::get_instance();
@@ -80,6 +112,32 @@ int init_log(char *process_name) {
   return 0;
 }
 
+int init_async_log() {
+  S3Option *option_instance = S3Option::get_instance();
+  if (!option_instance->is_log_async_enabled()) {
+    return 0;
+  }
+  async_logger = new S3AsyncLogger(
+      option_instance->get_log_async_buffer_size_kb() * 1024, write_to_glog);
+  int rc = async_logger->start();
+  if (rc != 0) {
+    delete async_logger;
+    async_logger = NULL;
+    return rc;
+  }
+  s3log_async = true;
+  return 0;
+}
+
+static void fini_async_log() {
+  if (async_logger) {
+    s3log_async = false;
+    async_logger->stop();
+    delete async_logger;
+    async_logger = NULL;
+  }
+}
+
 void redefine_log_level() {
   S3Option *option_instance = S3Option::get_instance();
   if (option_instance->get_log_level() != "") {
@@ -114,6 +172,7 @@ void redefine_log_level() {
 }
 
 void fini_log() {
+  fini_async_log();
   google::FlushLogFiles(google::GLOG_INFO);
   google::ShutdownGoogleLogging();
 
@@ -121,5 +180,10 @@ void fini_log() {
   closelog();
 }
 
-void flushall_log() { google::FlushLogFiles(google::GLOG_INFO); }
+void flushall_log() {
+  if (s3log_async) {
+    async_logger->flush();
+  }
+  google::FlushLogFiles(google::GLOG_INFO);
+}
 
@@ -22,6 +22,7 @@
 
 #ifndef __S3_SERVER_LOG_H__
 #define __S3_SERVER_LOG_H__
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <glog/logging.h>
@@ -42,6 +43,12 @@ typedef void (*s3_fatal_log_handler)(int);
 extern s3_fatal_log_handler s3_fatal_handler;
 
 extern int s3log_level;
+// Set while messages are written by the writer thread of S3AsyncLogger.
+extern std::atomic<bool> s3log_async;
+
+// Formats a message into the log buffer of the calling thread.
+void s3_log_async(int loglevel, const char* file, int line, const char* fmt,
+                  ...) __attribute__((format(printf, 4, 5)));
 
 inline const char* s3_log_get_req_id(const char* requestid) {
   return (requestid && requestid[0]) ? requestid : S3_DEFAULT_REQID;
@@ -63,23 +70,30 @@ inline const char* s3_log_get_req_id(const std::string& requestid) {
 //    only if S3 log level is set to DEBUG.
 // 2. Logging a FATAL message terminates the program (after the message is
 //    logged).so demote it to ERROR
-#define s3_log(loglevel, requestid, fmt, ...)                    \
-  do {                                                           \
-    if (loglevel >= s3log_level) {                               \
-      char* s3_log_msg__ = nullptr;                              \
-      int s3_log_len__ =                                         \
-          asprintf(&s3_log_msg__, "[Req:%s] " fmt "\n",          \
-                   s3_log_get_req_id(requestid), ##__VA_ARGS__); \
-      if (s3_log_len__ > 0) {                                    \
-        if (s3_log_msg__[s3_log_len__ - 2] == '\n')              \
-          s3_log_msg__[s3_log_len__ - 1] = '\0';                 \
-        s3_log_msg_##loglevel(s3_log_msg__);                     \
-        free(s3_log_msg__);                                      \
-      }                                                          \
-    }                                                            \
-    if (loglevel >= S3_LOG_FATAL) {                              \
-      s3_fatal_handler(1);                                       \
-    }                                                            \
+// 3. With S3_LOG_ASYNC_ENABLED, messages are only formatted by the caller
+//    and written to glog by a background thread.
+#define s3_log(loglevel, requestid, fmt, ...)                          \
+  do {                                                                 \
+    if (loglevel >= s3log_level) {                                     \
+      if (s3log_async.load(std::memory_order_relaxed)) {               \
+        s3_log_async(loglevel, __FILE__, __LINE__, "[Req:%s] " fmt,    \
+                     s3_log_get_req_id(requestid), ##__VA_ARGS__);     \
+      } else {                                                         \
+        char* s3_log_msg__ = nullptr;                                  \
+        int s3_log_len__ =                                             \
+            asprintf(&s3_log_msg__, "[Req:%s] " fmt "\n",              \
+                     s3_log_get_req_id(requestid), ##__VA_ARGS__);     \
+        if (s3_log_len__ > 0) {                                        \
+          if (s3_log_msg__[s3_log_len__ - 2] == '\n')                  \
+            s3_log_msg__[s3_log_len__ - 1] = '\0';                     \
+          s3_log_msg_##loglevel(s3_log_msg__);                         \
+          free(s3_log_msg__);                                          \
+        }                                                              \
+      }                                                                \
+    }                                                                  \
+    if (loglevel >= S3_LOG_FATAL) {                                    \
+      s3_fatal_handler(1);                                             \
+    }                                                                  \
   } while (0)
 
 // Note:
@@ -109,6 +123,8 @@ static inline std::string s3_get_timestamp() {
 }
 
 int init_log(char *process_name);
+// Starts asynchronous logging when enabled, after the daemon has forked.
+int init_async_log();
 void redefine_log_level();
 void fini_log();
 void flushall_log();
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_LRU_CACHE_H__
+#define __S3_SERVER_S3_LRU_CACHE_H__
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// LRU cache of shared immutable values whose entries expire after a TTL.
+// It is not thread safe, owners shared by several threads serialize calls
+// with their own lock.
+template <typename Value>
+class S3LruCache {
+  struct cache_entry {
+    std::shared_ptr<const Value> value;
+    std::chrono::steady_clock::time_point expires_at;
+    std::list<std::string>::iterator lru_pos;
+  };
+
+  // Most recently used key first
+  std::list<std::string> lru_list;
+  std::unordered_map<std::string, cache_entry> entries;
+
+  size_t max_entries;
+  std::chrono::milliseconds ttl;
+
+  void erase(typename std::unordered_map<std::string, cache_entry>::iterator
+                 it) {
+    lru_list.erase(it->second.lru_pos);
+    entries.erase(it);
+  }
+
+ public:
+  S3LruCache(size_t max_entries, unsigned int ttl_millisec)
+      : max_entries(max_entries), ttl(ttl_millisec) {}
+
+  bool is_enabled() const {
+    return max_entries > 0 && ttl > std::chrono::milliseconds::zero();
+  }
+
+  // Returns nullptr when the key is not cached or its entry expired.
+  std::shared_ptr<const Value> get(const std::string& key) {
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+      return nullptr;
+    }
+    if (std::chrono::steady_clock::now() >= it->second.expires_at) {
+      erase(it);
+      return nullptr;
+    }
+    lru_list.splice(lru_list.begin(), lru_list, it->second.lru_pos);
+    return it->second.value;
+  }
+
+  // Replaces the entry of 'key', evicting least recently used entries
+  // when the cache is full.
+  void put(const std::string& key, std::shared_ptr<const Value> value) {
+    if (!is_enabled()) {
+      return;
+    }
+    erase(key);
+    while (entries.size() >= max_entries) {
+      erase(entries.find(lru_list.back()));
+    }
+    lru_list.push_front(key);
+    entries[key] = {std::move(value), std::chrono::steady_clock::now() + ttl,
+                    lru_list.begin()};
+  }
+
+  void erase(const std::string& key) {
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+      erase(it);
+    }
+  }
+
+  void clear() {
+    lru_list.clear();
+    entries.clear();
+  }
+
+  size_t size() const { return entries.size(); }
+};
+
+#endif
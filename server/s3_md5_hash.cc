@@ -18,9 +18,14 @@
  *
  */
 
+#include <stdint.h>
+
+#include <algorithm>
+
 #include "base64.h"
 
 #include "s3_md5_hash.h"
+#include "s3_md5_mb.h"
 
 MD5hash::MD5hash() { status = MD5_Init(&md5ctx); }
 
@@ -51,6 +56,134 @@ int MD5hash::Finalize() {
   return 0;
 }
 
+size_t MD5hash::feed_until_full_blocks(const S3BufferSequence &buffers,
+                                       size_t &buf_idx, size_t &offset,
+                                       const unsigned char **blocks_at) {
+  while (buf_idx < buffers.size()) {
+    const char *buf = (const char *)buffers[buf_idx].first;
+    const size_t buf_len = buffers[buf_idx].second;
+    size_t len = buf_len - offset;
+
+    if (status > 0 && md5ctx.num == 0 && len >= MD5_CBLOCK) {
+      *blocks_at = (const unsigned char *)buf + offset;
+      return len / MD5_CBLOCK;
+    }
+    if (md5ctx.num != 0 && len > MD5_CBLOCK - md5ctx.num) {
+      // Only complete the block OpenSSL holds.
+      len = MD5_CBLOCK - md5ctx.num;
+    }
+    if (len > 0) {
+      Update(buf + offset, len);
+    }
+    offset += len;
+    if (offset == buf_len) {
+      ++buf_idx;
+      offset = 0;
+    }
+  }
+  return 0;
+}
+
+void MD5hash::add_hashed_blocks(size_t blocks) {
+  // Nh:Nl is the 64 bit count of bits hashed so far
+  uint64_t bits = ((uint64_t)md5ctx.Nh << 32) | md5ctx.Nl;
+  bits += (uint64_t)blocks * MD5_CBLOCK * 8;
+  md5ctx.Nl = (MD5_LONG)bits;
+  md5ctx.Nh = (MD5_LONG)(bits >> 32);
+}
+
+void MD5hash::UpdateMulti(
+    std::vector<std::pair<MD5hash *, S3BufferSequence>> &inputs) {
+  const size_t lanes = S3MD5MultiBuffer::lanes();
+
+  if (lanes < 2 || inputs.size() < 2) {
+    for (auto &input : inputs) {
+      for (auto &buf : input.second) {
+        input.first->Update((const char *)buf.first, buf.second);
+      }
+    }
+    return;
+  }
+
+  struct md5_lane {
+    MD5hash *hash;
+    const S3BufferSequence *buffers;
+    size_t buf_idx;
+    size_t offset;
+    const unsigned char *data;
+    size_t blocks;
+  };
+  std::vector<md5_lane> active;
+  uint32_t states[S3_MD5_MB_MAX_LANES][4];
+  const unsigned char *data[S3_MD5_MB_MAX_LANES];
+  size_t next_input = 0;
+
+  active.reserve(lanes);
+  for (;;) {
+    while (active.size() < lanes && next_input < inputs.size()) {
+      md5_lane lane = {inputs[next_input].first, &inputs[next_input].second,
+                       0, 0, NULL, 0};
+      ++next_input;
+      lane.blocks = lane.hash->feed_until_full_blocks(
+          *lane.buffers, lane.buf_idx, lane.offset, &lane.data);
+      if (lane.blocks > 0) {
+        active.push_back(lane);
+      }
+    }
+    if (active.empty()) {
+      break;
+    }
+    if (active.size() == 1) {
+      // Nothing left to interleave with, finish it on the scalar path.
+      md5_lane &lane = active[0];
+      for (size_t i = lane.buf_idx; i < lane.buffers->size(); ++i) {
+        const size_t skip = (i == lane.buf_idx) ? lane.offset : 0;
+        lane.hash->Update((const char *)(*lane.buffers)[i].first + skip,
+                          (*lane.buffers)[i].second - skip);
+      }
+      active.clear();
+      continue;
+    }
+
+    // Run all lanes for as long as the shortest one has whole blocks,
+    // padding unused lanes with a copy of the first one.
+    size_t blocks = active[0].blocks;
+    for (size_t i = 0; i < lanes; ++i) {
+      const md5_lane &lane = active[i < active.size() ? i : 0];
+      if (lane.blocks < blocks) {
+        blocks = lane.blocks;
+      }
+      states[i][0] = lane.hash->md5ctx.A;
+      states[i][1] = lane.hash->md5ctx.B;
+      states[i][2] = lane.hash->md5ctx.C;
+      states[i][3] = lane.hash->md5ctx.D;
+      data[i] = lane.data;
+    }
+    S3MD5MultiBuffer::compress(states, data, blocks);
+
+    for (size_t i = 0; i < active.size(); ++i) {
+      md5_lane &lane = active[i];
+      lane.hash->md5ctx.A = states[i][0];
+      lane.hash->md5ctx.B = states[i][1];
+      lane.hash->md5ctx.C = states[i][2];
+      lane.hash->md5ctx.D = states[i][3];
+      lane.hash->add_hashed_blocks(blocks);
+      lane.data += blocks * MD5_CBLOCK;
+      lane.offset += blocks * MD5_CBLOCK;
+      lane.blocks -= blocks;
+      if (lane.blocks == 0) {
+        lane.blocks = lane.hash->feed_until_full_blocks(
+            *lane.buffers, lane.buf_idx, lane.offset, &lane.data);
+      }
+    }
+    active.erase(std::remove_if(active.begin(), active.end(),
+                                [](const md5_lane &lane) {
+                                  return lane.blocks == 0;
+                                }),
+                 active.end());
+  }
+}
+
 const char hex_tbl[] = "0123456789abcdef";
 
 std::string MD5hash::get_md5_string() {
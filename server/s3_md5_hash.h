@@ -24,20 +24,40 @@
 #define __S3_SERVER_S3_MD5_HASH_H__
 
 #include <string>
+#include <utility>
+#include <vector>
 #include <gtest/gtest_prod.h>
 #include <openssl/md5.h>
 
+#include "s3_buffer_sequence.h"
+
 class MD5hash {
   MD5_CTX md5ctx;
   unsigned char md5_digest[MD5_DIGEST_LENGTH];
   int status;
   bool is_finalized = false;
 
+  // Hashes leading partial blocks of 'buffers' from (buf_idx, offset) on,
+  // stopping at the next run of whole blocks, which is returned through
+  // 'blocks_at'. Returns the number of blocks in the run, 0 at the end.
+  size_t feed_until_full_blocks(const S3BufferSequence &buffers,
+                                size_t &buf_idx, size_t &offset,
+                                const unsigned char **blocks_at);
+  // Accounts for blocks transformed outside of OpenSSL.
+  void add_hashed_blocks(size_t blocks);
+
  public:
   MD5hash();
   int Update(const char *input, size_t length);
   int Finalize();
 
+  // Updates several independent hashes, each with its own buffers, as if
+  // Update() was called for every buffer in order. Streams are interleaved
+  // on the lanes of S3MD5MultiBuffer when the CPU allows it.
+  // A hash must not appear more than once in 'inputs'.
+  static void UpdateMulti(
+      std::vector<std::pair<MD5hash *, S3BufferSequence>> &inputs);
+
   std::string get_md5_string();
   std::string get_md5_base64enc_string();
 
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <string.h>
+
+#include "s3_md5_mb.h"
+
+#define MD5_F(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define MD5_G(x, y, z) ((y) ^ ((z) & ((x) ^ (y))))
+#define MD5_H(x, y, z) ((x) ^ (y) ^ (z))
+#define MD5_I(x, y, z) ((y) ^ ((x) | ~(z)))
+
+#define MD5_STEP(f, a, b, c, d, m, k, s)      \
+  do {                                        \
+    (a) += f((b), (c), (d)) + (m) + (k);      \
+    (a) = ((a) << (s)) | ((a) >> (32 - (s))); \
+    (a) += (b);                               \
+  } while (0)
+
+// Vector types are used through macros and always_inline templates only,
+// so each engine is compiled with the instruction set of its caller.
+template <typename V, size_t N>
+static inline __attribute__((always_inline)) void md5_mb_compress(
+    uint32_t (*states)[4], const unsigned char *data[], size_t blocks) {
+  V a, b, c, d;
+  const unsigned char *ptr[N];
+
+  for (size_t l = 0; l < N; ++l) {
+    a[l] = states[l][0];
+    b[l] = states[l][1];
+    c[l] = states[l][2];
+    d[l] = states[l][3];
+    ptr[l] = data[l];
+  }
+
+  for (size_t blk = 0; blk < blocks; ++blk) {
+    V m[16];
+    // Transpose: word w of every lane goes to m[w].
+    for (size_t l = 0; l < N; ++l) {
+      uint32_t words[16];
+      memcpy(words, ptr[l], sizeof(words));
+      for (size_t w = 0; w < 16; ++w) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        m[w][l] = __builtin_bswap32(words[w]);
+#else
+        m[w][l] = words[w];
+#endif
+      }
+      ptr[l] += 64;
+    }
+
+    const V aa = a, bb = b, cc = c, dd = d;
+
+    MD5_STEP(MD5_F, a, b, c, d, m[0], 0xd76aa478, 7);
+    MD5_STEP(MD5_F, d, a, b, c, m[1], 0xe8c7b756, 12);
+    MD5_STEP(MD5_F, c, d, a, b, m[2], 0x242070db, 17);
+    MD5_STEP(MD5_F, b, c, d, a, m[3], 0xc1bdceee, 22);
+    MD5_STEP(MD5_F, a, b, c, d, m[4], 0xf57c0faf, 7);
+    MD5_STEP(MD5_F, d, a, b, c, m[5], 0x4787c62a, 12);
+    MD5_STEP(MD5_F, c, d, a, b, m[6], 0xa8304613, 17);
+    MD5_STEP(MD5_F, b, c, d, a, m[7], 0xfd469501, 22);
+    MD5_STEP(MD5_F, a, b, c, d, m[8], 0x698098d8, 7);
+    MD5_STEP(MD5_F, d, a, b, c, m[9], 0x8b44f7af, 12);
+    MD5_STEP(MD5_F, c, d, a, b, m[10], 0xffff5bb1, 17);
+    MD5_STEP(MD5_F, b, c, d, a, m[11], 0x895cd7be, 22);
+    MD5_STEP(MD5_F, a, b, c, d, m[12], 0x6b901122, 7);
+    MD5_STEP(MD5_F, d, a, b, c, m[13], 0xfd987193, 12);
+    MD5_STEP(MD5_F, c, d, a, b, m[14], 0xa679438e, 17);
+    MD5_STEP(MD5_F, b, c, d, a, m[15], 0x49b40821, 22);
+
+    MD5_STEP(MD5_G, a, b, c, d, m[1], 0xf61e2562, 5);
+    MD5_STEP(MD5_G, d, a, b, c, m[6], 0xc040b340, 9);
+    MD5_STEP(MD5_G, c, d, a, b, m[11], 0x265e5a51, 14);
+    MD5_STEP(MD5_G, b, c, d, a, m[0], 0xe9b6c7aa, 20);
+    MD5_STEP(MD5_G, a, b, c, d, m[5], 0xd62f105d, 5);
+    MD5_STEP(MD5_G, d, a, b, c, m[10], 0x02441453, 9);
+    MD5_STEP(MD5_G, c, d, a, b, m[15], 0xd8a1e681, 14);
+    MD5_STEP(MD5_G, b, c, d, a, m[4], 0xe7d3fbc8, 20);
+    MD5_STEP(MD5_G, a, b, c, d, m[9], 0x21e1cde6, 5);
+    MD5_STEP(MD5_G, d, a, b, c, m[14], 0xc33707d6, 9);
+    MD5_STEP(MD5_G, c, d, a, b, m[3], 0xf4d50d87, 14);
+    MD5_STEP(MD5_G, b, c, d, a, m[8], 0x455a14ed, 20);
+    MD5_STEP(MD5_G, a, b, c, d, m[13], 0xa9e3e905, 5);
+    MD5_STEP(MD5_G, d, a, b, c, m[2], 0xfcefa3f8, 9);
+    MD5_STEP(MD5_G, c, d, a, b, m[7], 0x676f02d9, 14);
+    MD5_STEP(MD5_G, b, c, d, a, m[12], 0x8d2a4c8a, 20);
+
+    MD5_STEP(MD5_H, a, b, c, d, m[5], 0xfffa3942, 4);
+    MD5_STEP(MD5_H, d, a, b, c, m[8], 0x8771f681, 11);
+    MD5_STEP(MD5_H, c, d, a, b, m[11], 0x6d9d6122, 16);
+    MD5_STEP(MD5_H, b, c, d, a, m[14], 0xfde5380c, 23);
+    MD5_STEP(MD5_H, a, b, c, d, m[1], 0xa4beea44, 4);
+    MD5_STEP(MD5_H, d, a, b, c, m[4], 0x4bdecfa9, 11);
+    MD5_STEP(MD5_H, c, d, a, b, m[7], 0xf6bb4b60, 16);
+    MD5_STEP(MD5_H, b, c, d, a, m[10], 0xbebfbc70, 23);
+    MD5_STEP(MD5_H, a, b, c, d, m[13], 0x289b7ec6, 4);
+    MD5_STEP(MD5_H, d, a, b, c, m[0], 0xeaa127fa, 11);
+    MD5_STEP(MD5_H, c, d, a, b, m[3], 0xd4ef3085, 16);
+    MD5_STEP(MD5_H, b, c, d, a, m[6], 0x04881d05, 23);
+    MD5_STEP(MD5_H, a, b, c, d, m[9], 0xd9d4d039, 4);
+    MD5_STEP(MD5_H, d, a, b, c, m[12], 0xe6db99e5, 11);
+    MD5_STEP(MD5_H, c, d, a, b, m[15], 0x1fa27cf8, 16);
+    MD5_STEP(MD5_H, b, c, d, a, m[2], 0xc4ac5665, 23);
+
+    MD5_STEP(MD5_I, a, b, c, d, m[0], 0xf4292244, 6);
+    MD5_STEP(MD5_I, d, a, b, c, m[7], 0x432aff97, 10);
+    MD5_STEP(MD5_I, c, d, a, b, m[14], 0xab9423a7, 15);
+    MD5_STEP(MD5_I, b, c, d, a, m[5], 0xfc93a039, 21);
+    MD5_STEP(MD5_I, a, b, c, d, m[12], 0x655b59c3, 6);
+    MD5_STEP(MD5_I, d, a, b, c, m[3], 0x8f0ccc92, 10);
+    MD5_STEP(MD5_I, c, d, a, b, m[10], 0xffeff47d, 15);
+    MD5_STEP(MD5_I, b, c, d, a, m[1], 0x85845dd1, 21);
+    MD5_STEP(MD5_I, a, b, c, d, m[8], 0x6fa87e4f, 6);
+    MD5_STEP(MD5_I, d, a, b, c, m[15], 0xfe2ce6e0, 10);
+    MD5_STEP(MD5_I, c, d, a, b, m[6], 0xa3014314, 15);
+    MD5_STEP(MD5_I, b, c, d, a, m[13], 0x4e0811a1, 21);
+    MD5_STEP(MD5_I, a, b, c, d, m[4], 0xf7537e82, 6);
+    MD5_STEP(MD5_I, d, a, b, c, m[11], 0xbd3af235, 10);
+    MD5_STEP(MD5_I, c, d, a, b, m[2], 0x2ad7d2bb, 15);
+    MD5_STEP(MD5_I, b, c, d, a, m[9], 0xeb86d391, 21);
+
+    a += aa;
+    b += bb;
+    c += cc;
+    d += dd;
+  }
+
+  for (size_t l = 0; l < N; ++l) {
+    states[l][0] = a[l];
+    states[l][1] = b[l];
+    states[l][2] = c[l];
+    states[l][3] = d[l];
+  }
+}
+
+#if defined(__x86_64__)
+typedef uint32_t md5_v4u32 __attribute__((vector_size(16)));
+typedef uint32_t md5_v8u32 __attribute__((vector_size(32)));
+
+static void md5_mb_compress_sse2(uint32_t (*states)[4],
+                                 const unsigned char *data[], size_t blocks) {
+  md5_mb_compress<md5_v4u32, 4>(states, data, blocks);
+}
+
+__attribute__((target("avx2"))) static void md5_mb_compress_avx2(
+    uint32_t (*states)[4], const unsigned char *data[], size_t blocks) {
+  md5_mb_compress<md5_v8u32, 8>(states, data, blocks);
+}
+
+#if __GNUC__ >= 5
+#define S3_MD5_MB_AVX512
+typedef uint32_t md5_v16u32 __attribute__((vector_size(64)));
+
+__attribute__((target("avx512f"))) static void md5_mb_compress_avx512(
+    uint32_t (*states)[4], const unsigned char *data[], size_t blocks) {
+  md5_mb_compress<md5_v16u32, 16>(states, data, blocks);
+}
+#endif  // __GNUC__ >= 5
+#endif  // __x86_64__
+
+S3MD5MultiBuffer::compress_fn S3MD5MultiBuffer::engine = NULL;
+size_t S3MD5MultiBuffer::engine_lanes = 1;
+const char *S3MD5MultiBuffer::name = "scalar";
+
+void S3MD5MultiBuffer::init() {
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+#ifdef S3_MD5_MB_AVX512
+  if (__builtin_cpu_supports("avx512f")) {
+    engine = md5_mb_compress_avx512;
+    engine_lanes = 16;
+    name = "avx512";
+    return;
+  }
+#endif
+  if (__builtin_cpu_supports("avx2")) {
+    engine = md5_mb_compress_avx2;
+    engine_lanes = 8;
+    name = "avx2";
+    return;
+  }
+  // SSE2 is part of x86_64
+  engine = md5_mb_compress_sse2;
+  engine_lanes = 4;
+  name = "sse2";
+#else
+  use_scalar();
+#endif  // __x86_64__
+}
+
+void S3MD5MultiBuffer::use_scalar() {
+  engine = NULL;
+  engine_lanes = 1;
+  name = "scalar";
+}
+
+size_t S3MD5MultiBuffer::lanes() { return engine_lanes; }
+
+const char *S3MD5MultiBuffer::engine_name() { return name; }
+
+void S3MD5MultiBuffer::compress(uint32_t (*states)[4],
+                                const unsigned char *data[], size_t blocks) {
+  engine(states, data, blocks);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_MD5_MB_H__
+#define __S3_SERVER_S3_MD5_MB_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Widest engine: AVX-512, 16 x 32 bit lanes
+#define S3_MD5_MB_MAX_LANES 16
+
+// Multi-buffer MD5 block engine.
+// MD5 of a single stream cannot be parallelised, but independent streams
+// can: lane i of a SIMD register carries the state of stream i, so one
+// pass over the 64 MD5 steps advances 4, 8 or 16 streams at once.
+// The widest engine supported by the CPU is picked at startup; when no
+// vector engine is usable lanes() is 1 and callers should keep using the
+// scalar OpenSSL MD5 path.
+class S3MD5MultiBuffer {
+ public:
+  typedef void (*compress_fn)(uint32_t (*states)[4],
+                              const unsigned char *data[], size_t blocks);
+
+ private:
+  static compress_fn engine;
+  static size_t engine_lanes;
+  static const char *name;
+
+ public:
+  // Checks CPUID and selects the engine. Safe to call more than once.
+  static void init();
+
+  // Allows to force the scalar path, e.g. to compare both in benchmarks.
+  static void use_scalar();
+
+  static size_t lanes();
+  static const char *engine_name();
+
+  // Runs 'blocks' MD5 transforms on each of lanes() streams. states[i]
+  // holds A, B, C, D of stream i, data[i] points to its 'blocks' * 64
+  // bytes of input. Every lane must be set; duplicate an active lane's
+  // pointers to pad unused ones.
+  static void compress(uint32_t (*states)[4], const unsigned char *data[],
+                       size_t blocks);
+};
+
+#endif
@@ -18,11 +18,13 @@
  *
  */
 
+#include <cstdint>
+
 #include "s3_mem_pool_manager.h"
 
 S3MempoolManager *S3MempoolManager::instance = NULL;
 
-size_t S3MempoolManager::free_space = 0;
+std::atomic<size_t> S3MempoolManager::free_space(0);
 
 extern "C" size_t mem_get_free_space_func() {
   return S3MempoolManager::free_space;
@@ -169,6 +171,17 @@ int S3MempoolManager::release_buffer_for_unit_size(void *buf,
   return S3_MEMPOOL_ERROR;
 }
 
+void S3MempoolManager::release_buffer_by_ref(const void *buf, size_t length,
+                                             void *extra) {
+  size_t unit_size = (size_t)(uintptr_t)extra;
+  s3_log(S3_LOG_DEBUG, "", "%s Entry with unit_size[%zu]\n", __func__,
+         unit_size);
+  // Connections may release their data after pools are gone on shutdown.
+  if (instance != NULL) {
+    instance->release_buffer_for_unit_size(const_cast<void *>(buf), unit_size);
+  }
+}
+
 size_t S3MempoolManager::get_free_space_for(size_t unit_size) {
   auto item = pool_of_mem_pool.find(unit_size);
   if (item != pool_of_mem_pool.end()) {
@@ -182,6 +195,8 @@ size_t S3MempoolManager::get_free_space_for(size_t unit_size) {
 }
 
 bool S3MempoolManager::free_any_unused() {
+  // Threads short of memory would otherwise downsize the same pool at once.
+  std::lock_guard<std::mutex> guard(downsize_lock);
   // <non_zero free_space, handle>
   std::map<size_t, MemoryPoolHandle> free_space_map;
 
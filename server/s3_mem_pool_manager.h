@@ -23,7 +23,9 @@
 #ifndef __S3_SERVER_S3_MEM_POOL_MANAGER_H__
 #define __S3_SERVER_S3_MEM_POOL_MANAGER_H__
 
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <vector>
 
 #include <gtest/gtest_prod.h>
@@ -34,7 +36,10 @@
 // Pool of memory pools specifically for use of different unit_size buffers
 class S3MempoolManager {
   // map<unit_size, memory_pool_for_unit_size>
+  // Filled by initialize() only, so it is read without lock by threads.
   std::map<size_t, MemoryPoolHandle> pool_of_mem_pool;
+  // Serialises downsizing of pools by free_any_unused()
+  std::mutex downsize_lock;
 
   // map<unit_size, last_used_timestamp>
   std::map<size_t, size_t> last_used_timestamp;
@@ -57,7 +62,8 @@ class S3MempoolManager {
  public:
   // initially equal to total_memory_threshold
   // static so C callback passed to mempool can access this
-  static size_t free_space;
+  // Atomic as pools, each with its own lock, share it across threads.
+  static std::atomic<size_t> free_space;
 
   //  Return the buffer of give unit_size
   // For flags see mempool_getbuffer() in s3_memory_pool.h header
@@ -67,6 +73,11 @@ class S3MempoolManager {
   // proper unit_size else it will have **UNEXPECTED BEHAVIOR**
   int release_buffer_for_unit_size(void* buf, size_t unit_size);
 
+  // Cleanup callback for buffers lent out by reference, e.g. to libevent
+  // with evbuffer_add_reference(). 'extra' holds unit_size of the buffer.
+  static void release_buffer_by_ref(const void* buf, size_t length,
+                                    void* extra);
+
   size_t get_free_space_for(size_t unit_size);
 
   // Free any mempool that has max free space, free it by half
@@ -112,6 +123,7 @@ class S3MempoolManager {
   FRIEND_TEST(S3MempoolManagerTestSuite, CreateEXISTSTest);
   FRIEND_TEST(S3MempoolManagerTestSuite, PoolShouldGrowAndErrorOnMax);
   FRIEND_TEST(S3MempoolManagerTestSuite, PoolShouldGrowByDownsizingUnusedPool);
+  FRIEND_TEST(S3MempoolManagerTestSuite, ReleaseBufferByRefTest);
 };
 
 #endif
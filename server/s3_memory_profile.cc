@@ -22,6 +22,7 @@
 
 #include "s3_motr_layout.h"
 #include "s3_log.h"
+#include "s3_mem_pool_manager.h"
 #include "s3_memory_pool.h"
 #include "s3_memory_profile.h"
 #include "s3_option.h"
@@ -49,6 +50,37 @@ bool S3MemoryProfile::we_have_enough_memory_for_put_obj(int layout_id) {
   return (free_space_in_libevent_mempool > min_mem_for_put_obj);
 }
 
+bool S3MemoryProfile::we_have_enough_free_memory(size_t memory) {
+#ifdef S3_GOOGLE_TEST
+  return true;
+#endif
+  size_t free_space_in_libevent_mempool = 0;
+  event_mempool_free_space(&free_space_in_libevent_mempool);
+  return free_space_in_libevent_mempool > memory &&
+         free_memory_in_pool_above_threshold_limits();
+}
+
+bool S3MemoryProfile::we_have_enough_memory_for_read_ahead(int layout_id,
+                                                           size_t units) {
+#ifdef S3_GOOGLE_TEST
+  return true;
+#endif
+  size_t unit_size =
+      S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(layout_id);
+  size_t free_space_in_motr_read_mempool =
+      S3MempoolManager::get_instance()->get_free_space_for(unit_size);
+  s3_log(S3_LOG_DEBUG, "", "free_space_in_motr_read_mempool = %zu\n",
+         free_space_in_motr_read_mempool);
+
+  size_t min_mem_for_read_ahead =
+      (units + g_option_instance->get_motr_units_per_request()) * unit_size;
+
+  s3_log(S3_LOG_DEBUG, "", "min_mem_for_read_ahead = %zu\n",
+         min_mem_for_read_ahead);
+
+  return (free_space_in_motr_read_mempool > min_mem_for_read_ahead);
+}
+
 bool S3MemoryProfile::free_memory_in_pool_above_threshold_limits() {
 #ifdef S3_GOOGLE_TEST
   return true;
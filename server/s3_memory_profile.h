@@ -24,14 +24,21 @@
 #define __S3_SERVER_S3_MEMORY_PROFILE_H__
 
 class S3MemoryProfile {
-  size_t memory_per_put_request(int layout_id);
-
  public:
+  size_t memory_per_put_request(int layout_id);
   // Returns true if we have enough memory in mempool to process
   // either put request. Get request we just reject when we run
   // out of memory, memory pool manager is dynamic and free space
   // blocked by less used unit_size, so we cannot get accurate estimate
   virtual bool we_have_enough_memory_for_put_obj(int layout_id);
+  // Returns true if libevent mempool has more than 'memory' free and stays
+  // above its reserve limits.
+  virtual bool we_have_enough_free_memory(size_t memory);
+  // Returns true if motr read mempool can serve one more read of 'units'
+  // blocks for layout and still leave a full read for other requests.
+  // Used to bound read-ahead of get requests.
+  virtual bool we_have_enough_memory_for_read_ahead(int layout_id,
+                                                    size_t units);
   virtual bool free_memory_in_pool_above_threshold_limits();
 };
 
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include "s3_metadata_codec.h"
+
+#include <json/json.h>
+
+#include "base64.h"
+
+namespace {
+
+enum class FieldKind {
+  string,
+  integer,
+  map,
+  // Raw bytes, base64 encoded in JSON
+  bytes
+};
+
+struct FieldInfo {
+  const char *json_name;
+  FieldKind kind;
+};
+
+// Indexed by S3MetadataField
+const FieldInfo field_info[] = {
+    {nullptr, FieldKind::string},
+    {"Bucket-Name", FieldKind::string},
+    {"Object-Name", FieldKind::string},
+    {"Object-URI", FieldKind::string},
+    {"layout_id", FieldKind::integer},
+    {"Upload-ID", FieldKind::string},
+    {"motr_part_oid", FieldKind::string},
+    {"motr_old_oid", FieldKind::string},
+    {"old_layout_id", FieldKind::integer},
+    {"motr_old_object_version_id", FieldKind::string},
+    {"motr_oid", FieldKind::string},
+    {"inline_data", FieldKind::bytes},
+    {"System-Defined", FieldKind::map},
+    {"User-Defined", FieldKind::map},
+    {"User-Defined-Tags", FieldKind::map},
+    {"ACL", FieldKind::bytes},
+    {"create_timestamp", FieldKind::string},
+    {"Policy", FieldKind::bytes},
+    {"motr_object_list_index_oid", FieldKind::string},
+    {"motr_multipart_index_oid", FieldKind::string},
+    {"motr_objects_version_list_index_oid", FieldKind::string},
+    {"ACL", FieldKind::string},
+    {"inline_data", FieldKind::string},
+};
+
+static_assert(sizeof(field_info) / sizeof(field_info[0]) ==
+                  (size_t)S3MetadataField::max_field,
+              "field_info must describe every S3MetadataField");
+
+size_t varint_length(uint64_t value) {
+  size_t length = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++length;
+  }
+  return length;
+}
+
+}  // namespace
+
+bool s3_is_binary_metadata(const std::string &record) {
+  return !record.empty() && record[0] == '\0';
+}
+
+bool s3_binary_metadata_to_json(const std::string &record, std::string &json) {
+  S3MetadataDecoder decoder(record);
+  Json::Value root;
+  S3MetadataField field;
+  std::string value;
+  int64_t number;
+  std::map<std::string, std::string> map_value;
+
+  while (decoder.next_field(field)) {
+    if (field >= S3MetadataField::max_field) {
+      decoder.skip_field();
+      continue;
+    }
+    const FieldInfo &info = field_info[(size_t)field];
+    switch (info.kind) {
+      case FieldKind::string:
+        if (decoder.read_string(value)) {
+          root[info.json_name] = value;
+        }
+        break;
+      case FieldKind::integer:
+        if (decoder.read_integer(number)) {
+          root[info.json_name] = (Json::Int64)number;
+        }
+        break;
+      case FieldKind::map:
+        map_value.clear();
+        if (decoder.read_map(map_value)) {
+          Json::Value &members = root[info.json_name];
+          for (const auto &kv : map_value) {
+            members[kv.first] = kv.second;
+          }
+        }
+        break;
+      case FieldKind::bytes:
+        if (decoder.read_base64(value)) {
+          root[info.json_name] = value;
+        }
+        break;
+    }
+  }
+  if (decoder.failed()) {
+    return false;
+  }
+  Json::FastWriter writer;
+  json = writer.write(root);
+  return true;
+}
+
+S3MetadataEncoder::S3MetadataEncoder(std::string &out, S3MetadataRecord type)
+    : record(out) {
+  record.clear();
+  record += '\0';
+  record += (char)type;
+  record += (char)S3_METADATA_FORMAT_VERSION;
+}
+
+void S3MetadataEncoder::add_varint(uint64_t value) {
+  while (value >= 0x80) {
+    record += (char)(0x80 | (value & 0x7F));
+    value >>= 7;
+  }
+  record += (char)value;
+}
+
+void S3MetadataEncoder::add_header(S3MetadataField field, size_t length) {
+  add_varint((uint64_t)field);
+  add_varint(length);
+}
+
+void S3MetadataEncoder::add_string(S3MetadataField field,
+                                   const std::string &value) {
+  add_header(field, value.length());
+  record += value;
+}
+
+void S3MetadataEncoder::add_integer(S3MetadataField field, int64_t value) {
+  // Zigzag, so small negative values stay short.
+  uint64_t zigzag = ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+  add_header(field, varint_length(zigzag));
+  add_varint(zigzag);
+}
+
+void S3MetadataEncoder::add_map(
+    S3MetadataField field, const std::map<std::string, std::string> &value) {
+  size_t length = 0;
+  for (const auto &kv : value) {
+    length += varint_length(kv.first.length()) + kv.first.length() +
+              varint_length(kv.second.length()) + kv.second.length();
+  }
+  add_header(field, length);
+  for (const auto &kv : value) {
+    add_varint(kv.first.length());
+    record += kv.first;
+    add_varint(kv.second.length());
+    record += kv.second;
+  }
+}
+
+void S3MetadataEncoder::add_bytes(S3MetadataField field,
+                                  const std::string &value) {
+  add_string(field, value);
+}
+
+void S3MetadataEncoder::add_base64(S3MetadataField field,
+                                   S3MetadataField as_stored,
+                                   const std::string &encoded) {
+  std::string decoded = base64_decode(encoded);
+  if (base64_encode((const unsigned char *)decoded.data(), decoded.length()) ==
+      encoded) {
+    add_bytes(field, decoded);
+  } else {
+    add_string(as_stored, encoded);
+  }
+}
+
+S3MetadataDecoder::S3MetadataDecoder(const std::string &record)
+    : pos(record.data()),
+      end(record.data() + record.length()),
+      field_end(pos),
+      type(S3MetadataRecord::object),
+      error(false) {
+  if (record.length() < 3 || record[0] != '\0' ||
+      (record[1] != (char)S3MetadataRecord::object &&
+       record[1] != (char)S3MetadataRecord::bucket) ||
+      (uint8_t)record[2] != S3_METADATA_FORMAT_VERSION) {
+    fail();
+    return;
+  }
+  type = (S3MetadataRecord)record[1];
+  pos += 3;
+  field_end = pos;
+}
+
+bool S3MetadataDecoder::fail() {
+  error = true;
+  return false;
+}
+
+bool S3MetadataDecoder::read_varint(const char *limit, uint64_t &value) {
+  value = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    if (pos == limit) {
+      return fail();
+    }
+    uint8_t byte = (uint8_t)*pos++;
+    value |= (uint64_t)(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      return true;
+    }
+  }
+  return fail();
+}
+
+bool S3MetadataDecoder::read_chunk(const char *limit, const char *&data,
+                                   size_t &length) {
+  uint64_t chunk_length;
+  if (!read_varint(limit, chunk_length)) {
+    return false;
+  }
+  if (chunk_length > (uint64_t)(limit - pos)) {
+    return fail();
+  }
+  data = pos;
+  length = chunk_length;
+  pos += chunk_length;
+  return true;
+}
+
+bool S3MetadataDecoder::next_field(S3MetadataField &field) {
+  if (error) {
+    return false;
+  }
+  // Whatever is left of the previous field is skipped.
+  pos = field_end;
+  if (pos == end) {
+    return false;
+  }
+  uint64_t id;
+  const char *payload;
+  size_t length;
+  if (!read_varint(end, id) || !read_chunk(end, payload, length)) {
+    return false;
+  }
+  field = id < (uint64_t)S3MetadataField::max_field ? (S3MetadataField)id
+                                                   : S3MetadataField::max_field;
+  pos = payload;
+  field_end = payload + length;
+  return true;
+}
+
+bool S3MetadataDecoder::read_string(std::string &value) {
+  if (error) {
+    return false;
+  }
+  value.assign(pos, field_end - pos);
+  pos = field_end;
+  return true;
+}
+
+bool S3MetadataDecoder::read_integer(int64_t &value) {
+  uint64_t zigzag;
+  if (error || !read_varint(field_end, zigzag)) {
+    return false;
+  }
+  value = (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+  return true;
+}
+
+bool S3MetadataDecoder::read_map(std::map<std::string, std::string> &value) {
+  if (error) {
+    return false;
+  }
+  const char *key, *val;
+  size_t key_length, val_length;
+  while (pos < field_end) {
+    if (!read_chunk(field_end, key, key_length) ||
+        !read_chunk(field_end, val, val_length)) {
+      return false;
+    }
+    value[std::string(key, key_length)].assign(val, val_length);
+  }
+  return true;
+}
+
+bool S3MetadataDecoder::read_base64(std::string &encoded) {
+  if (error) {
+    return false;
+  }
+  encoded = base64_encode((const unsigned char *)pos, field_end - pos);
+  pos = field_end;
+  return true;
+}
+
+void S3MetadataDecoder::skip_field() { pos = field_end; }
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_METADATA_CODEC_H__
+#define __S3_SERVER_S3_METADATA_CODEC_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <map>
+#include <string>
+
+// Compact binary form of object and bucket metadata records, used instead of
+// JSON when S3_SERVER_METADATA_BINARY_ENCODING is enabled.
+//
+// Record layout:
+//   header: '\0', record type, format version
+//   fields: varint field id, varint payload length, payload
+// Payload of a map field is a sequence of (varint length, bytes) pairs
+// alternating keys and values. Integers are varint encoded, base64 values
+// of the JSON form are kept decoded. A JSON record always starts with '{',
+// so the leading '\0' tells both forms apart and old records stay readable.
+// Readers skip fields they do not know, new fields need no version change.
+
+enum class S3MetadataRecord : char {
+  object = 'O',
+  bucket = 'B'
+};
+
+// Ids are stored in records, never renumber them.
+enum class S3MetadataField : uint32_t {
+  none = 0,
+  bucket_name = 1,
+  object_name = 2,
+  object_uri = 3,
+  layout_id = 4,
+  upload_id = 5,
+  motr_part_oid = 6,
+  motr_old_oid = 7,
+  old_layout_id = 8,
+  motr_old_object_version_id = 9,
+  motr_oid = 10,
+  inline_data = 11,
+  system_defined = 12,
+  user_defined = 13,
+  user_defined_tags = 14,
+  acl = 15,
+  create_timestamp = 16,
+  policy = 17,
+  object_list_index_oid = 18,
+  multipart_index_oid = 19,
+  objects_version_list_index_oid = 20,
+  // Values kept as stored when they are not canonical base64
+  acl_as_stored = 21,
+  inline_data_as_stored = 22,
+  max_field
+};
+
+const uint8_t S3_METADATA_FORMAT_VERSION = 1;
+
+// True if 'record' is in the binary form.
+bool s3_is_binary_metadata(const std::string &record);
+
+// Converts a binary record to the JSON form the same metadata would have had,
+// for tools and the KV API which hand records out. Returns false on malformed
+// input.
+bool s3_binary_metadata_to_json(const std::string &record, std::string &json);
+
+// Appends a record to 'record', which is cleared first.
+class S3MetadataEncoder {
+  std::string &record;
+
+  void add_varint(uint64_t value);
+  void add_header(S3MetadataField field, size_t length);
+
+ public:
+  S3MetadataEncoder(std::string &record, S3MetadataRecord type);
+
+  void add_string(S3MetadataField field, const std::string &value);
+  void add_integer(S3MetadataField field, int64_t value);
+  void add_map(S3MetadataField field,
+               const std::map<std::string, std::string> &value);
+  // Stores raw bytes of the JSON field which holds them base64 encoded.
+  void add_bytes(S3MetadataField field, const std::string &value);
+  // Stores a value held base64 encoded in memory as raw bytes, or under
+  // 'as_stored' unchanged if decoding and encoding it again would not give
+  // back the same string.
+  void add_base64(S3MetadataField field, S3MetadataField as_stored,
+                  const std::string &encoded);
+};
+
+// Forward-only reader of a record, strings are assigned in place so reused
+// objects keep their buffers.
+//
+// Usage:
+//   S3MetadataDecoder decoder(record);
+//   S3MetadataField field;
+//   while (decoder.next_field(field)) {
+//     if (field == S3MetadataField::object_name) {
+//       decoder.read_string(object_name);
+//     } else {
+//       decoder.skip_field();
+//     }
+//   }
+//   if (decoder.failed()) { ... }
+class S3MetadataDecoder {
+  const char *pos;
+  const char *end;
+  // End of payload of the current field
+  const char *field_end;
+  S3MetadataRecord type;
+  bool error;
+
+  bool fail();
+  bool read_varint(const char *limit, uint64_t &value);
+  bool read_chunk(const char *limit, const char *&data, size_t &length);
+
+ public:
+  // The record is not copied and must outlive the decoder.
+  explicit S3MetadataDecoder(const std::string &record);
+  S3MetadataDecoder(std::string &&record) = delete;
+
+  S3MetadataRecord record_type() const { return type; }
+
+  // Reads the header of the next field. The payload must be consumed with
+  // one of the read functions or skip_field() before the next call.
+  bool next_field(S3MetadataField &field);
+  bool read_string(std::string &value);
+  bool read_integer(int64_t &value);
+  bool read_map(std::map<std::string, std::string> &value);
+  // Reads raw bytes and base64 encodes them.
+  bool read_base64(std::string &encoded);
+  void skip_field();
+
+  bool failed() const { return error; }
+};
+
+#endif
@@ -20,6 +20,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "s3_motr_context.h"
 #include "s3_mem_pool_manager.h"
@@ -31,8 +32,137 @@ extern std::set<struct s3_motr_idx_context *> global_motr_idx;
 extern std::set<struct s3_motr_obj_context *> global_motr_obj;
 extern int shutdown_motr_teardown_called;
 
-// Helper methods to free m0_bufvec array which holds
-// Memory buffers from custom memory pool
+std::mutex global_motr_ctx_lock;
+
+// A context and its arrays are allocated as one block. Blocks of up to
+// 8KB come from pools of 64, 128, ... 8192 bytes blocks, so an operation
+// costs one pool get/release instead of several calloc()/free().
+#define MOTR_CTX_ALIGNMENT 16
+#define MOTR_CTX_POOL_MIN_BLOCK_SIZE 64
+#define MOTR_CTX_POOL_COUNT 8
+#define MOTR_CTX_POOL_EXPANSION_SIZE 65536
+
+static MemoryPoolHandle motr_ctx_pools[MOTR_CTX_POOL_COUNT];
+
+// In front of each block, tells which pool the block came from.
+union motr_ctx_block_header {
+  int pool_index;  // -1 for blocks from calloc()
+  char align[MOTR_CTX_ALIGNMENT];
+};
+
+static size_t motr_ctx_aligned(size_t size) {
+  return (size + MOTR_CTX_ALIGNMENT - 1) & ~((size_t)MOTR_CTX_ALIGNMENT - 1);
+}
+
+// Returns zeroed memory of given size, NULL on out-of-memory
+static void *motr_ctx_alloc(size_t size) {
+  size_t block_size = sizeof(union motr_ctx_block_header) + size;
+  size_t pool_block_size = MOTR_CTX_POOL_MIN_BLOCK_SIZE;
+  int pool_index = 0;
+  union motr_ctx_block_header *header = NULL;
+
+  while (pool_index < MOTR_CTX_POOL_COUNT && pool_block_size < block_size) {
+    pool_index++;
+    pool_block_size <<= 1;
+  }
+  if (pool_index < MOTR_CTX_POOL_COUNT &&
+      motr_ctx_pools[pool_index] != NULL) {
+    header = (union motr_ctx_block_header *)mempool_getbuffer(
+        motr_ctx_pools[pool_index], pool_block_size);
+    if (header != NULL) {
+      memset(header, 0, block_size);
+    }
+  }
+  if (header == NULL) {
+    // Too large for pools, pools are not created or reached max threshold
+    header = (union motr_ctx_block_header *)calloc(1, block_size);
+    if (header == NULL) {
+      return NULL;
+    }
+    pool_index = -1;
+  }
+  header->pool_index = pool_index;
+  return header + 1;
+}
+
+static void motr_ctx_free(void *ptr) {
+  if (ptr == NULL) {
+    return;
+  }
+  union motr_ctx_block_header *header = (union motr_ctx_block_header *)ptr - 1;
+  int pool_index = header->pool_index;
+  if (pool_index >= 0 && motr_ctx_pools[pool_index] != NULL) {
+    mempool_releasebuffer(motr_ctx_pools[pool_index], header,
+                          (size_t)MOTR_CTX_POOL_MIN_BLOCK_SIZE << pool_index);
+  } else {
+    // Pool blocks are plain malloc()'ed memory, also once pool is destroyed
+    free(header);
+  }
+}
+
+// Lays out a context and its arrays in one block, a first pass over a
+// NULL block only adds up the size of the block.
+class S3MotrCtxBlock {
+  char *block;
+  size_t used;
+
+ public:
+  explicit S3MotrCtxBlock(void *mem = NULL) : block((char *)mem), used(0) {}
+
+  template <typename T>
+  T *take(size_t count = 1) {
+    T *part = (block == NULL) ? NULL : (T *)(block + used);
+    used += motr_ctx_aligned(count * sizeof(T));
+    return part;
+  }
+
+  size_t size() const { return used; }
+};
+
+// 'layout' takes the parts of a context with arrays of 'count' entries
+// from the block and returns the context, NULL if the block is NULL.
+template <typename T>
+static T *motr_ctx_create(T *(*layout)(S3MotrCtxBlock &, size_t),
+                          size_t count) {
+  S3MotrCtxBlock sizing;
+  layout(sizing, count);
+  S3MotrCtxBlock block(motr_ctx_alloc(sizing.size()));
+  return layout(block, count);
+}
+
+int create_motr_ctx_pools(size_t max_threshold, int flags) {
+  s3_log(S3_LOG_DEBUG, "", "%s Entry with max_threshold = %zu\n", __func__,
+         max_threshold);
+  if (max_threshold == 0) {
+    return 0;
+  }
+  size_t block_size = MOTR_CTX_POOL_MIN_BLOCK_SIZE;
+  for (int i = 0; i < MOTR_CTX_POOL_COUNT; i++, block_size <<= 1) {
+    int rc = mempool_create(block_size, 0, MOTR_CTX_POOL_EXPANSION_SIZE,
+                            max_threshold, (func_log_callback_type)NULL, flags,
+                            &motr_ctx_pools[i]);
+    if (rc != 0) {
+      s3_log(S3_LOG_ERROR, "",
+             "Pool creation failed for motr context block size %zu\n",
+             block_size);
+      destroy_motr_ctx_pools();
+      return rc;
+    }
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+  return 0;
+}
+
+void destroy_motr_ctx_pools() {
+  for (int i = 0; i < MOTR_CTX_POOL_COUNT; i++) {
+    if (motr_ctx_pools[i] != NULL) {
+      mempool_destroy(&motr_ctx_pools[i]);
+    }
+  }
+}
+
+// Helper methods to release Memory buffers from custom memory pool
+// held by m0_bufvec array
 static void s3_bufvec_free_aligned(struct m0_bufvec *bufvec, size_t unit_size,
                                    bool free_bufs = true) {
   s3_log(S3_LOG_DEBUG, "",
@@ -41,55 +171,33 @@ static void s3_bufvec_free_aligned(struct m0_bufvec *bufvec, size_t unit_size,
   if (free_bufs) {
     M0_PRE(unit_size > 0);
   }
-  if (bufvec != NULL) {
-    if (bufvec->ov_buf != NULL) {
-      if (free_bufs) {
-        for (uint32_t i = 0; i < bufvec->ov_vec.v_nr; ++i) {
-          S3MempoolManager::get_instance()->release_buffer_for_unit_size(
-              bufvec->ov_buf[i], unit_size);
-          bufvec->ov_buf[i] = NULL;
-        }
+  if (bufvec != NULL && bufvec->ov_buf != NULL && free_bufs) {
+    for (uint32_t i = 0; i < bufvec->ov_vec.v_nr; ++i) {
+      if (bufvec->ov_buf[i] != NULL) {
+        S3MempoolManager::get_instance()->release_buffer_for_unit_size(
+            bufvec->ov_buf[i], unit_size);
+        bufvec->ov_buf[i] = NULL;
       }
-      free(bufvec->ov_buf);
-      bufvec->ov_buf = NULL;
     }
-    free(bufvec->ov_vec.v_count);
-    bufvec->ov_vec.v_count = NULL;
-    bufvec->ov_vec.v_nr = 0;
   }
 }
 
-// Helper methods to create m0_bufvec array which holds
+// Helper methods to fill m0_bufvec array with
 // Memory buffers from custom memory pool
 // Each buffer size is pre-determined == size set in mempool
-static int s3_bufvec_alloc_aligned(struct m0_bufvec *bufvec, uint32_t num_segs,
-                                   size_t unit_size,
+static int s3_bufvec_alloc_aligned(struct m0_bufvec *bufvec, size_t unit_size,
                                    bool allocate_bufs = true) {
   s3_log(S3_LOG_DEBUG, "",
          "s3_bufvec_alloc_aligned unit_size = %zu, allocate_bufs = %s\n",
          unit_size, (allocate_bufs ? "true" : "false"));
-  M0_PRE(num_segs > 0);
   M0_PRE(bufvec != NULL);
+  M0_PRE(bufvec->ov_vec.v_nr > 0);
   if (allocate_bufs) {
     M0_PRE(unit_size > 0);
   }
 
-  bufvec->ov_buf = NULL;
-  bufvec->ov_vec.v_nr = num_segs;
-  bufvec->ov_vec.v_count = (m0_bcount_t *)calloc(num_segs, sizeof(m0_bcount_t));
-  if (bufvec->ov_vec.v_count == NULL) {
-    s3_bufvec_free_aligned(bufvec, unit_size, allocate_bufs);
-    return -ENOMEM;
-  }
-
-  bufvec->ov_buf = (void **)calloc(num_segs, sizeof(void *));
-  if (bufvec->ov_buf == NULL) {
-    s3_bufvec_free_aligned(bufvec, unit_size, allocate_bufs);
-    return -ENOMEM;
-  }
-
   if (allocate_bufs) {
-    for (uint32_t i = 0; i < num_segs; ++i) {
+    for (uint32_t i = 0; i < bufvec->ov_vec.v_nr; ++i) {
       bufvec->ov_buf[i] =
           (void *)S3MempoolManager::get_instance()->get_buffer_for_unit_size(
               unit_size);
@@ -104,16 +212,24 @@ static int s3_bufvec_alloc_aligned(struct m0_bufvec *bufvec, uint32_t num_segs,
   return 0;
 }
 
+static struct s3_motr_obj_context *layout_obj_context(S3MotrCtxBlock &block,
+                                                      size_t count) {
+  struct s3_motr_obj_context *ctx = block.take<struct s3_motr_obj_context>();
+  struct m0_obj *objs = block.take<struct m0_obj>(count);
+  if (ctx != NULL) {
+    ctx->objs = objs;
+    ctx->obj_count = count;
+  }
+  return ctx;
+}
+
 struct s3_motr_obj_context *create_obj_context(size_t count) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry with object count = %zu\n", __func__,
          count);
 
-  struct s3_motr_obj_context *ctx = (struct s3_motr_obj_context *)calloc(
-      1, sizeof(struct s3_motr_obj_context));
+  struct s3_motr_obj_context *ctx = motr_ctx_create(layout_obj_context, count);
 
-  ctx->objs = (struct m0_obj *)calloc(count, sizeof(struct m0_obj));
-  ctx->obj_count = count;
-  global_motr_obj.insert(ctx);
+  global_motr_ctx_insert(global_motr_obj, ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return ctx;
 }
@@ -121,24 +237,31 @@ struct s3_motr_obj_context *create_obj_context(size_t count) {
 int free_obj_context(struct s3_motr_obj_context *ctx) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
 
-  free(ctx->objs);
-  free(ctx);
+  motr_ctx_free(ctx);
 
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return 0;
 }
 
+static struct s3_motr_op_context *layout_op_ctx(S3MotrCtxBlock &block,
+                                                size_t op_count) {
+  struct s3_motr_op_context *ctx = block.take<struct s3_motr_op_context>();
+  struct m0_op **ops = block.take<struct m0_op *>(op_count);
+  struct m0_op_ops *cbs = block.take<struct m0_op_ops>(op_count);
+  if (ctx != NULL) {
+    ctx->ops = ops;
+    ctx->cbs = cbs;
+    ctx->op_count = op_count;
+  }
+  return ctx;
+}
+
 // To create a basic motr operation
 struct s3_motr_op_context *create_basic_op_ctx(size_t op_count) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry with op_count = %zu\n", __func__,
          op_count);
 
-  struct s3_motr_op_context *ctx =
-      (struct s3_motr_op_context *)calloc(1, sizeof(struct s3_motr_op_context));
-
-  ctx->ops = (struct m0_op **)calloc(op_count, sizeof(struct m0_op *));
-  ctx->cbs = (struct m0_op_ops *)calloc(op_count, sizeof(struct m0_op_ops));
-  ctx->op_count = op_count;
+  struct s3_motr_op_context *ctx = motr_ctx_create(layout_op_ctx, op_count);
 
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return ctx;
@@ -147,20 +270,58 @@ struct s3_motr_op_context *create_basic_op_ctx(size_t op_count) {
 int free_basic_op_ctx(struct s3_motr_op_context *ctx) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
   if (!shutdown_motr_teardown_called) {
-    global_motr_object_ops_list.erase(ctx);
+    global_motr_ctx_erase(global_motr_object_ops_list, ctx);
     for (size_t i = 0; i < ctx->op_count; i++) {
       if (ctx->ops[i] != NULL) {
         teardown_motr_op(ctx->ops[i]);
       }
     }
-    free(ctx->ops);
-    free(ctx->cbs);
-    free(ctx);
+    motr_ctx_free(ctx);
   }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return 0;
 }
 
+static struct s3_motr_rw_op_context *layout_rw_op_ctx(S3MotrCtxBlock &block,
+                                                      size_t count) {
+  struct s3_motr_rw_op_context *ctx =
+      block.take<struct s3_motr_rw_op_context>();
+  struct m0_indexvec *ext = block.take<struct m0_indexvec>();
+  struct m0_bufvec *data = block.take<struct m0_bufvec>();
+  struct m0_bufvec *attr = block.take<struct m0_bufvec>();
+  m0_bindex_t *ext_index = block.take<m0_bindex_t>(count);
+  m0_bcount_t *ext_count = block.take<m0_bcount_t>(count);
+  m0_bcount_t *data_count = block.take<m0_bcount_t>(count);
+  void **data_bufs = block.take<void *>(count);
+  m0_bcount_t *attr_count = block.take<m0_bcount_t>(count);
+  void **attr_bufs = block.take<void *>(count);
+  char *attr_space = block.take<char>(count);
+  if (ctx == NULL) {
+    return NULL;
+  }
+
+  ctx->ext = ext;
+  ext->iv_vec.v_nr = count;
+  ext->iv_vec.v_count = ext_count;
+  ext->iv_index = ext_index;
+
+  ctx->data = data;
+  data->ov_vec.v_nr = count;
+  data->ov_vec.v_count = data_count;
+  data->ov_buf = data_bufs;
+
+  // Same shape as m0_bufvec_alloc(attr, count, 1)
+  ctx->attr = attr;
+  attr->ov_vec.v_nr = count;
+  attr->ov_vec.v_count = attr_count;
+  attr->ov_buf = attr_bufs;
+  for (size_t i = 0; i < count; i++) {
+    attr_count[i] = 1;
+    attr_bufs[i] = attr_space + i;
+  }
+  return ctx;
+}
+
 // To create a motr RW operation
 // default allocate_bufs = true -> allocate memory for each buffer
 struct s3_motr_rw_op_context *create_basic_rw_op_ctx(size_t motr_buf_count,
@@ -169,47 +330,19 @@ struct s3_motr_rw_op_context *create_basic_rw_op_ctx(size_t motr_buf_count,
   s3_log(S3_LOG_DEBUG, "", "%s Entry motr_buf_count = %zu, unit_size = %zu\n",
          __func__, motr_buf_count, unit_size);
 
-  struct s3_motr_rw_op_context *ctx = (struct s3_motr_rw_op_context *)calloc(
-      1, sizeof(struct s3_motr_rw_op_context));
-
-  ctx->unit_size = unit_size;
-  ctx->ext = (struct m0_indexvec *)calloc(1, sizeof(struct m0_indexvec));
-  ctx->data = (struct m0_bufvec *)calloc(1, sizeof(struct m0_bufvec));
-  ctx->attr = (struct m0_bufvec *)calloc(1, sizeof(struct m0_bufvec));
-
-  ctx->allocated_bufs = allocate_bufs;
-  int rc = s3_bufvec_alloc_aligned(ctx->data, motr_buf_count, unit_size,
-                                   allocate_bufs);
-  if (rc != 0) {
-    free(ctx->ext);
-    free(ctx->data);
-    free(ctx->attr);
-    free(ctx);
+  struct s3_motr_rw_op_context *ctx =
+      motr_ctx_create(layout_rw_op_ctx, motr_buf_count);
+  if (ctx == NULL) {
     s3_log(S3_LOG_DEBUG, "", "%s Exit with NULL - possible out-of-memory\n",
            __func__);
     return NULL;
   }
 
-  rc = m0_bufvec_alloc(ctx->attr, motr_buf_count, 1);
-  if (rc != 0) {
-    s3_bufvec_free_aligned(ctx->data, unit_size, allocate_bufs);
-    free(ctx->data);
-    free(ctx->attr);
-    free(ctx->ext);
-    free(ctx);
-    s3_log(S3_LOG_DEBUG, "", "%s Exit with NULL - possible out-of-memory\n",
-           __func__);
-    return NULL;
-  }
-
-  rc = m0_indexvec_alloc(ctx->ext, motr_buf_count);
+  ctx->unit_size = unit_size;
+  ctx->allocated_bufs = allocate_bufs;
+  int rc = s3_bufvec_alloc_aligned(ctx->data, unit_size, allocate_bufs);
   if (rc != 0) {
-    s3_bufvec_free_aligned(ctx->data, unit_size, allocate_bufs);
-    m0_bufvec_free(ctx->attr);
-    free(ctx->data);
-    free(ctx->attr);
-    free(ctx->ext);
-    free(ctx);
+    motr_ctx_free(ctx);
     s3_log(S3_LOG_DEBUG, "", "%s Exit with NULL - possible out-of-memory\n",
            __func__);
     return NULL;
@@ -222,26 +355,31 @@ int free_basic_rw_op_ctx(struct s3_motr_rw_op_context *ctx) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
 
   s3_bufvec_free_aligned(ctx->data, ctx->unit_size, ctx->allocated_bufs);
-  m0_bufvec_free(ctx->attr);
-  m0_indexvec_free(ctx->ext);
-  free(ctx->ext);
-  free(ctx->data);
-  free(ctx->attr);
-  free(ctx);
+  motr_ctx_free(ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return 0;
 }
 
 /* Motr index API */
+static struct s3_motr_idx_context *layout_idx_context(S3MotrCtxBlock &block,
+                                                      size_t idx_count) {
+  struct s3_motr_idx_context *ctx = block.take<struct s3_motr_idx_context>();
+  struct m0_idx *idx = block.take<struct m0_idx>(idx_count);
+  if (ctx != NULL) {
+    ctx->idx = idx;
+    ctx->idx_count = idx_count;
+  }
+  return ctx;
+}
+
 struct s3_motr_idx_context *create_idx_context(size_t idx_count) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry with idx_count = %zu\n", __func__,
          idx_count);
 
-  struct s3_motr_idx_context *ctx = (struct s3_motr_idx_context *)calloc(
-      1, sizeof(struct s3_motr_idx_context));
-  ctx->idx = (struct m0_idx *)calloc(idx_count, sizeof(struct m0_idx));
-  ctx->idx_count = idx_count;
-  global_motr_idx.insert(ctx);
+  struct s3_motr_idx_context *ctx =
+      motr_ctx_create(layout_idx_context, idx_count);
+
+  global_motr_ctx_insert(global_motr_idx, ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return ctx;
 }
@@ -249,21 +387,31 @@ struct s3_motr_idx_context *create_idx_context(size_t idx_count) {
 int free_idx_context(struct s3_motr_idx_context *ctx) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
 
-  free(ctx->idx);
-  free(ctx);
+  motr_ctx_free(ctx);
 
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return 0;
 }
 
+static struct s3_motr_idx_op_context *layout_idx_op_ctx(S3MotrCtxBlock &block,
+                                                        size_t op_count) {
+  struct s3_motr_idx_op_context *ctx =
+      block.take<struct s3_motr_idx_op_context>();
+  struct m0_op **ops = block.take<struct m0_op *>(op_count);
+  struct m0_op_ops *cbs = block.take<struct m0_op_ops>(op_count);
+  if (ctx != NULL) {
+    ctx->ops = ops;
+    ctx->cbs = cbs;
+    ctx->op_count = op_count;
+  }
+  return ctx;
+}
+
 struct s3_motr_idx_op_context *create_basic_idx_op_ctx(int op_count) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry with op_count = %d\n", __func__, op_count);
 
-  struct s3_motr_idx_op_context *ctx = (struct s3_motr_idx_op_context *)calloc(
-      1, sizeof(struct s3_motr_idx_op_context));
-  ctx->ops = (struct m0_op **)calloc(op_count, sizeof(struct m0_op *));
-  ctx->cbs = (struct m0_op_ops *)calloc(op_count, sizeof(struct m0_op_ops));
-  ctx->op_count = op_count;
+  struct s3_motr_idx_op_context *ctx =
+      motr_ctx_create(layout_idx_op_ctx, op_count);
 
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return ctx;
@@ -272,7 +420,7 @@ struct s3_motr_idx_op_context *create_basic_idx_op_ctx(int op_count) {
 int free_basic_idx_op_ctx(struct s3_motr_idx_op_context *ctx) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
   if (!shutdown_motr_teardown_called) {
-    global_motr_idx_ops_list.erase(ctx);
+    global_motr_ctx_erase(global_motr_idx_ops_list, ctx);
 
     for (size_t i = 0; i < ctx->op_count; i++) {
       if (ctx->ops[i] == NULL) {
@@ -285,95 +433,79 @@ int free_basic_idx_op_ctx(struct s3_motr_idx_op_context *ctx) {
       teardown_motr_op(ctx->sync_op);
     }
 
-    free(ctx->ops);
-    free(ctx->cbs);
-    free(ctx);
+    motr_ctx_free(ctx);
   }
 
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return 0;
 }
 
-struct m0_bufvec *index_bufvec_alloc(int nr) {
-  struct m0_bufvec *bv;
-  bv = (m0_bufvec *)calloc(1, sizeof(*bv));
-  if (bv == NULL) return NULL;
-  bv->ov_vec.v_nr = nr;
-  bv->ov_vec.v_count = (m0_bcount_t *)calloc(nr, sizeof(m0_bcount_t));
-  if (bv->ov_vec.v_count == NULL) {
-    goto FAIL;
-  }
-  bv->ov_buf = (void **)calloc(nr, sizeof(char *));
-  if (bv->ov_buf == NULL) {
-    goto FAIL;
+static struct m0_bufvec *layout_index_bufvec(S3MotrCtxBlock &block,
+                                             size_t nr) {
+  struct m0_bufvec *bv = block.take<struct m0_bufvec>();
+  m0_bcount_t *v_count = block.take<m0_bcount_t>(nr);
+  void **ov_buf = block.take<void *>(nr);
+  if (bv != NULL) {
+    bv->ov_vec.v_nr = nr;
+    bv->ov_vec.v_count = v_count;
+    bv->ov_buf = ov_buf;
   }
-
   return bv;
+}
 
-FAIL:
-  if (bv != NULL) {
-    if (bv->ov_buf != NULL) {
-      free(bv->ov_buf);
-    }
-    if (bv->ov_vec.v_count != NULL) {
-      free(bv->ov_vec.v_count);
-    }
-    free(bv);
+// Frees the keys/values pointed by bufvec, they are malloc()'ed by users
+// of the bufvec or by motr.
+static void index_bufvec_free_bufs(struct m0_bufvec *bv) {
+  for (uint32_t i = 0; i < bv->ov_vec.v_nr; ++i) {
+    free(bv->ov_buf[i]);
   }
-  return NULL;
+}
+
+struct m0_bufvec *index_bufvec_alloc(int nr) {
+  return motr_ctx_create(layout_index_bufvec, nr);
 }
 
 void index_bufvec_free(struct m0_bufvec *bv) {
-  uint32_t i;
   if (bv == NULL) return;
 
-  if (bv->ov_buf != NULL) {
-    for (i = 0; i < bv->ov_vec.v_nr; ++i) free(bv->ov_buf[i]);
-    free(bv->ov_buf);
+  index_bufvec_free_bufs(bv);
+  motr_ctx_free(bv);
+}
+
+static struct s3_motr_kvs_op_context *layout_kvs_op_ctx(S3MotrCtxBlock &block,
+                                                        size_t no_of_keys) {
+  struct s3_motr_kvs_op_context *ctx =
+      block.take<struct s3_motr_kvs_op_context>();
+  struct m0_bufvec *keys = layout_index_bufvec(block, no_of_keys);
+  struct m0_bufvec *values = layout_index_bufvec(block, no_of_keys);
+  int *rcs = block.take<int>(no_of_keys);
+  if (ctx != NULL) {
+    ctx->keys = keys;
+    ctx->values = values;
+    ctx->rcs = rcs;
   }
-  free(bv->ov_vec.v_count);
-  free(bv);
+  return ctx;
 }
 
 struct s3_motr_kvs_op_context *create_basic_kvs_op_ctx(int no_of_keys) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
   s3_log(S3_LOG_DEBUG, "", "no of keys = %d\n", no_of_keys);
 
-  struct s3_motr_kvs_op_context *ctx = (struct s3_motr_kvs_op_context *)calloc(
-      1, sizeof(struct s3_motr_kvs_op_context));
-
-  ctx->keys = index_bufvec_alloc(no_of_keys);
-  if (ctx->keys == NULL) goto FAIL;
-  ctx->values = index_bufvec_alloc(no_of_keys);
-  if (ctx->values == NULL) goto FAIL;
-  ctx->rcs = (int *)calloc(no_of_keys, sizeof(int));
-  if (ctx->rcs == NULL) goto FAIL;
+  struct s3_motr_kvs_op_context *ctx =
+      motr_ctx_create(layout_kvs_op_ctx, no_of_keys);
+  if (ctx == NULL) {
+    return NULL;
+  }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return ctx;
-
-FAIL:
-  if (ctx->keys) {
-    index_bufvec_free(ctx->keys);
-  }
-  if (ctx->values) {
-    index_bufvec_free(ctx->values);
-  }
-  if (ctx->rcs) {
-    free(ctx->rcs);
-  }
-  if (ctx) {
-    free(ctx);
-  }
-  return NULL;
 }
 
 int free_basic_kvs_op_ctx(struct s3_motr_kvs_op_context *ctx) {
   s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
 
-  index_bufvec_free(ctx->keys);
-  index_bufvec_free(ctx->values);
-  free(ctx->rcs);
-  free(ctx);
+  index_bufvec_free_bufs(ctx->keys);
+  index_bufvec_free_bufs(ctx->values);
+  motr_ctx_free(ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return 0;
 }
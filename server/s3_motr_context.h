@@ -25,6 +25,7 @@
 
 #include "s3_common.h"
 #include "s3_log.h"
+#include <mutex>
 #include <set>
 
 EXTERN_C_BLOCK_BEGIN
@@ -78,6 +79,12 @@ struct s3_motr_kvs_op_context {
   int *rcs;  // per key return status array
 };
 
+// Creates pools of blocks for the contexts below, each pool holding up to
+// max_threshold bytes, flags as for mempool_create(). Contexts are
+// allocated with calloc() when pools are not created or are full.
+int create_motr_ctx_pools(size_t max_threshold, int flags);
+void destroy_motr_ctx_pools();
+
 struct s3_motr_obj_context *create_obj_context(size_t count);
 int free_obj_context(struct s3_motr_obj_context *ctx);
 
@@ -101,4 +108,19 @@ int free_basic_kvs_op_ctx(struct s3_motr_kvs_op_context *ctx);
 struct m0_bufvec *index_bufvec_alloc(int nr);
 void index_bufvec_free(struct m0_bufvec *bv);
 
+// global_motr_* lists of contexts in flight are shared by reactor threads.
+extern std::mutex global_motr_ctx_lock;
+
+template <typename T>
+void global_motr_ctx_insert(std::set<T *> &ctx_list, T *ctx) {
+  std::lock_guard<std::mutex> lock(global_motr_ctx_lock);
+  ctx_list.insert(ctx);
+}
+
+template <typename T>
+void global_motr_ctx_erase(std::set<T *> &ctx_list, T *ctx) {
+  std::lock_guard<std::mutex> lock(global_motr_ctx_lock);
+  ctx_list.erase(ctx);
+}
+
 #endif
@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <algorithm>
+#include <iterator>
+
+#include "s3_factory.h"
+#include "s3_motr_kvs_cursor.h"
+#include "s3_option.h"
+#include "s3_post_to_main_loop.h"
+
+S3MotrKVSCursor::S3MotrKVSCursor(
+    std::shared_ptr<RequestObject> req, std::shared_ptr<MotrAPI> motr_api,
+    std::shared_ptr<S3MotrKVSReaderFactory> factory)
+    : S3MotrKVSReader(req, motr_api),
+      request(req),
+      s3_motr_api(motr_api),
+      reader_factory(factory),
+      window_valid(false),
+      window_oid{0ULL, 0ULL},
+      window_start_inclusive(false),
+      window_at_end(false),
+      request_pending(false),
+      request_count(0),
+      request_inclusive(false),
+      state(S3MotrKVSReaderOpState::start) {
+  request_id = request->get_request_id();
+  stripped_request_id = request->get_stripped_request_id();
+  s3_log(S3_LOG_DEBUG, request_id, "%s Ctor\n", __func__);
+
+  S3Option* option_instance = S3Option::get_instance();
+  min_batch_size = option_instance->get_motr_idx_fetch_count();
+  max_batch_size = std::max<size_t>(
+      option_instance->get_motr_idx_prefetch_max_count(), min_batch_size);
+  batch_size = min_batch_size;
+  target_latency = std::chrono::milliseconds(
+      option_instance->get_motr_idx_prefetch_latency_ms());
+}
+
+S3MotrKVSCursor::~S3MotrKVSCursor() {
+  s3_log(S3_LOG_DEBUG, request_id, "%s\n", __func__);
+}
+
+void S3MotrKVSCursor::next_keyval(struct m0_uint128 idx_oid, std::string key,
+                                  size_t nr_kvp,
+                                  std::function<void(void)> on_success,
+                                  std::function<void(void)> on_failed,
+                                  unsigned int flag) {
+  s3_log(S3_LOG_INFO, stripped_request_id,
+         "%s Entry with idx_oid = %" SCNx64 " : %" SCNx64
+         " key = %s and count = %zu\n",
+         __func__, idx_oid.u_hi, idx_oid.u_lo, key.c_str(), nr_kvp);
+  handler_on_success = std::move(on_success);
+  handler_on_failed = std::move(on_failed);
+  request_pending = true;
+  request_key = std::move(key);
+  request_count = nr_kvp;
+  request_inclusive = !(flag & M0_OIF_EXCLUDE_START_KEY);
+  state = S3MotrKVSReaderOpState::start;
+
+  if (idx_oid.u_hi != window_oid.u_hi || idx_oid.u_lo != window_oid.u_lo ||
+      !covers(request_key, request_inclusive)) {
+    s3_log(S3_LOG_DEBUG, request_id, "Key is outside the fetched keys\n");
+    abandon(ahead);
+    abandon(direct);
+    window_valid = false;
+    window.clear();
+    window_oid = idx_oid;
+    start_fetch(direct, request_key, request_inclusive,
+                std::max(request_count, batch_size));
+    s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+    return;
+  }
+  try_serve(true);
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+bool S3MotrKVSCursor::covers(const std::string& key, bool inclusive) const {
+  if (!window_valid) {
+    return false;
+  }
+  int cmp = key.compare(window_start);
+  if (cmp > 0) {
+    return true;
+  }
+  return cmp == 0 && (!inclusive || window_start_inclusive);
+}
+
+void S3MotrKVSCursor::start_fetch(std::shared_ptr<Fetch>& slot,
+                                  const std::string& key, bool inclusive,
+                                  size_t count) {
+  s3_log(S3_LOG_DEBUG, request_id, "Fetching %zu keys after [%s]\n", count,
+         key.c_str());
+  std::shared_ptr<S3MotrKVSReader> reader;
+  if (!idle_readers.empty()) {
+    reader = std::move(idle_readers.back());
+    idle_readers.pop_back();
+  } else if (reader_factory) {
+    reader = reader_factory->create_motr_kvs_reader(request, s3_motr_api);
+  } else {
+    reader = std::make_shared<S3MotrKVSReader>(request, s3_motr_api);
+  }
+  slot = std::make_shared<Fetch>();
+  slot->reader = reader;
+  slot->start_key = key;
+  slot->inclusive = inclusive;
+  slot->count = count;
+  slot->started = std::chrono::steady_clock::now();
+  if (!self_ref) {
+    self_ref = shared_from_this();
+  }
+  Fetch* fetch = slot.get();
+  reader->next_keyval(window_oid, key, count,
+                      [this, fetch]() { fetch_done(fetch, true); },
+                      [this, fetch]() { fetch_done(fetch, false); },
+                      inclusive ? 0 : M0_OIF_EXCLUDE_START_KEY);
+}
+
+void S3MotrKVSCursor::abandon(std::shared_ptr<Fetch>& slot) {
+  if (slot) {
+    abandoned.push_back(std::move(slot));
+    slot = nullptr;
+  }
+}
+
+void S3MotrKVSCursor::prefetch() {
+  if (!window_valid || window_at_end || ahead) {
+    return;
+  }
+  if (window.empty()) {
+    start_fetch(ahead, window_start, window_start_inclusive, batch_size);
+  } else {
+    start_fetch(ahead, window.rbegin()->first, false, batch_size);
+  }
+}
+
+void S3MotrKVSCursor::adapt_batch_size(const Fetch& fetch, size_t fetched) {
+  // Only a full batch of the current size says how Motr copes with it.
+  if (fetched < fetch.count || fetch.count != batch_size) {
+    return;
+  }
+  auto elapsed = std::chrono::steady_clock::now() - fetch.started;
+  if (elapsed < target_latency) {
+    batch_size = std::min(batch_size * 2, max_batch_size);
+  } else if (elapsed > 2 * target_latency) {
+    batch_size = std::max(batch_size / 2, min_batch_size);
+  }
+  s3_log(S3_LOG_DEBUG, request_id, "Listing batch size = %zu\n", batch_size);
+}
+
+void S3MotrKVSCursor::fetch_done(Fetch* fetch, bool success) {
+  s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+  std::shared_ptr<Fetch> done;
+  bool is_direct = false;
+  if (ahead.get() == fetch) {
+    done = std::move(ahead);
+    ahead = nullptr;
+  } else if (direct.get() == fetch) {
+    done = std::move(direct);
+    direct = nullptr;
+    is_direct = true;
+  } else {
+    auto it = std::find_if(
+        abandoned.begin(), abandoned.end(),
+        [fetch](const std::shared_ptr<Fetch>& f) { return f.get() == fetch; });
+    if (it == abandoned.end()) {
+      s3_log(S3_LOG_WARN, request_id, "Dropping reply of unknown fetch\n");
+      return;
+    }
+    idle_readers.push_back(std::move((*it)->reader));
+    abandoned.erase(it);
+    release_if_idle();
+    return;
+  }
+  S3MotrKVSReaderOpState reader_state = done->reader->get_state();
+  KeyValues& kvs = done->reader->get_key_values();
+  size_t fetched = success ? kvs.size() : 0;
+  if (success) {
+    adapt_batch_size(*done, fetched);
+  } else if (reader_state == S3MotrKVSReaderOpState::failed_e2big) {
+    max_batch_size = std::max<size_t>(done->count / 2, 1);
+    min_batch_size = std::min(min_batch_size, max_batch_size);
+    batch_size = std::min(batch_size, max_batch_size);
+  }
+
+  if (success || reader_state == S3MotrKVSReaderOpState::missing) {
+    if (is_direct) {
+      window_valid = true;
+      window_start = done->start_key;
+      window_start_inclusive = done->inclusive;
+      window.clear();
+      window.swap(kvs);
+    } else if (window.empty()) {
+      window.swap(kvs);
+    } else {
+      window.insert(std::make_move_iterator(kvs.begin()),
+                    std::make_move_iterator(kvs.end()));
+    }
+    window_at_end = fetched < done->count;
+    idle_readers.push_back(std::move(done->reader));
+    if (request_pending) {
+      try_serve(false);
+    }
+  } else if (is_direct) {
+    idle_readers.push_back(std::move(done->reader));
+    if (reader_state == S3MotrKVSReaderOpState::failed_e2big &&
+        done->count > request_count) {
+      // The extra keys were only asked for ahead of time.
+      start_fetch(direct, done->start_key, done->inclusive, request_count);
+    } else {
+      reply(false, reader_state, false);
+    }
+  } else {
+    s3_log(S3_LOG_WARN, request_id, "Prefetch of listing keys failed\n");
+    idle_readers.push_back(std::move(done->reader));
+    if (request_pending) {
+      // Let the caller see the error of its own request, if any.
+      window_valid = false;
+      window.clear();
+      start_fetch(direct, request_key, request_inclusive, request_count);
+    }
+  }
+  release_if_idle();
+}
+
+bool S3MotrKVSCursor::try_serve(bool in_caller) {
+  auto it = request_inclusive ? window.lower_bound(request_key)
+                              : window.upper_bound(request_key);
+  if (!window_at_end &&
+      static_cast<size_t>(std::distance(it, window.end())) < request_count) {
+    const std::string& last_fetched =
+        window.empty() ? window_start : window.rbegin()->first;
+    if (!ahead && request_key > last_fetched) {
+      // Seek past the fetched keys, the ones in between are not needed.
+      window_valid = false;
+      window.clear();
+      start_fetch(direct, request_key, request_inclusive,
+                  std::max(request_count, batch_size));
+    } else {
+      // Served when the keys after the window arrive.
+      prefetch();
+    }
+    return false;
+  }
+  result_keys_values.clear();
+  for (; it != window.end() && result_keys_values.size() < request_count;
+       ++it) {
+    result_keys_values.insert(result_keys_values.end(), std::move(*it));
+  }
+  if (!result_keys_values.empty()) {
+    // Served keys are not asked for again.
+    window_start = result_keys_values.rbegin()->first;
+    window_start_inclusive = false;
+    window.erase(window.begin(), window.upper_bound(window_start));
+  }
+  prefetch();
+  if (result_keys_values.empty()) {
+    reply(false, S3MotrKVSReaderOpState::missing, in_caller);
+  } else {
+    reply(true, S3MotrKVSReaderOpState::present, in_caller);
+  }
+  return true;
+}
+
+void S3MotrKVSCursor::reply(bool success, S3MotrKVSReaderOpState new_state,
+                            bool in_caller) {
+  state = new_state;
+  request_pending = false;
+  if (!in_caller) {
+    std::function<void(void)> handler =
+        success ? handler_on_success : handler_on_failed;
+    handler();
+    return;
+  }
+  // Called from next_keyval(): answer from the loop, as a Motr op would, so
+  // a listing served from prefetched keys does not recurse.
+  struct user_event_context* user_ctx =
+      (struct user_event_context*)calloc(1, sizeof(struct user_event_context));
+  user_ctx->app_ctx = new std::pair<std::shared_ptr<S3MotrKVSCursor>, bool>(
+      shared_from_this(), success);
+#ifdef S3_GOOGLE_TEST
+  reply_in_loop(0, 0, (void*)user_ctx);
+#else
+  S3PostToMainLoop((void*)user_ctx)(reply_in_loop, request_id);
+#endif  // S3_GOOGLE_TEST
+}
+
+void S3MotrKVSCursor::reply_in_loop(evutil_socket_t, short, void* user_data) {
+  struct user_event_context* user_ctx =
+      (struct user_event_context*)user_data;
+  auto* reply_ctx =
+      (std::pair<std::shared_ptr<S3MotrKVSCursor>, bool>*)user_ctx->app_ctx;
+  if (user_ctx->user_event) {
+    event_free((struct event*)user_ctx->user_event);
+  }
+  free(user_ctx);
+
+  S3MotrKVSCursor* cursor = reply_ctx->first.get();
+  std::function<void(void)> handler = reply_ctx->second
+                                          ? cursor->handler_on_success
+                                          : cursor->handler_on_failed;
+  handler();
+  delete reply_ctx;
+}
+
+void S3MotrKVSCursor::release_if_idle() {
+  if (ahead || direct || !abandoned.empty() || request_pending) {
+    return;
+  }
+  // May destroy the cursor, keep this the last thing done.
+  std::shared_ptr<S3MotrKVSCursor> self = std::move(self_ref);
+  self_ref = nullptr;
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_MOTR_KVS_CURSOR_H__
+#define __S3_SERVER_S3_MOTR_KVS_CURSOR_H__
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <event2/event.h>
+#include <gtest/gtest_prod.h>
+
+#include "s3_motr_kvs_reader.h"
+
+class S3MotrKVSReaderFactory;
+
+// Index iterator for listings. It serves next_keyval() like S3MotrKVSReader
+// does, but keeps the NEXT op for the keys following the last served batch
+// in flight while the caller processes the current one, so a listing waits
+// on Motr only when it outpaces it.
+//
+// Keys are fetched in batches of their own size, which grows while Motr
+// answers faster than the configured latency and shrinks when it is slower
+// or rejects the batch with E2BIG. Requests falling within the fetched range
+// (including seeks past a common prefix) are answered from it, a seek past
+// it waits for the prefetch in flight first; anything else starts a new
+// fetch.
+class S3MotrKVSCursor : public S3MotrKVSReader,
+                        public std::enable_shared_from_this<S3MotrKVSCursor> {
+  typedef std::map<std::string, std::pair<int, std::string>> KeyValues;
+
+  // One NEXT op issued on an inner reader.
+  struct Fetch {
+    std::shared_ptr<S3MotrKVSReader> reader;
+    std::string start_key;
+    bool inclusive;
+    size_t count;
+    std::chrono::steady_clock::time_point started;
+  };
+
+  std::shared_ptr<RequestObject> request;
+  std::shared_ptr<MotrAPI> s3_motr_api;
+  std::shared_ptr<S3MotrKVSReaderFactory> reader_factory;
+  std::string request_id;
+  std::string stripped_request_id;
+
+  // Inner readers not running an op.
+  std::vector<std::shared_ptr<S3MotrKVSReader>> idle_readers;
+  // Fetch for the keys after the window; fetch for a request outside it.
+  std::shared_ptr<Fetch> ahead;
+  std::shared_ptr<Fetch> direct;
+  // Ops still running whose result is no longer wanted.
+  std::vector<std::shared_ptr<Fetch>> abandoned;
+  // Keeps the cursor alive while an op refers to it.
+  std::shared_ptr<S3MotrKVSCursor> self_ref;
+
+  // Fetched and not yet served keys. All keys of the index after
+  // window_start (or from it, if window_start_inclusive) up to the last
+  // one in the window are known; all keys past it too, if window_at_end.
+  bool window_valid;
+  struct m0_uint128 window_oid;
+  std::string window_start;
+  bool window_start_inclusive;
+  bool window_at_end;
+  KeyValues window;
+
+  // Request of the caller.
+  bool request_pending;
+  std::string request_key;
+  size_t request_count;
+  bool request_inclusive;
+  std::function<void(void)> handler_on_success;
+  std::function<void(void)> handler_on_failed;
+
+  S3MotrKVSReaderOpState state;
+  KeyValues result_keys_values;
+
+  size_t batch_size;
+  size_t min_batch_size;
+  size_t max_batch_size;
+  std::chrono::milliseconds target_latency;
+
+  bool covers(const std::string& key, bool inclusive) const;
+  void start_fetch(std::shared_ptr<Fetch>& slot, const std::string& key,
+                   bool inclusive, size_t count);
+  void fetch_done(Fetch* fetch, bool success);
+  void prefetch();
+  void abandon(std::shared_ptr<Fetch>& slot);
+  void adapt_batch_size(const Fetch& fetch, size_t fetched);
+  bool try_serve(bool in_caller);
+  void reply(bool success, S3MotrKVSReaderOpState new_state, bool in_caller);
+  void release_if_idle();
+
+  static void reply_in_loop(evutil_socket_t, short, void* user_data);
+
+ public:
+  S3MotrKVSCursor(std::shared_ptr<RequestObject> req,
+                  std::shared_ptr<MotrAPI> motr_api = nullptr,
+                  std::shared_ptr<S3MotrKVSReaderFactory> factory = nullptr);
+  virtual ~S3MotrKVSCursor();
+
+  S3MotrKVSReaderOpState get_state() override { return state; }
+
+  // Must be called on a cursor owned by a std::shared_ptr.
+  void next_keyval(struct m0_uint128 idx_oid, std::string key, size_t nr_kvp,
+                   std::function<void(void)> on_success,
+                   std::function<void(void)> on_failed,
+                   unsigned int flag = M0_OIF_EXCLUDE_START_KEY) override;
+
+  KeyValues& get_key_values() override { return result_keys_values; }
+
+  size_t get_batch_size() const { return batch_size; }
+
+  // friends declaration for Unit test
+  FRIEND_TEST(S3MotrKVSCursorTest, ServesNextBatchFromPrefetch);
+  FRIEND_TEST(S3MotrKVSCursorTest, WaitsForPrefetchInFlight);
+  FRIEND_TEST(S3MotrKVSCursorTest, SeekWithinWindow);
+  FRIEND_TEST(S3MotrKVSCursorTest, SeekPastWindowWaitsForPrefetch);
+  FRIEND_TEST(S3MotrKVSCursorTest, SeekOutsideWindowAbandonsPrefetch);
+  FRIEND_TEST(S3MotrKVSCursorTest, LateReplyOfUnknownFetchIsDropped);
+  FRIEND_TEST(S3MotrKVSCursorTest, EndOfIndex);
+  FRIEND_TEST(S3MotrKVSCursorTest, AdaptsBatchSizeToLatency);
+  FRIEND_TEST(S3MotrKVSCursorTest, E2bigRetriesWithRequestedCount);
+};
+
+#endif
@@ -59,7 +59,7 @@ S3MotrKVSReader::~S3MotrKVSReader() { clean_up_contexts(); }
 void S3MotrKVSReader::clean_up_contexts() {
   reader_context = nullptr;
   if (!shutdown_motr_teardown_called) {
-    global_motr_idx.erase(idx_ctx);
+    global_motr_ctx_erase(global_motr_idx, idx_ctx);
     if (idx_ctx) {
       for (size_t i = 0; i < idx_ctx->n_initialized_contexts; i++) {
         s3_motr_api->motr_idx_fini(&idx_ctx->idx[i]);
@@ -159,7 +159,7 @@ void S3MotrKVSReader::get_keyval(struct m0_uint128 oid,
 
   s3_motr_api->motr_op_launch(request->addb_request_id, idx_op_ctx->ops, 1,
                               MotrOpType::getkv);
-  global_motr_idx_ops_list.insert(idx_op_ctx);
+  global_motr_ctx_insert(global_motr_idx_ops_list, idx_op_ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return;
 }
@@ -391,7 +391,7 @@ void S3MotrKVSReader::next_keyval(struct m0_uint128 idx_oid, std::string key,
 
   s3_motr_api->motr_op_launch(request->addb_request_id, idx_op_ctx->ops, 1,
                               MotrOpType::getkv);
-  global_motr_idx_ops_list.insert(idx_op_ctx);
+  global_motr_ctx_insert(global_motr_idx_ops_list, idx_op_ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return;
 }
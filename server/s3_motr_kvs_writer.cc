@@ -70,7 +70,7 @@ void S3MotrKVSWriter::clean_up_contexts() {
   writer_context = nullptr;
   sync_context = nullptr;
   if (!shutdown_motr_teardown_called) {
-    global_motr_idx.erase(idx_ctx);
+    global_motr_ctx_erase(global_motr_idx, idx_ctx);
     if (idx_ctx) {
       for (size_t i = 0; i < idx_ctx->n_initialized_contexts; i++) {
         if (shutdown_motr_teardown_called) {
@@ -155,7 +155,7 @@ void S3MotrKVSWriter::create_index_with_oid(
 
   s3_motr_api->motr_op_launch(request->addb_request_id, idx_op_ctx->ops, 1,
                               MotrOpType::createidx);
-  global_motr_idx_ops_list.insert(idx_op_ctx);
+  global_motr_ctx_insert(global_motr_idx_ops_list, idx_op_ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -329,7 +329,7 @@ void S3MotrKVSWriter::delete_index(struct m0_uint128 idx_oid,
 
   s3_motr_api->motr_op_launch(request->addb_request_id, idx_op_ctx->ops, 1,
                               MotrOpType::deleteidx);
-  global_motr_idx_ops_list.insert(idx_op_ctx);
+  global_motr_ctx_insert(global_motr_idx_ops_list, idx_op_ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -432,7 +432,7 @@ void S3MotrKVSWriter::delete_indexes(std::vector<struct m0_uint128> oids,
 
   s3_motr_api->motr_op_launch(request->addb_request_id, idx_op_ctx->ops,
                               oids.size(), MotrOpType::deleteidx);
-  global_motr_idx_ops_list.insert(idx_op_ctx);
+  global_motr_ctx_insert(global_motr_idx_ops_list, idx_op_ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -563,7 +563,7 @@ int S3MotrKVSWriter::put_keyval_impl(
   s3_motr_api->motr_op_launch(
       (is_async ? request->addb_request_id : S3_ADDB_STARTUP_REQUESTS_ID),
       &(idx_op_ctx->ops[0]), 1, MotrOpType::putkv);
-  global_motr_idx_ops_list.insert(idx_op_ctx);
+  global_motr_ctx_insert(global_motr_idx_ops_list, idx_op_ctx);
   if (!is_async) {
     s3_log(S3_LOG_DEBUG, request_id, "Waiting for motr put KV to complete\n");
     rc = s3_motr_api->motr_op_wait(
@@ -686,7 +686,7 @@ void S3MotrKVSWriter::put_keyval(struct m0_uint128 oid, std::string key,
 
   s3_motr_api->motr_op_launch(request->addb_request_id, idx_op_ctx->ops, 1,
                               MotrOpType::putkv);
-  global_motr_idx_ops_list.insert(idx_op_ctx);
+  global_motr_ctx_insert(global_motr_idx_ops_list, idx_op_ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -889,7 +889,7 @@ void S3MotrKVSWriter::delete_keyval(struct m0_uint128 oid,
 
   s3_motr_api->motr_op_launch(request->addb_request_id, idx_op_ctx->ops, 1,
                               MotrOpType::deletekv);
-  global_motr_idx_ops_list.insert(idx_op_ctx);
+  global_motr_ctx_insert(global_motr_idx_ops_list, idx_op_ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -65,7 +65,7 @@ void S3MotrReader::clean_up_contexts() {
   open_context = nullptr;
   reader_context = nullptr;
   if (!shutdown_motr_teardown_called) {
-    global_motr_obj.erase(obj_ctx);
+    global_motr_ctx_erase(global_motr_obj, obj_ctx);
     if (obj_ctx) {
       for (size_t i = 0; i < obj_ctx->n_initialized_contexts; i++) {
         s3_motr_api->motr_obj_fini(&obj_ctx->objs[i]);
@@ -184,7 +184,7 @@ int S3MotrReader::open_object(std::function<void(void)> on_success,
 
   s3_motr_api->motr_op_launch(request->addb_request_id, ctx->ops, 1,
                               MotrOpType::openobj);
-  global_motr_object_ops_list.insert(ctx);
+  global_motr_ctx_insert(global_motr_object_ops_list, ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return rc;
 }
@@ -292,7 +292,7 @@ bool S3MotrReader::read_object() {
 
   s3_motr_api->motr_op_launch(request->addb_request_id, ctx->ops, 1,
                               MotrOpType::readobj);
-  global_motr_object_ops_list.insert(ctx);
+  global_motr_ctx_insert(global_motr_object_ops_list, ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return true;
 }
@@ -76,6 +76,7 @@ S3MotrWiter::S3MotrWiter(std::shared_ptr<RequestObject> req, uint64_t offset,
       last_index(offset),
       size_in_current_write(0),
       total_written(0),
+      content_md5_enabled(true),
       is_object_opened(false),
       obj_ctx(nullptr) {
 
@@ -108,6 +109,10 @@ S3MotrWiter::S3MotrWiter(std::shared_ptr<RequestObject> req, uint64_t offset,
   place_holder_for_last_unit = NULL;
   last_op_was_write = false;
   unit_size_for_place_holder = -1;
+
+  if (S3HashWorkerPool::get_instance()) {
+    hash_stream = S3HashWorkerPool::get_instance()->create_stream();
+  }
 }
 
 S3MotrWiter::S3MotrWiter(std::shared_ptr<RequestObject> req,
@@ -122,6 +127,10 @@ S3MotrWiter::S3MotrWiter(std::shared_ptr<RequestObject> req,
 }
 
 S3MotrWiter::~S3MotrWiter() {
+  if (hash_stream) {
+    // Hash jobs may still be reading our buffers and md5crypt.
+    hash_stream->cancel();
+  }
   reset_buffers_if_any(unit_size_for_place_holder);
   clean_up_contexts();
 }
@@ -151,7 +160,7 @@ void S3MotrWiter::clean_up_contexts() {
   writer_context = nullptr;
   delete_context = nullptr;
   if (!shutdown_motr_teardown_called) {
-    global_motr_obj.erase(obj_ctx);
+    global_motr_ctx_erase(global_motr_obj, obj_ctx);
     if (obj_ctx) {
       for (size_t i = 0; i < obj_ctx->n_initialized_contexts; ++i) {
         s3_motr_api->motr_obj_fini(&obj_ctx->objs[i]);
@@ -221,7 +230,7 @@ int S3MotrWiter::open_objects() {
          oid_list_stream.str().c_str());
   s3_motr_api->motr_op_launch(request->addb_request_id, ctx->ops, ops_count,
                               MotrOpType::openobj);
-  global_motr_object_ops_list.insert(ctx);
+  global_motr_ctx_insert(global_motr_object_ops_list, ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
   return 0;
 }
@@ -336,7 +345,7 @@ void S3MotrWiter::create_object(std::function<void(void)> on_success,
 
   s3_motr_api->motr_op_launch(request->addb_request_id, ctx->ops, 1,
                               MotrOpType::createobj);
-  global_motr_object_ops_list.insert(ctx);
+  global_motr_ctx_insert(global_motr_object_ops_list, ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -487,11 +496,17 @@ void S3MotrWiter::write_content() {
          size_in_current_write);
   s3_motr_api->motr_op_launch(request->addb_request_id, ctx->ops, 1,
                               MotrOpType::writeobj);
-  global_motr_object_ops_list.insert(ctx);
+  global_motr_ctx_insert(global_motr_object_ops_list, ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
 void S3MotrWiter::write_content_successful() {
+  if (hash_stream && !hash_stream->is_idle()) {
+    s3_log(S3_LOG_DEBUG, request_id, "Waiting for md5 of written data\n");
+    hash_stream->notify_when_idle(
+        std::bind(&S3MotrWiter::write_content_successful, this));
+    return;
+  }
   total_written += size_in_current_write;
   s3_log(S3_LOG_INFO, stripped_request_id,
          "Motr API sucessful: write(total_written = %zu)\n", total_written);
@@ -504,6 +519,12 @@ void S3MotrWiter::write_content_successful() {
 }
 
 void S3MotrWiter::write_content_failed() {
+  if (hash_stream && !hash_stream->is_idle()) {
+    // Caller may free the buffers once notified, let hashing finish first.
+    hash_stream->notify_when_idle(
+        std::bind(&S3MotrWiter::write_content_failed, this));
+    return;
+  }
   s3_log(S3_LOG_ERROR, request_id, "Write to object failed after writing %zu\n",
          total_written);
 
@@ -590,7 +611,7 @@ void S3MotrWiter::delete_objects() {
          oid_list_stream.str().c_str());
   s3_motr_api->motr_op_launch(request->addb_request_id, ctx->ops, ops_count,
                               MotrOpType::deleteobj);
-  global_motr_object_ops_list.insert(ctx);
+  global_motr_ctx_insert(global_motr_object_ops_list, ctx);
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -665,6 +686,7 @@ void S3MotrWiter::set_up_motr_data_buffers(struct s3_motr_rw_op_context *rw_ctx,
 
   size_in_current_write = 0;
   size_t buf_idx = 0;
+  S3BufferSequence buffers_to_hash;
 
   while (!buffer_sequence.empty()) {
 
@@ -681,7 +703,11 @@ void S3MotrWiter::set_up_motr_data_buffers(struct s3_motr_rw_op_context *rw_ctx,
     rw_ctx->data->ov_vec.v_count[buf_idx] = size_of_each_buf;
 
     // Here we use actual length to get md5
-    md5crypt.Update((const char *)ptr_n_len.first, len_in_buf);
+    if (hash_stream) {
+      buffers_to_hash.push_back(ptr_n_len);
+    } else if (content_md5_enabled) {
+      md5crypt.Update((const char *)ptr_n_len.first, len_in_buf);
+    }
 
     // Init motr buffer attrs.
     rw_ctx->ext->iv_index[buf_idx] = last_index;
@@ -696,6 +722,11 @@ void S3MotrWiter::set_up_motr_data_buffers(struct s3_motr_rw_op_context *rw_ctx,
     buffer_sequence.pop_front();
   }
 
+  if (!buffers_to_hash.empty()) {
+    // Buffers stay with us until write completion, which waits for this job.
+    hash_stream->submit_md5(&md5crypt, std::move(buffers_to_hash));
+  }
+
   if (buf_idx < motr_buf_count) {
     // Allocate place_holder_for_last_unit only if its required.
     // Its required when writing last block of object.
@@ -30,6 +30,7 @@
 #include "s3_asyncop_context_base.h"
 #include "s3_motr_context.h"
 #include "s3_motr_wrapper.h"
+#include "s3_hash_worker_pool.h"
 #include "s3_log.h"
 #include "s3_md5_hash.h"
 #include "s3_request_object.h"
@@ -101,10 +102,16 @@ class S3MotrWiter {
   std::string stripped_request_id;
   // md5 for the content written to motr.
   MD5hash md5crypt;
+  // When set, md5crypt is updated on a hash worker thread while the write
+  // is in flight. Write completion is reported only once the hashing of
+  // its buffers is done as well.
+  std::shared_ptr<S3HashStream> hash_stream;
 
   // maintain state for debugging.
   size_t size_in_current_write;
   size_t total_written;
+  // Whether written data goes into md5crypt.
+  bool content_md5_enabled;
 
   bool is_object_opened;
   struct s3_motr_obj_context* obj_ctx;
@@ -169,10 +176,16 @@ class S3MotrWiter {
     layout_ids.push_back(id);
   }
 
+  // Offset at which next write_content() starts.
+  virtual void set_last_index(uint64_t index) { last_index = index; }
+
   // This concludes the md5 calculation
   virtual std::string get_content_md5() {
     // Complete MD5 computation and remember
     if (content_md5.empty()) {
+      if (hash_stream) {
+        hash_stream->wait();
+      }
       md5crypt.Finalize();
       content_md5 = md5crypt.get_md5_string();
     }
@@ -185,6 +198,13 @@ class S3MotrWiter {
     return md5crypt.get_md5_base64enc_string();
   }
 
+  // For writers of data hashed elsewhere, get_content_md5() is then of no
+  // use.
+  void disable_content_md5() {
+    content_md5_enabled = false;
+    hash_stream = nullptr;
+  }
+
   // async create
   virtual void create_object(std::function<void(void)> on_success,
                              std::function<void(void)> on_failed, int layoutid);
@@ -233,6 +253,7 @@ class S3MotrWiter {
   FRIEND_TEST(S3MotrWiterTest, OpenObjectsFailedMissingTest);
   FRIEND_TEST(S3MotrWiterTest, WriteContentSuccessfulTest);
   FRIEND_TEST(S3MotrWiterTest, WriteContentFailedTest);
+  FRIEND_TEST(S3MotrWiterTest, WriteContentWithHashWorkerTest);
 };
 
 #endif
@@ -131,3 +131,17 @@ void S3ObjectAction::setup_fi_for_shutdown_tests() {
   S3_CHECK_FI_AND_SET_SHUTDOWN_SIGNAL(
       "put_object_acl_action_fetch_bucket_info_shutdown_fail");
 }
+
+bool S3ObjectAction::replaces_inline_object() {
+  return object_metadata &&
+         object_metadata->get_state() == S3ObjectMetadataState::present &&
+         object_metadata->is_inline();
+}
+
+void S3ObjectAction::remove_inline_object_version_metadata() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  object_metadata->remove_version_metadata(
+      std::bind(&S3ObjectAction::next, this),
+      std::bind(&S3ObjectAction::next, this));
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
@@ -63,6 +63,11 @@ class S3ObjectAction : public S3Action {
   // Sets appropriate Fault points for any shutdown tests.
   void setup_fi_for_shutdown_tests();
 
+  // Inline object has no motr object and so no probable delete record, its
+  // version entry is not left to background delete when it gets replaced.
+  bool replaces_inline_object();
+  void remove_inline_object_version_metadata();
+
  public:
   S3ObjectAction(std::shared_ptr<S3RequestObject> req,
                  std::shared_ptr<S3BucketMetadataFactory> bucket_meta_factory =
@@ -37,6 +37,7 @@
 #include "s3_get_object_tagging_action.h"
 #include "s3_delete_object_tagging_action.h"
 #include "s3_stats.h"
+#include "s3_upload_part_copy_action.h"
 
 void S3ObjectAPIHandler::create_action() {
   s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
@@ -77,8 +78,10 @@ void S3ObjectAPIHandler::create_action() {
           break;
         case S3HttpVerb::PUT:
           if (!request->get_header_value("x-amz-copy-source").empty()) {
-            // Copy Object in part upload not yet supported.
-            // Do nothing = unsupported API
+            // Copy (range of) object as a part
+            request->set_action_str("UploadPartCopy");
+            action = std::make_shared<S3UploadPartCopyAction>(request);
+            s3_stats_inc("upload_part_copy_request_count");
           } else {
             // Multipart part uploads
             request->set_object_size(request->get_data_length());
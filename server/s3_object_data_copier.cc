@@ -18,7 +18,11 @@
  *
  */
 
+#include <algorithm>
+#include <cstring>
+
 #include "s3_factory.h"
+#include "s3_hash_worker_pool.h"
 #include "s3_log.h"
 #include "s3_m0_uint128_helper.h"
 #include "s3_mem_pool_manager.h"
@@ -26,286 +30,455 @@
 #include "s3_motr_reader.h"
 #include "s3_motr_writer.h"
 #include "s3_object_data_copier.h"
+#include "s3_option.h"
 
 S3ObjectDataCopier::S3ObjectDataCopier(
     std::shared_ptr<RequestObject> request_object,
     std::shared_ptr<S3MotrWiter> motr_writer,
+    std::shared_ptr<S3MotrWriterFactory> motr_writer_factory,
     std::shared_ptr<S3MotrReaderFactory> motr_reader_factory,
     std::shared_ptr<MotrAPI> motr_api)
     : request_object(std::move(request_object)),
       motr_writer(std::move(motr_writer)),
+      motr_writer_factory(std::move(motr_writer_factory)),
       motr_reader_factory(std::move(motr_reader_factory)),
-      motr_api(std::move(motr_api)) {
+      motr_api(std::move(motr_api)),
+      src_obj_id{0ULL, 0ULL},
+      src_layout_id(0),
+      max_slots(1),
+      next_read_seq_no(0),
+      next_write_seq_no(0),
+      next_extent_index(0),
+      pending_length(0),
+      read_offset(0),
+      hash_wait_pending(false) {
 
   request_id = this->request_object->get_request_id();
   s3_log(S3_LOG_DEBUG, request_id, "%s Ctor\n", __func__);
 }
 
 S3ObjectDataCopier::~S3ObjectDataCopier() {
-  if (!data_blocks_writing.empty()) {
-    cleanup_blocks_written();
+  if (hash_stream) {
+    // Hash jobs may still be reading our buffers.
+    hash_stream->cancel();
   }
-  if (!data_blocks_read.empty()) {
-    data_blocks_writing = std::move(data_blocks_read);
-    cleanup_blocks_written();
+  for (auto& slot : slots) {
+    cleanup_blocks(slot.data_blocks);
   }
+  cleanup_blocks(pending_blocks);
+}
+
+size_t S3ObjectDataCopier::slots_in_flight() const {
+  return std::count_if(slots.begin(), slots.end(), [](const Slot& slot) {
+    return slot.state == SlotState::reading ||
+           slot.state == SlotState::writing ||
+           slot.state == SlotState::written;
+  });
 }
 
-void S3ObjectDataCopier::read_data_block() {
+void S3ObjectDataCopier::read_data_blocks() {
+  const size_t max_read_size = units_per_chunk * motr_unit_size;
+
+  while (!copy_failed && bytes_left_to_read) {
+    auto it = std::find_if(slots.begin(), slots.end(), [](const Slot& slot) {
+      return slot.state == SlotState::idle;
+    });
+    if (it == slots.end() && slots.size() >= max_slots) {
+      break;
+    }
+    // Reads beyond the first one use the motr read pool only while it has
+    // room for them, so a copy cannot drain it.
+    if (slots_in_flight() &&
+        S3MempoolManager::get_instance()->get_free_space_for(motr_unit_size) <
+            std::min(max_read_size, bytes_left_to_read)) {
+      s3_log(S3_LOG_DEBUG, request_id, "Motr read pool is short of buffers");
+      break;
+    }
+    size_t slot_index = it - slots.begin();
+    if (it == slots.end()) {
+      slots.emplace_back();
+      slots.back().reader = motr_reader_factory->create_motr_reader(
+          request_object, src_obj_id, src_layout_id, motr_api);
+    }
+    if (!read_data_block(slot_index)) {
+      break;
+    }
+  }
+}
+
+bool S3ObjectDataCopier::read_data_block(size_t slot_index) {
   s3_log(S3_LOG_INFO, request_id, "%s Entry\n", __func__);
 
-  assert(!read_in_progress);
-  assert(data_blocks_read.empty());
+  Slot& slot = slots[slot_index];
+  assert(slot.state == SlotState::idle);
+  assert(slot.data_blocks.empty());
   assert(bytes_left_to_read > 0);
 
+  const size_t skip = read_offset % motr_unit_size;
+  assert(contiguous_destination || !skip);
   const auto n_blocks = std::min<size_t>(
-      S3Option::get_instance()->get_motr_units_per_request(),
-      (bytes_left_to_read + motr_unit_size - 1) / motr_unit_size);
-
-  if (motr_reader->read_object_data(
-          n_blocks,
-          std::bind(&S3ObjectDataCopier::read_data_block_success, this),
-          std::bind(&S3ObjectDataCopier::read_data_block_failed, this))) {
-
-    s3_log(S3_LOG_DEBUG, request_id, "Read of %zu data block is started",
-           n_blocks);
-    read_in_progress = true;
-  } else {
-    copy_failed = true;
+      units_per_chunk,
+      (skip + bytes_left_to_read + motr_unit_size - 1) / motr_unit_size);
+
+  slot.offset = read_offset;
+  // Contiguous writes get their offset once packed, see pack_data_blocks().
+  slot.write_offset = read_offset;
+  slot.skip = skip;
+  slot.length =
+      std::min<size_t>(n_blocks * motr_unit_size - skip, bytes_left_to_read);
+  slot.seq_no = next_read_seq_no;
+
+  slot.reader->set_last_index(read_offset - skip);
+  if (!slot.reader->read_object_data(
+          n_blocks, std::bind(&S3ObjectDataCopier::read_data_block_success,
+                              this, slot_index),
+          std::bind(&S3ObjectDataCopier::read_data_block_failed, this,
+                    slot_index))) {
     s3_log(S3_LOG_ERROR, request_id, "Read of %zu data block failed to start",
            n_blocks);
-    set_s3_error(motr_reader->get_state() ==
-                         S3MotrReaderOpState::failed_to_launch
-                     ? "ServiceUnavailable"
-                     : "InternalError");
-    if (!write_in_progress) {
-      this->on_failure();
-    }
+    fail_copy(slot.reader->get_state() == S3MotrReaderOpState::failed_to_launch
+                  ? "ServiceUnavailable"
+                  : "InternalError");
+    s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+    return false;
+  }
+  s3_log(S3_LOG_DEBUG, request_id,
+         "Read of %zu data block at %zu is started in slot %zu", n_blocks,
+         (size_t)read_offset, slot_index);
+  slot.state = SlotState::reading;
+  ++next_read_seq_no;
+  read_offset += slot.length;
+  bytes_left_to_read -= slot.length;
+  if (!bytes_left_to_read) {
+    start_next_extent();
   }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+  return true;
 }
 
-void S3ObjectDataCopier::read_data_block_success() {
+void S3ObjectDataCopier::read_data_block_success(size_t slot_index) {
 
   s3_log(S3_LOG_INFO, request_id, "%s Entry\n", __func__);
   s3_log(S3_LOG_INFO, request_id, "Reading a part of data succeeded");
 
-  assert(read_in_progress);
-  read_in_progress = false;
+  Slot& slot = slots[slot_index];
+  assert(slot.state == SlotState::reading);
+  slot.state = SlotState::idle;
 
   if (check_shutdown_and_rollback()) {
     s3_log(S3_LOG_DEBUG, nullptr, "Shutdown or rollback");
     return;
   }
-  if (copy_failed) {
-    assert(!write_in_progress);
-
-    this->on_failure();
-    return;
-  }
-  assert(data_blocks_read.empty());
-  data_blocks_read = motr_reader->extract_blocks_read();
-
-  size_t bytes_in_chunk_count = 0;
-
-  if (data_blocks_read.empty()) {
-    s3_log(S3_LOG_ERROR, request_id, "Motr reader returned no data");
-
-    copy_failed = true;
-    set_s3_error("InternalError");
-
-    if (!write_in_progress) {
-      this->on_failure();
+  if (!copy_failed) {
+    assert(slot.data_blocks.empty());
+    slot.data_blocks = slot.reader->extract_blocks_read();
+
+    // Calculating actial size of data that has just been read
+    const size_t bytes_read = slot.skip + slot.length;
+    size_t bytes_in_chunk_count = 0;
+    for (size_t i = 0, n = slot.data_blocks.size(); i + 1 < n; ++i) {
+      const auto motr_block_size = slot.data_blocks[i].second;
+      assert(motr_block_size == motr_unit_size);
+
+      // We can use multiplication, but something may change in the future
+      bytes_in_chunk_count += motr_block_size;
     }
-    return;
-  }
-  // Calculating actial size of data that has just been read
-
-  for (size_t i = 0, n = data_blocks_read.size() - 1; i < n; ++i) {
-    const auto motr_block_size = data_blocks_read[i].second;
-    assert(motr_block_size == motr_unit_size);
-
-    // We can use multiplication, but something may change in the future
-    bytes_in_chunk_count += motr_block_size;
-  }
-  if (bytes_in_chunk_count >= bytes_left_to_read) {
-    s3_log(S3_LOG_ERROR, request_id,
-           "Too many data has been read. Data left - %zu, got - %zu",
-           bytes_left_to_read, bytes_in_chunk_count);
-
-    copy_failed = true;
-    set_s3_error("InternalError");
-
-    if (!write_in_progress) {
-      this->on_failure();
-    }
-    return;
-  }
-  bytes_left_to_read -= bytes_in_chunk_count;
-
-  auto& r_last_block_size =
-      data_blocks_read[data_blocks_read.size() - 1].second;
-
-  if (r_last_block_size >= bytes_left_to_read) {
-    r_last_block_size = bytes_left_to_read;
-    bytes_left_to_read = 0;
-  } else {
-    bytes_left_to_read -= r_last_block_size;
-  }
-  bytes_in_chunk_count += r_last_block_size;
-
-  s3_log(S3_LOG_DEBUG, request_id, "Got %zu bytes in %zu blocks",
-         bytes_in_chunk_count, data_blocks_read.size());
-
-  if (!write_in_progress) {
-    // Anyway we have data for writing here and can kick data writing
-    write_data_block();
-
-    if (write_in_progress && bytes_left_to_read) {
-      // Writing has started successfully.
-      // So we have 'space' for reading.
-      assert(data_blocks_read.empty());
-
-      read_data_block();
+    if (slot.data_blocks.empty()) {
+      s3_log(S3_LOG_ERROR, request_id, "Motr reader returned no data");
+      fail_copy("InternalError");
+    } else if (bytes_in_chunk_count >= bytes_read ||
+               bytes_in_chunk_count + slot.data_blocks.back().second <
+                   bytes_read) {
+      s3_log(S3_LOG_ERROR, request_id,
+             "Unexpected amount of data has been read. Expected - %zu, got - "
+             "%zu blocks",
+             bytes_read, slot.data_blocks.size());
+      fail_copy("InternalError");
+    } else {
+      slot.data_blocks.back().second = bytes_read - bytes_in_chunk_count;
+      slot.state = SlotState::read;
+      s3_log(S3_LOG_DEBUG, request_id, "Got %zu bytes in %zu blocks",
+             slot.length, slot.data_blocks.size());
     }
   }
+  proceed();
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
-void S3ObjectDataCopier::read_data_block_failed() {
+void S3ObjectDataCopier::read_data_block_failed(size_t slot_index) {
   s3_log(S3_LOG_INFO, request_id, "%s Entry\n", __func__);
   s3_log(S3_LOG_ERROR, request_id, "Failed to read object data from motr");
 
-  assert(read_in_progress);
-  read_in_progress = false;
-  copy_failed = true;
-
-  set_s3_error(motr_reader->get_state() == S3MotrReaderOpState::failed_to_launch
-                   ? "ServiceUnavailable"
-                   : "InternalError");
-  if (!write_in_progress) {
-    this->on_failure();
-  }
+  Slot& slot = slots[slot_index];
+  assert(slot.state == SlotState::reading);
+  slot.state = SlotState::idle;
 
+  fail_copy(slot.reader->get_state() == S3MotrReaderOpState::failed_to_launch
+                ? "ServiceUnavailable"
+                : "InternalError");
+  proceed();
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
-void S3ObjectDataCopier::write_data_block() {
-  s3_log(S3_LOG_INFO, request_id, "%s Entry\n", __func__);
+void S3ObjectDataCopier::write_data_blocks() {
+  // Chunks are written (and hashed) in the order they were read in.
+  while (!copy_failed) {
+    auto it =
+        std::find_if(slots.begin(), slots.end(), [this](const Slot& slot) {
+          return slot.state == SlotState::read &&
+                 slot.seq_no == next_write_seq_no;
+        });
+    if (it == slots.end()) {
+      break;
+    }
+    write_data_block(it - slots.begin());
+  }
+}
 
-  assert(!write_in_progress);
-  assert(data_blocks_writing.empty());
-  assert(!data_blocks_read.empty());
+void S3ObjectDataCopier::write_data_block(size_t slot_index) {
+  s3_log(S3_LOG_INFO, request_id, "%s Entry\n", __func__);
 
-  data_blocks_writing = std::move(data_blocks_read);
-  // We have just separated part of data for writing and
-  // also freed a 'slot' for futher reading
+  Slot& slot = slots[slot_index];
+  assert(slot.state == SlotState::read);
+  assert(!slot.data_blocks.empty());
 
-  motr_writer->write_content(
-      std::bind(&S3ObjectDataCopier::write_data_block_success, this),
-      std::bind(&S3ObjectDataCopier::write_data_block_failed, this),
-      data_blocks_writing,  // NO std::move()!
-                            // We must pass a copy of the stucture.
-                            // Data buffers will be freed just after writing.
+  if (contiguous_destination && !pack_data_blocks(slot)) {
+    s3_log(S3_LOG_ERROR, request_id, "Motr read pool is out of buffers");
+    slot.state = SlotState::idle;
+    fail_copy("ServiceUnavailable");
+    s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+    return;
+  }
+  if (slot.data_blocks.empty()) {
+    // Less than a unit of destination is packed, it waits for next chunk.
+    slot.state = SlotState::idle;
+    ++next_write_seq_no;
+    s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+    return;
+  }
+  if (!slot.writer) {
+    slot.writer = motr_writer_factory->create_motr_writer(
+        request_object, motr_writer->get_oid());
+    slot.writer->set_layout_id(motr_writer->get_layout_id());
+    slot.writer->disable_content_md5();
+  }
+  if (hash_stream) {
+    // Buffers stay with us until the hashing of them is done.
+    hash_stream->submit_md5(&md5crypt, slot.data_blocks);
+  } else {
+    for (const auto& block : slot.data_blocks) {
+      md5crypt.Update((const char*)block.first, block.second);
+    }
+  }
+  ++next_write_seq_no;
+
+  slot.writer->set_last_index(slot.write_offset);
+  slot.writer->write_content(
+      std::bind(&S3ObjectDataCopier::write_data_block_success, this,
+                slot_index),
+      std::bind(&S3ObjectDataCopier::write_data_block_failed, this,
+                slot_index),
+      slot.data_blocks,  // NO std::move()!
+                         // We must pass a copy of the stucture.
+                         // Data buffers will be freed just after writing.
       motr_unit_size);
 
-  if (motr_writer->get_state() == S3MotrWiterOpState::failed_to_launch) {
+  if (slot.writer->get_state() == S3MotrWiterOpState::failed_to_launch) {
     s3_log(S3_LOG_ERROR, request_id, "Write of data block failed to start");
-
-    copy_failed = true;
-    set_s3_error("ServiceUnavailable");
-
-    if (!read_in_progress) {
-      this->on_failure();
-    }
+    // Buffers are freed along with the copier.
+    slot.state = SlotState::idle;
+    fail_copy("ServiceUnavailable");
   } else {
-    write_in_progress = true;
+    slot.state = SlotState::writing;
   }
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
-void S3ObjectDataCopier::cleanup_blocks_written() {
+// Appends the chunk read in 'slot' to the data not written yet and gives
+// the slot back as much of it as can be written from write_offset: whole
+// units of destination, or all of it once the last chunk is read. Chunks
+// which do not follow on a buffer boundary are copied, shifting them.
+bool S3ObjectDataCopier::pack_data_blocks(Slot& slot) {
+  S3BufferSequence data_blocks;
+  data_blocks.swap(slot.data_blocks);
+
+  if (!slot.skip && pending_length % motr_unit_size == 0) {
+    pending_blocks.insert(pending_blocks.end(), data_blocks.begin(),
+                          data_blocks.end());
+    pending_length += slot.length;
+  } else {
+    size_t skip = slot.skip;
+    for (const auto& block : data_blocks) {
+      if (skip >= block.second) {
+        skip -= block.second;
+        continue;
+      }
+      const char* src = (const char*)block.first + skip;
+      size_t len = block.second - skip;
+      skip = 0;
+
+      while (len) {
+        size_t room = motr_unit_size - pending_length % motr_unit_size;
+        if (room == motr_unit_size) {
+          void* buffer =
+              S3MempoolManager::get_instance()->get_buffer_for_unit_size(
+                  motr_unit_size);
+          if (!buffer) {
+            cleanup_blocks(data_blocks);
+            return false;
+          }
+          pending_blocks.emplace_back(buffer, 0);
+        }
+        auto& last_block = pending_blocks.back();
+        const size_t n = std::min(room, len);
+
+        memcpy((char*)last_block.first + last_block.second, src, n);
+        last_block.second += n;
+        pending_length += n;
+        src += n;
+        len -= n;
+      }
+    }
+    cleanup_blocks(data_blocks);
+  }
+  const bool last_chunk =
+      !bytes_left_to_read && slot.seq_no + 1 == next_read_seq_no;
+  size_t write_length = pending_length;
+  if (!last_chunk) {
+    write_length -= pending_length % write_unit_size;
+  }
+  s3_log(S3_LOG_DEBUG, request_id, "Packed %zu bytes, %zu to be written at %zu",
+         pending_length, write_length, (size_t)write_offset);
+
+  slot.write_offset = write_offset;
+  write_offset += write_length;
+  pending_length -= write_length;
+  while (write_length) {
+    assert(pending_blocks.front().second <= write_length);
+    write_length -= pending_blocks.front().second;
+    slot.data_blocks.push_back(pending_blocks.front());
+    pending_blocks.pop_front();
+  }
+  return true;
+}
+
+void S3ObjectDataCopier::cleanup_blocks(S3BufferSequence& data_blocks) {
   auto* p_mem_pool_man = S3MempoolManager::get_instance();
   assert(p_mem_pool_man != nullptr);
 
-  while (!data_blocks_writing.empty()) {
-    auto* p_data_block = data_blocks_writing.back().first;
+  while (!data_blocks.empty()) {
+    auto* p_data_block = data_blocks.back().first;
 
     if (p_data_block) {
       p_mem_pool_man->release_buffer_for_unit_size(p_data_block,
                                                    motr_unit_size);
     }
-    data_blocks_writing.pop_back();
+    data_blocks.pop_back();
   }
 }
 
-void S3ObjectDataCopier::write_data_block_success() {
+void S3ObjectDataCopier::write_data_block_success(size_t slot_index) {
   s3_log(S3_LOG_INFO, request_id, "%s Entry\n", __func__);
 
-  assert(write_in_progress);
-  write_in_progress = false;
-
-  cleanup_blocks_written();
+  Slot& slot = slots[slot_index];
+  assert(slot.state == SlotState::writing);
 
-  if (check_shutdown_and_rollback()) {
-    s3_log(S3_LOG_DEBUG, nullptr, "Shutdown or rollback");
+  if (hash_stream && !hash_stream->is_idle()) {
+    s3_log(S3_LOG_DEBUG, request_id, "Waiting for md5 of written data\n");
+    slot.state = SlotState::written;
+    if (!hash_wait_pending) {
+      hash_wait_pending = true;
+      hash_stream->notify_when_idle(
+          std::bind(&S3ObjectDataCopier::hashing_done, this));
+    }
     return;
   }
-  if (copy_failed) {
-    assert(!read_in_progress);
+  slot.state = SlotState::idle;
+  cleanup_blocks(slot.data_blocks);
 
-    this->on_failure();
+  if (check_shutdown_and_rollback()) {
+    s3_log(S3_LOG_DEBUG, nullptr, "Shutdown or rollback");
     return;
   }
-  if (!data_blocks_read.empty()) {
-    // We have new chunk of data for writing
-    write_data_block();
+  proceed();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
 
-    if (copy_failed) {
-      // New writing failed to start
-      return;
+void S3ObjectDataCopier::hashing_done() {
+  s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+  hash_wait_pending = false;
+  for (auto& slot : slots) {
+    if (slot.state == SlotState::written) {
+      slot.state = SlotState::idle;
+      cleanup_blocks(slot.data_blocks);
     }
   }
-  assert(!copy_failed);
-  assert(data_blocks_read.empty());
-
-  if (bytes_left_to_read) {
-
-    if (!read_in_progress) {
-      read_data_block();
-    }
-  } else if (!write_in_progress) {
-    // We have read all source's data but the call of write_data_block()
-    // did not start writing.
-    // It means that the function did not find data ready for writing.
-    // So all data has been written.
-    this->on_success();
+  if (check_shutdown_and_rollback()) {
+    s3_log(S3_LOG_DEBUG, nullptr, "Shutdown or rollback");
+    return;
   }
-  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+  proceed();
 }
 
-void S3ObjectDataCopier::write_data_block_failed() {
+void S3ObjectDataCopier::write_data_block_failed(size_t slot_index) {
   s3_log(S3_LOG_INFO, request_id, "%s Entry\n", __func__);
   s3_log(S3_LOG_ERROR, request_id, "Failed to write object data to motr");
 
-  assert(write_in_progress);
-  write_in_progress = false;
+  Slot& slot = slots[slot_index];
+  assert(slot.state == SlotState::writing);
+  // Buffers are freed along with the copier, hashing may still use them.
+  slot.state = SlotState::idle;
 
-  copy_failed = true;
+  fail_copy(slot.writer->get_state() == S3MotrWiterOpState::failed_to_launch
+                ? "ServiceUnavailable"
+                : "InternalError");
+  proceed();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
 
-  cleanup_blocks_written();
+void S3ObjectDataCopier::proceed() {
+  write_data_blocks();
+  read_data_blocks();
 
-  set_s3_error(motr_writer->get_state() == S3MotrWiterOpState::failed_to_launch
-                   ? "ServiceUnavailable"
-                   : "InternalError");
-  if (!read_in_progress) {
+  if (slots_in_flight()) {
+    return;
+  }
+  // May destroy the copier, nothing is to be done after the callbacks.
+  if (copy_failed) {
     this->on_failure();
+  } else if (!bytes_left_to_read) {
+    // We have read all source's data and nothing is being written.
+    assert(std::all_of(slots.begin(), slots.end(), [](const Slot& slot) {
+      return slot.state == SlotState::idle;
+    }));
+    this->on_success();
+  }
+}
+
+void S3ObjectDataCopier::fail_copy(std::string s3_error) {
+  copy_failed = true;
+  if (this->s3_error.empty()) {
+    set_s3_error(std::move(s3_error));
   }
-  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+bool S3ObjectDataCopier::start_next_extent() {
+  while (next_extent_index < extents.size()) {
+    const S3ObjectExtent& extent = extents[next_extent_index++];
+    if (extent.length) {
+      s3_log(S3_LOG_DEBUG, request_id, "Copying extent %zu:%zu", extent.offset,
+             extent.length);
+      read_offset = extent.offset;
+      bytes_left_to_read = extent.length;
+      return true;
+    }
+  }
+  return false;
 }
 
 void S3ObjectDataCopier::copy(
     struct m0_uint128 src_obj_id, size_t object_size, int layout_id,
+    std::vector<S3ObjectExtent> extents,
     std::function<bool(void)> check_shutdown_and_rollback,
     std::function<void(void)> on_success,
     std::function<void(void)> on_failure) {
@@ -321,25 +494,78 @@ void S3ObjectDataCopier::copy(
   this->check_shutdown_and_rollback = std::move(check_shutdown_and_rollback);
   this->on_success = std::move(on_success);
   this->on_failure = std::move(on_failure);
+  this->src_obj_id = src_obj_id;
+  src_layout_id = layout_id;
 
   motr_unit_size =
       S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(layout_id);
-
-  motr_reader = motr_reader_factory->create_motr_reader(
+  pending_length = 0;
+
+  // Writer pads the last unit of every write, so chunks shall be whole
+  // units of destination too not to overwrite each other. Unit sizes are
+  // powers of two.
+  S3Option* option_instance = S3Option::get_instance();
+  const size_t dst_unit_size =
+      S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
+          motr_writer->get_layout_id());
+  units_per_chunk =
+      std::max<size_t>(option_instance->get_motr_units_per_request(),
+                       dst_unit_size / motr_unit_size);
+  write_unit_size = std::max(dst_unit_size, motr_unit_size);
+
+  // Every slot in flight holds up to a read worth of motr read pool buffers.
+  const size_t slot_size = units_per_chunk * motr_unit_size;
+  max_slots = std::max<size_t>(
+      1, std::min<size_t>(
+             option_instance->get_motr_copy_pipeline_depth(),
+             option_instance->get_motr_read_pool_max_threshold() / slot_size));
+  s3_log(S3_LOG_DEBUG, request_id, "Copying with up to %zu slots", max_slots);
+
+  slots.clear();
+  // Callbacks refer to slots by index, they are never moved.
+  slots.reserve(max_slots);
+  slots.emplace_back();
+  slots[0].reader = motr_reader_factory->create_motr_reader(
       request_object, src_obj_id, layout_id, motr_api);
-  motr_reader->set_last_index(0);
+  slots[0].writer = motr_writer;
+  motr_writer->disable_content_md5();
+  if (S3HashWorkerPool::get_instance()) {
+    hash_stream = S3HashWorkerPool::get_instance()->create_stream();
+  }
 
-  bytes_left_to_read = object_size;
+  if (extents.empty()) {
+    extents.push_back({0, object_size});
+  }
+  this->extents = std::move(extents);
+  next_extent_index = 0;
+  bytes_left_to_read = 0;
+  start_next_extent();
 
   copy_failed = false;
-  read_in_progress = false;
-  write_in_progress = false;
+  next_read_seq_no = 0;
+  next_write_seq_no = 0;
 
-  read_data_block();
+  proceed();
 
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
+void S3ObjectDataCopier::set_destination_offset(uint64_t offset) {
+  contiguous_destination = true;
+  write_offset = offset;
+}
+
+std::string S3ObjectDataCopier::get_content_md5() {
+  if (content_md5.empty()) {
+    if (hash_stream) {
+      hash_stream->wait();
+    }
+    md5crypt.Finalize();
+    content_md5 = md5crypt.get_md5_string();
+  }
+  return content_md5;
+}
+
 void S3ObjectDataCopier::set_s3_error(std::string s3_error) {
   this->s3_error = std::move(s3_error);
 }
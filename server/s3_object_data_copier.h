@@ -23,16 +23,21 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest_prod.h>
 
 #include "lib/types.h"  // struct m0_uint128
 #include "s3_buffer_sequence.h"
+#include "s3_md5_hash.h"
+#include "s3_object_metadata.h"
 
 class RequestObject;
+class S3HashStream;
 class S3MotrReader;
 class S3MotrReaderFactory;
 class S3MotrWiter;
+class S3MotrWriterFactory;
 
 class S3ObjectDataCopier {
 
@@ -45,60 +50,141 @@ class S3ObjectDataCopier {
 
   std::shared_ptr<RequestObject> request_object;
   std::shared_ptr<S3MotrWiter> motr_writer;
+  std::shared_ptr<S3MotrWriterFactory> motr_writer_factory;
   std::shared_ptr<S3MotrReaderFactory> motr_reader_factory;
   std::shared_ptr<MotrAPI> motr_api;
-  std::shared_ptr<S3MotrReader> motr_reader;
 
-  S3BufferSequence data_blocks_read;     // Source's data has been read but not
-                                         // taken for writing.
-  S3BufferSequence data_blocks_writing;  // Source's data currently beeing
-                                         // written
+  struct m0_uint128 src_obj_id;
+  int src_layout_id;
+
+  enum class SlotState {
+    idle,
+    reading,
+    read,  // Source's data has been read but not taken for writing.
+    writing,
+    written  // Buffers are still being hashed.
+  };
+
+  // Source's data is read and written in chunks of up to
+  // motr_units_per_request units, each going through one of the slots.
+  // Several slots are in flight at a time, see S3_MOTR_COPY_PIPELINE_DEPTH.
+  struct Slot {
+    std::shared_ptr<S3MotrReader> reader;
+    std::shared_ptr<S3MotrWiter> writer;
+    SlotState state = SlotState::idle;
+    S3BufferSequence data_blocks;
+    // Offset of the chunk in source and destination objects, its length and
+    // its position in the copy. Chunks are written in the order they were
+    // read in.
+    uint64_t offset = 0;
+    uint64_t write_offset = 0;
+    size_t length = 0;
+    uint64_t seq_no = 0;
+    // Bytes read ahead of the chunk, as reads start at a unit boundary of
+    // source.
+    size_t skip = 0;
+  };
+  std::vector<Slot> slots;
+  size_t max_slots;
+  uint64_t next_read_seq_no;
+  uint64_t next_write_seq_no;
+
+  // Source's data is copied extent by extent, to the same offsets in
+  // destination object unless it is written contiguously from
+  // write_offset, see set_destination_offset(). Copies to the same offsets
+  // need extents starting at unit boundaries of source.
+  std::vector<S3ObjectExtent> extents;
+  size_t next_extent_index;
+  bool contiguous_destination = false;
+  uint64_t write_offset = 0;
+  // Data written contiguously is shifted into these buffers when it does
+  // not start at a unit boundary of destination, see pack_data_blocks().
+  S3BufferSequence pending_blocks;
+  size_t pending_length;
 
   // All POD variables should be (re)initialized in This::copy()
+  // Next offset to read and bytes left to read in current extent.
+  uint64_t read_offset;
   size_t bytes_left_to_read;
   size_t motr_unit_size;
+  // Units of source read per chunk, chunks are whole units of destination.
+  size_t units_per_chunk;
+  // Every write but the last one is whole units of both objects.
+  size_t write_unit_size;
   bool copy_failed;
-  bool read_in_progress;
-  bool write_in_progress;
-
-  void cleanup_blocks_written();
-  void read_data_block();
-  void read_data_block_success();
-  void read_data_block_failed();
-  void write_data_block();
-  void write_data_block_success();
-  void write_data_block_failed();
+
+  // md5 of the copied data, hashed in order on a hash worker if there are
+  // any. Writers do not hash, as each of them sees a part of the data only.
+  MD5hash md5crypt;
+  std::string content_md5;
+  std::shared_ptr<S3HashStream> hash_stream;
+  bool hash_wait_pending;
+
+  size_t slots_in_flight() const;
+  void cleanup_blocks(S3BufferSequence& data_blocks);
+  bool start_next_extent();
+  void read_data_blocks();
+  bool read_data_block(size_t slot_index);
+  void read_data_block_success(size_t slot_index);
+  void read_data_block_failed(size_t slot_index);
+  bool pack_data_blocks(Slot& slot);
+  void write_data_blocks();
+  void write_data_block(size_t slot_index);
+  void write_data_block_success(size_t slot_index);
+  void write_data_block_failed(size_t slot_index);
+  void hashing_done();
+  // Starts what can be started and reports the outcome once all is done.
+  void proceed();
+  void fail_copy(std::string s3_error);
   void set_s3_error(std::string);
 
  public:
   S3ObjectDataCopier(std::shared_ptr<RequestObject> request_object,
                      std::shared_ptr<S3MotrWiter> motr_writer,
+                     std::shared_ptr<S3MotrWriterFactory> motr_writer_factory,
                      std::shared_ptr<S3MotrReaderFactory> motr_reader_factory,
                      std::shared_ptr<MotrAPI> motr_api);
 
   ~S3ObjectDataCopier();
 
+  // Empty 'extents' means source's data is contiguous from offset 0.
   void copy(struct m0_uint128 src_obj_id, size_t object_size, int layout_id,
+            std::vector<S3ObjectExtent> extents,
             std::function<bool(void)> check_shutdown_and_rollback,
             std::function<void(void)> on_success,
             std::function<void(void)> on_failure);
 
+  // Makes copy() write source's data contiguously from 'offset' of
+  // destination object instead of at the offsets it has in source.
+  void set_destination_offset(uint64_t offset);
+
   const std::string& get_s3_error() { return s3_error; }
 
+  // md5 of the data copied, valid once the copy succeeded.
+  std::string get_content_md5();
+
   friend class S3ObjectDataCopierTest;
 
   FRIEND_TEST(S3ObjectDataCopierTest, ReadDataBlockStarted);
   FRIEND_TEST(S3ObjectDataCopierTest, ReadDataBlockFailedToStart);
+  FRIEND_TEST(S3ObjectDataCopierTest, ReadDataBlocksFillsSlots);
+  FRIEND_TEST(S3ObjectDataCopierTest, ReadDataBlockToDestinationOffset);
   FRIEND_TEST(S3ObjectDataCopierTest, ReadDataBlockSuccessWhileShuttingDown);
   FRIEND_TEST(S3ObjectDataCopierTest, ReadDataBlockSuccessCopyFailed);
   FRIEND_TEST(S3ObjectDataCopierTest, ReadDataBlockSuccessShouldStartWrite);
+  FRIEND_TEST(S3ObjectDataCopierTest, ReadDataBlockSuccessOutOfOrder);
   FRIEND_TEST(S3ObjectDataCopierTest, ReadDataBlockFailed);
+  FRIEND_TEST(S3ObjectDataCopierTest, ReadDataBlockSuccessStartsNextExtent);
+  FRIEND_TEST(S3ObjectDataCopierTest, ReadDataBlockOfUnalignedExtent);
+  FRIEND_TEST(S3ObjectDataCopierTest, ReadDataBlockSuccessOfUnalignedExtent);
+  FRIEND_TEST(S3ObjectDataCopierTest, WriteShiftedDataKeepsPartialUnit);
+  FRIEND_TEST(S3ObjectDataCopierTest, WriteShiftedDataOfLastChunk);
   FRIEND_TEST(S3ObjectDataCopierTest, WriteObjectStarted);
   FRIEND_TEST(S3ObjectDataCopierTest, WriteObjectFailedShouldUndoMarkProgress);
   FRIEND_TEST(S3ObjectDataCopierTest, WriteObjectFailedDuetoEntityOpenFailure);
   FRIEND_TEST(S3ObjectDataCopierTest, WriteObjectSuccessfulWhileShuttingDown);
   FRIEND_TEST(S3ObjectDataCopierTest,
-              WriteObjectSuccessfulShouldRestartWritingData);
+              WriteObjectSuccessfulShouldRestartReadingData);
   FRIEND_TEST(S3ObjectDataCopierTest,
               WriteObjectSuccessfulDoNextStepWhenAllIsWritten);
 };
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <assert.h>
+#include <json/json.h>
+#include <utility>
+
+#include "s3_datetime.h"
+#include "s3_log.h"
+#include "s3_m0_uint128_helper.h"
+#include "s3_object_data_ref_record.h"
+
+S3ObjectDataRefRecord::S3ObjectDataRefRecord(
+    struct m0_uint128 oid, int layout_id, std::string obj_key_in_index,
+    struct m0_uint128 obj_list_idx_oid)
+    : data_oid(oid),
+      object_layout_id(layout_id),
+      object_key_in_index(std::move(obj_key_in_index)),
+      object_list_idx_oid(obj_list_idx_oid) {
+  // Assertions
+  s3_log(S3_LOG_DEBUG, "", "data_oid = %" SCNx64 " : %" SCNx64 "\n",
+         data_oid.u_hi, data_oid.u_lo);
+  assert(data_oid.u_hi || data_oid.u_lo);
+  s3_log(S3_LOG_DEBUG, "", "object_key_in_index = %s\n",
+         object_key_in_index.c_str());
+  assert(!object_key_in_index.empty());
+  assert(object_list_idx_oid.u_hi || object_list_idx_oid.u_lo);
+}
+
+std::string S3ObjectDataRefRecord::get_key_prefix(struct m0_uint128 oid) {
+  return S3M0Uint128Helper::to_string(oid) + '/';
+}
+
+std::string S3ObjectDataRefRecord::get_key() const {
+  return get_key_prefix(data_oid) +
+         S3M0Uint128Helper::to_string(object_list_idx_oid) + '/' +
+         object_key_in_index;
+}
+
+std::string S3ObjectDataRefRecord::to_json() {
+  Json::Value root;
+
+  // data oid and referring object are part of the key, still they are kept
+  // in json so that background delete need not parse the key.
+  root["motr_oid"] = S3M0Uint128Helper::to_string(data_oid);
+  root["object_layout_id"] = object_layout_id;
+  root["object_key_in_index"] = object_key_in_index;
+  root["object_list_index_oid"] =
+      S3M0Uint128Helper::to_string(object_list_idx_oid);
+
+  S3DateTime current_time;
+  current_time.init_current_time();
+  root["create_timestamp"] = current_time.get_isoformat_string();
+
+  Json::FastWriter fastWriter;
+  return fastWriter.write(root);
+}
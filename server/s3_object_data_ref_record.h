@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_OBJECT_DATA_REF_RECORD_H__
+#define __S3_SERVER_S3_OBJECT_DATA_REF_RECORD_H__
+
+#include <string>
+
+#include "s3_motr_rw_common.h"
+
+// Record is stored as a value in global object data refs index, one for each
+// object referring data of a motr object shared by several objects (see
+// CopyObject). The "key" is
+//    data oid + '/' + object list index oid + '/' + object key
+// so that all the references to data are listed by data oid + '/' prefix.
+// Background delete removes the data only when none of referring objects is
+// present any more in its object list index with same data oid.
+
+class S3ObjectDataRefRecord {
+  struct m0_uint128 data_oid;
+  int object_layout_id;
+  std::string object_key_in_index;        // key of referring object
+  struct m0_uint128 object_list_idx_oid;  // index of referring object
+
+ public:
+  S3ObjectDataRefRecord(struct m0_uint128 oid, int layout_id,
+                        std::string obj_key_in_index,
+                        struct m0_uint128 obj_list_idx_oid);
+  virtual ~S3ObjectDataRefRecord() {}
+
+  static std::string get_key_prefix(struct m0_uint128 oid);
+  virtual std::string get_key() const;
+
+  virtual std::string to_json();
+};
+
+#endif
@@ -36,7 +36,9 @@ S3ObjectListResponse::S3ObjectListResponse(std::string encoding_type)
       max_uploads(""),
       next_marker_uploadid(""),
       key_count(""),
-      response_xml("") {
+      response_xml(""),
+      streaming(false),
+      streamed_count(0) {
   s3_log(S3_LOG_DEBUG, "", "%s Ctor\n", __func__);
   object_list.clear();
   part_list.clear();
@@ -119,12 +121,29 @@ void S3ObjectListResponse::set_next_marker_uploadid(std::string next) {
 
 std::string& S3ObjectListResponse::get_object_name() { return object_name; }
 
+void S3ObjectListResponse::enable_streaming(
+    const std::string& requestor_canonical_id,
+    const std::string& bucket_owner_user_id,
+    const std::string& requestor_user_id) {
+  streaming = true;
+  this->requestor_canonical_id = requestor_canonical_id;
+  this->bucket_owner_user_id = bucket_owner_user_id;
+  this->requestor_user_id = requestor_user_id;
+}
+
 void S3ObjectListResponse::add_object(
     std::shared_ptr<S3ObjectMetadata> object) {
-  object_list.push_back(object);
+  if (streaming) {
+    append_contents_xml(contents_xml, *object);
+    ++streamed_count;
+  } else {
+    object_list.push_back(object);
+  }
 }
 
-unsigned int S3ObjectListResponse::size() { return object_list.size(); }
+unsigned int S3ObjectListResponse::size() {
+  return object_list.size() + streamed_count;
+}
 
 unsigned int S3ObjectListResponse::common_prefixes_size() {
   return common_prefixes.size();
@@ -195,64 +214,65 @@ std::string S3ObjectListResponse::get_next_marker_key() {
   return raw_value;
 }
 
-std::string& S3ObjectListResponse::get_xml(
-    const std::string requestor_canonical_id,
-    const std::string bucket_owner_user_id,
-    const std::string requestor_user_id) {
+bool S3ObjectListResponse::is_owner_visible(S3ObjectMetadata& object) {
+  return requestor_canonical_id == object.get_canonical_id() ||
+         bucket_owner_user_id == requestor_user_id;
+}
+
+void S3ObjectListResponse::append_contents_xml(std::string& xml,
+                                               S3ObjectMetadata& object) {
   // clang-format off
-  response_xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>";
-  response_xml +=
-      "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">";
-  response_xml += S3CommonUtilities::format_xml_string("Name", bucket_name);
-  response_xml +=
-      S3CommonUtilities::format_xml_string("Prefix", request_prefix);
+  xml += "<Contents>";
+  xml += S3CommonUtilities::format_xml_string(
+      "Key", get_response_format_key_value(object.get_object_name()));
+  xml += S3CommonUtilities::format_xml_string(
+      "LastModified", object.get_last_modified_iso());
+  xml += S3CommonUtilities::format_xml_string("ETag", object.get_md5(), true);
+  xml += S3CommonUtilities::format_xml_string(
+      "Size", object.get_content_length_str());
+  xml += S3CommonUtilities::format_xml_string(
+      "StorageClass", object.get_storage_class());
+  if (is_owner_visible(object)) {
+    xml += "<Owner>";
+    xml += S3CommonUtilities::format_xml_string("ID",
+                                                object.get_canonical_id());
+    xml += S3CommonUtilities::format_xml_string("DisplayName",
+                                                object.get_account_name());
+    xml += "</Owner>";
+  }
+  xml += "</Contents>";
+  // clang-format on
+}
+
+void S3ObjectListResponse::append_xml_head(std::string& xml) {
+  // clang-format off
+  xml += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>";
+  xml += "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">";
+  xml += S3CommonUtilities::format_xml_string("Name", bucket_name);
+  xml += S3CommonUtilities::format_xml_string("Prefix", request_prefix);
   // When 'Delimiter' is specified in the request, the response should have
   // 'Delimiter'
   if (!this->get_request_delimiter().empty()) {
-    response_xml +=
-        S3CommonUtilities::format_xml_string("Delimiter", request_delimiter);
+    xml += S3CommonUtilities::format_xml_string("Delimiter", request_delimiter);
   }
   if (encoding_type == "url") {
-    response_xml += S3CommonUtilities::format_xml_string("EncodingType", "url");
+    xml += S3CommonUtilities::format_xml_string("EncodingType", "url");
   }
-  response_xml +=
-      S3CommonUtilities::format_xml_string("Marker", request_marker_key);
-  response_xml += S3CommonUtilities::format_xml_string("MaxKeys", max_keys);
+  xml += S3CommonUtilities::format_xml_string("Marker", request_marker_key);
+  xml += S3CommonUtilities::format_xml_string("MaxKeys", max_keys);
   // When is_truncated is true, the response should have "NextMarker".
   // Refer AWS S3 ListObjects documentation for NextMarker.
   if (this->response_is_truncated) {
-    response_xml +=
-        S3CommonUtilities::format_xml_string("NextMarker", next_marker_key);
+    xml += S3CommonUtilities::format_xml_string("NextMarker", next_marker_key);
   }
-  response_xml += S3CommonUtilities::format_xml_string(
+  xml += S3CommonUtilities::format_xml_string(
       "IsTruncated", (response_is_truncated ? "true" : "false"));
+  // clang-format on
+}
 
-  for (auto&& object : object_list) {
-    response_xml += "<Contents>";
-    response_xml += S3CommonUtilities::format_xml_string(
-        "Key", get_response_format_key_value(object->get_object_name()));
-    response_xml += S3CommonUtilities::format_xml_string(
-        "LastModified", object->get_last_modified_iso());
-    response_xml +=
-        S3CommonUtilities::format_xml_string("ETag", object->get_md5(), true);
-    response_xml += S3CommonUtilities::format_xml_string(
-        "Size", object->get_content_length_str());
-    response_xml += S3CommonUtilities::format_xml_string(
-        "StorageClass", object->get_storage_class());
-    if (requestor_canonical_id == object->get_canonical_id() ||
-        bucket_owner_user_id == requestor_user_id) {
-    response_xml += "<Owner>";
-    response_xml +=
-        S3CommonUtilities::format_xml_string("ID", object->get_canonical_id());
-    response_xml += S3CommonUtilities::format_xml_string(
-        "DisplayName", object->get_account_name());
-    response_xml += "</Owner>";
-    }
-    response_xml += "</Contents>";
-  }
-
+void S3ObjectListResponse::append_xml_tail(std::string& xml) {
   for (auto&& prefix : common_prefixes) {
-    response_xml += "<CommonPrefixes>";
+    xml += "<CommonPrefixes>";
     std::string prefix_no_delimiter = prefix;
     // Remove the delimiter from the end
     prefix_no_delimiter.pop_back();
@@ -260,13 +280,39 @@ std::string& S3ObjectListResponse::get_xml(
         get_response_format_key_value(prefix_no_delimiter);
     // Add the delimiter at the end
     uri_encode_prefix += request_delimiter;
-    response_xml +=
-        S3CommonUtilities::format_xml_string("Prefix", uri_encode_prefix);
-    response_xml += "</CommonPrefixes>";
+    xml += S3CommonUtilities::format_xml_string("Prefix", uri_encode_prefix);
+    xml += "</CommonPrefixes>";
   }
+  xml += "</ListBucketResult>";
+}
 
-  response_xml += "</ListBucketResult>";
-  // clang-format on
+std::string S3ObjectListResponse::get_xml_head() {
+  std::string xml;
+  append_xml_head(xml);
+  return xml;
+}
+
+std::string S3ObjectListResponse::get_xml_tail() {
+  std::string xml;
+  append_xml_tail(xml);
+  return xml;
+}
+
+std::string& S3ObjectListResponse::get_xml(
+    const std::string requestor_canonical_id,
+    const std::string bucket_owner_user_id,
+    const std::string requestor_user_id) {
+  this->requestor_canonical_id = requestor_canonical_id;
+  this->bucket_owner_user_id = bucket_owner_user_id;
+  this->requestor_user_id = requestor_user_id;
+
+  response_xml.clear();
+  append_xml_head(response_xml);
+  response_xml += contents_xml;
+  for (auto&& object : object_list) {
+    append_contents_xml(response_xml, *object);
+  }
+  append_xml_tail(response_xml);
   return response_xml;
 }
 
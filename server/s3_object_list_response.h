@@ -60,7 +60,22 @@ class S3ObjectListResponse {
   std::string key_count;
   std::string response_xml;
 
+  // In streaming mode add_object() serializes each <Contents> entry into
+  // contents_xml right away and drops the object metadata, so a listing page
+  // never holds max_keys metadata objects at once.
+  bool streaming;
+  unsigned int streamed_count;
+  std::string contents_xml;
+  // Used to decide whether <Owner> is included in the <Contents> entries.
+  std::string requestor_canonical_id;
+  std::string bucket_owner_user_id;
+  std::string requestor_user_id;
+
   std::string get_response_format_key_value(const std::string& key_value);
+  virtual bool is_owner_visible(S3ObjectMetadata& object);
+  void append_contents_xml(std::string& xml, S3ObjectMetadata& object);
+  virtual void append_xml_head(std::string& xml);
+  void append_xml_tail(std::string& xml);
 
  public:
   S3ObjectListResponse(std::string encoding_type = "");
@@ -96,6 +111,10 @@ class S3ObjectListResponse {
   }
   std::string get_encoding_type() { return encoding_type; }
 
+  void enable_streaming(const std::string& requestor_canonical_id,
+                        const std::string& bucket_owner_user_id,
+                        const std::string& requestor_user_id);
+  bool is_streaming() { return streaming; }
   void add_object(std::shared_ptr<S3ObjectMetadata> object);
   void add_part(std::shared_ptr<S3PartMetadata> part);
   void add_common_prefix(std::string);
@@ -106,6 +125,12 @@ class S3ObjectListResponse {
   virtual std::string& get_xml(const std::string requestor_canonical_id,
                                const std::string bucket_owner_user_id,
                                const std::string requestor_user_id);
+  // Pieces of get_xml() for sending the response in chunks: the head up to
+  // <IsTruncated>, the <Contents> entries serialized in streaming mode, and
+  // the common prefixes with the closing tag.
+  std::string get_xml_head();
+  std::string& get_contents_xml() { return contents_xml; }
+  std::string get_xml_tail();
   std::string& get_multipart_xml();
   std::string& get_multiupload_xml();
   std::string& get_user_id();
@@ -148,6 +173,9 @@ class S3ObjectListResponse {
               ObjectListMultipartResponseWithValidObjectNotTruncated);
   FRIEND_TEST(S3ObjectListResponseTest,
               ObjectListMultipartResponseWithValidObjectTruncated);
+  FRIEND_TEST(S3ObjectListResponseTest,
+              StreamingObjectListResponseMatchesGetXml);
+  FRIEND_TEST(S3ObjectListResponseTest, ObjectListResponseBenchmark1000Keys);
 };
 
 #endif
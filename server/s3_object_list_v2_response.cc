@@ -47,87 +47,52 @@ void S3ObjectListResponseV2::set_start_after(
   start_after = in_start_after;
 }
 
-std::string& S3ObjectListResponseV2::get_xml(
-    const std::string& requestor_canonical_id,
-    const std::string& bucket_owner_user_id,
-    const std::string& requestor_user_id) {
+bool S3ObjectListResponseV2::is_owner_visible(S3ObjectMetadata& object) {
+  return fetch_owner;
+}
+
+void S3ObjectListResponseV2::append_xml_head(std::string& xml) {
   // clang-format off
-  response_xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>";
-  response_xml +=
-      "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">";
-  response_xml += S3CommonUtilities::format_xml_string("Name", bucket_name);
-  response_xml +=
-      S3CommonUtilities::format_xml_string("Prefix", request_prefix);
+  xml += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>";
+  xml += "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">";
+  xml += S3CommonUtilities::format_xml_string("Name", bucket_name);
+  xml += S3CommonUtilities::format_xml_string("Prefix", request_prefix);
   // When 'Delimiter' is specified in the request, the response should have
   // 'Delimiter'
   if (!this->get_request_delimiter().empty()) {
-    response_xml +=
-        S3CommonUtilities::format_xml_string("Delimiter", request_delimiter);
+    xml += S3CommonUtilities::format_xml_string("Delimiter", request_delimiter);
   }
   if (encoding_type == "url") {
-    response_xml += S3CommonUtilities::format_xml_string("EncodingType", "url");
+    xml += S3CommonUtilities::format_xml_string("EncodingType", "url");
   }
-  response_xml += S3CommonUtilities::format_xml_string("KeyCount", key_count);
+  xml += S3CommonUtilities::format_xml_string("KeyCount", key_count);
   // If 'continuation-token' specified in original request, include it in the
   // response
   if (cont_token_specified) {
-    response_xml += S3CommonUtilities::format_xml_string("ContinuationToken",
-                                                         continuation_token);
+    xml += S3CommonUtilities::format_xml_string("ContinuationToken",
+                                                continuation_token);
   }
-  response_xml += S3CommonUtilities::format_xml_string("MaxKeys", max_keys);
+  xml += S3CommonUtilities::format_xml_string("MaxKeys", max_keys);
   // When is_truncated is true, the response should have
   // "NextContinuationToken".
   // Refer AWS S3 ListObjects V2 documentation for NextContinuationToken.
   if (this->response_is_truncated) {
-    response_xml += S3CommonUtilities::format_xml_string(
-        "NextContinuationToken", next_marker_key);
+    xml += S3CommonUtilities::format_xml_string("NextContinuationToken",
+                                                next_marker_key);
   }
   // If 'start-after' specified in request, include it in response
   if (!start_after.empty()) {
-    response_xml +=
-        S3CommonUtilities::format_xml_string("StartAfter", start_after);
+    xml += S3CommonUtilities::format_xml_string("StartAfter", start_after);
   }
-  response_xml += S3CommonUtilities::format_xml_string(
+  xml += S3CommonUtilities::format_xml_string(
       "IsTruncated", (response_is_truncated ? "true" : "false"));
-
-  for (auto&& object : object_list) {
-    response_xml += "<Contents>";
-    response_xml += S3CommonUtilities::format_xml_string(
-        "Key", get_response_format_key_value(object->get_object_name()));
-    response_xml += S3CommonUtilities::format_xml_string(
-        "LastModified", object->get_last_modified_iso());
-    response_xml +=
-        S3CommonUtilities::format_xml_string("ETag", object->get_md5(), true);
-    response_xml += S3CommonUtilities::format_xml_string(
-        "Size", object->get_content_length_str());
-    response_xml += S3CommonUtilities::format_xml_string(
-        "StorageClass", object->get_storage_class());
-    if (this->fetch_owner) {
-      response_xml += "<Owner>";
-      response_xml += S3CommonUtilities::format_xml_string(
-          "ID", object->get_canonical_id());
-      response_xml += S3CommonUtilities::format_xml_string(
-          "DisplayName", object->get_account_name());
-      response_xml += "</Owner>";
-    }
-    response_xml += "</Contents>";
-  }
-
-  for (auto&& prefix : common_prefixes) {
-    response_xml += "<CommonPrefixes>";
-    std::string prefix_no_delimiter = prefix;
-    // Remove the delimiter from the end
-    prefix_no_delimiter.pop_back();
-    std::string uri_encode_prefix =
-        get_response_format_key_value(prefix_no_delimiter);
-    // Add the delimiter at the end
-    uri_encode_prefix += request_delimiter;
-    response_xml +=
-        S3CommonUtilities::format_xml_string("Prefix", uri_encode_prefix);
-    response_xml += "</CommonPrefixes>";
-  }
-
-  response_xml += "</ListBucketResult>";
   // clang-format on
-  return response_xml;
+}
+
+std::string& S3ObjectListResponseV2::get_xml(
+    const std::string& requestor_canonical_id,
+    const std::string& bucket_owner_user_id,
+    const std::string& requestor_user_id) {
+  return S3ObjectListResponse::get_xml(
+      requestor_canonical_id, bucket_owner_user_id, requestor_user_id);
 }
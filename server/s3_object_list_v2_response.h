@@ -37,6 +37,10 @@ class S3ObjectListResponseV2 : public S3ObjectListResponse {
   // Continuation-token presen in original request
   bool cont_token_specified;
 
+ protected:
+  bool is_owner_visible(S3ObjectMetadata &object) override;
+  void append_xml_head(std::string &xml) override;
+
  public:
   S3ObjectListResponseV2(const std::string &encoding_type = "");
 
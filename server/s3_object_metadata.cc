@@ -27,12 +27,15 @@
 #include "s3_datetime.h"
 #include "s3_factory.h"
 #include "s3_iem.h"
+#include "s3_json_scanner.h"
 #include "s3_log.h"
+#include "s3_metadata_codec.h"
 #include "s3_object_metadata.h"
 #include "s3_object_versioning_helper.h"
 #include "s3_uri_to_motr_oid.h"
 #include "s3_common_utilities.h"
 #include "s3_m0_uint128_helper.h"
+#include "s3_option.h"
 #include "s3_stats.h"
 
 extern struct m0_uint128 global_instance_id;
@@ -273,6 +276,59 @@ size_t S3ObjectMetadata::get_part_one_size() {
   }
 }
 
+void S3ObjectMetadata::set_part_slot_size(size_t slot_size) {
+  system_defined_attribute["Part-Slot-Size"] = std::to_string(slot_size);
+}
+
+size_t S3ObjectMetadata::get_part_slot_size() {
+  auto it = system_defined_attribute.find("Part-Slot-Size");
+  if (it == system_defined_attribute.end() || it->second.empty()) {
+    return 0;
+  }
+  return std::stoul(it->second);
+}
+
+// Stored as "offset:length,offset:length,..."
+void S3ObjectMetadata::set_extents(const std::vector<S3ObjectExtent>& extents) {
+  std::string value;
+  for (const auto& extent : extents) {
+    if (!value.empty()) {
+      value += ",";
+    }
+    value +=
+        std::to_string(extent.offset) + ":" + std::to_string(extent.length);
+  }
+  if (value.empty()) {
+    system_defined_attribute.erase("Part-Extents");
+  } else {
+    system_defined_attribute["Part-Extents"] = value;
+  }
+}
+
+std::vector<S3ObjectExtent> S3ObjectMetadata::get_extents() {
+  std::vector<S3ObjectExtent> extents;
+  auto it = system_defined_attribute.find("Part-Extents");
+  if (it == system_defined_attribute.end()) {
+    return extents;
+  }
+  const char* pos = it->second.c_str();
+  while (*pos) {
+    char* end = nullptr;
+    S3ObjectExtent extent;
+    extent.offset = strtoull(pos, &end, 10);
+    if (*end != ':') {
+      break;
+    }
+    extent.length = strtoull(end + 1, &end, 10);
+    extents.push_back(extent);
+    if (*end != ',') {
+      break;
+    }
+    pos = end + 1;
+  }
+  return extents;
+}
+
 void S3ObjectMetadata::set_md5(std::string md5) {
   system_defined_attribute["Content-MD5"] = md5;
 }
@@ -286,6 +342,18 @@ void S3ObjectMetadata::set_oid(struct m0_uint128 id) {
   motr_oid_str = S3M0Uint128Helper::to_string(oid);
 }
 
+void S3ObjectMetadata::set_inline_data(const std::string& data) {
+  is_inline_object = true;
+  encoded_inline_data = base64_encode(
+      reinterpret_cast<const unsigned char*>(data.data()), data.length());
+  oid = {0ULL, 0ULL};
+  motr_oid_str = S3M0Uint128Helper::to_string(oid);
+}
+
+std::string S3ObjectMetadata::get_inline_data() {
+  return base64_decode(encoded_inline_data);
+}
+
 void S3ObjectMetadata::set_version_id(std::string ver_id) {
   object_version_id = ver_id;
   rev_epoch_version_id_key =
@@ -440,7 +508,10 @@ void S3ObjectMetadata::save_metadata() {
   motr_kv_writer =
       mote_kv_writer_factory->create_motr_kvs_writer(request, s3_motr_api);
   motr_kv_writer->put_keyval(
-      object_list_index_oid, object_name, this->to_json(),
+      object_list_index_oid, object_name,
+      S3Option::get_instance()->is_s3server_metadata_binary_encoding_enabled()
+          ? this->to_binary()
+          : this->to_json(),
       std::bind(&S3ObjectMetadata::save_metadata_successful, this),
       std::bind(&S3ObjectMetadata::save_metadata_failed, this));
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
@@ -582,6 +653,9 @@ std::string S3ObjectMetadata::to_json() {
   }
 
   root["motr_oid"] = motr_oid_str;
+  if (is_inline_object) {
+    root["inline_data"] = encoded_inline_data;
+  }
 
   for (auto sit : system_defined_attribute) {
     root["System-Defined"][sit.first] = sit.second;
@@ -609,6 +683,49 @@ std::string S3ObjectMetadata::to_json() {
   ;
 }
 
+std::string S3ObjectMetadata::to_binary() {
+  s3_log(S3_LOG_DEBUG, request_id, "Called\n");
+  std::string record;
+  S3MetadataEncoder encoder(record, S3MetadataRecord::object);
+  encoder.add_string(S3MetadataField::bucket_name, bucket_name);
+  encoder.add_string(S3MetadataField::object_name, object_name);
+  encoder.add_string(S3MetadataField::object_uri, object_key_uri);
+  encoder.add_integer(S3MetadataField::layout_id, layout_id);
+
+  if (is_multipart) {
+    encoder.add_string(S3MetadataField::upload_id, upload_id);
+    encoder.add_string(S3MetadataField::motr_part_oid, motr_part_oid_str);
+    encoder.add_string(S3MetadataField::motr_old_oid, motr_old_oid_str);
+    encoder.add_integer(S3MetadataField::old_layout_id, old_layout_id);
+    encoder.add_string(S3MetadataField::motr_old_object_version_id,
+                       motr_old_object_version_id);
+  }
+
+  encoder.add_string(S3MetadataField::motr_oid, motr_oid_str);
+  if (is_inline_object) {
+    encoder.add_base64(S3MetadataField::inline_data,
+                       S3MetadataField::inline_data_as_stored,
+                       encoded_inline_data);
+  }
+
+  encoder.add_map(S3MetadataField::system_defined, system_defined_attribute);
+  if (!user_defined_attribute.empty()) {
+    encoder.add_map(S3MetadataField::user_defined, user_defined_attribute);
+  }
+  if (!object_tags.empty()) {
+    encoder.add_map(S3MetadataField::user_defined_tags, object_tags);
+  }
+  encoder.add_base64(
+      S3MetadataField::acl, S3MetadataField::acl_as_stored,
+      encoded_acl == "" ? request->get_default_acl() : encoded_acl);
+
+  S3DateTime current_time;
+  current_time.init_current_time();
+  encoder.add_string(S3MetadataField::create_timestamp,
+                     current_time.get_isoformat_string());
+  return record;
+}
+
 // Streaming to json
 std::string S3ObjectMetadata::version_entry_to_json() {
   s3_log(S3_LOG_DEBUG, request_id, "Called\n");
@@ -656,6 +773,9 @@ std::string S3ObjectMetadata::version_entry_to_json() {
 int S3ObjectMetadata::from_json(std::string content) {
   s3_log(S3_LOG_DEBUG, request_id, "Called with content [%s]\n",
          content.c_str());
+  if (s3_is_binary_metadata(content)) {
+    return from_binary(content);
+  }
   Json::Value newroot;
   Json::Reader reader;
   bool parsingSuccessful = reader.parse(content.c_str(), newroot);
@@ -674,6 +794,10 @@ int S3ObjectMetadata::from_json(std::string content) {
   layout_id = newroot["layout_id"].asInt();
 
   oid = S3M0Uint128Helper::to_m0_uint128(motr_oid_str);
+  is_inline_object = newroot.isMember("inline_data");
+  if (is_inline_object) {
+    encoded_inline_data = newroot["inline_data"].asString();
+  }
 
   //
   // Old oid is needed to remove the OID when the object already exists
@@ -719,6 +843,157 @@ int S3ObjectMetadata::from_json(std::string content) {
   return 0;
 }
 
+static bool is_listing_attribute(const std::string& name) {
+  return name == "Content-Length" || name == "Content-MD5" ||
+         name == "Last-Modified" || name == "x-amz-storage-class" ||
+         name == "Owner-Canonical-id" || name == "Owner-Account" ||
+         name == "Owner-User" || name == "Owner-User-id" ||
+         name == "Owner-Account-id";
+}
+
+int S3ObjectMetadata::from_listing_json(const std::string& content) {
+  if (s3_is_binary_metadata(content)) {
+    return from_binary(content, true);
+  }
+  S3JsonScanner scanner(content);
+  std::string key, value;
+
+  if (scanner.enter_object()) {
+    while (scanner.next_member(key)) {
+      if (key == "Bucket-Name") {
+        scanner.read_string(bucket_name);
+      } else if (key == "Object-Name") {
+        scanner.read_string(object_name);
+      } else if (key == "System-Defined" && scanner.enter_object()) {
+        while (scanner.next_member(key)) {
+          if (is_listing_attribute(key) && scanner.read_string(value)) {
+            system_defined_attribute[key] = value;
+          } else {
+            scanner.skip_value();
+          }
+        }
+      } else {
+        scanner.skip_value();
+      }
+    }
+  }
+  if (scanner.failed() || s3_fi_is_enabled("object_metadata_corrupted")) {
+    s3_log(S3_LOG_ERROR, request_id, "Json Parsing failed\n");
+    return -1;
+  }
+
+  user_name = system_defined_attribute["Owner-User"];
+  canonical_id = system_defined_attribute["Owner-Canonical-id"];
+  user_id = system_defined_attribute["Owner-User-id"];
+  account_name = system_defined_attribute["Owner-Account"];
+  account_id = system_defined_attribute["Owner-Account-id"];
+
+  return 0;
+}
+
+int S3ObjectMetadata::from_binary(const std::string& content,
+                                  bool listing_only) {
+  S3MetadataDecoder decoder(content);
+  S3MetadataField field;
+  int64_t number;
+
+  while (decoder.next_field(field)) {
+    if (listing_only && field != S3MetadataField::bucket_name &&
+        field != S3MetadataField::object_name &&
+        field != S3MetadataField::system_defined) {
+      decoder.skip_field();
+      continue;
+    }
+    switch (field) {
+      case S3MetadataField::bucket_name:
+        decoder.read_string(bucket_name);
+        break;
+      case S3MetadataField::object_name:
+        decoder.read_string(object_name);
+        break;
+      case S3MetadataField::object_uri:
+        decoder.read_string(object_key_uri);
+        break;
+      case S3MetadataField::layout_id:
+        if (decoder.read_integer(number)) {
+          layout_id = (int)number;
+        }
+        break;
+      case S3MetadataField::upload_id:
+        decoder.read_string(upload_id);
+        break;
+      case S3MetadataField::motr_part_oid:
+        decoder.read_string(motr_part_oid_str);
+        break;
+      case S3MetadataField::motr_old_oid:
+        decoder.read_string(motr_old_oid_str);
+        break;
+      case S3MetadataField::old_layout_id:
+        if (decoder.read_integer(number)) {
+          old_layout_id = (int)number;
+        }
+        break;
+      case S3MetadataField::motr_old_object_version_id:
+        decoder.read_string(motr_old_object_version_id);
+        break;
+      case S3MetadataField::motr_oid:
+        decoder.read_string(motr_oid_str);
+        break;
+      case S3MetadataField::inline_data:
+        is_inline_object = true;
+        decoder.read_base64(encoded_inline_data);
+        break;
+      case S3MetadataField::inline_data_as_stored:
+        is_inline_object = true;
+        decoder.read_string(encoded_inline_data);
+        break;
+      case S3MetadataField::system_defined:
+        decoder.read_map(system_defined_attribute);
+        break;
+      case S3MetadataField::user_defined:
+        decoder.read_map(user_defined_attribute);
+        break;
+      case S3MetadataField::user_defined_tags:
+        decoder.read_map(object_tags);
+        break;
+      case S3MetadataField::acl:
+        decoder.read_base64(encoded_acl);
+        break;
+      case S3MetadataField::acl_as_stored:
+        decoder.read_string(encoded_acl);
+        break;
+      default:
+        decoder.skip_field();
+        break;
+    }
+  }
+  if (decoder.failed() ||
+      decoder.record_type() != S3MetadataRecord::object ||
+      s3_fi_is_enabled("object_metadata_corrupted")) {
+    s3_log(S3_LOG_ERROR, request_id, "Binary metadata parsing failed\n");
+    return -1;
+  }
+
+  user_name = system_defined_attribute["Owner-User"];
+  canonical_id = system_defined_attribute["Owner-Canonical-id"];
+  user_id = system_defined_attribute["Owner-User-id"];
+  account_name = system_defined_attribute["Owner-Account"];
+  account_id = system_defined_attribute["Owner-Account-id"];
+  if (listing_only) {
+    return 0;
+  }
+
+  oid = S3M0Uint128Helper::to_m0_uint128(motr_oid_str);
+  if (is_multipart) {
+    old_oid = S3M0Uint128Helper::to_m0_uint128(motr_old_oid_str);
+  }
+  part_index_oid = S3M0Uint128Helper::to_m0_uint128(motr_part_oid_str);
+  object_version_id = system_defined_attribute["x-amz-version-id"];
+  rev_epoch_version_id_key =
+      S3ObjectVersioingHelper::generate_keyid_from_versionid(object_version_id);
+  return 0;
+}
+
 void S3ObjectMetadata::acl_from_json(std::string acl_json_str) {
   s3_log(S3_LOG_DEBUG, "", "Called\n");
   encoded_acl = acl_json_str;
@@ -28,6 +28,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "s3_bucket_metadata.h"
 #include "s3_motr_kvs_reader.h"
@@ -46,6 +47,13 @@ enum class S3ObjectMetadataState {
   invalid
 };
 
+// Placement of a piece of object data within its motr object, pieces are
+// listed in the order they appear in the object.
+struct S3ObjectExtent {
+  size_t offset;  // Offset within motr object.
+  size_t length;
+};
+
 // Forward declarations.
 class S3MotrKVSReaderFactory;
 class S3MotrKVSWriterFactory;
@@ -117,6 +125,10 @@ class S3ObjectMetadata : private S3ObjectMetadataCopyable {
 
   bool is_multipart = false;
 
+  // Data of a small object kept in its metadata, base64 encoded.
+  bool is_inline_object = false;
+  std::string encoded_inline_data;
+
   std::shared_ptr<S3MotrKVSReader> motr_kv_reader;
   std::shared_ptr<S3MotrKVSWriter> motr_kv_writer;
   std::shared_ptr<S3BucketMetadata> bucket_metadata;
@@ -192,6 +204,14 @@ class S3ObjectMetadata : private S3ObjectMetadataCopyable {
   virtual void set_part_one_size(const size_t& part_size);
   virtual std::string get_md5();
 
+  // Multipart uploads with part slots write part N at (N - 1) * slot size,
+  // 0 means parts are laid out back to back (part one size based).
+  virtual void set_part_slot_size(size_t slot_size);
+  virtual size_t get_part_slot_size();
+  // Empty when object data is contiguous from offset 0.
+  virtual void set_extents(const std::vector<S3ObjectExtent>& extents);
+  virtual std::vector<S3ObjectExtent> get_extents();
+
   virtual void set_oid(struct m0_uint128 id);
   void set_old_oid(struct m0_uint128 id);
   void acl_from_json(std::string acl_json_str);
@@ -204,6 +224,12 @@ class S3ObjectMetadata : private S3ObjectMetadataCopyable {
 
   virtual struct m0_uint128 get_old_oid() { return old_oid; }
 
+  // Inline object has its data stored in metadata and no motr object, its
+  // oid is zero.
+  void set_inline_data(const std::string& data);
+  std::string get_inline_data();
+  bool is_inline() const { return is_inline_object; }
+
   struct m0_uint128 get_part_index_oid() const { return part_index_oid; }
 
   void regenerate_version_id();
@@ -257,8 +283,8 @@ class S3ObjectMetadata : private S3ObjectMetadataCopyable {
   // Remove object metadata from object list index & versions list index
   virtual void remove(std::function<void(void)> on_success,
                       std::function<void(void)> on_failed);
-  void remove_version_metadata(std::function<void(void)> on_success,
-                               std::function<void(void)> on_failed);
+  virtual void remove_version_metadata(std::function<void(void)> on_success,
+                                       std::function<void(void)> on_failed);
 
   virtual S3ObjectMetadataState get_state() { return state; }
 
@@ -267,11 +293,22 @@ class S3ObjectMetadata : private S3ObjectMetadataCopyable {
 
   // For object metadata in object listing
   std::string to_json();
+  // Compact form of to_json(), see s3_metadata_codec.h
+  std::string to_binary();
   // For storing minimal version entry in version listing
   std::string version_entry_to_json();
 
+  // Reads both json and binary records.
   // returns 0 on success, -1 on parsing error.
   virtual int from_json(std::string content);
+  // 'listing_only' reads just what from_listing_json() reads.
+  // returns 0 on success, -1 on parsing error.
+  int from_binary(const std::string& content, bool listing_only = false);
+  // Object listing only needs key, size, mtime, ETag, storage class and
+  // owner. Pulls just those out of the json without building the whole
+  // document; other getters return empty values afterwards.
+  // returns 0 on success, -1 on parsing error.
+  virtual int from_listing_json(const std::string& content);
   virtual void setacl(const std::string& input_acl);
   virtual void set_tags(const std::map<std::string, std::string>& tags_as_map);
   virtual const std::map<std::string, std::string>& get_tags();
@@ -343,6 +380,10 @@ class S3ObjectMetadata : private S3ObjectMetadataCopyable {
   FRIEND_TEST(S3ObjectMetadataTest, RemoveVersionMetadataFailed);
   FRIEND_TEST(S3ObjectMetadataTest, ToJson);
   FRIEND_TEST(S3ObjectMetadataTest, FromJson);
+  FRIEND_TEST(S3ObjectMetadataTest, FromListingJson);
+  FRIEND_TEST(S3ObjectMetadataTest, InlineDataToJsonFromJson);
+  FRIEND_TEST(S3ObjectMetadataTest, ToBinaryFromBinary);
+  FRIEND_TEST(S3ObjectMetadataTest, BinaryRecordAsJson);
   FRIEND_TEST(S3MultipartObjectMetadataTest, FromJson);
   FRIEND_TEST(S3ObjectMetadataTest, GetEncodedBucketAcl);
 };
@@ -27,6 +27,7 @@
 #include "s3_common_utilities.h"
 
 S3Option* S3Option::option_instance = NULL;
+thread_local evbase_t* S3Option::thread_eventbase = NULL;
 
 bool S3Option::load_section(std::string section_name,
                             bool force_override_from_config = false) {
@@ -112,6 +113,11 @@ bool S3Option::load_section(std::string section_name,
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_LOG_FLUSH_FREQUENCY");
       log_flush_frequency_sec =
           s3_option_node["S3_LOG_FLUSH_FREQUENCY"].as<int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_LOG_ASYNC_ENABLED");
+      log_async_enable = s3_option_node["S3_LOG_ASYNC_ENABLED"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_LOG_ASYNC_BUFFER_SIZE_KB");
+      log_async_buffer_size_kb =
+          s3_option_node["S3_LOG_ASYNC_BUFFER_SIZE_KB"].as<unsigned>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_SERVER_IPV4_BIND_ADDR");
       s3_ipv4_bind_addr =
           s3_option_node["S3_SERVER_IPV4_BIND_ADDR"].as<std::string>();
@@ -137,6 +143,63 @@ bool S3Option::load_section(std::string section_name,
                                "S3_SERVER_OBJECT_DELAYED_DELETE");
       s3server_obj_delayed_del_enabled =
           s3_option_node["S3_SERVER_OBJECT_DELAYED_DELETE"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_SERVER_COPY_OBJECT_SHARE_DATA");
+      s3server_copy_object_share_data =
+          s3_option_node["S3_SERVER_COPY_OBJECT_SHARE_DATA"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_SERVER_OBJECT_INLINE_MAX_SIZE");
+      s3server_object_inline_max_size =
+          s3_option_node["S3_SERVER_OBJECT_INLINE_MAX_SIZE"].as<size_t>();
+      if (s3server_object_inline_max_size > S3_OBJECT_INLINE_MAX_SIZE_LIMIT) {
+        S3_OPTION_VALUE_INVALID_AND_RET(
+            "S3_SERVER_OBJECT_INLINE_MAX_SIZE",
+            std::to_string(s3server_object_inline_max_size));
+      }
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_SERVER_METADATA_BINARY_ENCODING");
+      s3server_metadata_binary_encoding_enabled =
+          s3_option_node["S3_SERVER_METADATA_BINARY_ENCODING"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_ENABLED");
+      qos_enabled = s3_option_node["S3_QOS_ENABLED"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_QOS_ACCOUNT_BANDWIDTH_LIMIT");
+      qos_account_bandwidth_limit =
+          s3_option_node["S3_QOS_ACCOUNT_BANDWIDTH_LIMIT"].as<size_t>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_ACCOUNT_IOPS_LIMIT");
+      qos_account_iops_limit =
+          s3_option_node["S3_QOS_ACCOUNT_IOPS_LIMIT"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_BUCKET_BANDWIDTH_LIMIT");
+      qos_bucket_bandwidth_limit =
+          s3_option_node["S3_QOS_BUCKET_BANDWIDTH_LIMIT"].as<size_t>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_BUCKET_IOPS_LIMIT");
+      qos_bucket_iops_limit =
+          s3_option_node["S3_QOS_BUCKET_IOPS_LIMIT"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_BURST_MSEC");
+      qos_burst_msec = s3_option_node["S3_QOS_BURST_MSEC"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_MAX_QUEUE_DEPTH");
+      qos_max_queue_depth =
+          s3_option_node["S3_QOS_MAX_QUEUE_DEPTH"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_MAX_QUEUE_WAIT_MSEC");
+      qos_max_queue_wait_msec =
+          s3_option_node["S3_QOS_MAX_QUEUE_WAIT_MSEC"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_METRICS_INTERVAL_SEC");
+      qos_metrics_interval_sec =
+          s3_option_node["S3_QOS_METRICS_INTERVAL_SEC"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_ACCOUNT_WEIGHTS");
+      qos_account_weights.clear();
+      for (auto weight : s3_option_node["S3_QOS_ACCOUNT_WEIGHTS"]) {
+        qos_account_weights[weight.first.as<std::string>()] =
+            weight.second.as<unsigned>();
+      }
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_SERVER_MULTIPART_PART_SLOTS");
+      multipart_part_slots_enabled =
+          s3_option_node["S3_SERVER_MULTIPART_PART_SLOTS"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_SERVER_LIST_RESPONSE_STREAMING");
+      list_response_streaming_enabled =
+          s3_option_node["S3_SERVER_LIST_RESPONSE_STREAMING"].as<bool>();
 
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_READ_AHEAD_MULTIPLE");
       read_ahead_multiple = s3_option_node["S3_READ_AHEAD_MULTIPLE"].as<int>();
@@ -158,6 +221,39 @@ bool S3Option::load_section(std::string section_name,
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_RETRY_INTERVAL_MILLISEC");
       retry_interval_millisec =
           s3_option_node["S3_RETRY_INTERVAL_MILLISEC"].as<unsigned short>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_REACTOR_THREADS");
+      reactor_threads =
+          s3_option_node["S3_REACTOR_THREADS"].as<unsigned short>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MEMPOOL_THREAD_CACHE");
+      mempool_thread_cache =
+          s3_option_node["S3_MEMPOOL_THREAD_CACHE"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_HASH_WORKER_THREADS");
+      hash_worker_threads =
+          s3_option_node["S3_HASH_WORKER_THREADS"].as<unsigned short>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_BUCKET_METADATA_CACHE_MAX_ENTRIES");
+      bucket_metadata_cache_max_entries =
+          s3_option_node["S3_BUCKET_METADATA_CACHE_MAX_ENTRIES"]
+              .as<unsigned int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_BUCKET_METADATA_CACHE_TTL_MILLISEC");
+      bucket_metadata_cache_ttl_millisec =
+          s3_option_node["S3_BUCKET_METADATA_CACHE_TTL_MILLISEC"]
+              .as<unsigned int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_CACHE_MAX_ENTRIES");
+      auth_cache_max_entries =
+          s3_option_node["S3_AUTH_CACHE_MAX_ENTRIES"].as<unsigned int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_CACHE_TTL_MILLISEC");
+      auth_cache_ttl_millisec =
+          s3_option_node["S3_AUTH_CACHE_TTL_MILLISEC"].as<unsigned int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_CONNECTION_POOL_SIZE");
+      auth_connection_pool_size =
+          s3_option_node["S3_AUTH_CONNECTION_POOL_SIZE"].as<unsigned int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_AUTH_CONNECTION_IDLE_TIMEOUT_MILLISEC");
+      auth_connection_idle_timeout_millisec =
+          s3_option_node["S3_AUTH_CONNECTION_IDLE_TIMEOUT_MILLISEC"]
+              .as<unsigned int>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node,
                                "S3_CLIENT_REQ_READ_TIMEOUT_SECS");
       s3_client_req_read_timeout_secs =
@@ -172,6 +268,12 @@ bool S3Option::load_section(std::string section_name,
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_STATSD_MAX_SEND_RETRY");
       statsd_max_send_retry =
           s3_option_node["S3_STATSD_MAX_SEND_RETRY"].as<unsigned short>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_STATSD_FLUSH_INTERVAL_MSEC");
+      statsd_flush_interval_msec =
+          s3_option_node["S3_STATSD_FLUSH_INTERVAL_MSEC"].as<unsigned int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_STATSD_MAX_PACKET_SIZE");
+      statsd_max_packet_size =
+          s3_option_node["S3_STATSD_MAX_PACKET_SIZE"].as<unsigned int>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_STATS_ALLOWLIST_FILENAME");
       stats_allowlist_filename =
           s3_option_node["S3_STATS_ALLOWLIST_FILENAME"].as<std::string>();
@@ -201,6 +303,9 @@ bool S3Option::load_section(std::string section_name,
       auth_port = s3_option_node["S3_AUTH_PORT"].as<unsigned short>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_IP_ADDR");
       auth_ip_addr = s3_option_node["S3_AUTH_IP_ADDR"].as<std::string>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_SIGNING_KEY_SECRET");
+      auth_signing_key_secret =
+          s3_option_node["S3_AUTH_SIGNING_KEY_SECRET"].as<std::string>();
     } else if (section_name == "S3_MOTR_CONFIG") {
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_LOCAL_ADDR");
       motr_local_addr = s3_option_node["S3_MOTR_LOCAL_ADDR"].as<std::string>();
@@ -220,9 +325,23 @@ bool S3Option::load_section(std::string section_name,
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_MAX_UNITS_PER_REQUEST");
       motr_units_per_request =
           s3_option_node["S3_MOTR_MAX_UNITS_PER_REQUEST"].as<unsigned short>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_COPY_PIPELINE_DEPTH");
+      motr_copy_pipeline_depth =
+          s3_option_node["S3_MOTR_COPY_PIPELINE_DEPTH"].as<int>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_MAX_IDX_FETCH_COUNT");
       motr_idx_fetch_count =
           s3_option_node["S3_MOTR_MAX_IDX_FETCH_COUNT"].as<int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_IDX_PREFETCH_ENABLED");
+      motr_idx_prefetch_enabled =
+          s3_option_node["S3_MOTR_IDX_PREFETCH_ENABLED"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_MOTR_IDX_PREFETCH_MAX_COUNT");
+      motr_idx_prefetch_max_count =
+          s3_option_node["S3_MOTR_IDX_PREFETCH_MAX_COUNT"].as<int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_MOTR_IDX_PREFETCH_LATENCY_MS");
+      motr_idx_prefetch_latency_ms =
+          s3_option_node["S3_MOTR_IDX_PREFETCH_LATENCY_MS"].as<int>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_IS_OOSTORE");
       motr_is_oostore = s3_option_node["S3_MOTR_IS_OOSTORE"].as<bool>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_IS_READ_VERIFY");
@@ -261,6 +380,13 @@ bool S3Option::load_section(std::string section_name,
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_FIRST_READ_SIZE");
       motr_first_obj_read_size =
           s3_option_node["S3_MOTR_FIRST_READ_SIZE"].as<unsigned int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_MAX_READ_AHEAD_DEPTH");
+      motr_max_read_ahead_depth =
+          s3_option_node["S3_MOTR_MAX_READ_AHEAD_DEPTH"].as<unsigned short>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_MOTR_CTX_POOL_MAX_THRESHOLD");
+      motr_ctx_pool_max_threshold =
+          s3_option_node["S3_MOTR_CTX_POOL_MAX_THRESHOLD"].as<size_t>();
 
       std::string motr_read_pool_initial_buffer_count_str;
       std::string motr_read_pool_expandable_count_str;
@@ -440,6 +566,63 @@ bool S3Option::load_section(std::string section_name,
                                "S3_SERVER_OBJECT_DELAYED_DELETE");
       s3server_obj_delayed_del_enabled =
           s3_option_node["S3_SERVER_OBJECT_DELAYED_DELETE"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_SERVER_COPY_OBJECT_SHARE_DATA");
+      s3server_copy_object_share_data =
+          s3_option_node["S3_SERVER_COPY_OBJECT_SHARE_DATA"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_SERVER_OBJECT_INLINE_MAX_SIZE");
+      s3server_object_inline_max_size =
+          s3_option_node["S3_SERVER_OBJECT_INLINE_MAX_SIZE"].as<size_t>();
+      if (s3server_object_inline_max_size > S3_OBJECT_INLINE_MAX_SIZE_LIMIT) {
+        S3_OPTION_VALUE_INVALID_AND_RET(
+            "S3_SERVER_OBJECT_INLINE_MAX_SIZE",
+            std::to_string(s3server_object_inline_max_size));
+      }
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_SERVER_METADATA_BINARY_ENCODING");
+      s3server_metadata_binary_encoding_enabled =
+          s3_option_node["S3_SERVER_METADATA_BINARY_ENCODING"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_ENABLED");
+      qos_enabled = s3_option_node["S3_QOS_ENABLED"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_QOS_ACCOUNT_BANDWIDTH_LIMIT");
+      qos_account_bandwidth_limit =
+          s3_option_node["S3_QOS_ACCOUNT_BANDWIDTH_LIMIT"].as<size_t>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_ACCOUNT_IOPS_LIMIT");
+      qos_account_iops_limit =
+          s3_option_node["S3_QOS_ACCOUNT_IOPS_LIMIT"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_BUCKET_BANDWIDTH_LIMIT");
+      qos_bucket_bandwidth_limit =
+          s3_option_node["S3_QOS_BUCKET_BANDWIDTH_LIMIT"].as<size_t>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_BUCKET_IOPS_LIMIT");
+      qos_bucket_iops_limit =
+          s3_option_node["S3_QOS_BUCKET_IOPS_LIMIT"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_BURST_MSEC");
+      qos_burst_msec = s3_option_node["S3_QOS_BURST_MSEC"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_MAX_QUEUE_DEPTH");
+      qos_max_queue_depth =
+          s3_option_node["S3_QOS_MAX_QUEUE_DEPTH"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_MAX_QUEUE_WAIT_MSEC");
+      qos_max_queue_wait_msec =
+          s3_option_node["S3_QOS_MAX_QUEUE_WAIT_MSEC"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_METRICS_INTERVAL_SEC");
+      qos_metrics_interval_sec =
+          s3_option_node["S3_QOS_METRICS_INTERVAL_SEC"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_QOS_ACCOUNT_WEIGHTS");
+      qos_account_weights.clear();
+      for (auto weight : s3_option_node["S3_QOS_ACCOUNT_WEIGHTS"]) {
+        qos_account_weights[weight.first.as<std::string>()] =
+            weight.second.as<unsigned>();
+      }
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_SERVER_MULTIPART_PART_SLOTS");
+      multipart_part_slots_enabled =
+          s3_option_node["S3_SERVER_MULTIPART_PART_SLOTS"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_SERVER_LIST_RESPONSE_STREAMING");
+      list_response_streaming_enabled =
+          s3_option_node["S3_SERVER_LIST_RESPONSE_STREAMING"].as<bool>();
 
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_READ_AHEAD_MULTIPLE");
       read_ahead_multiple = s3_option_node["S3_READ_AHEAD_MULTIPLE"].as<int>();
@@ -452,6 +635,39 @@ bool S3Option::load_section(std::string section_name,
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_RETRY_INTERVAL_MILLISEC");
       retry_interval_millisec =
           s3_option_node["S3_RETRY_INTERVAL_MILLISEC"].as<unsigned short>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_REACTOR_THREADS");
+      reactor_threads =
+          s3_option_node["S3_REACTOR_THREADS"].as<unsigned short>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MEMPOOL_THREAD_CACHE");
+      mempool_thread_cache =
+          s3_option_node["S3_MEMPOOL_THREAD_CACHE"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_HASH_WORKER_THREADS");
+      hash_worker_threads =
+          s3_option_node["S3_HASH_WORKER_THREADS"].as<unsigned short>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_BUCKET_METADATA_CACHE_MAX_ENTRIES");
+      bucket_metadata_cache_max_entries =
+          s3_option_node["S3_BUCKET_METADATA_CACHE_MAX_ENTRIES"]
+              .as<unsigned int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_BUCKET_METADATA_CACHE_TTL_MILLISEC");
+      bucket_metadata_cache_ttl_millisec =
+          s3_option_node["S3_BUCKET_METADATA_CACHE_TTL_MILLISEC"]
+              .as<unsigned int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_CACHE_MAX_ENTRIES");
+      auth_cache_max_entries =
+          s3_option_node["S3_AUTH_CACHE_MAX_ENTRIES"].as<unsigned int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_CACHE_TTL_MILLISEC");
+      auth_cache_ttl_millisec =
+          s3_option_node["S3_AUTH_CACHE_TTL_MILLISEC"].as<unsigned int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_CONNECTION_POOL_SIZE");
+      auth_connection_pool_size =
+          s3_option_node["S3_AUTH_CONNECTION_POOL_SIZE"].as<unsigned int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_AUTH_CONNECTION_IDLE_TIMEOUT_MILLISEC");
+      auth_connection_idle_timeout_millisec =
+          s3_option_node["S3_AUTH_CONNECTION_IDLE_TIMEOUT_MILLISEC"]
+              .as<unsigned int>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node,
                                "S3_CLIENT_REQ_READ_TIMEOUT_SECS");
       s3_client_req_read_timeout_secs =
@@ -466,11 +682,22 @@ bool S3Option::load_section(std::string section_name,
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_LOG_FLUSH_FREQUENCY");
       log_flush_frequency_sec =
           s3_option_node["S3_LOG_FLUSH_FREQUENCY"].as<int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_LOG_ASYNC_ENABLED");
+      log_async_enable = s3_option_node["S3_LOG_ASYNC_ENABLED"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_LOG_ASYNC_BUFFER_SIZE_KB");
+      log_async_buffer_size_kb =
+          s3_option_node["S3_LOG_ASYNC_BUFFER_SIZE_KB"].as<unsigned>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_ENABLE_STATS");
       stats_enable = s3_option_node["S3_ENABLE_STATS"].as<bool>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_STATSD_MAX_SEND_RETRY");
       statsd_max_send_retry =
           s3_option_node["S3_STATSD_MAX_SEND_RETRY"].as<unsigned short>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_STATSD_FLUSH_INTERVAL_MSEC");
+      statsd_flush_interval_msec =
+          s3_option_node["S3_STATSD_FLUSH_INTERVAL_MSEC"].as<unsigned int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_STATSD_MAX_PACKET_SIZE");
+      statsd_max_packet_size =
+          s3_option_node["S3_STATSD_MAX_PACKET_SIZE"].as<unsigned int>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_STATS_ALLOWLIST_FILENAME");
       stats_allowlist_filename =
           s3_option_node["S3_STATS_ALLOWLIST_FILENAME"].as<std::string>();
@@ -515,6 +742,9 @@ bool S3Option::load_section(std::string section_name,
         S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_IP_ADDR");
         auth_ip_addr = s3_option_node["S3_AUTH_IP_ADDR"].as<std::string>();
       }
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_AUTH_SIGNING_KEY_SECRET");
+      auth_signing_key_secret =
+          s3_option_node["S3_AUTH_SIGNING_KEY_SECRET"].as<std::string>();
     } else if (section_name == "S3_MOTR_CONFIG") {
       if (!(cmd_opt_flag & S3_OPTION_MOTR_LOCAL_ADDR)) {
         S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_LOCAL_ADDR");
@@ -541,9 +771,23 @@ bool S3Option::load_section(std::string section_name,
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_MAX_UNITS_PER_REQUEST");
       motr_units_per_request =
           s3_option_node["S3_MOTR_MAX_UNITS_PER_REQUEST"].as<unsigned short>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_COPY_PIPELINE_DEPTH");
+      motr_copy_pipeline_depth =
+          s3_option_node["S3_MOTR_COPY_PIPELINE_DEPTH"].as<int>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_MAX_IDX_FETCH_COUNT");
       motr_idx_fetch_count =
           s3_option_node["S3_MOTR_MAX_IDX_FETCH_COUNT"].as<int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_IDX_PREFETCH_ENABLED");
+      motr_idx_prefetch_enabled =
+          s3_option_node["S3_MOTR_IDX_PREFETCH_ENABLED"].as<bool>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_MOTR_IDX_PREFETCH_MAX_COUNT");
+      motr_idx_prefetch_max_count =
+          s3_option_node["S3_MOTR_IDX_PREFETCH_MAX_COUNT"].as<int>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_MOTR_IDX_PREFETCH_LATENCY_MS");
+      motr_idx_prefetch_latency_ms =
+          s3_option_node["S3_MOTR_IDX_PREFETCH_LATENCY_MS"].as<int>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_IS_OOSTORE");
       motr_is_oostore = s3_option_node["S3_MOTR_IS_OOSTORE"].as<bool>();
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_IS_READ_VERIFY");
@@ -572,6 +816,13 @@ bool S3Option::load_section(std::string section_name,
       S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_OPERATION_WAIT_PERIOD");
       motr_op_wait_period =
           s3_option_node["S3_MOTR_OPERATION_WAIT_PERIOD"].as<unsigned>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node, "S3_MOTR_MAX_READ_AHEAD_DEPTH");
+      motr_max_read_ahead_depth =
+          s3_option_node["S3_MOTR_MAX_READ_AHEAD_DEPTH"].as<unsigned short>();
+      S3_OPTION_ASSERT_AND_RET(s3_option_node,
+                               "S3_MOTR_CTX_POOL_MAX_THRESHOLD");
+      motr_ctx_pool_max_threshold =
+          s3_option_node["S3_MOTR_CTX_POOL_MAX_THRESHOLD"].as<size_t>();
 
       std::string motr_read_pool_initial_buffer_count_str;
       std::string motr_read_pool_expandable_count_str;
@@ -822,6 +1073,10 @@ void S3Option::dump_options() {
          (s3_enable_murmurhash_oid ? "true" : "false"));
   s3_log(S3_LOG_INFO, "", "S3_LOG_FLUSH_FREQUENCY = %d\n",
          log_flush_frequency_sec);
+  s3_log(S3_LOG_INFO, "", "S3_LOG_ASYNC_ENABLED = %s\n",
+         (log_async_enable ? "true" : "false"));
+  s3_log(S3_LOG_INFO, "", "S3_LOG_ASYNC_BUFFER_SIZE_KB = %u\n",
+         log_async_buffer_size_kb);
   s3_log(S3_LOG_INFO, "", "S3_ENABLE_AUTH_SSL = %s\n",
          (s3_enable_auth_ssl) ? "true" : "false");
   s3_log(S3_LOG_INFO, "", "S3_REUSEPORT = %s\n",
@@ -840,10 +1095,56 @@ void S3Option::dump_options() {
          motr_http_bind_port);
   s3_log(S3_LOG_INFO, "", "S3_SERVER_SHUTDOWN_GRACE_PERIOD = %d\n",
          s3_grace_period_sec);
+  s3_log(S3_LOG_INFO, "", "S3_REACTOR_THREADS = %d\n", reactor_threads);
+  s3_log(S3_LOG_INFO, "", "S3_MEMPOOL_THREAD_CACHE = %s\n",
+         mempool_thread_cache ? "true" : "false");
+  s3_log(S3_LOG_INFO, "", "S3_HASH_WORKER_THREADS = %d\n",
+         hash_worker_threads);
+  s3_log(S3_LOG_INFO, "", "S3_BUCKET_METADATA_CACHE_MAX_ENTRIES = %u\n",
+         bucket_metadata_cache_max_entries);
+  s3_log(S3_LOG_INFO, "", "S3_BUCKET_METADATA_CACHE_TTL_MILLISEC = %u\n",
+         bucket_metadata_cache_ttl_millisec);
+  s3_log(S3_LOG_INFO, "", "S3_AUTH_CACHE_MAX_ENTRIES = %d\n",
+         auth_cache_max_entries);
+  s3_log(S3_LOG_INFO, "", "S3_AUTH_CACHE_TTL_MILLISEC = %d\n",
+         auth_cache_ttl_millisec);
+  s3_log(S3_LOG_INFO, "", "S3_AUTH_CONNECTION_POOL_SIZE = %d\n",
+         auth_connection_pool_size);
+  s3_log(S3_LOG_INFO, "", "S3_AUTH_CONNECTION_IDLE_TIMEOUT_MILLISEC = %d\n",
+         auth_connection_idle_timeout_millisec);
   s3_log(S3_LOG_INFO, "", "S3_ENABLE_PERF = %d\n", perf_enabled);
   s3_log(S3_LOG_INFO, "", "S3_SERVER_SSL_ENABLE = %d\n", s3server_ssl_enabled);
   s3_log(S3_LOG_INFO, "", "S3_SERVER_OBJECT_DELAYED_DELETE = %d\n",
          s3server_obj_delayed_del_enabled);
+  s3_log(S3_LOG_INFO, "", "S3_SERVER_COPY_OBJECT_SHARE_DATA = %d\n",
+         s3server_copy_object_share_data);
+  s3_log(S3_LOG_INFO, "", "S3_SERVER_OBJECT_INLINE_MAX_SIZE = %zu\n",
+         s3server_object_inline_max_size);
+  s3_log(S3_LOG_INFO, "", "S3_SERVER_METADATA_BINARY_ENCODING = %d\n",
+         s3server_metadata_binary_encoding_enabled);
+  s3_log(S3_LOG_INFO, "", "S3_QOS_ENABLED = %d\n", qos_enabled);
+  s3_log(S3_LOG_INFO, "", "S3_QOS_ACCOUNT_BANDWIDTH_LIMIT = %zu\n",
+         qos_account_bandwidth_limit);
+  s3_log(S3_LOG_INFO, "", "S3_QOS_ACCOUNT_IOPS_LIMIT = %u\n",
+         qos_account_iops_limit);
+  s3_log(S3_LOG_INFO, "", "S3_QOS_BUCKET_BANDWIDTH_LIMIT = %zu\n",
+         qos_bucket_bandwidth_limit);
+  s3_log(S3_LOG_INFO, "", "S3_QOS_BUCKET_IOPS_LIMIT = %u\n",
+         qos_bucket_iops_limit);
+  s3_log(S3_LOG_INFO, "", "S3_QOS_BURST_MSEC = %u\n", qos_burst_msec);
+  s3_log(S3_LOG_INFO, "", "S3_QOS_MAX_QUEUE_DEPTH = %u\n", qos_max_queue_depth);
+  s3_log(S3_LOG_INFO, "", "S3_QOS_MAX_QUEUE_WAIT_MSEC = %u\n",
+         qos_max_queue_wait_msec);
+  s3_log(S3_LOG_INFO, "", "S3_QOS_METRICS_INTERVAL_SEC = %u\n",
+         qos_metrics_interval_sec);
+  for (auto weight : qos_account_weights) {
+    s3_log(S3_LOG_INFO, "", "S3 QoS weight of %s = %u\n", weight.first.c_str(),
+           weight.second);
+  }
+  s3_log(S3_LOG_INFO, "", "S3_SERVER_MULTIPART_PART_SLOTS = %d\n",
+         multipart_part_slots_enabled);
+  s3_log(S3_LOG_INFO, "", "S3_SERVER_LIST_RESPONSE_STREAMING = %d\n",
+         list_response_streaming_enabled);
   s3_log(S3_LOG_INFO, "", "S3_SERVER_CERT_FILE = %s\n",
          s3server_ssl_cert_file.c_str());
   s3_log(S3_LOG_INFO, "", "S3_SERVER_PEM_FILE = %s\n",
@@ -861,6 +1162,8 @@ void S3Option::dump_options() {
 
   s3_log(S3_LOG_INFO, "", "S3_AUTH_IP_ADDR = %s\n", auth_ip_addr.c_str());
   s3_log(S3_LOG_INFO, "", "S3_AUTH_PORT = %d\n", auth_port);
+  s3_log(S3_LOG_INFO, "", "S3_AUTH_SIGNING_KEY_SECRET is %s\n",
+         auth_signing_key_secret.empty() ? "not set" : "set");
   s3_log(S3_LOG_INFO, "", "S3_version = %s\n", s3_version.c_str());
 
   s3_log(S3_LOG_INFO, "", "S3_MOTR_LOCAL_ADDR = %s\n", motr_local_addr.c_str());
@@ -876,8 +1179,16 @@ void S3Option::dump_options() {
          unit_sizes.c_str());
   s3_log(S3_LOG_INFO, "", "S3_MOTR_MAX_UNITS_PER_REQUEST = %d\n",
          motr_units_per_request);
+  s3_log(S3_LOG_INFO, "", "S3_MOTR_COPY_PIPELINE_DEPTH = %d\n",
+         motr_copy_pipeline_depth);
   s3_log(S3_LOG_INFO, "", "S3_MOTR_MAX_IDX_FETCH_COUNT = %d\n",
          motr_idx_fetch_count);
+  s3_log(S3_LOG_INFO, "", "S3_MOTR_IDX_PREFETCH_ENABLED = %d\n",
+         motr_idx_prefetch_enabled);
+  s3_log(S3_LOG_INFO, "", "S3_MOTR_IDX_PREFETCH_MAX_COUNT = %d\n",
+         motr_idx_prefetch_max_count);
+  s3_log(S3_LOG_INFO, "", "S3_MOTR_IDX_PREFETCH_LATENCY_MS = %d\n",
+         motr_idx_prefetch_latency_ms);
   s3_log(S3_LOG_INFO, "", "S3_MOTR_IS_OOSTORE = %s\n",
          (motr_is_oostore ? "true" : "false"));
   s3_log(S3_LOG_INFO, "", "S3_MOTR_IS_READ_VERIFY = %s\n",
@@ -897,6 +1208,10 @@ void S3Option::dump_options() {
          motr_cass_max_column_family_num);
   s3_log(S3_LOG_INFO, "", "S3_MOTR_OPERATION_WAIT_PERIOD = %d\n",
          motr_op_wait_period);
+  s3_log(S3_LOG_INFO, "", "S3_MOTR_MAX_READ_AHEAD_DEPTH = %d\n",
+         motr_max_read_ahead_depth);
+  s3_log(S3_LOG_INFO, "", "S3_MOTR_CTX_POOL_MAX_THRESHOLD = %zu\n",
+         motr_ctx_pool_max_threshold);
 
   s3_log(S3_LOG_INFO, "", "S3_MOTR_READ_POOL_INITIAL_BUFFER_COUNT = %zu\n",
          motr_read_pool_initial_buffer_count);
@@ -946,6 +1261,10 @@ void S3Option::dump_options() {
   s3_log(S3_LOG_INFO, "", "S3_STATSD_PORT = %d\n", statsd_port);
   s3_log(S3_LOG_INFO, "", "S3_STATSD_MAX_SEND_RETRY = %d\n",
          statsd_max_send_retry);
+  s3_log(S3_LOG_INFO, "", "S3_STATSD_FLUSH_INTERVAL_MSEC = %d\n",
+         statsd_flush_interval_msec);
+  s3_log(S3_LOG_INFO, "", "S3_STATSD_MAX_PACKET_SIZE = %d\n",
+         statsd_max_packet_size);
   s3_log(S3_LOG_INFO, "", "S3_STATS_ALLOWLIST_FILENAME = %s\n",
          stats_allowlist_filename.c_str());
   s3_log(S3_LOG_INFO, "",
@@ -1093,6 +1412,12 @@ int S3Option::get_log_flush_frequency_in_sec() {
   return log_flush_frequency_sec;
 }
 
+bool S3Option::is_log_async_enabled() { return log_async_enable; }
+
+unsigned S3Option::get_log_async_buffer_size_kb() {
+  return log_async_buffer_size_kb;
+}
+
 bool S3Option::is_log_buffering_enabled() { return log_buffering_enable; }
 
 bool S3Option::is_murmurhash_oid_enabled() { return s3_enable_murmurhash_oid; }
@@ -1143,12 +1468,28 @@ unsigned short S3Option::get_motr_units_per_request() {
   return motr_units_per_request;
 }
 
+int S3Option::get_motr_copy_pipeline_depth() {
+  return motr_copy_pipeline_depth;
+}
+
 unsigned short S3Option::get_motr_op_wait_period() {
   return motr_op_wait_period;
 }
 
 int S3Option::get_motr_idx_fetch_count() { return motr_idx_fetch_count; }
 
+bool S3Option::is_motr_idx_prefetch_enabled() {
+  return motr_idx_prefetch_enabled;
+}
+
+int S3Option::get_motr_idx_prefetch_max_count() {
+  return motr_idx_prefetch_max_count;
+}
+
+int S3Option::get_motr_idx_prefetch_latency_ms() {
+  return motr_idx_prefetch_latency_ms;
+}
+
 void S3Option::set_motr_idx_fetch_count(short count) {
   motr_idx_fetch_count = count;
 }
@@ -1195,6 +1536,14 @@ int S3Option::get_motr_cass_max_column_family_num() {
 
 std::string S3Option::get_auth_ip_addr() { return auth_ip_addr; }
 
+const std::string& S3Option::get_auth_signing_key_secret() {
+  return auth_signing_key_secret;
+}
+
+void S3Option::set_auth_signing_key_secret(const std::string& secret) {
+  auth_signing_key_secret = secret;
+}
+
 void S3Option::disable_auth() { FLAGS_disable_auth = true; }
 
 void S3Option::enable_auth() { FLAGS_disable_auth = false; }
@@ -1211,10 +1560,79 @@ bool S3Option::is_s3server_obj_delayed_del_enabled() {
   return s3server_obj_delayed_del_enabled;
 }
 
+bool S3Option::is_s3server_copy_object_share_data_enabled() {
+  return s3server_copy_object_share_data;
+}
+
+size_t S3Option::get_s3server_object_inline_max_size() {
+  return s3server_object_inline_max_size;
+}
+
+bool S3Option::is_s3server_metadata_binary_encoding_enabled() {
+  return s3server_metadata_binary_encoding_enabled;
+}
+
+bool S3Option::is_qos_enabled() { return qos_enabled; }
+
+size_t S3Option::get_qos_account_bandwidth_limit() {
+  return qos_account_bandwidth_limit;
+}
+
+unsigned S3Option::get_qos_account_iops_limit() {
+  return qos_account_iops_limit;
+}
+
+size_t S3Option::get_qos_bucket_bandwidth_limit() {
+  return qos_bucket_bandwidth_limit;
+}
+
+unsigned S3Option::get_qos_bucket_iops_limit() { return qos_bucket_iops_limit; }
+
+unsigned S3Option::get_qos_burst_msec() { return qos_burst_msec; }
+
+unsigned S3Option::get_qos_max_queue_depth() { return qos_max_queue_depth; }
+
+unsigned S3Option::get_qos_max_queue_wait_msec() {
+  return qos_max_queue_wait_msec;
+}
+
+unsigned S3Option::get_qos_metrics_interval_sec() {
+  return qos_metrics_interval_sec;
+}
+
+const std::map<std::string, unsigned>& S3Option::get_qos_account_weights() {
+  return qos_account_weights;
+}
+
+bool S3Option::is_multipart_part_slots_enabled() {
+  return multipart_part_slots_enabled;
+}
+
+bool S3Option::is_list_response_streaming_enabled() {
+  return list_response_streaming_enabled;
+}
+
+void S3Option::set_list_response_streaming_enabled(bool flag) {
+  list_response_streaming_enabled = flag;
+}
+
 void S3Option::set_s3server_obj_delayed_del_enabled(const bool& flag) {
   s3server_obj_delayed_del_enabled = flag;
 }
 
+void S3Option::set_s3server_copy_object_share_data_enabled(const bool& flag) {
+  s3server_copy_object_share_data = flag;
+}
+
+void S3Option::set_s3server_object_inline_max_size(size_t max_size) {
+  s3server_object_inline_max_size = max_size;
+}
+
+void S3Option::set_s3server_metadata_binary_encoding_enabled(
+    const bool& flag) {
+  s3server_metadata_binary_encoding_enabled = flag;
+}
+
 bool S3Option::is_fake_motr_obj_op_read(m0_obj_opcode opcode) {
   return is_fake_motr_openobj() && is_fake_motr_createobj() &&
          is_fake_motr_readobj() && opcode == M0_OC_READ;
@@ -1257,8 +1675,46 @@ unsigned short S3Option::get_retry_interval_in_millisec() {
   return retry_interval_millisec;
 }
 
+unsigned short S3Option::get_reactor_threads() { return reactor_threads; }
+
+bool S3Option::is_mempool_thread_cache_enabled() {
+  return mempool_thread_cache;
+}
+
+unsigned short S3Option::get_hash_worker_threads() {
+  return hash_worker_threads;
+}
+
+unsigned int S3Option::get_bucket_metadata_cache_max_entries() {
+  return bucket_metadata_cache_max_entries;
+}
+
+unsigned int S3Option::get_bucket_metadata_cache_ttl_millisec() {
+  return bucket_metadata_cache_ttl_millisec;
+}
+
+unsigned int S3Option::get_auth_cache_max_entries() {
+  return auth_cache_max_entries;
+}
+
+unsigned int S3Option::get_auth_cache_ttl_millisec() {
+  return auth_cache_ttl_millisec;
+}
+
+unsigned int S3Option::get_auth_connection_pool_size() {
+  return auth_connection_pool_size;
+}
+
+unsigned int S3Option::get_auth_connection_idle_timeout_millisec() {
+  return auth_connection_idle_timeout_millisec;
+}
+
 void S3Option::set_eventbase(evbase_t* base) { eventbase = base; }
 
+void S3Option::set_thread_eventbase(evbase_t* base) {
+  thread_eventbase = base;
+}
+
 bool S3Option::is_stats_enabled() { return stats_enable; }
 
 void S3Option::set_stats_enable(bool enable) { stats_enable = enable; }
@@ -1271,6 +1727,14 @@ unsigned short S3Option::get_statsd_max_send_retry() {
   return statsd_max_send_retry;
 }
 
+unsigned int S3Option::get_statsd_flush_interval_msec() {
+  return statsd_flush_interval_msec;
+}
+
+unsigned int S3Option::get_statsd_max_packet_size() {
+  return statsd_max_packet_size;
+}
+
 std::string S3Option::get_stats_allowlist_filename() {
   return stats_allowlist_filename;
 }
@@ -1283,7 +1747,9 @@ void S3Option::set_stats_allowlist_filename(std::string filename) {
   stats_allowlist_filename = filename;
 }
 
-evbase_t* S3Option::get_eventbase() { return eventbase; }
+evbase_t* S3Option::get_eventbase() {
+  return thread_eventbase ? thread_eventbase : eventbase;
+}
 
 void S3Option::enable_fault_injection() { FLAGS_fault_injection = true; }
 
@@ -1326,3 +1792,11 @@ bool S3Option::get_libevent_mempool_zeroed_buffer() {
 unsigned int S3Option::get_motr_first_read_size() {
   return motr_first_obj_read_size;
 }
+
+unsigned short S3Option::get_motr_max_read_ahead_depth() {
+  return motr_max_read_ahead_depth;
+}
+
+size_t S3Option::get_motr_ctx_pool_max_threshold() {
+  return motr_ctx_pool_max_threshold;
+}
@@ -48,6 +48,10 @@
 #define S3_OPTION_MOTR_HTTP_REUSEPORT 0x400000
 #define S3_OPTION_AUDIT_LOG_DIR 0x800000
 
+// Inline data is part of the object metadata record, which is read by every
+// GET, HEAD and listing of the object, so it is kept small.
+#define S3_OBJECT_INLINE_MAX_SIZE_LIMIT (32 * 1024)
+
 #define S3_OPTION_ASSERT_AND_RET(node, option)                              \
   do {                                                                      \
     if (!node[option]) {                                                    \
@@ -70,6 +74,7 @@
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <map>
 #include <set>
 #include <string>
 #include "evhtp_wrapper.h"
@@ -92,10 +97,20 @@ class S3Option {
   unsigned short max_retry_count;
   unsigned short retry_interval_millisec;
   unsigned short s3_client_req_read_timeout_secs;
+  unsigned short reactor_threads;
+  bool mempool_thread_cache;
+  unsigned short hash_worker_threads;
+  unsigned int bucket_metadata_cache_max_entries;
+  unsigned int bucket_metadata_cache_ttl_millisec;
+  unsigned int auth_cache_max_entries;
+  unsigned int auth_cache_ttl_millisec;
+  unsigned int auth_connection_pool_size;
+  unsigned int auth_connection_idle_timeout_millisec;
 
   std::string auth_ip_addr;
   std::string s3_version;
   unsigned short auth_port;
+  std::string auth_signing_key_secret;
 
   std::string s3_default_endpoint;
   std::set<std::string> s3_region_endpoints;
@@ -128,17 +143,40 @@ class S3Option {
   bool s3_enable_auth_ssl;
   bool s3server_ssl_enabled;
   bool s3server_obj_delayed_del_enabled;
+  bool s3server_copy_object_share_data;
+  size_t s3server_object_inline_max_size;
+  bool s3server_metadata_binary_encoding_enabled;
+  bool qos_enabled;
+  size_t qos_account_bandwidth_limit;
+  unsigned qos_account_iops_limit;
+  size_t qos_bucket_bandwidth_limit;
+  unsigned qos_bucket_iops_limit;
+  unsigned qos_burst_msec;
+  unsigned qos_max_queue_depth;
+  unsigned qos_max_queue_wait_msec;
+  unsigned qos_metrics_interval_sec;
+  std::map<std::string, unsigned> qos_account_weights;
+  bool multipart_part_slots_enabled;
+  bool list_response_streaming_enabled;
   bool s3_reuseport;
   bool motr_http_reuseport;
   bool log_buffering_enable;
   bool s3_enable_murmurhash_oid;
   int log_flush_frequency_sec;
+  bool log_async_enable;
+  unsigned log_async_buffer_size_kb;
   unsigned int motr_first_obj_read_size;
 
   unsigned short motr_layout_id;
   unsigned short motr_units_per_request;
+  int motr_copy_pipeline_depth;
+  unsigned short motr_max_read_ahead_depth;
+  size_t motr_ctx_pool_max_threshold;
   std::vector<int> motr_unit_sizes_for_mem_pool;
   int motr_idx_fetch_count;
+  bool motr_idx_prefetch_enabled;
+  int motr_idx_prefetch_max_count;
+  int motr_idx_prefetch_latency_ms;
   std::string motr_local_addr;
   std::string motr_ha_addr;
   std::string motr_profile;
@@ -181,9 +219,13 @@ class S3Option {
   std::string statsd_ip_addr;
   unsigned short statsd_port;
   unsigned short statsd_max_send_retry;
+  unsigned int statsd_flush_interval_msec;
+  unsigned int statsd_max_packet_size;
   std::string stats_allowlist_filename;
   uint32_t perf_stats_inout_bytes_interval_msec;
   evbase_t* eventbase;
+  // Set on reactor threads only
+  static thread_local evbase_t* thread_eventbase;
 
   static S3Option* option_instance;
   void set_motr_idx_fetch_count(short count);
@@ -208,6 +250,20 @@ class S3Option {
     s3server_ssl_session_timeout_in_sec = DAY_IN_SECONDS;
     s3server_ssl_enabled = false;
     s3server_obj_delayed_del_enabled = true;
+    s3server_copy_object_share_data = false;
+    s3server_object_inline_max_size = 0;
+    s3server_metadata_binary_encoding_enabled = false;
+    qos_enabled = false;
+    qos_account_bandwidth_limit = 0;
+    qos_account_iops_limit = 0;
+    qos_bucket_bandwidth_limit = 0;
+    qos_bucket_iops_limit = 0;
+    qos_burst_msec = 1000;
+    qos_max_queue_depth = 64;
+    qos_max_queue_wait_msec = 5000;
+    qos_metrics_interval_sec = 60;
+    multipart_part_slots_enabled = false;
+    list_response_streaming_enabled = true;
 
     s3_grace_period_sec = 10;  // 10 seconds
     is_s3_shutting_down = false;
@@ -220,6 +276,8 @@ class S3Option {
     log_file_max_size_mb = 100;  // 100 MB
     log_buffering_enable = true;
     log_flush_frequency_sec = 30;  // 30 seconds
+    log_async_enable = false;
+    log_async_buffer_size_kb = 1024;
 
     // possible values: "disabled", "rsyslog-tcp"
     audit_logger_policy = "disabled";
@@ -261,6 +319,7 @@ class S3Option {
 
     auth_ip_addr = FLAGS_authhost;
     auth_port = FLAGS_authport;
+    auth_signing_key_secret = "";
 
     option_file = "/opt/seagate/cortx/s3/conf/s3config.yaml";
     layout_recommendation_file =
@@ -273,16 +332,33 @@ class S3Option {
     perf_log_file = FLAGS_perflogfile;
 
     motr_units_per_request = 1;
+    motr_copy_pipeline_depth = 4;
+    motr_max_read_ahead_depth = 1;
+    motr_ctx_pool_max_threshold = 16777216;  // 16mb
     motr_idx_fetch_count = 100;
+    motr_idx_prefetch_enabled = true;
+    motr_idx_prefetch_max_count = 1000;
+    motr_idx_prefetch_latency_ms = 20;
 
     retry_interval_millisec = 0;
     s3_client_req_read_timeout_secs = 5;
+    reactor_threads = 1;
+    mempool_thread_cache = true;
+    hash_worker_threads = 0;
+    bucket_metadata_cache_max_entries = 10000;
+    bucket_metadata_cache_ttl_millisec = 2000;
+    auth_cache_max_entries = 10000;
+    auth_cache_ttl_millisec = 60000;
+    auth_connection_pool_size = 16;
+    auth_connection_idle_timeout_millisec = 30000;
     max_retry_count = 0;
 
     stats_enable = false;
     statsd_ip_addr = FLAGS_statsd_host;
     statsd_port = FLAGS_statsd_port;
     statsd_max_send_retry = 3;
+    statsd_flush_interval_msec = 1000;
+    statsd_max_packet_size = 1432;
     stats_allowlist_filename =
         "/opt/seagate/cortx/s3/conf/s3stats-allowlist.yaml";
     perf_stats_inout_bytes_interval_msec = 1000;
@@ -349,6 +425,8 @@ class S3Option {
   std::string get_auth_ip_addr();
   std::string get_s3_version();
   unsigned short get_auth_port();
+  const std::string& get_auth_signing_key_secret();
+  void set_auth_signing_key_secret(const std::string& secret);
   void disable_auth();
   void enable_auth();
   bool is_auth_disabled();
@@ -373,7 +451,26 @@ class S3Option {
   bool is_s3server_addb_dump_enabled();
 
   bool is_s3server_obj_delayed_del_enabled();
+  bool is_s3server_copy_object_share_data_enabled();
+  size_t get_s3server_object_inline_max_size();
+  bool is_s3server_metadata_binary_encoding_enabled();
+  bool is_qos_enabled();
+  size_t get_qos_account_bandwidth_limit();
+  unsigned get_qos_account_iops_limit();
+  size_t get_qos_bucket_bandwidth_limit();
+  unsigned get_qos_bucket_iops_limit();
+  unsigned get_qos_burst_msec();
+  unsigned get_qos_max_queue_depth();
+  unsigned get_qos_max_queue_wait_msec();
+  unsigned get_qos_metrics_interval_sec();
+  const std::map<std::string, unsigned>& get_qos_account_weights();
+  bool is_multipart_part_slots_enabled();
+  bool is_list_response_streaming_enabled();
+  void set_list_response_streaming_enabled(bool flag);
   void set_s3server_obj_delayed_del_enabled(const bool& flag);
+  void set_s3server_copy_object_share_data_enabled(const bool& flag);
+  void set_s3server_object_inline_max_size(size_t max_size);
+  void set_s3server_metadata_binary_encoding_enabled(const bool& flag);
 
   bool is_s3_reuseport_enabled();
   bool is_motr_http_reuseport_enabled();
@@ -381,6 +478,8 @@ class S3Option {
   bool is_log_buffering_enabled();
   bool is_murmurhash_oid_enabled();
   int get_log_flush_frequency_in_sec();
+  bool is_log_async_enabled();
+  unsigned get_log_async_buffer_size_kb();
 
   unsigned short s3_performance_enabled();
   std::string get_perf_log_filename();
@@ -391,17 +490,32 @@ class S3Option {
   unsigned short get_motr_layout_id();
   std::vector<int> get_motr_unit_sizes_for_mem_pool();
   unsigned short get_motr_units_per_request();
+  int get_motr_copy_pipeline_depth();
   unsigned short get_motr_op_wait_period();
   unsigned short get_client_req_read_timeout_secs();
   unsigned int get_motr_write_payload_size(int layoutid);
   unsigned int get_motr_read_payload_size(int layoutid);
   int get_motr_idx_fetch_count();
+  bool is_motr_idx_prefetch_enabled();
+  int get_motr_idx_prefetch_max_count();
+  int get_motr_idx_prefetch_latency_ms();
   unsigned short get_max_retry_count();
   unsigned short get_retry_interval_in_millisec();
+  unsigned short get_reactor_threads();
+  bool is_mempool_thread_cache_enabled();
+  unsigned short get_hash_worker_threads();
+  unsigned int get_bucket_metadata_cache_max_entries();
+  unsigned int get_bucket_metadata_cache_ttl_millisec();
+  unsigned int get_auth_cache_max_entries();
+  unsigned int get_auth_cache_ttl_millisec();
+  unsigned int get_auth_connection_pool_size();
+  unsigned int get_auth_connection_idle_timeout_millisec();
   size_t get_motr_read_pool_initial_buffer_count();
   size_t get_motr_read_pool_expandable_count();
   size_t get_motr_read_pool_max_threshold();
   unsigned int get_motr_first_read_size();
+  unsigned short get_motr_max_read_ahead_depth();
+  size_t get_motr_ctx_pool_max_threshold();
 
   size_t get_libevent_pool_initial_size();
   size_t get_libevent_pool_expandable_size();
@@ -442,7 +556,11 @@ class S3Option {
   bool is_sync_kvs_allowed();
 
   void set_eventbase(evbase_t* base);
+  // Event base of the calling reactor thread, main event base for threads
+  // which are not reactors.
   evbase_t* get_eventbase();
+  // Registers event base of the calling thread, when it runs its own reactor.
+  void set_thread_eventbase(evbase_t* base);
 
   std::string get_redis_srv_addr();
   unsigned short get_redis_srv_port();
@@ -458,6 +576,8 @@ class S3Option {
   std::string get_statsd_ip_addr();
   unsigned short get_statsd_port();
   unsigned short get_statsd_max_send_retry();
+  unsigned int get_statsd_flush_interval_msec();
+  unsigned int get_statsd_max_packet_size();
   std::string get_stats_allowlist_filename();
   uint32_t get_perf_stats_inout_bytes_interval_msec();
   void set_stats_allowlist_filename(std::string filename);
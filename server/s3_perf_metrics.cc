@@ -18,6 +18,7 @@
  *
  */
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <cstdint>
@@ -28,25 +29,22 @@
 #include "atexit.h"
 
 // Helper class, will keep value of a single throughput metric.
+// Bytes are counted by all reactor threads.
 class S3ThroughputMetric {
  private:
-  int64_t bytes_cnt = 0;
+  std::atomic<int64_t> bytes_cnt{0};
   std::string name;
 
  public:
   explicit S3ThroughputMetric(std::string const &name_) : name(name_) {}
 
-  void submit() {
-    s3_stats_count(name, bytes_cnt);
-    bytes_cnt = 0;
-  }
+  void submit() { s3_stats_count(name, bytes_cnt.exchange(0)); }
 
   void more_bytes(int64_t cnt) {
-    bytes_cnt += cnt;
-    if (bytes_cnt > (((int64_t)1) << 51)) {  // some docs say that statsd can
-                                             // eat numbers up to 2^52^, so
-                                             // making sure we're not above that
-                                             // limit
+    const int64_t total = bytes_cnt.fetch_add(cnt) + cnt;
+    // some docs say that statsd can eat numbers up to 2^52^, so making sure
+    // we're not above that limit
+    if (total > (((int64_t)1) << 51)) {
       submit();
     }
   }
@@ -75,8 +73,24 @@ class S3ThroughputMetricsEvent : public RecurringEventBase {
   void more_bytes_out(int cnt) { out.more_bytes(cnt); }
 };
 
+// Helper class, defines recurring event sending metrics aggregated by
+// S3Stats to statsd.
+class S3StatsFlushEvent : public RecurringEventBase {
+ public:
+  S3StatsFlushEvent(std::shared_ptr<EventInterface> event_obj_ptr,
+                    evbase_t *evbase_ = nullptr)
+      : RecurringEventBase(std::move(event_obj_ptr), evbase_) {}
+
+  virtual void action_callback(void) noexcept {
+    if (g_stats_instance) {
+      g_stats_instance->flush();
+    }
+  }
+};
+
 static std::shared_ptr<EventWrapper> gs_event_obj_ptr;
 static std::shared_ptr<S3ThroughputMetricsEvent> gs_throughput_event;
+static std::shared_ptr<S3StatsFlushEvent> gs_stats_flush_event;
 
 int s3_perf_metrics_init(evbase_t *evbase) {
   int rc;
@@ -111,6 +125,18 @@ int s3_perf_metrics_init(evbase_t *evbase) {
   if (rc != 0) {
     return rc;
   }
+  const unsigned flush_interval_msec =
+      S3Option::get_instance()->get_statsd_flush_interval_msec();
+  if (flush_interval_msec > 0) {
+    gs_stats_flush_event.reset(
+        new S3StatsFlushEvent(gs_event_obj_ptr, evbase));
+    tv.tv_sec = flush_interval_msec / 1000;
+    tv.tv_usec = 1000 * (flush_interval_msec % 1000);
+    rc = gs_stats_flush_event->add_evtimer(tv);
+    if (rc != 0) {
+      return rc;
+    }
+  }
 
   call_fini.cancel();
 
@@ -126,6 +152,10 @@ void s3_perf_metrics_fini() {
     gs_throughput_event->del_evtimer();
     gs_throughput_event.reset();
   }
+  if (gs_stats_flush_event) {
+    gs_stats_flush_event->del_evtimer();
+    gs_stats_flush_event.reset();
+  }
   if (gs_event_obj_ptr) {
     gs_event_obj_ptr.reset();
   }
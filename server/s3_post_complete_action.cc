@@ -354,6 +354,9 @@ bool S3PostCompleteAction::validate_parts() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
   size_t part_one_size_in_multipart_metadata =
       multipart_metadata->get_part_one_size();
+  // Parts written to part slots may be of any size.
+  bool check_parts_size_consistency =
+      multipart_metadata->get_part_slot_size() == 0;
   if (part_metadata == NULL) {
     part_metadata = part_metadata_factory->create_part_metadata_obj(
         request, multipart_metadata->get_part_index_oid(), upload_id, 0);
@@ -416,7 +419,8 @@ bool S3PostCompleteAction::validate_parts() {
         break;
       }
 
-      if (part_one_size_in_multipart_metadata != 0) {
+      if (check_parts_size_consistency &&
+          part_one_size_in_multipart_metadata != 0) {
         // In non chunked mode if current part size is not same as
         // that in multipart metadata and its not the last part,
         // then bail out
@@ -435,7 +439,7 @@ bool S3PostCompleteAction::validate_parts() {
           break;
         }
       }
-      if ((prev_fetched_parts_size != 0) &&
+      if (check_parts_size_consistency && (prev_fetched_parts_size != 0) &&
           (prev_fetched_parts_size != current_parts_size)) {
         if (store_kv->first == total_parts) {
           // This is the last part, ignore it after size calculation
@@ -462,6 +466,10 @@ bool S3PostCompleteAction::validate_parts() {
       }
       object_size += part_metadata->get_content_length();
       awsetag.add_part_etag(part_metadata->get_md5());
+      if (!check_parts_size_consistency) {
+        part_sizes[strtoul(store_kv->first.c_str(), NULL, 10)] =
+            current_parts_size;
+      }
       // Remove the entry from parts map, so that in next
       // validate_parts() we dont have to scan it again
       part_kv = parts.erase(part_kv);
@@ -611,6 +619,19 @@ void S3PostCompleteAction::save_metadata() {
         multipart_metadata->get_content_type());
     new_object_metadata->set_md5(etag);
 
+    size_t part_slot_size = multipart_metadata->get_part_slot_size();
+    if (part_slot_size != 0) {
+      // Parts stay where they were written, only their placement is
+      // recorded for reads.
+      std::vector<S3ObjectExtent> extents;
+      for (const auto& part : part_sizes) {
+        if (part.second != 0) {
+          extents.push_back({(part.first - 1) * part_slot_size, part.second});
+        }
+      }
+      new_object_metadata->set_extents(extents);
+    }
+
     new_object_metadata->save(
         std::bind(&S3PostCompleteAction::save_object_metadata_succesful, this),
         std::bind(&S3PostCompleteAction::save_object_metadata_failed, this));
@@ -847,6 +868,10 @@ void S3PostCompleteAction::startcleanup() {
       // backgrounddelete decisions.
       ACTION_TASK_ADD(S3PostCompleteAction::mark_old_oid_for_deletion, this);
       ACTION_TASK_ADD(S3PostCompleteAction::delete_old_object, this);
+    } else if (replaces_inline_object()) {
+      // Inline object has no oid, only its version entry is left behind.
+      ACTION_TASK_ADD(
+          S3PostCompleteAction::remove_inline_object_version_metadata, this);
     }
   } else if (s3_post_complete_action_state ==
              S3PostCompleteActionState::abortedSinceValidationFailed) {
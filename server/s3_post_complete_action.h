@@ -67,6 +67,8 @@ class S3PostCompleteAction : public S3ObjectAction {
   std::string etag;
   std::map<std::string, std::string, S3NumStrComparator> parts;
   uint64_t object_size;
+  // Size of every validated part, by part number.
+  std::map<size_t, size_t> part_sizes;
   m0_uint128 multipart_index_oid;
   bool delete_multipart_object;
   bool obj_metadata_updated;
@@ -176,6 +178,7 @@ class S3PostCompleteAction : public S3ObjectAction {
   FRIEND_TEST(S3PostCompleteActionTest, GetNextPartsInfo);
   FRIEND_TEST(S3PostCompleteActionTest, GetPartsInfoFailed);
   FRIEND_TEST(S3PostCompleteActionTest, GetPartsSuccessful);
+  FRIEND_TEST(S3PostCompleteActionTest, GetPartsOfAnySizeWithPartSlots);
   FRIEND_TEST(S3PostCompleteActionTest, GetNextPartsSuccessful);
   FRIEND_TEST(S3PostCompleteActionTest, GetNextPartsSuccessfulNext);
   FRIEND_TEST(S3PostCompleteActionTest, GetNextPartsSuccessfulAbortSet);
@@ -197,6 +200,7 @@ class S3PostCompleteAction : public S3ObjectAction {
   FRIEND_TEST(S3PostCompleteActionTest, StartCleanupProbableEntryRecordFailed);
   FRIEND_TEST(S3PostCompleteActionTest,
               StartCleanupAbortedSinceValidationFailed);
+  FRIEND_TEST(S3PostCompleteActionTest, StartCleanupCompletedOverInlineObject);
 };
 
 #endif
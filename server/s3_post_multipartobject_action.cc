@@ -513,6 +513,10 @@ void S3PostMultipartObjectAction::save_upload_metadata() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
 
   object_multipart_metadata->set_layout_id(layout_id);
+  if (S3Option::get_instance()->is_multipart_part_slots_enabled()) {
+    // Every part gets a slot large enough for the largest allowed part.
+    object_multipart_metadata->set_part_slot_size(MAXIMUM_ALLOWED_PART_SIZE);
+  }
 
   for (auto it : request->get_in_headers_copy()) {
     if (it.first.find("x-amz-meta-") != std::string::npos) {
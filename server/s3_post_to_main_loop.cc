@@ -27,8 +27,9 @@ void S3PostToMainLoop::operator()(user_event_on_main_loop callback,
   struct event *ev_user = NULL;
   struct user_event_context *user_context =
       (struct user_event_context *)context;
-  struct event_base *base = S3Option::get_instance()->get_eventbase();
-
+  if (base == NULL) {
+    base = S3Option::get_instance()->get_eventbase();
+  }
   if (base == NULL) {
     s3_log(S3_LOG_ERROR, request_id, "ERROR: event base is NULL\n");
     return;
@@ -40,9 +40,12 @@ extern "C" typedef void (*user_event_on_main_loop)(evutil_socket_t,
 
 class S3PostToMainLoop {
   void *context;
+  // Event loop to run the callback on, calling thread's loop if NULL.
+  struct event_base *base;
 
  public:
-  S3PostToMainLoop(void *ctx) : context(ctx) {
+  S3PostToMainLoop(void *ctx, struct event_base *evbase = NULL)
+      : context(ctx), base(evbase) {
     s3_log(S3_LOG_DEBUG, "", "%s Ctor\n", __func__);
   }
 
@@ -833,7 +833,6 @@ void S3PutChunkUploadObjectAction::send_response_to_s3_client() {
 
 void S3PutChunkUploadObjectAction::startcleanup() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
-  // TODO: Perf - all below tasks can be done in parallel
   // Any of the following steps fail, backgrounddelete will be able to perform
   // cleanups.
   // Clear task list and setup cleanup task list
@@ -844,6 +843,8 @@ void S3PutChunkUploadObjectAction::startcleanup() {
   if (s3_put_chunk_action_state ==
       S3PutChunkUploadObjectActionState::completed) {
     s3_log(S3_LOG_DEBUG, request_id, "Cleanup old Object\n");
+    // Both records are independent, update them together.
+    begin_task_group();
     if (old_object_oid.u_hi || old_object_oid.u_lo) {
       // mark old OID for deletion in overwrite case, this optimizes
       // backgrounddelete decisions.
@@ -853,10 +854,15 @@ void S3PutChunkUploadObjectAction::startcleanup() {
     // remove new oid from probable delete list.
     ACTION_TASK_ADD(
         S3PutChunkUploadObjectAction::remove_new_oid_probable_record, this);
+    end_task_group();
     if (old_object_oid.u_hi || old_object_oid.u_lo) {
       // Object overwrite case, old object exists, delete it.
       ACTION_TASK_ADD(S3PutChunkUploadObjectAction::delete_old_object, this);
       // If delete object is successful, attempt to delete old probable record
+    } else if (replaces_inline_object()) {
+      ACTION_TASK_ADD(
+          S3PutChunkUploadObjectAction::remove_inline_object_version_metadata,
+          this);
     }
   } else if (s3_put_chunk_action_state ==
                  S3PutChunkUploadObjectActionState::newObjOidCreated ||
@@ -870,6 +876,7 @@ void S3PutChunkUploadObjectAction::startcleanup() {
     s3_log(S3_LOG_DEBUG, request_id,
            "Cleanup new Object: s3_put_chunk_action_state[%d]\n",
            s3_put_chunk_action_state);
+    begin_task_group();
     // Mark new OID for deletion, this optimizes backgrounddelete decisionss.
     ACTION_TASK_ADD(S3PutChunkUploadObjectAction::mark_new_oid_for_deletion,
                     this);
@@ -878,6 +885,7 @@ void S3PutChunkUploadObjectAction::startcleanup() {
       ACTION_TASK_ADD(
           S3PutChunkUploadObjectAction::remove_old_oid_probable_record, this);
     }
+    end_task_group();
     ACTION_TASK_ADD(S3PutChunkUploadObjectAction::delete_new_object, this);
     // If delete object is successful, attempt to delete new probable record
   } else {
@@ -951,11 +959,11 @@ void S3PutChunkUploadObjectAction::remove_old_oid_probable_record() {
   // key = oldoid + "-" + newoid
   std::string old_oid_rec_key = old_oid_str + '-' + new_oid_str;
 
-  if (!motr_kv_writer) {
-    motr_kv_writer =
+  if (!probable_rec_kv_writer) {
+    probable_rec_kv_writer =
         mote_kv_writer_factory->create_motr_kvs_writer(request, s3_motr_api);
   }
-  motr_kv_writer->delete_keyval(
+  probable_rec_kv_writer->delete_keyval(
       global_probable_dead_object_list_index_oid, old_oid_rec_key,
       std::bind(&S3PutChunkUploadObjectAction::next, this),
       std::bind(&S3PutChunkUploadObjectAction::next, this));
@@ -966,11 +974,11 @@ void S3PutChunkUploadObjectAction::remove_new_oid_probable_record() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
   assert(!new_oid_str.empty());
 
-  if (!motr_kv_writer) {
-    motr_kv_writer =
+  if (!probable_rec_kv_writer) {
+    probable_rec_kv_writer =
         mote_kv_writer_factory->create_motr_kvs_writer(request, s3_motr_api);
   }
-  motr_kv_writer->delete_keyval(
+  probable_rec_kv_writer->delete_keyval(
       global_probable_dead_object_list_index_oid, new_oid_str,
       std::bind(&S3PutChunkUploadObjectAction::next, this),
       std::bind(&S3PutChunkUploadObjectAction::next, this));
@@ -53,6 +53,8 @@ class S3PutChunkUploadObjectAction : public S3ObjectAction {
   S3PutChunkUploadObjectActionState s3_put_chunk_action_state;
   std::shared_ptr<S3MotrWiter> motr_writer;
   std::shared_ptr<S3MotrKVSWriter> motr_kv_writer;
+  // Removes probable delete records, may run along with motr_kv_writer.
+  std::shared_ptr<S3MotrKVSWriter> probable_rec_kv_writer;
   int layout_id;
   unsigned motr_write_payload_size;
   struct m0_uint128 old_object_oid;
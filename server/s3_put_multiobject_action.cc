@@ -237,6 +237,12 @@ void S3PutMultiObjectAction::save_multipart_metadata() {
   // to proceed.Also this is only in case of
   // non-chunked part upload.
   assert(part_number == 1);
+  if (object_multipart_metadata->get_part_slot_size() != 0) {
+    // Part offsets do not depend on part one size.
+    next();
+    s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+    return;
+  }
   size_t part_one_size_in_multipart_metadata =
       object_multipart_metadata->get_part_one_size();
   size_t current_part_one_size = request->get_data_length();
@@ -286,6 +292,12 @@ void S3PutMultiObjectAction::save_multipart_metadata_failed() {
 
 void S3PutMultiObjectAction::fetch_firstpart_info() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  if (object_multipart_metadata->get_part_slot_size() != 0) {
+    // Part offsets do not depend on part one size.
+    next();
+    s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+    return;
+  }
   part_metadata = part_metadata_factory->create_part_metadata_obj(
       request, object_multipart_metadata->get_part_index_oid(), upload_id, 1);
   part_metadata->load(
@@ -321,7 +333,22 @@ void S3PutMultiObjectAction::_set_layout_id(int layout_id) {
 void S3PutMultiObjectAction::compute_part_offset() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
   size_t offset = 0;
-  if (part_number != 1) {
+  size_t part_slot_size = object_multipart_metadata->get_part_slot_size();
+  if (part_slot_size != 0) {
+    // Each part owns a slot, so parts of any size can be written in any
+    // order without waiting for part one.
+    if (request->get_data_length() > part_slot_size) {
+      s3_log(S3_LOG_ERROR, request_id,
+             "Part %d size (%zu) exceeds part slot size (%zu)\n", part_number,
+             request->get_data_length(), part_slot_size);
+      set_s3_error("EntityTooLarge");
+      send_response_to_s3_client();
+      s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+      return;
+    }
+    offset = (part_number - 1) * part_slot_size;
+    s3_log(S3_LOG_DEBUG, request_id, "Offset for motr write = %zu\n", offset);
+  } else if (part_number != 1) {
     size_t part_one_size = 0;
     if (request->is_chunked()) {
       part_one_size = part_metadata->get_content_length();
@@ -360,8 +387,9 @@ void S3PutMultiObjectAction::compute_part_offset() {
 
   // FIXME multipart uploads are corrupted when partsize is not aligned with
   // motr unit size for given layout_id. We block such uploads temporarily
-  // and it will be fixed as a bug.
-  if (part_number == 1) {
+  // and it will be fixed as a bug. Part slots are unit aligned, so padding
+  // of the last unit of a part never overlaps the next part.
+  if (part_number == 1 && part_slot_size == 0) {
     // Reject during first part itself
     size_t unit_size =
         S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(layout_id);
@@ -154,6 +154,10 @@ class S3PutMultiObjectAction : public S3ObjectAction {
   FRIEND_TEST(S3PutMultipartObjectActionTestNoMockAuth,
               ComputePartOffsetNoChunk);
   FRIEND_TEST(S3PutMultipartObjectActionTestNoMockAuth, ComputePartOffset);
+  FRIEND_TEST(S3PutMultipartObjectActionTestNoMockAuth,
+              ComputePartOffsetWithPartSlots);
+  FRIEND_TEST(S3PutMultipartObjectActionTestNoMockAuth,
+              ComputePartOffsetWithPartSlotsEntityTooLarge);
   FRIEND_TEST(S3PutMultipartObjectActionTestWithMockAuth,
               InitiateDataStreamingForZeroSizeObject);
   FRIEND_TEST(S3PutMultipartObjectActionTestNoMockAuth,
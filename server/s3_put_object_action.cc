@@ -45,7 +45,8 @@ S3PutObjectAction::S3PutObjectAction(
     : S3ObjectAction(std::move(req), std::move(bucket_meta_factory),
                      std::move(object_meta_factory)),
       total_data_to_stream(0),
-      write_in_progress(false) {
+      write_in_progress(false),
+      store_inline(false) {
   s3_log(S3_LOG_DEBUG, request_id, "%s Ctor\n", __func__);
 
   s3_log(S3_LOG_INFO, stripped_request_id,
@@ -90,6 +91,11 @@ S3PutObjectAction::S3PutObjectAction(
     mote_kv_writer_factory = std::make_shared<S3MotrKVSWriterFactory>();
   }
 
+  const size_t inline_max_size =
+      S3Option::get_instance()->get_s3server_object_inline_max_size();
+  store_inline = inline_max_size != 0 &&
+                 request->get_content_length() <= inline_max_size;
+
   setup_steps();
 }
 
@@ -100,8 +106,13 @@ void S3PutObjectAction::setup_steps() {
     ACTION_TASK_ADD(S3PutObjectAction::validate_x_amz_tagging_if_present, this);
   }
   ACTION_TASK_ADD(S3PutObjectAction::validate_put_request, this);
-  ACTION_TASK_ADD(S3PutObjectAction::create_object, this);
-  ACTION_TASK_ADD(S3PutObjectAction::initiate_data_streaming, this);
+  if (store_inline) {
+    // Data goes into metadata, no motr object is created.
+    ACTION_TASK_ADD(S3PutObjectAction::read_inline_data, this);
+  } else {
+    ACTION_TASK_ADD(S3PutObjectAction::create_object, this);
+    ACTION_TASK_ADD(S3PutObjectAction::initiate_data_streaming, this);
+  }
   ACTION_TASK_ADD(S3PutObjectAction::save_metadata, this);
   ACTION_TASK_ADD(S3PutObjectAction::send_response_to_s3_client, this);
   // ...
@@ -292,6 +303,14 @@ void S3PutObjectAction::create_object_successful() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
   s3_put_action_state = S3PutObjectActionState::newObjOidCreated;
 
+  create_new_object_metadata();
+  new_object_metadata->set_oid(motr_writer->get_oid());
+
+  add_object_oid_to_probable_dead_oid_list();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3PutObjectAction::create_new_object_metadata() {
   // New Object or overwrite, create new metadata and release old.
   new_object_metadata = object_metadata_factory->create_object_metadata_obj(
       request, bucket_metadata->get_object_list_index_oid());
@@ -302,11 +321,7 @@ void S3PutObjectAction::create_object_successful() {
 
   // Generate a version id for the new object.
   new_object_metadata->regenerate_version_id();
-  new_object_metadata->set_oid(motr_writer->get_oid());
   new_object_metadata->set_layout_id(layout_id);
-
-  add_object_oid_to_probable_dead_oid_list();
-  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
 void S3PutObjectAction::create_object_failed() {
@@ -409,6 +424,54 @@ void S3PutObjectAction::create_new_oid(struct m0_uint128 current_oid) {
   return;
 }
 
+void S3PutObjectAction::read_inline_data() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  if (request->has_all_body_content()) {
+    create_inline_object();
+  } else {
+    // Whole body is small, ask for all of it at once.
+    request->listen_for_incoming_data(
+        std::bind(&S3PutObjectAction::consume_inline_data, this),
+        request->get_content_length());
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3PutObjectAction::consume_inline_data() {
+  s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+  if (request->is_s3_client_read_error()) {
+    client_read_error();
+  } else if (request->has_all_body_content()) {
+    create_inline_object();
+  } else {
+    // else just wait till entire body arrives.
+    request->resume();
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3PutObjectAction::create_inline_object() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  inline_data = request->get_full_body_content_as_string();
+  s3_perf_count_incoming_bytes(inline_data.length());
+  inline_data_md5.Update(inline_data.c_str(), inline_data.length());
+
+  // Layout is kept for readers that size their reads by it.
+  _set_layout_id(S3MotrLayoutMap::get_instance()->get_layout_for_object_size(
+      inline_data.length()));
+  create_new_object_metadata();
+  new_object_metadata->set_inline_data(inline_data);
+  s3_put_action_state = S3PutObjectActionState::writeComplete;
+
+  if (old_object_oid.u_hi || old_object_oid.u_lo) {
+    // Old motr object is still to be deleted once metadata is replaced.
+    add_object_oid_to_probable_dead_oid_list();
+  } else {
+    next();
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
 void S3PutObjectAction::initiate_data_streaming() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
   s3_timer.stop();
@@ -571,7 +634,7 @@ void S3PutObjectAction::save_metadata() {
 
   std::string s_md5_got = request->get_header_value("content-md5");
   if (!s_md5_got.empty()) {
-    std::string s_md5_calc = motr_writer->get_content_md5_base64();
+    std::string s_md5_calc = get_content_md5_base64();
     s3_log(S3_LOG_DEBUG, request_id, "MD5 calculated: %s, MD5 got %s",
            s_md5_calc.c_str(), s_md5_got.c_str());
 
@@ -592,7 +655,7 @@ void S3PutObjectAction::save_metadata() {
   new_object_metadata->reset_date_time_to_current();
   new_object_metadata->set_content_length(request->get_data_length_str());
   new_object_metadata->set_content_type(request->get_content_type());
-  new_object_metadata->set_md5(motr_writer->get_content_md5());
+  new_object_metadata->set_md5(get_content_md5());
   new_object_metadata->set_tags(new_object_tags_map);
 
   for (auto it : request->get_in_headers_copy()) {
@@ -612,6 +675,16 @@ void S3PutObjectAction::save_metadata() {
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
+std::string S3PutObjectAction::get_content_md5() {
+  return store_inline ? inline_data_md5.get_md5_string()
+                      : motr_writer->get_content_md5();
+}
+
+std::string S3PutObjectAction::get_content_md5_base64() {
+  return store_inline ? inline_data_md5.get_md5_base64enc_string()
+                      : motr_writer->get_content_md5_base64();
+}
+
 void S3PutObjectAction::save_object_metadata_success() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
   s3_put_action_state = S3PutObjectActionState::metadataSaved;
@@ -667,17 +740,20 @@ void S3PutObjectAction::add_object_oid_to_probable_dead_oid_list() {
   S3CommonUtilities::size_based_bucketing_of_objects(
       new_oid_str, request->get_content_length());
 
-  s3_log(S3_LOG_DEBUG, request_id,
-         "Adding new_probable_del_rec with key [%s]\n", new_oid_str.c_str());
-  new_probable_del_rec.reset(new S3ProbableDeleteRecord(
-      new_oid_str, old_object_oid, new_object_metadata->get_object_name(),
-      new_object_oid, layout_id, bucket_metadata->get_object_list_index_oid(),
-      bucket_metadata->get_objects_version_list_index_oid(),
-      new_object_metadata->get_version_key_in_index(),
-      false /* force_delete */));
+  if (!store_inline) {
+    s3_log(S3_LOG_DEBUG, request_id,
+           "Adding new_probable_del_rec with key [%s]\n", new_oid_str.c_str());
+    new_probable_del_rec.reset(new S3ProbableDeleteRecord(
+        new_oid_str, old_object_oid, new_object_metadata->get_object_name(),
+        new_object_oid, layout_id,
+        bucket_metadata->get_object_list_index_oid(),
+        bucket_metadata->get_objects_version_list_index_oid(),
+        new_object_metadata->get_version_key_in_index(),
+        false /* force_delete */));
 
-  // store new oid, key = newoid
-  probable_oid_list[new_oid_str] = new_probable_del_rec->to_json();
+    // store new oid, key = newoid
+    probable_oid_list[new_oid_str] = new_probable_del_rec->to_json();
+  }
 
   if (!motr_kv_writer) {
     motr_kv_writer =
@@ -709,9 +785,12 @@ void S3PutObjectAction::send_response_to_s3_client() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
 
   if (S3Option::get_instance()->is_getoid_enabled()) {
+    // Inline object has no motr object.
+    const struct m0_uint128 oid =
+        store_inline ? m0_uint128{0ULL, 0ULL} : new_object_oid;
 
     request->set_out_header_value("x-stx-oid",
-                                  S3M0Uint128Helper::to_string(new_object_oid));
+                                  S3M0Uint128Helper::to_string(oid));
     request->set_out_header_value("x-stx-layout-id", std::to_string(layout_id));
   }
 
@@ -748,7 +827,7 @@ void S3PutObjectAction::send_response_to_s3_client() {
     s3_stats_timing("put_object_save_metadata", mss);
     // AWS adds explicit quotes "" to etag values.
     // https://docs.aws.amazon.com/AmazonS3/latest/API/API_PutObject.html
-    std::string e_tag = "\"" + motr_writer->get_content_md5() + "\"";
+    std::string e_tag = "\"" + get_content_md5() + "\"";
 
     request->set_out_header_value("ETag", e_tag);
 
@@ -763,16 +842,34 @@ void S3PutObjectAction::send_response_to_s3_client() {
 
 void S3PutObjectAction::startcleanup() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
-  // TODO: Perf - all/some of below tasks can be done in parallel
   // Any of the following steps fail, backgrounddelete will be able to perform
   // cleanups.
   // Clear task list and setup cleanup task list
   clear_tasks();
   cleanup_started = true;
 
-  // Success conditions
-  if (s3_put_action_state == S3PutObjectActionState::completed) {
+  if (store_inline) {
+    // There is no new motr object to undo, only old one may need cleanup.
+    s3_log(S3_LOG_DEBUG, request_id,
+           "Cleanup for inline object: s3_put_action_state[%d]\n",
+           s3_put_action_state);
+    if (s3_put_action_state == S3PutObjectActionState::completed) {
+      if (old_object_oid.u_hi || old_object_oid.u_lo) {
+        ACTION_TASK_ADD(S3PutObjectAction::mark_old_oid_for_deletion, this);
+        ACTION_TASK_ADD(S3PutObjectAction::delete_old_object, this);
+      } else if (replaces_inline_object()) {
+        ACTION_TASK_ADD(
+            S3PutObjectAction::remove_inline_object_version_metadata, this);
+      }
+    } else if (old_probable_del_rec) {
+      // Old object stays, remove old oid from probable delete list.
+      ACTION_TASK_ADD(S3PutObjectAction::remove_old_oid_probable_record, this);
+    }
+  } else if (s3_put_action_state == S3PutObjectActionState::completed) {
+    // Success conditions
     s3_log(S3_LOG_DEBUG, request_id, "Cleanup old Object\n");
+    // Both records are independent, update them together.
+    begin_task_group();
     if (old_object_oid.u_hi || old_object_oid.u_lo) {
       // mark old OID for deletion in overwrite case, this optimizes
       // backgrounddelete decisions.
@@ -780,10 +877,14 @@ void S3PutObjectAction::startcleanup() {
     }
     // remove new oid from probable delete list.
     ACTION_TASK_ADD(S3PutObjectAction::remove_new_oid_probable_record, this);
+    end_task_group();
     if (old_object_oid.u_hi || old_object_oid.u_lo) {
       // Object overwrite case, old object exists, delete it.
       ACTION_TASK_ADD(S3PutObjectAction::delete_old_object, this);
       // If delete object is successful, attempt to delete old probable record
+    } else if (replaces_inline_object()) {
+      ACTION_TASK_ADD(
+          S3PutObjectAction::remove_inline_object_version_metadata, this);
     }
   } else if (s3_put_action_state == S3PutObjectActionState::newObjOidCreated ||
              s3_put_action_state == S3PutObjectActionState::writeFailed ||
@@ -795,12 +896,14 @@ void S3PutObjectAction::startcleanup() {
     s3_log(S3_LOG_DEBUG, request_id,
            "Cleanup new Object: s3_put_action_state[%d]\n",
            s3_put_action_state);
+    begin_task_group();
     // Mark new OID for deletion, this optimizes backgrounddelete decisionss.
     ACTION_TASK_ADD(S3PutObjectAction::mark_new_oid_for_deletion, this);
     if (old_object_oid.u_hi || old_object_oid.u_lo) {
       // remove old oid from probable delete list.
       ACTION_TASK_ADD(S3PutObjectAction::remove_old_oid_probable_record, this);
     }
+    end_task_group();
     ACTION_TASK_ADD(S3PutObjectAction::delete_new_object, this);
     // If delete object is successful, attempt to delete new probable record
   } else {
@@ -871,14 +974,14 @@ void S3PutObjectAction::remove_old_oid_probable_record() {
   // key = oldoid + "-" + newoid
   std::string old_oid_rec_key = old_oid_str + '-' + new_oid_str;
 
-  if (!motr_kv_writer) {
-    motr_kv_writer =
+  if (!probable_rec_kv_writer) {
+    probable_rec_kv_writer =
         mote_kv_writer_factory->create_motr_kvs_writer(request, s3_motr_api);
   }
-  motr_kv_writer->delete_keyval(global_probable_dead_object_list_index_oid,
-                                old_oid_rec_key,
-                                std::bind(&S3PutObjectAction::next, this),
-                                std::bind(&S3PutObjectAction::next, this));
+  probable_rec_kv_writer->delete_keyval(
+      global_probable_dead_object_list_index_oid, old_oid_rec_key,
+      std::bind(&S3PutObjectAction::next, this),
+      std::bind(&S3PutObjectAction::next, this));
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -886,14 +989,14 @@ void S3PutObjectAction::remove_new_oid_probable_record() {
   s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
   assert(!new_oid_str.empty());
 
-  if (!motr_kv_writer) {
-    motr_kv_writer =
+  if (!probable_rec_kv_writer) {
+    probable_rec_kv_writer =
         mote_kv_writer_factory->create_motr_kvs_writer(request, s3_motr_api);
   }
-  motr_kv_writer->delete_keyval(global_probable_dead_object_list_index_oid,
-                                new_oid_str,
-                                std::bind(&S3PutObjectAction::next, this),
-                                std::bind(&S3PutObjectAction::next, this));
+  probable_rec_kv_writer->delete_keyval(
+      global_probable_dead_object_list_index_oid, new_oid_str,
+      std::bind(&S3PutObjectAction::next, this),
+      std::bind(&S3PutObjectAction::next, this));
   s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
 }
 
@@ -912,6 +1015,11 @@ void S3PutObjectAction::delete_old_object() {
     next();
     return;
   }
+  if (!motr_writer) {
+    // Inline object was put, no writer was needed so far.
+    motr_writer =
+        motr_writer_factory->create_motr_writer(request, old_object_oid);
+  }
   motr_writer->set_oid(old_object_oid);
   motr_writer->delete_object(
       std::bind(&S3PutObjectAction::remove_old_object_version_metadata, this),
@@ -31,6 +31,7 @@
 #include "s3_bucket_metadata.h"
 #include "s3_motr_writer.h"
 #include "s3_factory.h"
+#include "s3_md5_hash.h"
 #include "s3_object_metadata.h"
 #include "s3_probable_delete_record.h"
 #include "s3_timer.h"
@@ -49,11 +50,19 @@ class S3PutObjectAction : public S3ObjectAction {
   std::string salt;
   std::shared_ptr<S3MotrWiter> motr_writer;
   std::shared_ptr<S3MotrKVSWriter> motr_kv_writer;
+  // Removes probable delete records, may run along with motr_kv_writer.
+  std::shared_ptr<S3MotrKVSWriter> probable_rec_kv_writer;
 
   size_t total_data_to_stream;
   S3Timer s3_timer;
   bool write_in_progress;
 
+  // Object small enough to be stored inline in its metadata, no motr object
+  // is created for it. See S3_SERVER_OBJECT_INLINE_MAX_SIZE.
+  bool store_inline;
+  std::string inline_data;
+  MD5hash inline_data_md5;
+
   std::shared_ptr<S3MotrWriterFactory> motr_writer_factory;
   std::shared_ptr<S3PutTagsBodyFactory> put_object_tag_body_factory;
   std::shared_ptr<S3MotrKVSWriterFactory> mote_kv_writer_factory;
@@ -70,6 +79,9 @@ class S3PutObjectAction : public S3ObjectAction {
 
   void create_new_oid(struct m0_uint128 current_oid);
   void collision_detected();
+  void create_new_object_metadata();
+  std::string get_content_md5();
+  std::string get_content_md5_base64();
 
   // Only for use with UT
  protected:
@@ -103,6 +115,10 @@ class S3PutObjectAction : public S3ObjectAction {
   void add_object_oid_to_probable_dead_oid_list();
   void add_object_oid_to_probable_dead_oid_list_failed();
 
+  void read_inline_data();
+  void consume_inline_data();
+  void create_inline_object();
+
   void initiate_data_streaming();
   void consume_incoming_content();
   void write_object(std::shared_ptr<S3AsyncBufferOptContainer> buffer);
@@ -192,6 +208,11 @@ class S3PutObjectAction : public S3ObjectAction {
   FRIEND_TEST(S3PutObjectActionTest, SendFailedResponse);
   FRIEND_TEST(S3PutObjectActionTest, ConsumeIncomingContentRequestTimeout);
   FRIEND_TEST(S3PutObjectActionTest, DelayedDeleteOldObject);
+  FRIEND_TEST(S3PutObjectActionTest, SmallObjectIsStoredInline);
+  FRIEND_TEST(S3PutObjectActionTest, CreateInlineObject);
+  FRIEND_TEST(S3PutObjectActionTest, CreateInlineObjectOverwrite);
+  FRIEND_TEST(S3PutObjectActionTest, SaveMetadataOfInlineObject);
+  FRIEND_TEST(S3PutObjectActionTest, CleanupAfterInlineObjectOverwrite);
 };
 
 #endif
@@ -180,6 +180,14 @@ void S3PutObjectActionBase::create_object_successful() {
   s3_log(S3_LOG_INFO, request_id, "Entering\n");
   s3_put_action_state = S3PutObjectActionState::newObjOidCreated;
 
+  create_new_object_metadata();
+  new_object_metadata->set_oid(motr_writer->get_oid());
+
+  add_object_oid_to_probable_dead_oid_list();
+  s3_log(S3_LOG_DEBUG, "", "Exiting\n");
+}
+
+void S3PutObjectActionBase::create_new_object_metadata() {
   // New Object or overwrite, create new metadata and release old.
   new_object_metadata = object_metadata_factory->create_object_metadata_obj(
       request, bucket_metadata->get_object_list_index_oid());
@@ -190,11 +198,7 @@ void S3PutObjectActionBase::create_object_successful() {
 
   // Generate a version id for the new object.
   new_object_metadata->regenerate_version_id();
-  new_object_metadata->set_oid(motr_writer->get_oid());
   new_object_metadata->set_layout_id(layout_id);
-
-  add_object_oid_to_probable_dead_oid_list();
-  s3_log(S3_LOG_DEBUG, "", "Exiting\n");
 }
 
 void S3PutObjectActionBase::create_object_failed() {
@@ -289,17 +293,20 @@ void S3PutObjectActionBase::add_object_oid_to_probable_dead_oid_list() {
     probable_oid_list[old_oid_rec_key] = old_probable_del_rec->to_json();
   }
 
-  s3_log(S3_LOG_DEBUG, request_id,
-         "Adding new_probable_del_rec with key [%s]\n", new_oid_str.c_str());
-  new_probable_del_rec.reset(new S3ProbableDeleteRecord(
-      new_oid_str, old_object_oid, new_object_metadata->get_object_name(),
-      new_object_oid, layout_id, bucket_metadata->get_object_list_index_oid(),
-      bucket_metadata->get_objects_version_list_index_oid(),
-      new_object_metadata->get_version_key_in_index(),
-      false /* force_delete */));
+  if (!new_object_inline) {
+    s3_log(S3_LOG_DEBUG, request_id,
+           "Adding new_probable_del_rec with key [%s]\n", new_oid_str.c_str());
+    new_probable_del_rec.reset(new S3ProbableDeleteRecord(
+        new_oid_str, old_object_oid, new_object_metadata->get_object_name(),
+        new_object_oid, layout_id,
+        bucket_metadata->get_object_list_index_oid(),
+        bucket_metadata->get_objects_version_list_index_oid(),
+        new_object_metadata->get_version_key_in_index(),
+        false /* force_delete */));
 
-  // store new oid, key = newoid
-  probable_oid_list[new_oid_str] = new_probable_del_rec->to_json();
+    // store new oid, key = newoid
+    probable_oid_list[new_oid_str] = new_probable_del_rec->to_json();
+  }
 
   if (!motr_kv_writer) {
     motr_kv_writer =
@@ -329,16 +336,37 @@ void S3PutObjectActionBase::add_object_oid_to_probable_dead_oid_list_failed() {
 
 void S3PutObjectActionBase::startcleanup() {
   s3_log(S3_LOG_INFO, request_id, "Entering\n");
-  // TODO: Perf - all/some of below tasks can be done in parallel
   // Any of the following steps fail, backgrounddelete will be able to perform
   // cleanups.
   // Clear task list and setup cleanup task list
   clear_tasks();
   cleanup_started = true;
 
-  // Success conditions
-  if (s3_put_action_state == S3PutObjectActionState::completed) {
+  if (new_object_inline) {
+    // There is no new motr object to undo, only old one may need cleanup.
+    s3_log(S3_LOG_DEBUG, request_id,
+           "Cleanup for inline object: s3_put_action_state[%d]\n",
+           s3_put_action_state);
+    if (s3_put_action_state == S3PutObjectActionState::completed) {
+      if (old_object_oid.u_hi || old_object_oid.u_lo) {
+        ACTION_TASK_ADD(S3PutObjectActionBase::mark_old_oid_for_deletion,
+                        this);
+        ACTION_TASK_ADD(S3PutObjectActionBase::delete_old_object, this);
+      } else if (replaces_inline_object()) {
+        ACTION_TASK_ADD(
+            S3PutObjectActionBase::remove_inline_object_version_metadata,
+            this);
+      }
+    } else if (old_probable_del_rec) {
+      // Old object stays, remove old oid from probable delete list.
+      ACTION_TASK_ADD(S3PutObjectActionBase::remove_old_oid_probable_record,
+                      this);
+    }
+  } else if (s3_put_action_state == S3PutObjectActionState::completed) {
+    // Success conditions
     s3_log(S3_LOG_DEBUG, request_id, "Cleanup old Object\n");
+    // Both records are independent, update them together.
+    begin_task_group();
     if (old_object_oid.u_hi || old_object_oid.u_lo) {
       // mark old OID for deletion in overwrite case, this optimizes
       // backgrounddelete decisions.
@@ -347,10 +375,14 @@ void S3PutObjectActionBase::startcleanup() {
     // remove new oid from probable delete list.
     ACTION_TASK_ADD(S3PutObjectActionBase::remove_new_oid_probable_record,
                     this);
+    end_task_group();
     if (old_object_oid.u_hi || old_object_oid.u_lo) {
       // Object overwrite case, old object exists, delete it.
       ACTION_TASK_ADD(S3PutObjectActionBase::delete_old_object, this);
       // If delete object is successful, attempt to delete old probable record
+    } else if (replaces_inline_object()) {
+      ACTION_TASK_ADD(
+          S3PutObjectActionBase::remove_inline_object_version_metadata, this);
     }
   } else if (s3_put_action_state == S3PutObjectActionState::newObjOidCreated ||
              s3_put_action_state == S3PutObjectActionState::writeFailed ||
@@ -362,15 +394,30 @@ void S3PutObjectActionBase::startcleanup() {
     s3_log(S3_LOG_DEBUG, request_id,
            "Cleanup new Object: s3_put_action_state[%d]\n",
            s3_put_action_state);
-    // Mark new OID for deletion, this optimizes backgrounddelete decisionss.
-    ACTION_TASK_ADD(S3PutObjectActionBase::mark_new_oid_for_deletion, this);
-    if (old_object_oid.u_hi || old_object_oid.u_lo) {
-      // remove old oid from probable delete list.
-      ACTION_TASK_ADD(S3PutObjectActionBase::remove_old_oid_probable_record,
+    if (object_data_shared) {
+      // Data belongs to the object it is shared with, forced deletion would
+      // let BD delete it. Only remove new oid from probable delete list.
+      ACTION_TASK_ADD(S3PutObjectActionBase::remove_new_oid_probable_record,
                       this);
+      if (old_object_oid.u_hi || old_object_oid.u_lo) {
+        ACTION_TASK_ADD(S3PutObjectActionBase::remove_old_oid_probable_record,
+                        this);
+      }
+    } else {
+      begin_task_group();
+      // Mark new OID for deletion, this optimizes backgrounddelete
+      // decisions.
+      ACTION_TASK_ADD(S3PutObjectActionBase::mark_new_oid_for_deletion, this);
+      if (old_object_oid.u_hi || old_object_oid.u_lo) {
+        // remove old oid from probable delete list.
+        ACTION_TASK_ADD(S3PutObjectActionBase::remove_old_oid_probable_record,
+                        this);
+      }
+      end_task_group();
+      ACTION_TASK_ADD(S3PutObjectActionBase::delete_new_object, this);
+      // If delete object is successful, attempt to delete new probable
+      // record
     }
-    ACTION_TASK_ADD(S3PutObjectActionBase::delete_new_object, this);
-    // If delete object is successful, attempt to delete new probable record
   } else {
     s3_log(S3_LOG_DEBUG, request_id,
            "No Cleanup required: s3_put_action_state[%d]\n",
@@ -436,14 +483,14 @@ void S3PutObjectActionBase::remove_old_oid_probable_record() {
   // key = oldoid + "-" + newoid
   std::string old_oid_rec_key = old_oid_str + '-' + new_oid_str;
 
-  if (!motr_kv_writer) {
-    motr_kv_writer =
+  if (!probable_rec_kv_writer) {
+    probable_rec_kv_writer =
         mote_kv_writer_factory->create_motr_kvs_writer(request, s3_motr_api);
   }
-  motr_kv_writer->delete_keyval(global_probable_dead_object_list_index_oid,
-                                old_oid_rec_key,
-                                std::bind(&S3PutObjectActionBase::next, this),
-                                std::bind(&S3PutObjectActionBase::next, this));
+  probable_rec_kv_writer->delete_keyval(
+      global_probable_dead_object_list_index_oid, old_oid_rec_key,
+      std::bind(&S3PutObjectActionBase::next, this),
+      std::bind(&S3PutObjectActionBase::next, this));
   s3_log(S3_LOG_DEBUG, "", "Exiting\n");
 }
 
@@ -451,14 +498,14 @@ void S3PutObjectActionBase::remove_new_oid_probable_record() {
   s3_log(S3_LOG_INFO, request_id, "Entering\n");
   assert(!new_oid_str.empty());
 
-  if (!motr_kv_writer) {
-    motr_kv_writer =
+  if (!probable_rec_kv_writer) {
+    probable_rec_kv_writer =
         mote_kv_writer_factory->create_motr_kvs_writer(request, s3_motr_api);
   }
-  motr_kv_writer->delete_keyval(global_probable_dead_object_list_index_oid,
-                                new_oid_str,
-                                std::bind(&S3PutObjectActionBase::next, this),
-                                std::bind(&S3PutObjectActionBase::next, this));
+  probable_rec_kv_writer->delete_keyval(
+      global_probable_dead_object_list_index_oid, new_oid_str,
+      std::bind(&S3PutObjectActionBase::next, this),
+      std::bind(&S3PutObjectActionBase::next, this));
   s3_log(S3_LOG_DEBUG, "", "Exiting\n");
 }
 
@@ -467,6 +514,21 @@ void S3PutObjectActionBase::delete_old_object() {
   // If PUT is success, we delete old object if present
   assert(old_object_oid.u_hi != 0ULL || old_object_oid.u_lo != 0ULL);
 
+  // Old object may share its data with other objects, then only BD can tell
+  // when the data is not referred any more.
+  if (S3Option::get_instance()->is_s3server_obj_delayed_del_enabled()) {
+    s3_log(S3_LOG_INFO, request_id,
+           "Skipping deletion of old object. The old object will be deleted by "
+           "BD.\n");
+    // Call next task in the pipeline
+    next();
+    return;
+  }
+  if (!motr_writer) {
+    // New object is inline, no writer was needed so far.
+    motr_writer =
+        motr_writer_factory->create_motr_writer(request, old_object_oid);
+  }
   motr_writer->set_oid(old_object_oid);
   motr_writer->delete_object(
       std::bind(&S3PutObjectActionBase::remove_old_object_version_metadata,
@@ -75,6 +75,7 @@ class S3PutObjectActionBase : public S3ObjectAction {
   void create_object_failed();
   void collision_detected();
   void create_new_oid(struct m0_uint128);
+  void create_new_object_metadata();
 
   void set_authorization_meta();
 
@@ -99,6 +100,8 @@ class S3PutObjectActionBase : public S3ObjectAction {
 
   std::shared_ptr<S3MotrWiter> motr_writer;
   std::shared_ptr<S3MotrKVSWriter> motr_kv_writer;
+  // Removes probable delete records, may run along with motr_kv_writer.
+  std::shared_ptr<S3MotrKVSWriter> probable_rec_kv_writer;
   std::shared_ptr<MotrAPI> s3_motr_api;
 
   std::shared_ptr<S3ObjectMetadata> new_object_metadata;
@@ -121,4 +124,8 @@ class S3PutObjectActionBase : public S3ObjectAction {
 
   S3PutObjectActionState s3_put_action_state = S3PutObjectActionState::empty;
   bool write_in_progress = false;
+  // New object refers data of another object instead of its own motr object.
+  bool object_data_shared = false;
+  // New object keeps its data in its metadata, it has no motr object.
+  bool new_object_inline = false;
 };
@@ -0,0 +1,578 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cmath>
+
+#include "event_utils.h"
+#include "s3_log.h"
+#include "s3_memory_profile.h"
+#include "s3_option.h"
+#include "s3_qos_scheduler.h"
+#include "s3_stats.h"
+
+// Requests waiting for memory are retried at this interval even if no
+// other request gives memory back, as the pool is shared with libevent.
+#define S3_QOS_MEMORY_RETRY_USEC 10000
+
+S3QosScheduler* S3QosScheduler::instance = NULL;
+
+S3TokenBucket::S3TokenBucket(double rate_per_sec, unsigned burst_msec,
+                             std::chrono::steady_clock::time_point now)
+    : rate(rate_per_sec),
+      capacity(rate_per_sec * burst_msec / 1000),
+      tokens(capacity),
+      last_refill(now) {}
+
+void S3TokenBucket::refill(std::chrono::steady_clock::time_point now) {
+  if (!is_limited() || now <= last_refill) {
+    return;
+  }
+  std::chrono::duration<double> elapsed = now - last_refill;
+  tokens = std::min(capacity, tokens + elapsed.count() * rate);
+  last_refill = now;
+}
+
+int64_t S3TokenBucket::get_wait_usec(double count) const {
+  if (!is_limited()) {
+    return 0;
+  }
+  const double needed = std::min(count, capacity);
+  if (tokens >= needed) {
+    return 0;
+  }
+  const int64_t wait_usec = std::ceil((needed - tokens) / rate * 1e6);
+  return std::max((int64_t)1, wait_usec);
+}
+
+void S3TokenBucket::take(double count) {
+  if (is_limited()) {
+    tokens -= count;
+  }
+}
+
+S3QosTicket::~S3QosTicket() {
+  S3QosScheduler* scheduler = S3QosScheduler::get_instance();
+  if (scheduler) {
+    scheduler->release(*this);
+  }
+}
+
+S3QosScheduler::S3QosScheduler(const Config& cfg, MemoryCheck check,
+                               WakeupScheduler wakeup)
+    : config(cfg),
+      memory_check(std::move(check)),
+      schedule_wakeup(std::move(wakeup)) {}
+
+S3QosScheduler::Account& S3QosScheduler::get_account(
+    const std::string& name, std::chrono::steady_clock::time_point now) {
+  auto it = accounts.find(name);
+  if (it != accounts.end()) {
+    return it->second;
+  }
+  Account& account = accounts[name];
+  auto weight = config.account_weights.find(name);
+  if (weight != config.account_weights.end() && weight->second > 0) {
+    account.weight = weight->second;
+  }
+  account.bandwidth = S3TokenBucket(config.account_bandwidth_limit,
+                                    config.burst_msec, now);
+  account.iops =
+      S3TokenBucket(config.account_iops_limit, config.burst_msec, now);
+  account.metrics.account = name.empty() ? "anonymous" : name;
+  return account;
+}
+
+S3QosScheduler::Bucket& S3QosScheduler::get_bucket(
+    const std::string& name, std::chrono::steady_clock::time_point now) {
+  auto it = buckets.find(name);
+  if (it != buckets.end()) {
+    return it->second;
+  }
+  Bucket& bucket = buckets[name];
+  bucket.bandwidth =
+      S3TokenBucket(config.bucket_bandwidth_limit, config.burst_msec, now);
+  bucket.iops = S3TokenBucket(config.bucket_iops_limit, config.burst_msec, now);
+  return bucket;
+}
+
+void S3QosScheduler::update_memory_users(Account& account, bool was_using) {
+  const bool is_using =
+      account.memory_reserved > 0 || account.memory_waiting > 0;
+  if (is_using && !was_using) {
+    ++accounts_using_memory;
+  } else if (!is_using && was_using) {
+    --accounts_using_memory;
+  }
+}
+
+// State of access keys and buckets is kept only while it matters: while
+// they have requests, their limits are in use or metrics are to report.
+void S3QosScheduler::forget_idle(const std::string& account_name,
+                                 const std::string& bucket_name) {
+  const auto now = std::chrono::steady_clock::now();
+  auto account_it = accounts.find(account_name);
+  if (account_it != accounts.end()) {
+    Account& account = account_it->second;
+    account.bandwidth.refill(now);
+    account.iops.refill(now);
+    const S3QosAccountMetrics& metrics = account.metrics;
+    if (account.in_flight == 0 && account.queue_count == 0 &&
+        account.memory_reserved == 0 && account.bandwidth.is_full() &&
+        account.iops.is_full() &&
+        (!config.metrics_enabled ||
+         (metrics.admitted == 0 && metrics.rejected == 0))) {
+      accounts.erase(account_it);
+    }
+  }
+  auto bucket_it = buckets.find(bucket_name);
+  if (bucket_it != buckets.end()) {
+    Bucket& bucket = bucket_it->second;
+    bucket.bandwidth.refill(now);
+    bucket.iops.refill(now);
+    if (bucket.in_flight == 0 && bucket.queue_count == 0 &&
+        bucket.bandwidth.is_full() && bucket.iops.is_full()) {
+      buckets.erase(bucket_it);
+    }
+  }
+}
+
+int64_t S3QosScheduler::get_wait_usec(const Entry& entry, Account& account,
+                                      Bucket& bucket) {
+  const S3QosRequest& request = entry.request;
+  int64_t wait_usec = std::max(
+      {account.iops.get_wait_usec(1), bucket.iops.get_wait_usec(1),
+       account.bandwidth.get_wait_usec(request.bytes),
+       bucket.bandwidth.get_wait_usec(request.bytes)});
+  if (wait_usec > 0 || request.memory == 0) {
+    return wait_usec;
+  }
+  if (account.memory_reserved > 0 && config.memory_budget > 0) {
+    // Each access key needing memory may hold its share of the budget,
+    // and at least memory of one request.
+    const size_t fair_share =
+        config.memory_budget / std::max((size_t)1, accounts_using_memory);
+    if (account.memory_reserved + request.memory > fair_share) {
+      return -1;
+    }
+  }
+  if (memory_check && !memory_check(memory_reserved + request.memory)) {
+    return -1;
+  }
+  return 0;
+}
+
+void S3QosScheduler::take_tokens(Account& account, Bucket& bucket,
+                                 size_t bytes) {
+  account.iops.take(1);
+  bucket.iops.take(1);
+  account.bandwidth.take(bytes);
+  bucket.bandwidth.take(bytes);
+}
+
+std::unique_ptr<S3QosTicket> S3QosScheduler::admit(
+    Entry& entry, Account& account, Bucket& bucket,
+    std::chrono::steady_clock::time_point now) {
+  const S3QosRequest& request = entry.request;
+  if (request.charge_on_admission) {
+    take_tokens(account, bucket, request.bytes);
+  }
+  ++account.in_flight;
+  ++bucket.in_flight;
+  --account.queue_depth;
+  if (request.memory > 0) {
+    const bool was_using = true;
+    account.memory_reserved += request.memory;
+    memory_reserved += request.memory;
+    --account.memory_waiting;
+    update_memory_users(account, was_using);
+  }
+  ++account.metrics.admitted;
+  if (entry.queued_at != now) {
+    s3_stats_timing("qos_queue_wait_time",
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        now - entry.queued_at).count());
+  }
+
+  std::unique_ptr<S3QosTicket> ticket(new S3QosTicket());
+  ticket->account = request.account;
+  ticket->bucket = request.bucket;
+  ticket->memory = request.memory;
+  ticket->bytes = request.bytes;
+  ticket->charged = request.charge_on_admission;
+  return ticket;
+}
+
+void S3QosScheduler::schedule(
+    std::chrono::steady_clock::time_point now,
+    std::vector<std::function<void()>>& callbacks, uint64_t submitted_id,
+    std::unique_ptr<S3QosTicket>& submitted_ticket) {
+  const auto max_wait = std::chrono::milliseconds(config.max_queue_wait_msec);
+
+  // Requests waiting for too long are rejected, they are first in queues.
+  for (Queue* queue : active_queues) {
+    Account& account = accounts[queue->account];
+    while (!queue->entries.empty() &&
+           now - queue->entries.front().queued_at >= max_wait) {
+      Entry& entry = queue->entries.front();
+      s3_log(S3_LOG_INFO, "",
+             "QoS: request of %s to bucket %s waited for too long\n",
+             account.metrics.account.c_str(), queue->bucket.c_str());
+      --account.queue_depth;
+      if (entry.request.memory > 0) {
+        const bool was_using = true;
+        --account.memory_waiting;
+        update_memory_users(account, was_using);
+      }
+      ++account.metrics.rejected;
+      s3_stats_inc("qos_rejected_count");
+      callbacks.push_back(std::move(entry.request.reject));
+      queue->entries.pop_front();
+    }
+  }
+
+  // Deficit round robin. A queue which cannot use its turns keeps its
+  // place, so it is served first once its limits or memory allow.
+  int64_t wakeup_usec = -1;
+  auto wake_in = [&wakeup_usec](int64_t usec) {
+    if (wakeup_usec < 0 || usec < wakeup_usec) {
+      wakeup_usec = usec;
+    }
+  };
+  bool admitted = true;
+  while (admitted) {
+    admitted = false;
+    wakeup_usec = -1;
+    auto it = active_queues.begin();
+    for (size_t count = active_queues.size(); count > 0; --count) {
+      Queue* queue = *it;
+      Account& account = accounts[queue->account];
+      Bucket& bucket = buckets[queue->bucket];
+      account.bandwidth.refill(now);
+      account.iops.refill(now);
+      bucket.bandwidth.refill(now);
+      bucket.iops.refill(now);
+      if (queue->deficit <= 0) {
+        queue->deficit += account.weight;
+      }
+      while (!queue->entries.empty() && queue->deficit > 0) {
+        Entry& entry = queue->entries.front();
+        const int64_t wait_usec = get_wait_usec(entry, account, bucket);
+        if (wait_usec != 0) {
+          if (wait_usec > 0 && !entry.throttled) {
+            entry.throttled = true;
+            ++account.metrics.throttled;
+            s3_stats_inc("qos_throttled_count");
+          }
+          wake_in(wait_usec > 0 ? wait_usec : S3_QOS_MEMORY_RETRY_USEC);
+          wake_in(std::chrono::duration_cast<std::chrono::microseconds>(
+                      entry.queued_at + max_wait - now).count());
+          break;
+        }
+        std::unique_ptr<S3QosTicket> ticket =
+            admit(entry, account, bucket, now);
+        if (entry.id == submitted_id) {
+          submitted_ticket = std::move(ticket);
+        } else {
+          auto admit_cb = std::move(entry.request.admit);
+          S3QosTicket* raw_ticket = ticket.release();
+          callbacks.push_back([admit_cb, raw_ticket]() {
+            admit_cb(std::unique_ptr<S3QosTicket>(raw_ticket));
+          });
+        }
+        queue->entries.pop_front();
+        --queue->deficit;
+        admitted = true;
+      }
+
+      if (queue->entries.empty()) {
+        --account.queue_count;
+        --bucket.queue_count;
+        it = active_queues.erase(it);
+        const std::string account_name = queue->account;
+        const std::string bucket_name = queue->bucket;
+        queues.erase(QueueKey(account_name, bucket_name));
+        forget_idle(account_name, bucket_name);
+      } else if (queue->deficit > 0) {
+        ++it;
+      } else {
+        auto next = std::next(it);
+        active_queues.splice(active_queues.end(), active_queues, it);
+        it = next;
+      }
+    }
+  }
+
+  if (wakeup_usec >= 0 && schedule_wakeup) {
+    schedule_wakeup(wakeup_usec);
+  }
+}
+
+std::unique_ptr<S3QosTicket> S3QosScheduler::submit(S3QosRequest request) {
+  const auto now = std::chrono::steady_clock::now();
+  std::vector<std::function<void()>> callbacks;
+  std::unique_ptr<S3QosTicket> ticket;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    const QueueKey key(request.account, request.bucket);
+    Account& account = get_account(request.account, now);
+    Bucket& bucket = get_bucket(request.bucket, now);
+    auto queue_it = queues.find(key);
+    const size_t queue_depth =
+        queue_it == queues.end() ? 0 : queue_it->second.entries.size();
+
+    if (queue_depth >= config.max_queue_depth) {
+      s3_log(S3_LOG_INFO, "", "QoS: queue of %s to bucket %s is full\n",
+             account.metrics.account.c_str(), request.bucket.c_str());
+      ++account.metrics.rejected;
+      s3_stats_inc("qos_rejected_count");
+      callbacks.push_back(std::move(request.reject));
+      forget_idle(key.first, key.second);
+    } else {
+      if (queue_it == queues.end()) {
+        queue_it = queues.insert(std::make_pair(key, Queue())).first;
+        queue_it->second.account = request.account;
+        queue_it->second.bucket = request.bucket;
+        ++account.queue_count;
+        ++bucket.queue_count;
+      }
+      Queue& queue = queue_it->second;
+      if (request.memory > 0) {
+        const bool was_using =
+            account.memory_reserved > 0 || account.memory_waiting > 0;
+        ++account.memory_waiting;
+        update_memory_users(account, was_using);
+      }
+      ++account.queue_depth;
+      const uint64_t id = ++last_entry_id;
+      queue.entries.push_back(Entry());
+      queue.entries.back().request = std::move(request);
+      queue.entries.back().id = id;
+      queue.entries.back().queued_at = now;
+      if (queue.entries.size() == 1) {
+        active_queues.push_back(&queue);
+      }
+      schedule(now, callbacks, id, ticket);
+      if (!ticket) {
+        // Still queued, so its access key is known.
+        ++accounts[key.first].metrics.queued;
+        s3_stats_inc("qos_queued_count");
+      }
+    }
+  }
+  for (auto& callback : callbacks) {
+    callback();
+  }
+  return ticket;
+}
+
+void S3QosScheduler::charge(S3QosTicket& ticket) {
+  if (ticket.charged) {
+    return;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> guard(lock);
+  Account& account = get_account(ticket.account, now);
+  Bucket& bucket = get_bucket(ticket.bucket, now);
+  account.iops.refill(now);
+  account.bandwidth.refill(now);
+  bucket.iops.refill(now);
+  bucket.bandwidth.refill(now);
+  take_tokens(account, bucket, ticket.bytes);
+  ticket.charged = true;
+}
+
+void S3QosScheduler::release(const S3QosTicket& ticket) {
+  const auto now = std::chrono::steady_clock::now();
+  std::vector<std::function<void()>> callbacks;
+  std::unique_ptr<S3QosTicket> no_ticket;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    Account& account = get_account(ticket.account, now);
+    Bucket& bucket = get_bucket(ticket.bucket, now);
+    --account.in_flight;
+    --bucket.in_flight;
+    if (ticket.memory > 0) {
+      const bool was_using = true;
+      account.memory_reserved -= ticket.memory;
+      memory_reserved -= ticket.memory;
+      update_memory_users(account, was_using);
+    }
+    // Size of responses is known only now, following requests wait while
+    // their access key or bucket is in debt.
+    if (ticket.charged) {
+      account.bandwidth.refill(now);
+      account.bandwidth.take(ticket.bytes_sent);
+      bucket.bandwidth.refill(now);
+      bucket.bandwidth.take(ticket.bytes_sent);
+    }
+    schedule(now, callbacks, 0, no_ticket);
+    forget_idle(ticket.account, ticket.bucket);
+  }
+  for (auto& callback : callbacks) {
+    callback();
+  }
+}
+
+void S3QosScheduler::wakeup() {
+  std::vector<std::function<void()>> callbacks;
+  std::unique_ptr<S3QosTicket> no_ticket;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    schedule(std::chrono::steady_clock::now(), callbacks, 0, no_ticket);
+  }
+  for (auto& callback : callbacks) {
+    callback();
+  }
+}
+
+size_t S3QosScheduler::get_queue_depth(const std::string& account,
+                                       const std::string& bucket) {
+  std::lock_guard<std::mutex> guard(lock);
+  auto it = queues.find(QueueKey(account, bucket));
+  return it == queues.end() ? 0 : it->second.entries.size();
+}
+
+std::vector<S3QosAccountMetrics> S3QosScheduler::collect_metrics() {
+  std::vector<S3QosAccountMetrics> all_metrics;
+  std::lock_guard<std::mutex> guard(lock);
+  std::vector<std::string> names;
+  for (auto& it : accounts) {
+    Account& account = it.second;
+    S3QosAccountMetrics& metrics = account.metrics;
+    metrics.queue_depth = account.queue_depth;
+    metrics.in_flight = account.in_flight;
+    metrics.memory_reserved = account.memory_reserved;
+    all_metrics.push_back(metrics);
+    metrics.admitted = metrics.queued = metrics.throttled = 0;
+    metrics.rejected = 0;
+    names.push_back(it.first);
+  }
+  for (const auto& name : names) {
+    forget_idle(name, "");
+  }
+  std::vector<std::string> bucket_names;
+  for (const auto& it : buckets) {
+    bucket_names.push_back(it.first);
+  }
+  for (const auto& name : bucket_names) {
+    forget_idle("", name);
+  }
+  return all_metrics;
+}
+
+void S3QosScheduler::log_metrics() {
+  for (const auto& metrics : collect_metrics()) {
+    s3_log(S3_LOG_INFO, "",
+           "QoS metrics of %s: queue_depth = %zu in_flight = %zu "
+           "memory_reserved = %zu admitted = %" PRIu64 " queued = %" PRIu64
+           " throttled = %" PRIu64 " rejected = %" PRIu64 "\n",
+           metrics.account.c_str(), metrics.queue_depth, metrics.in_flight,
+           metrics.memory_reserved, metrics.admitted, metrics.queued,
+           metrics.throttled, metrics.rejected);
+  }
+}
+
+// Recurring event logging metrics of the scheduler.
+class S3QosMetricsEvent : public RecurringEventBase {
+ public:
+  S3QosMetricsEvent(std::shared_ptr<EventInterface> event_obj_ptr,
+                    evbase_t *evbase_ = nullptr)
+      : RecurringEventBase(std::move(event_obj_ptr), evbase_) {}
+
+  virtual void action_callback(void) noexcept {
+    if (S3QosScheduler::get_instance()) {
+      S3QosScheduler::get_instance()->log_metrics();
+    }
+  }
+};
+
+static struct event *gs_qos_wakeup_event;
+static std::shared_ptr<S3QosMetricsEvent> gs_qos_metrics_event;
+
+static void on_qos_wakeup(evutil_socket_t, short, void *) {
+  if (S3QosScheduler::get_instance()) {
+    S3QosScheduler::get_instance()->wakeup();
+  }
+}
+
+int s3_qos_init(struct event_base *evbase) {
+  S3Option *option = S3Option::get_instance();
+  if (!option->is_qos_enabled()) {
+    return 0;
+  }
+  if (!evbase) {
+    return -EINVAL;
+  }
+  gs_qos_wakeup_event = evtimer_new(evbase, on_qos_wakeup, NULL);
+  if (!gs_qos_wakeup_event) {
+    return -ENOMEM;
+  }
+
+  S3QosScheduler::Config config;
+  config.account_bandwidth_limit = option->get_qos_account_bandwidth_limit();
+  config.account_iops_limit = option->get_qos_account_iops_limit();
+  config.bucket_bandwidth_limit = option->get_qos_bucket_bandwidth_limit();
+  config.bucket_iops_limit = option->get_qos_bucket_iops_limit();
+  config.burst_msec = option->get_qos_burst_msec();
+  config.max_queue_depth = option->get_qos_max_queue_depth();
+  config.max_queue_wait_msec = option->get_qos_max_queue_wait_msec();
+  config.memory_budget = option->get_libevent_pool_max_threshold();
+  config.account_weights = option->get_qos_account_weights();
+  config.metrics_enabled = option->get_qos_metrics_interval_sec() > 0;
+  S3QosScheduler::set_instance(new S3QosScheduler(
+      config,
+      [](size_t memory) {
+        return S3MemoryProfile().we_have_enough_free_memory(memory);
+      },
+      [](int64_t usec) {
+        struct timeval tv;
+        tv.tv_sec = usec / 1000000;
+        tv.tv_usec = usec % 1000000;
+        evtimer_add(gs_qos_wakeup_event, &tv);
+      }));
+
+  const unsigned metrics_interval_sec = option->get_qos_metrics_interval_sec();
+  if (metrics_interval_sec > 0) {
+    gs_qos_metrics_event.reset(
+        new S3QosMetricsEvent(std::make_shared<EventWrapper>(), evbase));
+    struct timeval tv;
+    tv.tv_sec = metrics_interval_sec;
+    tv.tv_usec = 0;
+    int rc = gs_qos_metrics_event->add_evtimer(tv);
+    if (rc != 0) {
+      return rc;
+    }
+  }
+  return 0;
+}
+
+void s3_qos_fini() {
+  gs_qos_metrics_event.reset();
+  S3QosScheduler *scheduler = S3QosScheduler::get_instance();
+  S3QosScheduler::set_instance(NULL);
+  delete scheduler;
+  if (gs_qos_wakeup_event) {
+    event_free(gs_qos_wakeup_event);
+    gs_qos_wakeup_event = NULL;
+  }
+}
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_QOS_SCHEDULER_H__
+#define __S3_SERVER_S3_QOS_SCHEDULER_H__
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest_prod.h>
+
+// Token bucket of a bandwidth (bytes) or IOPS (requests) limit. Requests
+// larger than the burst are let through once the bucket is full and leave
+// it in debt, which delays the following requests.
+class S3TokenBucket {
+  // Tokens per second, 0 if unlimited
+  double rate;
+  double capacity;
+  double tokens;
+  std::chrono::steady_clock::time_point last_refill;
+
+ public:
+  S3TokenBucket(double rate_per_sec = 0, unsigned burst_msec = 0,
+                std::chrono::steady_clock::time_point now =
+                    std::chrono::steady_clock::now());
+
+  bool is_limited() const { return rate > 0; }
+  bool is_full() const { return tokens >= capacity; }
+  void refill(std::chrono::steady_clock::time_point now);
+  // Microseconds until 'count' tokens may be taken, 0 if they may be now.
+  int64_t get_wait_usec(double count) const;
+  void take(double count);
+};
+
+struct S3QosTicket;
+
+// Request waiting for admission by S3QosScheduler.
+struct S3QosRequest {
+  // Access key of the request, empty for anonymous requests
+  std::string account;
+  std::string bucket;
+  // Request body, charged to bandwidth limits on admission.
+  size_t bytes = 0;
+  // Memory of the libevent pool needed while the request is served.
+  size_t memory = 0;
+  // Charged to bandwidth and IOPS limits on admission. Otherwise they are
+  // charged by S3QosScheduler::charge() once the access key is verified, so
+  // that requests with a forged signature don't drain its limits.
+  bool charge_on_admission = true;
+  // Called when a queued request is admitted or rejected, possibly from
+  // another thread than the one which submitted it.
+  std::function<void(std::unique_ptr<S3QosTicket>)> admit;
+  std::function<void()> reject;
+};
+
+// Held by an admitted request while it is served, gives reserved memory
+// back and charges bytes sent to the client on destruction.
+struct S3QosTicket {
+  std::string account;
+  std::string bucket;
+  size_t memory = 0;
+  // Request body, charged with the request
+  size_t bytes = 0;
+  size_t bytes_sent = 0;
+  // Set once charged to bandwidth and IOPS limits, only then bytes sent are
+  // charged too.
+  bool charged = false;
+
+  ~S3QosTicket();
+};
+
+// Admission metrics of an access key since they were last collected.
+struct S3QosAccountMetrics {
+  std::string account;
+  size_t queue_depth = 0;
+  size_t in_flight = 0;
+  size_t memory_reserved = 0;
+  uint64_t admitted = 0;
+  // Requests which had to wait for admission
+  uint64_t queued = 0;
+  // Requests which waited for bandwidth or IOPS limits
+  uint64_t throttled = 0;
+  uint64_t rejected = 0;
+};
+
+// Weighted fair admission of S3 requests.
+//
+// Requests wait in a queue per access key and bucket. Queues are served by
+// deficit round robin, in each round a queue may admit as many requests as
+// the weight of its access key. The head of a queue waits while its access
+// key or bucket is over its bandwidth or IOPS limit, or when it needs
+// memory which the pool cannot spare or which would take its access key
+// over a fair share of S3_LIBEVENT_POOL_MAX_THRESHOLD. Other queues are
+// served meanwhile, so a tenant running out of its share of limits or
+// memory no longer blocks everybody else.
+//
+// Requests are rejected when their queue is full or when they waited for
+// longer than S3_QOS_MAX_QUEUE_WAIT_MSEC.
+//
+// The scheduler is shared by all event loops and is thread safe. Request
+// callbacks are never run with its lock held.
+class S3QosScheduler {
+ public:
+  struct Config {
+    size_t account_bandwidth_limit = 0;
+    unsigned account_iops_limit = 0;
+    size_t bucket_bandwidth_limit = 0;
+    unsigned bucket_iops_limit = 0;
+    unsigned burst_msec = 1000;
+    unsigned max_queue_depth = 64;
+    unsigned max_queue_wait_msec = 5000;
+    size_t memory_budget = 0;
+    std::map<std::string, unsigned> account_weights;
+    // Idle access keys are remembered until their metrics are collected.
+    bool metrics_enabled = false;
+  };
+  // Checks the pool can spare given memory. It is asked for memory of the
+  // request plus all memory reserved by admitted requests, as they may not
+  // have allocated it from the pool yet.
+  typedef std::function<bool(size_t)> MemoryCheck;
+  // Asks for wakeup() to be called after given microseconds.
+  typedef std::function<void(int64_t)> WakeupScheduler;
+
+ private:
+  struct Entry {
+    S3QosRequest request;
+    uint64_t id;
+    std::chrono::steady_clock::time_point queued_at;
+    bool throttled = false;
+  };
+
+  struct Account {
+    unsigned weight = 1;
+    S3TokenBucket bandwidth;
+    S3TokenBucket iops;
+    size_t in_flight = 0;
+    size_t memory_reserved = 0;
+    // Queued requests needing memory
+    size_t memory_waiting = 0;
+    size_t queue_depth = 0;
+    size_t queue_count = 0;
+    S3QosAccountMetrics metrics;
+  };
+
+  struct Bucket {
+    S3TokenBucket bandwidth;
+    S3TokenBucket iops;
+    size_t in_flight = 0;
+    size_t queue_count = 0;
+  };
+
+  struct Queue {
+    std::string account;
+    std::string bucket;
+    std::deque<Entry> entries;
+    int64_t deficit = 0;
+  };
+
+  typedef std::pair<std::string, std::string> QueueKey;
+
+  Config config;
+  MemoryCheck memory_check;
+  WakeupScheduler schedule_wakeup;
+
+  std::mutex lock;
+  std::map<std::string, Account> accounts;
+  std::map<std::string, Bucket> buckets;
+  std::map<QueueKey, Queue> queues;
+  // Queues with waiting requests, in round robin order
+  std::list<Queue*> active_queues;
+  uint64_t last_entry_id = 0;
+  size_t accounts_using_memory = 0;
+  // Sum of memory_reserved of all access keys
+  size_t memory_reserved = 0;
+
+  static S3QosScheduler* instance;
+
+  Account& get_account(const std::string& name,
+                       std::chrono::steady_clock::time_point now);
+  Bucket& get_bucket(const std::string& name,
+                     std::chrono::steady_clock::time_point now);
+  void update_memory_users(Account& account, bool was_using);
+  void forget_idle(const std::string& account_name,
+                   const std::string& bucket_name);
+  // Returns 0 if entry may be admitted now, else microseconds to wait or
+  // -1 if it waits for memory.
+  int64_t get_wait_usec(const Entry& entry, Account& account,
+                        Bucket& bucket);
+  void take_tokens(Account& account, Bucket& bucket, size_t bytes);
+  std::unique_ptr<S3QosTicket> admit(Entry& entry, Account& account,
+                                     Bucket& bucket,
+                                     std::chrono::steady_clock::time_point now);
+  // Admits what can be admitted and rejects expired requests, callbacks
+  // are added to 'callbacks' to be run without the lock.
+  void schedule(std::chrono::steady_clock::time_point now,
+                std::vector<std::function<void()>>& callbacks,
+                uint64_t submitted_id,
+                std::unique_ptr<S3QosTicket>& submitted_ticket);
+
+ public:
+  S3QosScheduler(const Config& cfg, MemoryCheck check,
+                 WakeupScheduler wakeup);
+  virtual ~S3QosScheduler() = default;
+
+  // Returns NULL when QoS is disabled.
+  static S3QosScheduler* get_instance() { return instance; }
+  static void set_instance(S3QosScheduler* scheduler) {
+    instance = scheduler;
+  }
+
+  // Returns a ticket if the request is admitted right away, its callbacks
+  // are not called then. Otherwise request is queued, or rejected through
+  // its reject callback before submit() returns.
+  std::unique_ptr<S3QosTicket> submit(S3QosRequest request);
+  // Charges a request admitted without charge_on_admission to limits of
+  // its access key and bucket, once authenticated.
+  void charge(S3QosTicket& ticket);
+  void release(const S3QosTicket& ticket);
+  // Called when the time asked by WakeupScheduler has come.
+  void wakeup();
+
+  size_t get_queue_depth(const std::string& account, const std::string& bucket);
+  std::vector<S3QosAccountMetrics> collect_metrics();
+  void log_metrics();
+
+  FRIEND_TEST(S3QosSchedulerTest, IdleStateIsForgotten);
+};
+
+// Create (when S3_QOS_ENABLED) and destroy the scheduler, its timers run
+// on the given event base.
+int s3_qos_init(struct event_base *evbase);
+void s3_qos_fini();
+
+#endif  // __S3_SERVER_S3_QOS_SCHEDULER_H__
@@ -55,6 +55,17 @@ S3RequestObject::S3RequestObject(
 S3RequestObject::~S3RequestObject() {
   s3_log(S3_LOG_DEBUG, request_id, "%s\n", __func__);
   populate_and_log_audit_info();
+  if (qos_ticket) {
+    // Admission of following requests takes the response into account.
+    qos_ticket->bytes_sent = bytes_sent;
+  }
+}
+
+void S3RequestObject::charge_qos_ticket() {
+  S3QosScheduler* scheduler = S3QosScheduler::get_instance();
+  if (qos_ticket && scheduler) {
+    scheduler->charge(*qos_ticket);
+  }
 }
 
 S3AuditInfo& S3RequestObject::get_audit_info() { return audit_log_obj; }
@@ -41,6 +41,7 @@
 #include "s3_log.h"
 #include "s3_option.h"
 #include "s3_perf_logger.h"
+#include "s3_qos_scheduler.h"
 #include "s3_timer.h"
 #include "s3_uuid.h"
 #include "s3_audit_info.h"
@@ -59,6 +60,11 @@ class S3RequestObject : public RequestObject {
   S3ApiType s3_api_type;
   S3OperationCode s3_operation_code;
 
+  // Memory of libevent pool the request needs, reserved by S3QosScheduler
+  size_t qos_memory = 0;
+  // Set once admitted by S3QosScheduler
+  std::unique_ptr<S3QosTicket> qos_ticket;
+
  public:
   S3RequestObject(
       evhtp_request_t* req, EvhtpInterface* evhtp_obj_ptr,
@@ -89,6 +95,14 @@ class S3RequestObject : public RequestObject {
   virtual void set_default_acl(const std::string& name);
   virtual const std::string& get_default_acl();
 
+  void set_qos_memory(size_t memory) { qos_memory = memory; }
+  size_t get_qos_memory() const { return qos_memory; }
+  void set_qos_ticket(std::unique_ptr<S3QosTicket> ticket) {
+    qos_ticket = std::move(ticket);
+  }
+  // Charges the request to QoS limits of its access key once authenticated.
+  void charge_qos_ticket();
+
  public:
 
   FRIEND_TEST(S3MockAuthClientCheckTest, CheckAuth);
@@ -23,8 +23,10 @@
 #include <string>
 
 #include "s3_api_handler.h"
+#include "s3_aws_v4_signer.h"
 #include "s3_log.h"
 #include "s3_option.h"
+#include "s3_qos_scheduler.h"
 #include "s3_router.h"
 #include "s3_stats.h"
 #include "s3_uri.h"
@@ -58,6 +60,103 @@ bool Router::is_subdomain_match(std::string& endpoint) {
   return false;
 }
 
+// Access key a request is signed with, empty for anonymous requests.
+static std::string get_access_key_of(S3RequestObject& request) {
+  const std::string authorization = request.get_header_value("Authorization");
+  if (!authorization.empty()) {
+    S3AwsV4Signer signer(authorization);
+    if (signer.is_ok()) {
+      return signer.get_access_key();
+    }
+    // AWS <access key>:<signature>
+    const size_t colon = authorization.find(':');
+    if (authorization.compare(0, 4, "AWS ") == 0 &&
+        colon != std::string::npos) {
+      return authorization.substr(4, colon - 4);
+    }
+    return "";
+  }
+  // Presigned URLs
+  const std::string credential =
+      request.get_query_string_value("X-Amz-Credential");
+  if (!credential.empty()) {
+    const size_t slash = std::min(credential.find('/'), credential.find("%2F"));
+    return credential.substr(0, slash);
+  }
+  return request.get_query_string_value("AWSAccessKeyId");
+}
+
+static void on_posted_callback(evutil_socket_t, short, void* arg) {
+  std::unique_ptr<std::function<void()>> callback(
+      static_cast<std::function<void()>*>(arg));
+  (*callback)();
+}
+
+// Runs callback on given event loop.
+static void post_to_event_loop(evbase_t* evbase,
+                               std::function<void()> callback) {
+  auto* arg = new std::function<void()>(std::move(callback));
+  struct timeval tv = {0, 0};
+  if (event_base_once(evbase, -1, EV_TIMEOUT, on_posted_callback, arg, &tv) !=
+      0) {
+    s3_log(S3_LOG_ERROR, "", "event_base_once() failed\n");
+    delete arg;
+  }
+}
+
+// Returns true if request may be dispatched now. Otherwise it waits in
+// S3QosScheduler, paused so that its body is not read meanwhile, and is
+// dispatched (or rejected) on this event loop once admitted.
+static bool admit_request(S3QosScheduler* scheduler,
+                          std::shared_ptr<S3RequestObject> s3request,
+                          std::shared_ptr<S3APIHandler> handler) {
+  evbase_t* evbase = S3Option::get_instance()->get_eventbase();
+  S3QosRequest qos_request;
+  qos_request.account = get_access_key_of(*s3request);
+  qos_request.bucket = s3request->get_bucket_name();
+  // Anybody can claim an access key, its limits are charged once the
+  // request is authenticated.
+  qos_request.charge_on_admission =
+      qos_request.account.empty() ||
+      S3Option::get_instance()->is_auth_disabled();
+  if (s3request->http_verb() == S3HttpVerb::PUT ||
+      s3request->http_verb() == S3HttpVerb::POST) {
+    qos_request.bytes = s3request->get_data_length();
+  }
+  qos_request.memory = s3request->get_qos_memory();
+  qos_request.admit = [evbase, s3request,
+                       handler](std::unique_ptr<S3QosTicket> ticket) {
+    // Ticket is released with the callback if it does not run.
+    auto holder =
+        std::make_shared<std::unique_ptr<S3QosTicket>>(std::move(ticket));
+    post_to_event_loop(evbase, [s3request, handler, holder]() {
+      std::unique_ptr<S3QosTicket> ticket = std::move(*holder);
+      if (!s3request->client_connected()) {
+        return;
+      }
+      s3request->set_qos_ticket(std::move(ticket));
+      s3request->resume();
+      handler->manage_self(handler);
+      handler->dispatch();
+    });
+  };
+  qos_request.reject = [evbase, s3request]() {
+    post_to_event_loop(evbase, [s3request]() {
+      if (s3request->client_connected()) {
+        s3request->respond_retry_after(1);
+      }
+    });
+  };
+
+  std::unique_ptr<S3QosTicket> ticket = scheduler->submit(qos_request);
+  if (ticket) {
+    s3request->set_qos_ticket(std::move(ticket));
+    return true;
+  }
+  s3request->pause();
+  return false;
+}
+
 S3Router::S3Router(S3APIHandlerFactory* api_creator, S3UriFactory* uri_creator)
     : api_handler_factory(api_creator), uri_factory(uri_creator) {
   s3_log(S3_LOG_DEBUG, "", "%s Ctor\n", __func__);
@@ -114,6 +213,10 @@ void S3Router::dispatch(std::shared_ptr<RequestObject> request) {
 
   if (handler) {
     s3_stats_inc("total_request_count");
+    S3QosScheduler* qos_scheduler = S3QosScheduler::get_instance();
+    if (qos_scheduler && !admit_request(qos_scheduler, s3request, handler)) {
+      return;
+    }
     handler->manage_self(handler);
     handler->dispatch();  // Start processing the request
   } else {
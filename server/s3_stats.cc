@@ -21,12 +21,79 @@
 #include "s3_stats.h"
 #include <string.h>
 #include <yaml-cpp/yaml.h>
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <sstream>
 
 S3Stats* g_stats_instance = NULL;
 S3Stats* S3Stats::stats_instance = NULL;
+std::atomic<uint64_t> S3Stats::last_instance_id(0);
+
+unsigned S3StatsHistogram::bucket_of(size_t value) {
+  if (value < kLinearBuckets) {
+    return value;
+  }
+  // Position of the most significant bit, at least 6 here
+  unsigned msb = 63 - __builtin_clzll(value);
+  if (msb >= 32) {
+    return kBuckets - 1;
+  }
+  unsigned sub = (value >> (msb - 4)) & (kSubBuckets - 1);
+  return kLinearBuckets + (msb - 6) * kSubBuckets + sub;
+}
+
+size_t S3StatsHistogram::bucket_upper_bound(unsigned idx) {
+  if (idx < kLinearBuckets) {
+    return idx;
+  }
+  unsigned msb = 6 + (idx - kLinearBuckets) / kSubBuckets;
+  size_t sub = (idx - kLinearBuckets) % kSubBuckets;
+  size_t width = (size_t)1 << (msb - 4);
+  return (kSubBuckets + sub) * width + width - 1;
+}
+
+void S3StatsHistogram::record(size_t value) {
+  ++buckets[bucket_of(value)];
+  ++total;
+  if (value > max_value) {
+    max_value = value;
+  }
+}
+
+void S3StatsHistogram::merge(const S3StatsHistogram& other) {
+  for (unsigned i = 0; i < kBuckets; ++i) {
+    buckets[i] += other.buckets[i];
+  }
+  total += other.total;
+  if (other.max_value > max_value) {
+    max_value = other.max_value;
+  }
+}
+
+void S3StatsHistogram::reset() {
+  memset(buckets, 0, sizeof(buckets));
+  total = 0;
+  max_value = 0;
+}
+
+size_t S3StatsHistogram::percentile(unsigned pct) const {
+  if (total == 0) {
+    return 0;
+  }
+  uint64_t rank = (total * pct + 99) / 100;
+  if (rank == 0) {
+    rank = 1;
+  }
+  uint64_t seen = 0;
+  for (unsigned i = 0; i < kBuckets; ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      return std::min(bucket_upper_bound(i), max_value);
+    }
+  }
+  return max_value;
+}
 
 S3Stats* S3Stats::get_instance(SocketInterface* socket_obj) {
   if (!stats_instance) {
@@ -49,13 +116,44 @@ void S3Stats::delete_instance() {
   }
 }
 
+S3StatsThreadMetrics* S3Stats::get_thread_metrics() {
+  // Tagged with the owning instance, as S3Stats may be re-created in UTs
+  static thread_local uint64_t tls_instance_id = 0;
+  static thread_local S3StatsThreadMetrics* tls_metrics = NULL;
+
+  if (tls_instance_id != instance_id) {
+    std::unique_ptr<S3StatsThreadMetrics> metrics(new S3StatsThreadMetrics());
+    tls_metrics = metrics.get();
+    tls_instance_id = instance_id;
+    std::lock_guard<std::mutex> guard(thread_metrics_lock);
+    thread_metrics.push_back(std::move(metrics));
+  }
+  return tls_metrics;
+}
+
 int S3Stats::count(const std::string& key, int64_t value, int retry,
                    float sample_rate) {
+  if (aggregate && is_fequal(sample_rate, 1.0)) {
+    if (is_allowed_to_publish(key)) {
+      S3StatsThreadMetrics* metrics = get_thread_metrics();
+      std::lock_guard<std::mutex> guard(metrics->lock);
+      metrics->counters[key] += value;
+    }
+    return 0;
+  }
   return form_and_send_msg(key, "c", std::to_string(value), retry, sample_rate);
 }
 
 int S3Stats::timing(const std::string& key, size_t time_ms, int retry,
                     float sample_rate) {
+  if (aggregate && is_fequal(sample_rate, 1.0)) {
+    if (is_allowed_to_publish(key)) {
+      S3StatsThreadMetrics* metrics = get_thread_metrics();
+      std::lock_guard<std::mutex> guard(metrics->lock);
+      metrics->timings[key].record(time_ms);
+    }
+    return 0;
+  }
   return form_and_send_msg(key, "ms", std::to_string(time_ms), retry,
                            sample_rate);
 }
@@ -168,8 +266,73 @@ int S3Stats::init() {
   return 0;
 }
 
+int S3Stats::add_to_packet(std::string& packet, const std::string& line) {
+  int rc = 0;
+  if (!packet.empty() &&
+      packet.length() + 1 + line.length() >
+          g_option_instance->get_statsd_max_packet_size()) {
+    rc = send(packet, g_option_instance->get_statsd_max_send_retry());
+    packet.clear();
+  }
+  if (!packet.empty()) {
+    packet += '\n';
+  }
+  packet += line;
+  return rc;
+}
+
+int S3Stats::flush() {
+  std::unordered_map<std::string, int64_t> counters;
+  std::unordered_map<std::string, S3StatsHistogram> timings;
+  {
+    std::lock_guard<std::mutex> guard(thread_metrics_lock);
+    for (auto& metrics : thread_metrics) {
+      std::lock_guard<std::mutex> metrics_guard(metrics->lock);
+      // Keys are kept so that recording does not allocate again
+      for (auto& counter : metrics->counters) {
+        if (counter.second != 0) {
+          counters[counter.first] += counter.second;
+          counter.second = 0;
+        }
+      }
+      for (auto& timing : metrics->timings) {
+        if (timing.second.count() != 0) {
+          timings[timing.first].merge(timing.second);
+          timing.second.reset();
+        }
+      }
+    }
+  }
+  int rc = 0;
+  std::string packet;
+  for (const auto& counter : counters) {
+    rc |= add_to_packet(packet, counter.first + ":" +
+                                    std::to_string(counter.second) + "|c");
+  }
+  for (const auto& timing : timings) {
+    const std::string& key = timing.first;
+    const S3StatsHistogram& histogram = timing.second;
+    rc |= add_to_packet(
+        packet, key + ".count:" + std::to_string(histogram.count()) + "|c");
+    for (unsigned pct : {50, 90, 99}) {
+      const std::string value = std::to_string(histogram.percentile(pct));
+      rc |= add_to_packet(
+          packet, key + ".p" + std::to_string(pct) + ":" + value + "|g");
+    }
+    rc |= add_to_packet(
+        packet, key + ".max:" + std::to_string(histogram.max()) + "|g");
+  }
+  if (!packet.empty()) {
+    rc |= send(packet, g_option_instance->get_statsd_max_send_retry());
+  }
+  return rc ? -1 : 0;
+}
+
 void S3Stats::finish() {
   s3_log(S3_LOG_DEBUG, "", "%s Entry\n", __func__);
+  if (aggregate && sock != -1) {
+    flush();
+  }
   if (sock != -1) {
     socket_obj->close(sock);
     sock = -1;
@@ -26,13 +26,54 @@
 #include <gtest/gtest_prod.h>
 #include <math.h>
 #include <limits>
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include "s3_log.h"
 #include "s3_option.h"
 #include "socket_wrapper.h"
 
+// Distribution of timings (in ms) with about 6% precision: values below
+// 64 have a bucket each, larger ones share 16 buckets per power of two.
+class S3StatsHistogram {
+  static const unsigned kLinearBuckets = 64;
+  static const unsigned kSubBuckets = 16;
+  // Values from 2^32 ms on go to the last bucket
+  static const unsigned kBuckets = kLinearBuckets + (32 - 6) * kSubBuckets;
+
+  uint32_t buckets[kBuckets];
+  uint64_t total;
+  size_t max_value;
+
+  static unsigned bucket_of(size_t value);
+  static size_t bucket_upper_bound(unsigned idx);
+
+ public:
+  S3StatsHistogram() { reset(); }
+
+  void record(size_t value);
+  void merge(const S3StatsHistogram& other);
+  void reset();
+
+  uint64_t count() const { return total; }
+  size_t max() const { return max_value; }
+  // Returns the upper bound of the bucket holding the `pct` percentile.
+  size_t percentile(unsigned pct) const;
+};
+
+// Metrics aggregated by one thread since the last flush.
+struct S3StatsThreadMetrics {
+  // Only contended while the metrics are flushed
+  std::mutex lock;
+  std::unordered_map<std::string, int64_t> counters;
+  std::unordered_map<std::string, S3StatsHistogram> timings;
+};
+
 class S3Stats {
  public:
   static S3Stats* get_instance(SocketInterface* socket_obj = NULL);
@@ -56,10 +97,19 @@ class S3Stats {
   int count_unique(const std::string& key, const std::string& value,
                    int retry = 1);
 
+  // Sends counters and timing percentiles aggregated since the last call,
+  // packing as many metrics per UDP packet as allowed.
+  int flush();
+
  private:
   S3Stats(const std::string& host_addr, const unsigned short port_num,
           SocketInterface* socket_obj_ptr = NULL)
-      : host(host_addr), port(port_num), sock(-1) {
+      : host(host_addr),
+        port(port_num),
+        sock(-1),
+        aggregate(S3Option::get_instance()->get_statsd_flush_interval_msec() >
+                  0),
+        instance_id(++last_instance_id) {
     s3_log(S3_LOG_DEBUG, "", "%s Ctor\n", __func__);
     metrics_allowlist.clear();
     if (socket_obj_ptr) {
@@ -87,6 +137,13 @@ class S3Stats {
   int form_and_send_msg(const std::string& key, const std::string& type,
                         const std::string& value, int retry, float sample_rate);
 
+  // Returns the aggregation buffer of the calling thread
+  S3StatsThreadMetrics* get_thread_metrics();
+
+  // Adds a metric line to `packet`, sends `packet` first if it would grow
+  // beyond the max packet size.
+  int add_to_packet(std::string& packet, const std::string& line);
+
   // Returns true if two float numbers are (alomst) equal
   bool is_fequal(float x, float y) {
     return (fabsf(x - y) < std::numeric_limits<float>::epsilon());
@@ -111,10 +168,21 @@ class S3Stats {
   // metrics allowlist
   std::unordered_set<std::string> metrics_allowlist;
 
+  // Counters and timings are aggregated in memory and sent by flush()
+  // rather than one UDP message per call.
+  bool aggregate;
+  const uint64_t instance_id;
+  static std::atomic<uint64_t> last_instance_id;
+  std::mutex thread_metrics_lock;
+  std::vector<std::unique_ptr<S3StatsThreadMetrics>> thread_metrics;
+
   FRIEND_TEST(S3StatsTest, Init);
   FRIEND_TEST(S3StatsTest, Allowlist);
   FRIEND_TEST(S3StatsTest, S3StatsSendMustSucceedIfSocketSendToSucceeds);
   FRIEND_TEST(S3StatsTest, S3StatsSendMustRetryAndFailIfRetriesFail);
+  FRIEND_TEST(S3StatsTest, AggregatedCountersAreSentOnFlush);
+  FRIEND_TEST(S3StatsTest, AggregatedTimingsAreSentAsPercentiles);
+  FRIEND_TEST(S3StatsTest, FlushSplitsPacketsAtMaxPacketSize);
 };
 
 extern S3Option* g_option_instance;
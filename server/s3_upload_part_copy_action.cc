@@ -0,0 +1,706 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <cassert>
+#include <algorithm>
+#include <utility>
+
+#include "s3_common.h"
+#include "s3_common_utilities.h"
+#include "s3_copy_object_action.h"
+#include "s3_error_codes.h"
+#include "s3_log.h"
+#include "s3_motr_layout.h"
+#include "s3_motr_writer.h"
+#include "s3_option.h"
+#include "s3_upload_part_copy_action.h"
+
+S3UploadPartCopyAction::S3UploadPartCopyAction(
+    std::shared_ptr<S3RequestObject> req, std::shared_ptr<MotrAPI> motr_api,
+    std::shared_ptr<S3BucketMetadataFactory> bucket_meta_factory,
+    std::shared_ptr<S3ObjectMetadataFactory> object_meta_factory,
+    std::shared_ptr<S3ObjectMultipartMetadataFactory> object_mp_meta_factory,
+    std::shared_ptr<S3PartMetadataFactory> part_meta_factory,
+    std::shared_ptr<S3MotrWriterFactory> motrwriter_s3_factory,
+    std::shared_ptr<S3MotrReaderFactory> motrreader_s3_factory,
+    std::shared_ptr<S3AuthClientFactory> auth_factory)
+    : S3ObjectAction(std::move(req), std::move(bucket_meta_factory),
+                     std::move(object_meta_factory), true,
+                     std::move(auth_factory)),
+      s3_motr_api(std::move(motr_api)) {
+  s3_log(S3_LOG_DEBUG, request_id, "%s Ctor\n", __func__);
+  part_number = get_part_number();
+  upload_id = request->get_query_string_value("uploadId");
+
+  s3_log(S3_LOG_INFO, stripped_request_id,
+         "S3 API: UploadPartCopy. Bucket[%s] Object[%s] Part[%d] for "
+         "UploadId[%s], Source: [%s]\n",
+         request->get_bucket_name().c_str(), request->get_object_name().c_str(),
+         part_number, upload_id.c_str(),
+         request->get_headers_copysource().c_str());
+
+  layout_id = -1;  // Loaded from multipart metadata
+
+  if (object_mp_meta_factory) {
+    object_mp_metadata_factory = std::move(object_mp_meta_factory);
+  } else {
+    object_mp_metadata_factory =
+        std::make_shared<S3ObjectMultipartMetadataFactory>();
+  }
+  if (part_meta_factory) {
+    part_metadata_factory = std::move(part_meta_factory);
+  } else {
+    part_metadata_factory = std::make_shared<S3PartMetadataFactory>();
+  }
+  if (motrwriter_s3_factory) {
+    motr_writer_factory = std::move(motrwriter_s3_factory);
+  } else {
+    motr_writer_factory = std::make_shared<S3MotrWriterFactory>();
+  }
+  if (motrreader_s3_factory) {
+    motr_reader_factory = std::move(motrreader_s3_factory);
+  } else {
+    motr_reader_factory = std::make_shared<S3MotrReaderFactory>();
+  }
+  setup_steps();
+}
+
+void S3UploadPartCopyAction::setup_steps() {
+  s3_log(S3_LOG_DEBUG, request_id, "Setting up the action\n");
+
+  ACTION_TASK_ADD(S3UploadPartCopyAction::validate_upload_part_copy_request,
+                  this);
+  if (!S3Option::get_instance()->is_auth_disabled()) {
+    ACTION_TASK_ADD(
+        S3UploadPartCopyAction::set_source_bucket_authorization_metadata,
+        this);
+    ACTION_TASK_ADD(S3UploadPartCopyAction::check_source_bucket_authorization,
+                    this);
+  }
+  ACTION_TASK_ADD(S3UploadPartCopyAction::fetch_multipart_metadata, this);
+  // Part size is validated before part one size is saved.
+  ACTION_TASK_ADD(S3UploadPartCopyAction::compute_part_offset, this);
+  ACTION_TASK_ADD(S3UploadPartCopyAction::save_multipart_metadata, this);
+  ACTION_TASK_ADD(S3UploadPartCopyAction::copy_part, this);
+  ACTION_TASK_ADD(S3UploadPartCopyAction::save_metadata, this);
+  ACTION_TASK_ADD(S3UploadPartCopyAction::send_response_to_s3_client, this);
+}
+
+void S3UploadPartCopyAction::fetch_bucket_info_success() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  if (bucket_metadata->get_state() == S3BucketMetadataState::present) {
+    next();
+  } else {
+    set_s3_error("NoSuchBucket");
+    send_response_to_s3_client();
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3UploadPartCopyAction::fetch_bucket_info_failed() {
+  s3_log(S3_LOG_ERROR, request_id, "Bucket does not exists\n");
+  if (bucket_metadata->get_state() == S3BucketMetadataState::missing) {
+    set_s3_error("NoSuchBucket");
+  } else if (bucket_metadata->get_state() ==
+             S3BucketMetadataState::failed_to_launch) {
+    s3_log(S3_LOG_ERROR, request_id,
+           "Bucket metadata load operation failed due to pre launch failure\n");
+    set_s3_error("ServiceUnavailable");
+  } else {
+    set_s3_error("InternalError");
+  }
+  send_response_to_s3_client();
+}
+
+void S3UploadPartCopyAction::fetch_object_info_failed() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  next();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3UploadPartCopyAction::set_authorization_meta() {
+  s3_log(S3_LOG_DEBUG, request_id, "%s Entry\n", __func__);
+  auth_client->set_acl_and_policy(bucket_metadata->get_encoded_bucket_acl(),
+                                  bucket_metadata->get_policy_as_json());
+  request->set_action_str("PutObject");
+  next();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+// Accepts "bytes=first-last" only, both offsets are required.
+bool S3UploadPartCopyAction::parse_copy_source_range(
+    const std::string& range_value) {
+  const std::string bytes_unit = "bytes=";
+  if (range_value.compare(0, bytes_unit.length(), bytes_unit) != 0) {
+    return false;
+  }
+  std::string byte_range = range_value.substr(bytes_unit.length());
+  size_t pos = byte_range.find('-');
+  if (pos == std::string::npos) {
+    return false;
+  }
+  std::string first = byte_range.substr(0, pos);
+  std::string last = byte_range.substr(pos + 1);
+  unsigned long first_value = 0;
+  unsigned long last_value = 0;
+  if (first.empty() || last.empty() ||
+      !S3CommonUtilities::string_has_only_digits(first) ||
+      !S3CommonUtilities::string_has_only_digits(last) ||
+      !S3CommonUtilities::stoul(first, first_value) ||
+      !S3CommonUtilities::stoul(last, last_value) ||
+      first_value > last_value) {
+    return false;
+  }
+  first_byte = first_value;
+  last_byte = last_value;
+  return true;
+}
+
+void S3UploadPartCopyAction::validate_upload_part_copy_request() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+
+  if (part_number < MINIMUM_PART_NUMBER || part_number > MAXIMUM_PART_NUMBER) {
+    set_s3_error("InvalidPart");
+    send_response_to_s3_client();
+    return;
+  }
+  if ((request->get_object_name()).length() > MAX_OBJECT_KEY_LENGTH) {
+    set_s3_error("KeyTooLongError");
+    send_response_to_s3_client();
+    return;
+  }
+  S3CopyObjectAction::parse_copy_source(request->get_headers_copysource(),
+                                        source_bucket_name, source_object_name);
+  if (source_bucket_name.empty() || source_object_name.empty()) {
+    set_s3_error("InvalidArgument");
+    send_response_to_s3_client();
+    return;
+  }
+  std::string range_value =
+      request->get_header_value("x-amz-copy-source-range");
+  if (!range_value.empty()) {
+    s3_log(S3_LOG_DEBUG, stripped_request_id,
+           "Received x-amz-copy-source-range header, value: %s",
+           range_value.c_str());
+    if (!parse_copy_source_range(range_value)) {
+      s3_log(S3_LOG_INFO, stripped_request_id, "Invalid copy range(%s)\n",
+             range_value.c_str());
+      set_s3_error("InvalidArgument");
+      send_response_to_s3_client();
+      return;
+    }
+    has_copy_range = true;
+  }
+  fetch_source_bucket_info();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3UploadPartCopyAction::fetch_source_bucket_info() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  s3_log(S3_LOG_DEBUG, request_id, "Fetch metadata of bucket: %s\n",
+         source_bucket_name.c_str());
+
+  source_bucket_metadata = bucket_metadata_factory->create_bucket_metadata_obj(
+      request, source_bucket_name);
+
+  source_bucket_metadata->load(
+      std::bind(&S3UploadPartCopyAction::fetch_source_object_info, this),
+      std::bind(&S3UploadPartCopyAction::fetch_source_bucket_info_failed,
+                this));
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3UploadPartCopyAction::fetch_source_bucket_info_failed() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+
+  if (source_bucket_metadata->get_state() == S3BucketMetadataState::missing) {
+    s3_log(S3_LOG_DEBUG, request_id, "Source bucket: [%s] not found\n",
+           source_bucket_name.c_str());
+    set_s3_error("NoSuchBucket");
+  } else if (source_bucket_metadata->get_state() ==
+             S3BucketMetadataState::failed_to_launch) {
+    s3_log(S3_LOG_ERROR, request_id,
+           "Source bucket metadata load operation failed due to pre launch "
+           "failure\n");
+    set_s3_error("ServiceUnavailable");
+  } else {
+    s3_log(S3_LOG_DEBUG, request_id, "Source bucket metadata fetch failed\n");
+    set_s3_error("InternalError");
+  }
+  send_response_to_s3_client();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3UploadPartCopyAction::fetch_source_object_info() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  m0_uint128 source_object_list_oid =
+      source_bucket_metadata->get_object_list_index_oid();
+  m0_uint128 source_object_version_list_oid =
+      source_bucket_metadata->get_objects_version_list_index_oid();
+
+  if ((source_object_list_oid.u_hi == 0ULL &&
+       source_object_list_oid.u_lo == 0ULL) ||
+      (source_object_version_list_oid.u_hi == 0ULL &&
+       source_object_version_list_oid.u_lo == 0ULL)) {
+    // Object list index and version list index missing.
+    set_s3_error("NoSuchKey");
+    send_response_to_s3_client();
+  } else {
+    source_object_metadata =
+        object_metadata_factory->create_object_metadata_obj(
+            request, source_bucket_name, source_object_name,
+            source_object_list_oid);
+
+    source_object_metadata->set_objects_version_list_index_oid(
+        source_object_version_list_oid);
+
+    source_object_metadata->load(
+        std::bind(&S3UploadPartCopyAction::fetch_source_object_info_success,
+                  this),
+        std::bind(&S3UploadPartCopyAction::fetch_source_object_info_failed,
+                  this));
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3UploadPartCopyAction::fetch_source_object_info_success() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  const size_t content_length = source_object_metadata->get_content_length();
+
+  if (has_copy_range) {
+    if (last_byte >= content_length) {
+      s3_log(S3_LOG_INFO, stripped_request_id,
+             "Copy range %zu-%zu is out of source of %zu bytes\n", first_byte,
+             last_byte, content_length);
+      set_s3_error("InvalidRange");
+      send_response_to_s3_client();
+      return;
+    }
+    total_data_to_copy = last_byte - first_byte + 1;
+  } else {
+    first_byte = 0;
+    total_data_to_copy = content_length;
+  }
+  if (total_data_to_copy > MaxCopyObjectSourceSize) {
+    set_s3_error("InvalidRequest");
+    send_response_to_s3_client();
+    return;
+  }
+  clip_source_extents();
+  next();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3UploadPartCopyAction::fetch_source_object_info_failed() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+
+  if (S3ObjectMetadataState::missing == source_object_metadata->get_state()) {
+    set_s3_error("NoSuchKey");
+  } else if (S3ObjectMetadataState::failed_to_launch ==
+             source_object_metadata->get_state()) {
+    s3_log(S3_LOG_ERROR, request_id,
+           "Source object metadata load operation failed due to pre launch "
+           "failure\n");
+    set_s3_error("ServiceUnavailable");
+  } else {
+    s3_log(S3_LOG_DEBUG, request_id, "Source object metadata fetch failed\n");
+    set_s3_error("InternalError");
+  }
+  send_response_to_s3_client();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+// Maps [first_byte, first_byte + total_data_to_copy) of source's data onto
+// extents of source's motr object.
+void S3UploadPartCopyAction::clip_source_extents() {
+  std::vector<S3ObjectExtent> extents = source_object_metadata->get_extents();
+  if (extents.empty()) {
+    extents.push_back({0, source_object_metadata->get_content_length()});
+  }
+  const size_t range_end = first_byte + total_data_to_copy;
+  size_t extent_start = 0;
+
+  copy_extents.clear();
+  for (const auto& extent : extents) {
+    const size_t extent_end = extent_start + extent.length;
+    const size_t start = std::max(extent_start, first_byte);
+    const size_t end = std::min(extent_end, range_end);
+    if (start < end) {
+      copy_extents.push_back({extent.offset + (start - extent_start),
+                              end - start});
+    }
+    extent_start = extent_end;
+  }
+}
+
+void S3UploadPartCopyAction::set_source_bucket_authorization_metadata() {
+  s3_log(S3_LOG_INFO, request_id, "Entering\n");
+  auth_client->set_get_method = true;
+
+  auth_client->set_entity_path("/" + source_bucket_name + "/" +
+                               source_object_name);
+
+  auth_client->set_acl_and_policy(
+      source_object_metadata->get_encoded_object_acl(),
+      source_bucket_metadata->get_policy_as_json());
+  request->set_action_str("GetObject");
+  next();
+  s3_log(S3_LOG_DEBUG, "", "Exiting\n");
+}
+
+void S3UploadPartCopyAction::check_source_bucket_authorization() {
+  s3_log(S3_LOG_INFO, request_id, "Entering\n");
+  auth_client->check_authorization(
+      std::bind(&S3UploadPartCopyAction::next, this),
+      std::bind(
+          &S3UploadPartCopyAction::check_source_bucket_authorization_failed,
+          this));
+}
+
+void S3UploadPartCopyAction::check_source_bucket_authorization_failed() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+
+  std::string error_code = auth_client->get_error_code();
+  set_s3_error(error_code);
+  s3_log(S3_LOG_ERROR, request_id, "Authorization failure: %s\n",
+         error_code.c_str());
+
+  if (request->client_connected()) {
+    send_response_to_s3_client();
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3UploadPartCopyAction::fetch_multipart_metadata() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  object_multipart_metadata =
+      object_mp_metadata_factory->create_object_mp_metadata_obj(
+          request, bucket_metadata->get_multipart_index_oid(), upload_id);
+
+  object_multipart_metadata->load(
+      std::bind(&S3UploadPartCopyAction::next, this),
+      std::bind(&S3UploadPartCopyAction::fetch_multipart_failed, this));
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3UploadPartCopyAction::fetch_multipart_failed() {
+  s3_log(S3_LOG_ERROR, request_id,
+         "Failed to retrieve multipart upload metadata\n");
+  if (object_multipart_metadata->get_state() ==
+      S3ObjectMetadataState::missing) {
+    set_s3_error("NoSuchUpload");
+  } else {
+    set_s3_error("InternalError");
+  }
+  send_response_to_s3_client();
+}
+
+void S3UploadPartCopyAction::save_multipart_metadata() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  // Same as for uploaded part one, other parts need the size of part one to
+  // find their offsets unless the upload has part slots.
+  if (part_number != 1 ||
+      object_multipart_metadata->get_part_slot_size() != 0) {
+    next();
+    s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+    return;
+  }
+  size_t part_one_size_in_multipart_metadata =
+      object_multipart_metadata->get_part_one_size();
+
+  if (part_one_size_in_multipart_metadata != 0 &&
+      part_one_size_in_multipart_metadata != total_data_to_copy) {
+    s3_log(S3_LOG_ERROR, request_id,
+           "Part one size in multipart metadata "
+           "(%zu) differs from current part one "
+           "size (%zu)",
+           part_one_size_in_multipart_metadata, total_data_to_copy);
+    set_s3_error("InvalidObjectState");
+    send_response_to_s3_client();
+    s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+    return;
+  }
+  object_multipart_metadata->reset_date_time_to_current();
+  object_multipart_metadata->set_part_one_size(total_data_to_copy);
+  object_multipart_metadata->save(
+      std::bind(&S3UploadPartCopyAction::next, this),
+      std::bind(&S3UploadPartCopyAction::save_multipart_metadata_failed, this));
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3UploadPartCopyAction::save_multipart_metadata_failed() {
+  s3_log(S3_LOG_ERROR, request_id,
+         "Failed to update multipart metadata with part one size\n");
+  if (object_multipart_metadata->get_state() ==
+      S3ObjectMetadataState::failed_to_launch) {
+    set_s3_error("ServiceUnavailable");
+  } else {
+    set_s3_error("InternalError");
+  }
+  send_response_to_s3_client();
+}
+
+void S3UploadPartCopyAction::compute_part_offset() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  layout_id = object_multipart_metadata->get_layout_id();
+  const size_t unit_size =
+      S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(layout_id);
+  const size_t part_slot_size = object_multipart_metadata->get_part_slot_size();
+
+  if (part_slot_size != 0) {
+    if (total_data_to_copy > part_slot_size) {
+      s3_log(S3_LOG_ERROR, request_id,
+             "Part %d size (%zu) exceeds part slot size (%zu)\n", part_number,
+             total_data_to_copy, part_slot_size);
+      set_s3_error("EntityTooLarge");
+      send_response_to_s3_client();
+      s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+      return;
+    }
+    part_offset = (part_number - 1) * part_slot_size;
+  } else if (part_number == 1) {
+    // See compute_part_offset() of S3PutMultiObjectAction.
+    part_offset = 0;
+    if (total_data_to_copy % unit_size) {
+      s3_log(S3_LOG_DEBUG, request_id,
+             "Rejecting request as part size is not aligned w.r.t unit_size\n");
+      set_s3_error("InvalidPartSize");
+      send_response_to_s3_client();
+      s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+      return;
+    }
+  } else {
+    const size_t part_one_size = object_multipart_metadata->get_part_one_size();
+    if (part_one_size == 0) {
+      s3_log(S3_LOG_WARN, request_id,
+             "Part 1 size is not there in multipart metadata, hence "
+             "rejecting this request of part %d for time being\n",
+             part_number);
+      set_s3_error("ServiceUnavailable");
+      send_response_to_s3_client();
+      s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+      return;
+    }
+    part_offset = (part_number - 1) * part_one_size;
+  }
+  s3_log(S3_LOG_DEBUG, request_id, "Offset for motr write = %zu\n",
+         part_offset);
+
+  motr_writer = motr_writer_factory->create_motr_writer(
+      request, object_multipart_metadata->get_oid(), part_offset);
+  motr_writer->set_layout_id(layout_id);
+
+  next();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+bool S3UploadPartCopyAction::copy_part_cb() {
+  return check_shutdown_and_rollback() || !request->client_connected();
+}
+
+void S3UploadPartCopyAction::copy_part() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+
+  if (!total_data_to_copy) {
+    s3_log(S3_LOG_DEBUG, stripped_request_id, "Nothing to copy");
+    next();
+    return;
+  }
+  if (source_object_metadata->is_inline()) {
+    copy_inline_part();
+    return;
+  }
+  bool f_success = false;
+  try {
+    object_data_copier.reset(
+        new S3ObjectDataCopier(request, motr_writer, motr_writer_factory,
+                               motr_reader_factory, s3_motr_api));
+    object_data_copier->set_destination_offset(part_offset);
+
+    object_data_copier->copy(
+        source_object_metadata->get_oid(), total_data_to_copy,
+        source_object_metadata->get_layout_id(), copy_extents,
+        std::bind(&S3UploadPartCopyAction::copy_part_cb, this),
+        std::bind(&S3UploadPartCopyAction::copy_part_success, this),
+        std::bind(&S3UploadPartCopyAction::copy_part_failed, this));
+    f_success = true;
+  }
+  catch (const std::exception& ex) {
+    s3_log(S3_LOG_ERROR, stripped_request_id, "%s", ex.what());
+  }
+  catch (...) {
+    s3_log(S3_LOG_ERROR, stripped_request_id, "Non-standard C++ exception");
+  }
+  if (!f_success) {
+    object_data_copier.reset();
+
+    set_s3_error("InternalError");
+    send_response_to_s3_client();
+  }
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3UploadPartCopyAction::copy_part_success() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+
+  content_md5 = object_data_copier->get_content_md5();
+  object_data_copier.reset();
+  next();
+
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3UploadPartCopyAction::copy_part_failed() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+
+  set_s3_error(object_data_copier->get_s3_error());
+  object_data_copier.reset();
+  send_response_to_s3_client();
+
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+// Source keeps its data in metadata, the range is written to the part
+// straight from memory. md5 of the written data is kept by motr_writer.
+void S3UploadPartCopyAction::copy_inline_part() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  const size_t buf_size = 4096;
+
+  inline_source_data = source_object_metadata->get_inline_data();
+  if (inline_source_data.length() < first_byte + total_data_to_copy) {
+    s3_log(S3_LOG_ERROR, request_id,
+           "Inline data of source is shorter than its content length\n");
+    set_s3_error("InternalError");
+    send_response_to_s3_client();
+    s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+    return;
+  }
+  inline_source_data = inline_source_data.substr(first_byte,
+                                                 total_data_to_copy);
+  // Writer hands whole buffers to motr, pad the last one with zeros.
+  inline_source_data.resize(
+      (total_data_to_copy + buf_size - 1) / buf_size * buf_size, '\0');
+
+  S3BufferSequence buffers;
+  for (size_t offset = 0; offset < total_data_to_copy; offset += buf_size) {
+    buffers.emplace_back(&inline_source_data[offset],
+                         std::min(buf_size, total_data_to_copy - offset));
+  }
+  motr_writer->write_content(
+      std::bind(&S3UploadPartCopyAction::next, this),
+      std::bind(&S3UploadPartCopyAction::copy_inline_part_failed, this),
+      std::move(buffers), buf_size);
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3UploadPartCopyAction::copy_inline_part_failed() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+
+  if (motr_writer->get_state() == S3MotrWiterOpState::failed_to_launch) {
+    set_s3_error("ServiceUnavailable");
+  } else {
+    set_s3_error("InternalError");
+  }
+  send_response_to_s3_client();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3UploadPartCopyAction::save_metadata() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  part_metadata = part_metadata_factory->create_part_metadata_obj(
+      request, object_multipart_metadata->get_part_index_oid(), upload_id,
+      part_number);
+
+  part_metadata->reset_date_time_to_current();
+  part_metadata->set_content_length(std::to_string(total_data_to_copy));
+  // Nothing is copied from empty range, motr_writer has md5 of no data then.
+  part_metadata->set_md5(content_md5.empty() ? motr_writer->get_content_md5()
+                                             : content_md5);
+  // bypass shutdown signal check for next task
+  check_shutdown_signal_for_next_task(false);
+
+  part_metadata->save(
+      std::bind(&S3UploadPartCopyAction::next, this),
+      std::bind(&S3UploadPartCopyAction::save_metadata_failed, this));
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+void S3UploadPartCopyAction::save_metadata_failed() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+  if (part_metadata->get_state() == S3PartMetadataState::failed_to_launch) {
+    s3_log(S3_LOG_ERROR, request_id,
+           "Save of Part metadata failed due to pre launch failure\n");
+    set_s3_error("ServiceUnavailable");
+  } else {
+    s3_log(S3_LOG_ERROR, request_id, "Save of Part metadata failed\n");
+    set_s3_error("InternalError");
+  }
+  send_response_to_s3_client();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
+
+std::string S3UploadPartCopyAction::get_response_xml() {
+  std::string response_xml =
+      "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+      "<CopyPartResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">\n";
+  response_xml += S3CommonUtilities::format_xml_string(
+      "LastModified", part_metadata->get_last_modified_iso());
+  // AWS adds explicit quotes "" to etag values.
+  response_xml += S3CommonUtilities::format_xml_string(
+      "ETag", part_metadata->get_md5(), true);
+  response_xml += "\n</CopyPartResult>";
+  return response_xml;
+}
+
+void S3UploadPartCopyAction::send_response_to_s3_client() {
+  s3_log(S3_LOG_INFO, stripped_request_id, "%s Entry\n", __func__);
+
+  if (reject_if_shutting_down() ||
+      (is_error_state() && !get_s3_error_code().empty())) {
+    S3Error error(get_s3_error_code(), request->get_request_id(),
+                  request->get_object_uri());
+    std::string& response_xml = error.to_xml();
+
+    request->set_out_header_value("Content-Type", "application/xml");
+    request->set_out_header_value("Content-Length",
+                                  std::to_string(response_xml.length()));
+
+    if (get_s3_error_code() == "ServiceUnavailable" ||
+        get_s3_error_code() == "InternalError") {
+      request->set_out_header_value("Connection", "close");
+    }
+    if (get_s3_error_code() == "ServiceUnavailable") {
+      request->set_out_header_value("Retry-After", "1");
+    }
+    request->send_response(error.get_http_status_code(), response_xml);
+  } else {
+    std::string response_xml = get_response_xml();
+
+    request->set_out_header_value("Content-Type", "application/xml");
+    request->set_out_header_value("Content-Length",
+                                  std::to_string(response_xml.length()));
+    request->send_response(S3HttpSuccess200, response_xml);
+  }
+  S3_RESET_SHUTDOWN_SIGNAL;  // for shutdown testcases
+  request->resume(false);
+
+  done();
+  s3_log(S3_LOG_DEBUG, "", "%s Exit", __func__);
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#pragma once
+
+#ifndef __S3_SERVER_S3_UPLOAD_PART_COPY_ACTION_H__
+#define __S3_SERVER_S3_UPLOAD_PART_COPY_ACTION_H__
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest_prod.h>
+
+#include "s3_object_action_base.h"
+#include "s3_object_data_copier.h"
+#include "s3_object_metadata.h"
+#include "s3_part_metadata.h"
+
+class S3MotrWiter;
+
+// UploadPartCopy: data of a part is copied from (a byte range of) an
+// existing object by S3ObjectDataCopier, never leaving the server.
+class S3UploadPartCopyAction : public S3ObjectAction {
+  std::string source_bucket_name;
+  std::string source_object_name;
+
+  int part_number;
+  std::string upload_id;
+  int layout_id;
+
+  // Range of source given by x-amz-copy-source-range, whole source if none.
+  bool has_copy_range = false;
+  size_t first_byte = 0;
+  size_t last_byte = 0;
+  size_t total_data_to_copy = 0;
+  // Offset of the part in multipart object.
+  size_t part_offset = 0;
+  // Extents of source's data to copy.
+  std::vector<S3ObjectExtent> copy_extents;
+  // md5 of the data copied by object_data_copier.
+  std::string content_md5;
+  // Range of inline source being written, padded to whole buffers.
+  std::string inline_source_data;
+
+  std::shared_ptr<MotrAPI> s3_motr_api;
+  std::shared_ptr<S3BucketMetadata> source_bucket_metadata;
+  std::shared_ptr<S3ObjectMetadata> source_object_metadata;
+  std::shared_ptr<S3ObjectMetadata> object_multipart_metadata;
+  std::shared_ptr<S3PartMetadata> part_metadata;
+  std::shared_ptr<S3MotrWiter> motr_writer;
+  std::unique_ptr<S3ObjectDataCopier> object_data_copier;
+
+  std::shared_ptr<S3ObjectMultipartMetadataFactory> object_mp_metadata_factory;
+  std::shared_ptr<S3PartMetadataFactory> part_metadata_factory;
+  std::shared_ptr<S3MotrWriterFactory> motr_writer_factory;
+  std::shared_ptr<S3MotrReaderFactory> motr_reader_factory;
+
+  int get_part_number() {
+    return atoi((request->get_query_string_value("partNumber")).c_str());
+  }
+  bool parse_copy_source_range(const std::string& range_value);
+  void clip_source_extents();
+
+  void validate_upload_part_copy_request();
+  void fetch_source_bucket_info();
+  void fetch_source_bucket_info_failed();
+  void fetch_source_object_info();
+  void fetch_source_object_info_success();
+  void fetch_source_object_info_failed();
+  void set_source_bucket_authorization_metadata();
+  void check_source_bucket_authorization();
+  void check_source_bucket_authorization_failed();
+  void fetch_multipart_metadata();
+  void fetch_multipart_failed();
+  void save_multipart_metadata();
+  void save_multipart_metadata_failed();
+  void compute_part_offset();
+  void copy_part();
+  bool copy_part_cb();
+  void copy_part_success();
+  void copy_part_failed();
+  void copy_inline_part();
+  void copy_inline_part_failed();
+  void save_metadata();
+  void save_metadata_failed();
+  std::string get_response_xml();
+
+ protected:
+  void fetch_bucket_info_success() override;
+  void fetch_bucket_info_failed() override;
+  void fetch_object_info_failed() override;
+
+ public:
+  S3UploadPartCopyAction(
+      std::shared_ptr<S3RequestObject> req,
+      std::shared_ptr<MotrAPI> motr_api = nullptr,
+      std::shared_ptr<S3BucketMetadataFactory> bucket_meta_factory = nullptr,
+      std::shared_ptr<S3ObjectMetadataFactory> object_meta_factory = nullptr,
+      std::shared_ptr<S3ObjectMultipartMetadataFactory> object_mp_meta_factory =
+          nullptr,
+      std::shared_ptr<S3PartMetadataFactory> part_meta_factory = nullptr,
+      std::shared_ptr<S3MotrWriterFactory> motrwriter_s3_factory = nullptr,
+      std::shared_ptr<S3MotrReaderFactory> motrreader_s3_factory = nullptr,
+      std::shared_ptr<S3AuthClientFactory> auth_factory = nullptr);
+
+  void setup_steps();
+  void set_authorization_meta() override;
+  void send_response_to_s3_client();
+
+  friend class S3UploadPartCopyActionTest;
+
+  FRIEND_TEST(S3UploadPartCopyActionTest, ConstructorTest);
+  FRIEND_TEST(S3UploadPartCopyActionTest, ParseCopySourceRange);
+  FRIEND_TEST(S3UploadPartCopyActionTest, ParseCopySourceRangeInvalid);
+  FRIEND_TEST(S3UploadPartCopyActionTest, ValidateInvalidPartNumber);
+  FRIEND_TEST(S3UploadPartCopyActionTest, ValidateInvalidCopySource);
+  FRIEND_TEST(S3UploadPartCopyActionTest, ValidateInvalidCopySourceRange);
+  FRIEND_TEST(S3UploadPartCopyActionTest, SourceObjectRangeOutOfSize);
+  FRIEND_TEST(S3UploadPartCopyActionTest, SourceObjectWholeObject);
+  FRIEND_TEST(S3UploadPartCopyActionTest, ClipSourceExtents);
+  FRIEND_TEST(S3UploadPartCopyActionTest, ClipContiguousSource);
+  FRIEND_TEST(S3UploadPartCopyActionTest, ComputePartOffsetOfUnalignedRange);
+  FRIEND_TEST(S3UploadPartCopyActionTest, ComputePartOffsetInvalidPartOneSize);
+  FRIEND_TEST(S3UploadPartCopyActionTest, ComputePartOffsetWithPartSlots);
+  FRIEND_TEST(S3UploadPartCopyActionTest, ComputePartOffsetEntityTooLarge);
+  FRIEND_TEST(S3UploadPartCopyActionTest, CopyPartEmptyRange);
+  FRIEND_TEST(S3UploadPartCopyActionTest, CopyPartStarted);
+  FRIEND_TEST(S3UploadPartCopyActionTest, CopyPartOfInlineSource);
+  FRIEND_TEST(S3UploadPartCopyActionTest, SaveMetadata);
+  FRIEND_TEST(S3UploadPartCopyActionTest, SendErrorResponse);
+  FRIEND_TEST(S3UploadPartCopyActionTest, SendSuccessResponse);
+};
+
+#endif  // __S3_SERVER_S3_UPLOAD_PART_COPY_ACTION_H__
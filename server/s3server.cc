@@ -32,13 +32,18 @@
 #include "evhtp_wrapper.h"
 #include "fid/fid.h"
 #include "murmur3_hash.h"
+#include "s3_auth_cache.h"
+#include "s3_auth_connection_pool.h"
+#include "s3_bucket_metadata_cache.h"
 #include "s3_motr_layout.h"
 #include "s3_common_utilities.h"
 #include "s3_daemonize_server.h"
 #include "s3_error_codes.h"
 #include "s3_fi_common.h"
 #include "s3_log.h"
+#include "s3_hash_worker_pool.h"
 #include "s3_mem_pool_manager.h"
+#include "s3_motr_context.h"
 #include "s3_option.h"
 #include "s3_perf_logger.h"
 #include "s3_request_object.h"
@@ -52,6 +57,7 @@
 #include "s3_motr_wrapper.h"
 #include "s3_m0_uint128_helper.h"
 #include "s3_perf_metrics.h"
+#include "s3_qos_scheduler.h"
 #include "s3_iem.h"
 
 #define FOUR_KB 4096
@@ -68,6 +74,7 @@
 #define BUCKET_METADATA_LIST_INDEX_OID_U_LO 2
 #define OBJECT_PROBABLE_DEAD_OID_LIST_INDEX_OID_U_LO 3
 #define GLOBAL_INSTANCE_INDEX_U_LO 4
+#define OBJECT_DATA_REFS_INDEX_OID_U_LO 5
 
 S3Option *g_option_instance = NULL;
 evhtp_ssl_ctx_t *g_ssl_auth_ctx = NULL;
@@ -81,6 +88,8 @@ struct m0_uint128 bucket_metadata_list_index_oid;
 struct m0_uint128 global_instance_list_index;
 // objects listed in this index are probable delete candidates and not absolute.
 struct m0_uint128 global_probable_dead_object_list_index_oid;
+// index will have objects referring data of other objects (shared motr oid).
+struct m0_uint128 global_object_data_refs_index_oid;
 
 int global_shutdown_in_progress;
 pthread_t global_tid_indexop;
@@ -274,13 +283,19 @@ extern "C" evhtp_res dispatch_s3_api_request(evhtp_request_t *req,
       s3_request->http_verb() == S3HttpVerb::PUT) {
     int layout_id = S3MotrLayoutMap::get_instance()->get_layout_for_object_size(
         s3_request->get_data_length());
-    if (!S3MemoryProfile().we_have_enough_memory_for_put_obj(layout_id) ||
+    if (S3QosScheduler::get_instance()) {
+      // Request waits in the scheduler until memory is available.
+      s3_request->set_qos_memory(
+          S3MemoryProfile().memory_per_put_request(layout_id));
+    } else if (
+        !S3MemoryProfile().we_have_enough_memory_for_put_obj(layout_id) ||
         !S3MemoryProfile().free_memory_in_pool_above_threshold_limits()) {
       s3_log(S3_LOG_DEBUG, s3_request->get_request_id().c_str(),
              "Limited memory: Rejecting PUT object/part request with retry.\n");
       s3_request->respond_retry_after(1);
       return EVHTP_RES_OK;
-    } else if (req->buffer_out) {
+    }
+    if (req->buffer_out) {
       // Reserve memory for an error response
       evbuffer_expand(req->buffer_out, 4096);
     }
@@ -296,7 +311,9 @@ extern "C" evhtp_res dispatch_s3_api_request(evhtp_request_t *req,
 
   auto buffered_input = s3_request->get_buffered_input();
 
-  if (buffered_input && !buffered_input->is_freezed()) {
+  // Requests queued by S3QosScheduler are paused
+  if (buffered_input && !buffered_input->is_freezed() &&
+      !s3_request->is_request_paused()) {
     s3_request->set_start_client_request_read_timeout();
   }
 
@@ -624,7 +641,7 @@ void log_resource_limits() {
 
 evhtp_t *create_evhtp_handle(evbase_t *evbase_handle, Router *router,
                              void *arg) {
-  evhtp_t *htp = evhtp_new(global_evbase_handle, NULL);
+  evhtp_t *htp = evhtp_new(evbase_handle, NULL);
 #if defined SO_REUSEPORT
   if (g_option_instance->is_s3_reuseport_enabled()) {
     htp->enable_reuseport = 1;
@@ -688,6 +705,110 @@ void free_evhtp_handle(evhtp_t *htp) {
   }
 }
 
+// Additional reactors serve S3 requests on their own thread and event base,
+// with own listeners on the S3 port (SO_REUSEPORT). Main event base is the
+// first reactor.
+struct s3_reactor {
+  pthread_t tid;
+  evbase_t *evbase;
+  evhtp_t *htp_ipv4;
+  evhtp_t *htp_ipv6;
+};
+static std::vector<struct s3_reactor> s3_reactors;
+
+static void *s3_reactor_loop(void *arg) {
+  struct s3_reactor *reactor = (struct s3_reactor *)arg;
+  // Timers, auth connections and motr completions of requests accepted
+  // here use this event base.
+  S3Option::get_instance()->set_thread_eventbase(reactor->evbase);
+  s3_log(S3_LOG_INFO, "", "Reactor thread started\n");
+  event_base_loop(reactor->evbase, EVLOOP_NO_EXIT_ON_EMPTY);
+  s3_log(S3_LOG_INFO, "", "Reactor thread exited\n");
+  return NULL;
+}
+
+static evhtp_t *create_reactor_listener(evbase_t *evbase, Router *router,
+                                        const std::string &bind_addr,
+                                        uint16_t bind_port) {
+  evhtp_t *htp = create_evhtp_handle(evbase, router, NULL);
+  if (htp == NULL) {
+    return NULL;
+  }
+  if (g_option_instance->is_s3server_ssl_enabled() && !init_ssl(htp)) {
+    evhtp_free(htp);
+    return NULL;
+  }
+  if (evhtp_bind_socket(htp, bind_addr.c_str(), bind_port, 1024) < 0) {
+    s3_log(S3_LOG_ERROR, "", "Could not bind socket: %s\n", strerror(errno));
+    evhtp_free(htp);
+    return NULL;
+  }
+  return htp;
+}
+
+// bind addresses are prefixed with ipv4: / ipv6:, empty if not used.
+int start_s3_reactors(unsigned short count, Router *router,
+                      const std::string &ipv4_bind_addr,
+                      const std::string &ipv6_bind_addr, uint16_t bind_port) {
+  // Threads keep pointers to their entries.
+  s3_reactors.reserve(count);
+  for (unsigned short i = 0; i < count; ++i) {
+    s3_reactors.push_back({});
+    struct s3_reactor &reactor = s3_reactors.back();
+    reactor.evbase = event_base_new();
+    if (reactor.evbase == NULL ||
+        evthread_make_base_notifiable(reactor.evbase) < 0) {
+      s3_log(S3_LOG_ERROR, "", "Couldn't create reactor event base\n");
+      return -1;
+    }
+    if (!ipv4_bind_addr.empty()) {
+      reactor.htp_ipv4 = create_reactor_listener(reactor.evbase, router,
+                                                 ipv4_bind_addr, bind_port);
+      if (reactor.htp_ipv4 == NULL) {
+        return -1;
+      }
+    }
+    if (!ipv6_bind_addr.empty()) {
+      reactor.htp_ipv6 = create_reactor_listener(reactor.evbase, router,
+                                                 ipv6_bind_addr, bind_port);
+      if (reactor.htp_ipv6 == NULL) {
+        return -1;
+      }
+    }
+    if (pthread_create(&reactor.tid, NULL, s3_reactor_loop, &reactor) != 0) {
+      s3_log(S3_LOG_ERROR, "", "Failed to create reactor thread\n");
+      return -1;
+    }
+  }
+  return 0;
+}
+
+// Stops reactor loops, their event bases stay until free_s3_reactors() as
+// motr operations launched on them may still complete until motr is
+// finalized.
+void stop_s3_reactors() {
+  for (auto &reactor : s3_reactors) {
+    if (reactor.tid) {
+      event_base_loopexit(reactor.evbase, NULL);
+      pthread_join(reactor.tid, NULL);
+      reactor.tid = 0;
+    }
+  }
+}
+
+void free_s3_reactors() {
+  // Pooled Auth server connections live on the event bases freed below.
+  S3AuthConnectionPool::destroy_instances();
+  for (auto &reactor : s3_reactors) {
+    free_evhtp_handle(reactor.htp_ipv4);
+    free_evhtp_handle(reactor.htp_ipv6);
+    if (reactor.evbase) {
+      event_base_free(reactor.evbase);
+    }
+  }
+  s3_reactors.clear();
+}
+
 int main(int argc, char **argv) {
   int rc = 0;
   pthread_t tid;
@@ -736,6 +857,14 @@ int main(int argc, char **argv) {
 #if 0
   s3daemon.register_signals();
 #endif
+  // Writer thread of async logging must be started in the daemon process.
+  rc = init_async_log();
+  if (rc != 0) {
+    s3daemon.delete_pidfile();
+    finalize_cli_options();
+    s3_log(S3_LOG_FATAL, "", "Could not start asynchronous logging: %s\n",
+           strerror(-rc));
+  }
   // dump the config
   g_option_instance->dump_options();
 
@@ -757,7 +886,21 @@ int main(int argc, char **argv) {
     s3_log(S3_LOG_FATAL, "", "Stats Init failed!!\n");
   }
 
+  unsigned short reactor_threads = g_option_instance->get_reactor_threads();
+  if (reactor_threads > 1 && !g_option_instance->is_s3_reuseport_enabled()) {
+    s3daemon.delete_pidfile();
+    finalize_cli_options();
+    s3_log(S3_LOG_FATAL, "", "S3_REACTOR_THREADS > 1 needs S3_REUSEPORT\n");
+  }
+
   int libevent_mempool_flags = CREATE_ALIGNED_MEMORY;
+  if (reactor_threads > 1) {
+    // Pools are shared by reactor threads.
+    libevent_mempool_flags = libevent_mempool_flags | ENABLE_LOCKING;
+    if (g_option_instance->is_mempool_thread_cache_enabled()) {
+      libevent_mempool_flags = libevent_mempool_flags | ENABLE_THREAD_CACHE;
+    }
+  }
   if (g_option_instance->get_libevent_mempool_zeroed_buffer()) {
     libevent_mempool_flags = libevent_mempool_flags | ZEROED_BUFFER;
   }
@@ -893,6 +1036,12 @@ int main(int argc, char **argv) {
   }
 
   int motr_read_mempool_flags = CREATE_ALIGNED_MEMORY;
+  if (reactor_threads > 1) {
+    motr_read_mempool_flags = motr_read_mempool_flags | ENABLE_LOCKING;
+    if (g_option_instance->is_mempool_thread_cache_enabled()) {
+      motr_read_mempool_flags = motr_read_mempool_flags | ENABLE_THREAD_CACHE;
+    }
+  }
   if (g_option_instance->get_motr_read_mempool_zeroed_buffer()) {
     motr_read_mempool_flags = motr_read_mempool_flags | ZEROED_BUFFER;
   }
@@ -913,6 +1062,41 @@ int main(int argc, char **argv) {
            "Memory pool creation for motr read buffers failed!\n");
   }
 
+  // Pools for motr operation contexts, shared the same way as above.
+  int motr_ctx_mempool_flags = 0;
+  if (reactor_threads > 1) {
+    motr_ctx_mempool_flags = ENABLE_LOCKING;
+    if (g_option_instance->is_mempool_thread_cache_enabled()) {
+      motr_ctx_mempool_flags = motr_ctx_mempool_flags | ENABLE_THREAD_CACHE;
+    }
+  }
+  rc = create_motr_ctx_pools(
+      g_option_instance->get_motr_ctx_pool_max_threshold(),
+      motr_ctx_mempool_flags);
+  if (rc != 0) {
+    s3daemon.delete_pidfile();
+    fini_auth_ssl();
+    finalize_cli_options();
+    s3_log(S3_LOG_FATAL, "",
+           "Memory pool creation for motr operation contexts failed!\n");
+  }
+
+  if (g_option_instance->get_hash_worker_threads() > 0) {
+    // Offload MD5 computation of object data from the event loop(s).
+    rc = S3HashWorkerPool::create_pool(
+        g_option_instance->get_hash_worker_threads());
+    if (rc != 0) {
+      s3daemon.delete_pidfile();
+      fini_auth_ssl();
+      finalize_cli_options();
+      s3_log(S3_LOG_FATAL, "", "Could not start hash worker threads\n");
+    }
+  }
+
+  // Created before any reactor thread can race to create it on first use.
+  S3BucketMetadataCache::get_instance();
+  S3AuthCache::get_instance();
+
   log_resource_limits();
   struct timeval tv;
   tv.tv_usec = 0;
@@ -986,6 +1170,18 @@ int main(int argc, char **argv) {
     s3_log(S3_LOG_FATAL, "", "Failed to global object leak list KVS index\n");
   }
 
+  // global_object_data_refs_index_oid - will have objects sharing the data of
+  // a motr object, background delete consults it before deleting the data.
+  rc = create_global_index(global_object_data_refs_index_oid,
+                           OBJECT_DATA_REFS_INDEX_OID_U_LO);
+  if (rc < 0) {
+    s3daemon.delete_pidfile();
+    fini_auth_ssl();
+    fini_motr();
+    finalize_cli_options();
+    s3_log(S3_LOG_FATAL, "", "Failed to create object data refs KVS index\n");
+  }
+
   // global_instance_list_index - will hold s3server fid as key,
   // instance id as value.
   rc = create_global_index(global_instance_list_index,
@@ -1041,16 +1237,21 @@ int main(int argc, char **argv) {
     }
   }
 
+  // Requests are admitted by the scheduler as soon as listeners start.
+  rc = s3_qos_init(global_evbase_handle);
+  if (rc != 0) {
+    s3daemon.delete_pidfile();
+    fini_auth_ssl();
+    fini_motr();
+    finalize_cli_options();
+    s3_log(S3_LOG_FATAL, "", "Could not init QoS scheduler: %s\n",
+           strerror(-rc));
+  }
+
 /* KD - setup for reading data */
 /* set a callback to set per-connection hooks (via a post_accept cb) */
 // evhtp_set_post_accept_cb(htp, set_my_connection_handlers, NULL);
 
-#if 0
-#ifndef EVHTP_DISABLE_EVTHR
-    evhtp_use_threads(htp, NULL, 4, NULL);
-#endif
-#endif
-
   if (htp_ipv4) {
     // apend ipv4: prefix to identify by evhtp_bind_socket
     ipv4_bind_addr = "ipv4:" + ipv4_bind_addr;
@@ -1102,6 +1303,22 @@ int main(int argc, char **argv) {
     }
   }
 
+  if (reactor_threads > 1) {
+    s3_log(S3_LOG_INFO, "", "Starting %d additional S3 reactor threads\n",
+           reactor_threads - 1);
+    if (start_s3_reactors(reactor_threads - 1, s3_router,
+                          htp_ipv4 ? ipv4_bind_addr : "",
+                          htp_ipv6 ? ipv6_bind_addr : "", bind_port) != 0) {
+      s3daemon.delete_pidfile();
+      fini_auth_ssl();
+      stop_s3_reactors();
+      fini_motr();
+      free_s3_reactors();
+      finalize_cli_options();
+      s3_log(S3_LOG_FATAL, "", "Could not start S3 reactor threads\n");
+    }
+  }
+
   rc = s3_perf_metrics_init(global_evbase_handle);
   if (rc != 0) {
     s3daemon.delete_pidfile();
@@ -1148,9 +1365,12 @@ int main(int argc, char **argv) {
            "backend\n");
   }
 
+  // Reactors must not run motr callbacks past motr teardown.
+  stop_s3_reactors();
   shutdown_motr_teardown_called = 1;
   global_motr_teardown();
   s3_perf_metrics_fini();
+  s3_qos_fini();
   pthread_join(global_tid_indexop, NULL);
   pthread_join(global_tid_objop, NULL);
   S3FakeMotrRedisKvs::destroy_instance();
@@ -1162,6 +1382,7 @@ int main(int argc, char **argv) {
 
   /* Clean-up */
   fini_motr();
+  free_s3_reactors();
 
   delete s3_router;
   delete motr_router;
@@ -1171,7 +1392,11 @@ int main(int argc, char **argv) {
   s3_stats_fini();
   S3AuditInfoLogger::finalize();
   finalize_cli_options();
+  S3HashWorkerPool::destroy_instance();
+  S3BucketMetadataCache::destroy_instance();
+  S3AuthCache::destroy_instance();
   S3MempoolManager::destroy_instance();
+  destroy_motr_ctx_pools();
   S3MotrLayoutMap::destroy_instance();
   S3Option::destroy_instance();
   event_destroy_mempool();
@@ -94,6 +94,11 @@ class ActionTest : public testing::Test {
  public:
   void func_callback_one() { call_count_one += 1; }
   void func_callback_two() { call_count_two += 1; }
+  // Task completing right away
+  void func_callback_done() {
+    call_count_two += 1;
+    ptr_Actionobject->next();
+  }
 };
 
 TEST_F(ActionTest, Constructor) {
@@ -161,6 +166,41 @@ TEST_F(ActionTest, TasklistRun) {
   EXPECT_TRUE(call_count_two == 1);
 }
 
+TEST_F(ActionTest, TaskGroupRun) {
+  ptr_Actionobject->set_defaults();
+  ptr_Actionobject->begin_task_group();
+  ACTION_TASK_ADD_OBJPTR(ptr_Actionobject, ActionTest::func_callback_one, this);
+  ACTION_TASK_ADD_OBJPTR(ptr_Actionobject, ActionTest::func_callback_two, this);
+  ptr_Actionobject->end_task_group();
+  ACTION_TASK_ADD_OBJPTR(ptr_Actionobject, ActionTest::func_callback_one, this);
+
+  ptr_Actionobject->start();
+  EXPECT_EQ(1, call_count_one);
+  EXPECT_EQ(1, call_count_two);
+  EXPECT_EQ(2u, ptr_Actionobject->tasks_in_flight);
+  // First task of group done, still waiting for the other
+  ptr_Actionobject->next();
+  EXPECT_EQ(1, call_count_one);
+  ptr_Actionobject->next();
+  EXPECT_EQ(2, call_count_one);
+  EXPECT_EQ(0u, ptr_Actionobject->tasks_in_flight);
+}
+
+TEST_F(ActionTest, TaskGroupCompletedRightAway) {
+  ptr_Actionobject->set_defaults();
+  ptr_Actionobject->begin_task_group();
+  ACTION_TASK_ADD_OBJPTR(ptr_Actionobject, ActionTest::func_callback_done,
+                         this);
+  ACTION_TASK_ADD_OBJPTR(ptr_Actionobject, ActionTest::func_callback_done,
+                         this);
+  ptr_Actionobject->end_task_group();
+  ACTION_TASK_ADD_OBJPTR(ptr_Actionobject, ActionTest::func_callback_one, this);
+
+  ptr_Actionobject->start();
+  EXPECT_EQ(2, call_count_two);
+  EXPECT_EQ(1, call_count_one);
+}
+
 TEST_F(ActionTest, RollbacklistRun) {
   ptr_Actionobject->set_defaults();
   ptr_Actionobject->add_task_rollback(
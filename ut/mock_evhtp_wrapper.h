@@ -54,6 +54,11 @@ class MockEvhtpWrapper : public EvhtpInterface {
   MOCK_METHOD2(http_send_reply_body,
                void(evhtp_request_t *request, evbuf_t *buf));
   MOCK_METHOD1(http_send_reply_end, void(evhtp_request_t *request));
+  MOCK_METHOD2(http_send_reply_chunk_start,
+               void(evhtp_request_t *request, evhtp_res code));
+  MOCK_METHOD2(http_send_reply_chunk,
+               void(evhtp_request_t *request, evbuf_t *buf));
+  MOCK_METHOD1(http_send_reply_chunk_end, void(evhtp_request_t *request));
   MOCK_METHOD1(close_connection_after_writing, void(evhtp_connection_t *));
 
   // Libevent wrappers
@@ -224,6 +224,12 @@ class MockS3MotrKVSReaderFactory : public S3MotrKVSReaderFactory {
     return mock_motr_kvs_reader;
   }
 
+  std::shared_ptr<S3MotrKVSReader> create_motr_kvs_cursor(
+      std::shared_ptr<RequestObject> req,
+      std::shared_ptr<MotrAPI> s3_motr_api = nullptr) override {
+    return mock_motr_kvs_reader;
+  }
+
   std::shared_ptr<MockS3MotrKVSReader> mock_motr_kvs_reader;
 };
 
@@ -67,6 +67,9 @@ class MockS3ObjectMetadata : public S3ObjectMetadata {
                           std::function<void(void)> on_failed));
   MOCK_METHOD2(remove, void(std::function<void(void)> on_success,
                             std::function<void(void)> on_failed));
+  MOCK_METHOD2(remove_version_metadata,
+               void(std::function<void(void)> on_success,
+                    std::function<void(void)> on_failed));
   MOCK_METHOD1(setacl, void(const std::string&));
   MOCK_METHOD1(set_tags,
                void(const std::map<std::string, std::string>& tags_as_map));
@@ -77,6 +80,7 @@ class MockS3ObjectMetadata : public S3ObjectMetadata {
   MOCK_METHOD2(save_metadata, void(std::function<void(void)> on_success,
                                    std::function<void(void)> on_failed));
   MOCK_METHOD1(from_json, int(std::string content));
+  MOCK_METHOD1(from_listing_json, int(const std::string &content));
 };
 
 #endif
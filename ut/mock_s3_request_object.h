@@ -67,7 +67,14 @@ class MockS3RequestObject : public S3RequestObject {
   MOCK_METHOD2(send_response, void(int, std::string));
   MOCK_METHOD1(send_reply_start, void(int code));
   MOCK_METHOD2(send_reply_body, void(const char *data, int length));
+  MOCK_METHOD4(send_reply_body_by_ref,
+               void(const char *data, int length,
+                    evbuffer_ref_cleanup_cb cleanup_fn, void *cleanup_arg));
   MOCK_METHOD0(send_reply_end, void());
+  MOCK_METHOD1(send_reply_chunk_start, void(int code));
+  MOCK_METHOD2(send_reply_chunk, void(const char *data, int length));
+  MOCK_METHOD0(send_reply_chunk_end, void());
+  MOCK_METHOD0(get_pending_reply_body_length, size_t());
   MOCK_METHOD0(close_connection, void());
   MOCK_METHOD0(is_chunk_detail_ready, bool());
   MOCK_METHOD0(pop_chunk_detail, S3ChunkDetail());
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <cstdarg>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "s3_async_log.h"
+#include "s3_log.h"
+
+static std::string text_of(const S3LogRecord *record) {
+  return std::string(reinterpret_cast<const char *>(record + 1),
+                     record->text_len);
+}
+
+static bool push_text(S3LogRing &ring, const std::string &text,
+                      int64_t timestamp = 0) {
+  return ring.push(S3_LOG_INFO, __FILE__, __LINE__, timestamp, text.c_str(),
+                   text.length());
+}
+
+TEST(S3LogRingTest, PushAndPop) {
+  S3LogRing ring(4096);
+  EXPECT_TRUE(ring.front(ring.get_end()) == NULL);
+  EXPECT_TRUE(push_text(ring, "first", 1));
+  EXPECT_TRUE(push_text(ring, "second", 2));
+
+  const S3LogRecord *record = ring.front(ring.get_end());
+  ASSERT_TRUE(record != NULL);
+  EXPECT_EQ("first", text_of(record));
+  EXPECT_EQ(S3_LOG_INFO, record->level);
+  EXPECT_STREQ(__FILE__, record->file);
+  EXPECT_EQ(1, record->timestamp_nsec);
+  ring.pop();
+  record = ring.front(ring.get_end());
+  ASSERT_TRUE(record != NULL);
+  EXPECT_EQ("second", text_of(record));
+  ring.pop();
+  EXPECT_TRUE(ring.front(ring.get_end()) == NULL);
+}
+
+TEST(S3LogRingTest, ReadsOnlyUpToEnd) {
+  S3LogRing ring(4096);
+  EXPECT_TRUE(push_text(ring, "first"));
+  const uint64_t end = ring.get_end();
+  EXPECT_TRUE(push_text(ring, "second"));
+  EXPECT_TRUE(ring.front(end) != NULL);
+  ring.pop();
+  EXPECT_TRUE(ring.front(end) == NULL);
+  EXPECT_TRUE(ring.front(ring.get_end()) != NULL);
+}
+
+TEST(S3LogRingTest, WrapsAround) {
+  S3LogRing ring(256);
+  for (int i = 0; i < 100; ++i) {
+    // Sizes vary so records end at different offsets of the ring
+    const std::string text(i % 70, 'a' + i % 26);
+    ASSERT_TRUE(push_text(ring, text));
+    const S3LogRecord *record = ring.front(ring.get_end());
+    ASSERT_TRUE(record != NULL);
+    EXPECT_EQ(text, text_of(record));
+    ring.pop();
+    EXPECT_TRUE(ring.front(ring.get_end()) == NULL);
+  }
+}
+
+TEST(S3LogRingTest, DropsWhenFull) {
+  S3LogRing ring(256);
+  int pushed = 0;
+  while (push_text(ring, "message")) {
+    ++pushed;
+  }
+  // Each record takes 64 bytes
+  EXPECT_EQ(4, pushed);
+  EXPECT_TRUE(ring.is_half_full());
+  EXPECT_FALSE(push_text(ring, "message"));
+  EXPECT_EQ(2, ring.take_dropped());
+  EXPECT_EQ(0, ring.take_dropped());
+
+  ring.pop();
+  EXPECT_TRUE(push_text(ring, "message"));
+}
+
+TEST(S3LogRingTest, TruncatesLongText) {
+  S3LogRing ring(256);
+  const std::string text(1000, 'x');
+  ASSERT_TRUE(push_text(ring, text));
+  const S3LogRecord *record = ring.front(ring.get_end());
+  ASSERT_TRUE(record != NULL);
+  EXPECT_EQ(ring.get_max_text_len(), record->text_len);
+  EXPECT_EQ(text.substr(0, record->text_len), text_of(record));
+}
+
+class S3AsyncLoggerTest : public testing::Test {
+ protected:
+  std::mutex lock;
+  std::vector<std::string> messages;
+  std::vector<int> levels;
+  std::vector<int64_t> timestamps;
+
+  S3AsyncLogger::Writer get_writer() {
+    return [this](const S3LogRecord &record, const char *text) {
+      std::lock_guard<std::mutex> guard(lock);
+      messages.push_back(std::string(text, record.text_len));
+      levels.push_back(record.level);
+      timestamps.push_back(record.timestamp_nsec);
+    };
+  }
+
+  size_t get_message_count() {
+    std::lock_guard<std::mutex> guard(lock);
+    return messages.size();
+  }
+};
+
+static void log_to(S3AsyncLogger &logger, int level, const char *fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+
+static void log_to(S3AsyncLogger &logger, int level, const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  logger.log(level, __FILE__, __LINE__, fmt, args);
+  va_end(args);
+}
+
+TEST_F(S3AsyncLoggerTest, FormatsMessages) {
+  S3AsyncLogger logger(4096, get_writer());
+  ASSERT_EQ(0, logger.start());
+  log_to(logger, S3_LOG_INFO, "[Req:%s] Entering %d\n", "id", 42);
+  log_to(logger, S3_LOG_WARN, "no new line");
+  logger.flush();
+  ASSERT_EQ(2, messages.size());
+  // Trailing new line is left to the writer
+  EXPECT_EQ("[Req:id] Entering 42", messages[0]);
+  EXPECT_EQ(S3_LOG_INFO, levels[0]);
+  EXPECT_EQ("no new line", messages[1]);
+  EXPECT_EQ(S3_LOG_WARN, levels[1]);
+}
+
+TEST_F(S3AsyncLoggerTest, MessagesOfThreadsAreMergedByTime) {
+  S3AsyncLogger logger(4096, get_writer());
+  // Messages wait in rings of both threads until the writer starts
+  log_to(logger, S3_LOG_INFO, "main 1");
+  std::thread([&logger]() { log_to(logger, S3_LOG_INFO, "other 1"); }).join();
+  log_to(logger, S3_LOG_INFO, "main 2");
+  std::thread([&logger]() { log_to(logger, S3_LOG_INFO, "other 2"); }).join();
+  ASSERT_EQ(0, logger.start());
+  logger.flush();
+  std::vector<std::string> expected = {"main 1", "other 1", "main 2",
+                                       "other 2"};
+  EXPECT_EQ(expected, messages);
+}
+
+TEST_F(S3AsyncLoggerTest, ThreadsLogConcurrently) {
+  S3AsyncLogger logger(64 * 1024, get_writer());
+  ASSERT_EQ(0, logger.start());
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.push_back(std::thread([&logger, t]() {
+      for (int i = 0; i < 100; ++i) {
+        log_to(logger, S3_LOG_INFO, "thread %d message %d", t, i);
+      }
+    }));
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  logger.flush();
+  ASSERT_EQ(400, messages.size());
+  for (int t = 0; t < 4; ++t) {
+    int next = 0;
+    const std::string prefix = "thread " + std::to_string(t) + " ";
+    for (const auto &message : messages) {
+      if (message.compare(0, prefix.length(), prefix) == 0) {
+        EXPECT_EQ(prefix + "message " + std::to_string(next), message);
+        ++next;
+      }
+    }
+    EXPECT_EQ(100, next);
+  }
+}
+
+TEST_F(S3AsyncLoggerTest, DroppedMessagesAreCounted) {
+  S3AsyncLogger logger(256, get_writer());
+  for (int i = 0; i < 10; ++i) {
+    log_to(logger, S3_LOG_INFO, "message %d", i);
+  }
+  EXPECT_EQ(0, get_message_count());
+  ASSERT_EQ(0, logger.start());
+  logger.flush();
+  ASSERT_EQ(5, messages.size());
+  EXPECT_EQ("message 0", messages[0]);
+  EXPECT_EQ("message 3", messages[3]);
+  EXPECT_NE(std::string::npos,
+            messages[4].find("6 log messages were dropped"));
+  EXPECT_EQ(S3_LOG_WARN, levels[4]);
+}
+
+TEST_F(S3AsyncLoggerTest, ErrorsAreNotDropped) {
+  S3AsyncLogger logger(256, get_writer());
+  for (int i = 0; i < 4; ++i) {
+    log_to(logger, S3_LOG_INFO, "message %d", i);
+  }
+  EXPECT_EQ(0, get_message_count());
+  // Ring is full, so the error is written by the caller
+  log_to(logger, S3_LOG_ERROR, "error");
+  ASSERT_EQ(1, get_message_count());
+  EXPECT_EQ("error", messages[0]);
+  EXPECT_EQ(S3_LOG_ERROR, levels[0]);
+}
+
+TEST_F(S3AsyncLoggerTest, FatalIsFlushed) {
+  S3AsyncLogger logger(4096, get_writer());
+  ASSERT_EQ(0, logger.start());
+  log_to(logger, S3_LOG_INFO, "info");
+  log_to(logger, S3_LOG_FATAL, "fatal");
+  ASSERT_EQ(2, get_message_count());
+  EXPECT_EQ("fatal", messages[1]);
+}
+
+TEST_F(S3AsyncLoggerTest, StopWritesEverything) {
+  S3AsyncLogger logger(4096, get_writer());
+  ASSERT_EQ(0, logger.start());
+  for (int i = 0; i < 20; ++i) {
+    log_to(logger, S3_LOG_INFO, "message %d", i);
+  }
+  logger.stop();
+  EXPECT_EQ(20, messages.size());
+  // Flush after stop returns right away
+  logger.flush();
+}
+
+TEST_F(S3AsyncLoggerTest, RingsOfExitedThreadsAreForgotten) {
+  S3AsyncLogger logger(4096, get_writer());
+  ASSERT_EQ(0, logger.start());
+  std::thread thread([&logger]() { log_to(logger, S3_LOG_INFO, "bye"); });
+  thread.join();
+  logger.flush();
+  EXPECT_EQ(1, get_message_count());
+  std::lock_guard<std::mutex> guard(logger.lock);
+  EXPECT_TRUE(logger.rings.empty());
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "s3_auth_cache.h"
+
+#define SCOPE "20130524/us-east-1/s3/aws4_request"
+
+class S3AuthCacheTest : public testing::Test {
+ protected:
+  S3AuthCacheTest() : cache(2, 60000) {}
+
+  std::shared_ptr<const S3AuthCacheEntry> make_entry(
+      const std::string& user_name) {
+    auto entry = std::make_shared<S3AuthCacheEntry>();
+    entry->signing_key = "key";
+    entry->user_name = user_name;
+    return entry;
+  }
+
+  S3AuthCache cache;
+};
+
+TEST_F(S3AuthCacheTest, DisabledWhenNoEntriesOrTtl) {
+  EXPECT_TRUE(cache.is_enabled());
+  EXPECT_FALSE(S3AuthCache(0, 60000).is_enabled());
+  EXPECT_FALSE(S3AuthCache(10, 0).is_enabled());
+
+  S3AuthCache disabled(0, 60000);
+  disabled.put("AK1", SCOPE, make_entry("user1"));
+  EXPECT_EQ(0, disabled.size());
+}
+
+TEST_F(S3AuthCacheTest, GetReturnsCachedEntry) {
+  EXPECT_EQ(nullptr, cache.get("AK1", SCOPE));
+  cache.put("AK1", SCOPE, make_entry("user1"));
+
+  auto entry = cache.get("AK1", SCOPE);
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ("user1", entry->user_name);
+}
+
+TEST_F(S3AuthCacheTest, EntriesAreScoped) {
+  cache.put("AK1", SCOPE, make_entry("user1"));
+
+  EXPECT_EQ(nullptr, cache.get("AK2", SCOPE));
+  EXPECT_EQ(nullptr, cache.get("AK1", "20130525/us-east-1/s3/aws4_request"));
+  EXPECT_EQ(nullptr, cache.get("AK1", "20130524/us-west-2/s3/aws4_request"));
+}
+
+TEST_F(S3AuthCacheTest, LeastRecentlyUsedIsEvicted) {
+  cache.put("AK1", SCOPE, make_entry("user1"));
+  cache.put("AK2", SCOPE, make_entry("user2"));
+  // AK1 becomes most recently used
+  EXPECT_NE(nullptr, cache.get("AK1", SCOPE));
+  cache.put("AK3", SCOPE, make_entry("user3"));
+
+  EXPECT_EQ(2, cache.size());
+  EXPECT_NE(nullptr, cache.get("AK1", SCOPE));
+  EXPECT_EQ(nullptr, cache.get("AK2", SCOPE));
+  EXPECT_NE(nullptr, cache.get("AK3", SCOPE));
+}
+
+TEST_F(S3AuthCacheTest, EntryExpiresAfterTtl) {
+  S3AuthCache short_lived(2, 10);
+  short_lived.put("AK1", SCOPE, make_entry("user1"));
+  EXPECT_NE(nullptr, short_lived.get("AK1", SCOPE));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(nullptr, short_lived.get("AK1", SCOPE));
+  EXPECT_EQ(0, short_lived.size());
+}
+
+TEST_F(S3AuthCacheTest, DisableDropsEntries) {
+  cache.put("AK1", SCOPE, make_entry("user1"));
+  cache.disable();
+
+  EXPECT_FALSE(cache.is_enabled());
+  EXPECT_EQ(0, cache.size());
+  EXPECT_EQ(nullptr, cache.get("AK1", SCOPE));
+  cache.put("AK1", SCOPE, make_entry("user1"));
+  EXPECT_EQ(0, cache.size());
+}
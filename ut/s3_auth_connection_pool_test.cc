@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "s3_auth_connection_pool.h"
+
+class S3AuthConnectionPoolTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    evbase = event_base_new();
+    ASSERT_TRUE(evbase != NULL);
+
+    // Connections of the pool need a peer which accepts them.
+    listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_LE(0, listen_fd);
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    ASSERT_EQ(0, bind(listen_fd, (struct sockaddr *)&addr, addr_len));
+    ASSERT_EQ(0, listen(listen_fd, 16));
+    ASSERT_EQ(0, getsockname(listen_fd, (struct sockaddr *)&addr, &addr_len));
+    port = ntohs(addr.sin_port);
+  }
+
+  void TearDown() override {
+    pool.reset();
+    close(listen_fd);
+    event_base_free(evbase);
+  }
+
+  void create_pool(size_t max_idle, unsigned int idle_timeout_millisec) {
+    pool.reset(
+        new S3AuthConnectionPool(evbase, max_idle, idle_timeout_millisec));
+  }
+
+  evhtp_connection_t *new_connection() {
+    return evhtp_connection_new(evbase, "127.0.0.1", port);
+  }
+
+  // Runs the deferred release of connections.
+  void run_loop() { event_base_loop(evbase, EVLOOP_NONBLOCK); }
+
+  evbase_t *evbase = NULL;
+  int listen_fd = -1;
+  uint16_t port = 0;
+  std::unique_ptr<S3AuthConnectionPool> pool;
+};
+
+TEST_F(S3AuthConnectionPoolTest, ReleasedConnectionIsReused) {
+  create_pool(2, 60000);
+  evhtp_connection_t *conn = new_connection();
+  ASSERT_TRUE(conn != NULL);
+
+  pool->release(conn, true);
+  EXPECT_EQ(0, pool->get_idle_count());
+  run_loop();
+  EXPECT_EQ(1, pool->get_idle_count());
+
+  EXPECT_EQ(conn, pool->acquire());
+  EXPECT_EQ(0, pool->get_idle_count());
+  evhtp_connection_free(conn);
+}
+
+TEST_F(S3AuthConnectionPoolTest, UnusableConnectionIsClosed) {
+  create_pool(2, 60000);
+  evhtp_connection_t *conn = new_connection();
+  ASSERT_TRUE(conn != NULL);
+
+  pool->release(conn, false);
+  run_loop();
+  EXPECT_EQ(0, pool->get_idle_count());
+}
+
+TEST_F(S3AuthConnectionPoolTest, IdleListIsBounded) {
+  create_pool(2, 60000);
+  evhtp_connection_t *conn1 = new_connection();
+  evhtp_connection_t *conn2 = new_connection();
+  evhtp_connection_t *conn3 = new_connection();
+
+  pool->release(conn1, true);
+  pool->release(conn2, true);
+  pool->release(conn3, true);
+  run_loop();
+
+  ASSERT_EQ(2, pool->get_idle_count());
+  EXPECT_EQ(conn3, pool->idle.front().conn);
+  EXPECT_EQ(conn2, pool->idle.back().conn);
+}
+
+TEST_F(S3AuthConnectionPoolTest, ExpiredConnectionIsNotReused) {
+  create_pool(2, 1);
+  pool->release(new_connection(), true);
+  run_loop();
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+  pool->release(new_connection(), true);
+  run_loop();
+  EXPECT_EQ(1, pool->get_idle_count());
+}
+
+TEST_F(S3AuthConnectionPoolTest, ClosedConnectionLeavesPool) {
+  create_pool(2, 60000);
+  evhtp_connection_t *conn = new_connection();
+  pool->release(conn, true);
+  run_loop();
+  ASSERT_EQ(1, pool->get_idle_count());
+
+  // As evhtp does when Auth server closes the connection
+  evhtp_connection_free(conn);
+  EXPECT_EQ(0, pool->get_idle_count());
+}
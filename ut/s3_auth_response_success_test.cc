@@ -80,6 +80,25 @@ TEST_F(S3AuthResponseSuccessTest, GetSignatureSHA256) {
             "UvRt9pMPxbsSfHzEi9CIBOmDxJs=");
 }
 
+TEST_F(S3AuthResponseSuccessTest, GetSigningKey) {
+  EXPECT_EQ(auth_response_under_test->get_signing_key(), "");
+
+  std::string auth_success_xml_with_key =
+      "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>"
+      "<AuthenticateUserResponse "
+      "xmlns=\"https://iam.seagate.com/doc/2010-05-08/\">"
+      "<AuthenticateUserResult><UserId>123</UserId><UserName>tester</UserName>"
+      "<AccountId>12345</AccountId><AccountName>s3_test</AccountName>"
+      "<SignatureSHA256>UvRt9pMPxbsSfHzEi9CIBOmDxJs=</SignatureSHA256>"
+      "<SigningKey>0a1b2c</SigningKey></AuthenticateUserResult>"
+      "<ResponseMetadata><RequestId>1111</RequestId></ResponseMetadata></"
+      "AuthenticateUserResponse>";
+  auth_response_under_test =
+      std::make_shared<S3AuthResponseSuccess>(auth_success_xml_with_key);
+  EXPECT_TRUE(auth_response_under_test->isOK());
+  EXPECT_EQ(auth_response_under_test->get_signing_key(), "0a1b2c");
+}
+
 // Validate request id parsed from xml.
 TEST_F(S3AuthResponseSuccessTest, GetRequestId) {
   EXPECT_EQ(auth_response_under_test->get_request_id(), "1111");
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "s3_bucket_metadata_cache.h"
+
+class S3BucketMetadataCacheTest : public testing::Test {
+ protected:
+  S3BucketMetadataCacheTest() : cache(2, 60000) {}
+
+  std::shared_ptr<const S3BucketMetadataRecord> make_record(
+      const std::string& owner) {
+    auto record = std::make_shared<S3BucketMetadataRecord>();
+    record->bucket_owner_account_id = owner;
+    return record;
+  }
+
+  S3BucketMetadataCache cache;
+};
+
+TEST_F(S3BucketMetadataCacheTest, DisabledWhenNoEntriesOrTtl) {
+  EXPECT_TRUE(cache.is_enabled());
+  EXPECT_FALSE(S3BucketMetadataCache(0, 60000).is_enabled());
+  EXPECT_FALSE(S3BucketMetadataCache(10, 0).is_enabled());
+
+  S3BucketMetadataCache disabled(0, 60000);
+  disabled.put("bucket", make_record("A1"), disabled.get_generation());
+  EXPECT_EQ(0, disabled.size());
+}
+
+TEST_F(S3BucketMetadataCacheTest, GetReturnsCachedRecord) {
+  EXPECT_EQ(nullptr, cache.get("bucket"));
+  cache.put("bucket", make_record("A1"), cache.get_generation());
+
+  auto record = cache.get("bucket");
+  ASSERT_NE(nullptr, record);
+  EXPECT_EQ("A1", record->bucket_owner_account_id);
+}
+
+TEST_F(S3BucketMetadataCacheTest, LeastRecentlyUsedIsEvicted) {
+  cache.put("bucket1", make_record("A1"), cache.get_generation());
+  cache.put("bucket2", make_record("A2"), cache.get_generation());
+  // bucket1 becomes most recently used
+  EXPECT_NE(nullptr, cache.get("bucket1"));
+  cache.put("bucket3", make_record("A3"), cache.get_generation());
+
+  EXPECT_EQ(2, cache.size());
+  EXPECT_NE(nullptr, cache.get("bucket1"));
+  EXPECT_EQ(nullptr, cache.get("bucket2"));
+  EXPECT_NE(nullptr, cache.get("bucket3"));
+}
+
+TEST_F(S3BucketMetadataCacheTest, PutReplacesEntry) {
+  cache.put("bucket", make_record("A1"), cache.get_generation());
+  cache.put("bucket", make_record("A2"), cache.get_generation());
+
+  EXPECT_EQ(1, cache.size());
+  EXPECT_EQ("A2", cache.get("bucket")->bucket_owner_account_id);
+}
+
+TEST_F(S3BucketMetadataCacheTest, EntryExpiresAfterTtl) {
+  S3BucketMetadataCache short_lived(2, 10);
+  short_lived.put("bucket", make_record("A1"), short_lived.get_generation());
+  EXPECT_NE(nullptr, short_lived.get("bucket"));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(nullptr, short_lived.get("bucket"));
+  EXPECT_EQ(0, short_lived.size());
+}
+
+TEST_F(S3BucketMetadataCacheTest, InvalidateRemovesEntry) {
+  cache.put("bucket1", make_record("A1"), cache.get_generation());
+  cache.put("bucket2", make_record("A2"), cache.get_generation());
+
+  cache.invalidate("bucket1");
+  EXPECT_EQ(nullptr, cache.get("bucket1"));
+  EXPECT_NE(nullptr, cache.get("bucket2"));
+}
+
+TEST_F(S3BucketMetadataCacheTest, PutAfterInvalidateIsDropped) {
+  uint64_t generation = cache.get_generation();
+  cache.invalidate("bucket");
+  cache.put("bucket", make_record("A1"), generation);
+  EXPECT_EQ(nullptr, cache.get("bucket"));
+
+  cache.put("bucket", make_record("A1"), cache.get_generation());
+  EXPECT_NE(nullptr, cache.get("bucket"));
+}
@@ -23,9 +23,11 @@
 
 #include "mock_s3_factory.h"
 #include "mock_s3_request_object.h"
+#include "s3_bucket_metadata_cache.h"
 #include "s3_bucket_metadata_v1.h"
 #include "s3_callback_test_helpers.h"
 #include "s3_common.h"
+#include "s3_metadata_codec.h"
 #include "s3_test_utils.h"
 #include "s3_ut_common.h"
 
@@ -236,6 +238,67 @@ TEST_F(S3BucketMetadataV1Test, Load) {
       std::bind(&S3CallBack::on_failed, &s3bucketmetadata_callbackobj));
 }
 
+TEST_F(S3BucketMetadataV1Test, LoadFromCache) {
+  S3BucketMetadataCache* saved_instance = S3BucketMetadataCache::instance;
+  S3BucketMetadataCache::instance = new S3BucketMetadataCache(10, 60000);
+
+  auto record = std::make_shared<S3BucketMetadataRecord>();
+  record->bucket_owner_account_id = "12345";
+  record->bucket_name = bucket_name;
+  record->account_name = "cachedaccount";
+  record->object_list_index_oid = {0x11ff, 0x1fff};
+  S3BucketMetadataCache::instance->put(
+      bucket_name, record, S3BucketMetadataCache::instance->get_generation());
+
+  EXPECT_CALL(*(s3_global_bucket_index_metadata_factory
+                    ->mock_global_bucket_index_metadata),
+              load(_, _)).Times(0);
+  action_under_test->load(
+      std::bind(&S3CallBack::on_success, &s3bucketmetadata_callbackobj),
+      std::bind(&S3CallBack::on_failed, &s3bucketmetadata_callbackobj));
+
+  EXPECT_TRUE(s3bucketmetadata_callbackobj.success_called);
+  EXPECT_EQ(S3BucketMetadataState::present, action_under_test->state);
+  EXPECT_STREQ("12345", action_under_test->bucket_owner_account_id.c_str());
+  EXPECT_STREQ("cachedaccount", action_under_test->account_name.c_str());
+  EXPECT_OID_EQ(record->object_list_index_oid,
+                action_under_test->object_list_index_oid);
+
+  S3BucketMetadataCache::destroy_instance();
+  S3BucketMetadataCache::instance = saved_instance;
+}
+
+TEST_F(S3BucketMetadataV1Test, UpdateInvalidatesCache) {
+  S3BucketMetadataCache* saved_instance = S3BucketMetadataCache::instance;
+  S3BucketMetadataCache::instance = new S3BucketMetadataCache(10, 60000);
+  S3BucketMetadataCache::instance->put(
+      bucket_name, std::make_shared<S3BucketMetadataRecord>(),
+      S3BucketMetadataCache::instance->get_generation());
+  uint64_t generation = S3BucketMetadataCache::instance->get_generation();
+
+  action_under_test->state = S3BucketMetadataState::present;
+  action_under_test->bucket_owner_account_id = "12345";
+  EXPECT_CALL(*(motr_kvs_writer_factory->mock_motr_kvs_writer),
+              put_keyval(_, _, _, _, _)).Times(1);
+  action_under_test->update(
+      std::bind(&S3CallBack::on_success, &s3bucketmetadata_callbackobj),
+      std::bind(&S3CallBack::on_failed, &s3bucketmetadata_callbackobj));
+  EXPECT_EQ(0, S3BucketMetadataCache::instance->size());
+  EXPECT_EQ(generation + 1, S3BucketMetadataCache::instance->get_generation());
+
+  // A load that started before the update completed is not cached
+  S3BucketMetadataCache::instance->put(
+      bucket_name, std::make_shared<S3BucketMetadataRecord>(), generation);
+  EXPECT_EQ(0, S3BucketMetadataCache::instance->size());
+
+  action_under_test->save_bucket_info_successful();
+  EXPECT_TRUE(s3bucketmetadata_callbackobj.success_called);
+  EXPECT_EQ(generation + 2, S3BucketMetadataCache::instance->get_generation());
+
+  S3BucketMetadataCache::destroy_instance();
+  S3BucketMetadataCache::instance = saved_instance;
+}
+
 TEST_F(S3BucketMetadataV1Test, LoadBucketInfo) {
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
               get_keyval(_, "12345/seagate", _, _)).Times(1);
@@ -799,6 +862,41 @@ TEST_F(S3BucketMetadataV1Test, FromJson) {
   EXPECT_OID_NE(zero_oid, action_under_test->multipart_index_oid);
 }
 
+TEST_F(S3BucketMetadataV1Test, ToBinaryFromBinary) {
+  struct m0_uint128 multipart_oid = {0x1ffff, 0x1fff0};
+  action_under_test->bucket_name = "seagatebucket";
+  action_under_test->system_defined_attribute["Owner-Account"] = "s3_test";
+  action_under_test->system_defined_attribute["Owner-User"] = "tester";
+  action_under_test->encoded_acl = "PD94bg==";
+  action_under_test->bucket_policy = "{\"Version\":\"2012-10-17\"}";
+  action_under_test->bucket_tags["tag"] = "value";
+  action_under_test->multipart_index_oid = multipart_oid;
+
+  std::string record = action_under_test->to_binary();
+  EXPECT_TRUE(s3_is_binary_metadata(record));
+
+  action_under_test->bucket_name.clear();
+  action_under_test->system_defined_attribute.clear();
+  action_under_test->encoded_acl.clear();
+  action_under_test->bucket_policy.clear();
+  action_under_test->bucket_tags.clear();
+  action_under_test->multipart_index_oid = {0ULL, 0ULL};
+
+  EXPECT_EQ(0, action_under_test->from_json(record));
+  EXPECT_EQ("seagatebucket", action_under_test->bucket_name);
+  EXPECT_EQ("tester", action_under_test->user_name);
+  EXPECT_EQ("s3_test", action_under_test->account_name);
+  EXPECT_EQ("PD94bg==", action_under_test->encoded_acl);
+  EXPECT_EQ("{\"Version\":\"2012-10-17\"}", action_under_test->bucket_policy);
+  EXPECT_EQ("value", action_under_test->bucket_tags["tag"]);
+  EXPECT_OID_EQ(multipart_oid, action_under_test->multipart_index_oid);
+
+  // An object record is not bucket metadata.
+  std::string object_record;
+  S3MetadataEncoder encoder(object_record, S3MetadataRecord::object);
+  EXPECT_EQ(-1, action_under_test->from_json(object_record));
+}
+
 TEST_F(S3BucketMetadataV1Test, GetEncodedBucketAcl) {
   std::string json_str = "{\"ACL\":\"PD94bg==\"}";
 
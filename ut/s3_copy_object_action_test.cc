@@ -680,6 +680,236 @@ TEST_F(S3CopyObjectActionTest, ZeroSizeObject) {
   EXPECT_EQ(1, call_count_one);
 }
 
+TEST_F(S3CopyObjectActionTest, CanShareSourceData) {
+  auto option_instance = S3Option::get_instance();
+  option_instance->set_s3server_obj_delayed_del_enabled(true);
+  option_instance->set_s3server_copy_object_share_data_enabled(true);
+
+  action_under_test->total_data_to_stream = 0;
+  EXPECT_FALSE(action_under_test->can_share_source_data());
+
+  action_under_test->total_data_to_stream = 1024;
+  EXPECT_TRUE(action_under_test->can_share_source_data());
+
+  // Without delayed delete data is deleted right away, references or not.
+  option_instance->set_s3server_obj_delayed_del_enabled(false);
+  EXPECT_FALSE(action_under_test->can_share_source_data());
+  option_instance->set_s3server_obj_delayed_del_enabled(true);
+
+  option_instance->set_s3server_copy_object_share_data_enabled(false);
+  EXPECT_FALSE(action_under_test->can_share_source_data());
+}
+
+TEST_F(S3CopyObjectActionTest, CreateDestinationObjectSharesData) {
+  S3Option::get_instance()->set_s3server_copy_object_share_data_enabled(true);
+  struct m0_uint128 source_oid = {0x2ffff, 0x3ffff};
+  action_under_test->total_data_to_stream = 1024;
+  action_under_test->bucket_metadata =
+      ptr_mock_bucket_meta_factory->mock_bucket_metadata;
+  action_under_test->source_bucket_metadata =
+      ptr_mock_bucket_meta_factory->mock_bucket_metadata;
+  action_under_test->source_object_metadata =
+      ptr_mock_object_meta_factory->mock_object_metadata;
+
+  EXPECT_CALL(*(ptr_mock_bucket_meta_factory->mock_bucket_metadata),
+              get_object_list_index_oid())
+      .WillRepeatedly(Return(object_list_indx_oid));
+  EXPECT_CALL(*(ptr_mock_bucket_meta_factory->mock_bucket_metadata),
+              get_objects_version_list_index_oid())
+      .WillRepeatedly(Return(objects_version_list_idx_oid));
+  EXPECT_CALL(*ptr_mock_object_meta_factory->mock_object_metadata, get_oid())
+      .WillRepeatedly(Return(source_oid));
+  EXPECT_CALL(*ptr_mock_object_meta_factory->mock_object_metadata,
+              get_layout_id()).WillRepeatedly(Return(layout_id));
+  EXPECT_CALL(*ptr_mock_object_meta_factory->mock_object_metadata,
+              get_object_name())
+      .WillRepeatedly(Return(destination_object_name));
+  EXPECT_CALL(*ptr_mock_object_meta_factory->mock_object_metadata,
+              get_version_key_in_index())
+      .WillRepeatedly(Return(destination_object_name + "/1"));
+  EXPECT_CALL(*ptr_mock_object_meta_factory->mock_object_metadata,
+              set_oid(_)).Times(1);
+
+  // No motr object is created, references of the data are added first.
+  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer,
+              create_object(_, _, _)).Times(0);
+  EXPECT_CALL(*ptr_mock_motr_kvs_writer_factory->mock_motr_kvs_writer,
+              put_keyval(_, _, _, _)).Times(1);
+
+  action_under_test->create_destination_object();
+
+  EXPECT_TRUE(action_under_test->object_data_shared);
+  EXPECT_OID_EQ(source_oid, action_under_test->new_object_oid);
+  EXPECT_EQ(layout_id, action_under_test->layout_id);
+  EXPECT_FALSE(action_under_test->motr_writer);
+  // Probable delete record of source is not replaced.
+  EXPECT_EQ(S3M0Uint128Helper::to_string(source_oid) + "-" +
+                destination_object_name + "/1",
+            action_under_test->new_oid_str);
+  EXPECT_EQ(S3PutObjectActionState::empty,
+            action_under_test->s3_put_action_state);
+  S3Option::get_instance()->set_s3server_copy_object_share_data_enabled(false);
+}
+
+TEST_F(S3CopyObjectActionTest, AddObjectDataRefs) {
+  action_under_test->total_data_to_stream = 1024;
+  action_under_test->object_data_shared = true;
+  action_under_test->new_object_oid = oid;
+  action_under_test->layout_id = layout_id;
+  action_under_test->bucket_metadata =
+      ptr_mock_bucket_meta_factory->mock_bucket_metadata;
+  action_under_test->source_bucket_metadata =
+      ptr_mock_bucket_meta_factory->mock_bucket_metadata;
+  action_under_test->source_object_metadata =
+      ptr_mock_object_meta_factory->mock_object_metadata;
+  action_under_test->new_object_metadata =
+      ptr_mock_object_meta_factory->mock_object_metadata;
+
+  EXPECT_CALL(*(ptr_mock_bucket_meta_factory->mock_bucket_metadata),
+              get_object_list_index_oid())
+      .WillRepeatedly(Return(object_list_indx_oid));
+  EXPECT_CALL(*ptr_mock_object_meta_factory->mock_object_metadata,
+              get_object_name())
+      .WillRepeatedly(Return(destination_object_name));
+
+  // Data is not copied, its references are recorded instead.
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              read_object_data(_, _, _)).Times(0);
+  EXPECT_CALL(*ptr_mock_motr_kvs_writer_factory->mock_motr_kvs_writer,
+              put_keyval(_, _, _, _)).Times(1);
+
+  action_under_test->add_object_data_refs();
+}
+
+TEST_F(S3CopyObjectActionTest, CopyObjectOfSharedData) {
+  action_under_test->total_data_to_stream = 1024;
+  action_under_test->object_data_shared = true;
+
+  // Data is referred already, nothing is copied.
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              read_object_data(_, _, _)).Times(0);
+
+  action_under_test->clear_tasks();
+  ACTION_TASK_ADD_OBJPTR(action_under_test,
+                         S3CopyObjectActionTest::func_callback_one, this);
+  action_under_test->copy_object();
+
+  EXPECT_EQ(1, call_count_one);
+  EXPECT_EQ(S3PutObjectActionState::writeComplete,
+            action_under_test->s3_put_action_state);
+}
+
+TEST_F(S3CopyObjectActionTest, AddObjectDataRefsFailed) {
+  action_under_test->motr_kv_writer =
+      ptr_mock_motr_kvs_writer_factory->mock_motr_kvs_writer;
+
+  EXPECT_CALL(*ptr_mock_motr_kvs_writer_factory->mock_motr_kvs_writer,
+              get_state())
+      .WillRepeatedly(Return(S3MotrKVSWriterOpState::failed));
+  EXPECT_CALL(*ptr_mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
+  EXPECT_CALL(*ptr_mock_request, send_response(500, _)).Times(1);
+
+  action_under_test->add_object_data_refs_failed();
+
+  EXPECT_STREQ("InternalError", action_under_test->get_s3_error_code().c_str());
+  // No probable delete record was added, nothing is to be rolled back.
+  EXPECT_EQ(S3PutObjectActionState::newObjOidCreationFailed,
+            action_under_test->s3_put_action_state);
+}
+
+TEST_F(S3CopyObjectActionTest, CheckSourceObjectDataSuccess) {
+  action_under_test->new_object_oid = oid;
+  action_under_test->new_oid_str =
+      S3M0Uint128Helper::to_string(oid) + "-" + destination_object_name + "/1";
+  action_under_test->bucket_metadata =
+      ptr_mock_bucket_meta_factory->mock_bucket_metadata;
+  action_under_test->source_object_metadata =
+      ptr_mock_object_meta_factory->mock_object_metadata;
+  action_under_test->new_object_metadata =
+      ptr_mock_object_meta_factory->mock_object_metadata;
+
+  EXPECT_CALL(*ptr_mock_object_meta_factory->mock_object_metadata, get_oid())
+      .WillRepeatedly(Return(oid));
+  EXPECT_CALL(*ptr_mock_object_meta_factory->mock_object_metadata, get_md5())
+      .WillRepeatedly(Return("abcd1234abcd"));
+  EXPECT_CALL(*(ptr_mock_bucket_meta_factory->mock_bucket_metadata),
+              get_object_list_index_oid())
+      .WillRepeatedly(Return(object_list_indx_oid));
+  EXPECT_CALL(*(ptr_mock_bucket_meta_factory->mock_bucket_metadata),
+              get_objects_version_list_index_oid())
+      .WillRepeatedly(Return(objects_version_list_idx_oid));
+  EXPECT_CALL(*ptr_mock_object_meta_factory->mock_object_metadata,
+              get_object_name())
+      .WillRepeatedly(Return(destination_object_name));
+  EXPECT_CALL(*ptr_mock_object_meta_factory->mock_object_metadata,
+              get_version_key_in_index())
+      .WillRepeatedly(Return(destination_object_name + "/1"));
+
+  // Data is referred now, probable delete record of the copy is added.
+  EXPECT_CALL(*ptr_mock_motr_kvs_writer_factory->mock_motr_kvs_writer,
+              put_keyval(_, _, _, _)).Times(1);
+
+  action_under_test->check_source_object_data_success();
+
+  EXPECT_EQ(S3PutObjectActionState::newObjOidCreated,
+            action_under_test->s3_put_action_state);
+  EXPECT_EQ("abcd1234abcd", action_under_test->content_md5);
+}
+
+TEST_F(S3CopyObjectActionTest, CheckSourceObjectDataReplaced) {
+  struct m0_uint128 overwritten_oid = {0x2ffff, 0x3ffff};
+  action_under_test->new_object_oid = oid;
+  action_under_test->source_object_metadata =
+      ptr_mock_object_meta_factory->mock_object_metadata;
+
+  EXPECT_CALL(*ptr_mock_object_meta_factory->mock_object_metadata, get_oid())
+      .WillRepeatedly(Return(overwritten_oid));
+  EXPECT_CALL(*ptr_mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
+  EXPECT_CALL(*ptr_mock_request, send_response(500, _)).Times(1);
+
+  action_under_test->check_source_object_data_success();
+
+  EXPECT_STREQ("InternalError", action_under_test->get_s3_error_code().c_str());
+  EXPECT_EQ(S3PutObjectActionState::newObjOidCreationFailed,
+            action_under_test->s3_put_action_state);
+}
+
+TEST_F(S3CopyObjectActionTest, CheckSourceObjectDataMissing) {
+  action_under_test->source_object_metadata =
+      ptr_mock_object_meta_factory->mock_object_metadata;
+
+  EXPECT_CALL(*ptr_mock_object_meta_factory->mock_object_metadata, get_state())
+      .WillRepeatedly(Return(S3ObjectMetadataState::missing));
+  EXPECT_CALL(*ptr_mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
+  EXPECT_CALL(*ptr_mock_request, send_response(404, _)).Times(1);
+
+  action_under_test->check_source_object_data_failed();
+
+  EXPECT_STREQ("NoSuchKey", action_under_test->get_s3_error_code().c_str());
+}
+
+TEST_F(S3CopyObjectActionTest, SharedDataNotDeletedOnRollback) {
+  action_under_test->object_data_shared = true;
+  action_under_test->new_object_oid = oid;
+  action_under_test->new_oid_str =
+      S3M0Uint128Helper::to_string(oid) + "-" + destination_object_name + "/1";
+  action_under_test->s3_put_action_state =
+      S3PutObjectActionState::metadataSaveFailed;
+
+  // Record of the copy is removed rather than marked for forced deletion,
+  // and data is not deleted.
+  EXPECT_CALL(*ptr_mock_motr_kvs_writer_factory->mock_motr_kvs_writer,
+              put_keyval(_, _, _, _)).Times(0);
+  EXPECT_CALL(*ptr_mock_motr_kvs_writer_factory->mock_motr_kvs_writer,
+              delete_keyval(_, std::vector<std::string>{
+                                   action_under_test->new_oid_str},
+                            _, _)).Times(1);
+  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer,
+              delete_object(_, _, _)).Times(0);
+
+  action_under_test->startcleanup();
+}
+
 TEST_F(S3CopyObjectActionTest, SaveMetadata) {
   action_under_test->total_data_to_stream = 1024;
 
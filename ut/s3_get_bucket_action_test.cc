@@ -67,8 +67,8 @@ using ::testing::InSequence;
     EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),             \
                 get_key_values())                                             \
         .WillRepeatedly(ReturnRef(result_keys_values));                       \
-    EXPECT_CALL(*(object_meta_factory->mock_object_metadata), from_json(_))   \
-        .WillRepeatedly(Return(0));                                           \
+    EXPECT_CALL(*(object_meta_factory->mock_object_metadata),                 \
+                from_listing_json(_)).WillRepeatedly(Return(0));              \
     EXPECT_CALL(*(object_meta_factory->mock_object_metadata),                 \
                 get_content_length_str()).WillRepeatedly(Return("0"));        \
     EXPECT_CALL(*(bucket_meta_factory->mock_bucket_metadata), get_state())    \
@@ -264,7 +264,8 @@ TEST_F(S3GetBucketActionTest, GetNextObjectsSuccessful) {
 
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
               get_key_values()).WillRepeatedly(ReturnRef(result_keys_values));
-  EXPECT_CALL(*(object_meta_factory->mock_object_metadata), from_json(_))
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              from_listing_json(_))
       .WillRepeatedly(Return(0));
   EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
               get_content_length_str())
@@ -303,7 +304,8 @@ TEST_F(S3GetBucketActionTest, GetNextObjectsSuccessfulJsonError) {
 
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
               get_key_values()).WillRepeatedly(ReturnRef(result_keys_values));
-  EXPECT_CALL(*(object_meta_factory->mock_object_metadata), from_json(_))
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              from_listing_json(_))
       .WillRepeatedly(Return(-1));
   EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
               get_content_length_str())
@@ -409,8 +411,8 @@ TEST_F(S3GetBucketActionTest, GetNextObjectsSuccessfulDelimiterLastKey) {
   OBJ_METADATA_EXPECTATIONS;
   SET_NEXT_OBJ_SUCCESSFUL_EXPECTATIONS;
 
-  action_under_test_ptr->max_record_count =
-      S3Option::get_instance()->get_motr_idx_fetch_count();
+  // Full batch, ending within the common prefix
+  action_under_test_ptr->max_record_count = result_keys_values.size();
 
   action_under_test_ptr->get_next_objects_successful();
   EXPECT_EQ(0, action_under_test_ptr->object_list->size());
@@ -418,6 +420,82 @@ TEST_F(S3GetBucketActionTest, GetNextObjectsSuccessfulDelimiterLastKey) {
   EXPECT_EQ("test/\xff", action_under_test_ptr->last_key);
 }
 
+// Keys of a common prefix are rolled up within the batch, without asking
+// Motr for the keys after it.
+TEST_F(S3GetBucketActionTest, GetNextObjectsSuccessfulDelimiterSkipsInBatch) {
+  CREATE_ACTION_UNDER_TEST_OBJ;
+  CREATE_BUCKET_METADATA_OBJ;
+  CREATE_KVS_READER_OBJ;
+
+  action_under_test_ptr->request_delimiter.assign("/");
+  action_under_test_ptr->max_keys = 1000;
+  result_keys_values.insert(
+      std::make_pair("dir/key1", std::make_pair(10, "keyval")));
+  result_keys_values.insert(
+      std::make_pair("dir/key2", std::make_pair(10, "keyval")));
+  result_keys_values.insert(
+      std::make_pair("dirkey", std::make_pair(10, "keyval")));
+  result_keys_values.insert(
+      std::make_pair("other/key1", std::make_pair(10, "keyval")));
+  result_keys_values.insert(
+      std::make_pair("other/key2", std::make_pair(10, "keyval")));
+
+  OBJ_METADATA_EXPECTATIONS;
+  SET_NEXT_OBJ_SUCCESSFUL_EXPECTATIONS;
+  EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
+              next_keyval(_, _, _, _, _, _)).Times(0);
+
+  action_under_test_ptr->max_record_count = result_keys_values.size() + 1;
+  action_under_test_ptr->get_next_objects_successful();
+  EXPECT_EQ(1, action_under_test_ptr->object_list->size());
+  EXPECT_EQ(2, action_under_test_ptr->object_list->common_prefixes_size());
+  EXPECT_FALSE(action_under_test_ptr->object_list->is_response_truncated());
+}
+
+// Listing has max_keys entries when the batch ends within a common prefix:
+// only the keys past the prefix decide whether the response is truncated.
+TEST_F(S3GetBucketActionTest, GetNextObjectsSuccessfulDelimiterSeekTruncated) {
+  CREATE_ACTION_UNDER_TEST_OBJ;
+  CREATE_BUCKET_METADATA_OBJ;
+  CREATE_KVS_READER_OBJ;
+  EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader), get_state())
+      .WillRepeatedly(Return(S3MotrKVSReaderOpState::present));
+  EXPECT_CALL(*bucket_meta_factory->mock_bucket_metadata,
+              get_object_list_index_oid())
+      .WillRepeatedly(Return(object_list_indx_oid));
+
+  action_under_test_ptr->request_delimiter.assign("/");
+  action_under_test_ptr->max_keys = 1;
+  result_keys_values.insert(
+      std::make_pair("dir/key1", std::make_pair(10, "keyval")));
+  result_keys_values.insert(
+      std::make_pair("dir/key2", std::make_pair(10, "keyval")));
+  std::map<std::string, std::pair<int, std::string>> result_next_keys_values;
+  result_next_keys_values.insert(
+      std::make_pair("other", std::make_pair(10, "keyval")));
+
+  OBJ_METADATA_EXPECTATIONS;
+  SET_NEXT_OBJ_SUCCESSFUL_EXPECTATIONS;
+  {
+    InSequence s;
+    EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
+                get_key_values()).WillOnce(ReturnRef(result_keys_values));
+    EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
+                get_key_values()).WillOnce(ReturnRef(result_next_keys_values));
+  }
+  EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
+              next_keyval(_, std::string("dir/\xff"), _, _, _, _))
+      .WillOnce(InvokeWithoutArgs(
+           this, &S3GetBucketActionTest::call_next_keyval_successful));
+
+  action_under_test_ptr->max_record_count = result_keys_values.size();
+  action_under_test_ptr->get_next_objects_successful();
+  EXPECT_EQ(0, action_under_test_ptr->object_list->size());
+  EXPECT_EQ(1, action_under_test_ptr->object_list->common_prefixes_size());
+  EXPECT_TRUE(action_under_test_ptr->object_list->is_response_truncated());
+  EXPECT_EQ("dir/", action_under_test_ptr->object_list->get_next_marker_key());
+}
+
 // Prefix in multi-component object names
 TEST_F(S3GetBucketActionTest, GetNextObjectsSuccessfulMultiComponentKey) {
   CREATE_ACTION_UNDER_TEST_OBJ;
@@ -425,11 +503,9 @@ TEST_F(S3GetBucketActionTest, GetNextObjectsSuccessfulMultiComponentKey) {
   CREATE_KVS_READER_OBJ;
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader), get_state())
       .WillRepeatedly(Return(S3MotrKVSReaderOpState::present));
+  // Keys under "boo/" and "cquux/" are rolled up within the batch.
   EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
-              next_keyval(_, _, _, _, _, _))
-      .Times(AtLeast(1))
-      .WillRepeatedly(InvokeWithoutArgs(
-           this, &S3GetBucketActionTest::call_next_keyval_successful));
+              next_keyval(_, _, _, _, _, _)).Times(0);
   EXPECT_CALL(*bucket_meta_factory->mock_bucket_metadata,
               get_object_list_index_oid())
       .WillRepeatedly(Return(object_list_indx_oid));
@@ -446,35 +522,16 @@ TEST_F(S3GetBucketActionTest, GetNextObjectsSuccessfulMultiComponentKey) {
       std::make_pair("cquux/thud", std::make_pair(0, "keyval")));
   result_keys_values.insert(
       std::make_pair("cquux/bla", std::make_pair(0, "keyval")));
-  // last_key:= boo/\xff
-  std::map<std::string, std::pair<int, std::string>> result_next_keys_values;
-  result_next_keys_values.insert(
-      std::make_pair("cquux/thud", std::make_pair(0, "keyval")));
-  result_next_keys_values.insert(
-      std::make_pair("cquux/bla", std::make_pair(0, "keyval")));
-  // last_key:= cquux/\xff
-  std::map<std::string, std::pair<int, std::string>>
-      result_next_keys_values_empty;
 
   OBJ_METADATA_EXPECTATIONS;
   SET_NEXT_OBJ_SUCCESSFUL_EXPECTATIONS;
-  // Override get_key_values(), as below:
-  {
-    InSequence s;
-    EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
-                get_key_values()).WillOnce(ReturnRef(result_keys_values));
-    EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
-                get_key_values()).WillOnce(ReturnRef(result_next_keys_values));
-    EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
-                get_key_values())
-        .WillOnce(ReturnRef(result_next_keys_values_empty));
-  }
 
   action_under_test_ptr->max_record_count =
       S3Option::get_instance()->get_motr_idx_fetch_count();
   action_under_test_ptr->get_next_objects_successful();
   EXPECT_EQ(0, action_under_test_ptr->object_list->size());
   EXPECT_EQ(1, action_under_test_ptr->object_list->common_prefixes_size());
+  EXPECT_FALSE(action_under_test_ptr->object_list->is_response_truncated());
   // Ensure that common prefixes contain "cquux/"
   std::set<std::string> common_prexes =
       action_under_test_ptr->object_list->get_common_prefixes();
@@ -694,6 +751,21 @@ TEST_F(S3GetBucketActionTest, SendResponseToClientSuccess) {
   action_under_test_ptr->send_response_to_s3_client();
 }
 
+TEST_F(S3GetBucketActionTest, SendResponseToClientSuccessStreaming) {
+  CREATE_ACTION_UNDER_TEST_OBJ;
+  CREATE_BUCKET_METADATA_OBJ;
+
+  action_under_test_ptr->object_list->enable_streaming(
+      "qWwZGnGYTga8gbpcuY79SA", "1", "1");
+  action_under_test_ptr->fetch_successful = true;
+  EXPECT_CALL(*request_mock, set_out_header_value(_, _)).Times(AtLeast(1));
+  EXPECT_CALL(*request_mock, send_reply_chunk_start(200)).Times(1);
+  EXPECT_CALL(*request_mock, send_reply_chunk(_, _)).Times(AtLeast(1));
+  EXPECT_CALL(*request_mock, send_reply_chunk_end()).Times(1);
+  EXPECT_CALL(*request_mock, send_response(_, _)).Times(0);
+  action_under_test_ptr->send_response_to_s3_client();
+}
+
 TEST_F(S3GetBucketActionTest, SendResponseToClientInternalError) {
   CREATE_ACTION_UNDER_TEST_OBJ;
   CREATE_BUCKET_METADATA_OBJ;
@@ -66,8 +66,8 @@ using ::testing::_;
     EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),             \
                 get_key_values())                                             \
         .WillRepeatedly(ReturnRef(result_keys_values));                       \
-    EXPECT_CALL(*(object_meta_factory->mock_object_metadata), from_json(_))   \
-        .WillRepeatedly(Return(0));                                           \
+    EXPECT_CALL(*(object_meta_factory->mock_object_metadata),                 \
+                from_listing_json(_)).WillRepeatedly(Return(0));              \
     EXPECT_CALL(*(object_meta_factory->mock_object_metadata),                 \
                 get_content_length_str()).WillRepeatedly(Return("0"));        \
     EXPECT_CALL(*(bucket_meta_factory->mock_bucket_metadata), get_state())    \
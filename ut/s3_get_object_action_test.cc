@@ -19,6 +19,7 @@
  */
 
 #include <memory>
+#include <vector>
 
 #include "mock_s3_factory.h"
 #include "s3_motr_layout.h"
@@ -134,9 +135,45 @@ class S3GetObjectActionTest : public testing::Test {
 
   int call_count_one;
   std::string bucket_name, object_name;
+  // Motr read buffer handed out by mock reader, never released in tests
+  char data_block[1];
+  // Motr read callbacks held back by the mock to keep reads in flight
+  std::vector<std::function<void(void)>> pending_read_success;
+  std::vector<std::function<void(void)>> pending_read_failed;
 
  public:
   void func_callback_one() { call_count_one += 1; }
+
+  bool defer_read_object_data(size_t num_of_blocks,
+                              std::function<void(void)> on_success,
+                              std::function<void(void)> on_failed) {
+    pending_read_success.push_back(on_success);
+    pending_read_failed.push_back(on_failed);
+    return true;
+  }
+
+  // Object of 'num_of_units' units, read one unit per motr request.
+  void setup_read_ahead_object(size_t num_of_units) {
+    int layout_id = 1;
+    size_t unit_size =
+        S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(layout_id);
+    size_t obj_size = unit_size * num_of_units;
+
+    EXPECT_CALL(*(object_meta_factory->mock_object_metadata), get_oid())
+        .WillRepeatedly(Return(oid));
+    EXPECT_CALL(*(object_meta_factory->mock_object_metadata), get_layout_id())
+        .WillRepeatedly(Return(layout_id));
+    EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+                get_content_length()).WillRepeatedly(Return(obj_size));
+    action_under_test->object_metadata =
+        object_meta_factory->create_object_metadata_obj(ptr_mock_request,
+                                                        object_list_indx_oid);
+    action_under_test->content_length = obj_size;
+    action_under_test->first_byte_offset_to_read = 0;
+    action_under_test->last_byte_offset_to_read = obj_size - 1;
+    action_under_test->read_ahead_max_depth = 2;
+    action_under_test->read_ahead_depth = 2;
+  }
 };
 
 TEST_F(S3GetObjectActionTest, ConstructorTest) {
@@ -889,11 +926,12 @@ TEST_F(S3GetObjectActionTest, ReadObjectOfSizeLessThanUnitSize) {
 
   EXPECT_CALL(*ptr_mock_request, send_reply_start(Eq(S3HttpSuccess200)))
       .Times(AtLeast(1));
-  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), get_first_block(_))
-      .WillOnce(Return(obj_size));
-  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), get_next_block(_))
-      .WillOnce(Return(0));
-  EXPECT_CALL(*ptr_mock_request, send_reply_body(_, Eq(obj_size))).Times(1);
+  S3BufferSequence blocks_read{{data_block, obj_size}};
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), extract_blocks_read())
+      .WillOnce(Return(blocks_read));
+  EXPECT_CALL(*ptr_mock_request,
+              send_reply_body_by_ref(Eq(data_block), Eq(obj_size), _, _))
+      .Times(1);
   EXPECT_CALL(*ptr_mock_request, send_reply_end()).Times(1);
 
   EXPECT_CALL(*(motr_reader_factory->mock_motr_reader),
@@ -947,11 +985,12 @@ TEST_F(S3GetObjectActionTest, ReadObjectOfSizeEqualToUnitSize) {
 
   EXPECT_CALL(*ptr_mock_request, send_reply_start(Eq(S3HttpSuccess200)))
       .Times(AtLeast(1));
-  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), get_first_block(_))
-      .WillOnce(Return(obj_size));
-  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), get_next_block(_))
-      .WillOnce(Return(0));
-  EXPECT_CALL(*ptr_mock_request, send_reply_body(_, Eq(obj_size))).Times(1);
+  S3BufferSequence blocks_read{{data_block, obj_size}};
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), extract_blocks_read())
+      .WillOnce(Return(blocks_read));
+  EXPECT_CALL(*ptr_mock_request,
+              send_reply_body_by_ref(Eq(data_block), Eq(obj_size), _, _))
+      .Times(1);
   EXPECT_CALL(*ptr_mock_request, send_reply_end()).Times(1);
 
   EXPECT_CALL(*(motr_reader_factory->mock_motr_reader),
@@ -1006,14 +1045,13 @@ TEST_F(S3GetObjectActionTest, ReadObjectOfSizeMoreThanUnitSize) {
 
   EXPECT_CALL(*ptr_mock_request, send_reply_start(Eq(S3HttpSuccess200)))
       .Times(AtLeast(1));
-  EXPECT_CALL(*ptr_mock_request, send_reply_body(_, Eq(1)));
-  EXPECT_CALL(*ptr_mock_request, send_reply_body(_, Eq(obj_size - 1)));
+  EXPECT_CALL(*ptr_mock_request, send_reply_body_by_ref(_, Eq(1), _, _));
+  EXPECT_CALL(*ptr_mock_request,
+              send_reply_body_by_ref(_, Eq(obj_size - 1), _, _));
   EXPECT_CALL(*ptr_mock_request, send_reply_end()).Times(1);
-  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), get_first_block(_))
-      .WillOnce(Return(obj_size - 1));
-  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), get_next_block(_))
-      .WillOnce(Return(1))
-      .WillOnce(Return(0));
+  S3BufferSequence blocks_read{{data_block, obj_size - 1}, {data_block, 1}};
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), extract_blocks_read())
+      .WillOnce(Return(blocks_read));
 
   EXPECT_CALL(*(motr_reader_factory->mock_motr_reader),
               read_object_data(_, _, _))
@@ -1069,14 +1107,13 @@ TEST_F(S3GetObjectActionTest, ReadObjectOfGivenRange) {
 
   EXPECT_CALL(*ptr_mock_request, send_reply_start(Eq(S3HttpSuccess206)))
       .Times(AtLeast(1));
-  EXPECT_CALL(*ptr_mock_request, send_reply_body(_, Eq(1)));
-  EXPECT_CALL(*ptr_mock_request, send_reply_body(_, Eq(obj_size - 1)));
+  EXPECT_CALL(*ptr_mock_request, send_reply_body_by_ref(_, Eq(1), _, _));
+  EXPECT_CALL(*ptr_mock_request,
+              send_reply_body_by_ref(_, Eq(obj_size - 1), _, _));
   EXPECT_CALL(*ptr_mock_request, send_reply_end()).Times(1);
-  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), get_first_block(_))
-      .WillOnce(Return(obj_size - 1));
-  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), get_next_block(_))
-      .WillOnce(Return(1))
-      .WillOnce(Return(0));
+  S3BufferSequence blocks_read{{data_block, obj_size - 1}, {data_block, 1}};
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), extract_blocks_read())
+      .WillOnce(Return(blocks_read));
 
   EXPECT_CALL(*(motr_reader_factory->mock_motr_reader),
               read_object_data(_, _, _))
@@ -1089,6 +1126,323 @@ TEST_F(S3GetObjectActionTest, ReadObjectOfGivenRange) {
   action_under_test->read_object();
 }
 
+TEST_F(S3GetObjectActionTest, ReadObjectWithReadAheadDepthTwo) {
+  setup_read_ahead_object(3);
+  size_t unit_size = S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
+      action_under_test->object_metadata->get_layout_id());
+
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader),
+              read_object_data(Eq(1), _, _))
+      .Times(3)
+      .WillRepeatedly(
+          Invoke(this, &S3GetObjectActionTest::defer_read_object_data));
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), set_last_index(_))
+      .Times(AtLeast(3));
+  S3BufferSequence blocks_read{{data_block, unit_size}};
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), extract_blocks_read())
+      .Times(3)
+      .WillRepeatedly(Return(blocks_read));
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), get_state())
+      .WillRepeatedly(Return(S3MotrReaderOpState::success));
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              get_last_modified_gmt())
+      .WillOnce(Return("Sunday, 29 January 2017 08:05:01 GMT"));
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata), get_md5())
+      .WillOnce(Return("abcd1234abcd"));
+  std::map<std::string, std::string> meta_map;
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              get_user_attributes()).WillOnce(ReturnRef(meta_map));
+  EXPECT_CALL(*ptr_mock_request, get_header_value("Range")).Times(1);
+  EXPECT_CALL(*ptr_mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
+  EXPECT_CALL(*ptr_mock_request, send_reply_start(Eq(S3HttpSuccess200)))
+      .Times(1);
+  EXPECT_CALL(*ptr_mock_request, get_pending_reply_body_length())
+      .WillRepeatedly(Return(0));
+
+  EXPECT_CALL(*ptr_mock_request,
+              send_reply_body_by_ref(_, Eq(unit_size), _, _)).Times(3);
+  EXPECT_CALL(*ptr_mock_request, send_reply_end()).Times(1);
+
+  action_under_test->read_object();
+  EXPECT_EQ(2, pending_read_success.size());
+  EXPECT_EQ(2, action_under_test->reads_in_flight);
+
+  // Second read completes first, its data waits for the first read and
+  // the freed slot launches the last read.
+  pending_read_success[1]();
+  EXPECT_EQ(0, action_under_test->data_sent_to_client);
+  EXPECT_EQ(3, pending_read_success.size());
+  EXPECT_EQ(2, action_under_test->reads_in_flight);
+
+  // Both completed reads are sent in order.
+  pending_read_success[0]();
+  EXPECT_EQ(2 * unit_size, action_under_test->data_sent_to_client);
+  EXPECT_EQ(1, action_under_test->reads_in_flight);
+
+  pending_read_success[2]();
+  EXPECT_EQ(3 * unit_size, action_under_test->data_sent_to_client);
+  EXPECT_EQ(0, action_under_test->reads_in_flight);
+}
+
+TEST_F(S3GetObjectActionTest, ReadAheadDepthGrowsWhenClientDrains) {
+  setup_read_ahead_object(3);
+  action_under_test->read_ahead_max_depth = 3;
+  action_under_test->read_ahead_depth = 1;
+
+  EXPECT_CALL(*ptr_mock_request, get_pending_reply_body_length())
+      .WillRepeatedly(Return(0));
+
+  action_under_test->adjust_read_ahead_depth();
+  EXPECT_EQ(2, action_under_test->read_ahead_depth);
+  action_under_test->adjust_read_ahead_depth();
+  EXPECT_EQ(3, action_under_test->read_ahead_depth);
+  action_under_test->adjust_read_ahead_depth();
+  EXPECT_EQ(3, action_under_test->read_ahead_depth);
+}
+
+TEST_F(S3GetObjectActionTest, ReadAheadDepthShrinksWhenClientIsSlow) {
+  setup_read_ahead_object(3);
+  size_t unit_size = S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
+      action_under_test->object_metadata->get_layout_id());
+  action_under_test->read_ahead_max_depth = 4;
+  action_under_test->read_ahead_depth = 4;
+
+  EXPECT_CALL(*ptr_mock_request, get_pending_reply_body_length())
+      .WillRepeatedly(Return(8 * unit_size));
+
+  action_under_test->adjust_read_ahead_depth();
+  EXPECT_EQ(2, action_under_test->read_ahead_depth);
+  action_under_test->adjust_read_ahead_depth();
+  EXPECT_EQ(1, action_under_test->read_ahead_depth);
+  action_under_test->adjust_read_ahead_depth();
+  EXPECT_EQ(1, action_under_test->read_ahead_depth);
+}
+
+TEST_F(S3GetObjectActionTest, ReadAheadFailureWaitsForReadsInFlight) {
+  setup_read_ahead_object(3);
+
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader),
+              read_object_data(_, _, _))
+      .Times(2)
+      .WillRepeatedly(
+          Invoke(this, &S3GetObjectActionTest::defer_read_object_data));
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), set_last_index(_))
+      .Times(AtLeast(2));
+  EXPECT_CALL(*ptr_mock_request, send_reply_body_by_ref(_, _, _, _)).Times(0);
+  EXPECT_CALL(*ptr_mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
+  EXPECT_CALL(*ptr_mock_request, send_response(500, _)).Times(1);
+
+  action_under_test->read_object();
+  EXPECT_EQ(2, pending_read_failed.size());
+
+  // No response while the second read is still in flight.
+  pending_read_failed[0]();
+  EXPECT_TRUE(action_under_test->read_failed);
+  EXPECT_TRUE(action_under_test->get_s3_error_code().empty());
+
+  pending_read_success[1]();
+  EXPECT_STREQ("InternalError", action_under_test->get_s3_error_code().c_str());
+  EXPECT_EQ(0, action_under_test->reads_in_flight);
+}
+
+TEST_F(S3GetObjectActionTest, ReadObjectWrittenToPartSlots) {
+  setup_read_ahead_object(1);
+  size_t unit_size = S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
+      action_under_test->object_metadata->get_layout_id());
+  // Part 1 of 'unit_size + 10' bytes and part 2 of 5 bytes in slot of
+  // '4 * unit_size' bytes.
+  action_under_test->object_metadata->set_extents(
+      {{0, unit_size + 10}, {4 * unit_size, 5}});
+  action_under_test->content_length = unit_size + 15;
+  action_under_test->last_byte_offset_to_read = unit_size + 14;
+
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader),
+              read_object_data(Eq(1), _, _))
+      .Times(3)
+      .WillRepeatedly(
+          Invoke(this, &S3GetObjectActionTest::defer_read_object_data));
+  // Read of part 1 stops at its end, part 2 is read from its slot.
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), set_last_index(Eq(0)))
+      .Times(1);
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader),
+              set_last_index(Eq(unit_size))).Times(1);
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader),
+              set_last_index(Eq(4 * unit_size))).Times(1);
+  S3BufferSequence blocks_read{{data_block, unit_size}};
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), extract_blocks_read())
+      .Times(3)
+      .WillRepeatedly(Return(blocks_read));
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), get_state())
+      .WillRepeatedly(Return(S3MotrReaderOpState::success));
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              get_last_modified_gmt())
+      .WillOnce(Return("Sunday, 29 January 2017 08:05:01 GMT"));
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata), get_md5())
+      .WillOnce(Return("abcd1234abcd"));
+  std::map<std::string, std::string> meta_map;
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              get_user_attributes()).WillOnce(ReturnRef(meta_map));
+  EXPECT_CALL(*ptr_mock_request, get_header_value("Range")).Times(1);
+  EXPECT_CALL(*ptr_mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
+  EXPECT_CALL(*ptr_mock_request, send_reply_start(Eq(S3HttpSuccess200)))
+      .Times(1);
+  EXPECT_CALL(*ptr_mock_request, get_pending_reply_body_length())
+      .WillRepeatedly(Return(0));
+
+  EXPECT_CALL(*ptr_mock_request,
+              send_reply_body_by_ref(_, Eq(unit_size), _, _)).Times(1);
+  EXPECT_CALL(*ptr_mock_request, send_reply_body_by_ref(_, Eq(10), _, _))
+      .Times(1);
+  EXPECT_CALL(*ptr_mock_request, send_reply_body_by_ref(_, Eq(5), _, _))
+      .Times(1);
+  EXPECT_CALL(*ptr_mock_request, send_reply_end()).Times(1);
+
+  action_under_test->read_object();
+  EXPECT_EQ(3, action_under_test->total_blocks_to_read);
+  ASSERT_EQ(2, pending_read_success.size());
+
+  pending_read_success[0]();
+  pending_read_success[1]();
+  ASSERT_EQ(3, pending_read_success.size());
+  pending_read_success[2]();
+  EXPECT_EQ(unit_size + 15, action_under_test->data_sent_to_client);
+  EXPECT_EQ(0, action_under_test->reads_in_flight);
+}
+
+TEST_F(S3GetObjectActionTest, ReadRangeOfObjectWrittenToPartSlots) {
+  setup_read_ahead_object(1);
+  size_t unit_size = S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(
+      action_under_test->object_metadata->get_layout_id());
+  action_under_test->object_metadata->set_extents(
+      {{0, unit_size + 10}, {4 * unit_size, 5}});
+  action_under_test->content_length = unit_size + 15;
+  // Last 10 bytes of part 1 and first 3 bytes of part 2.
+  action_under_test->first_byte_offset_to_read = unit_size;
+  action_under_test->last_byte_offset_to_read = unit_size + 12;
+
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader),
+              read_object_data(Eq(1), _, _))
+      .Times(2)
+      .WillRepeatedly(
+          Invoke(this, &S3GetObjectActionTest::defer_read_object_data));
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader),
+              set_last_index(Eq(unit_size))).Times(1);
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader),
+              set_last_index(Eq(4 * unit_size))).Times(1);
+  S3BufferSequence blocks_read{{data_block, unit_size}};
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), extract_blocks_read())
+      .Times(2)
+      .WillRepeatedly(Return(blocks_read));
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader), get_state())
+      .WillRepeatedly(Return(S3MotrReaderOpState::success));
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              get_last_modified_gmt())
+      .WillOnce(Return("Sunday, 29 January 2017 08:05:01 GMT"));
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata), get_md5())
+      .WillOnce(Return("abcd1234abcd"));
+  std::map<std::string, std::string> meta_map;
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              get_user_attributes()).WillOnce(ReturnRef(meta_map));
+  EXPECT_CALL(*ptr_mock_request, get_header_value("Range"))
+      .WillRepeatedly(Return("bytes=1048576-1048588"));
+  EXPECT_CALL(*ptr_mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
+  EXPECT_CALL(*ptr_mock_request, send_reply_start(Eq(S3HttpSuccess206)))
+      .Times(1);
+  EXPECT_CALL(*ptr_mock_request, get_pending_reply_body_length())
+      .WillRepeatedly(Return(0));
+
+  EXPECT_CALL(*ptr_mock_request, send_reply_body_by_ref(_, Eq(10), _, _))
+      .Times(1);
+  EXPECT_CALL(*ptr_mock_request, send_reply_body_by_ref(_, Eq(3), _, _))
+      .Times(1);
+  EXPECT_CALL(*ptr_mock_request, send_reply_end()).Times(1);
+
+  action_under_test->read_object();
+  EXPECT_EQ(2, action_under_test->total_blocks_to_read);
+  ASSERT_EQ(2, pending_read_success.size());
+
+  pending_read_success[1]();
+  pending_read_success[0]();
+  EXPECT_EQ(13, action_under_test->data_sent_to_client);
+  EXPECT_EQ(0, action_under_test->reads_in_flight);
+}
+
+TEST_F(S3GetObjectActionTest, ReadInlineObject) {
+  std::string data = "inline data";
+  std::string data_sent;
+  std::map<std::string, std::string> meta_map;
+
+  action_under_test->object_metadata =
+      object_meta_factory->create_object_metadata_obj(ptr_mock_request,
+                                                      object_list_indx_oid);
+  action_under_test->object_metadata->set_inline_data(data);
+  action_under_test->content_length = data.length();
+  action_under_test->first_byte_offset_to_read = 0;
+  action_under_test->last_byte_offset_to_read = data.length() - 1;
+
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              get_content_length()).WillRepeatedly(Return(data.length()));
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata), get_md5())
+      .WillOnce(Return("abcd1234abcd"));
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              get_last_modified_gmt())
+      .WillOnce(Return("Sunday, 29 January 2017 08:05:01 GMT"));
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              get_user_attributes()).WillOnce(ReturnRef(meta_map));
+  EXPECT_CALL(*ptr_mock_request, get_header_value("Range"))
+      .WillOnce(Return(""));
+  EXPECT_CALL(*ptr_mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
+  EXPECT_CALL(*ptr_mock_request, send_reply_start(Eq(S3HttpSuccess200)))
+      .Times(1);
+  EXPECT_CALL(*ptr_mock_request, send_reply_body(_, _))
+      .WillOnce(Invoke([&data_sent](const char *buf, int len) {
+        data_sent.assign(buf, len);
+      }));
+  EXPECT_CALL(*ptr_mock_request, send_reply_end()).Times(1);
+  EXPECT_CALL(*(motr_reader_factory->mock_motr_reader),
+              read_object_data(_, _, _)).Times(0);
+
+  action_under_test->read_object();
+  EXPECT_EQ(data, data_sent);
+}
+
+TEST_F(S3GetObjectActionTest, ReadRangeOfInlineObject) {
+  std::string data = "inline data";
+  std::string data_sent;
+  std::map<std::string, std::string> meta_map;
+
+  action_under_test->object_metadata =
+      object_meta_factory->create_object_metadata_obj(ptr_mock_request,
+                                                      object_list_indx_oid);
+  action_under_test->object_metadata->set_inline_data(data);
+  action_under_test->content_length = data.length();
+  action_under_test->first_byte_offset_to_read = 2;
+  action_under_test->last_byte_offset_to_read = 5;
+
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              get_content_length()).WillRepeatedly(Return(data.length()));
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata), get_md5())
+      .WillOnce(Return("abcd1234abcd"));
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              get_last_modified_gmt())
+      .WillOnce(Return("Sunday, 29 January 2017 08:05:01 GMT"));
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              get_user_attributes()).WillOnce(ReturnRef(meta_map));
+  EXPECT_CALL(*ptr_mock_request, get_header_value("Range"))
+      .WillOnce(Return("bytes=2-5"));
+  EXPECT_CALL(*ptr_mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
+  EXPECT_CALL(*ptr_mock_request, send_reply_start(Eq(S3HttpSuccess206)))
+      .Times(1);
+  EXPECT_CALL(*ptr_mock_request, send_reply_body(_, _))
+      .WillOnce(Invoke([&data_sent](const char *buf, int len) {
+        data_sent.assign(buf, len);
+      }));
+  EXPECT_CALL(*ptr_mock_request, send_reply_end()).Times(1);
+
+  action_under_test->read_object();
+  EXPECT_EQ("line", data_sent);
+}
+
 TEST_F(S3GetObjectActionTest, ReadObjectFailedJustEndResponse1) {
   EXPECT_CALL(*ptr_mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
   EXPECT_CALL(*ptr_mock_request, send_response(_, _)).Times(1);
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "s3_hash_worker_pool.h"
+#include "s3_md5_mb.h"
+
+class S3HashWorkerPoolTest : public testing::Test {
+ protected:
+  void SetUp() { ASSERT_EQ(0, S3HashWorkerPool::create_pool(2)); }
+
+  void TearDown() { S3HashWorkerPool::destroy_instance(); }
+};
+
+TEST_F(S3HashWorkerPoolTest, CreateAndDestroyPool) {
+  ASSERT_TRUE(S3HashWorkerPool::get_instance() != NULL);
+  EXPECT_EQ(2u, S3HashWorkerPool::get_instance()->workers.size());
+  EXPECT_EQ(EEXIST, S3HashWorkerPool::create_pool(2));
+
+  S3HashWorkerPool::destroy_instance();
+  EXPECT_TRUE(S3HashWorkerPool::get_instance() == NULL);
+  EXPECT_EQ(EINVAL, S3HashWorkerPool::create_pool(0));
+  EXPECT_TRUE(S3HashWorkerPool::get_instance() == NULL);
+}
+
+TEST_F(S3HashWorkerPoolTest, StreamJobsRunInSubmitOrder) {
+  std::shared_ptr<S3HashStream> stream =
+      S3HashWorkerPool::get_instance()->create_stream();
+  std::vector<int> order;
+
+  for (int i = 0; i < 1000; ++i) {
+    stream->submit([&order, i]() { order.push_back(i); });
+  }
+  stream->wait();
+
+  EXPECT_TRUE(stream->is_idle());
+  ASSERT_EQ(1000u, order.size());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(i, order[i]);
+  }
+}
+
+TEST_F(S3HashWorkerPoolTest, StreamsAreSpreadOverWorkers) {
+  std::shared_ptr<S3HashStream> stream1 =
+      S3HashWorkerPool::get_instance()->create_stream();
+  std::shared_ptr<S3HashStream> stream2 =
+      S3HashWorkerPool::get_instance()->create_stream();
+
+  EXPECT_NE(stream1->worker, stream2->worker);
+}
+
+TEST_F(S3HashWorkerPoolTest, NotifyWhenIdleCallsBackRightAwayIfIdle) {
+  std::shared_ptr<S3HashStream> stream =
+      S3HashWorkerPool::get_instance()->create_stream();
+  bool called = false;
+
+  stream->notify_when_idle([&called]() { called = true; });
+
+  EXPECT_TRUE(called);
+}
+
+TEST_F(S3HashWorkerPoolTest, NotifyWhenIdleCallsBackAfterPendingJobs) {
+  std::shared_ptr<S3HashStream> stream =
+      S3HashWorkerPool::get_instance()->create_stream();
+  std::promise<void> job_may_run;
+  std::shared_future<void> job_go = job_may_run.get_future().share();
+  std::promise<int> idle;
+  std::future<int> idle_seen = idle.get_future();
+  int jobs_done = 0;
+
+  stream->submit([job_go, &jobs_done]() {
+    job_go.wait();
+    ++jobs_done;
+  });
+  stream->submit([&jobs_done]() { ++jobs_done; });
+  stream->notify_when_idle(
+      [&idle, &jobs_done]() { idle.set_value(jobs_done); });
+  EXPECT_FALSE(stream->is_idle());
+
+  job_may_run.set_value();
+  ASSERT_EQ(std::future_status::ready,
+            idle_seen.wait_for(std::chrono::seconds(10)));
+  EXPECT_EQ(2, idle_seen.get());
+}
+
+TEST_F(S3HashWorkerPoolTest, CancelDropsCallbackAndWaitsForJobs) {
+  std::shared_ptr<S3HashStream> stream =
+      S3HashWorkerPool::get_instance()->create_stream();
+  std::promise<void> job_may_run;
+  std::shared_future<void> job_go = job_may_run.get_future().share();
+  bool called = false;
+  bool job_done = false;
+
+  stream->submit([job_go, &job_done]() {
+    job_go.wait();
+    job_done = true;
+  });
+  stream->notify_when_idle([&called]() { called = true; });
+
+  std::thread releaser([&job_may_run]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    job_may_run.set_value();
+  });
+  stream->cancel();
+  releaser.join();
+
+  EXPECT_TRUE(job_done);
+  EXPECT_TRUE(stream->is_idle());
+  EXPECT_FALSE(called);
+}
+
+TEST_F(S3HashWorkerPoolTest, Md5JobsKeepStreamOrderWhenBatched) {
+  const size_t stream_count = 24;
+  std::vector<char> data(256 * 1024);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = (char)(i * 13 + (i >> 10));
+  }
+  std::promise<void> jobs_may_run;
+  std::shared_future<void> jobs_go = jobs_may_run.get_future().share();
+  std::vector<std::shared_ptr<S3HashStream>> streams;
+  std::vector<MD5hash> expected(stream_count);
+  std::vector<MD5hash> actual(stream_count);
+
+  S3MD5MultiBuffer::init();
+  for (size_t i = 0; i < stream_count; ++i) {
+    streams.push_back(S3HashWorkerPool::get_instance()->create_stream());
+    if (i < 2) {
+      // Hold both workers so that MD5 jobs of all streams get queued.
+      streams[i]->submit([jobs_go]() { jobs_go.wait(); });
+    }
+
+    S3BufferSequence first, second;
+    first.emplace_back(&data[i * 100], 16384);
+    first.emplace_back(&data[i * 100 + 16384], 1000 + i);
+    second.emplace_back(&data[i * 300], 8192 * (i % 3 + 1));
+    MD5hash *hash = &actual[i];
+    const char *extra = &data[i * 50];
+
+    // A plain job between two MD5 jobs must not be overtaken.
+    streams[i]->submit_md5(hash, first);
+    streams[i]->submit([hash, extra]() { hash->Update(extra, 77); });
+    streams[i]->submit_md5(hash, second);
+
+    for (const auto &buf : first) {
+      expected[i].Update((const char *)buf.first, buf.second);
+    }
+    expected[i].Update(extra, 77);
+    for (const auto &buf : second) {
+      expected[i].Update((const char *)buf.first, buf.second);
+    }
+  }
+  jobs_may_run.set_value();
+
+  for (size_t i = 0; i < stream_count; ++i) {
+    streams[i]->wait();
+    EXPECT_EQ(expected[i].get_md5_string(), actual[i].get_md5_string())
+        << "stream " << i;
+  }
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "s3_json_scanner.h"
+
+TEST(S3JsonScannerTest, ReadsWantedMembersAndSkipsOthers) {
+  std::string json =
+      "{ \"num\" : -1.5e3, \"arr\": [1, {\"s\": \"]}\"}, [true]],"
+      "\"obj\": {\"skip\": null, \"want\": \"value\"}, \"flag\": false,"
+      "\"last\": \"end\"}";
+  S3JsonScanner scanner(json);
+  std::string key, want, last;
+
+  ASSERT_TRUE(scanner.enter_object());
+  while (scanner.next_member(key)) {
+    if (key == "obj") {
+      ASSERT_TRUE(scanner.enter_object());
+      while (scanner.next_member(key)) {
+        if (key == "want") {
+          EXPECT_TRUE(scanner.read_string(want));
+        } else {
+          EXPECT_TRUE(scanner.skip_value());
+        }
+      }
+    } else if (key == "last") {
+      EXPECT_TRUE(scanner.read_string(last));
+    } else {
+      EXPECT_TRUE(scanner.skip_value());
+    }
+  }
+  EXPECT_FALSE(scanner.failed());
+  EXPECT_EQ("value", want);
+  EXPECT_EQ("end", last);
+}
+
+TEST(S3JsonScannerTest, DecodesEscapes) {
+  std::string json =
+      "\"a\\\"b\\\\c\\/d\\n\\t\\u0041\\u00e9\\u20ac\\ud83d\\ude00\"";
+  S3JsonScanner scanner(json);
+  std::string value;
+
+  EXPECT_TRUE(scanner.read_string(value));
+  EXPECT_EQ("a\"b\\c/d\n\tA\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80", value);
+}
+
+TEST(S3JsonScannerTest, FailsOnTruncatedInput) {
+  std::string key, value;
+  std::string unterminated_json = "{\"key\": \"val";
+  std::string unclosed_json = "{\"key\": {\"a\": 1}";
+  S3JsonScanner unterminated(unterminated_json);
+  EXPECT_TRUE(unterminated.enter_object());
+  EXPECT_TRUE(unterminated.next_member(key));
+  EXPECT_FALSE(unterminated.read_string(value));
+  EXPECT_TRUE(unterminated.failed());
+
+  S3JsonScanner unclosed(unclosed_json);
+  EXPECT_TRUE(unclosed.enter_object());
+  EXPECT_TRUE(unclosed.next_member(key));
+  EXPECT_TRUE(unclosed.skip_value());
+  EXPECT_FALSE(unclosed.next_member(key));
+  EXPECT_TRUE(unclosed.failed());
+}
+
+TEST(S3JsonScannerTest, FailsOnBadEscape) {
+  std::string value;
+  std::string bad_escape_json = "\"\\x\"";
+  std::string lone_surrogate_json = "\"\\ud83d\"";
+  S3JsonScanner bad_escape(bad_escape_json);
+  EXPECT_FALSE(bad_escape.read_string(value));
+  EXPECT_TRUE(bad_escape.failed());
+
+  S3JsonScanner lone_surrogate(lone_surrogate_json);
+  EXPECT_FALSE(lone_surrogate.read_string(value));
+  EXPECT_TRUE(lone_surrogate.failed());
+}
@@ -18,7 +18,10 @@
  *
  */
 
+#include <vector>
+
 #include "s3_md5_hash.h"
+#include "s3_md5_mb.h"
 #include "gtest/gtest.h"
 
 TEST(MD5HashTest, Constructor) {
@@ -84,3 +87,48 @@ TEST(MD5HashTest, GetMD5) {
   std::string str = md5hashobj.get_md5_string();
   EXPECT_STREQ("c3fcd3d76192e4007dfb496cca67e13b", str.c_str());
 }
+
+TEST(MD5HashTest, UpdateMultiMatchesUpdate) {
+  const size_t stream_count = 37;
+  std::vector<char> data(64 * 1024);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = (char)(i * 7 + (i >> 8));
+  }
+
+  S3MD5MultiBuffer::init();
+  for (int scalar = 0; scalar < 2; ++scalar) {
+    if (scalar) {
+      S3MD5MultiBuffer::use_scalar();
+    }
+    std::vector<MD5hash> expected(stream_count);
+    std::vector<MD5hash> actual(stream_count);
+    std::vector<std::pair<MD5hash *, S3BufferSequence>> inputs;
+
+    for (size_t i = 0; i < stream_count; ++i) {
+      // Some streams start with a partial block held by OpenSSL.
+      if (i % 3 == 0) {
+        expected[i].Update(&data[0], i + 1);
+        actual[i].Update(&data[0], i + 1);
+      }
+      // Streams of different lengths, with empty and unaligned buffers.
+      S3BufferSequence buffers;
+      size_t offset = i * 11;
+      for (size_t n = 0; n < i % 5 + 1; ++n) {
+        size_t len = (n == 1) ? 0 : 4096 * (i % 4) + 64 * n + i % 70;
+        buffers.emplace_back(&data[offset], len);
+        expected[i].Update(&data[offset], len);
+        offset += len;
+      }
+      inputs.emplace_back(&actual[i], buffers);
+    }
+
+    MD5hash::UpdateMulti(inputs);
+
+    for (size_t i = 0; i < stream_count; ++i) {
+      EXPECT_EQ(expected[i].get_md5_string(), actual[i].get_md5_string())
+          << "stream " << i << " engine "
+          << S3MD5MultiBuffer::engine_name();
+    }
+  }
+  S3MD5MultiBuffer::init();
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <json/json.h>
+#include <map>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "s3_metadata_codec.h"
+
+TEST(S3MetadataCodecTest, EncodeDecode) {
+  const std::string name("obj\0name", 8);
+  const std::string raw_acl("<AccessControlPolicy/>");
+  std::map<std::string, std::string> attributes = {
+      {"Content-Length", "1024"}, {"empty", ""}, {std::string(200, 'k'), "v"}};
+  std::string record;
+  S3MetadataEncoder encoder(record, S3MetadataRecord::object);
+  encoder.add_string(S3MetadataField::object_name, name);
+  encoder.add_integer(S3MetadataField::layout_id, 9);
+  encoder.add_integer(S3MetadataField::old_layout_id, -300);
+  encoder.add_map(S3MetadataField::system_defined, attributes);
+  encoder.add_base64(S3MetadataField::acl, S3MetadataField::acl_as_stored,
+                     "PEFjY2Vzc0NvbnRyb2xQb2xpY3kvPg==");
+  ASSERT_TRUE(s3_is_binary_metadata(record));
+
+  S3MetadataDecoder decoder(record);
+  EXPECT_EQ(S3MetadataRecord::object, decoder.record_type());
+  S3MetadataField field;
+  std::string value;
+  int64_t number;
+  std::map<std::string, std::string> map_value;
+
+  ASSERT_TRUE(decoder.next_field(field));
+  EXPECT_EQ(S3MetadataField::object_name, field);
+  EXPECT_TRUE(decoder.read_string(value));
+  EXPECT_EQ(name, value);
+  ASSERT_TRUE(decoder.next_field(field));
+  EXPECT_EQ(S3MetadataField::layout_id, field);
+  EXPECT_TRUE(decoder.read_integer(number));
+  EXPECT_EQ(9, number);
+  ASSERT_TRUE(decoder.next_field(field));
+  EXPECT_TRUE(decoder.read_integer(number));
+  EXPECT_EQ(-300, number);
+  ASSERT_TRUE(decoder.next_field(field));
+  EXPECT_EQ(S3MetadataField::system_defined, field);
+  EXPECT_TRUE(decoder.read_map(map_value));
+  EXPECT_EQ(attributes, map_value);
+  ASSERT_TRUE(decoder.next_field(field));
+  // Stored decoded, handed back encoded
+  EXPECT_EQ(S3MetadataField::acl, field);
+  EXPECT_NE(std::string::npos, record.find(raw_acl));
+  EXPECT_TRUE(decoder.read_base64(value));
+  EXPECT_EQ("PEFjY2Vzc0NvbnRyb2xQb2xpY3kvPg==", value);
+  EXPECT_FALSE(decoder.next_field(field));
+  EXPECT_FALSE(decoder.failed());
+}
+
+TEST(S3MetadataCodecTest, KeepsNonCanonicalBase64AsStored) {
+  std::string record;
+  S3MetadataEncoder encoder(record, S3MetadataRecord::bucket);
+  encoder.add_base64(S3MetadataField::acl, S3MetadataField::acl_as_stored,
+                     "not base64");
+
+  S3MetadataDecoder decoder(record);
+  S3MetadataField field;
+  std::string value;
+  ASSERT_TRUE(decoder.next_field(field));
+  EXPECT_EQ(S3MetadataField::acl_as_stored, field);
+  EXPECT_TRUE(decoder.read_string(value));
+  EXPECT_EQ("not base64", value);
+}
+
+TEST(S3MetadataCodecTest, SkipsUnknownAndUnreadFields) {
+  std::string record;
+  S3MetadataEncoder encoder(record, S3MetadataRecord::object);
+  encoder.add_string(S3MetadataField::bucket_name, "bucket");
+  encoder.add_string((S3MetadataField)1000, "from a newer server");
+  encoder.add_string(S3MetadataField::object_name, "obj");
+
+  S3MetadataDecoder decoder(record);
+  S3MetadataField field;
+  std::string value;
+  ASSERT_TRUE(decoder.next_field(field));
+  ASSERT_TRUE(decoder.next_field(field));
+  EXPECT_EQ(S3MetadataField::max_field, field);
+  ASSERT_TRUE(decoder.next_field(field));
+  EXPECT_EQ(S3MetadataField::object_name, field);
+  EXPECT_TRUE(decoder.read_string(value));
+  EXPECT_EQ("obj", value);
+  EXPECT_FALSE(decoder.next_field(field));
+  EXPECT_FALSE(decoder.failed());
+}
+
+TEST(S3MetadataCodecTest, RejectsMalformedRecords) {
+  S3MetadataField field;
+  for (const std::string &bad :
+       {std::string("{\"Bucket-Name\":\"b\"}"), std::string("\0X\1", 3),
+        std::string("\0O\2", 3), std::string("\0O\1\2\5ab", 7),
+        std::string("\0O\1\2", 4)}) {
+    S3MetadataDecoder decoder(bad);
+    while (decoder.next_field(field)) {
+      decoder.skip_field();
+    }
+    EXPECT_TRUE(decoder.failed());
+  }
+  EXPECT_FALSE(s3_is_binary_metadata("{\"Bucket-Name\":\"b\"}"));
+  EXPECT_FALSE(s3_is_binary_metadata(""));
+}
+
+TEST(S3MetadataCodecTest, ToJson) {
+  std::string record;
+  S3MetadataEncoder encoder(record, S3MetadataRecord::bucket);
+  encoder.add_string(S3MetadataField::bucket_name, "bucket");
+  encoder.add_map(S3MetadataField::system_defined, {{"Owner-User", "root"}});
+  encoder.add_bytes(S3MetadataField::policy, "{}");
+  encoder.add_integer(S3MetadataField::layout_id, 9);
+
+  std::string json;
+  Json::Value root;
+  Json::Reader reader;
+  ASSERT_TRUE(s3_binary_metadata_to_json(record, json));
+  ASSERT_TRUE(reader.parse(json, root));
+  EXPECT_EQ("bucket", root["Bucket-Name"].asString());
+  EXPECT_EQ("root", root["System-Defined"]["Owner-User"].asString());
+  EXPECT_EQ("e30=", root["Policy"].asString());
+  EXPECT_EQ(9, root["layout_id"].asInt());
+
+  record.resize(record.length() - 1);
+  EXPECT_FALSE(s3_binary_metadata_to_json(record, json));
+}
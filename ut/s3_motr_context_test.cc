@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include "gtest/gtest.h"
+
+#include "s3_motr_context.h"
+
+#define CTX_POOL_MAX_THRESHOLD (1024 * 1024)
+
+// Contexts must be usable alike whether their blocks come from the pools
+// or from calloc(), so tests run both ways.
+class S3MotrContextTest : public testing::Test {
+ protected:
+  void use_pools(bool with_pools) {
+    destroy_motr_ctx_pools();
+    if (with_pools) {
+      ASSERT_EQ(0, create_motr_ctx_pools(CTX_POOL_MAX_THRESHOLD, 0));
+    }
+  }
+
+  void TearDown() { destroy_motr_ctx_pools(); }
+};
+
+class S3MotrContextPoolTest : public S3MotrContextTest {
+ protected:
+  void SetUp() { use_pools(true); }
+};
+
+TEST_F(S3MotrContextTest, BasicOpCtx) {
+  for (bool with_pools : {false, true}) {
+    use_pools(with_pools);
+    for (size_t op_count : {1, 3, 2000}) {
+      struct s3_motr_op_context *ctx = create_basic_op_ctx(op_count);
+      ASSERT_TRUE(ctx != NULL);
+      EXPECT_EQ(op_count, ctx->op_count);
+      EXPECT_LE((void *)(ctx->ops + op_count), (void *)ctx->cbs);
+      for (size_t i = 0; i < op_count; i++) {
+        EXPECT_TRUE(ctx->ops[i] == NULL);
+        EXPECT_TRUE(ctx->cbs[i].oop_stable == NULL);
+      }
+      free_basic_op_ctx(ctx);
+    }
+  }
+}
+
+TEST_F(S3MotrContextTest, RwOpCtxWithoutBufs) {
+  for (bool with_pools : {false, true}) {
+    use_pools(with_pools);
+    for (size_t buf_count : {1, 16, 500}) {
+      struct s3_motr_rw_op_context *ctx =
+          create_basic_rw_op_ctx(buf_count, 4096, false);
+      ASSERT_TRUE(ctx != NULL);
+      EXPECT_FALSE(ctx->allocated_bufs);
+      EXPECT_EQ(buf_count, ctx->ext->iv_vec.v_nr);
+      EXPECT_EQ(buf_count, ctx->data->ov_vec.v_nr);
+      EXPECT_EQ(buf_count, ctx->attr->ov_vec.v_nr);
+      for (size_t i = 0; i < buf_count; i++) {
+        EXPECT_TRUE(ctx->data->ov_buf[i] == NULL);
+        EXPECT_EQ(0, ctx->data->ov_vec.v_count[i]);
+        EXPECT_EQ(0, ctx->ext->iv_index[i]);
+        EXPECT_EQ(1, ctx->attr->ov_vec.v_count[i]);
+        EXPECT_TRUE(ctx->attr->ov_buf[i] != NULL);
+        // As done by writers, arrays must not overlap
+        ctx->ext->iv_index[i] = i * 4096;
+        ctx->ext->iv_vec.v_count[i] = 4096;
+        ctx->data->ov_vec.v_count[i] = 4096;
+        ctx->attr->ov_vec.v_count[i] = 0;
+      }
+      for (size_t i = 0; i < buf_count; i++) {
+        EXPECT_EQ(i * 4096, ctx->ext->iv_index[i]);
+        EXPECT_EQ(4096, ctx->ext->iv_vec.v_count[i]);
+        EXPECT_EQ(4096, ctx->data->ov_vec.v_count[i]);
+      }
+      free_basic_rw_op_ctx(ctx);
+    }
+  }
+}
+
+TEST_F(S3MotrContextTest, KvsOpCtx) {
+  for (bool with_pools : {false, true}) {
+    use_pools(with_pools);
+    for (int no_of_keys : {1, 30, 1000}) {
+      struct s3_motr_kvs_op_context *ctx = create_basic_kvs_op_ctx(no_of_keys);
+      ASSERT_TRUE(ctx != NULL);
+      EXPECT_EQ(no_of_keys, ctx->keys->ov_vec.v_nr);
+      EXPECT_EQ(no_of_keys, ctx->values->ov_vec.v_nr);
+      for (int i = 0; i < no_of_keys; i++) {
+        EXPECT_TRUE(ctx->keys->ov_buf[i] == NULL);
+        EXPECT_TRUE(ctx->values->ov_buf[i] == NULL);
+        EXPECT_EQ(0, ctx->rcs[i]);
+        ctx->keys->ov_buf[i] = malloc(4);
+        ctx->keys->ov_vec.v_count[i] = 4;
+        ctx->rcs[i] = -ENOENT;
+      }
+      // Freeing the context frees the keys and values too
+      free_basic_kvs_op_ctx(ctx);
+    }
+  }
+}
+
+TEST_F(S3MotrContextTest, IdxOpCtx) {
+  for (bool with_pools : {false, true}) {
+    use_pools(with_pools);
+    struct s3_motr_idx_op_context *ctx = create_basic_idx_op_ctx(2);
+    ASSERT_TRUE(ctx != NULL);
+    EXPECT_EQ(2, ctx->op_count);
+    EXPECT_TRUE(ctx->sync_op == NULL);
+    free_basic_idx_op_ctx(ctx);
+  }
+}
+
+TEST_F(S3MotrContextTest, IndexBufvec) {
+  for (bool with_pools : {false, true}) {
+    use_pools(with_pools);
+    struct m0_bufvec *bv = index_bufvec_alloc(8);
+    ASSERT_TRUE(bv != NULL);
+    EXPECT_EQ(8, bv->ov_vec.v_nr);
+    bv->ov_buf[7] = malloc(16);
+    index_bufvec_free(bv);
+  }
+}
+
+TEST_F(S3MotrContextPoolTest, BlocksAreReused) {
+  struct s3_motr_op_context *ctx = create_basic_op_ctx(1);
+  free_basic_op_ctx(ctx);
+  EXPECT_EQ(ctx, create_basic_op_ctx(1));
+  free_basic_op_ctx(ctx);
+}
+
+TEST_F(S3MotrContextPoolTest, FreeAfterPoolsDestroyed) {
+  struct s3_motr_op_context *ctx = create_basic_op_ctx(1);
+  struct s3_motr_kvs_op_context *kvs_ctx = create_basic_kvs_op_ctx(1);
+  destroy_motr_ctx_pools();
+  free_basic_op_ctx(ctx);
+  free_basic_kvs_op_ctx(kvs_ctx);
+}
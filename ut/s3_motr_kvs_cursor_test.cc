@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "s3_factory.h"
+#include "s3_motr_kvs_cursor.h"
+#include "s3_option.h"
+
+#include "mock_s3_motr_wrapper.h"
+#include "mock_s3_request_object.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+static void dummy_request_cb(evhtp_request_t *req, void *arg) {}
+
+// Inner reader whose NEXT op is completed by the test.
+class FakeS3MotrKVSReader : public S3MotrKVSReader {
+ public:
+  FakeS3MotrKVSReader(std::shared_ptr<RequestObject> req,
+                      std::shared_ptr<MotrAPI> motr_api)
+      : S3MotrKVSReader(req, motr_api),
+        fake_state(S3MotrKVSReaderOpState::start),
+        count_asked(0),
+        flag_asked(0) {}
+
+  void next_keyval(struct m0_uint128 idx_oid, std::string key, size_t nr_kvp,
+                   std::function<void(void)> on_success,
+                   std::function<void(void)> on_failed,
+                   unsigned int flag) override {
+    key_asked = key;
+    count_asked = nr_kvp;
+    flag_asked = flag;
+    success = on_success;
+    failed = on_failed;
+  }
+
+  S3MotrKVSReaderOpState get_state() override { return fake_state; }
+
+  std::map<std::string, std::pair<int, std::string>> &get_key_values()
+      override {
+    return kvs;
+  }
+
+  // Answers with the keys of the index following the asked key.
+  void complete(const std::map<std::string, std::string> &index) {
+    auto it = (flag_asked & M0_OIF_EXCLUDE_START_KEY)
+                  ? index.upper_bound(key_asked)
+                  : index.lower_bound(key_asked);
+    kvs.clear();
+    for (; it != index.end() && kvs.size() < count_asked; ++it) {
+      kvs[it->first] = std::make_pair(0, it->second);
+    }
+    if (kvs.empty()) {
+      fail(S3MotrKVSReaderOpState::missing);
+    } else {
+      fake_state = S3MotrKVSReaderOpState::present;
+      // The handler may issue the next op on this reader.
+      std::function<void(void)> handler = success;
+      handler();
+    }
+  }
+
+  void fail(S3MotrKVSReaderOpState with_state) {
+    fake_state = with_state;
+    std::function<void(void)> handler = failed;
+    handler();
+  }
+
+  S3MotrKVSReaderOpState fake_state;
+  std::map<std::string, std::pair<int, std::string>> kvs;
+  std::string key_asked;
+  size_t count_asked;
+  unsigned int flag_asked;
+  std::function<void(void)> success;
+  std::function<void(void)> failed;
+};
+
+class FakeS3MotrKVSReaderFactory : public S3MotrKVSReaderFactory {
+ public:
+  std::shared_ptr<S3MotrKVSReader> create_motr_kvs_reader(
+      std::shared_ptr<RequestObject> req,
+      std::shared_ptr<MotrAPI> s3_motr_api = nullptr) override {
+    auto reader = std::make_shared<FakeS3MotrKVSReader>(req, s3_motr_api);
+    readers.push_back(reader);
+    return reader;
+  }
+
+  std::vector<std::shared_ptr<FakeS3MotrKVSReader>> readers;
+};
+
+#define SET_BATCH_SIZE(size)                                             \
+  cursor->batch_size = cursor->min_batch_size = cursor->max_batch_size = \
+      size
+
+static FakeS3MotrKVSReader *fake(std::shared_ptr<S3MotrKVSReader> reader) {
+  return static_cast<FakeS3MotrKVSReader *>(reader.get());
+}
+
+class S3MotrKVSCursorTest : public testing::Test {
+ protected:
+  S3MotrKVSCursorTest() {
+    evbase = event_base_new();
+    req = evhtp_request_new(dummy_request_cb, evbase);
+    EvhtpWrapper *evhtp_obj_ptr = new EvhtpWrapper();
+    ptr_mock_s3request =
+        std::make_shared<MockS3RequestObject>(req, evhtp_obj_ptr);
+    ptr_mock_s3motr = std::make_shared<MockS3Motr>();
+    reader_factory = std::make_shared<FakeS3MotrKVSReaderFactory>();
+    cursor = std::make_shared<S3MotrKVSCursor>(
+        ptr_mock_s3request, ptr_mock_s3motr, reader_factory);
+    index_oid = {0x1ffff, 0x1ffff};
+    char key[8];
+    for (int i = 0; i < 20; ++i) {
+      snprintf(key, sizeof(key), "k%02d", i);
+      index[key] = "value";
+    }
+    success_count = failed_count = 0;
+  }
+
+  ~S3MotrKVSCursorTest() { event_base_free(evbase); }
+
+  void next_keyval(const std::string &key, size_t count) {
+    cursor->next_keyval(index_oid, key, count,
+                        [this]() { ++success_count; },
+                        [this]() { ++failed_count; });
+  }
+
+  std::string first_key() {
+    return cursor->get_key_values().begin()->first;
+  }
+
+  std::string last_key() {
+    return cursor->get_key_values().rbegin()->first;
+  }
+
+  evbase_t *evbase;
+  evhtp_request_t *req;
+  std::shared_ptr<MockS3RequestObject> ptr_mock_s3request;
+  std::shared_ptr<MockS3Motr> ptr_mock_s3motr;
+  std::shared_ptr<FakeS3MotrKVSReaderFactory> reader_factory;
+  std::shared_ptr<S3MotrKVSCursor> cursor;
+  struct m0_uint128 index_oid;
+  std::map<std::string, std::string> index;
+  int success_count;
+  int failed_count;
+};
+
+TEST_F(S3MotrKVSCursorTest, ServesNextBatchFromPrefetch) {
+  SET_BATCH_SIZE(2);
+  next_keyval("", 2);
+  ASSERT_TRUE(cursor->direct != nullptr);
+  fake(cursor->direct->reader)->complete(index);
+  EXPECT_EQ(1, success_count);
+  EXPECT_EQ(2u, cursor->get_key_values().size());
+  EXPECT_EQ("k00", first_key());
+  EXPECT_EQ("k01", last_key());
+
+  // Keys after the batch are asked for before the caller needs them.
+  ASSERT_TRUE(cursor->ahead != nullptr);
+  EXPECT_EQ("k01", fake(cursor->ahead->reader)->key_asked);
+  fake(cursor->ahead->reader)->complete(index);
+  EXPECT_EQ(1, success_count);
+
+  next_keyval("k01", 2);
+  EXPECT_EQ(2, success_count);
+  EXPECT_EQ(S3MotrKVSReaderOpState::present, cursor->get_state());
+  EXPECT_EQ("k02", first_key());
+  EXPECT_EQ("k03", last_key());
+  ASSERT_TRUE(cursor->ahead != nullptr);
+  EXPECT_EQ("k03", fake(cursor->ahead->reader)->key_asked);
+  // A sequential walk keeps reusing one inner reader.
+  EXPECT_EQ(1u, reader_factory->readers.size());
+}
+
+TEST_F(S3MotrKVSCursorTest, WaitsForPrefetchInFlight) {
+  SET_BATCH_SIZE(2);
+  next_keyval("", 2);
+  fake(cursor->direct->reader)->complete(index);
+  EXPECT_EQ(1, success_count);
+
+  next_keyval("k01", 2);
+  EXPECT_EQ(1, success_count);
+  EXPECT_TRUE(cursor->direct == nullptr);
+  fake(cursor->ahead->reader)->complete(index);
+  EXPECT_EQ(2, success_count);
+  EXPECT_EQ("k02", first_key());
+  EXPECT_EQ("k03", last_key());
+}
+
+TEST_F(S3MotrKVSCursorTest, SeekWithinWindow) {
+  SET_BATCH_SIZE(10);
+  next_keyval("", 2);
+  EXPECT_EQ(10u, fake(cursor->direct->reader)->count_asked);
+  fake(cursor->direct->reader)->complete(index);
+  EXPECT_EQ("k01", last_key());
+
+  // Skipping past a common prefix still lands in the fetched keys.
+  next_keyval("k05\xff", 2);
+  EXPECT_EQ(2, success_count);
+  EXPECT_EQ("k06", first_key());
+  EXPECT_EQ("k07", last_key());
+  EXPECT_TRUE(cursor->direct == nullptr);
+  EXPECT_EQ(1u, reader_factory->readers.size());
+}
+
+TEST_F(S3MotrKVSCursorTest, SeekPastWindowWaitsForPrefetch) {
+  SET_BATCH_SIZE(2);
+  next_keyval("", 2);
+  fake(cursor->direct->reader)->complete(index);
+
+  next_keyval("k10", 2);
+  EXPECT_TRUE(cursor->direct == nullptr);
+  fake(cursor->ahead->reader)->complete(index);
+  EXPECT_EQ(1, success_count);
+
+  // Prefetched keys end before the seek key, fetch from it.
+  ASSERT_TRUE(cursor->direct != nullptr);
+  EXPECT_EQ("k10", fake(cursor->direct->reader)->key_asked);
+  fake(cursor->direct->reader)->complete(index);
+  EXPECT_EQ(2, success_count);
+  EXPECT_EQ("k11", first_key());
+  EXPECT_EQ("k12", last_key());
+}
+
+TEST_F(S3MotrKVSCursorTest, SeekOutsideWindowAbandonsPrefetch) {
+  SET_BATCH_SIZE(2);
+  next_keyval("", 2);
+  fake(cursor->direct->reader)->complete(index);
+  FakeS3MotrKVSReader *prefetching = fake(cursor->ahead->reader);
+
+  // Listing restarted from an earlier key.
+  next_keyval("", 2);
+  ASSERT_TRUE(cursor->direct != nullptr);
+  EXPECT_TRUE(cursor->ahead == nullptr);
+  EXPECT_EQ(2u, reader_factory->readers.size());
+
+  // Result of the abandoned prefetch is dropped.
+  prefetching->complete(index);
+  EXPECT_EQ(1, success_count);
+  EXPECT_TRUE(cursor->abandoned.empty());
+
+  fake(cursor->direct->reader)->complete(index);
+  EXPECT_EQ(2, success_count);
+  EXPECT_EQ("k00", first_key());
+  EXPECT_EQ("k01", last_key());
+}
+
+TEST_F(S3MotrKVSCursorTest, LateReplyOfUnknownFetchIsDropped) {
+  SET_BATCH_SIZE(2);
+  next_keyval("", 2);
+  fake(cursor->direct->reader)->complete(index);
+  FakeS3MotrKVSReader *prefetching = fake(cursor->ahead->reader);
+  next_keyval("", 2);
+  prefetching->complete(index);
+  ASSERT_TRUE(cursor->abandoned.empty());
+  size_t idle_readers = cursor->idle_readers.size();
+
+  // Reply again to the fetch which is forgotten already.
+  prefetching->complete(index);
+  EXPECT_EQ(1, success_count);
+  EXPECT_EQ(idle_readers, cursor->idle_readers.size());
+  ASSERT_TRUE(cursor->direct != nullptr);
+}
+
+TEST_F(S3MotrKVSCursorTest, EndOfIndex) {
+  std::map<std::string, std::string> small_index = {
+      {"a", "1"}, {"b", "2"}, {"c", "3"}};
+  SET_BATCH_SIZE(2);
+  next_keyval("", 2);
+  fake(cursor->direct->reader)->complete(small_index);
+  fake(cursor->ahead->reader)->complete(small_index);
+  EXPECT_TRUE(cursor->window_at_end);
+
+  next_keyval("b", 2);
+  EXPECT_EQ(2, success_count);
+  EXPECT_EQ(1u, cursor->get_key_values().size());
+  EXPECT_EQ("c", first_key());
+  EXPECT_TRUE(cursor->ahead == nullptr);
+
+  next_keyval("c", 2);
+  EXPECT_EQ(1, failed_count);
+  EXPECT_EQ(S3MotrKVSReaderOpState::missing, cursor->get_state());
+  EXPECT_TRUE(cursor->ahead == nullptr);
+  EXPECT_TRUE(cursor->direct == nullptr);
+  EXPECT_TRUE(cursor->self_ref == nullptr);
+}
+
+TEST_F(S3MotrKVSCursorTest, AdaptsBatchSizeToLatency) {
+  cursor->batch_size = cursor->min_batch_size = 2;
+  cursor->max_batch_size = 8;
+  cursor->target_latency = std::chrono::hours(1);
+  next_keyval("", 2);
+  fake(cursor->direct->reader)->complete(index);
+  EXPECT_EQ(4u, cursor->get_batch_size());
+  EXPECT_EQ(4u, fake(cursor->ahead->reader)->count_asked);
+  fake(cursor->ahead->reader)->complete(index);
+  EXPECT_EQ(8u, cursor->get_batch_size());
+
+  // Batches slower than the target shrink back.
+  cursor->target_latency = std::chrono::milliseconds(-1);
+  next_keyval("k01", 2);
+  EXPECT_EQ(8u, fake(cursor->ahead->reader)->count_asked);
+  fake(cursor->ahead->reader)->complete(index);
+  EXPECT_EQ(4u, cursor->get_batch_size());
+}
+
+TEST_F(S3MotrKVSCursorTest, E2bigRetriesWithRequestedCount) {
+  SET_BATCH_SIZE(10);
+  next_keyval("", 2);
+  fake(cursor->direct->reader)->fail(S3MotrKVSReaderOpState::failed_e2big);
+  EXPECT_EQ(0, failed_count);
+  EXPECT_EQ(5u, cursor->max_batch_size);
+  ASSERT_TRUE(cursor->direct != nullptr);
+  EXPECT_EQ(2u, fake(cursor->direct->reader)->count_asked);
+
+  fake(cursor->direct->reader)->fail(S3MotrKVSReaderOpState::failed_e2big);
+  EXPECT_EQ(1, failed_count);
+  EXPECT_EQ(S3MotrKVSReaderOpState::failed_e2big, cursor->get_state());
+}
@@ -18,6 +18,9 @@
  *
  */
 
+#include <chrono>
+#include <future>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -25,6 +28,7 @@
 #include "mock_s3_request_object.h"
 #include "s3_async_buffer_opt.h"
 #include "s3_callback_test_helpers.h"
+#include "s3_hash_worker_pool.h"
 #include "s3_motr_layout.h"
 #include "s3_motr_writer.h"
 
@@ -522,6 +526,56 @@ TEST_F(S3MotrWiterTest, WriteContentSuccessfulTest) {
   EXPECT_FALSE(S3MotrWiter_callbackobj.fail_called);
 }
 
+TEST_F(S3MotrWiterTest, WriteContentWithHashWorkerTest) {
+  std::promise<void> written;
+  std::future<void> write_done = written.get_future();
+  bool is_last_buf = true;
+  std::string sdata("Hello.World");
+
+  ASSERT_EQ(0, S3HashWorkerPool::create_pool(1));
+  motr_writer_ptr =
+      std::make_shared<S3MotrWiter>(request_mock, obj_oid, 0, s3_motr_api_mock);
+  motr_writer_ptr->set_layout_id(layout_id);
+  EXPECT_TRUE(motr_writer_ptr->hash_stream != nullptr);
+
+  EXPECT_CALL(*s3_motr_api_mock, motr_obj_init(_, _, _, _));
+  EXPECT_CALL(*s3_motr_api_mock, motr_entity_open(_, _))
+      .WillOnce(Invoke(s3_test_allocate_op));
+  EXPECT_CALL(*s3_motr_api_mock, motr_obj_op(_, _, _, _, _, _, _, _))
+      .WillOnce(Invoke(s3_test_motr_obj_op));
+  EXPECT_CALL(*s3_motr_api_mock, motr_op_setup(_, _, _)).Times(2);
+  EXPECT_CALL(*s3_motr_api_mock, motr_op_launch(_, _, _, _))
+      .WillRepeatedly(Invoke(s3_test_motr_op_launch));
+  EXPECT_CALL(*s3_motr_api_mock, motr_obj_fini(_)).Times(1);
+
+  S3Option::get_instance()->set_eventbase(evbase);
+
+  buffer->add_content(get_evbuf_t_with_data(fourk_buffer), false, false, true);
+  buffer->add_content(get_evbuf_t_with_data(sdata.c_str()), false, is_last_buf,
+                      true);
+  buffer->freeze();
+  motr_writer_ptr->write_content([&written]() { written.set_value(); },
+                                 []() { FAIL(); },
+                                 buffer->get_buffers(
+                                     buffer->get_content_length()),
+                                 buffer->size_of_each_evbuf);
+
+  // Completion is reported only after the md5 of the data is computed.
+  ASSERT_EQ(std::future_status::ready,
+            write_done.wait_for(std::chrono::seconds(10)));
+  EXPECT_TRUE(motr_writer_ptr->get_state() == S3MotrWiterOpState::saved);
+  EXPECT_TRUE(motr_writer_ptr->hash_stream->is_idle());
+
+  MD5hash expected_md5;
+  expected_md5.Update(fourk_buffer.c_str(), fourk_buffer.length());
+  expected_md5.Update(sdata.c_str(), sdata.length());
+  expected_md5.Finalize();
+  EXPECT_EQ(expected_md5.get_md5_string(), motr_writer_ptr->get_content_md5());
+
+  motr_writer_ptr = nullptr;
+  S3HashWorkerPool::destroy_instance();
+}
+
 TEST_F(S3MotrWiterTest, WriteContentFailedTest) {
   S3CallBack S3MotrWiter_callbackobj;
   bool is_last_buf = true;
@@ -19,11 +19,13 @@
  */
 #include <string>
 #include <memory>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "mock_s3_factory.h"
 #include "mock_s3_probable_delete_record.h"
+#include "s3_mem_pool_manager.h"
 #include "s3_object_data_copier.h"
 #include "s3_m0_uint128_helper.h"
 #include "s3_ut_common.h"
@@ -54,6 +56,9 @@ class S3ObjectDataCopierTest : public testing::Test {
   bool f_success;
   bool f_failed;
 
+  // Motr read pool buffer of a unit, its bytes are 'first', 'first' + 1...
+  void* get_unit_buffer(char first);
+
  public:
   void on_success_cb();
   void on_failed_cb();
@@ -63,6 +68,17 @@ void S3ObjectDataCopierTest::on_success_cb() { f_success = true; }
 
 void S3ObjectDataCopierTest::on_failed_cb() { f_failed = true; }
 
+void* S3ObjectDataCopierTest::get_unit_buffer(char first) {
+  const size_t unit_size = entity_under_test->motr_unit_size;
+  char* buffer =
+      (char*)S3MempoolManager::get_instance()->get_buffer_for_unit_size(
+          unit_size);
+  for (size_t i = 0; i < unit_size; ++i) {
+    buffer[i] = first + (char)i;
+  }
+  return buffer;
+}
+
 bool fn_false_cb() { return false; }
 
 bool fn_true_cb() { return true; }
@@ -88,22 +104,29 @@ void S3ObjectDataCopierTest::SetUp() {
 
   entity_under_test.reset(new S3ObjectDataCopier(
       ptr_mock_request, ptr_mock_motr_writer_factory->mock_motr_writer,
-      ptr_mock_motr_reader_factory, ptr_mock_s3_motr_api));
+      ptr_mock_motr_writer_factory, ptr_mock_motr_reader_factory,
+      ptr_mock_s3_motr_api));
 
-  entity_under_test->motr_reader =
+  entity_under_test->slots.reserve(4);
+  entity_under_test->slots.resize(1);
+  entity_under_test->slots[0].reader =
       ptr_mock_motr_reader_factory->mock_motr_reader;
+  entity_under_test->slots[0].writer =
+      ptr_mock_motr_writer_factory->mock_motr_writer;
   entity_under_test->on_success =
       std::bind(&S3ObjectDataCopierTest::on_success_cb, this);
   entity_under_test->on_failure =
       std::bind(&S3ObjectDataCopierTest::on_failed_cb, this);
   entity_under_test->motr_unit_size =
       S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(1);
+  entity_under_test->units_per_chunk =
+      S3Option::get_instance()->get_motr_units_per_request();
+  entity_under_test->write_unit_size = entity_under_test->motr_unit_size;
   entity_under_test->check_shutdown_and_rollback = &fn_false_cb;
 
+  entity_under_test->read_offset = 0;
   entity_under_test->bytes_left_to_read = 1024;
   entity_under_test->copy_failed = false;
-  entity_under_test->read_in_progress = false;
-  entity_under_test->write_in_progress = false;
 
   f_success = false;
   f_failed = false;
@@ -111,14 +134,20 @@ void S3ObjectDataCopierTest::SetUp() {
 
 TEST_F(S3ObjectDataCopierTest, ReadDataBlockStarted) {
 
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              set_last_index(Eq(0))).Times(1);
   EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
               read_object_data(_, _, _))
       .Times(1)
       .WillOnce(Return(true));
 
-  entity_under_test->read_data_block();
+  EXPECT_TRUE(entity_under_test->read_data_block(0));
 
-  EXPECT_TRUE(entity_under_test->read_in_progress);
+  EXPECT_EQ(S3ObjectDataCopier::SlotState::reading,
+            entity_under_test->slots[0].state);
+  EXPECT_EQ(1024, entity_under_test->slots[0].length);
+  EXPECT_EQ(0, entity_under_test->bytes_left_to_read);
+  EXPECT_EQ(1, entity_under_test->next_read_seq_no);
 }
 
 TEST_F(S3ObjectDataCopierTest, ReadDataBlockFailedToStart) {
@@ -132,40 +161,212 @@ TEST_F(S3ObjectDataCopierTest, ReadDataBlockFailedToStart) {
       .Times(1)
       .WillOnce(Return(S3MotrReaderOpState::failed_to_launch));
 
-  entity_under_test->read_data_block();
+  EXPECT_FALSE(entity_under_test->read_data_block(0));
 
-  EXPECT_FALSE(entity_under_test->read_in_progress);
+  EXPECT_EQ(S3ObjectDataCopier::SlotState::idle,
+            entity_under_test->slots[0].state);
   EXPECT_TRUE(entity_under_test->copy_failed);
-  EXPECT_FALSE(entity_under_test->get_s3_error().empty());
+  EXPECT_STREQ("ServiceUnavailable",
+               entity_under_test->get_s3_error().c_str());
+  EXPECT_EQ(1024, entity_under_test->bytes_left_to_read);
+}
+
+TEST_F(S3ObjectDataCopierTest, ReadDataBlocksFillsSlots) {
+  const size_t read_size =
+      entity_under_test->units_per_chunk * entity_under_test->motr_unit_size;
+  entity_under_test->max_slots = 3;
+  entity_under_test->bytes_left_to_read = 2 * read_size + 100;
+
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              read_object_data(_, _, _))
+      .Times(3)
+      .WillRepeatedly(Return(true));
+
+  entity_under_test->read_data_blocks();
+
+  ASSERT_EQ(3, entity_under_test->slots.size());
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(S3ObjectDataCopier::SlotState::reading,
+              entity_under_test->slots[i].state);
+    EXPECT_EQ(i * read_size, entity_under_test->slots[i].offset);
+    EXPECT_EQ(i, entity_under_test->slots[i].seq_no);
+  }
+  EXPECT_EQ(100, entity_under_test->slots[2].length);
+  EXPECT_EQ(0, entity_under_test->bytes_left_to_read);
+}
+
+TEST_F(S3ObjectDataCopierTest, ReadDataBlockToDestinationOffset) {
+  const size_t unit_size = entity_under_test->motr_unit_size;
+  entity_under_test->set_destination_offset(8 * unit_size);
+  entity_under_test->read_offset = 2 * unit_size;
+
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              set_last_index(Eq(2 * unit_size))).Times(1);
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              read_object_data(_, _, _))
+      .Times(1)
+      .WillOnce(Return(true));
+
+  EXPECT_TRUE(entity_under_test->read_data_block(0));
+
+  EXPECT_EQ(2 * unit_size, entity_under_test->slots[0].offset);
+  // Write offset is taken once the chunk is packed for writing.
+  EXPECT_EQ(8 * unit_size, entity_under_test->write_offset);
+}
+
+TEST_F(S3ObjectDataCopierTest, ReadDataBlockOfUnalignedExtent) {
+  const size_t unit_size = entity_under_test->motr_unit_size;
+  entity_under_test->set_destination_offset(8 * unit_size);
+  entity_under_test->read_offset = 2 * unit_size + 100;
+  entity_under_test->bytes_left_to_read = 2 * unit_size;
+  entity_under_test->units_per_chunk = 1;
+
+  // Read starts at the unit boundary.
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              set_last_index(Eq(2 * unit_size))).Times(1);
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              read_object_data(Eq(1), _, _))
+      .Times(1)
+      .WillOnce(Return(true));
+
+  EXPECT_TRUE(entity_under_test->read_data_block(0));
+
+  EXPECT_EQ(100, entity_under_test->slots[0].skip);
+  EXPECT_EQ(unit_size - 100, entity_under_test->slots[0].length);
+  EXPECT_EQ(3 * unit_size, entity_under_test->read_offset);
+  EXPECT_EQ(unit_size + 100, entity_under_test->bytes_left_to_read);
+}
+
+TEST_F(S3ObjectDataCopierTest, ReadDataBlockSuccessOfUnalignedExtent) {
+  const size_t unit_size = entity_under_test->motr_unit_size;
+  entity_under_test->set_destination_offset(8 * unit_size);
+  entity_under_test->slots[0].state = S3ObjectDataCopier::SlotState::reading;
+  entity_under_test->slots[0].skip = 100;
+  entity_under_test->slots[0].length = 1024;
+  entity_under_test->bytes_left_to_read = 0;
+  entity_under_test->next_read_seq_no = 1;
+
+  S3BufferSequence data_blocks_read;
+  data_blocks_read.emplace_back(get_unit_buffer(0), unit_size);
+
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              extract_blocks_read())
+      .Times(1)
+      .WillOnce(Return(data_blocks_read));
+  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer,
+              write_content(_, _, _, _)).Times(1);
+  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer, get_state())
+      .Times(1);
+
+  entity_under_test->read_data_block_success(0);
+
+  EXPECT_EQ(S3ObjectDataCopier::SlotState::writing,
+            entity_under_test->slots[0].state);
+  // Data is shifted to the start of the written block.
+  const auto& data_blocks = entity_under_test->slots[0].data_blocks;
+  ASSERT_EQ(1, data_blocks.size());
+  EXPECT_EQ(1024, data_blocks[0].second);
+  EXPECT_EQ(8 * unit_size, entity_under_test->slots[0].write_offset);
+  EXPECT_EQ((char)100, ((char*)data_blocks[0].first)[0]);
+  EXPECT_EQ(0, entity_under_test->pending_length);
+}
+
+TEST_F(S3ObjectDataCopierTest, WriteShiftedDataKeepsPartialUnit) {
+  const size_t unit_size = entity_under_test->motr_unit_size;
+  entity_under_test->set_destination_offset(8 * unit_size);
+  auto& slot = entity_under_test->slots[0];
+  slot.state = S3ObjectDataCopier::SlotState::read;
+  slot.skip = 100;
+  slot.length = unit_size + 50;
+  slot.data_blocks.emplace_back(get_unit_buffer(0), unit_size);
+  slot.data_blocks.emplace_back(get_unit_buffer(1), 150);
+  entity_under_test->next_read_seq_no = 1;
+
+  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer,
+              write_content(_, _, _, _)).Times(1);
+  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer, get_state())
+      .Times(1);
+
+  entity_under_test->write_data_block(0);
+
+  // A whole unit is written, the rest waits for the next chunk.
+  ASSERT_EQ(1, slot.data_blocks.size());
+  EXPECT_EQ(unit_size, slot.data_blocks[0].second);
+  EXPECT_EQ((char)100, ((char*)slot.data_blocks[0].first)[0]);
+  EXPECT_EQ((char)1, ((char*)slot.data_blocks[0].first)[unit_size - 100]);
+  EXPECT_EQ(8 * unit_size, slot.write_offset);
+  EXPECT_EQ(9 * unit_size, entity_under_test->write_offset);
+  EXPECT_EQ(50, entity_under_test->pending_length);
+  ASSERT_EQ(1, entity_under_test->pending_blocks.size());
+  EXPECT_EQ((char)101, ((char*)entity_under_test->pending_blocks[0].first)[0]);
+  EXPECT_EQ(1, entity_under_test->next_write_seq_no);
+}
+
+TEST_F(S3ObjectDataCopierTest, WriteShiftedDataOfLastChunk) {
+  const size_t unit_size = entity_under_test->motr_unit_size;
+  entity_under_test->set_destination_offset(9 * unit_size);
+  entity_under_test->pending_blocks.emplace_back(get_unit_buffer(0), 50);
+  entity_under_test->pending_length = 50;
+  auto& slot = entity_under_test->slots[0];
+  slot.state = S3ObjectDataCopier::SlotState::read;
+  slot.length = 100;
+  slot.data_blocks.emplace_back(get_unit_buffer(50), 100);
+  entity_under_test->bytes_left_to_read = 0;
+  entity_under_test->next_read_seq_no = 1;
+
+  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer,
+              write_content(_, _, _, _)).Times(1);
+  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer, get_state())
+      .Times(1);
+
+  entity_under_test->write_data_block(0);
+
+  // Everything left is written with the last chunk.
+  ASSERT_EQ(1, slot.data_blocks.size());
+  EXPECT_EQ(150, slot.data_blocks[0].second);
+  EXPECT_EQ(9 * unit_size, slot.write_offset);
+  for (size_t i = 0; i < 150; ++i) {
+    ASSERT_EQ((char)i, ((char*)slot.data_blocks[0].first)[i]);
+  }
+  EXPECT_EQ(0, entity_under_test->pending_length);
+  EXPECT_TRUE(entity_under_test->pending_blocks.empty());
 }
 
 TEST_F(S3ObjectDataCopierTest, ReadDataBlockSuccessWhileShuttingDown) {
 
-  entity_under_test->read_in_progress = true;
+  entity_under_test->slots[0].state = S3ObjectDataCopier::SlotState::reading;
   entity_under_test->check_shutdown_and_rollback = &fn_true_cb;
 
-  entity_under_test->read_data_block_success();
+  entity_under_test->read_data_block_success(0);
 
-  EXPECT_FALSE(entity_under_test->read_in_progress);
+  EXPECT_EQ(S3ObjectDataCopier::SlotState::idle,
+            entity_under_test->slots[0].state);
+  EXPECT_FALSE(f_success);
+  EXPECT_FALSE(f_failed);
 }
 
 TEST_F(S3ObjectDataCopierTest, ReadDataBlockSuccessCopyFailed) {
 
-  entity_under_test->read_in_progress = true;
+  entity_under_test->slots[0].state = S3ObjectDataCopier::SlotState::reading;
   entity_under_test->copy_failed = true;
   entity_under_test->set_s3_error("InternalError");
 
-  entity_under_test->read_data_block_success();
+  entity_under_test->read_data_block_success(0);
 
-  EXPECT_FALSE(entity_under_test->read_in_progress);
+  EXPECT_EQ(S3ObjectDataCopier::SlotState::idle,
+            entity_under_test->slots[0].state);
   EXPECT_TRUE(f_failed);
 }
 
 TEST_F(S3ObjectDataCopierTest, ReadDataBlockSuccessShouldStartWrite) {
-  entity_under_test->read_in_progress = true;
+  entity_under_test->slots[0].state = S3ObjectDataCopier::SlotState::reading;
+  entity_under_test->slots[0].length = 1024;
+  entity_under_test->bytes_left_to_read = 0;
 
+  // Read data is hashed by the copier, so the block must be real.
+  std::vector<char> data(4096);
   S3BufferSequence data_blocks_read;
-  data_blocks_read.emplace_back(nullptr, 0);
+  data_blocks_read.emplace_back(data.data(), data.size());
 
   EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
               extract_blocks_read())
@@ -177,21 +378,98 @@ TEST_F(S3ObjectDataCopierTest, ReadDataBlockSuccessShouldStartWrite) {
   EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer, get_state())
       .Times(1);
 
-  entity_under_test->read_data_block_success();
+  entity_under_test->read_data_block_success(0);
+
+  EXPECT_EQ(S3ObjectDataCopier::SlotState::writing,
+            entity_under_test->slots[0].state);
+  // The last block is cut to the length of data.
+  EXPECT_EQ(1024, entity_under_test->slots[0].data_blocks[0].second);
+  EXPECT_EQ(1, entity_under_test->next_write_seq_no);
+  // The block is not from the mempool.
+  entity_under_test->slots[0].data_blocks.clear();
+}
+
+TEST_F(S3ObjectDataCopierTest, ReadDataBlockSuccessOutOfOrder) {
+  entity_under_test->bytes_left_to_read = 0;
+  entity_under_test->slots.resize(2);
+  entity_under_test->slots[1].reader =
+      ptr_mock_motr_reader_factory->mock_motr_reader;
+  entity_under_test->slots[1].state = S3ObjectDataCopier::SlotState::reading;
+  entity_under_test->slots[1].seq_no = 1;
+  entity_under_test->slots[1].length = 1024;
+  entity_under_test->slots[0].state = S3ObjectDataCopier::SlotState::reading;
+
+  S3BufferSequence data_blocks_read;
+  data_blocks_read.emplace_back(nullptr, 1024);
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              extract_blocks_read())
+      .Times(1)
+      .WillOnce(Return(data_blocks_read));
+  // Later chunk waits for the earlier one to be written first.
+  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer,
+              write_content(_, _, _, _)).Times(0);
+
+  entity_under_test->read_data_block_success(1);
 
-  EXPECT_TRUE(entity_under_test->write_in_progress);
+  EXPECT_EQ(S3ObjectDataCopier::SlotState::read,
+            entity_under_test->slots[1].state);
+  EXPECT_EQ(0, entity_under_test->next_write_seq_no);
+  EXPECT_FALSE(f_success);
+}
+
+TEST_F(S3ObjectDataCopierTest, ReadDataBlockSuccessStartsNextExtent) {
+  const size_t unit_size = entity_under_test->motr_unit_size;
+  entity_under_test->extents = {{0, 1024}, {4 * unit_size, 100}};
+  entity_under_test->next_extent_index = 1;
+
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              read_object_data(_, _, _))
+      .WillRepeatedly(Return(true));
+  EXPECT_TRUE(entity_under_test->read_data_block(0));
+  EXPECT_EQ(100, entity_under_test->bytes_left_to_read);
+  EXPECT_EQ(4 * unit_size, entity_under_test->read_offset);
+  EXPECT_EQ(2, entity_under_test->next_extent_index);
+
+  std::vector<char> data(unit_size);
+  S3BufferSequence data_blocks_read;
+  data_blocks_read.emplace_back(data.data(), data.size());
+
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              extract_blocks_read())
+      .Times(1)
+      .WillOnce(Return(data_blocks_read));
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              set_last_index(Eq(4 * unit_size))).Times(1);
+  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer,
+              write_content(_, _, _, _)).Times(1);
+  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer, get_state())
+      .Times(1);
+
+  entity_under_test->max_slots = 2;
+  entity_under_test->read_data_block_success(0);
+
+  EXPECT_EQ(S3ObjectDataCopier::SlotState::writing,
+            entity_under_test->slots[0].state);
+  EXPECT_EQ(1024, entity_under_test->slots[0].data_blocks[0].second);
+  ASSERT_EQ(2, entity_under_test->slots.size());
+  EXPECT_EQ(S3ObjectDataCopier::SlotState::reading,
+            entity_under_test->slots[1].state);
+  EXPECT_EQ(100, entity_under_test->slots[1].length);
+  EXPECT_EQ(0, entity_under_test->bytes_left_to_read);
+  entity_under_test->slots[0].data_blocks.clear();
 }
 
 TEST_F(S3ObjectDataCopierTest, ReadDataBlockFailed) {
 
-  entity_under_test->read_in_progress = true;
+  entity_under_test->slots[0].state = S3ObjectDataCopier::SlotState::reading;
 
   EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader, get_state())
       .Times(1);
 
-  entity_under_test->read_data_block_failed();
+  entity_under_test->read_data_block_failed(0);
 
-  EXPECT_FALSE(entity_under_test->read_in_progress);
+  EXPECT_EQ(S3ObjectDataCopier::SlotState::idle,
+            entity_under_test->slots[0].state);
   EXPECT_TRUE(entity_under_test->copy_failed);
   EXPECT_FALSE(entity_under_test->get_s3_error().empty());
   EXPECT_TRUE(f_failed);
@@ -199,7 +477,9 @@ TEST_F(S3ObjectDataCopierTest, ReadDataBlockFailed) {
 
 TEST_F(S3ObjectDataCopierTest, WriteObjectStarted) {
 
-  entity_under_test->data_blocks_read.emplace_back(nullptr, 0);
+  entity_under_test->slots[0].state = S3ObjectDataCopier::SlotState::read;
+  entity_under_test->slots[0].offset = 8192;
+  entity_under_test->slots[0].data_blocks.emplace_back(nullptr, 0);
 
   EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer,
               write_content(_, _, _, _)).Times(1);
@@ -207,39 +487,42 @@ TEST_F(S3ObjectDataCopierTest, WriteObjectStarted) {
       .Times(1)
       .WillOnce(Return(S3MotrWiterOpState::start));
 
-  entity_under_test->write_data_block();
+  entity_under_test->write_data_block(0);
 
-  EXPECT_TRUE(entity_under_test->write_in_progress);
-  EXPECT_TRUE(entity_under_test->data_blocks_read.empty());
-  EXPECT_FALSE(entity_under_test->data_blocks_writing.empty());
+  EXPECT_EQ(S3ObjectDataCopier::SlotState::writing,
+            entity_under_test->slots[0].state);
+  EXPECT_FALSE(entity_under_test->slots[0].data_blocks.empty());
+  EXPECT_EQ(1, entity_under_test->next_write_seq_no);
 }
 
 TEST_F(S3ObjectDataCopierTest, WriteObjectFailedShouldUndoMarkProgress) {
 
-  entity_under_test->write_in_progress = true;
+  entity_under_test->slots[0].state = S3ObjectDataCopier::SlotState::writing;
 
   EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer, get_state())
       .Times(1)
       .WillOnce(Return(S3MotrWiterOpState::failed));
 
-  entity_under_test->write_data_block_failed();
+  entity_under_test->write_data_block_failed(0);
 
   EXPECT_STREQ("InternalError", entity_under_test->get_s3_error().c_str());
-  EXPECT_FALSE(entity_under_test->write_in_progress);
+  EXPECT_EQ(S3ObjectDataCopier::SlotState::idle,
+            entity_under_test->slots[0].state);
   EXPECT_TRUE(f_failed);
 }
 
 TEST_F(S3ObjectDataCopierTest, WriteObjectFailedDuetoEntityOpenFailure) {
 
-  entity_under_test->write_in_progress = true;
+  entity_under_test->slots[0].state = S3ObjectDataCopier::SlotState::writing;
 
   EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer, get_state())
       .Times(1)
       .WillOnce(Return(S3MotrWiterOpState::failed_to_launch));
 
-  entity_under_test->write_data_block_failed();
+  entity_under_test->write_data_block_failed(0);
 
-  EXPECT_FALSE(entity_under_test->write_in_progress);
+  EXPECT_EQ(S3ObjectDataCopier::SlotState::idle,
+            entity_under_test->slots[0].state);
   EXPECT_STREQ("ServiceUnavailable", entity_under_test->get_s3_error().c_str());
   EXPECT_TRUE(f_failed);
 }
@@ -247,37 +530,40 @@ TEST_F(S3ObjectDataCopierTest, WriteObjectFailedDuetoEntityOpenFailure) {
 TEST_F(S3ObjectDataCopierTest, WriteObjectSuccessfulWhileShuttingDown) {
 
   entity_under_test->check_shutdown_and_rollback = &fn_true_cb;
-  entity_under_test->write_in_progress = true;
+  entity_under_test->slots[0].state = S3ObjectDataCopier::SlotState::writing;
 
-  entity_under_test->write_data_block_success();
+  entity_under_test->write_data_block_success(0);
 
-  EXPECT_FALSE(entity_under_test->write_in_progress);
+  EXPECT_EQ(S3ObjectDataCopier::SlotState::idle,
+            entity_under_test->slots[0].state);
+  EXPECT_FALSE(f_success);
 }
 
-TEST_F(S3ObjectDataCopierTest, WriteObjectSuccessfulShouldRestartWritingData) {
+TEST_F(S3ObjectDataCopierTest, WriteObjectSuccessfulShouldRestartReadingData) {
 
-  entity_under_test->write_in_progress = true;
-  entity_under_test->data_blocks_read.emplace_back(nullptr, 0);
+  entity_under_test->slots[0].state = S3ObjectDataCopier::SlotState::writing;
 
-  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer,
-              write_content(_, _, _, _)).Times(1);
-  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer, get_state())
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              read_object_data(_, _, _))
       .Times(1)
-      .WillOnce(Return(S3MotrWiterOpState::start));
+      .WillOnce(Return(true));
 
-  entity_under_test->write_data_block_success();
+  entity_under_test->write_data_block_success(0);
 
-  EXPECT_TRUE(entity_under_test->write_in_progress);
+  EXPECT_EQ(S3ObjectDataCopier::SlotState::reading,
+            entity_under_test->slots[0].state);
+  EXPECT_FALSE(f_success);
 }
 
 TEST_F(S3ObjectDataCopierTest,
        WriteObjectSuccessfulDoNextStepWhenAllIsWritten) {
 
-  entity_under_test->write_in_progress = true;
+  entity_under_test->slots[0].state = S3ObjectDataCopier::SlotState::writing;
   entity_under_test->bytes_left_to_read = 0;
 
-  entity_under_test->write_data_block_success();
+  entity_under_test->write_data_block_success(0);
 
-  EXPECT_FALSE(entity_under_test->write_in_progress);
+  EXPECT_EQ(S3ObjectDataCopier::SlotState::idle,
+            entity_under_test->slots[0].state);
   EXPECT_TRUE(f_success);
 }
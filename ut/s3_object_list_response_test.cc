@@ -221,6 +221,47 @@ TEST_F(S3ObjectListResponseTest,
   CHECK_XML_RESPONSE;
 }
 
+// Test entries serialized as they are added give the same xml as get_xml.
+TEST_F(S3ObjectListResponseTest, StreamingObjectListResponseMatchesGetXml) {
+  std::shared_ptr<S3ObjectListResponse> streamed_response =
+      std::make_shared<S3ObjectListResponse>();
+  for (auto &&response : {response_under_test, streamed_response}) {
+    response->set_bucket_name("test.bucket.name");
+    response->set_request_delimiter("/");
+    response->set_max_keys("1000");
+    response->add_common_prefix("prefix1/");
+  }
+  streamed_response->enable_streaming("qWwZGnGYTga8gbpcuY79SA", "1", "1");
+
+  std::shared_ptr<MockS3ObjectMetadata> mock_obj =
+      std::make_shared<MockS3ObjectMetadata>(mock_request);
+  EXPECT_CALL(*mock_obj, get_object_name()).WillRepeatedly(Return("obj1"));
+  EXPECT_CALL(*mock_obj, get_last_modified_iso())
+      .WillRepeatedly(Return("last_modified"));
+  EXPECT_CALL(*mock_obj, get_md5()).WillRepeatedly(Return("abcd"));
+  EXPECT_CALL(*mock_obj, get_content_length_str())
+      .WillRepeatedly(Return("1024"));
+  EXPECT_CALL(*mock_obj, get_storage_class())
+      .WillRepeatedly(Return("STANDARD"));
+  EXPECT_CALL(*mock_obj, get_canonical_id())
+      .WillRepeatedly(Return("qWwZGnGYTga8gbpcuY79SA"));
+  EXPECT_CALL(*mock_obj, get_account_name()).WillRepeatedly(Return("s3user"));
+
+  response_under_test->add_object(mock_obj);
+  streamed_response->add_object(mock_obj);
+
+  EXPECT_TRUE(streamed_response->is_streaming());
+  EXPECT_TRUE(streamed_response->object_list.empty());
+  EXPECT_EQ(1u, streamed_response->size());
+  std::string response = streamed_response->get_xml_head() +
+                         streamed_response->get_contents_xml() +
+                         streamed_response->get_xml_tail();
+  CHECK_XML_RESPONSE;
+  EXPECT_THAT(response, HasSubstr("<Owner>"));
+  EXPECT_EQ(response_under_test->get_xml("qWwZGnGYTga8gbpcuY79SA", "1", "1"),
+            response);
+}
+
 // Test get_multiupload_xml with valid object and result is truncated.
 TEST_F(S3ObjectListResponseTest,
        ObjectListMultiuploadResponseWithValidObjectTruncated) {
@@ -21,10 +21,12 @@
 #include <json/json.h>
 #include <memory>
 
+#include "base64.h"
 #include "mock_s3_factory.h"
 #include "mock_s3_request_object.h"
 #include "s3_callback_test_helpers.h"
 #include "s3_common.h"
+#include "s3_metadata_codec.h"
 #include "s3_object_metadata.h"
 #include "s3_test_utils.h"
 #include "s3_ut_common.h"
@@ -592,6 +594,116 @@ TEST_F(S3ObjectMetadataTest, FromJson) {
   EXPECT_TRUE(ret_status == 0);
 }
 
+TEST_F(S3ObjectMetadataTest, InlineDataToJsonFromJson) {
+  const std::string data("small\0object", 12);
+  struct m0_uint128 zero_oid = {0ULL, 0ULL};
+  metadata_obj_under_test->set_inline_data(data);
+  EXPECT_TRUE(metadata_obj_under_test->is_inline());
+  EXPECT_OID_EQ(zero_oid, metadata_obj_under_test->get_oid());
+
+  std::shared_ptr<S3ObjectMetadata> loaded(new S3ObjectMetadata(
+      ptr_mock_request, true, "1234-1234", motr_kvs_reader_factory,
+      motr_kvs_writer_factory, ptr_mock_s3_motr_api));
+  EXPECT_FALSE(loaded->is_inline());
+  EXPECT_EQ(0, loaded->from_json(metadata_obj_under_test->to_json()));
+  EXPECT_TRUE(loaded->is_inline());
+  EXPECT_EQ(data, loaded->get_inline_data());
+
+  // Objects stored in motr do not get the field.
+  EXPECT_EQ(0, metadata_obj_under_test_with_oid->from_json(
+                   metadata_obj_under_test_with_oid->to_json()));
+  EXPECT_FALSE(metadata_obj_under_test_with_oid->is_inline());
+}
+
+TEST_F(S3ObjectMetadataTest, ToBinaryFromBinary) {
+  const std::string acl_xml("<AccessControlPolicy/>\n");
+  metadata_obj_under_test->setacl(
+      base64_encode((const unsigned char*)acl_xml.c_str(), acl_xml.length()));
+  metadata_obj_under_test->set_content_length("1024");
+  metadata_obj_under_test->set_md5("abcd");
+  metadata_obj_under_test->add_user_defined_attribute("x-amz-meta-key",
+                                                       "va\0lue");
+  metadata_obj_under_test->set_tags({{"tag", "value"}});
+  metadata_obj_under_test->set_layout_id(9);
+
+  std::string record = metadata_obj_under_test->to_binary();
+  EXPECT_TRUE(s3_is_binary_metadata(record));
+  EXPECT_LT(record.length(), metadata_obj_under_test->to_json().length());
+
+  std::shared_ptr<S3ObjectMetadata> loaded(new S3ObjectMetadata(
+      ptr_mock_request, true, "1234-1234", motr_kvs_reader_factory,
+      motr_kvs_writer_factory, ptr_mock_s3_motr_api));
+  // Readers take both forms.
+  EXPECT_EQ(0, loaded->from_json(record));
+  EXPECT_EQ(metadata_obj_under_test->get_object_name(),
+            loaded->get_object_name());
+  EXPECT_EQ("1024", loaded->get_content_length_str());
+  EXPECT_EQ("abcd", loaded->get_md5());
+  EXPECT_EQ("va\0lue", loaded->get_user_defined_attribute("x-amz-meta-key"));
+  EXPECT_EQ("value", loaded->get_tags().at("tag"));
+  EXPECT_EQ(9, loaded->get_layout_id());
+  EXPECT_EQ(metadata_obj_under_test->get_encoded_object_acl(),
+            loaded->get_encoded_object_acl());
+  EXPECT_EQ(acl_xml, loaded->get_acl_as_xml());
+
+  std::shared_ptr<S3ObjectMetadata> listed(new S3ObjectMetadata(
+      ptr_mock_request, true, "1234-1234", motr_kvs_reader_factory,
+      motr_kvs_writer_factory, ptr_mock_s3_motr_api));
+  EXPECT_EQ(0, listed->from_listing_json(record));
+  EXPECT_EQ("1024", listed->get_content_length_str());
+  EXPECT_EQ(0u, listed->user_defined_attribute.size());
+
+  // Truncated record
+  record.resize(record.length() - 1);
+  EXPECT_EQ(-1, loaded->from_json(record));
+}
+
+TEST_F(S3ObjectMetadataTest, BinaryRecordAsJson) {
+  const std::string data("small\0object", 12);
+  metadata_obj_under_test->set_inline_data(data);
+  metadata_obj_under_test->add_user_defined_attribute("x-amz-meta-key", "v");
+
+  Json::Value from_json, from_binary;
+  Json::Reader reader;
+  std::string json;
+  ASSERT_TRUE(
+      s3_binary_metadata_to_json(metadata_obj_under_test->to_binary(), json));
+  ASSERT_TRUE(reader.parse(json, from_binary));
+  ASSERT_TRUE(reader.parse(metadata_obj_under_test->to_json(), from_json));
+  from_json.removeMember("create_timestamp");
+  from_binary.removeMember("create_timestamp");
+  EXPECT_EQ(from_json, from_binary);
+}
+
+TEST_F(S3ObjectMetadataTest, FromListingJson) {
+  std::string json_str =
+      "{\"ACL\":\"PD94+Cg==\",\"Bucket-Name\":\"seagatebucket\","
+      "\"Object-Name\":\"dir/obj\\\"1\",\"layout_id\":9,"
+      "\"System-Defined\":{\"Content-Length\":\"1024\","
+      "\"Content-MD5\":\"abcd\",\"Last-Modified\":\"last_modified\","
+      "\"Owner-Account\":\"s3user\",\"Owner-Canonical-id\":\"C12345\","
+      "\"x-amz-storage-class\":\"STANDARD\",\"x-amz-meta-ignored\":\"x\"},"
+      "\"User-Defined\":{\"x-amz-meta-key\":\"value\"}}";
+
+  EXPECT_EQ(0, metadata_obj_under_test->from_listing_json(json_str));
+  EXPECT_EQ("seagatebucket", metadata_obj_under_test->bucket_name);
+  EXPECT_EQ("dir/obj\"1", metadata_obj_under_test->get_object_name());
+  EXPECT_EQ("1024", metadata_obj_under_test->get_content_length_str());
+  EXPECT_EQ("abcd", metadata_obj_under_test->get_md5());
+  EXPECT_EQ("last_modified", metadata_obj_under_test->get_last_modified_iso());
+  EXPECT_EQ("STANDARD", metadata_obj_under_test->get_storage_class());
+  EXPECT_EQ("C12345", metadata_obj_under_test->get_canonical_id());
+  EXPECT_EQ("s3user", metadata_obj_under_test->get_account_name());
+  EXPECT_EQ(0u, metadata_obj_under_test->user_defined_attribute.size());
+  EXPECT_EQ(0u, metadata_obj_under_test->system_defined_attribute.count(
+                    "x-amz-meta-ignored"));
+}
+
+TEST_F(S3ObjectMetadataTest, FromListingJsonInvalidJson) {
+  EXPECT_EQ(-1, metadata_obj_under_test->from_listing_json(
+                    "{\"Object-Name\":\"obj"));
+}
+
 TEST_F(S3MultipartObjectMetadataTest, FromJson) {
   int ret_status;
   std::string json_str =
@@ -23,6 +23,8 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <sstream>
+#include <thread>
 #include "gtest/gtest.h"
 
 extern S3Option *g_option_instance;
@@ -493,6 +495,28 @@ TEST_F(S3OptionsTest, MissingOptions) {
   unlink(config_file.c_str());
 }
 
+TEST_F(S3OptionsTest, InlineObjectMaxSizeTooLarge) {
+  // s3config-test.yaml with a large S3_SERVER_OBJECT_INLINE_MAX_SIZE
+  std::ifstream test_cfg_file("s3config-test.yaml");
+  std::stringstream cfg;
+  cfg << test_cfg_file.rdbuf();
+  std::string cfg_str = cfg.str();
+  const std::string option("S3_SERVER_OBJECT_INLINE_MAX_SIZE: 0");
+  size_t pos = cfg_str.find(option);
+  ASSERT_NE(std::string::npos, pos);
+  cfg_str.replace(pos, option.length(),
+                  "S3_SERVER_OBJECT_INLINE_MAX_SIZE: 1048576");
+
+  std::string config_file("s3config-temp-test.yaml");
+  std::ofstream cfg_file(config_file);
+  cfg_file << cfg_str;
+  cfg_file.close();
+
+  instance->set_option_file(config_file);
+  EXPECT_FALSE(instance->load_section("S3_SERVER_CONFIG", true));
+  unlink(config_file.c_str());
+}
+
 TEST_F(S3OptionsTest, TestReloadOptionsfromFile) {
   // create a temporary yaml file
   std::ofstream cfg_file;
@@ -512,3 +536,22 @@ TEST_F(S3OptionsTest, TestReloadOptionsfromFile) {
   EXPECT_EQ(std::string("ERROR"), instance->get_log_level());
   unlink(config_file.c_str());
 }
+
+TEST_F(S3OptionsTest, ThreadEventbaseOverridesMainEventbase) {
+  evbase_t *main_evbase = event_base_new();
+  evbase_t *reactor_evbase = event_base_new();
+  evbase_t *evbase_in_reactor = NULL;
+  instance->set_eventbase(main_evbase);
+
+  std::thread reactor([&]() {
+    instance->set_thread_eventbase(reactor_evbase);
+    evbase_in_reactor = instance->get_eventbase();
+  });
+  reactor.join();
+
+  EXPECT_EQ(reactor_evbase, evbase_in_reactor);
+  EXPECT_EQ(main_evbase, instance->get_eventbase());
+  instance->set_eventbase(NULL);
+  event_base_free(reactor_evbase);
+  event_base_free(main_evbase);
+}
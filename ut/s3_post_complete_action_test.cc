@@ -476,6 +476,51 @@ TEST_F(S3PostCompleteActionTest, GetPartsSuccessful) {
   EXPECT_EQ(0, call_count_one);
 }
 
+TEST_F(S3PostCompleteActionTest, GetPartsOfAnySizeWithPartSlots) {
+  CREATE_KVS_READER_OBJ;
+  CREATE_MP_METADATA_OBJ;
+
+  result_keys_values.insert(std::make_pair("1", std::make_pair(10, "keyval1")));
+  result_keys_values.insert(std::make_pair("2", std::make_pair(11, "keyval2")));
+  result_keys_values.insert(std::make_pair("4", std::make_pair(12, "keyval4")));
+
+  EXPECT_CALL(*(motr_kvs_reader_factory->mock_motr_kvs_reader),
+              get_key_values()).WillRepeatedly(ReturnRef(result_keys_values));
+  EXPECT_CALL(*(object_mp_meta_factory->mock_object_mp_metadata),
+              get_part_one_size()).WillRepeatedly(Return(0));
+  EXPECT_CALL(*(object_mp_meta_factory->mock_object_mp_metadata),
+              get_part_slot_size())
+      .WillRepeatedly(Return(MAXIMUM_ALLOWED_PART_SIZE));
+
+  action_under_test_ptr->parts["1"] = "keyval1";
+  action_under_test_ptr->parts["2"] = "keyval2";
+  action_under_test_ptr->parts["4"] = "keyval4";
+  action_under_test_ptr->total_parts = "4";
+
+  EXPECT_CALL(*(part_meta_factory->mock_part_metadata), from_json(_))
+      .WillRepeatedly(Return(0));
+  // Parts differ in size, only the last one is below minimum part size.
+  EXPECT_CALL(*(part_meta_factory->mock_part_metadata), get_content_length())
+      .WillOnce(Return(MINIMUM_ALLOWED_PART_SIZE + 1))
+      .WillOnce(Return(MINIMUM_ALLOWED_PART_SIZE + 1))
+      .WillOnce(Return(MINIMUM_ALLOWED_PART_SIZE))
+      .WillOnce(Return(MINIMUM_ALLOWED_PART_SIZE))
+      .WillRepeatedly(Return(1024));
+  EXPECT_CALL(*(part_meta_factory->mock_part_metadata), get_md5())
+      .WillRepeatedly(Return("abcd"));
+
+  EXPECT_TRUE(action_under_test_ptr->validate_parts());
+  EXPECT_FALSE(action_under_test_ptr->is_abort_multipart());
+  EXPECT_TRUE(action_under_test_ptr->parts.empty());
+  EXPECT_EQ(2 * MINIMUM_ALLOWED_PART_SIZE + 1 + 1024,
+            action_under_test_ptr->object_size);
+  ASSERT_EQ(3, action_under_test_ptr->part_sizes.size());
+  EXPECT_EQ(MINIMUM_ALLOWED_PART_SIZE + 1,
+            action_under_test_ptr->part_sizes[1]);
+  EXPECT_EQ(MINIMUM_ALLOWED_PART_SIZE, action_under_test_ptr->part_sizes[2]);
+  EXPECT_EQ(1024, action_under_test_ptr->part_sizes[4]);
+}
+
 TEST_F(S3PostCompleteActionTest, GetPartsSuccessfulEntityTooSmall) {
   CREATE_KVS_READER_OBJ;
   CREATE_MP_METADATA_OBJ;
@@ -769,3 +814,21 @@ TEST_F(S3PostCompleteActionTest, StartCleanupAbortedSinceValidationFailed) {
   EXPECT_EQ(false, action_under_test_ptr->is_error_state());
   EXPECT_EQ(2, action_under_test_ptr->number_of_tasks());
 }
+
+TEST_F(S3PostCompleteActionTest, StartCleanupCompletedOverInlineObject) {
+  action_under_test_ptr->s3_post_complete_action_state =
+      S3PostCompleteActionState::completed;
+  action_under_test_ptr->old_object_oid = {0x0, 0x0};
+  action_under_test_ptr->object_metadata =
+      object_meta_factory->mock_object_metadata;
+  object_meta_factory->mock_object_metadata->set_inline_data("inline data");
+
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata), get_state())
+      .WillRepeatedly(Return(S3ObjectMetadataState::present));
+  // Old version of the object is removed, there is no old oid to delete.
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              remove_version_metadata(_, _)).Times(1);
+
+  action_under_test_ptr->startcleanup();
+  EXPECT_EQ(false, action_under_test_ptr->is_error_state());
+}
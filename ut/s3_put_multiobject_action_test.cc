@@ -619,6 +619,56 @@ TEST_F(S3PutMultipartObjectActionTestNoMockAuth, ComputePartOffsetNoChunk) {
   EXPECT_EQ(1, call_count_one);
 }
 
+TEST_F(S3PutMultipartObjectActionTestNoMockAuth,
+       ComputePartOffsetWithPartSlots) {
+  m0_uint128 oid = {0x1ffff, 0x1ffff};
+  action_under_test->object_multipart_metadata =
+      object_mp_meta_factory->mock_object_mp_metadata;
+  // Part 1 is not uploaded yet and part size is not unit aligned.
+  action_under_test->part_number = 3;
+
+  size_t unit_size =
+      S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(layout_id);
+  EXPECT_CALL(*object_mp_meta_factory->mock_object_mp_metadata,
+              get_part_slot_size())
+      .WillRepeatedly(Return(MAXIMUM_ALLOWED_PART_SIZE));
+  EXPECT_CALL(*object_mp_meta_factory->mock_object_mp_metadata,
+              get_part_one_size()).Times(0);
+  EXPECT_CALL(*ptr_mock_request, get_data_length())
+      .WillRepeatedly(Return(unit_size - 2));
+  EXPECT_CALL(*object_mp_meta_factory->mock_object_mp_metadata, get_layout_id())
+      .WillRepeatedly(Return(layout_id));
+  EXPECT_CALL(*object_mp_meta_factory->mock_object_mp_metadata, get_oid())
+      .WillRepeatedly(Return(oid));
+
+  action_under_test->clear_tasks();
+  ACTION_TASK_ADD_OBJPTR(action_under_test,
+                         S3PutMultipartObjectActionTest::func_callback_one,
+                         this);
+  action_under_test->compute_part_offset();
+  EXPECT_TRUE(action_under_test->motr_writer != nullptr);
+  EXPECT_EQ(1, call_count_one);
+}
+
+TEST_F(S3PutMultipartObjectActionTestNoMockAuth,
+       ComputePartOffsetWithPartSlotsEntityTooLarge) {
+  action_under_test->object_multipart_metadata =
+      object_mp_meta_factory->mock_object_mp_metadata;
+  action_under_test->part_number = 2;
+
+  EXPECT_CALL(*object_mp_meta_factory->mock_object_mp_metadata,
+              get_part_slot_size()).WillRepeatedly(Return(1048576));
+  EXPECT_CALL(*ptr_mock_request, get_data_length())
+      .WillRepeatedly(Return(1048577));
+  EXPECT_CALL(*ptr_mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
+  EXPECT_CALL(*ptr_mock_request, send_response(413, _)).Times(1);
+  EXPECT_CALL(*ptr_mock_request, resume(_)).Times(1);
+
+  action_under_test->compute_part_offset();
+  EXPECT_STREQ("EntityTooLarge",
+               action_under_test->get_s3_error_code().c_str());
+}
+
 TEST_F(S3PutMultipartObjectActionTestWithMockAuth,
        InitiateDataStreamingForZeroSizeObject) {
   action_under_test->motr_writer = motr_writer_factory->mock_motr_writer;
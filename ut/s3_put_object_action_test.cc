@@ -793,6 +793,134 @@ TEST_F(S3PutObjectActionTest, DelayedDeleteOldObject) {
   EXPECT_EQ(1, call_count_one);
 }
 
+TEST_F(S3PutObjectActionTest, SmallObjectIsStoredInline) {
+  std::map<std::string, std::string> input_headers;
+  EXPECT_CALL(*ptr_mock_request, get_object_name())
+      .WillRepeatedly(ReturnRef(object_name));
+  EXPECT_CALL(*(ptr_mock_request), get_header_value(StrEq("x-amz-tagging")))
+      .WillRepeatedly(Return(""));
+  EXPECT_CALL(*ptr_mock_request, get_in_headers_copy())
+      .WillRepeatedly(ReturnRef(input_headers));
+  EXPECT_CALL(*ptr_mock_request, get_content_length())
+      .WillOnce(Return(4096))
+      .WillOnce(Return(4097));
+
+  S3Option::get_instance()->set_s3server_object_inline_max_size(4096);
+  action_under_test.reset(new S3PutObjectAction(
+      ptr_mock_request, ptr_mock_s3_motr_api, bucket_meta_factory,
+      object_meta_factory, motr_writer_factory, bucket_tag_body_factory_mock,
+      motr_kvs_writer_factory));
+  EXPECT_TRUE(action_under_test->store_inline);
+
+  action_under_test.reset(new S3PutObjectAction(
+      ptr_mock_request, ptr_mock_s3_motr_api, bucket_meta_factory,
+      object_meta_factory, motr_writer_factory, bucket_tag_body_factory_mock,
+      motr_kvs_writer_factory));
+  EXPECT_FALSE(action_under_test->store_inline);
+  S3Option::get_instance()->set_s3server_object_inline_max_size(0);
+}
+
+TEST_F(S3PutObjectActionTest, CreateInlineObject) {
+  CREATE_OBJECT_METADATA;
+  std::string data = "inline data";
+
+  action_under_test->store_inline = true;
+  EXPECT_CALL(*ptr_mock_request, get_full_body_content_as_string())
+      .WillOnce(ReturnRef(data));
+  EXPECT_CALL(*(motr_writer_factory->mock_motr_writer), create_object(_, _, _))
+      .Times(0);
+  EXPECT_CALL(*(motr_kvs_writer_factory->mock_motr_kvs_writer),
+              put_keyval(_, _, _, _)).Times(0);
+
+  action_under_test->clear_tasks();
+  ACTION_TASK_ADD_OBJPTR(action_under_test,
+                         S3PutObjectActionTest::func_callback_one, this);
+
+  action_under_test->create_inline_object();
+
+  EXPECT_EQ(1, call_count_one);
+  EXPECT_EQ(S3PutObjectActionState::writeComplete,
+            action_under_test->s3_put_action_state);
+  EXPECT_TRUE(action_under_test->new_object_metadata->is_inline());
+  EXPECT_EQ(data, action_under_test->new_object_metadata->get_inline_data());
+  EXPECT_EQ("0d87bfea7f8c74c9c67eefde4fddaa32",
+            action_under_test->get_content_md5());
+}
+
+TEST_F(S3PutObjectActionTest, CreateInlineObjectOverwrite) {
+  CREATE_OBJECT_METADATA;
+  std::string data = "inline data";
+
+  action_under_test->store_inline = true;
+  action_under_test->old_object_oid = old_object_oid;
+  action_under_test->old_oid_str = S3M0Uint128Helper::to_string(old_object_oid);
+  action_under_test->old_layout_id = old_layout_id;
+  EXPECT_CALL(*ptr_mock_request, get_full_body_content_as_string())
+      .WillOnce(ReturnRef(data));
+  EXPECT_CALL(*(motr_kvs_writer_factory->mock_motr_kvs_writer),
+              put_keyval(_, _, _, _)).Times(1);
+
+  action_under_test->create_inline_object();
+
+  // Only old object has a motr object to be deleted later.
+  EXPECT_TRUE(action_under_test->old_probable_del_rec != nullptr);
+  EXPECT_TRUE(action_under_test->new_probable_del_rec == nullptr);
+}
+
+TEST_F(S3PutObjectActionTest, SaveMetadataOfInlineObject) {
+  CREATE_BUCKET_METADATA;
+  std::string data = "inline data";
+  std::map<std::string, std::string> input_headers;
+
+  action_under_test->store_inline = true;
+  action_under_test->inline_data_md5.Update(data.c_str(), data.length());
+  action_under_test->new_object_metadata =
+      object_meta_factory->mock_object_metadata;
+
+  EXPECT_CALL(*ptr_mock_request, get_header_value("content-md5"))
+      .WillOnce(Return("DYe/6n+MdMnGfu/eT92qMg=="));
+  EXPECT_CALL(*ptr_mock_request, get_header_value("Content-Type"))
+      .WillOnce(Return(""));
+  EXPECT_CALL(*ptr_mock_request, get_data_length_str()).WillOnce(Return("11"));
+  EXPECT_CALL(*ptr_mock_request, get_in_headers_copy())
+      .WillOnce(ReturnRef(input_headers));
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              reset_date_time_to_current()).Times(1);
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              set_content_length(Eq("11"))).Times(1);
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata),
+              set_md5(Eq("0d87bfea7f8c74c9c67eefde4fddaa32"))).Times(1);
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata), set_tags(_))
+      .Times(1);
+  EXPECT_CALL(*(object_meta_factory->mock_object_metadata), save(_, _))
+      .Times(1);
+
+  action_under_test->save_metadata();
+  EXPECT_FALSE(action_under_test->is_error_state());
+}
+
+TEST_F(S3PutObjectActionTest, CleanupAfterInlineObjectOverwrite) {
+  action_under_test->store_inline = true;
+  action_under_test->s3_put_action_state = S3PutObjectActionState::completed;
+  action_under_test->old_object_oid = old_object_oid;
+  action_under_test->old_oid_str = S3M0Uint128Helper::to_string(old_object_oid);
+  action_under_test->new_oid_str = S3M0Uint128Helper::to_string(oid);
+  action_under_test->old_probable_del_rec.reset(new S3ProbableDeleteRecord(
+      action_under_test->old_oid_str + '-' + action_under_test->new_oid_str,
+      {0ULL, 0ULL}, object_name, old_object_oid, old_layout_id,
+      object_list_indx_oid, objects_version_list_idx_oid, "",
+      false /* force_delete */));
+
+  // Old oid is marked for deletion first, new oid has no record to remove.
+  EXPECT_CALL(*(motr_kvs_writer_factory->mock_motr_kvs_writer),
+              put_keyval(_, _, _, _, _)).Times(1);
+  EXPECT_CALL(*(motr_kvs_writer_factory->mock_motr_kvs_writer),
+              delete_keyval(_, _, _, _)).Times(0);
+
+  action_under_test->startcleanup();
+  EXPECT_EQ(2u, action_under_test->number_of_tasks());
+}
+
 TEST_F(S3PutObjectActionTest, ConsumeIncomingContentRequestTimeout) {
   ptr_mock_request->s3_client_read_error = "RequestTimeout";
   EXPECT_CALL(*ptr_mock_request, set_out_header_value(_, _)).Times(AtLeast(1));
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "s3_qos_scheduler.h"
+
+using std::chrono::milliseconds;
+
+TEST(S3TokenBucketTest, LimitsRate) {
+  auto now = std::chrono::steady_clock::now();
+  S3TokenBucket bucket(10, 1000, now);
+  EXPECT_TRUE(bucket.is_full());
+  EXPECT_EQ(0, bucket.get_wait_usec(10));
+  bucket.take(10);
+  EXPECT_NEAR(100000, bucket.get_wait_usec(1), 1);
+  bucket.refill(now + milliseconds(50));
+  EXPECT_NEAR(50000, bucket.get_wait_usec(1), 1);
+  bucket.refill(now + milliseconds(5000));
+  EXPECT_TRUE(bucket.is_full());
+}
+
+TEST(S3TokenBucketTest, LargeRequestLeavesDebt) {
+  auto now = std::chrono::steady_clock::now();
+  S3TokenBucket bucket(10, 1000, now);
+  // More than the burst is let through once the bucket is full
+  EXPECT_EQ(0, bucket.get_wait_usec(25));
+  bucket.take(25);
+  EXPECT_NEAR(1500000, bucket.get_wait_usec(0), 1);
+}
+
+TEST(S3TokenBucketTest, Unlimited) {
+  S3TokenBucket bucket;
+  EXPECT_FALSE(bucket.is_limited());
+  bucket.take(1000);
+  EXPECT_EQ(0, bucket.get_wait_usec(1000));
+  EXPECT_TRUE(bucket.is_full());
+}
+
+class S3QosSchedulerTest : public testing::Test {
+ protected:
+  S3QosScheduler::Config config;
+  std::unique_ptr<S3QosScheduler> scheduler;
+  // Number of requests the memory pool can take, checks take one.
+  size_t memory_slots = 1000;
+  // Free memory of the pool, unchanged as admitted requests do not use it.
+  size_t pool_free = SIZE_MAX;
+  std::vector<int64_t> wakeups;
+  std::vector<std::string> admitted;
+  std::vector<std::unique_ptr<S3QosTicket>> tickets;
+  int rejected = 0;
+
+  void create_scheduler() {
+    scheduler.reset(new S3QosScheduler(
+        config,
+        [this](size_t memory) {
+          if (memory_slots == 0 || memory > pool_free) {
+            return false;
+          }
+          --memory_slots;
+          return true;
+        },
+        [this](int64_t usec) { wakeups.push_back(usec); }));
+    S3QosScheduler::set_instance(scheduler.get());
+  }
+
+  void TearDown() override {
+    tickets.clear();
+    S3QosScheduler::set_instance(NULL);
+  }
+
+  S3QosRequest make_request(const std::string& account,
+                            const std::string& bucket = "bucket",
+                            size_t memory = 0) {
+    S3QosRequest request;
+    request.account = account;
+    request.bucket = bucket;
+    request.memory = memory;
+    request.admit = [this, account](std::unique_ptr<S3QosTicket> ticket) {
+      admitted.push_back(account);
+      tickets.push_back(std::move(ticket));
+    };
+    request.reject = [this]() { ++rejected; };
+    return request;
+  }
+};
+
+TEST_F(S3QosSchedulerTest, AdmitsRightAwayWithinLimits) {
+  create_scheduler();
+  std::unique_ptr<S3QosTicket> ticket = scheduler->submit(make_request("A"));
+  ASSERT_TRUE(ticket != nullptr);
+  EXPECT_EQ("A", ticket->account);
+  EXPECT_EQ("bucket", ticket->bucket);
+  EXPECT_TRUE(admitted.empty());
+  EXPECT_EQ(0, rejected);
+  EXPECT_TRUE(wakeups.empty());
+}
+
+TEST_F(S3QosSchedulerTest, IopsLimitQueuesRequests) {
+  config.account_iops_limit = 1;
+  config.metrics_enabled = true;
+  create_scheduler();
+  auto ticket = scheduler->submit(make_request("A"));
+  EXPECT_TRUE(ticket != nullptr);
+  EXPECT_TRUE(scheduler->submit(make_request("A")) == nullptr);
+  EXPECT_EQ(1, scheduler->get_queue_depth("A", "bucket"));
+  ASSERT_EQ(1, wakeups.size());
+  EXPECT_LT(0, wakeups[0]);
+  EXPECT_GE(1000000, wakeups[0]);
+  // Other access keys are not limited by it
+  EXPECT_TRUE(scheduler->submit(make_request("B")) != nullptr);
+
+  auto metrics = scheduler->collect_metrics();
+  ASSERT_EQ(2, metrics.size());
+  EXPECT_EQ("A", metrics[0].account);
+  EXPECT_EQ(1, metrics[0].queue_depth);
+  EXPECT_EQ(1, metrics[0].admitted);
+  EXPECT_EQ(1, metrics[0].queued);
+  EXPECT_EQ(1, metrics[0].throttled);
+  EXPECT_EQ(0, metrics[1].queued);
+}
+
+TEST_F(S3QosSchedulerTest, BucketLimitIsShared) {
+  config.bucket_iops_limit = 1;
+  create_scheduler();
+  auto ticket = scheduler->submit(make_request("A", "bucket1"));
+  EXPECT_TRUE(ticket != nullptr);
+  EXPECT_TRUE(scheduler->submit(make_request("B", "bucket1")) == nullptr);
+  EXPECT_TRUE(scheduler->submit(make_request("B", "bucket2")) != nullptr);
+}
+
+TEST_F(S3QosSchedulerTest, FullQueueRejects) {
+  config.account_iops_limit = 1;
+  config.max_queue_depth = 1;
+  create_scheduler();
+  auto ticket = scheduler->submit(make_request("A"));
+  EXPECT_TRUE(scheduler->submit(make_request("A")) == nullptr);
+  EXPECT_EQ(0, rejected);
+  EXPECT_TRUE(scheduler->submit(make_request("A")) == nullptr);
+  EXPECT_EQ(1, rejected);
+  EXPECT_EQ(1, scheduler->get_queue_depth("A", "bucket"));
+}
+
+TEST_F(S3QosSchedulerTest, RequestWaitingTooLongIsRejected) {
+  config.account_iops_limit = 1;
+  config.max_queue_wait_msec = 1;
+  create_scheduler();
+  auto ticket = scheduler->submit(make_request("A"));
+  EXPECT_TRUE(scheduler->submit(make_request("A")) == nullptr);
+  std::this_thread::sleep_for(milliseconds(2));
+  scheduler->wakeup();
+  EXPECT_EQ(1, rejected);
+  EXPECT_TRUE(admitted.empty());
+  EXPECT_EQ(0, scheduler->get_queue_depth("A", "bucket"));
+}
+
+TEST_F(S3QosSchedulerTest, WaitsForMemory) {
+  memory_slots = 0;
+  create_scheduler();
+  EXPECT_TRUE(scheduler->submit(make_request("A", "bucket", 100)) == nullptr);
+  // Requests without memory needs are not held back
+  EXPECT_TRUE(scheduler->submit(make_request("A", "bucket2")) != nullptr);
+  ASSERT_FALSE(wakeups.empty());
+
+  memory_slots = 1;
+  scheduler->wakeup();
+  ASSERT_EQ(1, admitted.size());
+  EXPECT_EQ(100, tickets[0]->memory);
+}
+
+TEST_F(S3QosSchedulerTest, MemoryIsSharedFairly) {
+  config.memory_budget = 100;
+  create_scheduler();
+  std::unique_ptr<S3QosTicket> a1 =
+      scheduler->submit(make_request("A", "bucket", 40));
+  std::unique_ptr<S3QosTicket> b1 =
+      scheduler->submit(make_request("B", "bucket", 40));
+  ASSERT_TRUE(a1 != nullptr);
+  ASSERT_TRUE(b1 != nullptr);
+  // Each of the two access keys may hold half of the budget
+  EXPECT_TRUE(scheduler->submit(make_request("A", "bucket", 40)) == nullptr);
+  EXPECT_TRUE(scheduler->submit(make_request("B", "bucket", 40)) == nullptr);
+
+  a1.reset();
+  ASSERT_EQ(1, admitted.size());
+  EXPECT_EQ("A", admitted[0]);
+}
+
+TEST_F(S3QosSchedulerTest, AdmittedMemoryIsReserved) {
+  pool_free = 100;
+  create_scheduler();
+  std::unique_ptr<S3QosTicket> a1 =
+      scheduler->submit(make_request("A", "bucket", 40));
+  std::unique_ptr<S3QosTicket> b1 =
+      scheduler->submit(make_request("B", "bucket", 40));
+  ASSERT_TRUE(a1 != nullptr);
+  ASSERT_TRUE(b1 != nullptr);
+  // Pool is still free, but 80 of it is promised to admitted requests
+  EXPECT_TRUE(scheduler->submit(make_request("C", "bucket", 40)) == nullptr);
+  scheduler->wakeup();
+  EXPECT_TRUE(admitted.empty());
+
+  a1.reset();
+  ASSERT_EQ(1, admitted.size());
+  EXPECT_EQ("C", admitted[0]);
+}
+
+TEST_F(S3QosSchedulerTest, QueuesAreServedByWeight) {
+  config.account_weights["A"] = 3;
+  memory_slots = 0;
+  create_scheduler();
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_TRUE(scheduler->submit(make_request("A", "bucket", 1)) == nullptr);
+  }
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_TRUE(scheduler->submit(make_request("B", "bucket", 1)) == nullptr);
+  }
+  // Memory for one request at a time
+  for (int i = 0; i < 8; ++i) {
+    memory_slots = 1;
+    scheduler->wakeup();
+  }
+  std::vector<std::string> expected = {"A", "A", "A", "B",
+                                       "A", "A", "A", "B"};
+  EXPECT_EQ(expected, admitted);
+}
+
+TEST_F(S3QosSchedulerTest, ResponseBytesAreCharged) {
+  config.account_bandwidth_limit = 1000;
+  create_scheduler();
+  std::unique_ptr<S3QosTicket> ticket = scheduler->submit(make_request("A"));
+  ASSERT_TRUE(ticket != nullptr);
+  ticket->bytes_sent = 5000;
+  ticket.reset();
+  EXPECT_TRUE(scheduler->submit(make_request("A")) == nullptr);
+  ASSERT_FALSE(wakeups.empty());
+  EXPECT_LT(3000000, wakeups.back());
+}
+
+TEST_F(S3QosSchedulerTest, UnverifiedRequestIsChargedOnceAuthenticated) {
+  config.account_iops_limit = 1;
+  config.account_bandwidth_limit = 1000;
+  create_scheduler();
+  S3QosRequest request = make_request("A");
+  request.charge_on_admission = false;
+  std::unique_ptr<S3QosTicket> forged = scheduler->submit(request);
+  ASSERT_TRUE(forged != nullptr);
+  EXPECT_FALSE(forged->charged);
+  // Neither the request nor its response drain limits of "A"
+  forged->bytes_sent = 5000;
+  forged.reset();
+
+  std::unique_ptr<S3QosTicket> ticket = scheduler->submit(request);
+  ASSERT_TRUE(ticket != nullptr);
+  scheduler->charge(*ticket);
+  EXPECT_TRUE(ticket->charged);
+  EXPECT_TRUE(scheduler->submit(make_request("A")) == nullptr);
+}
+
+TEST_F(S3QosSchedulerTest, IdleStateIsForgotten) {
+  create_scheduler();
+  std::unique_ptr<S3QosTicket> ticket =
+      scheduler->submit(make_request("A", "bucket", 10));
+  ASSERT_TRUE(ticket != nullptr);
+  EXPECT_EQ(1, scheduler->accounts.size());
+  EXPECT_EQ(1, scheduler->buckets.size());
+  ticket.reset();
+  EXPECT_TRUE(scheduler->accounts.empty());
+  EXPECT_TRUE(scheduler->buckets.empty());
+  EXPECT_TRUE(scheduler->queues.empty());
+  EXPECT_EQ(0, scheduler->accounts_using_memory);
+}
@@ -30,6 +30,7 @@ using ::testing::Return;
 using ::testing::_;
 using ::testing::InSequence;
 using testing::SetErrnoAndReturn;
+using ::testing::Invoke;
 
 extern S3Option* g_option_instance;
 extern S3Stats* g_stats_instance;
@@ -281,3 +282,93 @@ TEST_F(S3StatsTest, S3StatsCountUniqueCallMustNotFailForValidSocketCalls) {
   // again calls send.
   EXPECT_NE(s3_stats_under_test->count_unique("internal_error_count", "1"), -1);
 }
+
+/* Unit test that verifies counters are summed up and sent in one packet when
+ * aggregation is enabled.*/
+TEST_F(S3StatsTest, AggregatedCountersAreSentOnFlush) {
+  std::vector<std::string> packets;
+  EXPECT_CALL(*mock_socket, sendto(_, _, _, _, _, _))
+      .WillOnce(Invoke([&packets](int, const void* buf, size_t len, int,
+                                  const struct sockaddr*, socklen_t) {
+        packets.emplace_back((const char*)buf, len);
+        return (ssize_t)len;
+      }));
+  s3_stats_under_test->aggregate = true;
+
+  EXPECT_EQ(0, s3_stats_under_test->count("internal_error_count", 1));
+  EXPECT_EQ(0, s3_stats_under_test->count("internal_error_count", 2));
+  EXPECT_EQ(0, s3_stats_under_test->count("xyz", 1));
+  EXPECT_EQ(0, s3_stats_under_test->flush());
+
+  ASSERT_EQ(1, packets.size());
+  EXPECT_EQ("internal_error_count:3|c", packets[0]);
+
+  // Nothing new to send
+  EXPECT_EQ(0, s3_stats_under_test->flush());
+}
+
+/* Unit test that verifies timings are sent as count and percentiles when
+ * aggregation is enabled.*/
+TEST_F(S3StatsTest, AggregatedTimingsAreSentAsPercentiles) {
+  std::vector<std::string> packets;
+  EXPECT_CALL(*mock_socket, sendto(_, _, _, _, _, _))
+      .WillOnce(Invoke([&packets](int, const void* buf, size_t len, int,
+                                  const struct sockaddr*, socklen_t) {
+        packets.emplace_back((const char*)buf, len);
+        return (ssize_t)len;
+      }));
+  s3_stats_under_test->aggregate = true;
+
+  for (size_t time_ms = 1; time_ms <= 100; ++time_ms) {
+    s3_stats_under_test->timing("total_request_time", time_ms);
+  }
+  EXPECT_EQ(0, s3_stats_under_test->flush());
+
+  ASSERT_EQ(1, packets.size());
+  EXPECT_EQ(
+      "total_request_time.count:100|c\n"
+      "total_request_time.p50:50|g\n"
+      "total_request_time.p90:91|g\n"
+      "total_request_time.p99:99|g\n"
+      "total_request_time.max:100|g",
+      packets[0]);
+}
+
+/* Unit test that verifies metrics which do not fit into a packet are sent in
+ * the next one.*/
+TEST_F(S3StatsTest, FlushSplitsPacketsAtMaxPacketSize) {
+  EXPECT_CALL(*mock_socket, sendto(_, _, _, _, _, _)).WillOnce(Return(1));
+
+  const std::string line(g_option_instance->get_statsd_max_packet_size() / 2,
+                         'a');
+  std::string packet;
+  EXPECT_EQ(0, s3_stats_under_test->add_to_packet(packet, line));
+  EXPECT_EQ(line, packet);
+  // Does not fit with the separator, the first line is sent
+  EXPECT_EQ(0, s3_stats_under_test->add_to_packet(packet, line));
+  EXPECT_EQ(line, packet);
+}
+
+TEST(S3StatsHistogramTest, Percentiles) {
+  S3StatsHistogram histogram;
+  EXPECT_EQ(0, histogram.percentile(50));
+
+  for (size_t value = 0; value < 1000; ++value) {
+    histogram.record(value);
+  }
+  EXPECT_EQ(1000, histogram.count());
+  EXPECT_EQ(999, histogram.max());
+  // Large values are bucketed with ~6% precision
+  EXPECT_NEAR(500, histogram.percentile(50), 500 / 16);
+  EXPECT_NEAR(990, histogram.percentile(99), 990 / 16);
+
+  S3StatsHistogram other;
+  other.record(5000);
+  histogram.merge(other);
+  EXPECT_EQ(1001, histogram.count());
+  EXPECT_EQ(5000, histogram.max());
+  EXPECT_EQ(5000, histogram.percentile(100));
+
+  histogram.reset();
+  EXPECT_EQ(0, histogram.count());
+}
@@ -0,0 +1,463 @@
+/*
+ * Copyright (c) 2020 Seagate Technology LLC and/or its Affiliates
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For any questions about this software or licensing,
+ * please email opensource@seagate.com or cortx-questions@seagate.com.
+ *
+ */
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "mock_s3_factory.h"
+#include "s3_motr_layout.h"
+#include "s3_option.h"
+#include "s3_upload_part_copy_action.h"
+#include "s3_ut_common.h"
+#include "s3_test_utils.h"
+
+using ::testing::AtLeast;
+using ::testing::Eq;
+using ::testing::HasSubstr;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::ReturnRef;
+using ::testing::_;
+
+class S3UploadPartCopyActionTest : public testing::Test {
+ protected:
+  S3UploadPartCopyActionTest();
+  void SetUp() override;
+
+  std::shared_ptr<MockS3RequestObject> ptr_mock_request;
+  std::shared_ptr<MockS3Motr> ptr_mock_s3_motr_api;
+  std::shared_ptr<MockS3BucketMetadataFactory> ptr_mock_bucket_meta_factory;
+  std::shared_ptr<MockS3ObjectMetadataFactory> ptr_mock_object_meta_factory;
+  std::shared_ptr<MockS3ObjectMultipartMetadataFactory>
+      ptr_mock_object_mp_meta_factory;
+  std::shared_ptr<MockS3PartMetadataFactory> ptr_mock_part_meta_factory;
+  std::shared_ptr<MockS3MotrWriterFactory> ptr_mock_motr_writer_factory;
+  std::shared_ptr<MockS3MotrReaderFactory> ptr_mock_motr_reader_factory;
+
+  std::unique_ptr<S3UploadPartCopyAction> action_under_test;
+
+  struct m0_uint128 oid = {0x1ffff, 0x1ffff};
+  struct m0_uint128 src_oid = {0x1fff0, 0x1fff0};
+  int layout_id;
+  size_t unit_size;
+  std::string upload_id = "upload_id";
+  std::string bucket_name = "destination-bucket";
+  std::string object_name = "destination-object";
+  std::map<std::string, std::string> input_headers;
+  int call_count_one;
+
+  // Source object metadata as fetched.
+  void use_source_object(size_t content_length);
+
+ public:
+  void func_callback_one() { ++call_count_one; }
+};
+
+S3UploadPartCopyActionTest::S3UploadPartCopyActionTest() {
+  S3Option::get_instance()->disable_auth();
+
+  layout_id =
+      S3MotrLayoutMap::get_instance()->get_best_layout_for_object_size();
+  unit_size =
+      S3MotrLayoutMap::get_instance()->get_unit_size_for_layout(layout_id);
+
+  ptr_mock_s3_motr_api = std::make_shared<MockS3Motr>();
+  EXPECT_CALL(*ptr_mock_s3_motr_api, m0_h_ufid_next(_))
+      .WillRepeatedly(Invoke(dummy_helpers_ufid_next));
+
+  ptr_mock_request =
+      std::make_shared<MockS3RequestObject>(nullptr, new EvhtpWrapper());
+
+  input_headers["Authorization"] = "1";
+  EXPECT_CALL(*ptr_mock_request, get_in_headers_copy()).Times(1).WillOnce(
+      ReturnRef(input_headers));
+  EXPECT_CALL(*ptr_mock_request, get_bucket_name())
+      .WillRepeatedly(ReturnRef(bucket_name));
+  EXPECT_CALL(*ptr_mock_request, get_object_name())
+      .WillRepeatedly(ReturnRef(object_name));
+  EXPECT_CALL(*ptr_mock_request, get_query_string_value("uploadId"))
+      .WillRepeatedly(Return(upload_id));
+  EXPECT_CALL(*ptr_mock_request, get_query_string_value("partNumber"))
+      .WillRepeatedly(Return("2"));
+  EXPECT_CALL(*ptr_mock_request, get_headers_copysource())
+      .WillRepeatedly(Return("source-bucket/source-object"));
+
+  ptr_mock_bucket_meta_factory =
+      std::make_shared<MockS3BucketMetadataFactory>(ptr_mock_request);
+  ptr_mock_object_meta_factory = std::make_shared<MockS3ObjectMetadataFactory>(
+      ptr_mock_request, ptr_mock_s3_motr_api);
+  ptr_mock_object_mp_meta_factory =
+      std::make_shared<MockS3ObjectMultipartMetadataFactory>(
+          ptr_mock_request, ptr_mock_s3_motr_api, upload_id);
+  ptr_mock_part_meta_factory = std::make_shared<MockS3PartMetadataFactory>(
+      ptr_mock_request, oid, upload_id, 2);
+  ptr_mock_motr_writer_factory = std::make_shared<MockS3MotrWriterFactory>(
+      ptr_mock_request, oid, ptr_mock_s3_motr_api);
+  ptr_mock_motr_reader_factory = std::make_shared<MockS3MotrReaderFactory>(
+      ptr_mock_request, src_oid, layout_id);
+}
+
+void S3UploadPartCopyActionTest::SetUp() {
+  action_under_test.reset(new S3UploadPartCopyAction(
+      ptr_mock_request, ptr_mock_s3_motr_api, ptr_mock_bucket_meta_factory,
+      ptr_mock_object_meta_factory, ptr_mock_object_mp_meta_factory,
+      ptr_mock_part_meta_factory, ptr_mock_motr_writer_factory,
+      ptr_mock_motr_reader_factory));
+  call_count_one = 0;
+}
+
+void S3UploadPartCopyActionTest::use_source_object(size_t content_length) {
+  action_under_test->source_object_metadata =
+      ptr_mock_object_meta_factory->mock_object_metadata;
+  EXPECT_CALL(*ptr_mock_object_meta_factory->mock_object_metadata,
+              get_content_length()).WillRepeatedly(Return(content_length));
+  EXPECT_CALL(*ptr_mock_object_meta_factory->mock_object_metadata,
+              get_layout_id()).WillRepeatedly(Return(layout_id));
+  EXPECT_CALL(*ptr_mock_object_meta_factory->mock_object_metadata, get_oid())
+      .WillRepeatedly(Return(src_oid));
+}
+
+TEST_F(S3UploadPartCopyActionTest, ConstructorTest) {
+  EXPECT_EQ(2, action_under_test->part_number);
+  EXPECT_EQ(upload_id, action_under_test->upload_id);
+  EXPECT_EQ(-1, action_under_test->layout_id);
+  EXPECT_FALSE(action_under_test->has_copy_range);
+  EXPECT_NE(0, action_under_test->number_of_tasks());
+}
+
+TEST_F(S3UploadPartCopyActionTest, ParseCopySourceRange) {
+  EXPECT_TRUE(action_under_test->parse_copy_source_range("bytes=0-99"));
+  EXPECT_EQ(0, action_under_test->first_byte);
+  EXPECT_EQ(99, action_under_test->last_byte);
+
+  EXPECT_TRUE(action_under_test->parse_copy_source_range("bytes=100-100"));
+  EXPECT_EQ(100, action_under_test->first_byte);
+  EXPECT_EQ(100, action_under_test->last_byte);
+}
+
+TEST_F(S3UploadPartCopyActionTest, ParseCopySourceRangeInvalid) {
+  EXPECT_FALSE(action_under_test->parse_copy_source_range("0-99"));
+  EXPECT_FALSE(action_under_test->parse_copy_source_range("bytes="));
+  EXPECT_FALSE(action_under_test->parse_copy_source_range("bytes=-99"));
+  EXPECT_FALSE(action_under_test->parse_copy_source_range("bytes=10-"));
+  EXPECT_FALSE(action_under_test->parse_copy_source_range("bytes=20-10"));
+  EXPECT_FALSE(action_under_test->parse_copy_source_range("bytes=a-b"));
+  EXPECT_FALSE(action_under_test->parse_copy_source_range("bytes=1-2,4-5"));
+}
+
+TEST_F(S3UploadPartCopyActionTest, ValidateInvalidPartNumber) {
+  action_under_test->part_number = MAXIMUM_PART_NUMBER + 1;
+
+  EXPECT_CALL(*ptr_mock_request, send_response(400, _)).Times(1);
+
+  action_under_test->validate_upload_part_copy_request();
+
+  EXPECT_STREQ("InvalidPart",
+               action_under_test->get_s3_error_code().c_str());
+}
+
+TEST_F(S3UploadPartCopyActionTest, ValidateInvalidCopySource) {
+  EXPECT_CALL(*ptr_mock_request, get_headers_copysource()).Times(1).WillOnce(
+      Return("sourcebucketsourceobject"));
+  EXPECT_CALL(*ptr_mock_request, send_response(400, _)).Times(1);
+
+  action_under_test->validate_upload_part_copy_request();
+
+  EXPECT_STREQ("InvalidArgument",
+               action_under_test->get_s3_error_code().c_str());
+}
+
+TEST_F(S3UploadPartCopyActionTest, ValidateInvalidCopySourceRange) {
+  EXPECT_CALL(*ptr_mock_request, get_header_value("x-amz-copy-source-range"))
+      .Times(1)
+      .WillOnce(Return("bytes=100-10"));
+  EXPECT_CALL(*ptr_mock_request, send_response(400, _)).Times(1);
+
+  action_under_test->validate_upload_part_copy_request();
+
+  EXPECT_EQ("source-bucket", action_under_test->source_bucket_name);
+  EXPECT_EQ("source-object", action_under_test->source_object_name);
+  EXPECT_STREQ("InvalidArgument",
+               action_under_test->get_s3_error_code().c_str());
+}
+
+TEST_F(S3UploadPartCopyActionTest, SourceObjectRangeOutOfSize) {
+  use_source_object(100);
+  action_under_test->has_copy_range = true;
+  action_under_test->first_byte = 0;
+  action_under_test->last_byte = 100;
+
+  EXPECT_CALL(*ptr_mock_request, send_response(416, _)).Times(1);
+
+  action_under_test->fetch_source_object_info_success();
+
+  EXPECT_STREQ("InvalidRange", action_under_test->get_s3_error_code().c_str());
+}
+
+TEST_F(S3UploadPartCopyActionTest, SourceObjectWholeObject) {
+  use_source_object(3 * unit_size);
+
+  action_under_test->clear_tasks();
+  ACTION_TASK_ADD_OBJPTR(action_under_test,
+                         S3UploadPartCopyActionTest::func_callback_one, this);
+
+  action_under_test->fetch_source_object_info_success();
+
+  EXPECT_EQ(1, call_count_one);
+  EXPECT_EQ(3 * unit_size, action_under_test->total_data_to_copy);
+  ASSERT_EQ(1, action_under_test->copy_extents.size());
+  EXPECT_EQ(0, action_under_test->copy_extents[0].offset);
+  EXPECT_EQ(3 * unit_size, action_under_test->copy_extents[0].length);
+}
+
+TEST_F(S3UploadPartCopyActionTest, ClipSourceExtents) {
+  // Multipart source of three parts in slots of 4 units.
+  use_source_object(5 * unit_size);
+  ptr_mock_object_meta_factory->mock_object_metadata->set_extents(
+      {{0, 2 * unit_size}, {4 * unit_size, 2 * unit_size},
+       {8 * unit_size, unit_size}});
+  action_under_test->first_byte = unit_size;
+  action_under_test->total_data_to_copy = 3 * unit_size + 10;
+
+  action_under_test->clip_source_extents();
+
+  ASSERT_EQ(3, action_under_test->copy_extents.size());
+  EXPECT_EQ(unit_size, action_under_test->copy_extents[0].offset);
+  EXPECT_EQ(unit_size, action_under_test->copy_extents[0].length);
+  EXPECT_EQ(4 * unit_size, action_under_test->copy_extents[1].offset);
+  EXPECT_EQ(2 * unit_size, action_under_test->copy_extents[1].length);
+  EXPECT_EQ(8 * unit_size, action_under_test->copy_extents[2].offset);
+  EXPECT_EQ(10, action_under_test->copy_extents[2].length);
+}
+
+TEST_F(S3UploadPartCopyActionTest, ClipContiguousSource) {
+  use_source_object(10 * unit_size);
+  action_under_test->first_byte = 2 * unit_size;
+  action_under_test->total_data_to_copy = 5;
+
+  action_under_test->clip_source_extents();
+
+  ASSERT_EQ(1, action_under_test->copy_extents.size());
+  EXPECT_EQ(2 * unit_size, action_under_test->copy_extents[0].offset);
+  EXPECT_EQ(5, action_under_test->copy_extents[0].length);
+}
+
+TEST_F(S3UploadPartCopyActionTest, ComputePartOffsetOfUnalignedRange) {
+  use_source_object(10 * unit_size);
+  action_under_test->object_multipart_metadata =
+      ptr_mock_object_mp_meta_factory->mock_object_mp_metadata;
+  action_under_test->total_data_to_copy = 2 * unit_size;
+  // Copier shifts the data of a range starting in the middle of a unit.
+  action_under_test->copy_extents = {{100, unit_size},
+                                     {4 * unit_size + 10, unit_size}};
+
+  EXPECT_CALL(*ptr_mock_object_mp_meta_factory->mock_object_mp_metadata,
+              get_part_slot_size()).WillRepeatedly(Return(0));
+  EXPECT_CALL(*ptr_mock_object_mp_meta_factory->mock_object_mp_metadata,
+              get_part_one_size()).WillRepeatedly(Return(4 * unit_size));
+  EXPECT_CALL(*ptr_mock_object_mp_meta_factory->mock_object_mp_metadata,
+              get_layout_id()).WillRepeatedly(Return(layout_id));
+  EXPECT_CALL(*ptr_mock_object_mp_meta_factory->mock_object_mp_metadata,
+              get_oid()).WillRepeatedly(Return(oid));
+
+  action_under_test->clear_tasks();
+  ACTION_TASK_ADD_OBJPTR(action_under_test,
+                         S3UploadPartCopyActionTest::func_callback_one, this);
+
+  action_under_test->compute_part_offset();
+
+  EXPECT_EQ(1, call_count_one);
+  EXPECT_EQ(4 * unit_size, action_under_test->part_offset);
+  EXPECT_TRUE(action_under_test->motr_writer != nullptr);
+}
+
+TEST_F(S3UploadPartCopyActionTest, ComputePartOffsetInvalidPartOneSize) {
+  action_under_test->object_multipart_metadata =
+      ptr_mock_object_mp_meta_factory->mock_object_mp_metadata;
+  action_under_test->part_number = 1;
+  action_under_test->total_data_to_copy = unit_size + 1;
+
+  EXPECT_CALL(*ptr_mock_object_mp_meta_factory->mock_object_mp_metadata,
+              get_part_slot_size()).WillRepeatedly(Return(0));
+  EXPECT_CALL(*ptr_mock_object_mp_meta_factory->mock_object_mp_metadata,
+              get_layout_id()).WillRepeatedly(Return(layout_id));
+  // Part one size is not saved for a part which gets rejected.
+  EXPECT_CALL(*ptr_mock_object_mp_meta_factory->mock_object_mp_metadata,
+              set_part_one_size(_)).Times(0);
+  EXPECT_CALL(*ptr_mock_object_mp_meta_factory->mock_object_mp_metadata,
+              save(_, _)).Times(0);
+  EXPECT_CALL(*ptr_mock_request, send_response(400, _)).Times(1);
+
+  action_under_test->compute_part_offset();
+
+  EXPECT_STREQ("InvalidPartSize",
+               action_under_test->get_s3_error_code().c_str());
+}
+
+TEST_F(S3UploadPartCopyActionTest, ComputePartOffsetWithPartSlots) {
+  use_source_object(10 * unit_size);
+  action_under_test->object_multipart_metadata =
+      ptr_mock_object_mp_meta_factory->mock_object_mp_metadata;
+  action_under_test->total_data_to_copy = 3 * unit_size + 10;
+  action_under_test->copy_extents = {{unit_size, 3 * unit_size + 10}};
+
+  EXPECT_CALL(*ptr_mock_object_mp_meta_factory->mock_object_mp_metadata,
+              get_part_slot_size()).WillRepeatedly(Return(8 * unit_size));
+  EXPECT_CALL(*ptr_mock_object_mp_meta_factory->mock_object_mp_metadata,
+              get_layout_id()).WillRepeatedly(Return(layout_id));
+  EXPECT_CALL(*ptr_mock_object_mp_meta_factory->mock_object_mp_metadata,
+              get_oid()).WillRepeatedly(Return(oid));
+
+  action_under_test->clear_tasks();
+  ACTION_TASK_ADD_OBJPTR(action_under_test,
+                         S3UploadPartCopyActionTest::func_callback_one, this);
+
+  action_under_test->compute_part_offset();
+
+  EXPECT_EQ(1, call_count_one);
+  EXPECT_EQ(8 * unit_size, action_under_test->part_offset);
+  EXPECT_TRUE(action_under_test->motr_writer != nullptr);
+}
+
+TEST_F(S3UploadPartCopyActionTest, ComputePartOffsetEntityTooLarge) {
+  action_under_test->object_multipart_metadata =
+      ptr_mock_object_mp_meta_factory->mock_object_mp_metadata;
+  action_under_test->total_data_to_copy = 8 * unit_size + 1;
+
+  EXPECT_CALL(*ptr_mock_object_mp_meta_factory->mock_object_mp_metadata,
+              get_part_slot_size()).WillRepeatedly(Return(8 * unit_size));
+  EXPECT_CALL(*ptr_mock_object_mp_meta_factory->mock_object_mp_metadata,
+              get_layout_id()).WillRepeatedly(Return(layout_id));
+  EXPECT_CALL(*ptr_mock_request, send_response(400, _)).Times(1);
+
+  action_under_test->compute_part_offset();
+
+  EXPECT_STREQ("EntityTooLarge",
+               action_under_test->get_s3_error_code().c_str());
+}
+
+TEST_F(S3UploadPartCopyActionTest, CopyPartEmptyRange) {
+  action_under_test->total_data_to_copy = 0;
+
+  action_under_test->clear_tasks();
+  ACTION_TASK_ADD_OBJPTR(action_under_test,
+                         S3UploadPartCopyActionTest::func_callback_one, this);
+
+  action_under_test->copy_part();
+
+  EXPECT_EQ(1, call_count_one);
+  EXPECT_TRUE(action_under_test->object_data_copier == nullptr);
+}
+
+TEST_F(S3UploadPartCopyActionTest, CopyPartStarted) {
+  use_source_object(10 * unit_size);
+  action_under_test->total_data_to_copy = unit_size;
+  action_under_test->copy_extents = {{2 * unit_size, unit_size}};
+  action_under_test->part_offset = 8 * unit_size;
+  action_under_test->motr_writer =
+      ptr_mock_motr_writer_factory->mock_motr_writer;
+  action_under_test->motr_writer->set_layout_id(layout_id);
+
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              set_last_index(Eq(2 * unit_size))).Times(1);
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              read_object_data(_, _, _))
+      .Times(1)
+      .WillOnce(Return(true));
+
+  action_under_test->copy_part();
+
+  EXPECT_TRUE(action_under_test->object_data_copier != nullptr);
+}
+
+TEST_F(S3UploadPartCopyActionTest, CopyPartOfInlineSource) {
+  std::string data(5000, 'a');
+  data[100] = 'b';
+  use_source_object(data.length());
+  action_under_test->source_object_metadata->set_inline_data(data);
+  action_under_test->first_byte = 100;
+  action_under_test->total_data_to_copy = 4500;
+  action_under_test->motr_writer =
+      ptr_mock_motr_writer_factory->mock_motr_writer;
+
+  S3BufferSequence buffers;
+  EXPECT_CALL(*ptr_mock_motr_reader_factory->mock_motr_reader,
+              read_object_data(_, _, _)).Times(0);
+  EXPECT_CALL(*ptr_mock_motr_writer_factory->mock_motr_writer,
+              write_content(_, _, _, Eq(4096)))
+      .WillOnce(Invoke([&buffers](std::function<void(void)>,
+                                  std::function<void(void)>,
+                                  S3BufferSequence buffer_sequence, size_t) {
+        buffers = buffer_sequence;
+      }));
+
+  action_under_test->copy_part();
+
+  EXPECT_TRUE(action_under_test->object_data_copier == nullptr);
+  ASSERT_EQ(2u, buffers.size());
+  EXPECT_EQ(4096u, buffers[0].second);
+  EXPECT_EQ(404u, buffers[1].second);
+  EXPECT_EQ('b', *static_cast<char *>(buffers[0].first));
+}
+
+TEST_F(S3UploadPartCopyActionTest, SaveMetadata) {
+  action_under_test->object_multipart_metadata =
+      ptr_mock_object_mp_meta_factory->mock_object_mp_metadata;
+  action_under_test->total_data_to_copy = 4096;
+  action_under_test->content_md5 = "abcd1234abcd";
+
+  EXPECT_CALL(*ptr_mock_part_meta_factory->mock_part_metadata,
+              reset_date_time_to_current()).Times(1);
+  EXPECT_CALL(*ptr_mock_part_meta_factory->mock_part_metadata,
+              set_content_length(Eq("4096"))).Times(1);
+  EXPECT_CALL(*ptr_mock_part_meta_factory->mock_part_metadata,
+              set_md5(Eq("abcd1234abcd"))).Times(1);
+  EXPECT_CALL(*ptr_mock_part_meta_factory->mock_part_metadata, save(_, _))
+      .Times(1);
+
+  action_under_test->save_metadata();
+}
+
+TEST_F(S3UploadPartCopyActionTest, SendErrorResponse) {
+  action_under_test->set_s3_error("InternalError");
+
+  EXPECT_CALL(*ptr_mock_request, send_response(500, _)).Times(1);
+
+  action_under_test->send_response_to_s3_client();
+}
+
+TEST_F(S3UploadPartCopyActionTest, SendSuccessResponse) {
+  action_under_test->part_metadata =
+      ptr_mock_part_meta_factory->mock_part_metadata;
+
+  EXPECT_CALL(*ptr_mock_part_meta_factory->mock_part_metadata, get_md5())
+      .Times(1)
+      .WillOnce(Return("abcd1234abcd"));
+  EXPECT_CALL(*ptr_mock_part_meta_factory->mock_part_metadata,
+              get_last_modified_iso()).Times(1);
+  EXPECT_CALL(*ptr_mock_request,
+              send_response(200, HasSubstr("<ETag>\"abcd1234abcd\"</ETag>")))
+      .Times(1);
+
+  action_under_test->send_response_to_s3_client();
+}